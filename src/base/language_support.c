@@ -1659,6 +1659,43 @@ lang_get_collation (const int coll_id)
 }
 
 
+/*
+ * lang_get_byte_sort_weights - weights of the bytes of strings compared in a collation, if they fit in a byte
+ *   return: array of 256 weights, or NULL if the collation doesn't compare strings byte by byte on their weights
+ *   lang_coll(in): collation
+ *   ignore_trailing_space(in): the comparison ignores trailing spaces
+ *
+ * Note: spaces weigh zero. The weights of the bytes of a string, padded with zeros, order by memcmp as the string
+ *       does in the collation, up to ties.
+ */
+const unsigned int *
+lang_get_byte_sort_weights (const LANG_COLLATION * lang_coll, bool ignore_trailing_space)
+{
+  const unsigned int *weights;
+  int i;
+
+  if (lang_coll->fastcmp != lang_fastcmp_byte)
+    {
+      return NULL;
+    }
+
+  weights = (ignore_trailing_space) ? lang_coll->coll.weights_ti : lang_coll->coll.weights;
+  if (weights == NULL || lang_coll->coll.w_count < 256)
+    {
+      return NULL;
+    }
+
+  for (i = 0; i < 256; i++)
+    {
+      if (weights[i] > 0xff)
+	{
+	  return NULL;
+	}
+    }
+
+  return weights;
+}
+
 /*
  * lang_get_collation_name - return collation name
  *   return: collation name
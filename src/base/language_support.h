@@ -311,6 +311,7 @@ extern "C"
   extern const char *lang_get_collation_name (const int coll_id);
   extern LANG_COLLATION *lang_get_collation_by_name (const char *coll_name);
   extern int lang_collation_count (void);
+  extern const unsigned int *lang_get_byte_sort_weights (const LANG_COLLATION * lang_coll, bool ignore_trailing_space);
   extern const char *lang_get_codeset_name (int codeset_id);
   extern const ALPHABET_DATA *lang_user_alphabet_w_coll (const int collation_id);
   extern TEXT_CONVERSION *lang_get_txt_conv (void);
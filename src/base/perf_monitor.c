@@ -299,6 +299,9 @@ PSTAT_METADATA pstat_Metadata[] = {
   /* Execution statistics for external sort */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_SORT_NUM_IO_PAGES, "Num_sort_io_pages"),
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_SORT_NUM_DATA_PAGES, "Num_sort_data_pages"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_SORT_NUM_RUNS, "Num_sort_runs"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_SORT_NUM_MERGE_PASSES, "Num_sort_merge_passes"),
+  PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_SORT_NUM_SPILLED_PAGES, "Num_sort_spilled_pages"),
 
   /* Execution statistics for network communication */
   PSTAT_METADATA_INIT_SINGLE_ACC (PSTAT_NET_NUM_REQUESTS, "Num_network_requests"),
@@ -374,6 +374,9 @@ typedef enum
   /* Execution statistics for external sort */
   PSTAT_SORT_NUM_IO_PAGES,
   PSTAT_SORT_NUM_DATA_PAGES,
+  PSTAT_SORT_NUM_RUNS,
+  PSTAT_SORT_NUM_MERGE_PASSES,
+  PSTAT_SORT_NUM_SPILLED_PAGES,
 
   /* Execution statistics for network communication */
   PSTAT_NET_NUM_REQUESTS,
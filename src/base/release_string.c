@@ -440,6 +440,7 @@ rel_compare (const char *rel_a, const char *rel_b)
  */
 static REL_VERSION log_incompatible_versions[] = {
   {10, 0, 0},
+  {11, 4, 1},			/* RVHF_MVCC_INSERT_MULTI: one heap insert log record for a page of records */
 
   /* PLEASE APPEND HERE versions that are incompatible with existing ones. */
   /* NOTE that versions are kept as ascending order. */
@@ -474,6 +475,10 @@ rel_is_log_compatible (const char *writer_rel_str, const char *reader_rel_str)
  */
 static REL_VERSION net_incompatible_versions[] = {
   {10, 0, 0},
+  /* 11.4.1: XASL streams carry parallel degrees, ROWS frames, distinct recursive CTEs, scan selectivities and
+   * adaptive join limits; unpacked XASL nodes gain hash join, partition pruning and partition-wise join state;
+   * statistics requests and replies carry zone widths, frequent values and measured selectivities */
+  {11, 4, 1},
 
   /* PLEASE APPEND HERE versions that are incompatible with existing ones. */
   /* NOTE that versions are kept as ascending order. */
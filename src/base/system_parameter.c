@@ -753,6 +753,39 @@ static const char sysprm_ha_conf_file_name[] = "cubrid_ha.conf";
 
 #define PRM_NAME_ENABLE_MEMORY_MONITORING "enable_memory_monitoring"
 
+#define PRM_NAME_PARALLEL_HEAP_SCAN_DEGREE "parallel_heap_scan_degree"
+#define PRM_NAME_PARALLEL_HEAP_SCAN_PAGE_THRESHOLD "parallel_heap_scan_page_threshold"
+
+#define PRM_NAME_HEAP_ZONE_MAP_PAGES "heap_zone_map_pages"
+
+#define PRM_NAME_MAX_PARALLEL_WORKERS "max_parallel_workers"
+
+#define PRM_NAME_PARALLEL_QUERY_DEGREE "parallel_query_degree"
+
+#define PRM_NAME_VECTOR_SCAN_BATCH_SIZE "vector_scan_batch_size"
+
+#define PRM_NAME_PREDICATE_COMPILATION "predicate_compilation"
+
+#define PRM_NAME_MAX_HASH_JOIN_PARTITIONS "max_hash_join_partitions"
+
+#define PRM_NAME_MAX_HASH_JOIN_BLOOM_FILTER_KEYS "max_hash_join_bloom_filter_keys"
+
+#define PRM_NAME_MAX_AGG_HASH_PARTITIONS "max_agg_hash_partitions"
+
+#define PRM_NAME_PARALLEL_SORT_DEGREE "parallel_sort_degree"
+
+#define PRM_NAME_SORT_KEY_NORMALIZATION "sort_key_normalization"
+
+#define PRM_NAME_LIST_FILE_COMPRESSION "list_file_compression"
+
+#define PRM_NAME_OPTIMIZER_JOIN_PLANNING_BUDGET "optimizer_join_planning_budget"
+
+#define PRM_NAME_XASL_CACHE_MAX_PLAN_VARIANTS "max_plan_cache_variants"
+
+#define PRM_NAME_CARDINALITY_FEEDBACK_ERROR_RATIO "cardinality_feedback_error_ratio"
+
+#define PRM_NAME_ADAPTIVE_JOIN_ERROR_RATIO "adaptive_join_error_ratio"
+
 /*
  * Note about ERROR_LIST and INTEGER_LIST type
  * ERROR_LIST type is an array of bool type with the size of -(ER_LAST_ERROR)
@@ -2457,6 +2490,102 @@ static UINT64 prm_max_subquery_cache_size_lower = 0;	/* 0 */
 static UINT64 prm_max_subquery_cache_size_upper = 16 * 1024 * 1024;	/* 16 MB */
 static unsigned int prm_max_subquery_cache_size_flag = 0;
 
+int PRM_PARALLEL_HEAP_SCAN_DEGREE = 1;
+static int prm_parallel_heap_scan_degree_default = 1;	/* disabled */
+static int prm_parallel_heap_scan_degree_lower = 1;
+static int prm_parallel_heap_scan_degree_upper = 64;
+static unsigned int prm_parallel_heap_scan_degree_flag = 0;
+
+int PRM_PARALLEL_HEAP_SCAN_PAGE_THRESHOLD = 4096;
+static int prm_parallel_heap_scan_page_threshold_default = 4096;
+static int prm_parallel_heap_scan_page_threshold_lower = 1;
+static int prm_parallel_heap_scan_page_threshold_upper = INT_MAX;
+static unsigned int prm_parallel_heap_scan_page_threshold_flag = 0;
+
+int PRM_HEAP_ZONE_MAP_PAGES = 0;
+static int prm_heap_zone_map_pages_default = 0;
+static int prm_heap_zone_map_pages_lower = 0;
+static int prm_heap_zone_map_pages_upper = 65536;
+static unsigned int prm_heap_zone_map_pages_flag = 0;
+
+int PRM_MAX_PARALLEL_WORKERS = 8;
+static int prm_max_parallel_workers_default = 8;
+static int prm_max_parallel_workers_lower = 0;
+static int prm_max_parallel_workers_upper = 256;
+static unsigned int prm_max_parallel_workers_flag = 0;
+
+int PRM_PARALLEL_QUERY_DEGREE = 4;
+static int prm_parallel_query_degree_default = 4;
+static int prm_parallel_query_degree_lower = 1;
+static int prm_parallel_query_degree_upper = 64;
+static unsigned int prm_parallel_query_degree_flag = 0;
+
+int PRM_VECTOR_SCAN_BATCH_SIZE = 1024;
+static int prm_vector_scan_batch_size_default = 1024;
+static int prm_vector_scan_batch_size_lower = 0;
+static int prm_vector_scan_batch_size_upper = 16384;
+static unsigned int prm_vector_scan_batch_size_flag = 0;
+
+bool PRM_PREDICATE_COMPILATION = true;
+static bool prm_predicate_compilation_default = true;
+static unsigned int prm_predicate_compilation_flag = 0;
+
+int PRM_MAX_HASH_JOIN_PARTITIONS = 256;
+static int prm_max_hash_join_partitions_default = 256;
+static int prm_max_hash_join_partitions_lower = 0;
+static int prm_max_hash_join_partitions_upper = 4096;
+static unsigned int prm_max_hash_join_partitions_flag = 0;
+
+int PRM_MAX_HASH_JOIN_BLOOM_FILTER_KEYS = 4000000;
+static int prm_max_hash_join_bloom_filter_keys_default = 4000000;
+static int prm_max_hash_join_bloom_filter_keys_lower = 0;
+static int prm_max_hash_join_bloom_filter_keys_upper = 100000000;
+static unsigned int prm_max_hash_join_bloom_filter_keys_flag = 0;
+
+int PRM_MAX_AGG_HASH_PARTITIONS = 256;
+static int prm_max_agg_hash_partitions_default = 256;
+static int prm_max_agg_hash_partitions_lower = 0;
+static int prm_max_agg_hash_partitions_upper = 4096;
+static unsigned int prm_max_agg_hash_partitions_flag = 0;
+
+int PRM_PARALLEL_SORT_DEGREE = 4;
+static int prm_parallel_sort_degree_default = 4;
+static int prm_parallel_sort_degree_lower = 0;
+static int prm_parallel_sort_degree_upper = 64;
+static unsigned int prm_parallel_sort_degree_flag = 0;
+
+bool PRM_SORT_KEY_NORMALIZATION = true;
+static bool prm_sort_key_normalization_default = true;
+static unsigned int prm_sort_key_normalization_flag = 0;
+
+bool PRM_LIST_FILE_COMPRESSION = false;
+static bool prm_list_file_compression_default = false;
+static unsigned int prm_list_file_compression_flag = 0;
+
+int PRM_OPTIMIZER_JOIN_PLANNING_BUDGET = 100;
+static int prm_optimizer_join_planning_budget_default = 100;
+static int prm_optimizer_join_planning_budget_lower = 0;
+static int prm_optimizer_join_planning_budget_upper = 60000;
+static unsigned int prm_optimizer_join_planning_budget_flag = 0;
+
+int PRM_XASL_CACHE_MAX_PLAN_VARIANTS = 4;
+static int prm_xasl_cache_max_plan_variants_default = 4;
+static int prm_xasl_cache_max_plan_variants_lower = 0;
+static int prm_xasl_cache_max_plan_variants_upper = 16;
+static unsigned int prm_xasl_cache_max_plan_variants_flag = 0;
+
+float PRM_CARDINALITY_FEEDBACK_ERROR_RATIO = 10.0f;
+static float prm_cardinality_feedback_error_ratio_default = 10.0f;
+static float prm_cardinality_feedback_error_ratio_lower = 0.0f;
+static float prm_cardinality_feedback_error_ratio_upper = 1000000.0f;
+static unsigned int prm_cardinality_feedback_error_ratio_flag = 0;
+
+float PRM_ADAPTIVE_JOIN_ERROR_RATIO = 10.0f;
+static float prm_adaptive_join_error_ratio_default = 10.0f;
+static float prm_adaptive_join_error_ratio_lower = 0.0f;
+static float prm_adaptive_join_error_ratio_upper = 1000000.0f;
+static unsigned int prm_adaptive_join_error_ratio_flag = 0;
+
 typedef int (*DUP_PRM_FUNC) (void *, SYSPRM_DATATYPE, void *, SYSPRM_DATATYPE);
 
 static int prm_size_to_io_pages (void *out_val, SYSPRM_DATATYPE out_type, void *in_val, SYSPRM_DATATYPE in_type);
@@ -6448,6 +6577,207 @@ SYSPRM_PARAM prm_Def[] = {
    (void *) &prm_max_subquery_cache_size_lower,
    (char *) NULL,
    (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PARALLEL_HEAP_SCAN_DEGREE,
+   PRM_NAME_PARALLEL_HEAP_SCAN_DEGREE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_parallel_heap_scan_degree_flag,
+   (void *) &prm_parallel_heap_scan_degree_default,
+   (void *) &PRM_PARALLEL_HEAP_SCAN_DEGREE,
+   (void *) &prm_parallel_heap_scan_degree_upper,
+   (void *) &prm_parallel_heap_scan_degree_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PARALLEL_HEAP_SCAN_PAGE_THRESHOLD,
+   PRM_NAME_PARALLEL_HEAP_SCAN_PAGE_THRESHOLD,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_parallel_heap_scan_page_threshold_flag,
+   (void *) &prm_parallel_heap_scan_page_threshold_default,
+   (void *) &PRM_PARALLEL_HEAP_SCAN_PAGE_THRESHOLD,
+   (void *) &prm_parallel_heap_scan_page_threshold_upper,
+   (void *) &prm_parallel_heap_scan_page_threshold_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_HEAP_ZONE_MAP_PAGES,
+   PRM_NAME_HEAP_ZONE_MAP_PAGES,
+   (PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_heap_zone_map_pages_flag,
+   (void *) &prm_heap_zone_map_pages_default,
+   (void *) &PRM_HEAP_ZONE_MAP_PAGES,
+   (void *) &prm_heap_zone_map_pages_upper,
+   (void *) &prm_heap_zone_map_pages_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_MAX_PARALLEL_WORKERS,
+   PRM_NAME_MAX_PARALLEL_WORKERS,
+   (PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_max_parallel_workers_flag,
+   (void *) &prm_max_parallel_workers_default,
+   (void *) &PRM_MAX_PARALLEL_WORKERS,
+   (void *) &prm_max_parallel_workers_upper,
+   (void *) &prm_max_parallel_workers_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PARALLEL_QUERY_DEGREE,
+   PRM_NAME_PARALLEL_QUERY_DEGREE,
+   (PRM_FOR_CLIENT | PRM_USER_CHANGE | PRM_FOR_SESSION),
+   PRM_INTEGER,
+   &prm_parallel_query_degree_flag,
+   (void *) &prm_parallel_query_degree_default,
+   (void *) &PRM_PARALLEL_QUERY_DEGREE,
+   (void *) &prm_parallel_query_degree_upper,
+   (void *) &prm_parallel_query_degree_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_VECTOR_SCAN_BATCH_SIZE,
+   PRM_NAME_VECTOR_SCAN_BATCH_SIZE,
+   (PRM_FOR_SERVER),
+   PRM_INTEGER,
+   &prm_vector_scan_batch_size_flag,
+   (void *) &prm_vector_scan_batch_size_default,
+   (void *) &PRM_VECTOR_SCAN_BATCH_SIZE,
+   (void *) &prm_vector_scan_batch_size_upper,
+   (void *) &prm_vector_scan_batch_size_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PREDICATE_COMPILATION,
+   PRM_NAME_PREDICATE_COMPILATION,
+   (PRM_FOR_SERVER),
+   PRM_BOOLEAN,
+   &prm_predicate_compilation_flag,
+   (void *) &prm_predicate_compilation_default,
+   (void *) &PRM_PREDICATE_COMPILATION,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_MAX_HASH_JOIN_PARTITIONS,
+   PRM_NAME_MAX_HASH_JOIN_PARTITIONS,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_max_hash_join_partitions_flag,
+   (void *) &prm_max_hash_join_partitions_default,
+   (void *) &PRM_MAX_HASH_JOIN_PARTITIONS,
+   (void *) &prm_max_hash_join_partitions_upper,
+   (void *) &prm_max_hash_join_partitions_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_MAX_HASH_JOIN_BLOOM_FILTER_KEYS,
+   PRM_NAME_MAX_HASH_JOIN_BLOOM_FILTER_KEYS,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_max_hash_join_bloom_filter_keys_flag,
+   (void *) &prm_max_hash_join_bloom_filter_keys_default,
+   (void *) &PRM_MAX_HASH_JOIN_BLOOM_FILTER_KEYS,
+   (void *) &prm_max_hash_join_bloom_filter_keys_upper,
+   (void *) &prm_max_hash_join_bloom_filter_keys_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_MAX_AGG_HASH_PARTITIONS,
+   PRM_NAME_MAX_AGG_HASH_PARTITIONS,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_max_agg_hash_partitions_flag,
+   (void *) &prm_max_agg_hash_partitions_default,
+   (void *) &PRM_MAX_AGG_HASH_PARTITIONS,
+   (void *) &prm_max_agg_hash_partitions_upper,
+   (void *) &prm_max_agg_hash_partitions_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_PARALLEL_SORT_DEGREE,
+   PRM_NAME_PARALLEL_SORT_DEGREE,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_INTEGER,
+   &prm_parallel_sort_degree_flag,
+   (void *) &prm_parallel_sort_degree_default,
+   (void *) &PRM_PARALLEL_SORT_DEGREE,
+   (void *) &prm_parallel_sort_degree_upper,
+   (void *) &prm_parallel_sort_degree_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_SORT_KEY_NORMALIZATION,
+   PRM_NAME_SORT_KEY_NORMALIZATION,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_BOOLEAN,
+   &prm_sort_key_normalization_flag,
+   (void *) &prm_sort_key_normalization_default,
+   (void *) &PRM_SORT_KEY_NORMALIZATION,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_LIST_FILE_COMPRESSION,
+   PRM_NAME_LIST_FILE_COMPRESSION,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_BOOLEAN,
+   &prm_list_file_compression_flag,
+   (void *) &prm_list_file_compression_default,
+   (void *) &PRM_LIST_FILE_COMPRESSION,
+   (void *) NULL, (void *) NULL,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_OPTIMIZER_JOIN_PLANNING_BUDGET,
+   PRM_NAME_OPTIMIZER_JOIN_PLANNING_BUDGET,
+   (PRM_FOR_CLIENT | PRM_USER_CHANGE | PRM_FOR_SESSION),
+   PRM_INTEGER,
+   &prm_optimizer_join_planning_budget_flag,
+   (void *) &prm_optimizer_join_planning_budget_default,
+   (void *) &PRM_OPTIMIZER_JOIN_PLANNING_BUDGET,
+   (void *) &prm_optimizer_join_planning_budget_upper,
+   (void *) &prm_optimizer_join_planning_budget_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_XASL_CACHE_MAX_PLAN_VARIANTS,
+   PRM_NAME_XASL_CACHE_MAX_PLAN_VARIANTS,
+   (PRM_FOR_CLIENT | PRM_USER_CHANGE | PRM_FOR_SESSION),
+   PRM_INTEGER,
+   &prm_xasl_cache_max_plan_variants_flag,
+   (void *) &prm_xasl_cache_max_plan_variants_default,
+   (void *) &PRM_XASL_CACHE_MAX_PLAN_VARIANTS,
+   (void *) &prm_xasl_cache_max_plan_variants_upper,
+   (void *) &prm_xasl_cache_max_plan_variants_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_CARDINALITY_FEEDBACK_ERROR_RATIO,
+   PRM_NAME_CARDINALITY_FEEDBACK_ERROR_RATIO,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_FLOAT,
+   &prm_cardinality_feedback_error_ratio_flag,
+   (void *) &prm_cardinality_feedback_error_ratio_default,
+   (void *) &PRM_CARDINALITY_FEEDBACK_ERROR_RATIO,
+   (void *) &prm_cardinality_feedback_error_ratio_upper,
+   (void *) &prm_cardinality_feedback_error_ratio_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
+   (DUP_PRM_FUNC) NULL},
+  {PRM_ID_ADAPTIVE_JOIN_ERROR_RATIO,
+   PRM_NAME_ADAPTIVE_JOIN_ERROR_RATIO,
+   (PRM_FOR_SERVER | PRM_USER_CHANGE),
+   PRM_FLOAT,
+   &prm_adaptive_join_error_ratio_flag,
+   (void *) &prm_adaptive_join_error_ratio_default,
+   (void *) &PRM_ADAPTIVE_JOIN_ERROR_RATIO,
+   (void *) &prm_adaptive_join_error_ratio_upper,
+   (void *) &prm_adaptive_join_error_ratio_lower,
+   (char *) NULL,
+   (DUP_PRM_FUNC) NULL,
    (DUP_PRM_FUNC) NULL}
 };
 
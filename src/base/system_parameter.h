@@ -486,8 +486,25 @@ enum param_id
 
   PRM_ID_ENABLE_MEMORY_MONITORING,
   PRM_ID_MAX_SUBQUERY_CACHE_SIZE,
+  PRM_ID_PARALLEL_HEAP_SCAN_DEGREE,
+  PRM_ID_PARALLEL_HEAP_SCAN_PAGE_THRESHOLD,
+  PRM_ID_HEAP_ZONE_MAP_PAGES,
+  PRM_ID_MAX_PARALLEL_WORKERS,
+  PRM_ID_PARALLEL_QUERY_DEGREE,
+  PRM_ID_VECTOR_SCAN_BATCH_SIZE,
+  PRM_ID_PREDICATE_COMPILATION,
+  PRM_ID_MAX_HASH_JOIN_PARTITIONS,
+  PRM_ID_MAX_HASH_JOIN_BLOOM_FILTER_KEYS,
+  PRM_ID_MAX_AGG_HASH_PARTITIONS,
+  PRM_ID_PARALLEL_SORT_DEGREE,
+  PRM_ID_SORT_KEY_NORMALIZATION,
+  PRM_ID_LIST_FILE_COMPRESSION,
+  PRM_ID_OPTIMIZER_JOIN_PLANNING_BUDGET,
+  PRM_ID_XASL_CACHE_MAX_PLAN_VARIANTS,
+  PRM_ID_CARDINALITY_FEEDBACK_ERROR_RATIO,
+  PRM_ID_ADAPTIVE_JOIN_ERROR_RATIO,
   /* change PRM_LAST_ID when adding new system parameters */
-  PRM_LAST_ID = PRM_ID_MAX_SUBQUERY_CACHE_SIZE
+  PRM_LAST_ID = PRM_ID_ADAPTIVE_JOIN_ERROR_RATIO
 };
 typedef enum param_id PARAM_ID;
 
@@ -5799,6 +5799,64 @@ stats_get_statistics_from_server (OID * classoid, unsigned int timestamp, int *l
 #endif /* !CS_MODE */
 }
 
+#if defined(CS_MODE)
+/*
+ * stats_pack_update_statistics_request - pack the request to update the statistics of a class
+ *
+ * return: request buffer, to be freed by the caller; NULL on error
+ *
+ *   class_attr_ndv(in): NDV and frequent values of the columns
+ *   class_oid(in):
+ *   with_fullscan(in):
+ *   request_size(out):
+ */
+static char *
+stats_pack_update_statistics_request (CLASS_ATTR_NDV * class_attr_ndv, OID * class_oid, int with_fullscan,
+				      int *request_size)
+{
+  ATTR_NDV *attr_ndv;
+  char *request, *ptr;
+  int i, j, size;
+
+  size = OR_INT_SIZE + OR_OID_SIZE + OR_INT_SIZE;
+  for (i = 0; i < class_attr_ndv->attr_cnt + 1; i++)
+    {
+      attr_ndv = &class_attr_ndv->attr_ndv[i];
+      size += OR_INT_SIZE + OR_INT64_SIZE + OR_INT_SIZE;
+      for (j = 0; j < attr_ndv->n_freq_values; j++)
+	{
+	  size += or_packed_value_size (&attr_ndv->freq_values[j].value, 0, 1, 1) + OR_DOUBLE_SIZE + 2 * MAX_ALIGNMENT;
+	}
+    }
+
+  request = (char *) malloc (size);
+  if (request == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) size);
+      return NULL;
+    }
+
+  ptr = or_pack_int (request, class_attr_ndv->attr_cnt);
+  for (i = 0; i < class_attr_ndv->attr_cnt + 1; i++)
+    {
+      attr_ndv = &class_attr_ndv->attr_ndv[i];
+      ptr = or_pack_int (ptr, attr_ndv->id);
+      ptr = or_pack_int64 (ptr, attr_ndv->ndv);
+      ptr = or_pack_int (ptr, attr_ndv->n_freq_values);
+      for (j = 0; j < attr_ndv->n_freq_values; j++)
+	{
+	  ptr = or_pack_value (ptr, &attr_ndv->freq_values[j].value);
+	  ptr = or_pack_double (ptr, attr_ndv->freq_values[j].fraction);
+	}
+    }
+  ptr = or_pack_oid (ptr, class_oid);
+  ptr = or_pack_int (ptr, with_fullscan);
+
+  *request_size = CAST_STRLEN (ptr - request);
+  return request;
+}
+#endif /* CS_MODE */
+
 /*
  * stats_update_statistics -
  *
@@ -5818,38 +5876,23 @@ stats_update_statistics (MOP classop, int with_fullscan)
   char *request;
   OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
   char *reply;
-  char *ptr;
   int request_size;
   CLASS_ATTR_NDV class_attr_ndv = CLASS_ATTR_NDV_INITIALIZER;
 
   /* get NDV by query */
   if (stats_get_ndv_by_query (classop, &class_attr_ndv, NULL, with_fullscan) != NO_ERROR)
     {
-      if (class_attr_ndv.attr_ndv != NULL)
-	{
-	  free_and_init (class_attr_ndv.attr_ndv);
-	}
+      stats_free_class_attr_ndv (&class_attr_ndv);
       return ER_FAILED;
     }
 
-  request_size = OR_INT_SIZE + (sizeof (ATTR_NDV) * (class_attr_ndv.attr_cnt + 1)) + OR_INT_SIZE + OR_OID_SIZE;
-  request = (char *) malloc (request_size);
+  request = stats_pack_update_statistics_request (&class_attr_ndv, WS_OID (classop), with_fullscan, &request_size);
   if (request == NULL)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) request_size);
-      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      ASSERT_ERROR_AND_SET (error);
       goto end;
     }
 
-  ptr = or_pack_int (request, class_attr_ndv.attr_cnt);
-  for (int i = 0; i < class_attr_ndv.attr_cnt + 1; i++)
-    {
-      ptr = or_pack_int (ptr, class_attr_ndv.attr_ndv[i].id);
-      ptr = or_pack_int64 (ptr, class_attr_ndv.attr_ndv[i].ndv);
-    }
-  ptr = or_pack_oid (ptr, WS_OID (classop));
-  ptr = or_pack_int (ptr, with_fullscan);
-
   reply = OR_ALIGNED_BUF_START (a_reply);
 
   req_error =
@@ -5861,10 +5904,7 @@ stats_update_statistics (MOP classop, int with_fullscan)
     }
 
 end:
-  if (class_attr_ndv.attr_ndv != NULL)
-    {
-      free_and_init (class_attr_ndv.attr_ndv);
-    }
+  stats_free_class_attr_ndv (&class_attr_ndv);
 
   free_and_init (request);
 
@@ -5876,10 +5916,7 @@ end:
   /* get NDV by query */
   if (stats_get_ndv_by_query (classop, &class_attr_ndv, NULL, with_fullscan) != NO_ERROR)
     {
-      if (class_attr_ndv.attr_ndv != NULL)
-	{
-	  free_and_init (class_attr_ndv.attr_ndv);
-	}
+      stats_free_class_attr_ndv (&class_attr_ndv);
       return ER_FAILED;
     }
 
@@ -5892,10 +5929,7 @@ end:
 
   exit_server (*thread_p);
 
-  if (class_attr_ndv.attr_ndv != NULL)
-    {
-      free_and_init (class_attr_ndv.attr_ndv);
-    }
+  stats_free_class_attr_ndv (&class_attr_ndv);
 
   return success;
 #endif /* !CS_MODE */
@@ -5918,7 +5952,6 @@ stats_update_all_statistics (int with_fullscan)
   char *request;
   OR_ALIGNED_BUF (OR_INT_SIZE) a_reply;
   char *reply;
-  char *ptr;
   CLASS_ATTR_NDV class_attr_ndv = CLASS_ATTR_NDV_INITIALIZER;
   const char *query = "select c.unique_name from _db_class as c where c.class_type = 0 and [partition] is null "
     "union "
@@ -5970,24 +6003,14 @@ stats_update_all_statistics (int with_fullscan)
 	  goto end;
 	}
 
-      request_size = OR_INT_SIZE + (sizeof (ATTR_NDV) * (class_attr_ndv.attr_cnt + 1)) + OR_INT_SIZE + OR_OID_SIZE;
-      request = (char *) malloc (request_size);
+      request =
+	stats_pack_update_statistics_request (&class_attr_ndv, WS_OID (class_mop), with_fullscan, &request_size);
       if (request == NULL)
 	{
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) request_size);
-	  error = ER_OUT_OF_VIRTUAL_MEMORY;
+	  ASSERT_ERROR_AND_SET (error);
 	  goto end;
 	}
 
-      ptr = or_pack_int (request, class_attr_ndv.attr_cnt);
-      for (int i = 0; i < class_attr_ndv.attr_cnt + 1; i++)
-	{
-	  ptr = or_pack_int (ptr, class_attr_ndv.attr_ndv[i].id);
-	  ptr = or_pack_int64 (ptr, class_attr_ndv.attr_ndv[i].ndv);
-	}
-      ptr = or_pack_oid (ptr, WS_OID (class_mop));
-      ptr = or_pack_int (ptr, with_fullscan);
-
       reply = OR_ALIGNED_BUF_START (a_reply);
 
       req_error =
@@ -5997,10 +6020,7 @@ stats_update_all_statistics (int with_fullscan)
 	{
 	  or_unpack_errcode (reply, &error);
 	}
-      if (class_attr_ndv.attr_ndv != NULL)
-	{
-	  free_and_init (class_attr_ndv.attr_ndv);
-	}
+      stats_free_class_attr_ndv (&class_attr_ndv);
       free_and_init (request);
       db_value_clear (&class_name_val);
 
@@ -6017,10 +6037,7 @@ end:
       db_query_end (query_result);
       query_result = NULL;
     }
-  if (class_attr_ndv.attr_ndv != NULL)
-    {
-      free_and_init (class_attr_ndv.attr_ndv);
-    }
+  stats_free_class_attr_ndv (&class_attr_ndv);
   if (request)
     {
       free_and_init (request);
@@ -6077,10 +6094,7 @@ end:
       /* get NDV by query */
       if (stats_get_ndv_by_query (class_mop, &class_attr_ndv, NULL, with_fullscan) != NO_ERROR)
 	{
-	  if (class_attr_ndv.attr_ndv != NULL)
-	    {
-	      free_and_init (class_attr_ndv.attr_ndv);
-	    }
+	  stats_free_class_attr_ndv (&class_attr_ndv);
 	  error = ER_FAILED;
 	  goto end;
 	}
@@ -6091,10 +6105,7 @@ end:
 				  (with_fullscan ? STATS_WITH_FULLSCAN : STATS_WITH_SAMPLING), &class_attr_ndv);
       exit_server (*thread_p);
 
-      if (class_attr_ndv.attr_ndv != NULL)
-	{
-	  free_and_init (class_attr_ndv.attr_ndv);
-	}
+      stats_free_class_attr_ndv (&class_attr_ndv);
 
       db_value_clear (&class_name_val);
       if (error != NO_ERROR)
@@ -6110,10 +6121,7 @@ end:
       db_query_end (query_result);
       query_result = NULL;
     }
-  if (class_attr_ndv.attr_ndv != NULL)
-    {
-      free_and_init (class_attr_ndv.attr_ndv);
-    }
+  stats_free_class_attr_ndv (&class_attr_ndv);
 
   return (error == DB_CURSOR_END) ? NO_ERROR : error;
 #endif /* !CS_MODE */
@@ -4065,8 +4065,44 @@ sqst_update_statistics (THREAD_ENTRY * thread_p, unsigned int rid, char *request
 
   for (int i = 0; i < class_attr_ndv.attr_cnt + 1; i++)
     {
-      ptr = or_unpack_int (ptr, &class_attr_ndv.attr_ndv[i].id);
-      ptr = or_unpack_int64 (ptr, &class_attr_ndv.attr_ndv[i].ndv);
+      ATTR_NDV *attr_ndv = &class_attr_ndv.attr_ndv[i];
+
+      ptr = or_unpack_int (ptr, &attr_ndv->id);
+      ptr = or_unpack_int64 (ptr, &attr_ndv->ndv);
+      ptr = or_unpack_int (ptr, &attr_ndv->n_freq_values);
+
+      attr_ndv->freq_values = NULL;
+      if (attr_ndv->n_freq_values > 0)
+	{
+	  attr_ndv->freq_values =
+	    (ATTR_FREQ_VALUE *) db_private_alloc (thread_p, attr_ndv->n_freq_values * sizeof (ATTR_FREQ_VALUE));
+	  if (attr_ndv->freq_values == NULL)
+	    {
+	      /* frequent values are optional */
+	      er_clear ();
+	    }
+	}
+      for (int j = 0; j < attr_ndv->n_freq_values; j++)
+	{
+	  DB_VALUE value;
+	  double fraction;
+
+	  ptr = or_unpack_value (ptr, &value);
+	  ptr = or_unpack_double (ptr, &fraction);
+	  if (attr_ndv->freq_values != NULL)
+	    {
+	      attr_ndv->freq_values[j].value = value;
+	      attr_ndv->freq_values[j].fraction = fraction;
+	    }
+	  else
+	    {
+	      pr_clear_value (&value);
+	    }
+	}
+      if (attr_ndv->freq_values == NULL)
+	{
+	  attr_ndv->n_freq_values = 0;
+	}
     }
   ptr = or_unpack_oid (ptr, &classoid);
   ptr = or_unpack_int (ptr, &with_fullscan);
@@ -4079,6 +4115,21 @@ sqst_update_statistics (THREAD_ENTRY * thread_p, unsigned int rid, char *request
       (void) return_error_to_client (thread_p, rid);
     }
 
+  for (int i = 0; i < class_attr_ndv.attr_cnt + 1; i++)
+    {
+      ATTR_NDV *attr_ndv = &class_attr_ndv.attr_ndv[i];
+
+      for (int j = 0; j < attr_ndv->n_freq_values; j++)
+	{
+	  pr_clear_value (&attr_ndv->freq_values[j].value);
+	}
+      if (attr_ndv->freq_values != NULL)
+	{
+	  db_private_free_and_init (thread_p, attr_ndv->freq_values);
+	}
+    }
+  free_and_init (class_attr_ndv.attr_ndv);
+
   (void) or_pack_errcode (reply, error);
   css_send_data_to_client (thread_p->conn_entry, rid, reply, OR_ALIGNED_BUF_SIZE (a_reply));
 }
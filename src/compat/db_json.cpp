@@ -2004,8 +2004,12 @@ db_json_search_func (const JSON_DOC &doc, const DB_VALUE *pattern, const DB_VALU
   db_make_string (&encoded_pattern_dbval, encoded_pattern.c_str ());
   db_string_put_cs_and_collation (&encoded_pattern_dbval, INTL_CODESET_UTF8, LANG_COLL_UTF8_BINARY);
 
-  const map_func_type &f_search = [&json_paths, &paths, &encoded_pattern_dbval, esc_char, find_all] (const JSON_VALUE &jv,
-				  const JSON_PATH &crt_path, bool &stop) -> int
+  // the pattern is analyzed once for all the strings of the document
+  cub_compiled_like compiled_like;
+  cub_compiled_like *compiled_like_p = &compiled_like;
+
+  const map_func_type &f_search = [&json_paths, &paths, &encoded_pattern_dbval, esc_char, find_all,
+				   &compiled_like_p] (const JSON_VALUE &jv, const JSON_PATH &crt_path, bool &stop) -> int
   {
     if (!jv.IsString ())
       {
@@ -2019,7 +2023,7 @@ db_json_search_func (const JSON_DOC &doc, const DB_VALUE *pattern, const DB_VALU
     db_string_put_cs_and_collation (&str_val, INTL_CODESET_UTF8, LANG_COLL_UTF8_BINARY);
 
     int match;
-    int error_code = db_string_like (&str_val, &encoded_pattern_dbval, esc_char, &match);
+    int error_code = db_string_like (&str_val, &encoded_pattern_dbval, esc_char, &compiled_like_p, &match);
     if (error_code != NO_ERROR || !match)
       {
 	return error_code;
@@ -27,6 +27,7 @@
 #include "config.h"
 #include "load_worker_manager.hpp"
 #include "log_append.hpp"
+#include "parallel_query.hpp"
 #include "session.h"
 #include "thread_entry_task.hpp"
 #include "thread_entry.hpp"
@@ -1404,6 +1405,9 @@ shutdown:
   // stop load sessions
   cubload::worker_manager_stop_all ();
 
+  // stop parallel query workers
+  cubquery::px_worker_pool_final ();
+
   /* we should flush all append pages before stop log writer */
   logpb_force_flush_pages (thread_p);
 
@@ -38,6 +38,9 @@
 #include "xasl_generation.h"
 #include "xasl_predicate.hpp"
 
+/* heap pages scanned by each worker of a parallel scan */
+#define QO_PX_PAGES_PER_WORKER 4096
+
 typedef int (*ELIGIBILITY_FN) (QO_TERM *);
 
 static XASL_NODE *make_scan_proc (QO_ENV * env);
@@ -46,6 +49,8 @@ static XASL_NODE *make_mergelist_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE *
 				       BITSET * rght_exprs, PT_NODE * rght_elist);
 static XASL_NODE *make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_NODE * inner_xasl,
 				      PROJECTION_INFO * projection_info);
+static PT_NODE *qo_get_hash_join_input_spec (QO_PLAN * plan);
+static bool qo_is_unique_hash_join_input (QO_ENV * env, QO_PLAN * plan, BITSET * join_segs);
 static XASL_NODE *make_fetch_proc (QO_ENV * env, QO_PLAN * plan);
 static XASL_NODE *make_buildlist_proc (QO_ENV * env, PT_NODE * namelist);
 
@@ -57,6 +62,8 @@ static XASL_NODE *init_list_scan_proc (QO_ENV * env, XASL_NODE * xasl, XASL_NODE
 				       BITSET * predset, int *poslist);
 
 static XASL_NODE *add_access_spec (QO_ENV *, XASL_NODE *, QO_PLAN *);
+static void set_cardinality_feedback (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan);
+static void set_adaptive_join (QO_ENV * env, XASL_NODE * scan, QO_PLAN * outer, QO_PLAN * inner);
 static XASL_NODE *add_scan_proc (QO_ENV * env, XASL_NODE * xasl, XASL_NODE * scan);
 static XASL_NODE *add_fetch_proc (QO_ENV * env, XASL_NODE * xasl, XASL_NODE * proc);
 static XASL_NODE *add_uncorrelated (QO_ENV * env, XASL_NODE * xasl, XASL_NODE * sub);
@@ -65,6 +72,7 @@ static XASL_NODE *add_sort_spec (QO_ENV *, XASL_NODE *, QO_PLAN *, DB_VALUE *, b
 static XASL_NODE *add_if_predicate (QO_ENV *, XASL_NODE *, PT_NODE *);
 static XASL_NODE *add_during_join_predicate (QO_ENV *, XASL_NODE *, PT_NODE *);
 static XASL_NODE *add_after_join_predicate (QO_ENV *, XASL_NODE *, PT_NODE *);
+static XASL_NODE *add_exchange (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan);
 
 static PT_NODE *make_pred_from_bitset (QO_ENV * env, BITSET * predset, ELIGIBILITY_FN safe);
 static void make_pred_from_plan (QO_ENV * env, QO_PLAN * plan, PT_NODE ** key_access_pred, PT_NODE ** access_pred,
@@ -532,6 +540,86 @@ exit_on_error:
   goto exit_on_end;
 }
 
+/*
+ * qo_get_hash_join_input_spec () - get the spec scanned by an input of a hash join
+ *   return: spec, or NULL if the input is not the scan of a single spec
+ *   plan(in): outer or inner plan of the hash join
+ */
+static PT_NODE *
+qo_get_hash_join_input_spec (QO_PLAN * plan)
+{
+  while (plan != NULL && plan->plan_type == QO_PLANTYPE_SORT)
+    {
+      plan = plan->plan_un.sort.subplan;
+    }
+
+  if (plan == NULL || plan->plan_type != QO_PLANTYPE_SCAN)
+    {
+      return NULL;
+    }
+
+  return QO_NODE_ENTITY_SPEC (plan->plan_un.scan.node);
+}
+
+/*
+ * qo_is_unique_hash_join_input () - whether an input of a hash join has no two rows with the same join columns
+ *   return: true if the join columns are unique
+ *   env(in): The optimizer environment
+ *   plan(in): outer or inner plan of the hash join
+ *   join_segs(in): segments of the plan compared by the join terms
+ *
+ * Note: The input is known to be unique when it scans a DISTINCT derived table, such as the ones of unnested
+ *	 subqueries (see qo_unnest_subqueries), and every column of the derived table but the constants is compared.
+ */
+static bool
+qo_is_unique_hash_join_input (QO_ENV * env, QO_PLAN * plan, BITSET * join_segs)
+{
+  PARSER_CONTEXT *parser = QO_ENV_PARSER (env);
+  PT_NODE *spec, *query, *attr, *col;
+  QO_SEGMENT *seg;
+  BITSET_ITERATOR bitset_iter;
+  int seg_index;
+
+  spec = qo_get_hash_join_input_spec (plan);
+  if (spec == NULL || spec->info.spec.derived_table_type != PT_IS_SUBQUERY)
+    {
+      return false;
+    }
+
+  query = spec->info.spec.derived_table;
+  if (query == NULL || query->node_type != PT_SELECT || query->info.query.all_distinct != PT_DISTINCT)
+    {
+      return false;
+    }
+
+  for (attr = spec->info.spec.as_attr_list, col = pt_get_select_list (parser, query); attr != NULL && col != NULL;
+       attr = attr->next, col = col->next)
+    {
+      if (PT_IS_CONST (col))
+	{
+	  continue;
+	}
+
+      for (seg_index = bitset_iterate (join_segs, &bitset_iter); seg_index != -1;
+	   seg_index = bitset_next_member (&bitset_iter))
+	{
+	  seg = QO_ENV_SEG (env, seg_index);
+	  if (QO_NODE_ENTITY_SPEC (QO_SEG_HEAD (seg)) == spec && pt_name_equal (parser, QO_SEG_PT_NODE (seg), attr))
+	    {
+	      break;
+	    }
+	}
+
+      if (seg_index == -1)
+	{
+	  return false;
+	}
+    }
+
+  /* hidden columns are not in as_attr_list */
+  return (attr == NULL && col == NULL);
+}
+
 static XASL_NODE *
 make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_NODE * inner_xasl,
 		    PROJECTION_INFO * projection_info)
@@ -544,8 +632,11 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
   QO_PLAN *outer_plan, *inner_plan;
   QO_TERM *term;
   BITSET term_segs_set;
+  BITSET outer_join_segs, inner_join_segs;
   BITSET_ITERATOR bitset_iter;
   int bitset_index;
+  bool is_outer_unique, is_inner_unique;
+  PT_NODE *inner_spec;
 
   PROJECTION_PART_INFO *outer_info;
   PROJECTION_PART_INFO *inner_info;
@@ -594,6 +685,8 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
   assert (inner_info->expr_count == bitset_cardinality (inner_info->exprs_set));
 
   bitset_init (&term_segs_set, env);
+  bitset_init (&outer_join_segs, env);
+  bitset_init (&inner_join_segs, env);
 
   /**
    * STEP 1: Make XASL for the hash join procedure.
@@ -632,7 +725,6 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
       goto exit_on_error;
     }
 
-  /* Not used, but necessary to prevent a fault when qdump_print_list_merge_info is called. */
   merge_info->ls_outer_unique = (int *) pt_alloc_packing_buf (merge_info->ls_column_cnt * sizeof (int));
   if (merge_info->ls_outer_unique == NULL)
     {
@@ -645,7 +737,6 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
       goto exit_on_error;
     }
 
-  /* Not used, but necessary to prevent a fault when qdump_print_list_merge_info is called. */
   merge_info->ls_inner_unique = (int *) pt_alloc_packing_buf (merge_info->ls_column_cnt * sizeof (int));
   if (merge_info->ls_inner_unique == NULL)
     {
@@ -700,6 +791,7 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
 	    }
 
 	  outer_part = QO_SEG_PT_NODE (QO_ENV_SEG (env, found_index));
+	  bitset_add (&outer_join_segs, found_index);
 
 	  found_index = pt_find_attribute (parser, outer_part, outer_info->expr_name_list);
 	  if (found_index == -1)
@@ -739,6 +831,7 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
 	    }
 
 	  inner_part = QO_SEG_PT_NODE (QO_ENV_SEG (env, found_index));
+	  bitset_add (&inner_join_segs, found_index);
 
 	  found_index = pt_find_attribute (parser, inner_part, inner_info->expr_name_list);
 	  if (found_index == -1)
@@ -749,14 +842,23 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
 
 	  merge_info->ls_inner_column[value_index] = found_index;
 	}
-
-      /* currently, not used */
-      merge_info->ls_outer_unique[value_index] = false;
-      merge_info->ls_inner_unique[value_index] = false;
     }
 
   assert (value_index == merge_info->ls_column_cnt);
 
+  /**
+   * STEP 2-3-1: Mark the join columns of an input that has no duplicate keys.
+   *             Each row probing such an input matches one of its rows at most.
+   */
+  is_outer_unique = qo_is_unique_hash_join_input (env, outer_plan, &outer_join_segs);
+  is_inner_unique = qo_is_unique_hash_join_input (env, inner_plan, &inner_join_segs);
+
+  for (value_index = 0; value_index < merge_info->ls_column_cnt; value_index++)
+    {
+      merge_info->ls_outer_unique[value_index] = is_outer_unique;
+      merge_info->ls_inner_unique[value_index] = is_inner_unique;
+    }
+
   /**
    * STEP 2-4: Set the number of columns for the merged tuple.
    */
@@ -886,10 +988,20 @@ make_hashjoin_proc (QO_ENV * env, QO_PLAN * plan, XASL_NODE * outer_xasl, XASL_N
 	  xasl = add_during_join_predicate (env, xasl, during_join_pred);
 	  parser_free_tree (parser, during_join_pred);
 	}
+
+      /* the outer rows matching an unnested NOT EXISTS/NOT IN are discarded; do not produce them */
+      inner_spec = qo_get_hash_join_input_spec (inner_plan);
+      if (xasl != NULL && merge_info->join_type == JOIN_LEFT && inner_spec != NULL
+	  && PT_IS_SPEC_FLAG_SET (inner_spec, PT_SPEC_FLAG_ANTI_JOIN))
+	{
+	  XASL_SET_FLAG (xasl, XASL_HASH_ANTI_JOIN);
+	}
     }
 
 exit_on_end:
   bitset_delset (&term_segs_set);
+  bitset_delset (&outer_join_segs);
+  bitset_delset (&inner_join_segs);
 
   return xasl;
 
@@ -1003,6 +1115,11 @@ init_class_scan_proc (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan)
       /* free pointer node list */
       parser_free_tree (parser, after_join_pred);
       parser_free_tree (parser, if_pred);
+
+      if (xasl)
+	{
+	  set_cardinality_feedback (env, xasl, plan);
+	}
     }
 
   if (info)
@@ -1131,6 +1248,11 @@ add_access_spec (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan)
   xasl = add_if_predicate (env, xasl, if_pred);
   xasl = pt_to_instnum_pred (QO_ENV_PARSER (env), xasl, instnum_pred);
 
+  if (xasl)
+    {
+      set_cardinality_feedback (env, xasl, plan);
+    }
+
 success:
 
   /* free pointer node list */
@@ -1149,6 +1271,80 @@ exit_on_error:
   goto success;
 }
 
+/*
+ * set_cardinality_feedback () - let the heap scan of a plan measure the selectivity of its predicates
+ *   return:
+ *   env(in): The optimizer environment
+ *   xasl(in): The scan block of the plan
+ *   plan(in): The scan plan
+ *
+ * Note: the server compares the selectivity of the scan with the estimate and keeps it when they are far apart,
+ *	for the next compilation of the plans scanning the class (see qo_apply_cardinality_feedback ()). Only the
+ *	heap scans evaluating all the sargs of their node, and nothing else, in their data filter are measured.
+ */
+static void
+set_cardinality_feedback (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan)
+{
+  ACCESS_SPEC_TYPE *spec = xasl->spec_list;
+  QO_NODE *node = plan->plan_un.scan.node;
+
+  if (spec == NULL || spec->next != NULL || spec->type != TARGET_CLASS || spec->access != ACCESS_METHOD_SEQUENTIAL
+      || spec->where_pred == NULL || xasl->if_pred != NULL || xasl->after_join_pred != NULL)
+    {
+      return;
+    }
+
+  if (!bitset_is_equivalent (&(plan->sarged_terms), &(QO_NODE_SARGS (node))))
+    {
+      return;
+    }
+
+  spec->pred_hash = qo_node_predicate_hash (env, node);
+  spec->est_selectivity = (float) QO_NODE_SELECTIVITY (node);
+}
+
+/*
+ * set_adaptive_join () - let the inner index scan of a nested loop join switch to a hash table
+ *   return:
+ *   env(in): The optimizer environment
+ *   scan(in): The scan block of the inner plan
+ *   outer(in): The outer plan of the join
+ *   inner(in): The inner plan of the join
+ *
+ * Note: the server counts the outer rows probing the index. When they exceed the estimate of the outer plan by far,
+ *	the rest of the probes look up a hash table built from the heap of the inner class (see
+ *	scan_init_adaptive_join ()). Only the index scans of inner joins in SELECT statements can switch.
+ */
+static void
+set_adaptive_join (QO_ENV * env, XASL_NODE * scan, QO_PLAN * outer, QO_PLAN * inner)
+{
+  ACCESS_SPEC_TYPE *spec;
+  QO_INDEX_ENTRY *index_entry;
+  double rows;
+
+  if (scan == NULL || !qo_is_iscan (inner) || !PT_IS_SELECT (env->pt_tree)
+      || PT_SELECT_INFO_IS_FLAGED (env->pt_tree, PT_SELECT_INFO_FOR_UPDATE))
+    {
+      return;
+    }
+
+  /* the heap of a filtered index holds rows the index doesn't */
+  index_entry = inner->plan_un.scan.index->head;
+  if (index_entry->constraints->filter_predicate != NULL || index_entry->constraints->func_index_info != NULL)
+    {
+      return;
+    }
+
+  spec = scan->spec_list;
+  if (spec == NULL || spec->next != NULL || spec->type != TARGET_CLASS || spec->access != ACCESS_METHOD_INDEX)
+    {
+      return;
+    }
+
+  rows = MAX (1.0, outer->info->cardinality);
+  spec->adaptive_join_rows = (rows < (double) DB_INT32_MAX) ? (int) rows : DB_INT32_MAX;
+}
+
 /*
  * add_scan_proc () - Add the scan proc to the end of xasl's scan_ptr list
  *   return: XASL_NODE *
@@ -1173,6 +1369,53 @@ add_scan_proc (QO_ENV * env, XASL_NODE * xasl, XASL_NODE * scan)
   return xasl;
 }
 
+/*
+ * add_exchange () - Set the degree of the exchange gathering the results of
+ *		     xasl when its single scan is worth executing in parallel
+ *   return: XASL_NODE *
+ *   env(in): The optimizer environment
+ *   xasl(in): The XASL block scanning the class of plan
+ *   plan(in): The sequential scan plan
+ *
+ * Note: the server executes the block serially when it has no free workers
+ *       or when the block does something the workers can't (see
+ *       qexec_execute_parallel_scan).
+ */
+static XASL_NODE *
+add_exchange (QO_ENV * env, XASL_NODE * xasl, QO_PLAN * plan)
+{
+  PT_NODE *tree = QO_ENV_PT_TREE (env);
+  QO_NODE *node;
+  int degree;
+
+  if (xasl == NULL || !qo_is_seq_scan (plan))
+    {
+      return xasl;
+    }
+
+  if (tree == NULL || tree->node_type != PT_SELECT || tree->info.query.correlation_level != 0
+      || PT_SELECT_INFO_IS_FLAGED (tree, PT_SELECT_INFO_FOR_UPDATE))
+    {
+      return xasl;
+    }
+
+  node = plan->plan_un.scan.node;
+  if (QO_NODE_INFO (node) == NULL || QO_NODE_IS_CLASS_HIERARCHY (node))
+    {
+      /* derived tables and class hierarchies */
+      return xasl;
+    }
+
+  /* each worker should scan enough pages to pay for its start */
+  degree = MIN (prm_get_integer_value (PRM_ID_PARALLEL_QUERY_DEGREE), QO_NODE_TCARD (node) / QO_PX_PAGES_PER_WORKER);
+  if (degree >= 2)
+    {
+      xasl->px_degree = degree;
+    }
+
+  return xasl;
+}
+
 /*
  * add_fetch_proc () - Create a fetch proc and add it to the *head*
  *			of the list of fetch procs in xasl->fptr
@@ -2135,6 +2378,10 @@ gen_outer (QO_ENV * env, QO_PLAN * plan, BITSET * subqueries, XASL_NODE * inner_
        * performed by the caller.
        */
       xasl = add_access_spec (env, xasl, plan);
+      if (inner_scans == NULL && fetches == NULL)
+	{
+	  xasl = add_exchange (env, xasl, plan);
+	}
       xasl = add_scan_proc (env, xasl, inner_scans);
       xasl = add_fetch_proc (env, xasl, fetches);
       xasl = add_subqueries (env, xasl, &new_subqueries);
@@ -2300,6 +2547,10 @@ gen_outer (QO_ENV * env, QO_PLAN * plan, BITSET * subqueries, XASL_NODE * inner_
 		{
 		  mark_access_as_outer_join (parser, scan);
 		}
+	      else if (join_type == JOIN_INNER)
+		{
+		  set_adaptive_join (env, scan, outer, inner);
+		}
 	    }
 	  bitset_assign (&new_subqueries, &fake_subqueries);
 	  make_outer_instnum (env, outer, plan);
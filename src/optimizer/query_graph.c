@@ -52,6 +52,7 @@
 #include "db.h"
 #include "system_parameter.h"
 #include "memory_alloc.h"
+#include "memory_hash.h"
 #include "environment_variable.h"
 #include "util_func.h"
 #include "locator_cl.h"
@@ -203,6 +204,7 @@ static void qo_estimate_statistics (MOP class_mop, CLASS_STATS *);
 static void qo_node_free (QO_NODE *);
 static void qo_node_dump (QO_NODE *, FILE *);
 static void qo_node_add_sarg (QO_NODE *, QO_TERM *);
+static void qo_apply_cardinality_feedback (QO_ENV * env);
 
 static void qo_seg_free (QO_SEGMENT *);
 
@@ -5037,6 +5039,7 @@ qo_get_attr_info_func_index (QO_ENV * env, QO_SEGMENT * seg, const char *expr_st
   cum_statsp->pkeys_size = 0;
   cum_statsp->pkeys = NULL;
   attr_infop->ndv = 0;
+  attr_infop->zone_map_width = 1.0;
 
   /* set the statistics from the class information(QO_CLASS_INFO_ENTRY) */
   for (i = 0; i < n; class_info_entryp++, i++)
@@ -5217,6 +5220,7 @@ qo_get_attr_info (QO_ENV * env, QO_SEGMENT * seg)
       cum_statsp->pkeys_size = 0;
       cum_statsp->pkeys = NULL;
       attr_infop->ndv = 0;
+      attr_infop->zone_map_width = 1.0;
 
       return attr_infop;
     }
@@ -5231,6 +5235,7 @@ qo_get_attr_info (QO_ENV * env, QO_SEGMENT * seg)
   cum_statsp->pkeys_size = 0;
   cum_statsp->pkeys = NULL;
   attr_infop->ndv = 0;
+  attr_infop->zone_map_width = 0.0;
 
   /* set the statistics from the class information(QO_CLASS_INFO_ENTRY) */
   for (i = 0; i < n; class_info_entryp++, i++)
@@ -5244,6 +5249,7 @@ qo_get_attr_info (QO_ENV * env, QO_SEGMENT * seg)
 	{
 	  /* the attribute statistics of the class were not set */
 	  cum_statsp->is_indexed = false;
+	  attr_infop->zone_map_width = 1.0;
 	  continue;
 	  /* We'll consider the segment to be indexed only if all of the attributes it represents are indexed. The
 	   * current optimization strategy makes it inconvenient to try to construct "mixed" (segment and index) scans
@@ -5272,12 +5278,16 @@ qo_get_attr_info (QO_ENV * env, QO_SEGMENT * seg)
 	{
 	  /* attribute not found, what happens to the class attribute? */
 	  cum_statsp->is_indexed = false;
+	  attr_infop->zone_map_width = 1.0;
 	  continue;
 	}
 
       /* set Number of Distinct Values */
       attr_infop->ndv += attr_statsp->ndv;
 
+      /* zones of all classes are read, the widest decides */
+      attr_infop->zone_map_width = MAX (attr_infop->zone_map_width, attr_statsp->zone_map_width);
+
       if (cum_statsp->valid_limits == false)
 	{
 	  /* first time */
@@ -5875,6 +5885,9 @@ qo_env_new (PARSER_CONTEXT * parser, PT_NODE * query)
       env->plan_dump_enabled = true;
     }
   env->multi_range_opt_candidate = false;
+  env->join_search = QO_JOIN_SEARCH_NONE;
+  env->join_candidates = 0;
+  env->join_search_usec = 0;
 
   return env;
 }
@@ -6137,6 +6150,8 @@ qo_discover_edges (QO_ENV * env)
 	}
     }
 
+  qo_apply_cardinality_feedback (env);
+
   /*
    * Check some invariants.  If something has gone wrong during the
    * discovery phase to violate these invariants, it will mean certain
@@ -8268,6 +8283,119 @@ qo_node_add_sarg (QO_NODE * node, QO_TERM * sarg)
     }
 }
 
+/*
+ * qo_node_predicate_hash () - hash of the shape of the sargs of a node
+ *   return: hash; 0 if the scan of the node cannot measure the selectivity of its sargs
+ *   env(in): optimizer environment
+ *   node(in): node
+ *
+ * Note: the sargs are printed without the names of the specs, and with their host variables as such, so that
+ *       the same predicates on a class have the same hash in every query. The order of the sargs does not matter.
+ */
+unsigned int
+qo_node_predicate_hash (QO_ENV * env, QO_NODE * node)
+{
+  PARSER_CONTEXT *parser = QO_ENV_PARSER (env);
+  BITSET_ITERATOR iter;
+  PT_NODE *pt_expr;
+  unsigned int hash = 0;
+  unsigned int save_custom;
+  const char *text;
+  int t;
+
+  if (QO_NODE_INFO (node) == NULL || QO_NODE_INFO_N (node) != 1 || QO_NODE_IS_CLASS_PARTITIONED (node)
+      || bitset_is_empty (&(QO_NODE_SARGS (node))))
+    {
+      return 0;
+    }
+
+  save_custom = parser->custom_print;
+  parser->custom_print |= PT_SUPPRESS_RESOLVED;
+
+  for (t = bitset_iterate (&(QO_NODE_SARGS (node)), &iter); t != -1; t = bitset_next_member (&iter))
+    {
+      pt_expr = QO_TERM_PT_EXPR (QO_ENV_TERM (env, t));
+      text = (pt_expr != NULL) ? parser_print_tree (parser, pt_expr) : NULL;
+      if (text == NULL)
+	{
+	  hash = 0;
+	  break;
+	}
+      hash += mht_5strhash (text, UINT_MAX);
+    }
+
+  parser->custom_print = save_custom;
+
+  return hash;
+}
+
+/*
+ * qo_apply_cardinality_feedback () - correct the selectivity of the sargs with the one measured by the scans
+ *   return:
+ *   env(in): optimizer environment
+ *
+ * Note: the server keeps the selectivity of the sargs of a class which was found far from the estimate, e.g.
+ *       for correlated predicates. The estimate of each sarg is scaled by the same factor, so that their product
+ *       is the measured selectivity.
+ */
+static void
+qo_apply_cardinality_feedback (QO_ENV * env)
+{
+  QO_NODE *node;
+  QO_TERM *term;
+  CLASS_STATS *stats;
+  BITSET_ITERATOR iter;
+  unsigned int hash;
+  double selectivity, factor;
+  int i, j, t, n;
+
+  for (i = 0; i < env->nnodes; i++)
+    {
+      node = QO_ENV_NODE (env, i);
+
+      if (QO_NODE_INFO (node) == NULL || QO_NODE_INFO (node)->info[0].stats == NULL
+	  || QO_NODE_INFO (node)->info[0].stats->n_feedback <= 0)
+	{
+	  continue;
+	}
+
+      hash = qo_node_predicate_hash (env, node);
+      if (hash == 0)
+	{
+	  continue;
+	}
+
+      stats = QO_NODE_INFO (node)->info[0].stats;
+      for (j = 0; j < stats->n_feedback; j++)
+	{
+	  if (stats->feedback[j].pred_hash == hash)
+	    {
+	      break;
+	    }
+	}
+      if (j >= stats->n_feedback || QO_NODE_SELECTIVITY (node) <= 0.0)
+	{
+	  continue;
+	}
+
+      selectivity = stats->feedback[j].selectivity;
+      if (QO_NODE_NCARD (node) > 0)
+	{
+	  selectivity = MAX (selectivity, 1.0 / (double) QO_NODE_NCARD (node));
+	}
+
+      n = bitset_cardinality (&(QO_NODE_SARGS (node)));
+      factor = pow (selectivity / QO_NODE_SELECTIVITY (node), 1.0 / n);
+      for (t = bitset_iterate (&(QO_NODE_SARGS (node)), &iter); t != -1; t = bitset_next_member (&iter))
+	{
+	  term = QO_ENV_TERM (env, t);
+	  QO_TERM_SELECTIVITY (term) = MIN (QO_TERM_SELECTIVITY (term) * factor, 1.0);
+	}
+
+      QO_NODE_SELECTIVITY (node) = selectivity;
+    }
+}
+
 /*
  * qo_node_fprint () -
  *   return:
@@ -95,6 +95,7 @@ struct qo_attr_info
   /* cumulative stats for all attributes under this umbrella */
   QO_ATTR_CUM_STATS cum_stats;
   INT64 ndv;			/* Number of Distinct Values of column */
+  double zone_map_width;	/* fraction of the value range covered by a heap zone; 1 without zone map */
 };
 
 struct qo_index_entry
@@ -848,6 +849,14 @@ typedef enum
 				 * limit */
 } QO_SORT_LIMIT_USE;
 
+typedef enum
+{
+  QO_JOIN_SEARCH_NONE,		/* no join */
+  QO_JOIN_SEARCH_PERMUTATION,	/* left-deep permutations of the nodes, a window of nodes at a time */
+  QO_JOIN_SEARCH_DP,		/* dynamic programming over the connected subsets of nodes */
+  QO_JOIN_SEARCH_DP_OVER_BUDGET	/* permutations, after the dynamic programming ran out of planning budget */
+} QO_JOIN_SEARCH;
+
 struct qo_env
 {
   /*
@@ -960,6 +969,14 @@ struct qo_env
    * large, this is set to true.
    */
   bool multi_range_opt_candidate;
+
+  /*
+   * How the join orders were searched, the number of joins examined and
+   * the time spent on them; printed with the plan.
+   */
+  QO_JOIN_SEARCH join_search;
+  int join_candidates;
+  UINT64 join_search_usec;
 };
 
 #define QO_ENV_SEG(env, n)		(&(env)->segs[(n)])
@@ -1036,6 +1053,7 @@ struct qo_xasl_index_info
 extern void qo_env_free (QO_ENV *);
 extern void qo_seg_fprint (QO_SEGMENT *, FILE *);
 extern void qo_node_fprint (QO_NODE *, FILE *);
+extern unsigned int qo_node_predicate_hash (QO_ENV * env, QO_NODE * node);
 extern void qo_term_fprint (QO_TERM *, FILE *);
 extern void qo_print_stats (FILE *);
 extern void qo_eqclass_fprint_wrt (QO_EQCLASS *, BITSET *, FILE *);
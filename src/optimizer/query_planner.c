@@ -51,6 +51,7 @@
 #include "network_interface_cl.h"
 #include "dbtype.h"
 #include "regu_var.hpp"
+#include "tsc_timer.h"
 
 #define INDENT_INCR		4
 #define INDENT_FMT		"%*c"
@@ -89,6 +90,9 @@
 #define	qo_follow_free	qo_generic_free
 #define	qo_worst_free	qo_generic_free
 
+/* the dynamic programming keeps an info for each connected subset of nodes */
+#define QO_JOIN_DP_MAX_NODES 20
+
 #define QO_INFO_INDEX(_M_offset, _bitset)  \
     (_M_offset + (unsigned int)(BITPATTERN(_bitset) & planner->node_mask))
 
@@ -200,6 +204,8 @@ static int qo_compute_projected_size (QO_PLANNER *, BITSET *);
 
 static QO_PLANNER *qo_alloc_planner (QO_ENV *);
 static void qo_clean_planner (QO_PLANNER *);
+static QO_INFO *qo_search_partition_join_dp (QO_PLANNER *, QO_PARTITION *, PT_HINT_ENUM, BITSET *, BITSET *,
+					     TSC_TICKS, bool *);
 static QO_INFO *qo_search_partition_join (QO_PLANNER *, QO_PARTITION *, BITSET *);
 static QO_PLAN *qo_search_partition (QO_PLANNER *, QO_PARTITION *, QO_EQCLASS *, BITSET *);
 static QO_PLAN *qo_search_planner (QO_PLANNER *);
@@ -430,6 +436,7 @@ static double qo_and_selectivity (QO_ENV * env, double lhs_sel, double rhs_sel);
 static double qo_not_selectivity (QO_ENV * env, double sel);
 
 static double qo_equal_selectivity (QO_ENV * env, PT_NODE * pt_expr);
+static double qo_plan_variant_selectivity (QO_ENV * env, PT_NODE * pt_host_var);
 
 static double qo_comp_selectivity (QO_ENV * env, PT_NODE * pt_expr);
 
@@ -1538,8 +1545,79 @@ static void
 qo_sscan_cost (QO_PLAN * planp)
 {
   QO_NODE *nodep;
+  QO_ENV *env;
+  QO_TERM *termp;
+  QO_SEGMENT *segp;
+  BITSET_ITERATOR iter;
+  double read_fraction, term_fraction;
+  bool is_trigram_term;
+  int t;
 
   nodep = planp->plan_un.scan.node;
+  env = planp->info->env;
+
+  /* pages of heap zones that cannot satisfy a sarg are skipped (see heap_zone_map.hpp); a zone is read if it covers
+   * the selected values, which are about selectivity + zone width of the value range. string attributes are
+   * summarized by trigrams instead, and their width is the chance that a trigram seems to be in a zone without it;
+   * it applies to LIKE and REGEXP only. */
+  read_fraction = 1.0;
+  for (t = bitset_iterate (&(planp->sarged_terms), &iter); t != -1; t = bitset_next_member (&iter))
+    {
+      termp = QO_ENV_TERM (env, t);
+      if (QO_TERM_CLASS (termp) != QO_TC_SARG || QO_TERM_IS_FLAGED (termp, QO_TERM_RANGELIST)
+	  || QO_TERM_IS_FLAGED (termp, QO_TERM_OR_PRED) || QO_TERM_PT_EXPR (termp) == NULL
+	  || QO_TERM_PT_EXPR (termp)->node_type != PT_EXPR)
+	{
+	  continue;
+	}
+
+      is_trigram_term = false;
+      switch (QO_TERM_PT_EXPR (termp)->info.expr.op)
+	{
+	case PT_EQ:
+	case PT_LT:
+	case PT_LE:
+	case PT_GT:
+	case PT_GE:
+	case PT_BETWEEN:
+	case PT_IS_NULL:
+	  break;
+	case PT_LIKE:
+	case PT_RLIKE:
+	case PT_RLIKE_BINARY:
+	  is_trigram_term = true;
+	  break;
+	default:
+	  continue;
+	}
+
+      if (is_trigram_term)
+	{
+	  /* LIKE is not always indexable; the term must read a single attribute */
+	  if (bitset_cardinality (&(QO_TERM_SEGS (termp))) != 1)
+	    {
+	      continue;
+	    }
+	  segp = QO_ENV_SEG (env, bitset_first_member (&(QO_TERM_SEGS (termp))));
+	}
+      else
+	{
+	  if (!QO_TERM_CAN_USE_INDEX (termp))
+	    {
+	      continue;
+	    }
+	  segp = QO_TERM_INDEX_SEG (termp, 0);
+	}
+      if (segp == NULL || QO_SEG_INFO (segp) == NULL || QO_SEG_INFO (segp)->zone_map_width >= 1.0
+	  || QO_SEG_PT_NODE (segp) == NULL || PT_IS_CHAR_STRING_TYPE (QO_SEG_PT_NODE (segp)->type_enum) != is_trigram_term)
+	{
+	  continue;
+	}
+
+      term_fraction = MIN (1.0, QO_TERM_SELECTIVITY (termp) + QO_SEG_INFO (segp)->zone_map_width);
+      read_fraction = MIN (read_fraction, term_fraction);
+    }
+
   planp->fixed_cpu_cost = 0.0;
   planp->fixed_io_cost = 0.0;
   if (QO_NODE_NCARD (nodep) == 0)
@@ -1550,7 +1628,7 @@ qo_sscan_cost (QO_PLAN * planp)
     {
       planp->variable_cpu_cost = (double) QO_NODE_NCARD (nodep) * (double) QO_CPU_WEIGHT;
     }
-  planp->variable_io_cost = (double) QO_NODE_TCARD (nodep);
+  planp->variable_io_cost = (double) QO_NODE_TCARD (nodep) * read_fraction;
 }
 
 /*
@@ -4859,6 +4937,16 @@ qo_plan_dump (QO_PLAN * plan, FILE * output)
       qo_plan_lite_print (plan, output, 0);
     }
 
+  if (plan->info != NULL && plan->info->env != NULL && plan->info->env->join_search != QO_JOIN_SEARCH_NONE)
+    {
+      QO_ENV *env = plan->info->env;
+
+      fprintf (output, "\nJoin search: %s, %d joins considered, %.3f ms\n",
+	       (env->join_search == QO_JOIN_SEARCH_DP) ? "connected subsets"
+	       : (env->join_search == QO_JOIN_SEARCH_DP_OVER_BUDGET) ? "permutations (over planning budget)"
+	       : "permutations", env->join_candidates, (double) env->join_search_usec / 1000.0);
+    }
+
   fputs ("\n", output);
 }
 
@@ -7371,6 +7459,8 @@ planner_visit_node (QO_PLANNER * planner, QO_PARTITION * partition, PT_HINT_ENUM
     int kept = 0;
     int idx_join_plan_n = 0;
 
+    planner->env->join_candidates++;
+
     /* for path-term, if join order is correct, we can use follow. */
     if (follow_term && (QO_NODE_IDX (QO_TERM_TAIL (follow_term)) == QO_NODE_IDX (tail_node)))
       {
@@ -8754,12 +8844,190 @@ qo_clean_planner (QO_PLANNER * planner)
  * Refer Sybase Ataptive Server
  */
 
+/*
+ * qo_search_partition_join_dp () - search the join orders of a partition by
+ *                                  dynamic programming over its connected
+ *                                  subsets of nodes
+ *   return: info of the whole partition; NULL if not found
+ *   planner(in):
+ *   partition(in):
+ *   hint(in):
+ *   partition_terms(in): terms of the partition
+ *   remaining_subqueries(in):
+ *   start_tick(in): start of the search of the partition
+ *   is_over_budget(out): the search was given up at the planning budget
+ *
+ * Note: The subsets are extended by increasing size. A subset joined with
+ *       each node outside of it gives a subset of the next size, whose info
+ *       keeps the best plans of all the joins giving it. planner_visit_node
+ *       does not make cross joins, so only connected subsets get an info
+ *       and are extended, and every join order of the partition is covered
+ *       once per subset instead of once per prefix. The inner of a join is
+ *       still a single node, as the index and nested-loop joins need.
+ */
+static QO_INFO *
+qo_search_partition_join_dp (QO_PLANNER * planner, QO_PARTITION * partition, PT_HINT_ENUM hint,
+			     BITSET * partition_terms, BITSET * remaining_subqueries, TSC_TICKS start_tick,
+			     bool * is_over_budget)
+{
+  QO_ENV *env = planner->env;
+  QO_NODE *rel_nodes[QO_JOIN_DP_MAX_NODES];
+  QO_NODE *head_node, *tail_node;
+  QO_INFO *head_info;
+  QO_SUBQUERY *subq;
+  BITSET visited_nodes;
+  BITSET visited_rel_nodes;
+  BITSET visited_terms;
+  BITSET nested_path_nodes;
+  BITSET remaining_nodes;
+  BITSET remaining_terms;
+  BITSET head_subqueries;
+  BITSET_ITERATOR bi;
+  TSC_TICKS now_tick;
+  UINT64 budget_usec;
+  unsigned int head_mask, full_mask, low_bit, ripple;
+  int nodes_cnt, size, i, r, t;
+
+  *is_over_budget = false;
+  budget_usec = (UINT64) prm_get_integer_value (PRM_ID_OPTIMIZER_JOIN_PLANNING_BUDGET) * 1000;
+
+  bitset_init (&visited_nodes, env);
+  bitset_init (&visited_rel_nodes, env);
+  bitset_init (&visited_terms, env);
+  bitset_init (&nested_path_nodes, env);
+  bitset_init (&remaining_nodes, env);
+  bitset_init (&remaining_terms, env);
+  bitset_init (&head_subqueries, env);
+
+  nodes_cnt = 0;
+  for (i = bitset_iterate (&(QO_PARTITION_NODES (partition)), &bi); i != -1; i = bitset_next_member (&bi))
+    {
+      rel_nodes[QO_NODE_REL_IDX (QO_ENV_NODE (env, i))] = QO_ENV_NODE (env, i);
+      nodes_cnt++;
+    }
+  assert (nodes_cnt <= QO_JOIN_DP_MAX_NODES);
+  full_mask = (1U << nodes_cnt) - 1;
+
+  for (size = 1; size < nodes_cnt; size++)
+    {
+      /* the joins of this level give the subsets of size + 1 nodes */
+      planner->join_unit = size + 1;
+      planner->best_info = NULL;
+
+      /* the subsets of size nodes, as masks of relative node indexes in increasing order */
+      head_mask = (1U << size) - 1;
+      while (head_mask <= full_mask)
+	{
+	  BITSET_CLEAR (visited_nodes);
+	  BITSET_CLEAR (visited_rel_nodes);
+	  head_node = NULL;
+	  for (r = 0; r < nodes_cnt; r++)
+	    {
+	      if (head_mask & (1U << r))
+		{
+		  head_node = rel_nodes[r];
+		  bitset_add (&visited_nodes, QO_NODE_IDX (head_node));
+		  bitset_add (&visited_rel_nodes, r);
+		}
+	    }
+
+	  if (size == 1)
+	    {
+	      /* the outermost node must not depend on others */
+	      head_info = planner->node_info[QO_NODE_IDX (head_node)];
+	      if (!bitset_is_empty (&(QO_NODE_DEP_SET (head_node)))
+		  || !bitset_is_empty (&(QO_NODE_OUTER_DEP_SET (head_node))))
+		{
+		  head_info = NULL;
+		}
+	    }
+	  else
+	    {
+	      head_info = planner->join_info[QO_PARTITION_M_OFFSET (partition) + head_mask];
+	    }
+
+	  if (head_info == NULL || head_info->best_no_order.nplans == 0)
+	    {
+	      goto next_head;
+	    }
+
+	  bitset_assign (&remaining_nodes, &(QO_PARTITION_NODES (partition)));
+	  bitset_difference (&remaining_nodes, &visited_nodes);
+
+	  bitset_assign (&visited_terms, &(head_info->terms));
+	  bitset_assign (&remaining_terms, partition_terms);
+	  bitset_difference (&remaining_terms, &visited_terms);
+
+	  /* the subqueries pinned by the plans of the subset are not pinned again */
+	  bitset_assign (&head_subqueries, remaining_subqueries);
+	  for (i = bitset_iterate (remaining_subqueries, &bi); i != -1; i = bitset_next_member (&bi))
+	    {
+	      subq = &planner->subqueries[i];
+	      if (bitset_subset (&visited_nodes, &(subq->nodes)) && bitset_subset (&visited_terms, &(subq->terms)))
+		{
+		  bitset_remove (&head_subqueries, i);
+		}
+	    }
+
+	  for (t = 0; t < nodes_cnt; t++)
+	    {
+	      if (head_mask & (1U << t))
+		{
+		  continue;
+		}
+
+	      tail_node = rel_nodes[t];
+	      if (!bitset_subset (&visited_nodes, &(QO_NODE_DEP_SET (tail_node)))
+		  || !bitset_subset (&visited_nodes, &(QO_NODE_OUTER_DEP_SET (tail_node))))
+		{
+		  continue;
+		}
+
+	      BITSET_CLEAR (nested_path_nodes);
+	      planner_visit_node (planner, partition, hint, head_node, tail_node, &visited_nodes, &visited_rel_nodes,
+				  &visited_terms, &nested_path_nodes, &remaining_nodes, &remaining_terms,
+				  &head_subqueries, 0);
+
+	      tsc_getticks (&now_tick);
+	      if (tsc_elapsed_utime (now_tick, start_tick) > budget_usec)
+		{
+		  *is_over_budget = true;
+		  planner->best_info = NULL;
+		  goto end;
+		}
+	    }
+
+	next_head:
+	  /* next mask with as many bits */
+	  low_bit = head_mask & (~head_mask + 1);
+	  ripple = head_mask + low_bit;
+	  head_mask = (((ripple ^ head_mask) >> 2) / low_bit) | ripple;
+	}
+    }
+
+end:
+  bitset_delset (&visited_nodes);
+  bitset_delset (&visited_rel_nodes);
+  bitset_delset (&visited_terms);
+  bitset_delset (&nested_path_nodes);
+  bitset_delset (&remaining_nodes);
+  bitset_delset (&remaining_terms);
+  bitset_delset (&head_subqueries);
+
+  return planner->best_info;
+}
+
 /*
  * qo_search_partition_join () -
  *   return:
  *   planner(in):
  *   partition(in):
  *   remaining_subqueries(in):
+ *
+ * Note: Joins of more nodes than the permutations search at once are
+ *       searched by dynamic programming first, within the planning budget
+ *       (optimizer_join_planning_budget, in milliseconds). Past the budget,
+ *       the permutations search them a window of nodes at a time.
  */
 static QO_INFO *
 qo_search_partition_join (QO_PLANNER * planner, QO_PARTITION * partition, BITSET * remaining_subqueries)
@@ -8778,8 +9046,12 @@ qo_search_partition_join (QO_PLANNER * planner, QO_PARTITION * partition, BITSET
   BITSET nested_path_nodes;
   BITSET remaining_nodes;
   BITSET remaining_terms;
+  TSC_TICKS start_tick, end_tick;
+  bool is_over_budget;
+  int join_unit;
 
   env = planner->env;
+  tsc_getticks (&start_tick);
   bitset_init (&visited_nodes, env);
   bitset_init (&visited_rel_nodes, env);
   bitset_init (&visited_terms, env);
@@ -8828,6 +9100,26 @@ qo_search_partition_join (QO_PLANNER * planner, QO_PARTITION * partition, BITSET
       planner->join_unit = (nodes_cnt <= 25) ? MIN (8, nodes_cnt) : (nodes_cnt <= 37) ? 3 : 2;
     }
 
+  env->join_search = QO_JOIN_SEARCH_PERMUTATION;
+  if (planner->join_unit < nodes_cnt && nodes_cnt <= QO_JOIN_DP_MAX_NODES
+      && prm_get_integer_value (PRM_ID_OPTIMIZER_JOIN_PLANNING_BUDGET) > 0)
+    {
+      /* the permutations would not search all of the join orders */
+      join_unit = planner->join_unit;
+      if (qo_search_partition_join_dp (planner, partition, hint, &remaining_terms, remaining_subqueries, start_tick,
+				       &is_over_budget) != NULL)
+	{
+	  env->join_search = QO_JOIN_SEARCH_DP;
+	  goto end;
+	}
+
+      if (is_over_budget)
+	{
+	  env->join_search = QO_JOIN_SEARCH_DP_OVER_BUDGET;
+	}
+      planner->join_unit = join_unit;
+    }
+
   /* STEP 1: do join search with visited nodes */
 
   node = NULL;			/* init */
@@ -8905,6 +9197,10 @@ qo_search_partition_join (QO_PLANNER * planner, QO_PARTITION * partition, BITSET
 
     }
 
+end:
+  tsc_getticks (&end_tick);
+  env->join_search_usec += tsc_elapsed_utime (end_tick, start_tick);
+
   bitset_delset (&visited_rel_nodes);
   bitset_delset (&visited_nodes);
   bitset_delset (&visited_terms);
@@ -9358,6 +9654,36 @@ qo_not_selectivity (QO_ENV * env, double sel)
   return 1.0 - sel;
 }
 
+/*
+ * qo_plan_variant_selectivity () - selectivity of the equality of an attribute with a host variable, known to the
+ *				    plan variant being compiled
+ *   return: selectivity, or a negative value if unknown
+ *   env(in):
+ *   pt_host_var(in): host variable
+ *
+ * Note: plan variants are compiled for the values of host variables that are frequent in their column (see
+ *	 do_execute_select). The selectivity stands for the bucket of frequencies of the value.
+ */
+static double
+qo_plan_variant_selectivity (QO_ENV * env, PT_NODE * pt_host_var)
+{
+  PARSER_CONTEXT *parser = QO_ENV_PARSER (env);
+  int index;
+
+  if (parser->plan_variant_selectivity == NULL || pt_host_var->node_type != PT_HOST_VAR)
+    {
+      return -1.0;
+    }
+
+  index = pt_host_var->info.host_var.index;
+  if (index < 0 || index >= parser->host_var_count + parser->auto_param_count)
+    {
+      return -1.0;
+    }
+
+  return parser->plan_variant_selectivity[index];
+}
+
 /*
  * qo_equal_selectivity () - Compute the selectivity of an equality predicate
  *   return: double
@@ -9415,6 +9741,12 @@ qo_equal_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	case PC_OTHER:
 	  /* attr = const */
 
+	  /* the plan variant being compiled may know how frequent the value of the host variable is */
+	  if (pc_rhs == PC_HOST_VAR && (selectivity = qo_plan_variant_selectivity (env, rhs)) >= 0.0)
+	    {
+	      break;
+	    }
+
 	  /* check for index on the attribute.  NOTE: For an equality predicate, we treat subqueries as constants. */
 	  lhs_icard = qo_index_cardinality (env, lhs);
 	  if (lhs_icard != 0)
@@ -9447,6 +9779,11 @@ qo_equal_selectivity (QO_ENV * env, PT_NODE * pt_expr)
 	case PC_ATTR:
 	  /* const = attr */
 
+	  if (pc_lhs == PC_HOST_VAR && (selectivity = qo_plan_variant_selectivity (env, lhs)) >= 0.0)
+	    {
+	      break;
+	    }
+
 	  /* check for index on the attribute.  NOTE: For an equality predicate, we treat subqueries as constants. */
 	  rhs_icard = qo_index_cardinality (env, rhs);
 	  if (rhs_icard != 0)
@@ -102,6 +102,16 @@ struct qo_reset_location_info
   bool found_outerjoin;
 };
 
+typedef struct qo_unnest_corr_info QO_UNNEST_CORR_INFO;
+struct qo_unnest_corr_info
+{
+  int depth;			/* queries entered below the walked expression */
+  int max_level;		/* farthest enclosing scope referenced, relative to the walked expression */
+  bool has_local_name;		/* references a name of the walked expression's own scope */
+  bool has_query;		/* contains a subquery */
+  bool has_path;		/* contains a path expression */
+};
+
 typedef struct qo_reduce_reference_info
 {
   PT_NODE *pk_spec;
@@ -8389,6 +8399,632 @@ qo_rewrite_subqueries (PARSER_CONTEXT * parser, PT_NODE * node, void *arg, int *
   return node;
 }
 
+/*
+ * qo_get_unnest_corr_info_pre () - collect the scopes referenced by an expression
+ *   return: PT_NODE *
+ *   parser(in):
+ *   node(in):
+ *   arg(in/out): QO_UNNEST_CORR_INFO
+ *   continue_walk(in):
+ *
+ * Note: do parser_walk_tree() pre function
+ */
+static PT_NODE *
+qo_get_unnest_corr_info_pre (PARSER_CONTEXT * parser, PT_NODE * node, void *arg, int *continue_walk)
+{
+  QO_UNNEST_CORR_INFO *info = (QO_UNNEST_CORR_INFO *) arg;
+
+  if (PT_IS_QUERY_NODE_TYPE (node->node_type))
+    {
+      info->has_query = true;
+      info->depth++;
+    }
+  else if (node->node_type == PT_DOT_)
+    {
+      info->has_path = true;
+    }
+  else if (node->node_type == PT_NAME && node->info.name.spec_id != 0)
+    {
+      if (node->info.name.correlation_level > info->depth)
+	{
+	  info->max_level = MAX (info->max_level, node->info.name.correlation_level - info->depth);
+	}
+      else if (info->depth == 0)
+	{
+	  info->has_local_name = true;
+	}
+    }
+
+  return node;
+}
+
+/*
+ * qo_get_unnest_corr_info_post () -
+ *   return: PT_NODE *
+ *   parser(in):
+ *   node(in):
+ *   arg(in/out): QO_UNNEST_CORR_INFO
+ *   continue_walk(in):
+ *
+ * Note: do parser_walk_tree() post function
+ */
+static PT_NODE *
+qo_get_unnest_corr_info_post (PARSER_CONTEXT * parser, PT_NODE * node, void *arg, int *continue_walk)
+{
+  QO_UNNEST_CORR_INFO *info = (QO_UNNEST_CORR_INFO *) arg;
+
+  if (PT_IS_QUERY_NODE_TYPE (node->node_type))
+    {
+      info->depth--;
+    }
+
+  return node;
+}
+
+/*
+ * qo_get_unnest_corr_info () - get the scopes referenced by an expression (list)
+ *   return:
+ *   parser(in):
+ *   node(in): expression of a query; the whole list is walked
+ *   info(out):
+ */
+static void
+qo_get_unnest_corr_info (PARSER_CONTEXT * parser, PT_NODE * node, QO_UNNEST_CORR_INFO * info)
+{
+  info->depth = 0;
+  info->max_level = 0;
+  info->has_local_name = false;
+  info->has_query = false;
+  info->has_path = false;
+
+  (void) parser_walk_tree (parser, node, qo_get_unnest_corr_info_pre, info, qo_get_unnest_corr_info_post, info);
+}
+
+/*
+ * qo_is_unnest_key () - check whether an expression can be a key of an unnested subquery
+ *   return: true if the expression references only the given scope and can be hashed
+ *   parser(in):
+ *   node(in): expression, not linked to a list
+ *   level(in): 0 for an expression of the subquery, 1 for one of the outer query
+ */
+static bool
+qo_is_unnest_key (PARSER_CONTEXT * parser, PT_NODE * node, int level)
+{
+  QO_UNNEST_CORR_INFO info;
+
+  if (node == NULL || node->next != NULL || PT_IS_COLLECTION_TYPE (node->type_enum)
+      || !tp_valid_indextype (pt_type_enum_to_db (node->type_enum)))
+    {
+      return false;
+    }
+
+  qo_get_unnest_corr_info (parser, node, &info);
+  if (info.has_query || info.has_path || info.max_level != level)
+    {
+      return false;
+    }
+
+  /* an expression of the subquery must reference it, one of the outer query must not */
+  return (level == 0) ? info.has_local_name : !info.has_local_name;
+}
+
+/*
+ * qo_is_unnest_corr_term () - check whether a term of a subquery is an equality with the outer query
+ *   return: true if the term is 'subquery-expr = outer-expr' (either way round)
+ *   parser(in):
+ *   term(in): term of the subquery, not linked to a list
+ */
+static bool
+qo_is_unnest_corr_term (PARSER_CONTEXT * parser, PT_NODE * term)
+{
+  PT_NODE *arg1, *arg2;
+
+  if (term->node_type != PT_EXPR || term->info.expr.op != PT_EQ || term->or_next != NULL
+      || term->info.expr.location != 0)
+    {
+      return false;
+    }
+
+  arg1 = term->info.expr.arg1;
+  arg2 = term->info.expr.arg2;
+
+  return ((qo_is_unnest_key (parser, arg1, 0) && qo_is_unnest_key (parser, arg2, 1))
+	  || (qo_is_unnest_key (parser, arg1, 1) && qo_is_unnest_key (parser, arg2, 0)));
+}
+
+/*
+ * qo_check_unnest_subquery () - check whether a subquery can be joined to its outer query
+ *   return: number of correlated equalities of the subquery, or -1 if it cannot be unnested
+ *   parser(in):
+ *   subquery(in): subquery whose WHERE clause is in CNF
+ *
+ * Note: The subquery must be a plain SELECT, correlated with the query directly enclosing it through equalities
+ *	 only, each between an expression of its own and one of the outer query. Its other terms, FROM clause and
+ *	 nested subqueries must not reference the outer query.
+ */
+static int
+qo_check_unnest_subquery (PARSER_CONTEXT * parser, PT_NODE * subquery)
+{
+  PT_NODE *term, *save_next;
+  QO_UNNEST_CORR_INFO info;
+  int corr_term_cnt = 0;
+
+  if (subquery == NULL || subquery->node_type != PT_SELECT || PT_IS_VALUE_QUERY (subquery)
+      || subquery->info.query.correlation_level > 1)
+    {
+      return -1;
+    }
+
+  if (subquery->info.query.q.select.group_by != NULL || subquery->info.query.q.select.having != NULL
+      || subquery->info.query.q.select.connect_by != NULL || subquery->info.query.q.select.start_with != NULL
+      || subquery->info.query.limit != NULL || subquery->info.query.orderby_for != NULL
+      || subquery->info.query.with != NULL)
+    {
+      return -1;
+    }
+
+  if ((subquery->info.query.q.select.hint & PT_HINT_QUERY_CACHE)
+      || PT_SELECT_INFO_IS_FLAGED (subquery, PT_SELECT_INFO_FOR_UPDATE))
+    {
+      return -1;
+    }
+
+  if (pt_has_aggregate (parser, subquery) || pt_has_analytic (parser, subquery)
+      || pt_has_inst_in_where_and_select_list (parser, subquery))
+    {
+      return -1;
+    }
+
+  qo_get_unnest_corr_info (parser, subquery->info.query.q.select.from, &info);
+  if (info.max_level != 0 || info.has_path)
+    {
+      return -1;
+    }
+
+  for (term = subquery->info.query.q.select.where; term != NULL; term = term->next)
+    {
+      /* cut-off link */
+      save_next = term->next;
+      term->next = NULL;
+
+      qo_get_unnest_corr_info (parser, term, &info);
+      if (info.max_level == 0 && !info.has_path)
+	{
+	  /* local term, remains in the subquery */
+	}
+      else if (qo_is_unnest_corr_term (parser, term))
+	{
+	  corr_term_cnt++;
+	}
+      else
+	{
+	  corr_term_cnt = -1;
+	}
+
+      /* restore link */
+      term->next = save_next;
+
+      if (corr_term_cnt < 0)
+	{
+	  return -1;
+	}
+    }
+
+  return corr_term_cnt;
+}
+
+/*
+ * qo_clear_name_correlation () - reset the correlation level of names moved to the outer query
+ *   return: PT_NODE *
+ *   parser(in):
+ *   node(in):
+ *   arg(in):
+ *   continue_walk(in):
+ *
+ * Note: do parser_walk_tree() pre function
+ */
+static PT_NODE *
+qo_clear_name_correlation (PARSER_CONTEXT * parser, PT_NODE * node, void *arg, int *continue_walk)
+{
+  if (node->node_type == PT_NAME)
+    {
+      node->info.name.correlation_level = 0;
+    }
+
+  return node;
+}
+
+/*
+ * qo_unnest_subquery () - join a subquery to its outer query through a derived table
+ *   return: terms that replace the subquery predicate in the WHERE clause, or NULL on error
+ *   parser(in):
+ *   node(in): SELECT node, outer query
+ *   subquery(in): subquery checked by qo_check_unnest_subquery()
+ *   in_arg(in): left operand of IN/NOT IN, compared with the select list of the subquery; NULL for [NOT] EXISTS
+ *   is_anti(in): true for NOT EXISTS/NOT IN
+ *   idx(in/out): seqno of the generated names
+ *
+ * Note: The correlated equalities are taken out of the subquery, whose select list becomes the subquery side of
+ *	 them and is made DISTINCT, so that each row of the outer query matches at most one row of the derived table.
+ *	 A semi join is then an inner join on the equalities:
+ *	   ... WHERE EXISTS (SELECT ... FROM t WHERE t.b = o.a AND ...)
+ *	     => ... FROM ..., (SELECT DISTINCT t.b FROM t WHERE ...) av (av1) WHERE av1 = o.a
+ *	 and an anti join a left outer join keeping the outer rows without a match:
+ *	   ... WHERE NOT EXISTS (SELECT ... FROM t WHERE t.b = o.a AND ...)
+ *	     => ... FROM ... LEFT JOIN (SELECT DISTINCT t.b FROM t WHERE ...) av (av1) ON av1 = o.a WHERE av1 IS NULL
+ *	 A matched row of the derived table cannot have a NULL key, since it was equal to a value of the outer row.
+ */
+static PT_NODE *
+qo_unnest_subquery (PARSER_CONTEXT * parser, PT_NODE * node, PT_NODE * subquery, PT_NODE * in_arg, bool is_anti,
+		    int *idx)
+{
+  PT_NODE *term, *next, *prev, *arg1, *arg2;
+  PT_NODE *inner_exprs, *outer_exprs, *inner_expr, *outer_expr;
+  PT_NODE *new_spec, *new_attr, *new_terms, *spec;
+  RESET_LOCATION_INFO locate_info;
+  short location;
+
+  inner_exprs = outer_exprs = NULL;
+  new_terms = NULL;
+
+  if (in_arg != NULL)
+    {
+      /* 'in_arg IN (SELECT col ...)' is the equality col = in_arg */
+      inner_exprs = subquery->info.query.q.select.list;
+      subquery->info.query.q.select.list = NULL;
+      outer_exprs = in_arg;
+    }
+  else
+    {
+      parser_free_tree (parser, subquery->info.query.q.select.list);
+      subquery->info.query.q.select.list = NULL;
+    }
+
+  /* take the correlated equalities out of the subquery */
+  for (prev = NULL, term = subquery->info.query.q.select.where; term != NULL; term = next)
+    {
+      QO_UNNEST_CORR_INFO info;
+
+      next = term->next;
+      term->next = NULL;
+
+      qo_get_unnest_corr_info (parser, term, &info);
+      if (info.max_level == 0)
+	{
+	  /* local term */
+	  term->next = next;
+	  prev = term;
+	  continue;
+	}
+
+      if (prev == NULL)
+	{
+	  subquery->info.query.q.select.where = next;
+	}
+      else
+	{
+	  prev->next = next;
+	}
+
+      arg1 = term->info.expr.arg1;
+      arg2 = term->info.expr.arg2;
+      term->info.expr.arg1 = NULL;
+      term->info.expr.arg2 = NULL;
+      parser_free_tree (parser, term);
+
+      if (qo_is_unnest_key (parser, arg1, 0))
+	{
+	  inner_expr = arg1;
+	  outer_expr = arg2;
+	}
+      else
+	{
+	  inner_expr = arg2;
+	  outer_expr = arg1;
+	}
+
+      (void) parser_walk_tree (parser, outer_expr, qo_clear_name_correlation, NULL, NULL, NULL);
+
+      inner_exprs = parser_append_node (inner_expr, inner_exprs);
+      outer_exprs = parser_append_node (outer_expr, outer_exprs);
+    }
+
+  subquery->info.query.q.select.list = inner_exprs;
+  subquery->info.query.all_distinct = PT_DISTINCT;
+  subquery->info.query.correlation_level = 0;
+
+  /* make new derived spec and append it to FROM */
+  if (mq_make_derived_spec (parser, node, subquery, idx, &new_spec, &new_attr) == NULL)
+    {
+      return NULL;
+    }
+
+  /* create 'outer-expr = attr' */
+  for (outer_expr = outer_exprs; outer_expr != NULL && new_attr != NULL; outer_expr = next, new_attr = arg2)
+    {
+      /* save, cut-off link */
+      next = outer_expr->next;
+      outer_expr->next = NULL;
+      arg2 = new_attr->next;
+      new_attr->next = NULL;
+
+      term = pt_expression_2 (parser, PT_EQ, outer_expr, new_attr);
+      if (term == NULL)
+	{
+	  PT_INTERNAL_ERROR (parser, "allocate new node");
+	  return NULL;
+	}
+      term->type_enum = PT_TYPE_LOGICAL;
+
+      new_terms = parser_append_node (term, new_terms);
+    }
+
+  if (is_anti)
+    {
+      /* the equalities become the ON condition of the derived table, joined last */
+      location = 0;
+      for (spec = node->info.query.q.select.from; spec != NULL; spec = spec->next)
+	{
+	  if (spec != new_spec && spec->info.spec.location >= location)
+	    {
+	      location = spec->info.spec.location + 1;
+	    }
+	}
+
+      new_spec->info.spec.join_type = PT_JOIN_LEFT_OUTER;
+      new_spec->info.spec.location = location;
+      new_spec->info.spec.flag = (PT_SPEC_FLAG) (new_spec->info.spec.flag | PT_SPEC_FLAG_ANTI_JOIN);
+
+      locate_info.start_spec = NULL;
+      locate_info.start = 0;
+      locate_info.end = location;
+      locate_info.found_outerjoin = false;
+      (void) parser_walk_tree (parser, new_terms, qo_modify_location, &locate_info, NULL, NULL);
+
+      /* keep the outer rows without a match */
+      arg1 = parser_copy_tree (parser, new_terms->info.expr.arg2);
+      term = pt_expression_1 (parser, PT_IS_NULL, arg1);
+      if (arg1 == NULL || term == NULL)
+	{
+	  PT_INTERNAL_ERROR (parser, "allocate new node");
+	  return NULL;
+	}
+      term->type_enum = PT_TYPE_LOGICAL;
+
+      new_terms = parser_append_node (term, new_terms);
+    }
+
+  return new_terms;
+}
+
+/*
+ * qo_make_not_in_guards () - make the terms that give NOT IN its NULL semantics
+ *   return: terms, or NULL on error
+ *   parser(in):
+ *   in_arg(in): left operand of NOT IN
+ *   subquery(in): uncorrelated subquery of NOT IN
+ *
+ * Note: 'a NOT IN (SELECT col ...)' is true only if no row of the subquery equals a, none is NULL and, unless the
+ *	 subquery is empty, a is not NULL. The anti join checks the first condition, the terms
+ *	   NOT EXISTS (SELECT ... WHERE col IS NULL) AND (a IS NOT NULL OR NOT EXISTS (SELECT ...))
+ *	 the others. Their subqueries are uncorrelated and executed only once.
+ */
+static PT_NODE *
+qo_make_not_in_guards (PARSER_CONTEXT * parser, PT_NODE * in_arg, PT_NODE * subquery)
+{
+  PT_NODE *null_query, *empty_query, *col, *is_null, *exists_null, *exists_any;
+  PT_NODE *no_null, *no_row, *not_null_arg, *guards;
+
+  null_query = mq_reset_ids_in_statement (parser, parser_copy_tree (parser, subquery));
+  empty_query = mq_reset_ids_in_statement (parser, parser_copy_tree (parser, subquery));
+  if (null_query == NULL || empty_query == NULL)
+    {
+      PT_INTERNAL_ERROR (parser, "copy tree");
+      return NULL;
+    }
+
+  col = parser_copy_tree (parser, null_query->info.query.q.select.list);
+  is_null = pt_expression_1 (parser, PT_IS_NULL, col);
+  exists_null = pt_expression_1 (parser, PT_EXISTS, null_query);
+  no_null = pt_expression_1 (parser, PT_NOT, exists_null);
+  exists_any = pt_expression_1 (parser, PT_EXISTS, empty_query);
+  no_row = pt_expression_1 (parser, PT_NOT, exists_any);
+  not_null_arg = pt_expression_1 (parser, PT_IS_NOT_NULL, parser_copy_tree (parser, in_arg));
+  if (col == NULL || is_null == NULL || exists_null == NULL || no_null == NULL || exists_any == NULL
+      || no_row == NULL || not_null_arg == NULL)
+    {
+      PT_INTERNAL_ERROR (parser, "allocate new node");
+      return NULL;
+    }
+
+  is_null->type_enum = PT_TYPE_LOGICAL;
+  exists_null->type_enum = PT_TYPE_LOGICAL;
+  no_null->type_enum = PT_TYPE_LOGICAL;
+  exists_any->type_enum = PT_TYPE_LOGICAL;
+  no_row->type_enum = PT_TYPE_LOGICAL;
+  not_null_arg->type_enum = PT_TYPE_LOGICAL;
+
+  null_query->info.query.q.select.where = parser_append_node (is_null, null_query->info.query.q.select.where);
+
+  guards = pt_expression_2 (parser, PT_OR, not_null_arg, no_row);
+  if (guards == NULL)
+    {
+      PT_INTERNAL_ERROR (parser, "allocate new node");
+      return NULL;
+    }
+  guards->type_enum = PT_TYPE_LOGICAL;
+
+  return parser_append_node (guards, no_null);
+}
+
+/*
+ * qo_unnest_subqueries () - Rewrite correlated [NOT] EXISTS, correlated IN and uncorrelated NOT IN subqueries to
+ *			      semi joins and anti joins
+ *   return: PT_NODE *
+ *   parser(in):
+ *   node(in): SELECT node
+ *   idx(in/out): seqno of the generated names
+ *
+ * Note: The subqueries are otherwise executed once for each row of the outer query. The derived tables they are
+ *	 rewritten to are executed once, and joined with the outer query by any join method; a hash join takes
+ *	 advantage of their rows being unique (see qo_unnest_subquery()).
+ */
+static PT_NODE *
+qo_unnest_subqueries (PARSER_CONTEXT * parser, PT_NODE * node, int *idx)
+{
+  PT_NODE *cnf_node, *prev, *next, *subquery, *in_arg, *new_terms, *guards, *spec, *last;
+  PT_OP_TYPE op_type;
+  bool is_anti, has_right_outer_join;
+  int corr_term_cnt;
+
+  if (node->node_type != PT_SELECT || node->info.query.q.select.connect_by != NULL
+      || PT_SELECT_INFO_IS_FLAGED (node, PT_SELECT_INFO_FOR_UPDATE)
+      || pt_has_inst_in_where_and_select_list (parser, node))
+    {
+      return node;
+    }
+
+  has_right_outer_join = false;
+  for (spec = node->info.query.q.select.from; spec != NULL; spec = spec->next)
+    {
+      if (spec->info.spec.join_type == PT_JOIN_RIGHT_OUTER || spec->info.spec.join_type == PT_JOIN_FULL_OUTER)
+	{
+	  has_right_outer_join = true;
+	}
+    }
+
+  node->info.query.q.select.where = pt_cnf (parser, node->info.query.q.select.where);
+
+  for (prev = NULL, cnf_node = node->info.query.q.select.where; cnf_node != NULL; cnf_node = next)
+    {
+      next = cnf_node->next;
+
+      if (cnf_node->node_type != PT_EXPR || cnf_node->or_next != NULL || cnf_node->info.expr.location != 0)
+	{
+	  prev = cnf_node;
+	  continue;
+	}
+
+      op_type = cnf_node->info.expr.op;
+      is_anti = false;
+      in_arg = NULL;
+      subquery = NULL;
+
+      if (op_type == PT_NOT && cnf_node->info.expr.arg1 != NULL && cnf_node->info.expr.arg1->node_type == PT_EXPR
+	  && cnf_node->info.expr.arg1->info.expr.op == PT_EXISTS)
+	{
+	  /* NOT EXISTS: anti join */
+	  is_anti = true;
+	  subquery = cnf_node->info.expr.arg1->info.expr.arg1;
+	}
+      else if (op_type == PT_EXISTS)
+	{
+	  /* EXISTS: semi join */
+	  subquery = cnf_node->info.expr.arg1;
+	}
+      else if (op_type == PT_IS_IN || op_type == PT_EQ_SOME || op_type == PT_IS_NOT_IN)
+	{
+	  is_anti = (op_type == PT_IS_NOT_IN);
+	  in_arg = cnf_node->info.expr.arg1;
+	  subquery = cnf_node->info.expr.arg2;
+	}
+
+      if (subquery == NULL || !PT_IS_QUERY (subquery) || (is_anti && has_right_outer_join))
+	{
+	  prev = cnf_node;
+	  continue;
+	}
+
+      if (subquery->node_type == PT_SELECT)
+	{
+	  subquery->info.query.q.select.where = pt_cnf (parser, subquery->info.query.q.select.where);
+	}
+
+      corr_term_cnt = qo_check_unnest_subquery (parser, subquery);
+      if (corr_term_cnt < 0)
+	{
+	  prev = cnf_node;
+	  continue;
+	}
+
+      if (in_arg != NULL)
+	{
+	  if (!qo_is_unnest_key (parser, in_arg, 0) || !qo_is_unnest_key (parser, subquery->info.query.q.select.list, 0))
+	    {
+	      prev = cnf_node;
+	      continue;
+	    }
+
+	  /* uncorrelated IN is rewritten by qo_rewrite_subqueries(); only uncorrelated NOT IN is NULL-aware here */
+	  if ((op_type == PT_IS_NOT_IN) ? (corr_term_cnt > 0) : (corr_term_cnt == 0))
+	    {
+	      prev = cnf_node;
+	      continue;
+	    }
+	}
+      else if (corr_term_cnt == 0)
+	{
+	  /* uncorrelated EXISTS is executed once */
+	  prev = cnf_node;
+	  continue;
+	}
+
+      guards = NULL;
+      if (op_type == PT_IS_NOT_IN)
+	{
+	  guards = qo_make_not_in_guards (parser, in_arg, subquery);
+	  if (guards == NULL)
+	    {
+	      return NULL;
+	    }
+	}
+
+      /* detach the operands from the predicate */
+      if (in_arg != NULL)
+	{
+	  cnf_node->info.expr.arg1 = NULL;
+	  cnf_node->info.expr.arg2 = NULL;
+	}
+      else if (is_anti)
+	{
+	  cnf_node->info.expr.arg1->info.expr.arg1 = NULL;
+	}
+      else
+	{
+	  cnf_node->info.expr.arg1 = NULL;
+	}
+
+      new_terms = qo_unnest_subquery (parser, node, subquery, in_arg, is_anti, idx);
+      if (new_terms == NULL)
+	{
+	  return NULL;
+	}
+      new_terms = parser_append_node (guards, new_terms);
+
+      /* replace the predicate with the new terms */
+      cnf_node->next = NULL;
+      parser_free_tree (parser, cnf_node);
+
+      for (last = new_terms; last->next != NULL; last = last->next)
+	{
+	  ;
+	}
+      last->next = next;
+
+      if (prev == NULL)
+	{
+	  node->info.query.q.select.where = new_terms;
+	}
+      else
+	{
+	  prev->next = new_terms;
+	}
+      prev = last;
+    }
+
+  return node;
+}
+
 /*
  * qo_is_partition_attr () -
  *   return:
@@ -8514,6 +9150,99 @@ qo_do_auto_parameterize (PARSER_CONTEXT * parser, PT_NODE * where)
 
 }
 
+/*
+ * qo_is_connect_by_indexed_attr () - checks whether an index of a class
+ *                                    starts with an attribute
+ *   return: whether the index can look up the rows of a value of the
+ *           attribute
+ *   class_mop(in): class
+ *   name(in): PT_NAME of the attribute
+ */
+static bool
+qo_is_connect_by_indexed_attr (MOP class_mop, PT_NODE * name)
+{
+  SM_CLASS_CONSTRAINT *consp;
+
+  for (consp = sm_class_constraints (class_mop); consp != NULL; consp = consp->next)
+    {
+      if (!SM_IS_CONSTRAINT_INDEX_FAMILY (consp->type) || consp->index_status != SM_NORMAL_INDEX
+	  || consp->filter_predicate != NULL || consp->func_index_info != NULL)
+	{
+	  continue;
+	}
+
+      if (consp->attributes[0] != NULL
+	  && intl_identifier_casecmp (consp->attributes[0]->header.name, name->info.name.original) == 0)
+	{
+	  return true;
+	}
+    }
+
+  return false;
+}
+
+/*
+ * qo_find_connect_by_equi_terms () - finds the terms PRIOR attr1 = attr2 of
+ *                                    a CONNECT BY predicate
+ *   return: void
+ *   pred(in): CONNECT BY predicate (list of conjuncts)
+ *   spec(in): spec of the query
+ *   class_mop(in): class of the spec
+ *   has_equi_term(out): set when such a term is found
+ *   has_indexed_term(out): set when an index can look up the rows of attr2
+ */
+static void
+qo_find_connect_by_equi_terms (PT_NODE * pred, PT_NODE * spec, MOP class_mop, bool * has_equi_term,
+			       bool * has_indexed_term)
+{
+  PT_NODE *arg1, *arg2, *tmp;
+
+  for (; pred != NULL; pred = pred->next)
+    {
+      if (!pt_is_expr_node (pred) || pred->or_next != NULL)
+	{
+	  continue;
+	}
+
+      if (pred->info.expr.op == PT_AND)
+	{
+	  qo_find_connect_by_equi_terms (pred->info.expr.arg1, spec, class_mop, has_equi_term, has_indexed_term);
+	  qo_find_connect_by_equi_terms (pred->info.expr.arg2, spec, class_mop, has_equi_term, has_indexed_term);
+	  continue;
+	}
+
+      if (pred->info.expr.op != PT_EQ)
+	{
+	  continue;
+	}
+
+      arg1 = pred->info.expr.arg1;
+      arg2 = pred->info.expr.arg2;
+      if (pt_is_expr_node (arg2) && arg2->info.expr.op == PT_PRIOR)
+	{
+	  tmp = arg1;
+	  arg1 = arg2;
+	  arg2 = tmp;
+	}
+
+      if (!pt_is_expr_node (arg1) || arg1->info.expr.op != PT_PRIOR || !pt_is_attr (arg1->info.expr.arg1))
+	{
+	  continue;
+	}
+      if (arg2 == NULL || arg2->node_type != PT_NAME || !pt_is_attr (arg2)
+	  || arg2->info.name.spec_id != spec->info.spec.id)
+	{
+	  continue;
+	}
+
+      *has_equi_term = true;
+      if (qo_is_connect_by_indexed_attr (class_mop, arg2))
+	{
+	  *has_indexed_term = true;
+	}
+    }
+}
+
 /*
  * qo_can_generate_single_table_connect_by () - checks a SELECT ... CONNECT BY
  *                                              query for single-table
@@ -8524,6 +9253,10 @@ qo_do_auto_parameterize (PARSER_CONTEXT * parser, PT_NODE * where)
  * Note: The single-table optimizations (potentially using indexes for table
  *       access in START WITH and CONNECT BY predicates) can be performed if
  *       the query does not involve joins or partitioned tables.
+ *       They are not performed either when the CONNECT BY has PRIOR attr1 =
+ *       attr2 terms and no index starts with any attr2: every parent would
+ *       then scan the whole table, while the general plan hashes the rows
+ *       once by attr2 (hash list scan) and looks the children up in it.
  */
 static bool
 qo_can_generate_single_table_connect_by (PARSER_CONTEXT * parser, PT_NODE * node)
@@ -8590,6 +9323,20 @@ qo_can_generate_single_table_connect_by (PARSER_CONTEXT * parser, PT_NODE * node
     {
       return false;
     }
+
+  if (!(node->info.query.q.select.hint & PT_HINT_NO_HASH_LIST_SCAN) && node->info.query.q.select.using_index == NULL
+      && node->info.query.q.select.use_idx == NULL)
+    {
+      bool has_equi_term = false, has_indexed_term = false;
+
+      qo_find_connect_by_equi_terms (node->info.query.q.select.connect_by, spec, name->info.name.db_object,
+				     &has_equi_term, &has_indexed_term);
+      if (has_equi_term && !has_indexed_term)
+	{
+	  return false;
+	}
+    }
+
   return true;
 }
 
@@ -9013,6 +9760,9 @@ qo_optimize_queries (PARSER_CONTEXT * parser, PT_NODE * node, void *arg, int *co
 
 	  /* rewrite uncorrelated subquery to join query */
 	  qo_rewrite_subqueries (parser, node, &idx, &continue_walk);
+
+	  /* rewrite correlated [NOT] EXISTS, IN and uncorrelated NOT IN to semi and anti joins */
+	  (void) qo_unnest_subqueries (parser, node, &idx);
 	}
 
       /* rewrite optimization on WHERE, HAVING clause */
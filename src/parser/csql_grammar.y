@@ -462,6 +462,7 @@ static void pt_value_set_collation_info (PARSER_CONTEXT *parser,
 static void pt_value_set_monetary (PARSER_CONTEXT *parser, PT_NODE *node,
                    const char *str, const char *txt, DB_CURRENCY type);
 static PT_NODE * pt_create_paren_expr_list (PT_NODE * exp);
+static int pt_analytic_frame_offset (const char *text);
 static PT_MISC_TYPE parser_attr_type;
 
 static bool allow_attribute_ordering;
@@ -637,6 +638,7 @@ static char *g_plcsql_text;
 %type <number> of_analytic_lead_lag
 %type <number> of_percentile
 %type <number> of_analytic_no_args
+%type <number> analytic_frame_bound
 %type <number> of_cume_dist_percent_rank_function
 %type <number> negative_prec_cast_type
 %type <number> opt_nulls_first_or_last
@@ -1064,6 +1066,7 @@ static char *g_plcsql_text;
 %type <c3> of_serial_owner_clause
 %type <c3> delete_from_using
 %type <c3> trigger_status_or_priority_or_change_owner
+%type <c3> opt_analytic_frame
 
 %type <c2> sp_return_type
 %type <c2> extended_table_spec_list
@@ -1549,6 +1552,7 @@ static char *g_plcsql_text;
 %token <cptr> ERROR_
 %token <cptr> EXPLAIN
 %token <cptr> FIRST_VALUE
+%token <cptr> FOLLOWING
 %token <cptr> FULLSCAN
 %token <cptr> GE_INF_
 %token <cptr> GE_LE_
@@ -1644,6 +1648,7 @@ static char *g_plcsql_text;
 %token <cptr> PLCSQL
 %token <cptr> PLCSQL_TEXT_SOME
 %token <cptr> PORT
+%token <cptr> PRECEDING
 %token <cptr> PRINT
 %token <cptr> PRIORITY
 %token <cptr> PRIVATE
@@ -1697,6 +1702,7 @@ static char *g_plcsql_text;
 %token <cptr> TYPE
 %token <cptr> TRIGGERS
 %token <cptr> UCASE
+%token <cptr> UNBOUNDED
 %token <cptr> UNCOMMITTED
 %token <cptr> VAR_POP
 %token <cptr> VAR_SAMP
@@ -16765,8 +16771,8 @@ reserved_func
 			parser_groupby_exception = PT_COUNT;
 
 		DBG_PRINT}}
-	| COUNT '(' '*' ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by ')'
-		{{ DBG_TRACE_GRAMMAR(reserved_func, | COUNT '(' '*' ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by ')');
+	| COUNT '(' '*' ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by opt_analytic_frame ')'
+		{{ DBG_TRACE_GRAMMAR(reserved_func, | COUNT '(' '*' ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by opt_analytic_frame ')');
 
 			PT_NODE *node = parser_new_node (this_parser, PT_FUNCTION);
 
@@ -16778,6 +16784,9 @@ reserved_func
 			    node->info.function.analytic.is_analytic = true;
 			    node->info.function.analytic.partition_by = $7;
 			    node->info.function.analytic.order_by = $8;
+			    node->info.function.analytic.has_frame = (bool) TO_NUMBER (CONTAINER_AT_0 ($9));
+			    node->info.function.analytic.frame_start = (int) TO_NUMBER (CONTAINER_AT_1 ($9));
+			    node->info.function.analytic.frame_end = (int) TO_NUMBER (CONTAINER_AT_2 ($9));
 			  }
 
 			$$ = node;
@@ -16837,7 +16846,7 @@ reserved_func
 			parser_groupby_exception = PT_COUNT;
 
 		DBG_PRINT}}
-	| COUNT '(' opt_all expression_ ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by ')'
+	| COUNT '(' opt_all expression_ ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by opt_analytic_frame ')'
 		{{ DBG_TRACE_GRAMMAR(reserved_func, | COUNT '(' opt_all expression_ ')' OVER '(' ~ ')');
 
 			PT_NODE *node = parser_new_node (this_parser, PT_FUNCTION);
@@ -16850,6 +16859,9 @@ reserved_func
 			    node->info.function.analytic.is_analytic = true;
 			    node->info.function.analytic.partition_by = $8;
 			    node->info.function.analytic.order_by = $9;
+			    node->info.function.analytic.has_frame = (bool) TO_NUMBER (CONTAINER_AT_0 ($10));
+			    node->info.function.analytic.frame_start = (int) TO_NUMBER (CONTAINER_AT_1 ($10));
+			    node->info.function.analytic.frame_end = (int) TO_NUMBER (CONTAINER_AT_2 ($10));
 			  }
 
 			$$ = node;
@@ -16917,7 +16929,7 @@ reserved_func
 			PARSER_SAVE_ERR_CONTEXT ($$, @$.buffer_pos)
 
 		DBG_PRINT}}
-	| of_analytic '(' opt_all expression_ ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by ')'
+	| of_analytic '(' opt_all expression_ ')' OVER '(' opt_analytic_partition_by opt_analytic_order_by opt_analytic_frame ')'
 		{{ DBG_TRACE_GRAMMAR(reserved_func, | of_analytic '(' opt_all expression_ ')' OVER '(' ~ ')');
 
 			PT_NODE *node = parser_new_node (this_parser, PT_FUNCTION);
@@ -16930,6 +16942,9 @@ reserved_func
 			    node->info.function.analytic.is_analytic = true;
 			    node->info.function.analytic.partition_by = $8;
 			    node->info.function.analytic.order_by = $9;
+			    node->info.function.analytic.has_frame = (bool) TO_NUMBER (CONTAINER_AT_0 ($10));
+			    node->info.function.analytic.frame_start = (int) TO_NUMBER (CONTAINER_AT_1 ($10));
+			    node->info.function.analytic.frame_end = (int) TO_NUMBER (CONTAINER_AT_2 ($10));
 			  }
 
 			$$ = node;
@@ -18702,6 +18717,67 @@ opt_analytic_partition_by
 		DBG_PRINT}}
 	;
 
+opt_analytic_frame
+	: /* empty */
+		{{ DBG_TRACE_GRAMMAR(opt_analytic_frame, : );
+
+			container_3 ctn;
+			SET_CONTAINER_3 (ctn, FROM_NUMBER (false), FROM_NUMBER (0), FROM_NUMBER (0));
+			$$ = ctn;
+
+		DBG_PRINT}}
+	| ROWS analytic_frame_bound
+		{{ DBG_TRACE_GRAMMAR(opt_analytic_frame, | ROWS analytic_frame_bound);
+
+			/* the frame ends at the current row */
+			container_3 ctn;
+			SET_CONTAINER_3 (ctn, FROM_NUMBER (true), FROM_NUMBER ($2), FROM_NUMBER (0));
+			$$ = ctn;
+
+		DBG_PRINT}}
+	| ROWS BETWEEN analytic_frame_bound AND analytic_frame_bound
+		{{ DBG_TRACE_GRAMMAR(opt_analytic_frame, | ROWS BETWEEN analytic_frame_bound AND analytic_frame_bound);
+
+			container_3 ctn;
+			SET_CONTAINER_3 (ctn, FROM_NUMBER (true), FROM_NUMBER ($3), FROM_NUMBER ($5));
+			$$ = ctn;
+
+		DBG_PRINT}}
+	;
+
+analytic_frame_bound
+	: UNBOUNDED PRECEDING
+		{{ DBG_TRACE_GRAMMAR(analytic_frame_bound, : UNBOUNDED PRECEDING);
+
+			$$ = -PT_ANALYTIC_FRAME_UNBOUNDED;
+
+		DBG_PRINT}}
+	| UNBOUNDED FOLLOWING
+		{{ DBG_TRACE_GRAMMAR(analytic_frame_bound, | UNBOUNDED FOLLOWING);
+
+			$$ = PT_ANALYTIC_FRAME_UNBOUNDED;
+
+		DBG_PRINT}}
+	| CURRENT ROW
+		{{ DBG_TRACE_GRAMMAR(analytic_frame_bound, | CURRENT ROW);
+
+			$$ = 0;
+
+		DBG_PRINT}}
+	| UNSIGNED_INTEGER PRECEDING
+		{{ DBG_TRACE_GRAMMAR(analytic_frame_bound, | UNSIGNED_INTEGER PRECEDING);
+
+			$$ = -pt_analytic_frame_offset ($1);
+
+		DBG_PRINT}}
+	| UNSIGNED_INTEGER FOLLOWING
+		{{ DBG_TRACE_GRAMMAR(analytic_frame_bound, | UNSIGNED_INTEGER FOLLOWING);
+
+			$$ = pt_analytic_frame_offset ($1);
+
+		DBG_PRINT}}
+	;
+
 opt_over_analytic_partition_by
 	: /* empty */
 		{{ DBG_TRACE_GRAMMAR(opt_over_analytic_partition_by, : );
@@ -22957,6 +23033,7 @@ identifier
 	| ERROR_                 {{ DBG_TRACE_GRAMMAR(identifier, | ERROR_             ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| EXPLAIN                {{ DBG_TRACE_GRAMMAR(identifier, | EXPLAIN            ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| FIRST_VALUE            {{ DBG_TRACE_GRAMMAR(identifier, | FIRST_VALUE        ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
+	| FOLLOWING              {{ DBG_TRACE_GRAMMAR(identifier, | FOLLOWING          ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| FULLSCAN               {{ DBG_TRACE_GRAMMAR(identifier, | FULLSCAN           ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| GE_INF_                {{ DBG_TRACE_GRAMMAR(identifier, | GE_INF_            ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| GE_LE_                 {{ DBG_TRACE_GRAMMAR(identifier, | GE_LE_             ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
@@ -23047,6 +23124,7 @@ identifier
 	| PERCENTILE_DISC        {{ DBG_TRACE_GRAMMAR(identifier, | PERCENTILE_DISC    ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| PERCENT_RANK           {{ DBG_TRACE_GRAMMAR(identifier, | PERCENT_RANK       ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| PORT                   {{ DBG_TRACE_GRAMMAR(identifier, | PORT               ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
+	| PRECEDING              {{ DBG_TRACE_GRAMMAR(identifier, | PRECEDING          ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| PRINT                  {{ DBG_TRACE_GRAMMAR(identifier, | PRINT              ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| PRIORITY               {{ DBG_TRACE_GRAMMAR(identifier, | PRIORITY           ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| PRIVATE                {{ DBG_TRACE_GRAMMAR(identifier, | PRIVATE            ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
@@ -23099,6 +23177,7 @@ identifier
 	| TRIGGERS               {{ DBG_TRACE_GRAMMAR(identifier, | TRIGGERS           ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| TYPE                   {{ DBG_TRACE_GRAMMAR(identifier, | TYPE               ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| UCASE                  {{ DBG_TRACE_GRAMMAR(identifier, | UCASE              ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
+	| UNBOUNDED              {{ DBG_TRACE_GRAMMAR(identifier, | UNBOUNDED          ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| UNCOMMITTED            {{ DBG_TRACE_GRAMMAR(identifier, | UNCOMMITTED        ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| VARIANCE               {{ DBG_TRACE_GRAMMAR(identifier, | VARIANCE           ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
 	| VAR_POP                {{ DBG_TRACE_GRAMMAR(identifier, | VAR_POP            ); SET_CPTR_2_PTNAME($$, $1, @$.buffer_pos);  }}
@@ -28000,6 +28079,25 @@ pt_create_json_value (PARSER_CONTEXT *parser, const char *str)
   return node;
 }
 
+/*
+ * pt_analytic_frame_offset () - offset of a bound of a ROWS window frame
+ *   return: number of rows, saturated below PT_ANALYTIC_FRAME_UNBOUNDED
+ *   text(in): unsigned integer literal
+ */
+static int
+pt_analytic_frame_offset (const char *text)
+{
+  long long offset = strtoll (text, NULL, 10);
+
+  if (offset < 0 || offset >= PT_ANALYTIC_FRAME_UNBOUNDED)
+    {
+      /* a frame this wide covers any partition */
+      return PT_ANALYTIC_FRAME_UNBOUNDED - 1;
+    }
+
+  return (int) offset;
+}
+
 static void
 pt_jt_append_column_or_nested_node (PT_NODE * jt_node, PT_NODE * jt_col_or_nested)
 {
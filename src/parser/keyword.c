@@ -191,6 +191,7 @@ static KEYWORD_RECORD keywords[] = {
   {FIRST, "FIRST", 0},
   {FIRST_VALUE, "FIRST_VALUE", 1},
   {FLOAT_, "FLOAT", 0},
+  {FOLLOWING, "FOLLOWING", 1},
   {For, "FOR", 0},
   {FOREIGN, "FOREIGN", 0},
   {FOUND, "FOUND", 0},
@@ -351,6 +352,7 @@ static KEYWORD_RECORD keywords[] = {
   {PERCENTILE_CONT, "PERCENTILE_CONT", 1},
   {PERCENTILE_DISC, "PERCENTILE_DISC", 1},
   {POSITION, "POSITION", 0},
+  {PRECEDING, "PRECEDING", 1},
   {PRECISION, "PRECISION", 0},
   {PREPARE, "PREPARE", 0},
   {PRESERVE, "PRESERVE", 0},
@@ -486,6 +488,7 @@ static KEYWORD_RECORD keywords[] = {
   {TYPE, "TYPE", 1},
   {True, "TRUE", 0},
   {UCASE, "UCASE", 1},
+  {UNBOUNDED, "UNBOUNDED", 1},
   {UNDER, "UNDER", 0},
   {Union, "UNION", 0},
   {UNIQUE, "UNIQUE", 0},
@@ -9578,13 +9578,8 @@ pt_resolve_cte_specs (PARSER_CONTEXT * parser, PT_NODE * node, void *arg, int *c
 	    {
 	      curr_cte->info.cte.non_recursive_part = non_recursive_part;
 	      curr_cte->info.cte.recursive_part = recursive_part;
+	      /* with UNION (distinct), the rows the recursive part finds again are dropped */
 	      curr_cte->info.cte.only_all = all_distinct;
-	      if (curr_cte->info.cte.only_all != PT_ALL)
-		{
-		  PT_ERRORmf (parser, curr_cte, MSGCAT_SET_PARSER_SEMANTIC, MSGCAT_SEMANTIC_INCORRECT_UNION_IN_CTE,
-			      curr_cte->info.cte.name->info.name.original);
-		  return NULL;
-		}
 	    }
 
 	  /* check if there are any unresolved self references of the cte, it would be incorrect */
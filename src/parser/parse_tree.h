@@ -514,6 +514,9 @@ struct json_t;
         ( (n) && (n)->node_type == PT_FUNCTION && \
           (n)->info.function.analytic.is_analytic )
 
+/* offset of an UNBOUNDED bound of a ROWS window frame; UNBOUNDED PRECEDING is its negation */
+#define PT_ANALYTIC_FRAME_UNBOUNDED DB_INT32_MAX
+
 #define PT_IS_POINTER_REF_NODE(n) \
         ( (n) && (n)->node_type == PT_NODE_POINTER && \
           (n)->info.pointer.type == PT_POINTER_REF )
@@ -1718,7 +1721,9 @@ typedef enum
   PT_SPEC_FLAG_MVCC_ASSIGN_REEV = 0x800,	/* the spec is used in UPDATE assignment reevaluation */
   PT_SPEC_FLAG_DOESNT_HAVE_UNIQUE = 0x1000,	/* the spec was checked and does not have any uniques */
   PT_SPEC_FLAG_SAMPLING_SCAN = 0x2000,	/* spec for sampling scan */
-  PT_SPEC_FLAG_REFERENCED_AT_ODKU = 0x4000	/* spec for odku assignment */
+  PT_SPEC_FLAG_REFERENCED_AT_ODKU = 0x4000,	/* spec for odku assignment */
+  PT_SPEC_FLAG_ANTI_JOIN = 0x8000	/* derived table of an unnested NOT EXISTS/NOT IN; the outer rows it matches
+					 * are discarded */
 } PT_SPEC_FLAG;
 
 typedef enum
@@ -2481,6 +2486,9 @@ struct pt_function_info
     bool from_last;		/* determines whether the calculation begins at the last or first row */
     bool ignore_nulls;		/* determines whether the calculation eliminate or includes null values */
     bool is_analytic;		/* is analytic clause */
+    bool has_frame;		/* whether a ROWS window frame is given */
+    int frame_start;		/* first row of the ROWS frame, relative to the current row */
+    int frame_end;		/* last row of the ROWS frame, relative to the current row */
   } analytic;
 };
 
@@ -2957,6 +2965,35 @@ struct pt_select_info
           (s)->info.query.q.select.flag &= ~(f)
 
 /* common with union and select info */
+/* Plan variants of a SELECT statement: the plans compiled for the values of the host variables that are frequent in
+ * the columns they are compared with (see max_plan_cache_variants) */
+#define PT_PLAN_VARIANT_MAX_PARAMS 8
+#define PT_PLAN_VARIANT_MAX_VARIANTS 16
+
+typedef struct pt_plan_variant_param PT_PLAN_VARIANT_PARAM;
+struct pt_plan_variant_param
+{
+  int host_var_index;		/* the host variable */
+  DB_OBJECT *class_mop;		/* and the column it is equal to */
+  int attr_id;
+};
+
+typedef struct pt_plan_variant PT_PLAN_VARIANT;
+struct pt_plan_variant
+{
+  unsigned int signature;	/* frequency buckets of the values of the parameters, 4 bits each */
+  XASL_ID xasl_id;
+};
+
+typedef struct pt_plan_variants PT_PLAN_VARIANTS;
+struct pt_plan_variants
+{
+  int n_params;			/* 0 if the plan does not depend on the values of host variables */
+  PT_PLAN_VARIANT_PARAM params[PT_PLAN_VARIANT_MAX_PARAMS];
+  int n_variants;
+  PT_PLAN_VARIANT variants[PT_PLAN_VARIANT_MAX_VARIANTS];
+};
+
 struct pt_query_info
 {
   int correlation_level;	/* for correlated subqueries */
@@ -2991,6 +3028,7 @@ struct pt_query_info
   PT_NODE *limit;		/* PT_VALUE (list) limit clause parameter(s) */
   void *xasl;			/* xasl proc pointer */
   XASL_ID *sub_xasl_id;		/* xasl_id for cached subquery */
+  PT_PLAN_VARIANTS *plan_variants;	/* plans for frequent values of host variables; NULL until the first execution */
   UINTPTR id;			/* query unique id # */
   PT_HINT_ENUM hint;		/* hint flag */
   bool is_order_dependent;	/* true if query is order dependent */
@@ -3966,6 +4004,10 @@ struct parser_context
 
   HIDE_PWD_INFO hide_pwd_info;
 
+  double *plan_variant_selectivity;	/* when compiling a plan variant: selectivity of the equality with each host
+					 * variable, by index; negative if unknown. NULL otherwise */
+  unsigned int plan_variant_signature;	/* when compiling a plan variant: its signature, 0 otherwise */
+
   struct
   {
     unsigned has_internal_error:1;	/* 0 or 1 */
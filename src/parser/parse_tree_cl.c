@@ -365,6 +365,7 @@ static PARSER_VARCHAR *pt_print_execute_trigger (PARSER_CONTEXT * parser, PT_NOD
 static PARSER_VARCHAR *pt_print_expr (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_file_path (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_function (PARSER_CONTEXT * parser, PT_NODE * p);
+static PARSER_VARCHAR *pt_print_analytic_frame_bound (PARSER_CONTEXT * parser, PARSER_VARCHAR * q, int bound);
 static PARSER_VARCHAR *pt_print_get_opt_lvl (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_get_stats (PARSER_CONTEXT * parser, PT_NODE * p);
 static PARSER_VARCHAR *pt_print_get_trigger (PARSER_CONTEXT * parser, PT_NODE * p);
@@ -12299,6 +12300,35 @@ pt_init_function (PT_NODE * p)
   return p;
 }
 
+/*
+ * pt_print_analytic_frame_bound () - print a bound of a ROWS window frame
+ *   return: q with the bound appended
+ *   parser(in):
+ *   q(in): output string
+ *   bound(in): offset of the bound, relative to the current row
+ */
+static PARSER_VARCHAR *
+pt_print_analytic_frame_bound (PARSER_CONTEXT * parser, PARSER_VARCHAR * q, int bound)
+{
+  char buf[32];
+
+  if (bound == -PT_ANALYTIC_FRAME_UNBOUNDED)
+    {
+      return pt_append_nulstring (parser, q, "unbounded preceding");
+    }
+  else if (bound == PT_ANALYTIC_FRAME_UNBOUNDED)
+    {
+      return pt_append_nulstring (parser, q, "unbounded following");
+    }
+  else if (bound == 0)
+    {
+      return pt_append_nulstring (parser, q, "current row");
+    }
+
+  sprintf (buf, "%d %s", bound < 0 ? -bound : bound, bound < 0 ? "preceding" : "following");
+  return pt_append_nulstring (parser, q, buf);
+}
+
 /*
  * pt_print_function () -
  *   return:
@@ -12543,6 +12573,17 @@ pt_print_function (PARSER_CONTEXT * parser, PT_NODE * p)
 	  q = pt_append_nulstring (parser, q, "order by ");
 	  q = pt_append_varchar (parser, q, r1);
 	}
+      if (p->info.function.analytic.has_frame)
+	{
+	  if (p->info.function.analytic.partition_by || p->info.function.analytic.order_by)
+	    {
+	      q = pt_append_nulstring (parser, q, " ");
+	    }
+	  q = pt_append_nulstring (parser, q, "rows between ");
+	  q = pt_print_analytic_frame_bound (parser, q, p->info.function.analytic.frame_start);
+	  q = pt_append_nulstring (parser, q, " and ");
+	  q = pt_print_analytic_frame_bound (parser, q, p->info.function.analytic.frame_end);
+	}
       q = pt_append_nulstring (parser, q, ")");
     }
 
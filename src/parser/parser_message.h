@@ -501,6 +501,8 @@
 #define MSGCAT_SEMANTIC_NOT_ALLOWED_PERCENT_TYPE 		MSGCAT_SEMANTIC_NO(321)
 #define MSGCAT_SEMANTIC_UNDEFINED_TABLE_COLUMN   		MSGCAT_SEMANTIC_NO(322)
 #define MSGCAT_SEMANTIC_SP_OUT_ARGS_EXISTS_IN_QUERY             MSGCAT_SEMANTIC_NO(323)
+#define MSGCAT_SEMANTIC_ANALYTIC_FRAME_NOT_ALLOWED               MSGCAT_SEMANTIC_NO(324)
+#define MSGCAT_SEMANTIC_INVALID_ANALYTIC_FRAME                   MSGCAT_SEMANTIC_NO(325)
 
 /* Message id in the set MSGCAT_SET_PARSER_RUNTIME */
 #define MSGCAT_RUNTIME_NO(n)				n
@@ -10080,6 +10080,12 @@ pt_free_statement_xasl_id (PT_NODE * statement)
       free_and_init (statement->xasl_id);
     }
 
+  if (statement->node_type == PT_SELECT && statement->info.query.plan_variants != NULL)
+    {
+      /* the plan variants are recompiled with the statement */
+      statement->info.query.plan_variants->n_variants = 0;
+    }
+
   if (statement->node_type == PT_DELETE)
     {
       /* free xasl_id for computed individual select statements */
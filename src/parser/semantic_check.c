@@ -15861,6 +15861,30 @@ pt_check_analytic_function (PARSER_CONTEXT * parser, PT_NODE * func, void *arg,
       return func;
     }
 
+  /* ROWS window frames are evaluated for the aggregates that can be computed over a sliding window */
+  if (func->info.function.analytic.has_frame)
+    {
+      FUNC_CODE fcode = func->info.function.function_type;
+      int frame_start = func->info.function.analytic.frame_start;
+      int frame_end = func->info.function.analytic.frame_end;
+
+      if ((fcode != PT_COUNT_STAR && fcode != PT_COUNT && fcode != PT_SUM && fcode != PT_AVG && fcode != PT_MIN
+	   && fcode != PT_MAX) || func->info.function.all_or_distinct != PT_ALL)
+	{
+	  PT_ERRORmf (parser, func, MSGCAT_SET_PARSER_SEMANTIC, MSGCAT_SEMANTIC_ANALYTIC_FRAME_NOT_ALLOWED,
+		      pt_short_print (parser, func));
+	  return func;
+	}
+
+      if (frame_start == PT_ANALYTIC_FRAME_UNBOUNDED || frame_end == -PT_ANALYTIC_FRAME_UNBOUNDED
+	  || frame_start > frame_end)
+	{
+	  PT_ERRORmf (parser, func, MSGCAT_SET_PARSER_SEMANTIC, MSGCAT_SEMANTIC_INVALID_ANALYTIC_FRAME,
+		      pt_short_print (parser, func));
+	  return func;
+	}
+    }
+
   /* median doesn't support over(order by ...) */
   if (func->info.function.function_type == PT_MEDIAN)
     {
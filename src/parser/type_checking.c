@@ -17275,7 +17275,7 @@ pt_evaluate_db_value_expr (PARSER_CONTEXT * parser, PT_NODE * expr, PT_OP_TYPE o
 		esc_char->need_clear = false;
 	      }
 
-	    if (db_string_like (arg1, arg2, esc_char, &cmp))
+	    if (db_string_like (arg1, arg2, esc_char, NULL, &cmp))
 	      {
 		/* db_string_like() also checks argument types */
 		return 0;
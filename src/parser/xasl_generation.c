@@ -1401,6 +1401,7 @@ pt_make_pred_term_like (const REGU_VARIABLE * arg1, const REGU_VARIABLE * arg2,
 	  et_like->src = (REGU_VARIABLE *) arg1;
 	  et_like->pattern = (REGU_VARIABLE *) arg2;
 	  et_like->esc_char = (REGU_VARIABLE *) arg3;
+	  et_like->compiled_like = NULL;
 	}
     }
 
@@ -17385,6 +17386,7 @@ pt_plan_cte (PARSER_CONTEXT * parser, PT_NODE * node, PROC_TYPE proc_type)
     {
       xasl->proc.cte.non_recursive_part = non_recursive_part_xasl;
       xasl->proc.cte.recursive_part = recursive_part_xasl;
+      xasl->proc.cte.is_distinct = (recursive_part_xasl != NULL && node->info.cte.only_all != PT_ALL);
     }
 
   if (recursive_part_xasl == NULL && non_recursive_part_xasl != NULL)
@@ -23888,6 +23890,9 @@ pt_to_analytic_node (PARSER_CONTEXT * parser, PT_NODE * tree, ANALYTIC_INFO * an
   analytic->value = (DB_VALUE *) tree->etc;
   analytic->from_last = func_info->analytic.from_last;
   analytic->ignore_nulls = func_info->analytic.ignore_nulls;
+  analytic->has_frame = func_info->analytic.has_frame;
+  analytic->frame_start = func_info->analytic.frame_start;
+  analytic->frame_end = func_info->analytic.frame_end;
 
   /* set value types */
   regu_dbval_type_init (analytic->value, pt_node_to_db_type (tree));
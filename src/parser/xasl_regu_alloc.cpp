@@ -118,6 +118,7 @@ regu_xasl_proc_init (xasl_node &node, PROC_TYPE type)
     case CTE_PROC:
       node.proc.cte.recursive_part = NULL;
       node.proc.cte.non_recursive_part = NULL;
+      node.proc.cte.is_distinct = false;
       break;
 
     default:
@@ -152,6 +153,9 @@ regu_init (access_spec_node &spec)
   spec.s_dbval = NULL;
   spec.next = NULL;
   spec.flags = ACCESS_SPEC_FLAG_NONE;
+  spec.pred_hash = 0;
+  spec.est_selectivity = 1.0f;
+  spec.adaptive_join_rows = 0;
 }
 
 static void
@@ -263,6 +267,7 @@ regu_init (cubxasl::pred_expr &pr)
 {
   pr.type = T_NOT_TERM;
   pr.pe.m_not_term = NULL;
+  pr.compiled = NULL;
 }
 
 void
@@ -329,6 +334,9 @@ regu_init (cubxasl::analytic_list_node &ana)
   ana.from_last = false;
   ana.ignore_nulls = false;
   ana.is_const_operand = false;
+  ana.has_frame = false;
+  ana.frame_start = 0;
+  ana.frame_end = 0;
 
   regu_alloc (ana.list_id);
   regu_alloc (ana.value2);
@@ -40,6 +40,7 @@
 #include <errno.h>
 #include <stdarg.h>
 #include <ctype.h>
+#include <math.h>
 
 
 #include "error_manager.h"
@@ -210,6 +211,11 @@ static int do_supplemental_statement (PARSER_CONTEXT * parser, PT_NODE * stateme
 static int do_reserve_classinfo (PARSER_CONTEXT * parser, PT_NODE * statement, RESERVED_CLASS_INFO ** cls_info);
 
 static int do_reserve_oidinfo (PARSER_CONTEXT * parser, PT_NODE * statement, OID ** oid);
+
+static int do_find_plan_variant_params (PARSER_CONTEXT * parser, PT_NODE * statement);
+static int do_get_frequent_values_stats (DB_OBJECT * class_mop, int attr_id, ATTR_STATS ** attr_stats_p);
+static int do_get_plan_variant_bucket (DB_VALUE * value, const PT_PLAN_VARIANT_PARAM * param, int *bucket);
+static int do_get_plan_variant (PARSER_CONTEXT * parser, PT_NODE * statement, XASL_ID ** xasl_id_p);
 /*
  * initialize_serial_invariant() - initialize a serial invariant
  *   return: None
@@ -14533,6 +14539,20 @@ do_prepare_select (PARSER_CONTEXT * parser, PT_NODE * statement)
 			  (PT_CONVERT_RANGE | PT_PRINT_QUOTES | PT_PRINT_DIFFERENT_SYSTEM_PARAMETERS | PT_PRINT_USER));
 
   contextp->sql_hash_text = (char *) statement->alias_print;
+  if (parser->plan_variant_signature != 0 && contextp->sql_hash_text != NULL)
+    {
+      char variant_text[32];
+
+      /* plan variants are cached apart from the generic plan of the statement */
+      sprintf (variant_text, " /* plan variant %08x */", parser->plan_variant_signature);
+      contextp->sql_hash_text = pt_append_string (parser, pt_append_string (parser, NULL, contextp->sql_hash_text),
+						  variant_text);
+      if (contextp->sql_hash_text == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, strlen (statement->alias_print));
+	  return ER_OUT_OF_VIRTUAL_MEMORY;
+	}
+    }
   err =
     SHA1Compute ((unsigned char *) contextp->sql_hash_text, (unsigned) strlen (contextp->sql_hash_text),
 		 &contextp->sha1);
@@ -14719,6 +14739,8 @@ do_prepare_subquery (PARSER_CONTEXT * parser, PT_NODE * stmt)
 
   context.host_var_count = 0;
   context.host_variables = NULL;
+  context.plan_variant_selectivity = NULL;
+  context.plan_variant_signature = 0;
   stmt->sub_host_var_index = NULL;
   stmt->sub_host_var_count = 0;
 
@@ -15132,6 +15154,7 @@ do_execute_select (PARSER_CONTEXT * parser, PT_NODE * statement)
   DB_VALUE *vals, *v;
   CACHE_TIME clt_cache_time;
   bool query_trace = false;
+  XASL_ID *xasl_id;
 
   assert (parser->query_id == NULL_QUERY_ID);
 
@@ -15247,8 +15270,16 @@ do_execute_select (PARSER_CONTEXT * parser, PT_NODE * statement)
   CACHE_TIME_RESET (&statement->cache_time);
   statement->flag.clt_cache_reusable = 0;
 
+  /* the values of the host variables may call for a plan of their own */
+  err = do_get_plan_variant (parser, statement, &xasl_id);
+  if (err != NO_ERROR)
+    {
+      AU_RESTORE (au_save);
+      return err;
+    }
+
   err =
-    execute_query (statement->xasl_id, &parser->query_id, parser->host_var_count + parser->auto_param_count,
+    execute_query (xasl_id, &parser->query_id, parser->host_var_count + parser->auto_param_count,
 		   parser->host_variables, &list_id, query_flag, &clt_cache_time, &statement->cache_time);
 
   AU_RESTORE (au_save);
@@ -15293,6 +15324,345 @@ do_execute_select (PARSER_CONTEXT * parser, PT_NODE * statement)
   return err;
 }				/* do_execute_select() */
 
+/*
+ * do_find_plan_variant_params () - find the host variables of a SELECT whose values may change its plan
+ *   return: error code
+ *   parser(in): parser context
+ *   statement(in/out): SELECT statement; its plan variants are initialized
+ *
+ * Note: these are the host variables that the WHERE clause requires equal to a column with frequent values
+ *       (see UPDATE STATISTICS): the plan that suits the frequent values may not suit the others.
+ */
+static int
+do_find_plan_variant_params (PARSER_CONTEXT * parser, PT_NODE * statement)
+{
+  PT_PLAN_VARIANTS *plan_variants;
+  PT_PLAN_VARIANT_PARAM *param;
+  PT_NODE *term, *name, *host_var, *spec, *entity;
+  ATTR_STATS *attr_stats;
+  int attr_id, error;
+
+  assert (statement->node_type == PT_SELECT);
+
+  plan_variants = (PT_PLAN_VARIANTS *) parser_alloc (parser, sizeof (PT_PLAN_VARIANTS));
+  if (plan_variants == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, sizeof (PT_PLAN_VARIANTS));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  for (term = statement->info.query.q.select.where; term != NULL; term = term->next)
+    {
+      if (plan_variants->n_params >= PT_PLAN_VARIANT_MAX_PARAMS)
+	{
+	  break;
+	}
+
+      if (term->node_type != PT_EXPR || term->info.expr.op != PT_EQ || term->or_next != NULL)
+	{
+	  continue;
+	}
+
+      if (PT_IS_NAME_NODE (term->info.expr.arg1) && PT_IS_HOSTVAR (term->info.expr.arg2))
+	{
+	  name = term->info.expr.arg1;
+	  host_var = term->info.expr.arg2;
+	}
+      else if (PT_IS_HOSTVAR (term->info.expr.arg1) && PT_IS_NAME_NODE (term->info.expr.arg2))
+	{
+	  name = term->info.expr.arg2;
+	  host_var = term->info.expr.arg1;
+	}
+      else
+	{
+	  continue;
+	}
+
+      if (name->info.name.meta_class != PT_NORMAL || host_var->info.host_var.var_type != PT_HOST_IN)
+	{
+	  continue;
+	}
+
+      for (spec = statement->info.query.q.select.from; spec != NULL; spec = spec->next)
+	{
+	  if (spec->info.spec.id == name->info.name.spec_id)
+	    {
+	      break;
+	    }
+	}
+      if (spec == NULL || (entity = spec->info.spec.flat_entity_list) == NULL || entity->next != NULL
+	  || entity->info.name.db_object == NULL)
+	{
+	  continue;
+	}
+
+      attr_id = sm_att_id (entity->info.name.db_object, name->info.name.original);
+      if (attr_id < 0)
+	{
+	  continue;
+	}
+
+      error = do_get_frequent_values_stats (entity->info.name.db_object, attr_id, &attr_stats);
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
+      if (attr_stats == NULL)
+	{
+	  continue;
+	}
+
+      param = &plan_variants->params[plan_variants->n_params++];
+      param->host_var_index = host_var->info.host_var.index;
+      param->class_mop = entity->info.name.db_object;
+      param->attr_id = attr_id;
+    }
+
+  statement->info.query.plan_variants = plan_variants;
+
+  return NO_ERROR;
+}
+
+/*
+ * do_get_frequent_values_stats () - statistics of a column that has frequent values
+ *   return: error code
+ *   class_mop(in): class
+ *   attr_id(in): column
+ *   attr_stats_p(out): statistics of the column, NULL if it has no frequent values
+ */
+static int
+do_get_frequent_values_stats (DB_OBJECT * class_mop, int attr_id, ATTR_STATS ** attr_stats_p)
+{
+  SM_CLASS *class_;
+  int i, error;
+
+  *attr_stats_p = NULL;
+
+  error = au_fetch_class (class_mop, &class_, AU_FETCH_READ, AU_SELECT);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error;
+    }
+
+  if (class_->stats == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  for (i = 0; i < class_->stats->n_attrs; i++)
+    {
+      if (class_->stats->attr_stats[i].id == attr_id)
+	{
+	  if (class_->stats->attr_stats[i].n_freq_values > 0 && class_->stats->attr_stats[i].ndv > 0)
+	    {
+	      *attr_stats_p = &class_->stats->attr_stats[i];
+	    }
+	  break;
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * do_get_plan_variant_bucket () - the bucket of frequencies of the value of a host variable in its column
+ *   return: error code
+ *   value(in): value of the host variable
+ *   param(in): host variable and column
+ *   bucket(out): 0 for values not much more frequent than the average of the column; otherwise 1 for the values
+ *                found in more than 10% of the rows, 2 for 1% to 10%, and so on, down to 7
+ */
+static int
+do_get_plan_variant_bucket (DB_VALUE * value, const PT_PLAN_VARIANT_PARAM * param, int *bucket)
+{
+  ATTR_STATS *attr_stats;
+  double fraction = 0.0;
+  int i, error;
+
+  *bucket = 0;
+
+  if (DB_IS_NULL (value))
+    {
+      return NO_ERROR;
+    }
+
+  error = do_get_frequent_values_stats (param->class_mop, param->attr_id, &attr_stats);
+  if (error != NO_ERROR || attr_stats == NULL)
+    {
+      return error;
+    }
+
+  for (i = 0; i < attr_stats->n_freq_values; i++)
+    {
+      if (tp_value_compare (value, &attr_stats->freq_values[i].value, 1, 0) == DB_EQ)
+	{
+	  fraction = attr_stats->freq_values[i].fraction;
+	  break;
+	}
+    }
+
+  /* the generic plan expects each value in 1/NDV of the rows */
+  if (fraction <= 0.0 || fraction * attr_stats->ndv < 4.0)
+    {
+      return NO_ERROR;
+    }
+
+  *bucket = 1 + MIN (6, (int) floor (-log10 (fraction)));
+
+  return NO_ERROR;
+}
+
+/*
+ * do_get_plan_variant () - get the plan of a SELECT for the values of its host variables
+ *   return: error code
+ *   parser(in): parser context, with the values of the host variables
+ *   statement(in/out): prepared SELECT statement
+ *   xasl_id_p(out): the plan to execute
+ *
+ * Note: when host variables are equal to frequent values of their columns, the statement is compiled again with the
+ *       selectivity of these values, into a plan variant that the server caches apart from the generic plan. The
+ *       variants are told apart by their signature, the buckets of frequencies of the values. A statement keeps up
+ *       to max_plan_cache_variants variants; other values use the generic plan.
+ */
+static int
+do_get_plan_variant (PARSER_CONTEXT * parser, PT_NODE * statement, XASL_ID ** xasl_id_p)
+{
+  PT_PLAN_VARIANTS *plan_variants;
+  PT_PLAN_VARIANT *variant;
+  COMPILE_CONTEXT save_context;
+  XASL_ID *save_xasl_id;
+  double *selectivity = NULL;
+  unsigned int signature = 0, save_use_plan_cache, save_cannot_prepare;
+  int i, var_count, bucket, max_variants, error = NO_ERROR;
+
+  *xasl_id_p = statement->xasl_id;
+
+  max_variants = MIN (prm_get_integer_value (PRM_ID_XASL_CACHE_MAX_PLAN_VARIANTS), PT_PLAN_VARIANT_MAX_VARIANTS);
+  if (max_variants <= 0 || statement->node_type != PT_SELECT || statement->flag.recompile
+      || parser->plan_variant_signature != 0)
+    {
+      return NO_ERROR;
+    }
+
+  if (statement->info.query.plan_variants == NULL)
+    {
+      error = do_find_plan_variant_params (parser, statement);
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
+    }
+  plan_variants = statement->info.query.plan_variants;
+  if (plan_variants->n_params == 0)
+    {
+      return NO_ERROR;
+    }
+
+  var_count = parser->host_var_count + parser->auto_param_count;
+  selectivity = (double *) malloc (var_count * sizeof (double));
+  if (selectivity == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, var_count * sizeof (double));
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  for (i = 0; i < var_count; i++)
+    {
+      selectivity[i] = -1.0;
+    }
+
+  for (i = 0; i < plan_variants->n_params; i++)
+    {
+      PT_PLAN_VARIANT_PARAM *param = &plan_variants->params[i];
+
+      if (param->host_var_index < 0 || param->host_var_index >= var_count)
+	{
+	  continue;
+	}
+
+      error = do_get_plan_variant_bucket (&parser->host_variables[param->host_var_index], param, &bucket);
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+      if (bucket > 0)
+	{
+	  /* a fraction of the rows inside the bucket */
+	  selectivity[param->host_var_index] = 0.3 * pow (10.0, -(bucket - 1));
+	  signature |= ((unsigned int) bucket) << (4 * i);
+	}
+    }
+
+  if (signature == 0)
+    {
+      /* the generic plan suits these values */
+      goto end;
+    }
+
+  for (i = 0; i < plan_variants->n_variants; i++)
+    {
+      if (plan_variants->variants[i].signature == signature)
+	{
+	  *xasl_id_p = &plan_variants->variants[i].xasl_id;
+	  goto end;
+	}
+    }
+
+  if (plan_variants->n_variants >= max_variants)
+    {
+      goto end;
+    }
+
+  /* compile the variant */
+  save_context = parser->context;
+  save_xasl_id = statement->xasl_id;
+  save_use_plan_cache = statement->flag.use_plan_cache;
+  save_cannot_prepare = statement->flag.cannot_prepare;
+
+  statement->xasl_id = NULL;
+  parser->plan_variant_selectivity = selectivity;
+  parser->plan_variant_signature = signature;
+
+  error = do_prepare_select (parser, statement);
+
+  parser->plan_variant_selectivity = NULL;
+  parser->plan_variant_signature = 0;
+
+  variant = NULL;
+  if (error == NO_ERROR && statement->xasl_id != NULL)
+    {
+      variant = &plan_variants->variants[plan_variants->n_variants++];
+      variant->signature = signature;
+      XASL_ID_COPY (&variant->xasl_id, statement->xasl_id);
+    }
+  else if (error != NO_ERROR)
+    {
+      /* the generic plan is still good */
+      er_clear ();
+      pt_reset_error (parser);
+      error = NO_ERROR;
+    }
+
+  if (statement->xasl_id != NULL)
+    {
+      free_and_init (statement->xasl_id);
+    }
+  statement->xasl_id = save_xasl_id;
+  statement->flag.use_plan_cache = save_use_plan_cache;
+  statement->flag.cannot_prepare = save_cannot_prepare;
+  parser->context = save_context;
+
+  if (variant != NULL)
+    {
+      *xasl_id_p = &variant->xasl_id;
+    }
+
+end:
+  free_and_init (selectivity);
+
+  return error;
+}
+
 static int
 do_reserve_oidinfo (PARSER_CONTEXT * parser, PT_NODE * statement, OID ** reserved_oid)
 {
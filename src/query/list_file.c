@@ -37,6 +37,7 @@
 #include "db_value_printer.hpp"
 #include "dbtype.h"
 #include "error_manager.h"
+#include "language_support.h"
 #include "log_append.hpp"
 #include "object_primitive.h"
 #include "object_representation.h"
@@ -285,6 +286,10 @@ static DB_VALUE *qfile_get_list_cache_entry_param_values (QFILE_LIST_CACHE_ENTRY
 static int qfile_compare_with_null_value (int o0, int o1, SUBKEY_INFO key_info);
 static int qfile_compare_with_interpolation_domain (char *fp0, char *fp1, SUBKEY_INFO * subkey,
 						    SORTKEY_INFO * key_info);
+static bool qfile_initialize_sort_key_prefix (SORTKEY_INFO * key_info_p);
+static void qfile_make_sort_key_prefix (SORTKEY_INFO * key_info_p, QFILE_TUPLE tuple, unsigned char *prefix);
+static int qfile_put_sort_key_prefix_bytes (unsigned char *bytes, UINT64 value, int size);
+static bool qfile_compare_sort_key_prefix (const unsigned char *prefix0, const unsigned char *prefix1, int *order);
 
 #if defined(SERVER_MODE)
 static BH_CMP_RESULT
@@ -1366,17 +1371,12 @@ qfile_reopen_list_as_append_mode (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_
   else
     {
       assert_release (!VPID_ISNULL (&list_id_p->last_vpid));
-      last_page_ptr =
-	pgbuf_fix (thread_p, &list_id_p->last_vpid, OLD_PAGE, PGBUF_LATCH_WRITE, PGBUF_UNCONDITIONAL_LATCH);
+      /* the last page may be a compressed page of the temp file */
+      last_page_ptr = qmgr_get_old_page (thread_p, &list_id_p->last_vpid, temp_file_p);
       if (last_page_ptr == NULL)
 	{
 	  return ER_FAILED;
 	}
-
-#if !defined (NDEBUG)
-      (void) pgbuf_check_page_ptype (thread_p, last_page_ptr, PAGE_QRESULT);
-#endif /* !NDEBUG */
-
     }
 
   list_id_p->last_pgptr = last_page_ptr;
@@ -3159,6 +3159,7 @@ qfile_make_sort_key (THREAD_ENTRY * thread_p, SORTKEY_INFO * key_info_p, RECDES
   SCAN_CODE scan_status;
   char *field_data;
   int field_length, offset;
+  unsigned char *prefix = NULL;
   SORT_STATUS status;
 
   scan_status = qfile_scan_list_next (thread_p, input_scan_p, tuple_record_p, PEEK);
@@ -3189,6 +3190,14 @@ qfile_make_sort_key (THREAD_ENTRY * thread_p, SORTKEY_INFO * key_info_p, RECDES
 	  sort_record_p->s.original.offset = input_scan_p->curr_offset;
 	}
 
+      if (key_info_p->use_key_prefix)
+	{
+	  /* built once the record is known to fit */
+	  prefix = (unsigned char *) data;
+	  data += SORT_KEY_PREFIX_SIZE;
+	  length += SORT_KEY_PREFIX_SIZE;
+	}
+
       /* STEP 2: build body */
       for (i = 0; i < nkeys; i++)
 	{
@@ -3222,6 +3231,14 @@ qfile_make_sort_key (THREAD_ENTRY * thread_p, SORTKEY_INFO * key_info_p, RECDES
 
       length = CAST_BUFLEN (data - key_record_p->data);	/* i.e, 4 + 4 * (n - 1) */
 
+      if (key_info_p->use_key_prefix)
+	{
+	  /* built once the record is known to fit */
+	  prefix = (unsigned char *) data;
+	  data += SORT_KEY_PREFIX_SIZE;
+	  length += SORT_KEY_PREFIX_SIZE;
+	}
+
       /* STEP 1: build header(offset_MAP) - go on with STEP 2 */
 
       /* STEP 2: build body */
@@ -3268,6 +3285,10 @@ qfile_make_sort_key (THREAD_ENTRY * thread_p, SORTKEY_INFO * key_info_p, RECDES
 
   if (key_record_p->length <= key_record_p->area_size)
     {
+      if (prefix != NULL)
+	{
+	  qfile_make_sort_key_prefix (key_info_p, tuple_record_p->tpl, prefix);
+	}
       status = SORT_SUCCESS;
     }
   else
@@ -3592,6 +3613,17 @@ qfile_compare_partial_sort_record (const void *pk0, const void *pk1, void *arg)
   fp1 = &(k1->s.original.body[0]);
   fp1 = PTR_ALIGN (fp1, MAX_ALIGNMENT);
 
+  if (key_info_p->use_key_prefix)
+    {
+      if (qfile_compare_sort_key_prefix ((unsigned char *) fp0, (unsigned char *) fp1, &order))
+	{
+	  return order;
+	}
+
+      fp0 += SORT_KEY_PREFIX_SIZE;
+      fp1 += SORT_KEY_PREFIX_SIZE;
+    }
+
   for (i = 0; i < n; i++)
     {
       if (QFILE_GET_TUPLE_VALUE_FLAG (fp0) == V_BOUND)
@@ -3662,6 +3694,13 @@ qfile_compare_all_sort_record (const void *pk0, const void *pk1, void *arg)
   k0 = *(SORT_REC **) pk0;
   k1 = *(SORT_REC **) pk1;
 
+  if (key_info_p->use_key_prefix
+      && qfile_compare_sort_key_prefix (qfile_get_sort_key_prefix (k0, key_info_p),
+					qfile_get_sort_key_prefix (k1, key_info_p), &order))
+    {
+      return order;
+    }
+
   for (i = 0; i < n; i++)
     {
       o0 = k0->s.offset[i];
@@ -3689,6 +3728,297 @@ qfile_compare_all_sort_record (const void *pk0, const void *pk1, void *arg)
   return order;
 }
 
+/*
+ * qfile_get_sort_key_prefix () - normalized key prefix of a sort record
+ *   return: SORT_KEY_PREFIX_SIZE bytes at the start of the record body
+ *   sort_rec(in): sort record
+ *   arg(in): sort key information
+ */
+const unsigned char *
+qfile_get_sort_key_prefix (const SORT_REC * sort_rec, void *arg)
+{
+  SORTKEY_INFO *key_info_p = (SORTKEY_INFO *) arg;
+  const char *body;
+
+  assert (key_info_p->use_key_prefix);
+
+  if (key_info_p->use_original)
+    {
+      body = &(sort_rec->s.original.body[0]);
+    }
+  else
+    {
+      body = (const char *) &sort_rec->s.offset[key_info_p->nkeys];
+    }
+
+  return (const unsigned char *) PTR_ALIGN (body, MAX_ALIGNMENT);
+}
+
+/*
+ * qfile_compare_sort_key_prefix () - compare the normalized key prefixes of two sort records
+ *   return: true if the prefixes decide the order of the records, false if their keys must be compared
+ *   prefix0(in): prefix of the first record
+ *   prefix1(in): prefix of the second record
+ *   order(out): -1, 0, or 1, strcmp-style
+ */
+static bool
+qfile_compare_sort_key_prefix (const unsigned char *prefix0, const unsigned char *prefix1, int *order)
+{
+  int length0, length1;
+  int cmp;
+
+  length0 = SORT_KEY_PREFIX_LENGTH (prefix0);
+  length1 = SORT_KEY_PREFIX_LENGTH (prefix1);
+
+  cmp = memcmp (prefix0, prefix1, MIN (length0, length1));
+  if (cmp != 0)
+    {
+      *order = (cmp < 0) ? -1 : 1;
+      return true;
+    }
+
+  if (length0 == length1 && SORT_KEY_PREFIX_IS_COMPLETE (prefix0) && SORT_KEY_PREFIX_IS_COMPLETE (prefix1))
+    {
+      *order = 0;
+      return true;
+    }
+
+  return false;
+}
+
+/*
+ * qfile_initialize_sort_key_prefix () - find the keys that normalized key prefixes of the sort records can hold
+ *   return: true if the first key can be normalized
+ *   key_info_p(in/out): sort key information
+ *
+ * Note: integers, dates, times, timestamps, datetimes and numerics are normalized to big-endian bytes, and strings to
+ *       the weights of their bytes in collations that compare bytes on weights. The keys after a key that cannot be
+ *       normalized, or after a string, are not in the prefix.
+ */
+static bool
+qfile_initialize_sort_key_prefix (SORTKEY_INFO * key_info_p)
+{
+  SUBKEY_INFO *subkey;
+  DB_TYPE type;
+  int i;
+
+  for (i = 0; i < key_info_p->nkeys; i++)
+    {
+      subkey = &key_info_p->key[i];
+      subkey->prefix_type = DB_TYPE_NULL;
+      subkey->prefix_weights = NULL;
+
+      if (subkey->use_cmp_dom || subkey->col_dom == NULL)
+	{
+	  break;
+	}
+
+      type = TP_DOMAIN_TYPE (subkey->col_dom);
+      switch (type)
+	{
+	case DB_TYPE_SHORT:
+	case DB_TYPE_INTEGER:
+	case DB_TYPE_BIGINT:
+	case DB_TYPE_DATE:
+	case DB_TYPE_TIME:
+	case DB_TYPE_TIMESTAMP:
+	case DB_TYPE_DATETIME:
+	case DB_TYPE_NUMERIC:
+	  subkey->prefix_type = type;
+	  break;
+
+	case DB_TYPE_STRING:
+	  subkey->prefix_weights =
+	    lang_get_byte_sort_weights (lang_get_collation (subkey->col_dom->collation_id),
+					prm_get_bool_value (PRM_ID_IGNORE_TRAILING_SPACE));
+	  if (subkey->prefix_weights != NULL)
+	    {
+	      subkey->prefix_type = type;
+	    }
+	  break;
+
+	default:
+	  break;
+	}
+
+      if (subkey->prefix_type == DB_TYPE_NULL || subkey->prefix_type == DB_TYPE_STRING)
+	{
+	  break;
+	}
+    }
+
+  /* the keys after the last one in the prefix keep DB_TYPE_NULL from qfile_initialize_sort_key_info () */
+  return key_info_p->nkeys > 0 && key_info_p->key[0].prefix_type != DB_TYPE_NULL;
+}
+
+/*
+ * qfile_put_sort_key_prefix_bytes () - put an unsigned value in big-endian bytes
+ *   return: size
+ *   bytes(out): bytes of the value
+ *   value(in): value
+ *   size(in): number of bytes
+ */
+static int
+qfile_put_sort_key_prefix_bytes (unsigned char *bytes, UINT64 value, int size)
+{
+  int i;
+
+  for (i = size - 1; i >= 0; i--)
+    {
+      bytes[i] = (unsigned char) (value & 0xff);
+      value >>= 8;
+    }
+
+  return size;
+}
+
+/*
+ * qfile_make_sort_key_prefix () - make the normalized key prefix of a sort record
+ *   return: void
+ *   key_info_p(in): sort key information
+ *   tuple(in): tuple the sort record is made of
+ *   prefix(out): SORT_KEY_PREFIX_SIZE bytes
+ *
+ * Note: each key is a byte ordering null and non-null values as the sort does, followed for a non-null value by its
+ *       normalized bytes, inverted for a descending key. A string fills the rest of the prefix with the weights of
+ *       its bytes padded with zeros. A long string that may be compressed, or a numeric that does not fit its
+ *       precision, ends the prefix before its bytes.
+ */
+static void
+qfile_make_sort_key_prefix (SORTKEY_INFO * key_info_p, QFILE_TUPLE tuple, unsigned char *prefix)
+{
+  unsigned char bytes[DB_NUMERIC_BUF_SIZE];	/* the largest normalized value */
+  unsigned char *p, *end;
+  SUBKEY_INFO *subkey;
+  char *field_data, *data;
+  DB_BIGINT bigint;
+  DB_DATETIME datetime;
+  unsigned int time_value;
+  int i, j, size, str_length, n_sign_bytes;
+  bool is_complete = true;
+
+  memset (prefix, 0, SORT_KEY_PREFIX_SIZE);
+  p = prefix;
+  end = prefix + SORT_KEY_PREFIX_MAX_LENGTH;
+
+  for (i = 0; i < key_info_p->nkeys && p < end; i++)
+    {
+      subkey = &key_info_p->key[i];
+      if (subkey->prefix_type == DB_TYPE_NULL)
+	{
+	  break;
+	}
+
+      QFILE_GET_TUPLE_VALUE_HEADER_POSITION (tuple, subkey->col, field_data);
+      if (QFILE_GET_TUPLE_VALUE_FLAG (field_data) != V_BOUND)
+	{
+	  *p++ = subkey->is_nulls_first ? 0x00 : 0x02;
+	  continue;
+	}
+
+      *p++ = 0x01;
+      data = field_data + QFILE_TUPLE_VALUE_HEADER_SIZE;
+
+      if (subkey->prefix_type == DB_TYPE_STRING)
+	{
+	  str_length = OR_GET_BYTE (data);
+	  if (str_length >= OR_MINIMUM_STRING_LENGTH_FOR_COMPRESSION)
+	    {
+	      is_complete = false;
+	      break;
+	    }
+
+	  data += OR_BYTE_SIZE;
+	  for (j = 0; j < str_length && p < end; j++)
+	    {
+	      *p = (data[j] == ' ') ? 0 : (unsigned char) subkey->prefix_weights[(unsigned char) data[j]];
+	      *p = subkey->is_desc ? ~*p : *p;
+	      p++;
+	    }
+
+	  /* pad with zeros, which are already there for an ascending key */
+	  for (; subkey->is_desc && p < end; p++)
+	    {
+	      *p = 0xff;
+	    }
+	  p = end;
+	  is_complete = false;
+	  break;
+	}
+
+      switch (subkey->prefix_type)
+	{
+	case DB_TYPE_SHORT:
+	  size = qfile_put_sort_key_prefix_bytes (bytes, (unsigned short) OR_GET_SHORT (data) ^ 0x8000, OR_SHORT_SIZE);
+	  break;
+	case DB_TYPE_INTEGER:
+	  size = qfile_put_sort_key_prefix_bytes (bytes, (unsigned int) OR_GET_INT (data) ^ 0x80000000, OR_INT_SIZE);
+	  break;
+	case DB_TYPE_BIGINT:
+	  OR_GET_BIGINT (data, &bigint);
+	  size = qfile_put_sort_key_prefix_bytes (bytes, (UINT64) bigint ^ 0x8000000000000000ULL, OR_BIGINT_SIZE);
+	  break;
+	case DB_TYPE_DATE:
+	case DB_TYPE_TIME:
+	case DB_TYPE_TIMESTAMP:
+	  time_value = (unsigned int) OR_GET_INT (data);
+	  size = qfile_put_sort_key_prefix_bytes (bytes, time_value, OR_INT_SIZE);
+	  break;
+	case DB_TYPE_DATETIME:
+	  OR_GET_DATETIME (data, &datetime);
+	  size = qfile_put_sort_key_prefix_bytes (bytes, datetime.date, OR_INT_SIZE);
+	  size += qfile_put_sort_key_prefix_bytes (bytes + size, datetime.time, OR_INT_SIZE);
+	  break;
+	case DB_TYPE_NUMERIC:
+	  /* two's complement big-endian integer at the scale of the domain, cut to the bytes of its precision */
+	  size = MIN ((subkey->col_dom->precision * 3322 / 1000 + 2 + 7) / 8, (int) DB_NUMERIC_BUF_SIZE);
+	  n_sign_bytes = (int) DB_NUMERIC_BUF_SIZE - size;
+	  for (j = 0; j < n_sign_bytes; j++)
+	    {
+	      if ((unsigned char) data[j] != (((unsigned char) data[n_sign_bytes] & 0x80) ? 0xff : 0))
+		{
+		  break;
+		}
+	    }
+	  if (j < n_sign_bytes)
+	    {
+	      /* does not fit its precision; the prefix ends before it */
+	      size = -1;
+	      break;
+	    }
+	  memcpy (bytes, data + n_sign_bytes, size);
+	  bytes[0] ^= 0x80;
+	  break;
+	default:
+	  assert (false);
+	  size = -1;
+	  break;
+	}
+
+      if (size < 0)
+	{
+	  is_complete = false;
+	  break;
+	}
+
+      for (j = 0; j < size && p < end; j++)
+	{
+	  *p++ = subkey->is_desc ? ~bytes[j] : bytes[j];
+	}
+      if (j < size)
+	{
+	  is_complete = false;
+	}
+    }
+
+  if (i < key_info_p->nkeys)
+    {
+      is_complete = false;
+    }
+
+  prefix[SORT_KEY_PREFIX_MAX_LENGTH] = (unsigned char) ((p - prefix) | (is_complete ? SORT_KEY_PREFIX_COMPLETE : 0));
+}
+
 /*
  * qfile_compare_with_null_value () -
  *   return: -1, 0, or 1, strcmp-style
@@ -3778,6 +4108,11 @@ qfile_get_estimated_pages_for_sorting (QFILE_LIST_ID * list_id_p, SORTKEY_INFO *
       sort_key_overhead = (int) ceil (((double) (list_id_p->tuple_cnt * sort_key_size)) / DB_PAGESIZE);
     }
 
+  if (key_info_p->use_key_prefix)
+    {
+      sort_key_overhead += (int) ceil (((double) (list_id_p->tuple_cnt * SORT_KEY_PREFIX_SIZE)) / DB_PAGESIZE);
+    }
+
   return prorated_pages + sort_key_overhead;
 }
 
@@ -3811,6 +4146,7 @@ qfile_initialize_sort_key_info (SORTKEY_INFO * key_info_p, SORT_LIST * list_p, Q
   key_info_p->nkeys = n;
   key_info_p->use_original = (n != types->type_cnt);
   key_info_p->error = NO_ERROR;
+  key_info_p->use_key_prefix = false;
 
   if (n <= (int) DIM (key_info_p->default_keys))
     {
@@ -3838,6 +4174,8 @@ qfile_initialize_sort_key_info (SORTKEY_INFO * key_info_p, SORT_LIST * list_p, Q
 	  subkey->col_dom = p->pos_descr.dom;
 	  subkey->cmp_dom = NULL;
 	  subkey->use_cmp_dom = false;
+	  subkey->prefix_type = DB_TYPE_NULL;
+	  subkey->prefix_weights = NULL;
 
 	  if (p->pos_descr.dom->type->id == DB_TYPE_VARIABLE)
 	    {
@@ -3872,6 +4210,8 @@ qfile_initialize_sort_key_info (SORTKEY_INFO * key_info_p, SORT_LIST * list_p, Q
 	  subkey->col_dom = types->domp[i];
 	  subkey->cmp_dom = NULL;
 	  subkey->use_cmp_dom = false;
+	  subkey->prefix_type = DB_TYPE_NULL;
+	  subkey->prefix_weights = NULL;
 	  subkey->sort_f = types->domp[i]->type->get_data_cmpdisk_function ();
 	  subkey->is_desc = 0;
 	  subkey->is_nulls_first = 1;
@@ -4007,6 +4347,12 @@ qfile_sort_list_with_func (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p, S
   info.output_file = srlist_id;
   info.extra_arg = extra_arg;
 
+  if (get_func == NULL && cmp_func == NULL && prm_get_bool_value (PRM_ID_SORT_KEY_NORMALIZATION))
+    {
+      /* the records are made and compared here, so they can start with a normalized key prefix */
+      info.key_info.use_key_prefix = qfile_initialize_sort_key_prefix (&info.key_info);
+    }
+
   if (get_func == NULL)
     {
       get_func = &qfile_get_next_sort_item;
@@ -4039,7 +4385,8 @@ qfile_sort_list_with_func (THREAD_ENTRY * thread_p, QFILE_LIST_ID * list_id_p, S
 
   sort_result =
     sort_listfile (thread_p, NULL_VOLID, estimated_pages, get_func, &info, put_func, &info, cmp_func, &info.key_info,
-		   dup_option, limit, srlist_id->tfile_vfid->tde_encrypted);
+		   (info.key_info.use_key_prefix ? &qfile_get_sort_key_prefix : NULL), dup_option, limit,
+		   srlist_id->tfile_vfid->tde_encrypted);
 
   if (sort_result < 0)
     {
@@ -140,6 +140,7 @@ extern SORT_STATUS qfile_make_sort_key (THREAD_ENTRY * thread_p, SORTKEY_INFO *
 extern QFILE_TUPLE qfile_generate_sort_tuple (SORTKEY_INFO * info, SORT_REC * sort_rec, RECDES * output_recdes);
 extern int qfile_compare_partial_sort_record (const void *pk0, const void *pk1, void *arg);
 extern int qfile_compare_all_sort_record (const void *pk0, const void *pk1, void *arg);
+extern const unsigned char *qfile_get_sort_key_prefix (const SORT_REC * sort_rec, void *arg);
 extern int qfile_get_estimated_pages_for_sorting (QFILE_LIST_ID * listid, SORTKEY_INFO * info);
 extern SORTKEY_INFO *qfile_initialize_sort_key_info (SORTKEY_INFO * info, SORT_LIST * list,
 						     QFILE_TUPLE_VALUE_TYPE_LIST * types);
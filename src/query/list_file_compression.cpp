@@ -0,0 +1,461 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// list_file_compression - LZ4 compressed pages of the temporary list files that spill out of their memory buffer
+//
+
+#include "list_file_compression.hpp"
+
+#include "error_manager.h"
+#include "file_manager.h"
+#include "log_impl.h"
+#include "page_buffer.h"
+
+#include "lz4.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  static int
+  cps_init_packed_page (THREAD_ENTRY *thread_p, PAGE_PTR page, void *args)
+  {
+    pgbuf_set_page_ptype (thread_p, page, PAGE_QRESULT);
+    pgbuf_set_dirty (thread_p, page, DONT_FREE);
+
+    return NO_ERROR;
+  }
+
+  compressed_page_store::compressed_page_store (const VFID &temp_vfid)
+    : m_vfid (temp_vfid)
+    , m_mutex ()
+    , m_images ()
+    , m_packed_vpids ()
+    , m_packed_end (0)
+    , m_frames ()
+    , m_frame_pageids ()
+    , m_clean_lru ()
+    , m_buffer (LZ4_compressBound (DB_PAGESIZE))
+    , m_is_compressing (true)
+    , m_sample_raw_pages (0)
+    , m_sample_stored_bytes (0)
+    , m_pages_since_probe (0)
+  {
+    assert (!VFID_ISNULL (&temp_vfid));
+  }
+
+  compressed_page_store::~compressed_page_store ()
+  {
+    for (auto &it : m_frames)
+      {
+	/* all pages are unfixed when the list files of the temp file are destroyed */
+	assert (it.second.fix_count == 0);
+	free (it.second.page);
+      }
+  }
+
+  bool
+  compressed_page_store::is_store_vpid (const VPID *vpid)
+  {
+    return vpid->volid == PAGE_VOLID;
+  }
+
+  PAGE_PTR
+  compressed_page_store::new_page (THREAD_ENTRY *thread_p, VPID *vpid)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    int pageid = (int) m_images.size ();
+    frame *fr;
+
+    fr = alloc_frame (pageid);
+    if (fr == NULL)
+      {
+	return NULL;
+      }
+
+    m_images.push_back ({ -1, 0, false });
+
+    std::memset (fr->page, 0, DB_PAGESIZE);
+    fr->fix_count = 1;
+    fr->is_dirty = true;
+
+    vpid->volid = PAGE_VOLID;
+    vpid->pageid = pageid;
+
+    return fr->page;
+  }
+
+  PAGE_PTR
+  compressed_page_store::fix_page (THREAD_ENTRY *thread_p, const VPID *vpid)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+    int pageid = vpid->pageid;
+    frame *fr;
+
+    if (vpid->volid != PAGE_VOLID || pageid < 0 || pageid >= (int) m_images.size ())
+      {
+	assert (false);
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_TEMP_FILE, 1, LOG_FIND_THREAD_TRAN_INDEX (thread_p));
+	return NULL;
+      }
+
+    auto found = m_frames.find (pageid);
+    if (found != m_frames.end ())
+      {
+	fr = &found->second;
+	if (fr->fix_count == 0 && !fr->is_dirty)
+	  {
+	    m_clean_lru.erase (fr->lru_pos);
+	  }
+	fr->fix_count++;
+	return fr->page;
+      }
+
+    fr = alloc_frame (pageid);
+    if (fr == NULL)
+      {
+	return NULL;
+      }
+
+    if (read_image (thread_p, pageid, fr->page) != NO_ERROR)
+      {
+	free_frame (pageid);
+	return NULL;
+      }
+
+    fr->fix_count = 1;
+    fr->is_dirty = false;
+
+    return fr->page;
+  }
+
+  bool
+  compressed_page_store::owns_page (PAGE_PTR page)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_frame_pageids.find (page) != m_frame_pageids.end ();
+  }
+
+  void
+  compressed_page_store::set_dirty (PAGE_PTR page)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    auto found = m_frame_pageids.find (page);
+    if (found == m_frame_pageids.end ())
+      {
+	assert (false);
+	return;
+      }
+
+    frame &fr = m_frames.at (found->second);
+    assert (fr.fix_count > 0);
+    fr.is_dirty = true;
+  }
+
+  void
+  compressed_page_store::unfix_page (THREAD_ENTRY *thread_p, PAGE_PTR page)
+  {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    auto found = m_frame_pageids.find (page);
+    if (found == m_frame_pageids.end ())
+      {
+	assert (false);
+	return;
+      }
+
+    int pageid = found->second;
+    frame &fr = m_frames.at (pageid);
+
+    assert (fr.fix_count > 0);
+    if (--fr.fix_count > 0)
+      {
+	return;
+      }
+
+    if (fr.is_dirty)
+      {
+	if (write_image (thread_p, pageid, fr.page) != NO_ERROR)
+	  {
+	    /* keep the frame; the next unfix writes it again */
+	    ASSERT_ERROR ();
+	    return;
+	  }
+	fr.is_dirty = false;
+      }
+
+    release_frame (pageid, fr);
+  }
+
+  compressed_page_store::frame *
+  compressed_page_store::alloc_frame (int pageid)
+  {
+    PAGE_PTR page = (PAGE_PTR) malloc (DB_PAGESIZE);
+
+    if (page == NULL)
+      {
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) DB_PAGESIZE);
+	return NULL;
+      }
+
+    frame &fr = m_frames[pageid];
+    fr.page = page;
+    fr.fix_count = 0;
+    fr.is_dirty = false;
+    m_frame_pageids[page] = pageid;
+
+    return &fr;
+  }
+
+  void
+  compressed_page_store::free_frame (int pageid)
+  {
+    auto found = m_frames.find (pageid);
+
+    assert (found != m_frames.end ());
+    m_frame_pageids.erase (found->second.page);
+    free (found->second.page);
+    m_frames.erase (found);
+  }
+
+  void
+  compressed_page_store::release_frame (int pageid, frame &fr)
+  {
+    int victim;
+
+    /* keep the clean frame for the next fix of the page */
+    m_clean_lru.push_front (pageid);
+    fr.lru_pos = m_clean_lru.begin ();
+
+    if ((int) m_clean_lru.size () > MAX_CLEAN_FRAMES)
+      {
+	victim = m_clean_lru.back ();
+	m_clean_lru.pop_back ();
+	free_frame (victim);
+      }
+  }
+
+  bool
+  compressed_page_store::compress_next_page ()
+  {
+    if (m_is_compressing)
+      {
+	return true;
+      }
+
+    if (++m_pages_since_probe >= PROBE_INTERVAL)
+      {
+	m_pages_since_probe = 0;
+	return true;
+      }
+
+    return false;
+  }
+
+  void
+  compressed_page_store::sample_ratio (int stored_length)
+  {
+    if (!m_is_compressing)
+      {
+	/* probe; one page that compresses well enough is worth trying again */
+	if (stored_length * 100 <= DB_PAGESIZE * MAX_STORED_PERCENT)
+	  {
+	    m_is_compressing = true;
+	    m_sample_raw_pages = 0;
+	    m_sample_stored_bytes = 0;
+	  }
+	return;
+      }
+
+    m_sample_raw_pages++;
+    m_sample_stored_bytes += stored_length;
+    if (m_sample_raw_pages < SAMPLE_PAGES)
+      {
+	return;
+      }
+
+    m_is_compressing =
+	    m_sample_stored_bytes * 100 <= (std::int64_t) m_sample_raw_pages * DB_PAGESIZE * MAX_STORED_PERCENT;
+    m_sample_raw_pages = 0;
+    m_sample_stored_bytes = 0;
+    m_pages_since_probe = 0;
+  }
+
+  int
+  compressed_page_store::write_image (THREAD_ENTRY *thread_p, int pageid, PAGE_PTR page)
+  {
+    page_image &image = m_images[pageid];
+    const char *data = page;
+    int length = DB_PAGESIZE;
+    bool is_compressed = false;
+    std::int64_t offset;
+    int error;
+
+    if (compress_next_page ())
+      {
+	int compressed_length = LZ4_compress_default (page, m_buffer.data (), DB_PAGESIZE, (int) m_buffer.size ());
+
+	if (compressed_length > 0 && compressed_length * 100 <= DB_PAGESIZE * MAX_STORED_PERCENT)
+	  {
+	    data = m_buffer.data ();
+	    length = compressed_length;
+	    is_compressed = true;
+	  }
+	sample_ratio (length);
+      }
+
+    /* an image rewritten no larger than before keeps its place in the stream */
+    offset = (image.offset >= 0 && length <= image.length) ? image.offset : m_packed_end;
+
+    error = write_stream (thread_p, offset, data, length);
+    if (error != NO_ERROR)
+      {
+	return error;
+      }
+
+    if (offset == m_packed_end)
+      {
+	m_packed_end += length;
+      }
+    image.offset = offset;
+    image.length = length;
+    image.is_compressed = is_compressed;
+
+    return NO_ERROR;
+  }
+
+  int
+  compressed_page_store::read_image (THREAD_ENTRY *thread_p, int pageid, PAGE_PTR page)
+  {
+    const page_image &image = m_images[pageid];
+    int error;
+
+    if (image.offset < 0)
+      {
+	/* allocated, but unfixed before it could be written */
+	assert (false);
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_TEMP_FILE, 1, LOG_FIND_THREAD_TRAN_INDEX (thread_p));
+	return ER_QPROC_INVALID_TEMP_FILE;
+      }
+
+    if (!image.is_compressed)
+      {
+	return read_stream (thread_p, image.offset, page, image.length);
+      }
+
+    error = read_stream (thread_p, image.offset, m_buffer.data (), image.length);
+    if (error != NO_ERROR)
+      {
+	return error;
+      }
+
+    if (LZ4_decompress_safe (m_buffer.data (), page, image.length, DB_PAGESIZE) != DB_PAGESIZE)
+      {
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_IO_LZ4_DECOMPRESS_FAIL, 0);
+	return ER_IO_LZ4_DECOMPRESS_FAIL;
+      }
+
+    return NO_ERROR;
+  }
+
+  int
+  compressed_page_store::write_stream (THREAD_ENTRY *thread_p, std::int64_t offset, const char *data, int length)
+  {
+    std::size_t index = (std::size_t) (offset / DB_PAGESIZE);
+    int page_offset = (int) (offset % DB_PAGESIZE);
+    PAGE_PTR packed_page;
+    VPID vpid;
+    int chunk;
+    int error;
+
+    while (length > 0)
+      {
+	if (index < m_packed_vpids.size ())
+	  {
+	    packed_page = pgbuf_fix (thread_p, &m_packed_vpids[index], OLD_PAGE, PGBUF_LATCH_WRITE,
+				     PGBUF_UNCONDITIONAL_LATCH);
+	    if (packed_page == NULL)
+	      {
+		ASSERT_ERROR_AND_SET (error);
+		return error;
+	      }
+	  }
+	else
+	  {
+	    assert (index == m_packed_vpids.size ());
+	    error = file_alloc (thread_p, &m_vfid, cps_init_packed_page, NULL, &vpid, &packed_page);
+	    if (error != NO_ERROR)
+	      {
+		ASSERT_ERROR ();
+		return error;
+	      }
+	    m_packed_vpids.push_back (vpid);
+	  }
+
+	chunk = std::min (length, DB_PAGESIZE - page_offset);
+	std::memcpy (packed_page + page_offset, data, chunk);
+	pgbuf_set_dirty (thread_p, packed_page, FREE);
+
+	data += chunk;
+	length -= chunk;
+	page_offset = 0;
+	index++;
+      }
+
+    return NO_ERROR;
+  }
+
+  int
+  compressed_page_store::read_stream (THREAD_ENTRY *thread_p, std::int64_t offset, char *data, int length)
+  {
+    std::size_t index = (std::size_t) (offset / DB_PAGESIZE);
+    int page_offset = (int) (offset % DB_PAGESIZE);
+    PAGE_PTR packed_page;
+    int chunk;
+    int error;
+
+    while (length > 0)
+      {
+	assert (index < m_packed_vpids.size ());
+	packed_page = pgbuf_fix (thread_p, &m_packed_vpids[index], OLD_PAGE, PGBUF_LATCH_READ,
+				 PGBUF_UNCONDITIONAL_LATCH);
+	if (packed_page == NULL)
+	  {
+	    ASSERT_ERROR_AND_SET (error);
+	    return error;
+	  }
+
+	chunk = std::min (length, DB_PAGESIZE - page_offset);
+	std::memcpy (data, packed_page + page_offset, chunk);
+	pgbuf_unfix (thread_p, packed_page);
+
+	data += chunk;
+	length -= chunk;
+	page_offset = 0;
+	index++;
+      }
+
+    return NO_ERROR;
+  }
+} // namespace cubquery
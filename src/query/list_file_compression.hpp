@@ -0,0 +1,157 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// list_file_compression - LZ4 compressed pages of the temporary list files that spill out of their memory buffer
+//
+//  when list_file_compression is on, the pages a temporary list file gets once its memory buffer is exhausted are not
+//  pages of its temp file, but logical pages of a compressed page store. a logical page is handed out as a frame in
+//  memory; when its last fix is released and it was modified, the frame is compressed and appended to a stream of
+//  packed images, stored in the pages of the temp file of the list file. fixing the page again decompresses its image
+//  into a frame. a few clean frames are kept, so that the pages fixed one after the other by a scan are decompressed
+//  once.
+//
+//  logical pages are identified by a VPID whose volume is PAGE_VOLID, so the query manager knows which pages belong to
+//  the store. the list file code handles them like any other page.
+//
+//  the pages of wide or random rows barely compress. the store measures the ratio of the pages it compresses and
+//  stores the pages raw while the ratio is not worth the CPU; every so often it probes a page again.
+//
+
+#ifndef _LIST_FILE_COMPRESSION_HPP_
+#define _LIST_FILE_COMPRESSION_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "storage_common.h"
+#include "thread_compat.hpp"
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace cubquery
+{
+  //
+  // compressed_page_store
+  //
+  //  description:
+  //    logical pages of a temporary list file, compressed into the pages of its temp file. all functions are safe to
+  //    call from several threads.
+  //
+  //  how to use:
+  //    compressed_page_store *store = new compressed_page_store (temp_vfid);
+  //
+  //    PAGE_PTR page = store->new_page (thread_p, &vpid);   // fixed, zeroed and dirty
+  //    // write page
+  //    store->unfix_page (thread_p, page);                  // compressed and written when dirty
+  //
+  //    page = store->fix_page (thread_p, &vpid);            // decompressed
+  //    // read page
+  //    store->unfix_page (thread_p, page);
+  //
+  //    delete store;   // before the temp file is retired; the packed pages are not deallocated
+  //
+  class compressed_page_store
+  {
+    public:
+      // volume of the VPIDs of the logical pages
+      static const VOLID PAGE_VOLID = -2;
+
+      // packed pages are allocated in temp_vfid
+      explicit compressed_page_store (const VFID &temp_vfid);
+      compressed_page_store (const compressed_page_store &) = delete;
+      compressed_page_store (compressed_page_store &&) = delete;
+
+      ~compressed_page_store ();
+
+      compressed_page_store &operator= (const compressed_page_store &) = delete;
+      compressed_page_store &operator= (compressed_page_store &&) = delete;
+
+      static bool is_store_vpid (const VPID *vpid);
+
+      // NULL with an error set on failure
+      PAGE_PTR new_page (THREAD_ENTRY *thread_p, VPID *vpid);
+      PAGE_PTR fix_page (THREAD_ENTRY *thread_p, const VPID *vpid);
+
+      // page is a fixed page of the store
+      bool owns_page (PAGE_PTR page);
+      void set_dirty (PAGE_PTR page);
+      // a dirty page that cannot be written stays in memory, so it is not lost
+      void unfix_page (THREAD_ENTRY *thread_p, PAGE_PTR page);
+
+    private:
+      struct page_image
+      {
+	std::int64_t offset;	// in the packed stream; -1 if never written
+	int length;
+	bool is_compressed;
+      };
+
+      struct frame
+      {
+	PAGE_PTR page;
+	int fix_count;
+	bool is_dirty;
+	std::list<int>::iterator lru_pos;	// of the clean unfixed frames
+      };
+
+      static const int MAX_CLEAN_FRAMES = 8;
+      // pages stored compressed only if they shrink at least to this percent of the page size
+      static const int MAX_STORED_PERCENT = 75;
+      // pages over which the compression ratio is measured
+      static const int SAMPLE_PAGES = 16;
+      // while compression is off, a page in this many is compressed to probe the ratio again
+      static const int PROBE_INTERVAL = 64;
+
+      frame *alloc_frame (int pageid);
+      void free_frame (int pageid);
+      void release_frame (int pageid, frame &fr);
+
+      bool compress_next_page ();
+      void sample_ratio (int stored_length);
+
+      int write_image (THREAD_ENTRY *thread_p, int pageid, PAGE_PTR page);
+      int read_image (THREAD_ENTRY *thread_p, int pageid, PAGE_PTR page);
+      int write_stream (THREAD_ENTRY *thread_p, std::int64_t offset, const char *data, int length);
+      int read_stream (THREAD_ENTRY *thread_p, std::int64_t offset, char *data, int length);
+
+      VFID m_vfid;
+      std::mutex m_mutex;
+
+      std::vector<page_image> m_images;	// of the logical pages, by pageid
+      std::vector<VPID> m_packed_vpids;	// pages of the packed stream
+      std::int64_t m_packed_end;
+
+      std::unordered_map<int, frame> m_frames;	// by pageid
+      std::unordered_map<PAGE_PTR, int> m_frame_pageids;
+      std::list<int> m_clean_lru;	// most recently unfixed first
+
+      std::vector<char> m_buffer;	// compressed image
+      bool m_is_compressing;
+      int m_sample_raw_pages;
+      std::int64_t m_sample_stored_bytes;
+      int m_pages_since_probe;
+  };
+} // namespace cubquery
+
+#endif // _LIST_FILE_COMPRESSION_HPP_
@@ -0,0 +1,360 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// parallel_heap_scan - scan a heap file with several workers, each one reading its own ranges of pages
+//
+
+#include "parallel_heap_scan.hpp"
+
+#include "error_manager.h"
+#include "file_manager.h"
+#include "log_impl.h"
+#include "memory_alloc.h"
+#include "parallel_query.hpp"
+#include "thread_entry.hpp"
+#if defined (SERVER_MODE)
+#include "thread_entry_task.hpp"
+#endif // SERVER_MODE
+#include "tsc_timer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  /* pages handed to a worker at once; small enough to balance the load of workers, large enough to keep the
+   * contention on the chunk cursor negligible */
+  const int PX_HEAP_SCAN_MAX_CHUNK_PAGES = 64;
+
+  parallel_heap_scan::parallel_heap_scan (const HFID &hfid, const OID &class_oid)
+    : m_hfid (hfid)
+    , m_class_oid (class_oid)
+    , m_mvcc_snapshot (NULL)
+    , m_tran_index (NULL_TRAN_INDEX)
+    , m_vpids (NULL)
+    , m_page_count (0)
+    , m_chunk_size (1)
+    , m_next_page { 0 }
+    , m_stop { false }
+    , m_error (NO_ERROR)
+    , m_func (NULL)
+    , m_mutex ()
+    , m_workers_done ()
+    , m_active_workers (0)
+    , m_worker_stats ()
+  {
+  }
+
+  parallel_heap_scan::~parallel_heap_scan ()
+  {
+    assert (m_active_workers == 0);
+
+    if (m_vpids != NULL)
+      {
+	db_private_free (NULL, m_vpids);
+      }
+  }
+
+  int
+  parallel_heap_scan::prepare (cubthread::entry &thread_ref)
+  {
+    int error_code = NO_ERROR;
+
+    m_tran_index = LOG_FIND_THREAD_TRAN_INDEX (&thread_ref);
+
+    /* the snapshot must be taken before collecting pages: objects visible to the snapshot can only be found on pages
+     * allocated before it. */
+    m_mvcc_snapshot = logtb_get_mvcc_snapshot (&thread_ref);
+    if (m_mvcc_snapshot == NULL)
+      {
+	ASSERT_ERROR_AND_SET (error_code);
+	return error_code;
+      }
+
+    error_code = file_get_user_page_vpids (&thread_ref, &m_hfid.vfid, &m_vpids, &m_page_count);
+    if (error_code != NO_ERROR)
+      {
+	ASSERT_ERROR ();
+	return error_code;
+      }
+
+    return NO_ERROR;
+  }
+
+  int
+  parallel_heap_scan::get_page_count () const
+  {
+    return m_page_count;
+  }
+
+  int
+  parallel_heap_scan::get_degree (int max_degree, int page_threshold) const
+  {
+    int degree;
+
+    if (page_threshold <= 0)
+      {
+	page_threshold = 1;
+      }
+
+    degree = m_page_count / page_threshold;
+    return std::max (1, std::min (degree, max_degree));
+  }
+
+  int
+  parallel_heap_scan::execute (cubthread::entry &thread_ref, int degree, const record_func &func)
+  {
+    int worker_id;
+    int helpers;
+
+    assert (m_tran_index == LOG_FIND_THREAD_TRAN_INDEX (&thread_ref));
+    assert (degree >= 1);
+
+    /* this thread is worker 0; no helpers in stand-alone mode or when the worker pool is busy */
+    helpers = px_reserve_workers (degree - 1);
+    degree = helpers + 1;
+
+    m_func = &func;
+    m_stop = false;
+    m_error = NO_ERROR;
+
+    start_pages (degree);
+
+    m_worker_stats.resize (degree);
+    std::memset (m_worker_stats.data (), 0, degree * sizeof (SCAN_PX_WORKER_STATS));
+
+#if defined (SERVER_MODE)
+    m_active_workers = helpers;
+    for (worker_id = 1; worker_id < degree; worker_id++)
+      {
+	// *INDENT-OFF*
+	cubthread::entry_callable_task *task =
+	  new cubthread::entry_callable_task (std::bind (&parallel_heap_scan::execute_worker_task, this,
+							 std::placeholders::_1, worker_id));
+	// *INDENT-ON*
+	px_push_task (task);
+      }
+#endif // SERVER_MODE
+
+    /* this thread works as worker 0 */
+    worker_id = 0;
+    scan_pages (thread_ref, worker_id);
+
+#if defined (SERVER_MODE)
+    {
+      /* wait for the other workers to finish; they use this object */
+      std::unique_lock<std::mutex> ulock (m_mutex);
+      m_workers_done.wait (ulock, [this] { return m_active_workers == 0; });
+    }
+#endif // SERVER_MODE
+
+    px_release_workers (helpers);
+    m_func = NULL;
+
+    if (m_error != NO_ERROR)
+      {
+	/* errors of other workers are set in their own context */
+	if (er_errid () == NO_ERROR)
+	  {
+	    if (m_error == ER_INTERRUPTED)
+	      {
+		er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
+	      }
+	    else
+	      {
+		er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+	      }
+	  }
+	return m_error;
+      }
+
+    return NO_ERROR;
+  }
+
+  const std::vector<SCAN_PX_WORKER_STATS> &
+  parallel_heap_scan::get_worker_stats () const
+  {
+    return m_worker_stats;
+  }
+
+  UINT64
+  parallel_heap_scan::get_read_rows () const
+  {
+    UINT64 read_rows = 0;
+
+    for (const SCAN_PX_WORKER_STATS &stats : m_worker_stats)
+      {
+	read_rows += stats.read_rows;
+      }
+    return read_rows;
+  }
+
+  UINT64
+  parallel_heap_scan::get_qualified_rows () const
+  {
+    UINT64 qualified_rows = 0;
+
+    for (const SCAN_PX_WORKER_STATS &stats : m_worker_stats)
+      {
+	qualified_rows += stats.qualified_rows;
+      }
+    return qualified_rows;
+  }
+
+  void
+  parallel_heap_scan::start_pages (int degree)
+  {
+    assert (degree >= 1);
+
+    m_next_page = 0;
+    m_chunk_size = std::max (1, std::min (PX_HEAP_SCAN_MAX_CHUNK_PAGES, m_page_count / (degree * 4)));
+  }
+
+  bool
+  parallel_heap_scan::get_next_page (int &page, int &last_page, VPID &vpid)
+  {
+    if (page >= last_page && !get_next_chunk (page, last_page))
+      {
+	return false;
+      }
+
+    vpid = m_vpids[page++];
+    return true;
+  }
+
+  bool
+  parallel_heap_scan::get_next_chunk (int &first_page, int &last_page)
+  {
+    if (m_stop)
+      {
+	return false;
+      }
+
+    first_page = m_next_page.fetch_add (m_chunk_size);
+    if (first_page >= m_page_count)
+      {
+	return false;
+      }
+    last_page = std::min (first_page + m_chunk_size, m_page_count);
+    return true;
+  }
+
+  void
+  parallel_heap_scan::set_error (int error_code)
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    if (m_error == NO_ERROR)
+      {
+	m_error = (error_code != NO_ERROR) ? error_code : ER_FAILED;
+      }
+    m_stop = true;
+  }
+
+  void
+  parallel_heap_scan::scan_pages (cubthread::entry &thread_ref, int worker_id)
+  {
+    SCAN_PX_WORKER_STATS &stats = m_worker_stats[worker_id];
+    HEAP_SCANRANGE scan_range;
+    RECDES recdes = RECDES_INITIALIZER;
+    OID oid;
+    SCAN_CODE scan;
+    DB_LOGICAL ev_res;
+    TSC_TICKS start_tick, end_tick;
+    TSCTIMEVAL tv_diff;
+    bool continue_checking = true;
+    int first_page, last_page, page;
+    int error_code;
+
+    tsc_getticks (&start_tick);
+
+    error_code = heap_scanrange_start (&thread_ref, &scan_range, &m_hfid, &m_class_oid, m_mvcc_snapshot);
+    if (error_code != NO_ERROR)
+      {
+	set_error (error_code);
+	return;
+      }
+
+    while (get_next_chunk (first_page, last_page))
+      {
+	if (logtb_is_interrupted_tran (&thread_ref, false, &continue_checking, m_tran_index))
+	  {
+	    set_error (ER_INTERRUPTED);
+	    break;
+	  }
+
+	for (page = first_page; page < last_page && !m_stop; page++)
+	  {
+	    stats.num_pages++;
+
+	    OID_SET_NULL (&oid);
+	    while ((scan = heap_page_next (&thread_ref, &m_vpids[page], &m_class_oid, &oid, &recdes,
+					   &scan_range.scan_cache, PEEK)) == S_SUCCESS)
+	      {
+		stats.read_rows++;
+
+		ev_res = (*m_func) (thread_ref, worker_id, oid, recdes);
+		if (ev_res == V_ERROR)
+		  {
+		    set_error (er_errid ());
+		    goto end;
+		  }
+		else if (ev_res == V_TRUE)
+		  {
+		    stats.qualified_rows++;
+		  }
+	      }
+
+	    if (scan != S_END)
+	      {
+		set_error (er_errid ());
+		goto end;
+	      }
+	  }
+      }
+
+end:
+    heap_scanrange_end (&thread_ref, &scan_range);
+
+    tsc_getticks (&end_tick);
+    tsc_elapsed_time_usec (&tv_diff, end_tick, start_tick);
+    TSC_ADD_TIMEVAL (stats.elapsed_scan, tv_diff);
+  }
+
+#if defined (SERVER_MODE)
+  void
+  parallel_heap_scan::execute_worker_task (cubthread::entry &thread_ref, int worker_id)
+  {
+    thread_ref.tran_index = m_tran_index;
+
+    scan_pages (thread_ref, worker_id);
+
+    thread_ref.tran_index = NULL_TRAN_INDEX;
+
+    /* this must be the last access to this object; requester may destroy it as soon as the mutex is released */
+    std::unique_lock<std::mutex> ulock (m_mutex);
+    if (--m_active_workers == 0)
+      {
+	m_workers_done.notify_all ();
+      }
+  }
+#endif // SERVER_MODE
+} // namespace cubquery
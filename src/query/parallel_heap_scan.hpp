@@ -0,0 +1,141 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// parallel_heap_scan - scan a heap file with several workers, each one reading its own ranges of pages
+//
+
+#ifndef _PARALLEL_HEAP_SCAN_HPP_
+#define _PARALLEL_HEAP_SCAN_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "heap_file.h"
+#include "scan_manager.h"       // SCAN_PX_WORKER_STATS
+#include "storage_common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// forward definitions
+namespace cubthread
+{
+  class entry;
+}
+
+namespace cubquery
+{
+  //
+  // parallel_heap_scan
+  //
+  //  description:
+  //    the user pages of the heap file are read from the file table and split into chunks of consecutive pages
+  //    (see file_get_user_page_vpids). workers take chunks one by one until all pages are scanned; each worker owns a
+  //    heap scan range (see heap_scanrange_start) and visits every object visible to the transaction snapshot. the
+  //    thread that requested the scan works as worker 0; the others are reserved from the parallel query worker pool
+  //    (see parallel_query.hpp), so the scan may get fewer workers than requested.
+  //
+  //    what is done with each object is decided by the caller through record_func, which is called from all workers
+  //    concurrently. it must only use state that belongs to the given worker.
+  //
+  //    in SA_MODE, when a single worker is requested or when no worker is available, all chunks are scanned by the
+  //    calling thread.
+  //
+  //    the chunks can also feed heap scans of other workers, e.g. of an exchange (see scan_next_heap_scan): after
+  //    start_pages, each scan takes its pages with get_next_page.
+  //
+  //  how to use:
+  //    parallel_heap_scan px_scan (hfid, class_oid);
+  //    if (px_scan.prepare (thread_ref) == NO_ERROR
+  //        && (degree = px_scan.get_degree (max_degree, page_threshold)) > 1)
+  //      {
+  //        error = px_scan.execute (thread_ref, degree, func);
+  //      }
+  //
+  class parallel_heap_scan
+  {
+    public:
+      // returns V_TRUE if object qualifies, V_FALSE/V_UNKNOWN if it doesn't and V_ERROR on error
+      using record_func = std::function<DB_LOGICAL (cubthread::entry &thread_ref, int worker_id, const OID &oid,
+			  RECDES &recdes)>;
+
+      parallel_heap_scan (const HFID &hfid, const OID &class_oid);
+      parallel_heap_scan (const parallel_heap_scan &) = delete;
+      parallel_heap_scan (parallel_heap_scan &&) = delete;
+
+      ~parallel_heap_scan ();
+
+      parallel_heap_scan &operator= (const parallel_heap_scan &) = delete;
+      parallel_heap_scan &operator= (parallel_heap_scan &&) = delete;
+
+      // take the snapshot and collect heap pages; must be called by the thread that owns the transaction
+      int prepare (cubthread::entry &thread_ref);
+
+      int get_page_count () const;
+      // cost based degree: one worker for each page_threshold pages, up to max_degree
+      int get_degree (int max_degree, int page_threshold) const;
+
+      int execute (cubthread::entry &thread_ref, int degree, const record_func &func);
+
+      // page source for degree scans; page and last_page are the cursor of the caller's scan, both 0 at start
+      void start_pages (int degree);
+      bool get_next_page (int &page, int &last_page, VPID &vpid);
+
+      // stats available after execute
+      const std::vector<SCAN_PX_WORKER_STATS> &get_worker_stats () const;
+      UINT64 get_read_rows () const;
+      UINT64 get_qualified_rows () const;
+
+    private:
+      bool get_next_chunk (int &first_page, int &last_page);
+      void set_error (int error_code);
+
+      void scan_pages (cubthread::entry &thread_ref, int worker_id);
+#if defined (SERVER_MODE)
+      void execute_worker_task (cubthread::entry &thread_ref, int worker_id);
+#endif // SERVER_MODE
+
+      HFID m_hfid;
+      OID m_class_oid;
+      MVCC_SNAPSHOT *m_mvcc_snapshot;
+      int m_tran_index;
+
+      VPID *m_vpids;		// user pages of heap file
+      int m_page_count;
+      int m_chunk_size;		// pages in a chunk
+
+      std::atomic<int> m_next_page;	// first page of next chunk
+      std::atomic<bool> m_stop;	// stop scanning, one of the workers had an error
+      int m_error;			// first error code
+
+      const record_func *m_func;
+
+      std::mutex m_mutex;
+      std::condition_variable m_workers_done;
+      int m_active_workers;
+
+      std::vector<SCAN_PX_WORKER_STATS> m_worker_stats;
+  };
+} // namespace cubquery
+
+#endif // _PARALLEL_HEAP_SCAN_HPP_
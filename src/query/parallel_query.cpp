@@ -0,0 +1,348 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// parallel_query - worker pool and exchanges for intra-query parallelism
+//
+
+#include "parallel_query.hpp"
+
+#include "error_manager.h"
+#include "log_impl.h"
+#include "system_parameter.h"
+#include "thread_entry.hpp"
+#if defined (SERVER_MODE)
+#include "thread_manager.hpp"
+#include "thread_worker_pool.hpp"
+#endif // SERVER_MODE
+
+#include <algorithm>
+#include <atomic>
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  /* batches a worker may have queued before it waits for the requester */
+  const std::size_t PX_EXCHANGE_QUEUED_BATCHES_PER_WORKER = 2;
+  /* size of the copy of the error of a worker; longer messages are truncated */
+  const int PX_EXCHANGE_ERROR_AREA_SIZE = 1024;
+
+#if defined (SERVER_MODE)
+  static std::mutex g_pool_mutex;
+  static cubthread::entry_workpool *g_worker_pool = NULL;
+  static bool g_pool_stopped = false;
+  static std::atomic<int> g_reserved_workers { 0 };
+
+  static cubthread::entry_workpool *
+  px_get_worker_pool ()
+  {
+    std::unique_lock<std::mutex> ulock (g_pool_mutex);
+
+    if (g_worker_pool == NULL && !g_pool_stopped)
+      {
+	int pool_size = prm_get_integer_value (PRM_ID_MAX_PARALLEL_WORKERS);
+
+	/* tasks are pushed only for reserved workers; the extra room covers tasks of finished exchanges that did not
+	 * exit yet */
+	g_worker_pool = cubthread::get_manager ()->create_worker_pool (pool_size, 2 * pool_size,
+			"parallel query workers", NULL, 1, false);
+	if (g_worker_pool == NULL)
+	  {
+	    /* no more thread entries; queries are executed serially */
+	    g_pool_stopped = true;
+	  }
+      }
+
+    return g_worker_pool;
+  }
+#endif // SERVER_MODE
+
+  int
+  px_reserve_workers (int count)
+  {
+#if defined (SERVER_MODE)
+    int max_workers = prm_get_integer_value (PRM_ID_MAX_PARALLEL_WORKERS);
+    int reserved, granted;
+
+    if (count <= 0 || max_workers <= 0)
+      {
+	return 0;
+      }
+
+    reserved = g_reserved_workers.load ();
+    do
+      {
+	granted = std::min (count, max_workers - reserved);
+	if (granted <= 0)
+	  {
+	    return 0;
+	  }
+      }
+    while (!g_reserved_workers.compare_exchange_weak (reserved, reserved + granted));
+
+    if (px_get_worker_pool () == NULL)
+      {
+	px_release_workers (granted);
+	return 0;
+      }
+
+    return granted;
+#else // !SERVER_MODE
+    return 0;
+#endif // !SERVER_MODE
+  }
+
+  void
+  px_release_workers (int count)
+  {
+#if defined (SERVER_MODE)
+    if (count > 0)
+      {
+	g_reserved_workers -= count;
+	assert (g_reserved_workers >= 0);
+      }
+#else // !SERVER_MODE
+    assert (count == 0);
+#endif // !SERVER_MODE
+  }
+
+#if defined (SERVER_MODE)
+  void
+  px_push_task (cubthread::entry_task *task)
+  {
+    /* the pool exists while workers are reserved */
+    assert (g_worker_pool != NULL);
+    cubthread::get_manager ()->push_task (g_worker_pool, task);
+  }
+#endif // SERVER_MODE
+
+  void
+  px_worker_pool_final ()
+  {
+#if defined (SERVER_MODE)
+    std::unique_lock<std::mutex> ulock (g_pool_mutex);
+
+    g_pool_stopped = true;
+    if (g_worker_pool != NULL)
+      {
+	cubthread::get_manager ()->destroy_worker_pool (g_worker_pool);
+	g_worker_pool = NULL;
+      }
+#endif // SERVER_MODE
+  }
+
+  px_exchange::px_exchange (cubthread::entry &thread_ref, int degree)
+    : m_tran_index (LOG_FIND_THREAD_TRAN_INDEX (&thread_ref))
+    , m_on_trace (thread_ref.on_trace)
+    , m_degree (degree)
+    , m_func ()
+    , m_mutex ()
+    , m_cond_produce ()
+    , m_cond_consume ()
+    , m_cond_finish ()
+    , m_batches ()
+    , m_producing_workers (0)
+    , m_active_workers (0)
+    , m_stop (false)
+    , m_finished (false)
+    , m_error (NO_ERROR)
+    , m_error_area ()
+  {
+  }
+
+  px_exchange::~px_exchange ()
+  {
+    assert (m_active_workers == 0);
+  }
+
+  int
+  px_exchange::get_degree () const
+  {
+    return m_degree;
+  }
+
+  void
+  px_exchange::start (const worker_func &func)
+  {
+    m_func = func;
+
+#if defined (SERVER_MODE)
+    int worker_id;
+
+    m_producing_workers = m_degree;
+    m_active_workers = m_degree;
+    for (worker_id = 0; worker_id < m_degree; worker_id++)
+      {
+	// *INDENT-OFF*
+	cubthread::entry_callable_task *task =
+	  new cubthread::entry_callable_task (std::bind (&px_exchange::execute_worker_task, this, std::placeholders::_1,
+							 worker_id));
+	// *INDENT-ON*
+	px_push_task (task);
+      }
+#else // !SERVER_MODE
+    /* workers are never reserved in stand-alone mode */
+    assert (m_degree == 0);
+#endif // !SERVER_MODE
+  }
+
+  bool
+  px_exchange::consume (std::vector<char> &batch)
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    m_cond_consume.wait (ulock, [this] { return m_stop || !m_batches.empty () || m_producing_workers == 0; });
+    if (m_stop || m_batches.empty ())
+      {
+	return false;
+      }
+
+    batch = std::move (m_batches.front ());
+    m_batches.pop_front ();
+    m_cond_produce.notify_one ();
+
+    return true;
+  }
+
+  void
+  px_exchange::finish ()
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    m_finished = true;
+    m_stop = true;
+    m_cond_produce.notify_all ();
+    m_cond_finish.notify_all ();
+
+    /* workers use this object until they exit */
+    m_cond_finish.wait (ulock, [this] { return m_active_workers == 0; });
+    m_batches.clear ();
+  }
+
+  int
+  px_exchange::get_error ()
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    if (m_error != NO_ERROR && er_errid () == NO_ERROR)
+      {
+	/* errors of workers are set in their own context; raise the copy of the first one here */
+	if (!m_error_area.empty ())
+	  {
+	    (void) er_set_area_error (m_error_area.data ());
+	  }
+	else if (m_error == ER_INTERRUPTED)
+	  {
+	    er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_INTERRUPTED, 0);
+	  }
+	else
+	  {
+	    er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_GENERIC_ERROR, 0);
+	  }
+      }
+    return m_error;
+  }
+
+  bool
+  px_exchange::produce (std::vector<char> &batch)
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    m_cond_produce.wait (ulock, [this]
+    {
+      return m_stop || m_batches.size () < (std::size_t) m_degree * PX_EXCHANGE_QUEUED_BATCHES_PER_WORKER;
+    });
+    if (m_stop)
+      {
+	return false;
+      }
+
+    m_batches.push_back (std::move (batch));
+    batch.clear ();
+    m_cond_consume.notify_one ();
+
+    return true;
+  }
+
+  void
+  px_exchange::end_production ()
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    assert (m_producing_workers > 0);
+    if (--m_producing_workers == 0)
+      {
+	m_cond_consume.notify_all ();
+      }
+
+    m_cond_finish.wait (ulock, [this] { return m_finished; });
+  }
+
+  void
+  px_exchange::set_error (int error_code)
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    if (m_error == NO_ERROR)
+      {
+	m_error = (error_code != NO_ERROR) ? error_code : ER_FAILED;
+	if (er_errid () != NO_ERROR)
+	  {
+	    /* keep the code, severity and message of the error for the requester */
+	    int length = PX_EXCHANGE_ERROR_AREA_SIZE;
+
+	    m_error_area.resize (length);
+	    (void) er_get_area_error (m_error_area.data (), &length);
+	    m_error_area.resize (length);
+	  }
+      }
+    m_stop = true;
+    m_cond_produce.notify_all ();
+    m_cond_consume.notify_all ();
+  }
+
+  bool
+  px_exchange::is_stopped ()
+  {
+    std::unique_lock<std::mutex> ulock (m_mutex);
+
+    return m_stop;
+  }
+
+#if defined (SERVER_MODE)
+  void
+  px_exchange::execute_worker_task (cubthread::entry &thread_ref, int worker_id)
+  {
+    thread_ref.tran_index = m_tran_index;
+    thread_ref.on_trace = m_on_trace;
+
+    m_func (thread_ref, worker_id);
+
+    thread_ref.on_trace = false;
+    thread_ref.tran_index = NULL_TRAN_INDEX;
+
+    /* this must be the last access to this object; requester may destroy it as soon as the mutex is released */
+    std::unique_lock<std::mutex> ulock (m_mutex);
+    if (--m_active_workers == 0)
+      {
+	m_cond_finish.notify_all ();
+      }
+  }
+#endif // SERVER_MODE
+} // namespace cubquery
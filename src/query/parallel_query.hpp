@@ -0,0 +1,146 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// parallel_query - worker pool and exchanges for intra-query parallelism
+//
+//  parts of a query that are executed in parallel run on the workers of a dedicated worker pool. the pool has
+//  max_parallel_workers threads, which is also the number of workers all queries may use at once: a query reserves
+//  its workers before starting them and gets fewer than it asked for, maybe none, when other queries use the pool.
+//
+//  the results of the workers are gathered by an exchange: workers produce batches of packed tuples and the thread
+//  that executes the query consumes them. workers that have to hand over more than tuples (e.g. partial aggregates)
+//  end their production and wait until the requester is done with their state.
+//
+
+#ifndef _PARALLEL_QUERY_HPP_
+#define _PARALLEL_QUERY_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#if defined (SERVER_MODE)
+#include "thread_entry_task.hpp"
+#endif // SERVER_MODE
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// forward definitions
+namespace cubthread
+{
+  class entry;
+}
+
+namespace cubquery
+{
+  // reserve up to count workers of the parallel query worker pool; returns the number of reserved workers, which is
+  // always 0 in stand-alone mode
+  int px_reserve_workers (int count);
+  void px_release_workers (int count);
+#if defined (SERVER_MODE)
+  // execute task on a reserved worker
+  void px_push_task (cubthread::entry_task *task);
+#endif // SERVER_MODE
+  // stop the worker pool on server shutdown
+  void px_worker_pool_final ();
+
+  //
+  // px_exchange
+  //
+  //  description:
+  //    gather exchange between degree workers, each one running worker_func, and the requester. the requester starts
+  //    the workers, consumes the batches until all workers end their production and then finishes the exchange, which
+  //    lets the workers clean up and waits for them.
+  //
+  //    a worker must call end_production exactly once, after its last batch and before freeing the state the
+  //    requester may still read; end_production returns once the requester finishes the exchange.
+  //
+  //    the first error of a worker stops the exchange: the other workers stop producing and the requester stops
+  //    consuming. get_error raises that error, with its code and message, in the context of the requester.
+  //
+  //  how to use:
+  //    degree = px_reserve_workers (requested);
+  //    px_exchange exchange (thread_ref, degree);
+  //    exchange.start (worker_func);
+  //    while (exchange.consume (batch))
+  //      {
+  //        // add tuples of batch to result
+  //      }
+  //    // read state of workers, if needed
+  //    exchange.finish ();
+  //    px_release_workers (degree);
+  //
+  class px_exchange
+  {
+    public:
+      using worker_func = std::function<void (cubthread::entry &thread_ref, int worker_id)>;
+
+      px_exchange (cubthread::entry &thread_ref, int degree);
+      px_exchange (const px_exchange &) = delete;
+      px_exchange (px_exchange &&) = delete;
+
+      ~px_exchange ();
+
+      px_exchange &operator= (const px_exchange &) = delete;
+      px_exchange &operator= (px_exchange &&) = delete;
+
+      int get_degree () const;
+
+      // requester side
+      void start (const worker_func &func);
+      bool consume (std::vector<char> &batch);
+      void finish ();
+      int get_error ();
+
+      // worker side
+      bool produce (std::vector<char> &batch);
+      void end_production ();
+      void set_error (int error_code);
+      bool is_stopped ();
+
+    private:
+#if defined (SERVER_MODE)
+      void execute_worker_task (cubthread::entry &thread_ref, int worker_id);
+#endif // SERVER_MODE
+
+      int m_tran_index;
+      bool m_on_trace;
+      int m_degree;
+      worker_func m_func;
+
+      std::mutex m_mutex;
+      std::condition_variable m_cond_produce;	// queue is not full, or exchange was stopped
+      std::condition_variable m_cond_consume;	// queue is not empty, or production ended
+      std::condition_variable m_cond_finish;	// exchange finished, or workers exited
+
+      std::deque<std::vector<char>> m_batches;
+      int m_producing_workers;
+      int m_active_workers;
+      bool m_stop;
+      bool m_finished;
+      int m_error;
+      std::vector<char> m_error_area;	// error of the first failed worker, flattened by er_get_area_error
+  };
+} // namespace cubquery
+
+#endif // _PARALLEL_QUERY_HPP_
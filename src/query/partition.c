@@ -159,6 +159,10 @@ static int partition_prune_heap_scan (PRUNING_CONTEXT * pinfo);
 
 static int partition_prune_index_scan (PRUNING_CONTEXT * pinfo);
 
+static int partition_match_join_keys (PRUNING_CONTEXT * pinfo, PRUNING_BITSET * pruned);
+static bool partition_is_key_attribute (PRUNING_CONTEXT * pinfo, ATTR_ID attr_id, DB_TYPE type);
+static bool partition_have_same_values (DB_SEQ * values_a, DB_SEQ * values_b);
+
 static int partition_find_inherited_btid (THREAD_ENTRY * thread_p, OID * src_class, OID * dest_class, BTID * src_btid,
 					  BTID * dest_btid);
 static int partition_attrinfo_get_key (THREAD_ENTRY * thread_p, PRUNING_CONTEXT * pcontext, DB_VALUE * curr_key,
@@ -912,6 +916,7 @@ pruningset_to_spec_list (PRUNING_CONTEXT * pinfo, const PRUNING_BITSET * pruned)
     {
       COPY_OID (&spec[i].oid, &pinfo->partitions[pos + 1].class_oid);
       HFID_COPY (&spec[i].hfid, &pinfo->partitions[pos + 1].class_hfid);
+      spec[i].position = pos;
 
       if (i == cnt - 1)
 	{
@@ -2702,6 +2707,84 @@ partition_get_position_in_key (PRUNING_CONTEXT * pinfo, BTID * btid)
   return NO_ERROR;
 }
 
+/*
+ * partition_match_join_keys () - keep the partitions holding the join keys of the spec
+ * return : error code or NO_ERROR
+ * pinfo (in)	   : pruning context
+ * pruned (in/out) : partitions left by the predicates of the spec
+ *
+ * Note: the keys are values of the partition key, of its type (see partition_is_partition_key). They are matched one
+ *	 by one, or with their range if they were too many. Keys out of every partition leave no partition to scan.
+ */
+static int
+partition_match_join_keys (PRUNING_CONTEXT * pinfo, PRUNING_BITSET * pruned)
+{
+  PARTITION_JOIN_KEYS *keys = pinfo->spec->join_keys;
+  REGU_VARIABLE *func_regu = pinfo->partition_pred->func_regu;
+  PRUNING_BITSET matched, upper;
+  MATCH_STATUS status;
+  int i;
+
+  if (keys == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  keys->partitions = pruningset_popcount (pruned);
+  keys->scanned = keys->partitions;
+
+  if (func_regu->type != TYPE_ATTR_ID || pinfo->attr_id != keys->attr_id || func_regu->domain == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  for (i = 0; i < keys->count; i++)
+    {
+      if (DB_VALUE_DOMAIN_TYPE (&keys->values[i]) != TP_DOMAIN_TYPE (func_regu->domain))
+	{
+	  return NO_ERROR;
+	}
+    }
+
+  pruningset_init (&matched, PARTITIONS_COUNT (pinfo));
+
+  if (keys->is_range)
+    {
+      if (pinfo->partition_type != DB_PARTITION_RANGE || keys->count != 2)
+	{
+	  /* only ranges of partitions are pruned with a range of keys */
+	  return NO_ERROR;
+	}
+
+      pruningset_init (&upper, PARTITIONS_COUNT (pinfo));
+      (void) partition_prune_db_val (pinfo, &keys->values[0], PO_GE, &matched);
+      (void) partition_prune_db_val (pinfo, &keys->values[1], PO_LE, &upper);
+      pruningset_intersect (&matched, &upper);
+    }
+  else
+    {
+      for (i = 0; i < keys->count; i++)
+	{
+	  /* a key out of every partition matches no partition */
+	  status = partition_prune_db_val (pinfo, &keys->values[i], PO_EQ, &matched);
+	  if (status == MATCH_NOT_FOUND && pinfo->partition_type == DB_PARTITION_HASH)
+	    {
+	      return NO_ERROR;
+	    }
+	}
+    }
+
+  if (pinfo->error_code != NO_ERROR)
+    {
+      return pinfo->error_code;
+    }
+
+  pruningset_intersect (pruned, &matched);
+  keys->scanned = pruningset_popcount (pruned);
+
+  return NO_ERROR;
+}
+
 /*
  * partition_prune_heap_scan () - prune a access spec for heap scan
  * return : error code or NO_ERROR
@@ -2733,23 +2816,23 @@ partition_prune_heap_scan (PRUNING_CONTEXT * pinfo)
 	}
     }
 
-  if (status != MATCH_NOT_FOUND)
-    {
-      error = pruningset_to_spec_list (pinfo, &pruned);
-      if (error != NO_ERROR)
-	{
-	  ASSERT_ERROR ();
-	}
-    }
-  else
+  if (status == MATCH_NOT_FOUND)
     {
       /* consider all partitions */
       pruningset_set_all (&pruned);
-      error = pruningset_to_spec_list (pinfo, &pruned);
-      if (error != NO_ERROR)
-	{
-	  ASSERT_ERROR ();
-	}
+    }
+
+  error = partition_match_join_keys (pinfo, &pruned);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error;
+    }
+
+  error = pruningset_to_spec_list (pinfo, &pruned);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
     }
 
   return error;
@@ -2814,20 +2897,20 @@ partition_prune_index_scan (PRUNING_CONTEXT * pinfo)
       else
 	{
 	  pruningset_set_all (&pruned);
-	  error = pruningset_to_spec_list (pinfo, &pruned);
-	  if (error != NO_ERROR)
-	    {
-	      ASSERT_ERROR ();
-	    }
 	}
     }
-  else
+
+  error = partition_match_join_keys (pinfo, &pruned);
+  if (error != NO_ERROR)
     {
-      error = pruningset_to_spec_list (pinfo, &pruned);
-      if (error != NO_ERROR)
-	{
-	  ASSERT_ERROR ();
-	}
+      ASSERT_ERROR ();
+      return error;
+    }
+
+  error = pruningset_to_spec_list (pinfo, &pruned);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
     }
 
   return error;
@@ -2942,6 +3025,188 @@ partition_prune_spec (THREAD_ENTRY * thread_p, val_descr * vd, access_spec_node
   return error;
 }
 
+/*
+ * partition_is_partition_key () - check whether an attribute is the partition key of a class
+ * return : error code or NO_ERROR
+ * thread_p (in)    :
+ * class_oid (in)   : partitioned class
+ * attr_id (in)	    : attribute
+ * type (in)	    : type of the values matched against the attribute
+ * is_key (out)	    : true if the class is partitioned on the attribute itself, and the values have its type
+ *
+ * Note: values of the partition key can prune the partitions of a scan with PARTITION_JOIN_KEYS.
+ */
+int
+partition_is_partition_key (THREAD_ENTRY * thread_p, const OID * class_oid, ATTR_ID attr_id, DB_TYPE type,
+			    bool * is_key)
+{
+  PRUNING_CONTEXT pinfo;
+  int error = NO_ERROR;
+
+  *is_key = false;
+
+  (void) partition_init_pruning_context (&pinfo);
+
+  error = partition_load_pruning_context (thread_p, class_oid, DB_PARTITIONED_CLASS, &pinfo);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error;
+    }
+
+  if (pinfo.partitions != NULL)
+    {
+      *is_key = partition_is_key_attribute (&pinfo, attr_id, type);
+    }
+
+  partition_clear_pruning_context (&pinfo);
+
+  return NO_ERROR;
+}
+
+/*
+ * partition_is_same_partitioning () - check whether two classes are partitioned the same way
+ * return : error code or NO_ERROR
+ * thread_p (in)      :
+ * class_oid_a (in)   : partitioned class
+ * attr_id_a (in)     : attribute of class a
+ * class_oid_b (in)   : partitioned class
+ * attr_id_b (in)     : attribute of class b
+ * type (in)	      : type of the values matched against the attributes
+ * is_same (out)      : true if the rows of the two classes with equal values of the attributes are in the partitions
+ *			at the same position
+ *
+ * Note: both classes must be partitioned on the attributes themselves (see partition_is_partition_key), with the same
+ *	 type and number of partitions. Range and list partitions must also have the same bounds and values, in the
+ *	 same order; hash partitions of equal values are found by the same hash function.
+ */
+int
+partition_is_same_partitioning (THREAD_ENTRY * thread_p, const OID * class_oid_a, ATTR_ID attr_id_a,
+				const OID * class_oid_b, ATTR_ID attr_id_b, DB_TYPE type, bool * is_same)
+{
+  PRUNING_CONTEXT pinfo_a, pinfo_b;
+  int error = NO_ERROR;
+  int i;
+
+  *is_same = false;
+
+  (void) partition_init_pruning_context (&pinfo_a);
+  (void) partition_init_pruning_context (&pinfo_b);
+
+  error = partition_load_pruning_context (thread_p, class_oid_a, DB_PARTITIONED_CLASS, &pinfo_a);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto cleanup;
+    }
+
+  error = partition_load_pruning_context (thread_p, class_oid_b, DB_PARTITIONED_CLASS, &pinfo_b);
+  if (error != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      goto cleanup;
+    }
+
+  if (pinfo_a.partitions == NULL || pinfo_b.partitions == NULL
+      || !partition_is_key_attribute (&pinfo_a, attr_id_a, type)
+      || !partition_is_key_attribute (&pinfo_b, attr_id_b, type))
+    {
+      goto cleanup;
+    }
+
+  if (pinfo_a.partition_type != pinfo_b.partition_type || pinfo_a.count != pinfo_b.count)
+    {
+      goto cleanup;
+    }
+
+  if (pinfo_a.partition_type != DB_PARTITION_HASH)
+    {
+      for (i = 1; i < pinfo_a.count; i++)
+	{
+	  if (!partition_have_same_values (pinfo_a.partitions[i].values, pinfo_b.partitions[i].values))
+	    {
+	      goto cleanup;
+	    }
+	}
+    }
+
+  *is_same = true;
+
+cleanup:
+  partition_clear_pruning_context (&pinfo_a);
+  partition_clear_pruning_context (&pinfo_b);
+
+  return error;
+}
+
+/*
+ * partition_is_key_attribute () - check whether a class is partitioned on an attribute itself
+ * return : true if the partition key is the attribute and has the type
+ * pinfo (in)	    : pruning context of the class, with its partitions loaded
+ * attr_id (in)	    : attribute
+ * type (in)	    : type
+ */
+static bool
+partition_is_key_attribute (PRUNING_CONTEXT * pinfo, ATTR_ID attr_id, DB_TYPE type)
+{
+  REGU_VARIABLE *func_regu = pinfo->partition_pred->func_regu;
+
+  return (func_regu->type == TYPE_ATTR_ID && pinfo->attr_id == attr_id && func_regu->domain != NULL
+	  && TP_DOMAIN_TYPE (func_regu->domain) == type);
+}
+
+/*
+ * partition_have_same_values () - check whether two range or list partitions are defined by the same values
+ * return : true if the values are equal, in the same order
+ * values_a (in)    : bounds of a range partition, or values of a list partition
+ * values_b (in)    : same, of the other partition
+ *
+ * Note: NULL bounds of range partitions stand for MINVALUE and MAXVALUE and are equal.
+ */
+static bool
+partition_have_same_values (DB_SEQ * values_a, DB_SEQ * values_b)
+{
+  DB_VALUE value_a, value_b;
+  bool is_same = true;
+  int size, i;
+
+  if (values_a == NULL || values_b == NULL)
+    {
+      return false;
+    }
+
+  size = db_set_size (values_a);
+  if (size < 0 || size != db_set_size (values_b))
+    {
+      return false;
+    }
+
+  db_make_null (&value_a);
+  db_make_null (&value_b);
+
+  for (i = 0; i < size && is_same; i++)
+    {
+      if (db_set_get (values_a, i, &value_a) != NO_ERROR || db_set_get (values_b, i, &value_b) != NO_ERROR)
+	{
+	  er_clear ();
+	  is_same = false;
+	}
+      else if (DB_IS_NULL (&value_a) || DB_IS_NULL (&value_b))
+	{
+	  is_same = (DB_IS_NULL (&value_a) && DB_IS_NULL (&value_b));
+	}
+      else
+	{
+	  is_same = (tp_value_compare (&value_a, &value_b, 1, 1) == DB_EQ);
+	}
+
+      pr_clear_value (&value_a);
+      pr_clear_value (&value_b);
+    }
+
+  return is_same;
+}
+
 /*
  * partition_find_partition_for_record () - find the partition in which a
  *					    record should be placed
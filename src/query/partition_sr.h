@@ -111,6 +111,12 @@ extern PRUNING_SCAN_CACHE *partition_new_scancache (PRUNING_CONTEXT * pcontext);
 
 extern int partition_prune_spec (THREAD_ENTRY * thread_p, val_descr * vd, access_spec_node * access_spec);
 
+extern int partition_is_partition_key (THREAD_ENTRY * thread_p, const OID * class_oid, ATTR_ID attr_id, DB_TYPE type,
+				       bool * is_key);
+
+extern int partition_is_same_partitioning (THREAD_ENTRY * thread_p, const OID * class_oid_a, ATTR_ID attr_id_a,
+					   const OID * class_oid_b, ATTR_ID attr_id_b, DB_TYPE type, bool * is_same);
+
 extern int partition_prune_insert (THREAD_ENTRY * thread_p, const OID * class_oid, RECDES * recdes,
 				   HEAP_SCANCACHE * scan_cache, PRUNING_CONTEXT * pcontext, int op_type,
 				   OID * pruned_class_oid, HFID * pruned_hfid, OID * superclass_oid);
@@ -0,0 +1,461 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_adaptive_join - inner index scan of a nested loop join that can switch to a hash table
+//
+
+#include "query_adaptive_join.hpp"
+
+#include "dbtype.h"
+#include "error_manager.h"
+#include "fetch.h"
+#include "heap_file.h"
+#include "memory_alloc.h"
+#include "memory_hash.h"
+#include "object_domain.h"
+#include "object_primitive.h"
+#include "regu_var.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  /* fewer outer rows than this are never worth a hash table */
+  const std::uint64_t ADAPTIVE_JOIN_MIN_PROBES = 1000;
+
+  /* memory used by a record of the hash table, besides the record itself */
+  const std::size_t ADAPTIVE_JOIN_ENTRY_OVERHEAD = 64;
+
+  adaptive_join::adaptive_join (regu_variable_node *key, int expected_rows, double error_ratio)
+    : m_state (STATE_NESTED_LOOP)
+    , m_reason ("outer rows within the estimate")
+    , m_expected_rows (std::max (expected_rows, 1))
+    , m_probes (0)
+    , m_next_decision (0)
+    , m_switch_probes (0)
+    , m_key_operands ()
+    , m_num_keys (0)
+    , m_attr_info ()
+    , m_attr_info_inited (false)
+    , m_record_keys ()
+    , m_domains ()
+    , m_records ()
+    , m_entries ()
+    , m_table ()
+    , m_probe_values ()
+    , m_probe_keys ()
+    , m_probe_args ()
+    , m_next_candidate ()
+    , m_end_candidate ()
+  {
+    double rows = (double) m_expected_rows * error_ratio;
+
+    assert (error_ratio > 0);
+
+    m_next_decision = (rows < (double) UINT64_MAX) ? (std::uint64_t) rows : UINT64_MAX;
+    m_next_decision = std::max (m_next_decision, ADAPTIVE_JOIN_MIN_PROBES);
+    m_next_candidate = m_end_candidate = m_table.cend ();
+
+    if (key == NULL)
+      {
+	/* the scan can't switch */
+      }
+    else if (key->type == TYPE_FUNC && key->value.funcp->ftype == F_MIDXKEY)
+      {
+	for (regu_variable_list_node *operand = key->value.funcp->operand; operand != NULL; operand = operand->next)
+	  {
+	    m_key_operands.push_back (&operand->value);
+	  }
+      }
+    else
+      {
+	m_key_operands.push_back (key);
+      }
+    m_num_keys = (int) m_key_operands.size ();
+    m_probe_args.resize (m_num_keys);
+  }
+
+  adaptive_join::~adaptive_join ()
+  {
+    assert (!m_attr_info_inited);
+
+    for (DB_VALUE &value : m_probe_values)
+      {
+	pr_clear_value (&value);
+      }
+  }
+
+  bool
+  adaptive_join::add_probe ()
+  {
+    m_probes++;
+    return m_state == STATE_NESTED_LOOP && m_probes >= m_next_decision;
+  }
+
+  void
+  adaptive_join::keep_nested_loop (const char *reason)
+  {
+    assert (m_state == STATE_NESTED_LOOP);
+
+    m_state = STATE_KEPT;
+    m_reason = reason;
+  }
+
+  void
+  adaptive_join::defer (const char *reason)
+  {
+    assert (m_state == STATE_NESTED_LOOP);
+
+    m_reason = reason;
+    m_next_decision = m_probes * 2;
+  }
+
+  int
+  adaptive_join::build (cubthread::entry *thread_p, const HFID &hfid, const OID &class_oid, mvcc_snapshot *snapshot,
+			const ATTR_ID *key_attr_ids, std::uint64_t max_size)
+  {
+    HEAP_SCANCACHE scan_cache;
+    RECDES recdes = RECDES_INITIALIZER;
+    OID cls_oid = class_oid;
+    OID oid;
+    SCAN_CODE scan_code;
+    int npages, nobjs, avg_length;
+    std::uint64_t size;
+    bool has_null;
+    bool is_too_large = false;
+    int error = NO_ERROR;
+
+    assert (m_state == STATE_NESTED_LOOP);
+    assert (m_num_keys > 0);
+
+    if (heap_estimate (thread_p, &hfid, &npages, &nobjs, &avg_length) < 0)
+      {
+	ASSERT_ERROR_AND_SET (error);
+	return error;
+      }
+
+    if ((std::uint64_t) npages > m_probes)
+      {
+	/* reading the whole heap still costs more than the probes */
+	defer ("inner heap larger than the outer rows");
+	return NO_ERROR;
+      }
+
+    if ((std::uint64_t) nobjs * (avg_length + ADAPTIVE_JOIN_ENTRY_OVERHEAD) > max_size)
+      {
+	keep_nested_loop ("inner too large for memory");
+	return NO_ERROR;
+      }
+
+    error = heap_attrinfo_start (thread_p, &class_oid, m_num_keys, key_attr_ids, &m_attr_info);
+    if (error != NO_ERROR)
+      {
+	return error;
+      }
+    m_attr_info_inited = true;
+
+    m_record_keys.resize (m_num_keys);
+    m_domains.resize (m_num_keys, NULL);
+    for (int i = 0; i < m_num_keys; i++)
+      {
+	m_record_keys[i] = heap_attrinfo_access (key_attr_ids[i], &m_attr_info);
+	for (int j = 0; j < m_attr_info.num_values; j++)
+	  {
+	    if (m_attr_info.values[j].attrid == key_attr_ids[i])
+	      {
+		m_domains[i] = m_attr_info.values[j].last_attrepr->domain;
+		break;
+	      }
+	  }
+	if (m_record_keys[i] == NULL || m_domains[i] == NULL)
+	  {
+	    assert (false);
+	    keep_nested_loop ("unknown key column");
+	    clear (thread_p);
+	    return NO_ERROR;
+	  }
+      }
+
+    error = heap_scancache_start (thread_p, &scan_cache, &hfid, &cls_oid, true, snapshot);
+    if (error != NO_ERROR)
+      {
+	clear (thread_p);
+	return error;
+      }
+
+    size = 0;
+    OID_SET_NULL (&oid);
+    while ((scan_code = heap_next (thread_p, &hfid, &cls_oid, &oid, &recdes, &scan_cache, PEEK)) == S_SUCCESS)
+      {
+	error = read_key_values (thread_p, oid, recdes, has_null);
+	if (error != NO_ERROR)
+	  {
+	    break;
+	  }
+	if (has_null)
+	  {
+	    /* never equal to a key */
+	    continue;
+	  }
+
+	size += recdes.length + ADAPTIVE_JOIN_ENTRY_OVERHEAD;
+	if (size > max_size)
+	  {
+	    is_too_large = true;
+	    break;
+	  }
+
+	/* records are read in place, keep them aligned */
+	m_records.resize (DB_ALIGN (m_records.size (), MAX_ALIGNMENT));
+	m_entries.push_back ({ oid, m_records.size (), recdes.length });
+	m_records.insert (m_records.end (), recdes.data, recdes.data + recdes.length);
+	m_table.emplace (hash_key_values (m_record_keys.data ()), (int) m_entries.size () - 1);
+      }
+    if (error == NO_ERROR && scan_code == S_ERROR)
+      {
+	ASSERT_ERROR_AND_SET (error);
+      }
+
+    heap_scancache_end (thread_p, &scan_cache);
+
+    if (error != NO_ERROR)
+      {
+	clear (thread_p);
+	return error;
+      }
+
+    if (is_too_large)
+      {
+	keep_nested_loop ("inner too large for memory");
+	clear (thread_p);
+	return NO_ERROR;
+      }
+
+    m_probe_values.resize (m_num_keys);
+    m_probe_keys.resize (m_num_keys);
+    for (int i = 0; i < m_num_keys; i++)
+      {
+	db_make_null (&m_probe_values[i]);
+	m_probe_keys[i] = &m_probe_values[i];
+      }
+    m_next_candidate = m_end_candidate = m_table.cend ();
+
+    m_state = STATE_HASH;
+    m_reason = "outer rows exceeded the estimate";
+    m_switch_probes = m_probes;
+
+    return NO_ERROR;
+  }
+
+  void
+  adaptive_join::clear (cubthread::entry *thread_p)
+  {
+    if (m_attr_info_inited)
+      {
+	heap_attrinfo_end (thread_p, &m_attr_info);
+	m_attr_info_inited = false;
+      }
+
+    m_record_keys.clear ();
+    m_domains.clear ();
+    std::vector<char> ().swap (m_records);
+    std::vector<entry> ().swap (m_entries);
+    m_table.clear ();
+    m_next_candidate = m_end_candidate = m_table.cend ();
+
+    if (m_state == STATE_HASH)
+      {
+	/* the scan goes on with the index */
+	m_state = STATE_KEPT;
+      }
+  }
+
+  int
+  adaptive_join::start_probe (cubthread::entry *thread_p, val_descr *vd)
+  {
+    DB_VALUE **key_values = m_probe_args.data ();
+    int error;
+
+    assert (m_state == STATE_HASH);
+
+    m_next_candidate = m_end_candidate = m_table.cend ();
+
+    for (int i = 0; i < m_num_keys; i++)
+      {
+	pr_clear_value (&m_probe_values[i]);
+      }
+
+    for (int i = 0; i < m_num_keys; i++)
+      {
+	error = fetch_peek_dbval (thread_p, m_key_operands[i], vd, NULL, NULL, NULL, &key_values[i]);
+	if (error != NO_ERROR)
+	  {
+	    return error;
+	  }
+	if (DB_IS_NULL (key_values[i]))
+	  {
+	    /* no match */
+	    return NO_ERROR;
+	  }
+
+	/* hash the key in the domain of the column; a key that changes when coerced can't be equal to a value of the
+	 * column */
+	if (tp_value_coerce (key_values[i], &m_probe_values[i], m_domains[i]) != DOMAIN_COMPATIBLE
+	    || tp_value_compare (key_values[i], &m_probe_values[i], 1, 0) != DB_EQ)
+	  {
+	    er_clear ();
+	    return NO_ERROR;
+	  }
+      }
+
+    auto range = m_table.equal_range (hash_key_values (m_probe_keys.data ()));
+    m_next_candidate = range.first;
+    m_end_candidate = range.second;
+
+    return NO_ERROR;
+  }
+
+  SCAN_CODE
+  adaptive_join::next_match (cubthread::entry *thread_p, OID *&oid, RECDES &recdes)
+  {
+    bool has_null;
+
+    while (m_next_candidate != m_end_candidate)
+      {
+	int index = m_next_candidate->second;
+	bool is_equal = true;
+
+	++m_next_candidate;
+
+	oid = &m_entries[index].oid;
+	recdes = get_record (index);
+	if (read_key_values (thread_p, *oid, recdes, has_null) != NO_ERROR)
+	  {
+	    return S_ERROR;
+	  }
+
+	for (int i = 0; i < m_num_keys && is_equal; i++)
+	  {
+	    is_equal = tp_value_compare (m_probe_keys[i], m_record_keys[i], 1, 0) == DB_EQ;
+	  }
+	if (is_equal)
+	  {
+	    return S_SUCCESS;
+	  }
+      }
+
+    return S_END;
+  }
+
+  RECDES
+  adaptive_join::get_record (int index)
+  {
+    RECDES recdes;
+
+    recdes.area_size = recdes.length = m_entries[index].length;
+    recdes.type = REC_HOME;
+    recdes.data = m_records.data () + m_entries[index].offset;
+
+    return recdes;
+  }
+
+  int
+  adaptive_join::read_key_values (cubthread::entry *thread_p, const OID &oid, RECDES &recdes, bool &has_null)
+  {
+    int error;
+
+    error = heap_attrinfo_read_dbvalues (thread_p, &oid, &recdes, &m_attr_info);
+    if (error != NO_ERROR)
+      {
+	return error;
+      }
+
+    has_null = std::any_of (m_record_keys.begin (), m_record_keys.end (), [] (const DB_VALUE *value)
+    {
+      return DB_IS_NULL (value);
+    });
+
+    return NO_ERROR;
+  }
+
+  /* same as the hash of the keys of hash list scans (see qdata_hash_scan_key ()) */
+  unsigned int
+  adaptive_join::hash_key_values (const DB_VALUE *const *values) const
+  {
+    unsigned int hash_val = 0, tmp_hash_val;
+
+    for (int i = 0; i < m_num_keys; i++)
+      {
+	hash_val = ROTL32 (hash_val, 13);
+	tmp_hash_val = mht_get_hash_number (UINT_MAX, values[i]);
+	hash_val ^= tmp_hash_val;
+	if (hash_val == 0)
+	  {
+	    hash_val = tmp_hash_val;
+	  }
+      }
+
+    return hash_val;
+  }
+
+  int
+  adaptive_join::get_key_count () const
+  {
+    return m_num_keys;
+  }
+
+  bool
+  adaptive_join::is_hashed () const
+  {
+    return m_state == STATE_HASH;
+  }
+
+  bool
+  adaptive_join::is_decided () const
+  {
+    return m_state != STATE_NESTED_LOOP;
+  }
+
+  const char *
+  adaptive_join::get_reason () const
+  {
+    return m_reason;
+  }
+
+  std::uint64_t
+  adaptive_join::get_probes () const
+  {
+    return m_probes;
+  }
+
+  std::uint64_t
+  adaptive_join::get_switch_probes () const
+  {
+    return m_switch_probes;
+  }
+
+  std::uint64_t
+  adaptive_join::get_expected_rows () const
+  {
+    return m_expected_rows;
+  }
+} // namespace cubquery
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_adaptive_join - inner index scan of a nested loop join that can switch to a hash table
+//
+//  the optimizer chooses an index nested loop join when it expects few outer rows. when the outer side produces far
+//  more rows than expected, each of them still descends the index and fetches the heap pages of its matches, and the
+//  join may take orders of magnitude longer than a hash join would.
+//
+//  the inner index scan of such a join counts the outer rows probing it. when their number exceeds the estimate of the
+//  optimizer by adaptive_join_error_ratio times, the scan reads the heap of the inner class once, keeps the visible
+//  records in memory and hashes them on the columns of the index key. the next outer rows look up the hash table
+//  instead of the index; the rows already joined are not joined again. the records of the hash table are filtered
+//  by the key filter and the data filter of the scan, like the records read through the index, so the results of the
+//  join are the same either way.
+//
+//  the scan keeps probing the index if the inner class has more heap pages than outer rows seen so far (the decision
+//  is taken again when their number doubles), or if its records don't fit in max_hash_list_scan_size.
+//
+
+#ifndef _QUERY_ADAPTIVE_JOIN_HPP_
+#define _QUERY_ADAPTIVE_JOIN_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "dbtype_def.h"
+#include "heap_attrinfo.h"
+#include "storage_common.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// forward definitions
+class regu_variable_node;
+struct mvcc_snapshot;
+struct tp_domain;
+struct val_descr;
+
+namespace cubthread
+{
+  class entry;
+}
+
+namespace cubquery
+{
+  //
+  // adaptive_join
+  //
+  //  description:
+  //    the decision of an inner index scan between probing the index and probing a hash table, and the hash table.
+  //
+  //  how to use:
+  //    adaptive_join *join = new adaptive_join (key, expected_rows, error_ratio);
+  //
+  //    // for each outer row
+  //    if (join->add_probe ())
+  //      {
+  //        // time to decide
+  //        join->build (thread_p, hfid, class_oid, snapshot, key_attr_ids, max_size);
+  //      }
+  //    if (join->is_hashed ())
+  //      {
+  //        join->start_probe (thread_p, vd);
+  //        while (join->next_match (thread_p, oid_p, recdes) == S_SUCCESS)
+  //          {
+  //            // filter the record
+  //          }
+  //      }
+  //
+  //    join->clear (thread_p);
+  //    delete join;
+  //
+  class adaptive_join
+  {
+    public:
+      // key is the value of the index key looked up by the scan, or the F_MIDXKEY function of its first columns; NULL
+      // if the scan can't switch
+      adaptive_join (regu_variable_node *key, int expected_rows, double error_ratio);
+      adaptive_join (const adaptive_join &) = delete;
+      adaptive_join (adaptive_join &&) = delete;
+
+      ~adaptive_join ();
+
+      adaptive_join &operator= (const adaptive_join &) = delete;
+      adaptive_join &operator= (adaptive_join &&) = delete;
+
+      // count an outer row; true if the scan should decide whether to switch to the hash table
+      bool add_probe ();
+      // keep probing the index until the end of the scan
+      void keep_nested_loop (const char *reason);
+      // read the heap of the inner class into the hash table, unless it is too large. the number of outer rows may
+      // not justify it yet, then the decision is taken again later
+      int build (cubthread::entry *thread_p, const HFID &hfid, const OID &class_oid, mvcc_snapshot *snapshot,
+		 const ATTR_ID *key_attr_ids, std::uint64_t max_size);
+      // free the hash table and the attribute cache
+      void clear (cubthread::entry *thread_p);
+
+      // probe; the key is evaluated with the values of the outer row. oid points into the hash table
+      int start_probe (cubthread::entry *thread_p, val_descr *vd);
+      SCAN_CODE next_match (cubthread::entry *thread_p, OID *&oid, RECDES &recdes);
+
+      // # of columns of the index key looked up
+      int get_key_count () const;
+
+      bool is_hashed () const;
+      bool is_decided () const;
+      const char *get_reason () const;
+      std::uint64_t get_probes () const;
+      std::uint64_t get_switch_probes () const;
+      std::uint64_t get_expected_rows () const;
+
+    private:
+      enum state
+      {
+	STATE_NESTED_LOOP,	// probing the index, not decided
+	STATE_HASH,		// probing the hash table
+	STATE_KEPT		// probing the index until the end
+      };
+
+      // a record of the hash table
+      struct entry
+      {
+	OID oid;
+	std::size_t offset;	// in m_records
+	int length;
+      };
+
+      RECDES get_record (int index);
+      int read_key_values (cubthread::entry *thread_p, const OID &oid, RECDES &recdes, bool &has_null);
+      unsigned int hash_key_values (const DB_VALUE *const *values) const;
+      void defer (const char *reason);
+
+      state m_state;
+      const char *m_reason;
+      std::uint64_t m_expected_rows;
+      std::uint64_t m_probes;
+      std::uint64_t m_next_decision;	// # of probes at which to decide
+      std::uint64_t m_switch_probes;	// # of probes when switched
+
+      std::vector<regu_variable_node *> m_key_operands;	// values of the columns of the key
+      int m_num_keys;
+
+      // hash table
+      HEAP_CACHE_ATTRINFO m_attr_info;	// key columns of the records
+      bool m_attr_info_inited;
+      std::vector<DB_VALUE *> m_record_keys;	// values of the key columns, in m_attr_info
+      std::vector<tp_domain *> m_domains;	// of the key columns
+      std::vector<char> m_records;
+      std::vector<entry> m_entries;
+      std::unordered_multimap<unsigned int, int> m_table;	// hash of key to index in m_entries
+
+      // probe
+      std::vector<DB_VALUE> m_probe_values;	// coerced to m_domains
+      std::vector<DB_VALUE *> m_probe_keys;	// in m_probe_values
+      std::vector<DB_VALUE *> m_probe_args;	// values of m_key_operands
+      std::unordered_multimap<unsigned int, int>::const_iterator m_next_candidate;
+      std::unordered_multimap<unsigned int, int>::const_iterator m_end_candidate;
+  };
+} // namespace cubquery
+
+#endif // _QUERY_ADAPTIVE_JOIN_HPP_
@@ -99,6 +99,12 @@ namespace cubquery
     aggregate_hash_value *curr_part_value;	/* current partial value */
     aggregate_hash_value *temp_part_value;	/* temporary partial value */
     int sorted_count;
+
+    /* partition-wise aggregation, of a class partitioned on a group key */
+    bool is_partition_wise;	/* groups are complete when the scan moves to the next partition */
+    INT64 partition_part_count;	/* # of tuples of the partial list when the current partition started */
+    qfile_list_id *done_tuple_list_id;	/* first tuples of the groups complete */
+    qfile_list_id *done_part_list_id;	/* accumulators of the groups complete, in the same order */
   };
 
 
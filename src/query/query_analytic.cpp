@@ -137,58 +137,10 @@ qdata_evaluate_analytic_func (cubthread::entry *thread_p, ANALYTIC_TYPE *func_p,
       return ER_FAILED;
     }
 
-  if ((func_p->opr_dbtype == DB_TYPE_VARIABLE || TP_DOMAIN_COLLATION_FLAG (func_p->domain) != TP_DOMAIN_COLL_NORMAL)
-      && !DB_IS_NULL (&dbval))
+  error = qdata_bind_analytic_domain (func_p, &dbval);
+  if (error != NO_ERROR)
     {
-      /* set function default domain when late binding */
-      switch (func_p->function)
-	{
-	case PT_COUNT:
-	case PT_COUNT_STAR:
-	  func_p->domain = tp_domain_resolve_default (DB_TYPE_BIGINT);
-	  break;
-
-	case PT_AVG:
-	case PT_STDDEV:
-	case PT_STDDEV_POP:
-	case PT_STDDEV_SAMP:
-	case PT_VARIANCE:
-	case PT_VAR_POP:
-	case PT_VAR_SAMP:
-	  func_p->domain = tp_domain_resolve_default (DB_TYPE_DOUBLE);
-	  break;
-
-	case PT_SUM:
-	  if (TP_IS_NUMERIC_TYPE (DB_VALUE_TYPE (&dbval)))
-	    {
-	      func_p->domain = tp_domain_resolve_value (&dbval, NULL);
-	    }
-	  else
-	    {
-	      func_p->domain = tp_domain_resolve_default (DB_TYPE_DOUBLE);
-	    }
-	  break;
-
-	default:
-	  func_p->domain = tp_domain_resolve_value (&dbval, NULL);
-	  break;
-	}
-
-      if (func_p->domain == NULL)
-	{
-	  error = ER_FAILED;
-	  goto exit;
-	}
-
-      /* coerce operand */
-      if (tp_value_coerce (&dbval, &dbval, func_p->domain) != DOMAIN_COMPATIBLE)
-	{
-	  error = ER_FAILED;
-	  goto exit;
-	}
-
-      func_p->opr_dbtype = TP_DOMAIN_TYPE (func_p->domain);
-      db_value_domain_init (func_p->value, func_p->opr_dbtype, DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE);
+      goto exit;
     }
 
   if (DB_IS_NULL (&dbval) && func_p->function != PT_ROW_NUMBER && func_p->function != PT_FIRST_VALUE
@@ -746,6 +698,71 @@ exit:
   return error;
 }
 
+/*
+ * qdata_bind_analytic_domain () - set the domain of a late bound analytic function from its operand
+ *   return: NO_ERROR, or ER_code
+ *   func_p(in): Analytic expression node
+ *   dbval(in/out): Operand value; coerced to the domain of the function
+ *
+ */
+int
+qdata_bind_analytic_domain (ANALYTIC_TYPE *func_p, DB_VALUE *dbval)
+{
+  if ((func_p->opr_dbtype == DB_TYPE_VARIABLE || TP_DOMAIN_COLLATION_FLAG (func_p->domain) != TP_DOMAIN_COLL_NORMAL)
+      && !DB_IS_NULL (dbval))
+    {
+      /* set function default domain when late binding */
+      switch (func_p->function)
+	{
+	case PT_COUNT:
+	case PT_COUNT_STAR:
+	  func_p->domain = tp_domain_resolve_default (DB_TYPE_BIGINT);
+	  break;
+
+	case PT_AVG:
+	case PT_STDDEV:
+	case PT_STDDEV_POP:
+	case PT_STDDEV_SAMP:
+	case PT_VARIANCE:
+	case PT_VAR_POP:
+	case PT_VAR_SAMP:
+	  func_p->domain = tp_domain_resolve_default (DB_TYPE_DOUBLE);
+	  break;
+
+	case PT_SUM:
+	  if (TP_IS_NUMERIC_TYPE (DB_VALUE_TYPE (dbval)))
+	    {
+	      func_p->domain = tp_domain_resolve_value (dbval, NULL);
+	    }
+	  else
+	    {
+	      func_p->domain = tp_domain_resolve_default (DB_TYPE_DOUBLE);
+	    }
+	  break;
+
+	default:
+	  func_p->domain = tp_domain_resolve_value (dbval, NULL);
+	  break;
+	}
+
+      if (func_p->domain == NULL)
+	{
+	  return ER_FAILED;
+	}
+
+      /* coerce operand */
+      if (tp_value_coerce (dbval, dbval, func_p->domain) != DOMAIN_COMPATIBLE)
+	{
+	  return ER_FAILED;
+	}
+
+      func_p->opr_dbtype = TP_DOMAIN_TYPE (func_p->domain);
+      db_value_domain_init (func_p->value, func_p->opr_dbtype, DB_DEFAULT_PRECISION, DB_DEFAULT_SCALE);
+    }
+
+  return NO_ERROR;
+}
+
 /*
  * qdata_finalize_analytic_func () -
  *   return: NO_ERROR, or ER_code
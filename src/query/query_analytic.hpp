@@ -30,6 +30,7 @@
 #include "system.h"               // QUERY_ID
 
 // forward definitions
+struct db_value;
 struct val_descr;
 
 namespace cubthread
@@ -45,5 +46,6 @@ namespace cubxasl
 int qdata_initialize_analytic_func (cubthread::entry *thread_p, cubxasl::analytic_list_node *func_p, QUERY_ID query_id);
 int qdata_evaluate_analytic_func (cubthread::entry *thread_p, cubxasl::analytic_list_node *func_p, val_descr *vd);
 int qdata_finalize_analytic_func (cubthread::entry *thread_p, cubxasl::analytic_list_node *func_p, bool is_same_group);
+int qdata_bind_analytic_domain (cubxasl::analytic_list_node *func_p, db_value *dbval);
 
 #endif // _QUERY_ANALYTIC_HPP_
@@ -0,0 +1,602 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_analytic_frame - analytic functions computed over a ROWS window frame
+//
+
+#include "query_analytic_frame.hpp"
+
+#include "dbtype.h"
+#include "error_manager.h"
+#include "fetch.h"
+#include "object_domain.h"
+#include "object_primitive.h"
+#include "query_analytic.hpp"
+#include "query_opfunc.h"
+#include "xasl_analytic.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  // leaves of the smallest segment tree
+  static const std::int64_t TREE_MIN_CAPACITY = 16;
+
+  analytic_frame::analytic_frame (cubxasl::analytic_list_node &func)
+    : m_func (func)
+    , m_start (func.frame_start)
+    , m_end (func.frame_end)
+    , m_is_unbounded_preceding (func.frame_start == -ANALYTIC_FRAME_UNBOUNDED)
+    , m_is_unbounded_following (func.frame_end == ANALYTIC_FRAME_UNBOUNDED)
+    , m_value_domain (NULL)
+    , m_add_domain (NULL)
+    , m_is_exact_sum (false)
+    , m_use_tree (false)
+    , m_rows ()
+    , m_first_row (0)
+    , m_row_count (0)
+    , m_next_row (0)
+    , m_is_partition_ended (false)
+    , m_window_lo (0)
+    , m_window_hi (0)
+    , m_count (0)
+    , m_count_nn (0)
+    , m_accumulator ()
+    , m_approximate_sum (0)
+    , m_tree ()
+    , m_tree_capacity (0)
+  {
+    DB_TYPE type;
+
+    db_make_null (&m_accumulator);
+
+    switch (m_func.function)
+      {
+      case PT_SUM:
+	type = TP_DOMAIN_TYPE (m_func.domain);
+	if (type == DB_TYPE_SHORT || type == DB_TYPE_INTEGER || type == DB_TYPE_BIGINT || type == DB_TYPE_NUMERIC)
+	  {
+	    m_value_domain = m_func.domain;
+	    m_add_domain = (type == DB_TYPE_NUMERIC) ? NULL : m_func.domain;
+	    m_is_exact_sum = true;
+	  }
+	else
+	  {
+	    m_value_domain = &tp_Double_domain;
+	  }
+	break;
+
+      case PT_AVG:
+	/* the sum of an average is exact as long as the operands are */
+	type = m_func.opr_dbtype;
+	if (type == DB_TYPE_SHORT || type == DB_TYPE_INTEGER)
+	  {
+	    m_value_domain = &tp_Bigint_domain;
+	    m_is_exact_sum = true;
+	  }
+	else if (type == DB_TYPE_BIGINT)
+	  {
+	    m_value_domain = tp_domain_resolve (DB_TYPE_NUMERIC, NULL, DB_MAX_NUMERIC_PRECISION, 0, NULL, 0);
+	    m_is_exact_sum = true;
+	  }
+	else if (type == DB_TYPE_NUMERIC)
+	  {
+	    m_is_exact_sum = true;
+	  }
+	else
+	  {
+	    m_value_domain = &tp_Double_domain;
+	  }
+	break;
+
+      default:
+	break;
+      }
+
+    /* a row leaves the window by subtraction only from counters and exact sums */
+    m_use_tree = !m_is_unbounded_preceding && (m_func.function == PT_MIN || m_func.function == PT_MAX
+		 || ((m_func.function == PT_SUM || m_func.function == PT_AVG) && !m_is_exact_sum));
+  }
+
+  analytic_frame::~analytic_frame ()
+  {
+    clear_rows ();
+    pr_clear_value (&m_accumulator);
+  }
+
+  void
+  analytic_frame::start_partition ()
+  {
+    clear_rows ();
+    m_first_row = 0;
+    m_row_count = 0;
+    m_next_row = 0;
+    m_is_partition_ended = false;
+
+    reset_window (0);
+
+    /* leaves of the previous partition would be taken for rows of this one */
+    std::fill (m_tree.begin (), m_tree.end (), tree_node { -1, 0 });
+  }
+
+  int
+  analytic_frame::add_row (cubthread::entry *thread_p, val_descr *vd)
+  {
+    DB_VALUE dbval;
+    TP_DOMAIN_STATUS status;
+    int error;
+
+    db_make_null (&dbval);
+
+    if (m_func.function != PT_COUNT_STAR)
+      {
+	if (fetch_copy_dbval (thread_p, &m_func.operand, vd, NULL, NULL, NULL, &dbval) != NO_ERROR)
+	  {
+	    return ER_FAILED;
+	  }
+
+	error = qdata_bind_analytic_domain (&m_func, &dbval);
+	if (error != NO_ERROR)
+	  {
+	    pr_clear_value (&dbval);
+	    return error;
+	  }
+
+	if (m_value_domain != NULL && !DB_IS_NULL (&dbval))
+	  {
+	    status = tp_value_coerce (&dbval, &dbval, m_value_domain);
+	    if (status != DOMAIN_COMPATIBLE)
+	      {
+		error = tp_domain_status_er_set (status, ARG_FILE_LINE, &dbval, m_value_domain);
+		pr_clear_value (&dbval);
+		return error;
+	      }
+	  }
+      }
+
+    /* the row owns the copy */
+    m_rows.push_back (dbval);
+    m_row_count++;
+
+    return NO_ERROR;
+  }
+
+  void
+  analytic_frame::end_partition ()
+  {
+    m_is_partition_ended = true;
+  }
+
+  bool
+  analytic_frame::has_result () const
+  {
+    if (m_next_row >= m_row_count)
+      {
+	return false;
+      }
+    if (m_is_partition_ended)
+      {
+	return true;
+      }
+
+    return !m_is_unbounded_following && m_next_row + m_end < m_row_count;
+  }
+
+  int
+  analytic_frame::next_result (DB_VALUE *result)
+  {
+    std::int64_t lo, hi;
+    int error;
+
+    assert (has_result ());
+
+    /* frame of the next row, clipped to the partition; hi is past its last row */
+    lo = m_is_unbounded_preceding ? 0 : std::max<std::int64_t> (m_next_row + m_start, 0);
+    hi = m_is_unbounded_following ? m_row_count : std::min (m_next_row + m_end + 1, m_row_count);
+    lo = std::min (lo, m_row_count);
+    hi = std::max (hi, lo);
+
+    /* both bounds of the frame only move forward; rows leave the window before others enter it */
+    if (lo >= m_window_hi)
+      {
+	reset_window (lo);
+      }
+    while (m_window_lo < lo)
+      {
+	error = remove_from_window (m_window_lo++);
+	if (error != NO_ERROR)
+	  {
+	    return error;
+	  }
+      }
+    while (m_window_hi < hi)
+      {
+	error = add_to_window (m_window_hi++);
+	if (error != NO_ERROR)
+	  {
+	    return error;
+	  }
+      }
+
+    error = compute_result (result);
+    m_next_row++;
+
+    /* the next frames start at the window; a running aggregate no longer needs the rows it has added */
+    release_rows (m_is_unbounded_preceding ? m_window_hi : m_window_lo);
+
+    return error;
+  }
+
+  void
+  analytic_frame::clear_rows ()
+  {
+    for (DB_VALUE &value : m_rows)
+      {
+	pr_clear_value (&value);
+      }
+    m_rows.clear ();
+  }
+
+  void
+  analytic_frame::release_rows (std::int64_t first_needed)
+  {
+    while (m_first_row < first_needed && !m_rows.empty ())
+      {
+	pr_clear_value (&m_rows.front ());
+	m_rows.pop_front ();
+	m_first_row++;
+      }
+  }
+
+  DB_VALUE &
+  analytic_frame::row_value (std::int64_t row)
+  {
+    assert (row >= m_first_row && row < m_row_count);
+
+    return m_rows[row - m_first_row];
+  }
+
+  int
+  analytic_frame::add_to_window (std::int64_t row)
+  {
+    DB_VALUE &value = row_value (row);
+    int cmp;
+
+    m_count++;
+    if (m_use_tree)
+      {
+	tree_set (row);
+      }
+
+    if (DB_IS_NULL (&value))
+      {
+	return NO_ERROR;
+      }
+    m_count_nn++;
+
+    if (m_use_tree)
+      {
+	return NO_ERROR;
+      }
+
+    switch (m_func.function)
+      {
+      case PT_SUM:
+      case PT_AVG:
+	if (!m_is_exact_sum)
+	  {
+	    m_approximate_sum += db_get_double (&value);
+	  }
+	else if (m_count_nn == 1)
+	  {
+	    pr_clear_value (&m_accumulator);
+	    return pr_clone_value (&value, &m_accumulator);
+	  }
+	else
+	  {
+	    return qdata_add_dbval (&m_accumulator, &value, &m_accumulator, m_add_domain);
+	  }
+	break;
+
+      case PT_MIN:
+      case PT_MAX:
+	/* running MIN/MAX of a frame that starts at UNBOUNDED PRECEDING */
+	if (!DB_IS_NULL (&m_accumulator))
+	  {
+	    cmp = m_func.domain->type->cmpval (&m_accumulator, &value, 1, 1, NULL, m_func.domain->collation_id);
+	    if ((m_func.function == PT_MIN && cmp <= 0) || (m_func.function == PT_MAX && cmp >= 0))
+	      {
+		break;
+	      }
+	  }
+	pr_clear_value (&m_accumulator);
+	return pr_clone_value (&value, &m_accumulator);
+
+      default:
+	break;
+      }
+
+    return NO_ERROR;
+  }
+
+  int
+  analytic_frame::remove_from_window (std::int64_t row)
+  {
+    DB_VALUE &value = row_value (row);
+
+    assert (m_use_tree || (m_func.function != PT_MIN && m_func.function != PT_MAX));
+
+    m_count--;
+    if (DB_IS_NULL (&value))
+      {
+	return NO_ERROR;
+      }
+    m_count_nn--;
+
+    if (!m_is_exact_sum || m_use_tree)
+      {
+	/* only counted, or left in the segment tree */
+	return NO_ERROR;
+      }
+
+    if (m_count_nn == 0)
+      {
+	pr_clear_value (&m_accumulator);
+	db_make_null (&m_accumulator);
+	return NO_ERROR;
+      }
+
+    return qdata_subtract_dbval (&m_accumulator, &value, &m_accumulator, m_add_domain);
+  }
+
+  void
+  analytic_frame::reset_window (std::int64_t row)
+  {
+    m_window_lo = row;
+    m_window_hi = row;
+    m_count = 0;
+    m_count_nn = 0;
+    pr_clear_value (&m_accumulator);
+    db_make_null (&m_accumulator);
+    m_approximate_sum = 0;
+  }
+
+  int
+  analytic_frame::compute_result (DB_VALUE *result)
+  {
+    DB_VALUE sum, count, avg;
+    DB_VALUE *sum_p;
+    tree_node node;
+    TP_DOMAIN_STATUS status;
+    int error = NO_ERROR;
+
+    switch (m_func.function)
+      {
+      case PT_COUNT_STAR:
+	db_make_bigint (result, m_count);
+	return NO_ERROR;
+
+      case PT_COUNT:
+	db_make_bigint (result, m_count_nn);
+	return NO_ERROR;
+
+      case PT_MIN:
+      case PT_MAX:
+	if (!m_use_tree)
+	  {
+	    return pr_clone_value (&m_accumulator, result);
+	  }
+
+	node = tree_query (m_window_lo, m_window_hi);
+	if (node.row < 0)
+	  {
+	    db_make_null (result);
+	    return NO_ERROR;
+	  }
+	return pr_clone_value (&row_value (node.row), result);
+
+      case PT_SUM:
+      case PT_AVG:
+	break;
+
+      default:
+	assert (false);
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_XASLNODE, 0);
+	return ER_QPROC_INVALID_XASLNODE;
+      }
+
+    if (m_count_nn == 0)
+      {
+	db_make_null (result);
+	return NO_ERROR;
+      }
+
+    if (m_is_exact_sum)
+      {
+	sum_p = &m_accumulator;
+      }
+    else
+      {
+	db_make_double (&sum, m_use_tree ? tree_query (m_window_lo, m_window_hi).sum : m_approximate_sum);
+	sum_p = &sum;
+      }
+
+    if (m_func.function == PT_SUM)
+      {
+	status = tp_value_coerce (sum_p, result, m_func.domain);
+	if (status != DOMAIN_COMPATIBLE)
+	  {
+	    return tp_domain_status_er_set (status, ARG_FILE_LINE, sum_p, m_func.domain);
+	  }
+	return NO_ERROR;
+      }
+
+    /* AVG (X) = SUM (X) / COUNT (X) */
+    db_make_double (&count, (double) m_count_nn);
+    db_make_null (&avg);
+    error = qdata_divide_dbval (sum_p, &count, &avg, &tp_Double_domain);
+    if (error == NO_ERROR)
+      {
+	status = tp_value_coerce (&avg, result, &tp_Double_domain);
+	if (status != DOMAIN_COMPATIBLE)
+	  {
+	    error = tp_domain_status_er_set (status, ARG_FILE_LINE, &avg, &tp_Double_domain);
+	  }
+      }
+    pr_clear_value (&avg);
+
+    return error;
+  }
+
+  analytic_frame::tree_node
+  analytic_frame::make_leaf (std::int64_t row)
+  {
+    DB_VALUE &value = row_value (row);
+
+    if (DB_IS_NULL (&value))
+      {
+	return tree_node { -1, 0 };
+      }
+    else if (m_func.function == PT_MIN || m_func.function == PT_MAX)
+      {
+	return tree_node { row, 0 };
+      }
+    else
+      {
+	return tree_node { -1, db_get_double (&value) };
+      }
+  }
+
+  analytic_frame::tree_node
+  analytic_frame::combine (const tree_node &left, const tree_node &right)
+  {
+    int cmp;
+
+    if (m_func.function != PT_MIN && m_func.function != PT_MAX)
+      {
+	return tree_node { -1, left.sum + right.sum };
+      }
+
+    /* nodes out of the queried range may still hold rows that were released */
+    if (left.row < m_first_row)
+      {
+	return (right.row < m_first_row) ? tree_node { -1, 0 } : right;
+      }
+    else if (right.row < m_first_row)
+      {
+	return left;
+      }
+
+    cmp = m_func.domain->type->cmpval (&row_value (left.row), &row_value (right.row), 1, 1, NULL,
+				       m_func.domain->collation_id);
+    if (m_func.function == PT_MIN)
+      {
+	return (cmp <= 0) ? left : right;
+      }
+    else
+      {
+	return (cmp >= 0) ? left : right;
+      }
+  }
+
+  void
+  analytic_frame::tree_set (std::int64_t row)
+  {
+    std::int64_t capacity, slot, r;
+
+    /* the window, up to row, must fit in the leaves */
+    if (row - m_window_lo + 1 > m_tree_capacity)
+      {
+	capacity = std::max (m_tree_capacity, TREE_MIN_CAPACITY);
+	while (capacity < row - m_window_lo + 1)
+	  {
+	    capacity *= 2;
+	  }
+
+	m_tree_capacity = capacity;
+	m_tree.assign (2 * capacity, tree_node { -1, 0 });
+	for (r = m_window_lo; r < row; r++)
+	  {
+	    m_tree[capacity + r % capacity] = make_leaf (r);
+	  }
+	for (slot = capacity - 1; slot >= 1; slot--)
+	  {
+	    m_tree[slot] = combine (m_tree[2 * slot], m_tree[2 * slot + 1]);
+	  }
+      }
+
+    slot = m_tree_capacity + row % m_tree_capacity;
+    m_tree[slot] = make_leaf (row);
+    for (slot /= 2; slot >= 1; slot /= 2)
+      {
+	m_tree[slot] = combine (m_tree[2 * slot], m_tree[2 * slot + 1]);
+      }
+  }
+
+  analytic_frame::tree_node
+  analytic_frame::tree_query (std::int64_t lo, std::int64_t hi)
+  {
+    std::int64_t first_slot, last_slot;
+
+    if (hi <= lo)
+      {
+	return tree_node { -1, 0 };
+      }
+
+    assert (hi - lo <= m_tree_capacity);
+
+    /* the rows wrap around the leaves */
+    first_slot = lo % m_tree_capacity;
+    last_slot = (hi - 1) % m_tree_capacity;
+    if (first_slot <= last_slot)
+      {
+	return tree_query_slots (first_slot, last_slot);
+      }
+
+    return combine (tree_query_slots (first_slot, m_tree_capacity - 1), tree_query_slots (0, last_slot));
+  }
+
+  analytic_frame::tree_node
+  analytic_frame::tree_query_slots (std::int64_t first_slot, std::int64_t last_slot)
+  {
+    tree_node left = { -1, 0 };
+    tree_node right = { -1, 0 };
+    std::int64_t l = m_tree_capacity + first_slot;
+    std::int64_t r = m_tree_capacity + last_slot + 1;
+
+    while (l < r)
+      {
+	if (l & 1)
+	  {
+	    left = combine (left, m_tree[l++]);
+	  }
+	if (r & 1)
+	  {
+	    right = combine (m_tree[--r], right);
+	  }
+	l /= 2;
+	r /= 2;
+      }
+
+    return combine (left, right);
+  }
+} // namespace cubquery
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_analytic_frame - analytic functions computed over a ROWS window frame
+//
+//  an analytic function with a ROWS frame has a value of its own for each row of the partition: the aggregate of the
+//  rows from frame_start to frame_end, relative to that row. the rows are added one by one, in the order they come out
+//  of the sort, and the value of a row can be computed as soon as the last row of its frame is added. a partition is
+//  therefore computed in a single pass, keeping only the rows of the frames still to compute.
+//
+//  the window of rows slides along the partition: the rows entering it are added to the aggregate and the rows leaving
+//  it are removed. COUNT, and SUM and AVG over exact types, remove a row by subtracting it. MIN, MAX and approximate
+//  sums cannot, so the rows of the window are kept in a segment tree and the value of each row is a range query. a
+//  frame starting at UNBOUNDED PRECEDING never loses rows and only needs a running aggregate.
+//
+
+#ifndef _QUERY_ANALYTIC_FRAME_HPP_
+#define _QUERY_ANALYTIC_FRAME_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "dbtype_def.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// forward definitions
+struct tp_domain;
+struct val_descr;
+
+namespace cubthread
+{
+  class entry;
+}
+
+namespace cubxasl
+{
+  struct analytic_list_node;
+} // namespace cubxasl
+
+namespace cubquery
+{
+  //
+  // analytic_frame
+  //
+  //  description:
+  //    values of an analytic function with a ROWS frame (COUNT, SUM, AVG, MIN and MAX), one per row of a partition.
+  //
+  //  how to use:
+  //    analytic_frame frame (func);
+  //
+  //    frame.start_partition ();
+  //    for (each row of the partition)
+  //      {
+  //        frame.add_row (thread_p, vd);      // fetches the operand of the function
+  //        while (frame.has_result ())
+  //          {
+  //            frame.next_result (value);     // value of the next row, in row order
+  //          }
+  //      }
+  //    frame.end_partition ();
+  //    while (frame.has_result ())
+  //      {
+  //        frame.next_result (value);
+  //      }
+  //
+  class analytic_frame
+  {
+    public:
+      explicit analytic_frame (cubxasl::analytic_list_node &func);
+      analytic_frame (const analytic_frame &) = delete;
+      analytic_frame (analytic_frame &&) = delete;
+
+      ~analytic_frame ();
+
+      analytic_frame &operator= (const analytic_frame &) = delete;
+      analytic_frame &operator= (analytic_frame &&) = delete;
+
+      void start_partition ();
+      int add_row (cubthread::entry *thread_p, val_descr *vd);
+      void end_partition ();
+
+      // the frame of the next row without a value is complete
+      bool has_result () const;
+      // result is cleared by the caller
+      int next_result (DB_VALUE *result);
+
+    private:
+      // node of the segment tree: the row holding the MIN/MAX of its range, or the sum of its range
+      struct tree_node
+      {
+	std::int64_t row;	// -1 if none
+	double sum;
+      };
+
+      void clear_rows ();
+      void release_rows (std::int64_t first_needed);
+      DB_VALUE &row_value (std::int64_t row);
+
+      int add_to_window (std::int64_t row);
+      int remove_from_window (std::int64_t row);
+      void reset_window (std::int64_t row);
+      int compute_result (DB_VALUE *result);
+
+      tree_node make_leaf (std::int64_t row);
+      tree_node combine (const tree_node &left, const tree_node &right);
+      void tree_set (std::int64_t row);
+      tree_node tree_query (std::int64_t lo, std::int64_t hi);
+      tree_node tree_query_slots (std::int64_t first_slot, std::int64_t last_slot);
+
+      cubxasl::analytic_list_node &m_func;
+      std::int64_t m_start;		// frame bounds, relative to the current row
+      std::int64_t m_end;
+      bool m_is_unbounded_preceding;
+      bool m_is_unbounded_following;
+
+      tp_domain *m_value_domain;	// SUM/AVG operands are coerced to it; NULL to keep their domain
+      tp_domain *m_add_domain;	// of the additions of exact sums
+      bool m_is_exact_sum;
+      bool m_use_tree;		// the window cannot remove rows by subtraction
+
+      std::deque<DB_VALUE> m_rows;	// operands of the rows from m_first_row to m_row_count - 1
+      std::int64_t m_first_row;
+      std::int64_t m_row_count;
+      std::int64_t m_next_row;	// next row to compute
+      bool m_is_partition_ended;
+
+      std::int64_t m_window_lo;	// rows of the window, from m_window_lo to m_window_hi - 1
+      std::int64_t m_window_hi;
+      std::int64_t m_count;
+      std::int64_t m_count_nn;	// rows of the window with a non-NULL operand
+      DB_VALUE m_accumulator;	// sum, or running MIN/MAX, of the window
+      double m_approximate_sum;
+
+      std::vector<tree_node> m_tree;	// rows go to leaf m_tree_capacity + row % m_tree_capacity
+      std::int64_t m_tree_capacity;
+  };
+} // namespace cubquery
+
+#endif // _QUERY_ANALYTIC_FRAME_HPP_
@@ -0,0 +1,1138 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_compiled_pred - predicates compiled to programs specialized by the domains of their operands
+//
+
+#include "query_compiled_pred.hpp"
+
+#include "dbtype.h"
+#include "error_manager.h"
+#include "fetch.h"
+#include "object_domain.h"
+#include "object_representation.h"
+#include "query_evaluator.h"
+#include "query_executor.h"
+#include "set_object.h"
+#include "system_parameter.h"
+#include "thread_entry.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  //
+  // native values of the domains the nodes are specialized for. get returns false if the value does not have one of
+  // the expected types; compare returns false if the values must be coerced first.
+  //
+
+  struct compiled_pred::int_traits
+  {
+    using native = std::int64_t;
+
+    static bool get (const DB_VALUE *value, native &result)
+    {
+      switch (DB_VALUE_DOMAIN_TYPE (value))
+	{
+	case DB_TYPE_SHORT:
+	  result = db_get_short (value);
+	  return true;
+	case DB_TYPE_INTEGER:
+	  result = db_get_int (value);
+	  return true;
+	case DB_TYPE_BIGINT:
+	  result = db_get_bigint (value);
+	  return true;
+	default:
+	  return false;
+	}
+    }
+
+    static bool compare (const native &left, const native &right, int &cmp)
+    {
+      cmp = (left < right) ? -1 : ((left > right) ? 1 : 0);
+      return true;
+    }
+
+    static const std::vector<native> &get_list (const node &n)
+    {
+      return n.int_list;
+    }
+  };
+
+  struct compiled_pred::double_traits
+  {
+    using native = double;
+
+    static bool get (const DB_VALUE *value, native &result)
+    {
+      switch (DB_VALUE_DOMAIN_TYPE (value))
+	{
+	case DB_TYPE_SHORT:
+	  result = db_get_short (value);
+	  return true;
+	case DB_TYPE_INTEGER:
+	  result = db_get_int (value);
+	  return true;
+	case DB_TYPE_BIGINT:
+	  result = (double) db_get_bigint (value);
+	  return true;
+	case DB_TYPE_FLOAT:
+	  result = db_get_float (value);
+	  return true;
+	case DB_TYPE_DOUBLE:
+	  result = db_get_double (value);
+	  return true;
+	default:
+	  return false;
+	}
+    }
+
+    static bool compare (const native &left, const native &right, int &cmp)
+    {
+      cmp = (left < right) ? -1 : ((left > right) ? 1 : 0);
+      return true;
+    }
+
+    static const std::vector<native> &get_list (const node &n)
+    {
+      return n.double_list;
+    }
+  };
+
+  struct compiled_pred::numeric_traits
+  {
+    using native = numeric_value;
+
+    static bool get (const DB_VALUE *value, native &result)
+    {
+      if (DB_VALUE_DOMAIN_TYPE (value) != DB_TYPE_NUMERIC)
+	{
+	  return false;
+	}
+      result.buf = db_get_numeric (value);
+      result.scale = db_value_scale (value);
+      return true;
+    }
+
+    /* numerics are big-endian two's complement integers scaled by their scale */
+    static bool compare (const native &left, const native &right, int &cmp)
+    {
+      bool left_negative, right_negative;
+
+      if (left.scale != right.scale)
+	{
+	  return false;
+	}
+
+      left_negative = (left.buf[0] & 0x80) != 0;
+      right_negative = (right.buf[0] & 0x80) != 0;
+      if (left_negative != right_negative)
+	{
+	  cmp = left_negative ? -1 : 1;
+	}
+      else
+	{
+	  cmp = std::memcmp (left.buf, right.buf, DB_NUMERIC_BUF_SIZE);
+	  cmp = (cmp < 0) ? -1 : ((cmp > 0) ? 1 : 0);
+	}
+      return true;
+    }
+  };
+
+  struct compiled_pred::date_traits
+  {
+    using native = DB_DATE;
+
+    static bool get (const DB_VALUE *value, native &result)
+    {
+      if (DB_VALUE_DOMAIN_TYPE (value) != DB_TYPE_DATE)
+	{
+	  return false;
+	}
+      result = *db_get_date (value);
+      return true;
+    }
+
+    static bool compare (const native &left, const native &right, int &cmp)
+    {
+      cmp = (left < right) ? -1 : ((left > right) ? 1 : 0);
+      return true;
+    }
+  };
+
+  struct compiled_pred::time_traits
+  {
+    using native = DB_TIME;
+
+    static bool get (const DB_VALUE *value, native &result)
+    {
+      if (DB_VALUE_DOMAIN_TYPE (value) != DB_TYPE_TIME)
+	{
+	  return false;
+	}
+      result = *db_get_time (value);
+      return true;
+    }
+
+    static bool compare (const native &left, const native &right, int &cmp)
+    {
+      cmp = (left < right) ? -1 : ((left > right) ? 1 : 0);
+      return true;
+    }
+  };
+
+  struct compiled_pred::timestamp_traits
+  {
+    using native = DB_TIMESTAMP;
+
+    static bool get (const DB_VALUE *value, native &result)
+    {
+      if (DB_VALUE_DOMAIN_TYPE (value) != DB_TYPE_TIMESTAMP)
+	{
+	  return false;
+	}
+      result = *db_get_timestamp (value);
+      return true;
+    }
+
+    static bool compare (const native &left, const native &right, int &cmp)
+    {
+      cmp = (left < right) ? -1 : ((left > right) ? 1 : 0);
+      return true;
+    }
+  };
+
+  struct compiled_pred::datetime_traits
+  {
+    using native = DB_DATETIME;
+
+    static bool get (const DB_VALUE *value, native &result)
+    {
+      if (DB_VALUE_DOMAIN_TYPE (value) != DB_TYPE_DATETIME)
+	{
+	  return false;
+	}
+      result = *db_get_datetime (value);
+      return true;
+    }
+
+    static bool compare (const native &left, const native &right, int &cmp)
+    {
+      if (left.date != right.date)
+	{
+	  cmp = (left.date < right.date) ? -1 : 1;
+	}
+      else
+	{
+	  cmp = (left.time < right.time) ? -1 : ((left.time > right.time) ? 1 : 0);
+	}
+      return true;
+    }
+  };
+
+  //
+  // arithmetic, with the overflow checks of qdata_add_dbval and friends. false if the interpreter would raise an
+  // error.
+  //
+
+  template <OPERATOR_TYPE Opcode>
+  static bool
+  cp_arith_int (std::int64_t left, std::int64_t right, std::int64_t &result)
+  {
+    switch (Opcode)
+      {
+      case T_ADD:
+	result = (std::int64_t) ((std::uint64_t) left + (std::uint64_t) right);
+	return !OR_CHECK_ADD_OVERFLOW (left, right, result);
+      case T_SUB:
+	result = (std::int64_t) ((std::uint64_t) left - (std::uint64_t) right);
+	return !OR_CHECK_SUB_UNDERFLOW (left, right, result);
+      case T_MUL:
+	if (left == DB_BIGINT_MIN || right == DB_BIGINT_MIN)
+	  {
+	    return false;
+	  }
+	result = (std::int64_t) ((std::uint64_t) left * (std::uint64_t) right);
+	return !OR_CHECK_MULT_OVERFLOW (left, right, result);
+      case T_DIV:
+	if (right == 0 || OR_CHECK_BIGINT_DIV_OVERFLOW (left, right))
+	  {
+	    return false;
+	  }
+	result = left / right;
+	return true;
+      default:
+	assert (false);
+	return false;
+      }
+  }
+
+  template <OPERATOR_TYPE Opcode>
+  static bool
+  cp_arith_double (double left, double right, double &result)
+  {
+    switch (Opcode)
+      {
+      case T_ADD:
+	result = left + right;
+	break;
+      case T_SUB:
+	result = left - right;
+	break;
+      case T_MUL:
+	result = left * right;
+	break;
+      case T_DIV:
+	if (right == 0)
+	  {
+	    return false;
+	  }
+	result = left / right;
+	break;
+      default:
+	assert (false);
+	return false;
+      }
+
+    return !OR_CHECK_DOUBLE_OVERFLOW (result);
+  }
+
+  static bool
+  cp_is_arith_type (DB_TYPE type)
+  {
+    return type == DB_TYPE_SHORT || type == DB_TYPE_INTEGER || type == DB_TYPE_BIGINT || type == DB_TYPE_DOUBLE;
+  }
+
+  compiled_pred::compiled_pred ()
+    : m_nodes ()
+    , m_operands ()
+    , m_root (-1)
+    , m_specialized_count (0)
+  {
+  }
+
+  void
+  compiled_pred::compile (const PRED_EXPR *pred_expr)
+  {
+    assert (pred_expr != NULL);
+
+    m_nodes.clear ();
+    m_operands.clear ();
+    m_specialized_count = 0;
+
+    m_root = compile_node (pred_expr);
+  }
+
+  bool
+  compiled_pred::is_specialized () const
+  {
+    return m_specialized_count > 0;
+  }
+
+  int
+  compiled_pred::get_node_count () const
+  {
+    return (int) m_nodes.size ();
+  }
+
+  int
+  compiled_pred::get_specialized_count () const
+  {
+    return m_specialized_count;
+  }
+
+  DB_LOGICAL
+  compiled_pred::evaluate (cubthread::entry *thread_p, val_descr *vd, OID *obj_oid) const
+  {
+    static int max_recursion_sql_depth = prm_get_integer_value (PRM_ID_MAX_RECURSION_SQL_DEPTH);
+    context ctx = { thread_p, vd, obj_oid };
+    DB_LOGICAL result;
+
+    assert (m_root >= 0);
+
+    if (thread_get_recursion_depth (thread_p) > max_recursion_sql_depth)
+      {
+	er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_MAX_RECURSION_SQL_DEPTH, 1, max_recursion_sql_depth);
+	return V_ERROR;
+      }
+
+    thread_inc_recursion_depth (thread_p);
+
+    const node &root = m_nodes[m_root];
+    result = (this->*root.eval) (root, ctx);
+
+    thread_dec_recursion_depth (thread_p);
+
+    return result;
+  }
+
+  int
+  compiled_pred::compile_node (const PRED_EXPR *pred_expr)
+  {
+    std::vector<int> children;
+    const PRED_EXPR *pr;
+    BOOL_OP bool_op;
+    int node_index, child;
+
+    switch (pred_expr->type)
+      {
+      case T_PRED:
+	bool_op = pred_expr->pe.m_pred.bool_op;
+	if (bool_op != B_AND && bool_op != B_OR)
+	  {
+	    break;
+	  }
+
+	/* right-linear chain of the terms of a conjunction or disjunction (see eval_pred) */
+	for (pr = pred_expr; pr->type == T_PRED && pr->pe.m_pred.bool_op == bool_op; pr = pr->pe.m_pred.rhs)
+	  {
+	    children.push_back (compile_node (pr->pe.m_pred.lhs));
+	  }
+	children.push_back (compile_node (pr));
+
+	node_index = add_node ((bool_op == B_AND) ? &compiled_pred::eval_and : &compiled_pred::eval_or, pred_expr);
+	m_nodes[node_index].children = std::move (children);
+	return node_index;
+
+      case T_NOT_TERM:
+	child = compile_node (pred_expr->pe.m_not_term);
+	node_index = add_node (&compiled_pred::eval_not, pred_expr);
+	m_nodes[node_index].left = child;
+	return node_index;
+
+      case T_EVAL_TERM:
+	switch (pred_expr->pe.m_eval_term.et_type)
+	  {
+	  case T_COMP_EVAL_TERM:
+	    node_index = compile_comp_term (pred_expr);
+	    break;
+	  case T_ALSM_EVAL_TERM:
+	    node_index = compile_alsm_term (pred_expr);
+	    break;
+	  default:
+	    node_index = -1;
+	    break;
+	  }
+	if (node_index >= 0)
+	  {
+	    m_specialized_count++;
+	    return node_index;
+	  }
+	break;
+      }
+
+    return add_node (&compiled_pred::eval_interpreted, pred_expr);
+  }
+
+  /* returns the node of a comparison, or -1 if it has no specialized function */
+  int
+  compiled_pred::compile_comp_term (const PRED_EXPR *pred_expr)
+  {
+    const COMP_EVAL_TERM &et_comp = pred_expr->pe.m_eval_term.et.et_comp;
+    eval_func eval;
+    int node_index, left, right;
+
+    if (et_comp.lhs == NULL || et_comp.lhs->type == TYPE_LIST_ID)
+      {
+	return -1;
+      }
+
+    if (et_comp.rel_op == R_NULL)
+      {
+	/* any value may be null */
+	left = add_operand (et_comp.lhs, DB_TYPE_NULL);
+	node_index = add_node (&compiled_pred::eval_is_null, pred_expr);
+	m_nodes[node_index].left = left;
+	return node_index;
+      }
+
+    if (et_comp.rhs == NULL || et_comp.rhs->type == TYPE_LIST_ID)
+      {
+	return -1;
+      }
+
+    left = compile_operand (et_comp.lhs);
+    right = (left < 0) ? -1 : compile_operand (et_comp.rhs);
+    if (right < 0)
+      {
+	return -1;
+      }
+
+    switch (merge_kinds (m_operands[left].kind, m_operands[right].kind))
+      {
+      case KIND_INT:
+	eval = get_compare_func<int_traits> (et_comp.rel_op);
+	break;
+      case KIND_DOUBLE:
+	eval = get_compare_func<double_traits> (et_comp.rel_op);
+	break;
+      case KIND_NUMERIC:
+	eval = get_compare_func<numeric_traits> (et_comp.rel_op);
+	break;
+      case KIND_DATE:
+	eval = get_compare_func<date_traits> (et_comp.rel_op);
+	break;
+      case KIND_TIME:
+	eval = get_compare_func<time_traits> (et_comp.rel_op);
+	break;
+      case KIND_TIMESTAMP:
+	eval = get_compare_func<timestamp_traits> (et_comp.rel_op);
+	break;
+      case KIND_DATETIME:
+	eval = get_compare_func<datetime_traits> (et_comp.rel_op);
+	break;
+      default:
+	eval = NULL;
+	break;
+      }
+    if (eval == NULL)
+      {
+	return -1;
+      }
+
+    node_index = add_node (eval, pred_expr);
+    m_nodes[node_index].left = left;
+    m_nodes[node_index].right = right;
+    return node_index;
+  }
+
+  /* returns the node of an IN list of numeric constants, or -1 if it has no specialized function */
+  int
+  compiled_pred::compile_alsm_term (const PRED_EXPR *pred_expr)
+  {
+    const ALSM_EVAL_TERM &et_alsm = pred_expr->pe.m_eval_term.et.et_alsm;
+    const DB_VALUE *set_value;
+    DB_SET *set;
+    DB_VALUE elem;
+    DB_TYPE elem_type;
+    value_kind kind;
+    std::vector<std::int64_t> int_list;
+    std::vector<double> double_list;
+    bool has_null = false;
+    int node_index, left, i, size;
+
+    /* x IN (...) is x = SOME (...); NOT IN is its negation */
+    if (et_alsm.eq_flag != F_SOME || et_alsm.rel_op != R_EQ || et_alsm.elemset == NULL
+	|| et_alsm.elemset->type != TYPE_DBVAL)
+      {
+	return -1;
+      }
+
+    set_value = &et_alsm.elemset->value.dbval;
+    if (DB_IS_NULL (set_value) || !TP_IS_SET_TYPE (DB_VALUE_DOMAIN_TYPE (set_value)))
+      {
+	return -1;
+      }
+    set = db_get_set (set_value);
+    size = set_size (set);
+    if (size == 0)
+      {
+	return -1;
+      }
+
+    left = compile_operand (et_alsm.elem);
+    if (left < 0)
+      {
+	return -1;
+      }
+    kind = m_operands[left].kind;
+    if (kind != KIND_INT && kind != KIND_DOUBLE)
+      {
+	return -1;
+      }
+
+    for (i = 0; i < size; i++)
+      {
+	if (set_get_element_nocopy (set, i, &elem) != NO_ERROR)
+	  {
+	    return -1;
+	  }
+	if (DB_IS_NULL (&elem))
+	  {
+	    /* unknown unless another element is equal */
+	    has_null = true;
+	    continue;
+	  }
+
+	elem_type = DB_VALUE_DOMAIN_TYPE (&elem);
+	if (get_kind (elem_type) == KIND_DOUBLE)
+	  {
+	    kind = KIND_DOUBLE;
+	  }
+	else if (get_kind (elem_type) != KIND_INT)
+	  {
+	    return -1;
+	  }
+
+	double_list.emplace_back ();
+	(void) double_traits::get (&elem, double_list.back ());
+	if (kind == KIND_INT)
+	  {
+	    int_list.emplace_back ();
+	    (void) int_traits::get (&elem, int_list.back ());
+	  }
+      }
+
+    if (kind == KIND_INT)
+      {
+	node_index = add_node (&compiled_pred::eval_in_list<int_traits>, pred_expr);
+	std::sort (int_list.begin (), int_list.end ());
+	m_nodes[node_index].int_list = std::move (int_list);
+      }
+    else
+      {
+	node_index = add_node (&compiled_pred::eval_in_list<double_traits>, pred_expr);
+	std::sort (double_list.begin (), double_list.end ());
+	m_nodes[node_index].double_list = std::move (double_list);
+      }
+    m_nodes[node_index].left = left;
+    m_nodes[node_index].list_has_null = has_null;
+    return node_index;
+  }
+
+  /* returns the operand of regu, or -1 if it has no specialized function */
+  int
+  compiled_pred::compile_operand (regu_variable_node *regu)
+  {
+    const ARITH_TYPE *arith;
+    DB_TYPE left_type, right_type, result_type;
+    int operand_index, left, right;
+
+    if (regu == NULL)
+      {
+	return -1;
+      }
+
+    switch (regu->type)
+      {
+      case TYPE_ATTR_ID:
+      case TYPE_SHARED_ATTR_ID:
+      case TYPE_CLASS_ATTR_ID:
+      case TYPE_CONSTANT:
+      case TYPE_POS_VALUE:
+	return add_operand (regu, (regu->domain != NULL) ? TP_DOMAIN_TYPE (regu->domain) : DB_TYPE_NULL);
+
+      case TYPE_DBVAL:
+	return add_operand (regu, DB_VALUE_DOMAIN_TYPE (&regu->value.dbval));
+
+      case TYPE_INARITH:
+	arith = regu->value.arithptr;
+	if (arith == NULL || arith->domain == NULL
+	    || (arith->opcode != T_ADD && arith->opcode != T_SUB && arith->opcode != T_MUL && arith->opcode != T_DIV))
+	  {
+	    return -1;
+	  }
+	left = compile_operand (arith->leftptr);
+	right = (left < 0) ? -1 : compile_operand (arith->rightptr);
+	if (right < 0)
+	  {
+	    return -1;
+	  }
+
+	/* the interpreter computes with the type of the widest operand and casts the result to the domain of the
+	 * expression; only the arithmetic that needs no cast is specialized */
+	left_type = m_operands[left].type;
+	right_type = m_operands[right].type;
+	if (!cp_is_arith_type (left_type) || !cp_is_arith_type (right_type))
+	  {
+	    return -1;
+	  }
+	if (left_type == DB_TYPE_DOUBLE || right_type == DB_TYPE_DOUBLE)
+	  {
+	    result_type = DB_TYPE_DOUBLE;
+	  }
+	else if (left_type == DB_TYPE_BIGINT || right_type == DB_TYPE_BIGINT)
+	  {
+	    result_type = DB_TYPE_BIGINT;
+	  }
+	else if (left_type == DB_TYPE_INTEGER || right_type == DB_TYPE_INTEGER)
+	  {
+	    result_type = DB_TYPE_INTEGER;
+	  }
+	else
+	  {
+	    result_type = DB_TYPE_SHORT;
+	  }
+	if (TP_DOMAIN_TYPE (arith->domain) != result_type)
+	  {
+	    return -1;
+	  }
+
+	operand_index = add_operand (NULL, result_type);
+	{
+	  operand &op = m_operands[operand_index];
+
+	  op.left = left;
+	  op.right = right;
+	  switch (arith->opcode)
+	    {
+	    case T_ADD:
+	      op.arith_int = &cp_arith_int<T_ADD>;
+	      op.arith_double = &cp_arith_double<T_ADD>;
+	      break;
+	    case T_SUB:
+	      op.arith_int = &cp_arith_int<T_SUB>;
+	      op.arith_double = &cp_arith_double<T_SUB>;
+	      break;
+	    case T_MUL:
+	      op.arith_int = &cp_arith_int<T_MUL>;
+	      op.arith_double = &cp_arith_double<T_MUL>;
+	      break;
+	    case T_DIV:
+	      op.arith_int = &cp_arith_int<T_DIV>;
+	      op.arith_double = &cp_arith_double<T_DIV>;
+	      break;
+	    default:
+	      assert (false);
+	      return -1;
+	    }
+	}
+	return operand_index;
+
+      default:
+	return -1;
+      }
+  }
+
+  int
+  compiled_pred::add_operand (regu_variable_node *regu, DB_TYPE type)
+  {
+    int operand_index = (int) m_operands.size ();
+
+    m_operands.emplace_back ();
+    m_operands[operand_index].regu = regu;
+    m_operands[operand_index].kind = get_kind (type);
+    m_operands[operand_index].type = type;
+    m_operands[operand_index].arith_int = NULL;
+    m_operands[operand_index].arith_double = NULL;
+    m_operands[operand_index].left = -1;
+    m_operands[operand_index].right = -1;
+    return operand_index;
+  }
+
+  int
+  compiled_pred::add_node (eval_func eval, const PRED_EXPR *pred_expr)
+  {
+    int node_index = (int) m_nodes.size ();
+
+    m_nodes.emplace_back ();
+    m_nodes[node_index].eval = eval;
+    m_nodes[node_index].pred = pred_expr;
+    m_nodes[node_index].left = -1;
+    m_nodes[node_index].right = -1;
+    m_nodes[node_index].list_has_null = false;
+    return node_index;
+  }
+
+  template <typename Traits>
+  compiled_pred::eval_func
+  compiled_pred::get_compare_func (REL_OP rel_op)
+  {
+    switch (rel_op)
+      {
+      case R_EQ:
+	return &compiled_pred::eval_compare<Traits, R_EQ>;
+      case R_NE:
+	return &compiled_pred::eval_compare<Traits, R_NE>;
+      case R_GT:
+	return &compiled_pred::eval_compare<Traits, R_GT>;
+      case R_GE:
+	return &compiled_pred::eval_compare<Traits, R_GE>;
+      case R_LT:
+	return &compiled_pred::eval_compare<Traits, R_LT>;
+      case R_LE:
+	return &compiled_pred::eval_compare<Traits, R_LE>;
+      case R_NULLSAFE_EQ:
+	return &compiled_pred::eval_compare<Traits, R_NULLSAFE_EQ>;
+      default:
+	/* set comparisons, total order, ... */
+	return NULL;
+      }
+  }
+
+  DB_LOGICAL
+  compiled_pred::eval_and (const node &n, context &ctx) const
+  {
+    DB_LOGICAL result = V_TRUE, child_result;
+
+    for (int child : n.children)
+      {
+	const node &c = m_nodes[child];
+
+	child_result = (this->*c.eval) (c, ctx);
+	if (child_result == V_FALSE || child_result == V_ERROR)
+	  {
+	    return child_result;
+	  }
+	else if (child_result == V_UNKNOWN)
+	  {
+	    result = V_UNKNOWN;
+	  }
+      }
+
+    return result;
+  }
+
+  DB_LOGICAL
+  compiled_pred::eval_or (const node &n, context &ctx) const
+  {
+    DB_LOGICAL result = V_FALSE, child_result;
+
+    for (int child : n.children)
+      {
+	const node &c = m_nodes[child];
+
+	child_result = (this->*c.eval) (c, ctx);
+	if (child_result == V_TRUE || child_result == V_ERROR)
+	  {
+	    return child_result;
+	  }
+	else if (child_result == V_UNKNOWN)
+	  {
+	    result = V_UNKNOWN;
+	  }
+      }
+
+    return result;
+  }
+
+  DB_LOGICAL
+  compiled_pred::eval_not (const node &n, context &ctx) const
+  {
+    const node &c = m_nodes[n.left];
+
+    switch ((this->*c.eval) (c, ctx))
+      {
+      case V_TRUE:
+	return V_FALSE;
+      case V_FALSE:
+	return V_TRUE;
+      case V_UNKNOWN:
+	return V_UNKNOWN;
+      default:
+	return V_ERROR;
+      }
+  }
+
+  DB_LOGICAL
+  compiled_pred::eval_is_null (const node &n, context &ctx) const
+  {
+    const DB_VALUE *value;
+
+    switch (fetch_value (m_operands[n.left], ctx, value))
+      {
+      case FETCH_NULL:
+	return V_TRUE;
+      case FETCH_VALUE:
+	/* a reference to a deleted object is null too */
+	return (DB_VALUE_DOMAIN_TYPE (value) == DB_TYPE_OID) ? eval_interpreted (n, ctx) : V_FALSE;
+      default:
+	return V_ERROR;
+      }
+  }
+
+  DB_LOGICAL
+  compiled_pred::eval_interpreted (const node &n, context &ctx) const
+  {
+    return eval_pred (ctx.thread_p, n.pred, ctx.vd, ctx.obj_oid);
+  }
+
+  template <typename Traits, REL_OP RelOp>
+  DB_LOGICAL
+  compiled_pred::eval_compare (const node &n, context &ctx) const
+  {
+    typename Traits::native left_value, right_value;
+    fetch_status left_status, right_status;
+    int cmp;
+
+    left_status = fetch<Traits> (m_operands[n.left], ctx, left_value);
+    if (left_status == FETCH_ERROR)
+      {
+	return V_ERROR;
+      }
+    else if (left_status == FETCH_FALLBACK)
+      {
+	return eval_interpreted (n, ctx);
+      }
+    else if (left_status == FETCH_NULL && RelOp != R_NULLSAFE_EQ)
+      {
+	return V_UNKNOWN;
+      }
+
+    right_status = fetch<Traits> (m_operands[n.right], ctx, right_value);
+    if (right_status == FETCH_ERROR)
+      {
+	return V_ERROR;
+      }
+    else if (right_status == FETCH_FALLBACK)
+      {
+	return eval_interpreted (n, ctx);
+      }
+    else if (right_status == FETCH_NULL && RelOp != R_NULLSAFE_EQ)
+      {
+	return V_UNKNOWN;
+      }
+
+    if (RelOp == R_NULLSAFE_EQ && (left_status == FETCH_NULL || right_status == FETCH_NULL))
+      {
+	return (left_status == right_status) ? V_TRUE : V_FALSE;
+      }
+
+    if (!Traits::compare (left_value, right_value, cmp))
+      {
+	return eval_interpreted (n, ctx);
+      }
+
+    switch (RelOp)
+      {
+      case R_EQ:
+      case R_NULLSAFE_EQ:
+	return (cmp == 0) ? V_TRUE : V_FALSE;
+      case R_NE:
+	return (cmp != 0) ? V_TRUE : V_FALSE;
+      case R_GT:
+	return (cmp > 0) ? V_TRUE : V_FALSE;
+      case R_GE:
+	return (cmp >= 0) ? V_TRUE : V_FALSE;
+      case R_LT:
+	return (cmp < 0) ? V_TRUE : V_FALSE;
+      case R_LE:
+	return (cmp <= 0) ? V_TRUE : V_FALSE;
+      default:
+	assert (false);
+	return V_ERROR;
+      }
+  }
+
+  template <typename Traits>
+  DB_LOGICAL
+  compiled_pred::eval_in_list (const node &n, context &ctx) const
+  {
+    typename Traits::native value;
+    const std::vector<typename Traits::native> &list = Traits::get_list (n);
+
+    switch (fetch<Traits> (m_operands[n.left], ctx, value))
+      {
+      case FETCH_VALUE:
+	break;
+      case FETCH_NULL:
+	/* the list is not empty */
+	return V_UNKNOWN;
+      case FETCH_FALLBACK:
+	return eval_interpreted (n, ctx);
+      default:
+	return V_ERROR;
+      }
+
+    if (std::binary_search (list.begin (), list.end (), value))
+      {
+	return V_TRUE;
+      }
+    return n.list_has_null ? V_UNKNOWN : V_FALSE;
+  }
+
+  /* peek the value of a leaf operand, like fetch_peek_dbval but without its switch for the most common leaves */
+  compiled_pred::fetch_status
+  compiled_pred::fetch_value (const operand &op, context &ctx, const DB_VALUE *&value) const
+  {
+    regu_variable_node *regu = op.regu;
+    DB_VALUE *peek_value = NULL;
+
+    assert (regu != NULL);
+
+    switch (regu->type)
+      {
+      case TYPE_ATTR_ID:
+      case TYPE_SHARED_ATTR_ID:
+      case TYPE_CLASS_ATTR_ID:
+	peek_value = regu->value.attr_descr.cache_dbvalp;
+	break;
+      case TYPE_DBVAL:
+	peek_value = &regu->value.dbval;
+	break;
+      case TYPE_POS_VALUE:
+	peek_value = ctx.vd->dbval_ptr + regu->value.val_pos;
+	break;
+      default:
+	break;
+      }
+
+    if (peek_value == NULL
+	&& fetch_peek_dbval (ctx.thread_p, regu, ctx.vd, NULL, ctx.obj_oid, NULL, &peek_value) != NO_ERROR)
+      {
+	return FETCH_ERROR;
+      }
+
+    value = peek_value;
+    return DB_IS_NULL (peek_value) ? FETCH_NULL : FETCH_VALUE;
+  }
+
+  template <typename Traits>
+  compiled_pred::fetch_status
+  compiled_pred::fetch (const operand &op, context &ctx, typename Traits::native &value) const
+  {
+    const DB_VALUE *dbval;
+    fetch_status status;
+
+    if (op.regu == NULL)
+      {
+	return fetch_arith (op, ctx, value);
+      }
+
+    status = fetch_value (op, ctx, dbval);
+    if (status != FETCH_VALUE)
+      {
+	return status;
+      }
+    return Traits::get (dbval, value) ? FETCH_VALUE : FETCH_FALLBACK;
+  }
+
+  compiled_pred::fetch_status
+  compiled_pred::fetch_arith (const operand &op, context &ctx, std::int64_t &value) const
+  {
+    std::int64_t left_value, right_value;
+    fetch_status left_status, right_status;
+
+    assert (op.kind == KIND_INT && op.arith_int != NULL);
+
+    left_status = fetch<int_traits> (m_operands[op.left], ctx, left_value);
+    if (left_status == FETCH_ERROR || left_status == FETCH_FALLBACK)
+      {
+	return left_status;
+      }
+    right_status = fetch<int_traits> (m_operands[op.right], ctx, right_value);
+    if (right_status == FETCH_ERROR || right_status == FETCH_FALLBACK)
+      {
+	return right_status;
+      }
+    if (left_status == FETCH_NULL || right_status == FETCH_NULL)
+      {
+	return FETCH_NULL;
+      }
+
+    if (!op.arith_int (left_value, right_value, value))
+      {
+	return FETCH_FALLBACK;
+      }
+    if ((op.type == DB_TYPE_SHORT && OR_CHECK_SHORT_OVERFLOW (value))
+	|| (op.type == DB_TYPE_INTEGER && OR_CHECK_INT_OVERFLOW (value)))
+      {
+	return FETCH_FALLBACK;
+      }
+    return FETCH_VALUE;
+  }
+
+  compiled_pred::fetch_status
+  compiled_pred::fetch_arith (const operand &op, context &ctx, double &value) const
+  {
+    double left_value, right_value;
+    std::int64_t int_value = 0;
+    fetch_status left_status, right_status;
+
+    if (op.kind == KIND_INT)
+      {
+	/* integer arithmetic compared with doubles */
+	left_status = fetch_arith (op, ctx, int_value);
+	value = (double) int_value;
+	return left_status;
+      }
+
+    assert (op.kind == KIND_DOUBLE && op.arith_double != NULL);
+
+    left_status = fetch<double_traits> (m_operands[op.left], ctx, left_value);
+    if (left_status == FETCH_ERROR || left_status == FETCH_FALLBACK)
+      {
+	return left_status;
+      }
+    right_status = fetch<double_traits> (m_operands[op.right], ctx, right_value);
+    if (right_status == FETCH_ERROR || right_status == FETCH_FALLBACK)
+      {
+	return right_status;
+      }
+    if (left_status == FETCH_NULL || right_status == FETCH_NULL)
+      {
+	return FETCH_NULL;
+      }
+
+    return op.arith_double (left_value, right_value, value) ? FETCH_VALUE : FETCH_FALLBACK;
+  }
+
+  template <typename Native>
+  compiled_pred::fetch_status
+  compiled_pred::fetch_arith (const operand &op, context &ctx, Native &value) const
+  {
+    /* arithmetic operands are only compiled for integers and doubles */
+    assert (false);
+    return FETCH_FALLBACK;
+  }
+
+  compiled_pred::value_kind
+  compiled_pred::get_kind (DB_TYPE type)
+  {
+    switch (type)
+      {
+      case DB_TYPE_NULL:
+      case DB_TYPE_VARIABLE:
+	return KIND_ANY;
+      case DB_TYPE_SHORT:
+      case DB_TYPE_INTEGER:
+      case DB_TYPE_BIGINT:
+	return KIND_INT;
+      case DB_TYPE_FLOAT:
+      case DB_TYPE_DOUBLE:
+	return KIND_DOUBLE;
+      case DB_TYPE_NUMERIC:
+	return KIND_NUMERIC;
+      case DB_TYPE_DATE:
+	return KIND_DATE;
+      case DB_TYPE_TIME:
+	return KIND_TIME;
+      case DB_TYPE_TIMESTAMP:
+	return KIND_TIMESTAMP;
+      case DB_TYPE_DATETIME:
+	return KIND_DATETIME;
+      default:
+	return KIND_NONE;
+      }
+  }
+
+  /* the kind both operands are compared as */
+  compiled_pred::value_kind
+  compiled_pred::merge_kinds (value_kind left, value_kind right)
+  {
+    if (left == KIND_ANY)
+      {
+	return (right == KIND_ANY) ? KIND_NONE : right;
+      }
+    else if (right == KIND_ANY || left == right)
+      {
+	return left;
+      }
+    else if ((left == KIND_INT && right == KIND_DOUBLE) || (left == KIND_DOUBLE && right == KIND_INT))
+      {
+	/* coerced to double, like tp_value_compare does */
+	return KIND_DOUBLE;
+      }
+    return KIND_NONE;
+  }
+} // namespace cubquery
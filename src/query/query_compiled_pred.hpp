@@ -0,0 +1,217 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_compiled_pred - predicates compiled to programs specialized by the domains of their operands
+//
+//  eval_pred interprets a predicate tree: for each object it walks PRED_EXPR and REGU_VARIABLE nodes, switches on
+//  their types and operators and compares the values with tp_value_compare, which resolves the types of both values
+//  before coercing and comparing them.
+//
+//  a compiled predicate is a flat program built once for a predicate of an XASL clone. each term of the predicate
+//  becomes a node holding a function instantiated for the domain of its operands and its operator (e.g. "less than
+//  on 64-bit integers"), and each arithmetic operand a function instantiated for its operator. the nodes of
+//  conjunctions and disjunctions loop over their children instead of recursing into the tree.
+//
+//  the domains are only known when the predicate is compiled, so the functions check the types of the values they
+//  fetch: a term whose values do not have the expected types, or whose arithmetic would raise an error, is evaluated
+//  by eval_pred. terms that have no specialized function (strings, sets, subqueries, ...) are always evaluated by
+//  eval_pred.
+//
+//  programs are compiled for the predicates of XASL clones kept in the XASL cache, which are executed again and
+//  again, and are freed with the clone.
+//
+
+#ifndef _QUERY_COMPILED_PRED_HPP_
+#define _QUERY_COMPILED_PRED_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "dbtype_def.h"
+#include "regu_var.hpp"
+#include "storage_common.h"
+#include "xasl_predicate.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// forward definitions
+struct val_descr;
+namespace cubthread
+{
+  class entry;
+}
+
+namespace cubquery
+{
+  //
+  // compiled_pred
+  //
+  //  description:
+  //    the program of a predicate. it only references the nodes of the predicate, which must outlive it, and keeps no
+  //    state between evaluations, so it is used by the scans of any execution of its XASL clone.
+  //
+  //  how to use:
+  //    compiled_pred *program = new compiled_pred ();
+  //    program->compile (pred_expr);
+  //    if (program->is_specialized ())
+  //      {
+  //        // for each object
+  //        result = program->evaluate (thread_p, vd, obj_oid);
+  //      }
+  //
+  class compiled_pred
+  {
+    public:
+      compiled_pred ();
+      compiled_pred (const compiled_pred &) = delete;
+      compiled_pred (compiled_pred &&) = delete;
+
+      ~compiled_pred () = default;
+
+      compiled_pred &operator= (const compiled_pred &) = delete;
+      compiled_pred &operator= (compiled_pred &&) = delete;
+
+      void compile (const PRED_EXPR *pred_expr);
+      // true if at least a term of the predicate has a specialized function; otherwise eval_pred is as fast
+      bool is_specialized () const;
+
+      // same result as eval_pred (thread_p, pred_expr, vd, obj_oid)
+      DB_LOGICAL evaluate (cubthread::entry *thread_p, val_descr *vd, OID *obj_oid) const;
+
+      int get_node_count () const;
+      int get_specialized_count () const;
+
+    private:
+      // what a value fetch or an arithmetic operation has to say
+      enum fetch_status
+      {
+	FETCH_VALUE,
+	FETCH_NULL,
+	FETCH_FALLBACK,		// not the expected type, or the interpreter must raise an error
+	FETCH_ERROR
+      };
+
+      // the families of domains the functions are specialized for
+      enum value_kind
+      {
+	KIND_NONE,		// not specialized
+	KIND_ANY,		// null constants and host variables of unknown type; adopt the kind of the other operand
+	KIND_INT,		// short, integer, bigint
+	KIND_DOUBLE,		// float, double; integers are converted
+	KIND_NUMERIC,		// numerics of same scale
+	KIND_DATE,
+	KIND_TIME,
+	KIND_TIMESTAMP,
+	KIND_DATETIME
+      };
+
+      struct context
+      {
+	cubthread::entry *thread_p;
+	val_descr *vd;
+	OID *obj_oid;
+      };
+
+      struct operand;
+      struct node;
+
+      using eval_func = DB_LOGICAL (compiled_pred::*) (const node &, context &) const;
+      using arith_int_func = bool (*) (std::int64_t, std::int64_t, std::int64_t &);
+      using arith_double_func = bool (*) (double, double, double &);
+
+      struct operand
+      {
+	regu_variable_node *regu;	// leaf; NULL for arithmetic
+	value_kind kind;
+	DB_TYPE type;		// result type of arithmetic
+	arith_int_func arith_int;
+	arith_double_func arith_double;
+	int left;
+	int right;
+      };
+
+      struct node
+      {
+	eval_func eval;
+	const PRED_EXPR *pred;	// evaluated by eval_pred when the node is not specialized or its values don't fit
+	int left;		// operands
+	int right;
+	std::vector<int> children;	// conjunctions and disjunctions
+	std::vector<std::int64_t> int_list;	// IN lists, sorted
+	std::vector<double> double_list;
+	bool list_has_null;
+      };
+
+      // native values
+      struct numeric_value
+      {
+	const unsigned char *buf;
+	int scale;
+      };
+
+      struct int_traits;
+      struct double_traits;
+      struct numeric_traits;
+      struct date_traits;
+      struct time_traits;
+      struct timestamp_traits;
+      struct datetime_traits;
+
+      int compile_node (const PRED_EXPR *pred_expr);
+      int compile_comp_term (const PRED_EXPR *pred_expr);
+      int compile_alsm_term (const PRED_EXPR *pred_expr);
+      int compile_operand (regu_variable_node *regu);
+      int add_operand (regu_variable_node *regu, DB_TYPE type);
+      int add_node (eval_func eval, const PRED_EXPR *pred_expr);
+      template <typename Traits>
+      static eval_func get_compare_func (REL_OP rel_op);
+
+      // nodes
+      DB_LOGICAL eval_and (const node &n, context &ctx) const;
+      DB_LOGICAL eval_or (const node &n, context &ctx) const;
+      DB_LOGICAL eval_not (const node &n, context &ctx) const;
+      DB_LOGICAL eval_is_null (const node &n, context &ctx) const;
+      DB_LOGICAL eval_interpreted (const node &n, context &ctx) const;
+      template <typename Traits, REL_OP RelOp>
+      DB_LOGICAL eval_compare (const node &n, context &ctx) const;
+      template <typename Traits>
+      DB_LOGICAL eval_in_list (const node &n, context &ctx) const;
+
+      // operands
+      fetch_status fetch_value (const operand &op, context &ctx, const DB_VALUE *&value) const;
+      template <typename Traits>
+      fetch_status fetch (const operand &op, context &ctx, typename Traits::native &value) const;
+      fetch_status fetch_arith (const operand &op, context &ctx, std::int64_t &value) const;
+      fetch_status fetch_arith (const operand &op, context &ctx, double &value) const;
+      template <typename Native>
+      fetch_status fetch_arith (const operand &op, context &ctx, Native &value) const;
+
+      static value_kind get_kind (DB_TYPE type);
+      static value_kind merge_kinds (value_kind left, value_kind right);
+
+      std::vector<node> m_nodes;
+      std::vector<operand> m_operands;
+      int m_root;
+      int m_specialized_count;
+  };
+} // namespace cubquery
+
+#endif // _QUERY_COMPILED_PRED_HPP_
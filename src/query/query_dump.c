@@ -2777,6 +2777,7 @@ qdump_print_xasl (xasl_node * xasl_p)
     case CTE_PROC:
       fprintf (foutput, "non_recursive_part xasl:%p\n", xasl_p->proc.cte.non_recursive_part);
       fprintf (foutput, "recursive_part xasl:%p\n", xasl_p->proc.cte.recursive_part);
+      fprintf (foutput, "union:%s\n", xasl_p->proc.cte.is_distinct ? "distinct" : "all");
       /* TODO - dump anchor and recursive part of CTE when we need */
       break;
 
@@ -3130,6 +3131,16 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 	json_object_set_new (build, "fetch_time", json_integer (hashjoin_proc->stats.build.fetch_time));
 	json_object_set_new (build, "ioread", json_integer (hashjoin_proc->stats.build.ioreads));
 	json_object_set_new (build, "hash_method", json_string (hash_method_string));
+	if (hashjoin_proc->stats.build.is_unique)
+	  {
+	    json_object_set_new (build, "unique", json_true ());
+	  }
+	if (hashjoin_proc->stats.build.partitions > 0)
+	  {
+	    json_object_set_new (build, "partitions", json_integer (hashjoin_proc->stats.build.partitions));
+	    json_object_set_new (build, "levels", json_integer (hashjoin_proc->stats.build.partition_levels));
+	    json_object_set_new (build, "workers", json_integer (hashjoin_proc->stats.build.partition_workers));
+	  }
 
 #if defined(TEST_HASH_JOIN_PROFILE_TIME)
 	{
@@ -3155,6 +3166,10 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 	json_object_set_new (probe, "readkeys", json_integer (hashjoin_proc->stats.probe.readkeys));
 	json_object_set_new (probe, "rows", json_integer (hashjoin_proc->stats.probe.rows));
 	json_object_set_new (probe, "max_collisions", json_integer (hashjoin_proc->stats.probe.max_collisions));
+	if (XASL_IS_FLAGED (xasl_p, XASL_HASH_ANTI_JOIN))
+	  {
+	    json_object_set_new (probe, "discarded", json_integer (hashjoin_proc->stats.probe.discarded));
+	  }
 
 #if defined(TEST_HASH_JOIN_PROFILE_TIME)
 	{
@@ -3177,6 +3192,26 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 	json_object_set_new (proc, "build", build);
 	json_object_set_new (proc, "probe", probe);
 
+	if (hashjoin_proc->stats.runtime_filter.keys > 0)
+	  {
+	    json_t *runtime_filter = json_object ();
+	    json_object_set_new (runtime_filter, "keys", json_integer (hashjoin_proc->stats.runtime_filter.keys));
+	    json_object_set_new (runtime_filter, "checked", json_integer (hashjoin_proc->stats.runtime_filter.checked));
+	    json_object_set_new (runtime_filter, "filtered",
+				 json_integer (hashjoin_proc->stats.runtime_filter.filtered));
+	    json_object_set_new (proc, "runtime_filter", runtime_filter);
+	  }
+
+	if (hashjoin_proc->stats.partition_pruning.partitions > 0)
+	  {
+	    json_t *partition_pruning = json_object ();
+	    json_object_set_new (partition_pruning, "partitions",
+				 json_integer (hashjoin_proc->stats.partition_pruning.partitions));
+	    json_object_set_new (partition_pruning, "scanned",
+				 json_integer (hashjoin_proc->stats.partition_pruning.scanned));
+	    json_object_set_new (proc, "partition_pruning", partition_pruning);
+	  }
+
 	break;
       }
 
@@ -3198,7 +3233,17 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 
       if (xasl_p->proc.cte.recursive_part != NULL)
 	{
+	  CTE_STATS *cstats = &xasl_p->proc.cte.stats;
+
 	  cte_recursive_part = json_object ();
+	  json_object_set_new (cte_recursive_part, "iterations", json_integer (cstats->iterations));
+	  json_object_set_new (cte_recursive_part, "rows", json_integer (cstats->delta_rows));
+	  json_object_set_new (cte_recursive_part, "max_delta", json_integer (cstats->max_delta_rows));
+	  if (xasl_p->proc.cte.is_distinct)
+	    {
+	      json_object_set_new (cte_recursive_part, "duplicates", json_integer (cstats->duplicate_rows));
+	      json_object_set_new (cte_recursive_part, "dedup", json_string (cstats->dedup_sorted ? "sort" : "hash"));
+	    }
 	  qdump_print_stats_json (xasl_p->proc.cte.recursive_part, cte_recursive_part);
 	  json_object_set_new (proc, "recursive_part", cte_recursive_part);
 	}
@@ -3273,12 +3318,34 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 	  json_object_set_new (groupby, "sort", json_true ());
 	  json_object_set_new (groupby, "page", json_integer (gstats->groupby_pages));
 	  json_object_set_new (groupby, "ioread", json_integer (gstats->groupby_ioreads));
+	  if (gstats->groupby_spilled_pages > 0)
+	    {
+	      json_object_set_new (groupby, "runs", json_integer (gstats->groupby_runs));
+	      json_object_set_new (groupby, "passes", json_integer (gstats->groupby_merge_passes));
+	      json_object_set_new (groupby, "spilled", json_integer (gstats->groupby_spilled_pages * DB_PAGESIZE));
+	    }
 	}
       else
 	{
 	  json_object_set_new (groupby, "sort", json_false ());
 	}
 
+      if (gstats->hash_workers > 0)
+	{
+	  json_object_set_new (groupby, "workers", json_integer (gstats->hash_workers));
+	}
+
+      if (gstats->hash_partitions > 0)
+	{
+	  json_object_set_new (groupby, "partitions", json_integer (gstats->hash_partitions));
+	  json_object_set_new (groupby, "levels", json_integer (gstats->hash_partition_levels));
+	}
+
+      if (gstats->partition_wise > 0)
+	{
+	  json_object_set_new (groupby, "partitionwise", json_integer (gstats->partition_wise));
+	}
+
       json_object_set_new (groupby, "rows", json_integer (gstats->rows));
       json_object_set_new (proc, "GROUPBY", groupby);
     }
@@ -3295,6 +3362,12 @@ qdump_print_stats_json (xasl_node * xasl_p, json_t * parent)
 	  json_object_set_new (orderby, "sort", json_true ());
 	  json_object_set_new (orderby, "page", json_integer (ostats->orderby_pages));
 	  json_object_set_new (orderby, "ioread", json_integer (ostats->orderby_ioreads));
+	  if (ostats->orderby_spilled_pages > 0)
+	    {
+	      json_object_set_new (orderby, "runs", json_integer (ostats->orderby_runs));
+	      json_object_set_new (orderby, "passes", json_integer (ostats->orderby_merge_passes));
+	      json_object_set_new (orderby, "spilled", json_integer (ostats->orderby_spilled_pages * DB_PAGESIZE));
+	    }
 	}
       else if (ostats->orderby_topnsort)
 	{
@@ -3532,6 +3605,20 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
 
 	indent += 2;
 
+	if (hashjoin_proc->stats.runtime_filter.keys > 0)
+	  {
+	    fprintf (fp, "%*cRUNTIME FILTER (keys: %lld, checked: %lld, filtered: %lld)\n", indent, ' ',
+		     (long long int) hashjoin_proc->stats.runtime_filter.keys,
+		     (long long int) hashjoin_proc->stats.runtime_filter.checked,
+		     (long long int) hashjoin_proc->stats.runtime_filter.filtered);
+	  }
+
+	if (hashjoin_proc->stats.partition_pruning.partitions > 0)
+	  {
+	    fprintf (fp, "%*cPARTITION PRUNING (partitions: %u, scanned: %u)\n", indent, ' ',
+		     hashjoin_proc->stats.partition_pruning.partitions, hashjoin_proc->stats.partition_pruning.scanned);
+	  }
+
 	fprintf (fp,
 		 "%*cBUILD (time: %d, build_time: %d, fetch: %lld, fetch_time: %lld, ioread: %lld, hash_method: %s)",
 		 indent, ' ', TO_MSEC (hashjoin_proc->stats.build.elapsed_time),
@@ -3548,6 +3635,18 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
 		 TO_MSEC (hashjoin_proc->stats.build.profile.insert));
 #endif
 
+	if (hashjoin_proc->stats.build.is_unique)
+	  {
+	    fprintf (fp, ", unique");
+	  }
+
+	if (hashjoin_proc->stats.build.partitions > 0)
+	  {
+	    fprintf (fp, ", partitions: %u, levels: %u, workers: %u", (unsigned int) hashjoin_proc->stats.build.partitions,
+		     (unsigned int) hashjoin_proc->stats.build.partition_levels,
+		     (unsigned int) hashjoin_proc->stats.build.partition_workers);
+	  }
+
 	fprintf (fp, "\n");
 
 	qdump_print_stats_text (fp, hashjoin_proc->build->xasl, indent);
@@ -3562,6 +3661,11 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
 		 (long long int) hashjoin_proc->stats.probe.readkeys, (long long int) hashjoin_proc->stats.probe.rows,
 		 (unsigned int) hashjoin_proc->stats.probe.max_collisions);
 
+	if (XASL_IS_FLAGED (xasl_p, XASL_HASH_ANTI_JOIN))
+	  {
+	    fprintf (fp, ", discarded: %lld", (long long int) hashjoin_proc->stats.probe.discarded);
+	  }
+
 #if defined(TEST_HASH_JOIN_PROFILE_TIME)
 	fprintf (fp,
 		 ", (F: %d, H: %d, S: %d, M: %d, A: %d)",
@@ -3591,8 +3695,18 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
       qdump_print_stats_text (fp, xasl_p->proc.cte.non_recursive_part, indent);
       if (xasl_p->proc.cte.recursive_part != NULL)
 	{
+	  CTE_STATS *cstats = &xasl_p->proc.cte.stats;
+
 	  fprintf (fp, "%*c", indent, ' ');
-	  fprintf (fp, "CTE (recursive_part)\n");
+	  fprintf (fp, "CTE (recursive_part, iterations: %lld, rows: %lld, max_delta: %lld",
+		   (long long int) cstats->iterations, (long long int) cstats->delta_rows,
+		   (long long int) cstats->max_delta_rows);
+	  if (xasl_p->proc.cte.is_distinct)
+	    {
+	      fprintf (fp, ", duplicates: %lld, dedup: %s", (long long int) cstats->duplicate_rows,
+		       cstats->dedup_sorted ? "sort" : "hash");
+	    }
+	  fprintf (fp, ")\n");
 	  qdump_print_stats_text (fp, xasl_p->proc.cte.recursive_part, indent);
 	}
       break;
@@ -3654,12 +3768,34 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
 	{
 	  fprintf (fp, ", sort: true, page: %lld, ioread: %lld", (long long int) gstats->groupby_pages,
 		   (long long int) gstats->groupby_ioreads);
+	  if (gstats->groupby_spilled_pages > 0)
+	    {
+	      fprintf (fp, ", runs: %lld, passes: %lld, spilled: %lld", (long long int) gstats->groupby_runs,
+		       (long long int) gstats->groupby_merge_passes,
+		       (long long int) (gstats->groupby_spilled_pages * DB_PAGESIZE));
+	    }
 	}
       else
 	{
 	  fprintf (fp, ", sort: false");
 	}
 
+      if (gstats->hash_workers > 0)
+	{
+	  fprintf (fp, ", workers: %u", (unsigned int) gstats->hash_workers);
+	}
+
+      if (gstats->hash_partitions > 0)
+	{
+	  fprintf (fp, ", partitions: %u, levels: %u", (unsigned int) gstats->hash_partitions,
+		   (unsigned int) gstats->hash_partition_levels);
+	}
+
+      if (gstats->partition_wise > 0)
+	{
+	  fprintf (fp, ", partition-wise: %u", (unsigned int) gstats->partition_wise);
+	}
+
       fprintf (fp, ", rows: %d)\n", gstats->rows);
     }
 
@@ -3674,6 +3810,12 @@ qdump_print_stats_text (FILE * fp, xasl_node * xasl_p, int indent)
 	  fprintf (fp, ", sort: true");
 	  fprintf (fp, ", page: %lld, ioread: %lld", (long long int) ostats->orderby_pages,
 		   (long long int) ostats->orderby_ioreads);
+	  if (ostats->orderby_spilled_pages > 0)
+	    {
+	      fprintf (fp, ", runs: %lld, passes: %lld, spilled: %lld", (long long int) ostats->orderby_runs,
+		       (long long int) ostats->orderby_merge_passes,
+		       (long long int) (ostats->orderby_spilled_pages * DB_PAGESIZE));
+	    }
 	}
       else if (ostats->orderby_topnsort)
 	{
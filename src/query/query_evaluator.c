@@ -43,6 +43,7 @@
 #include "dbtype.h"
 #include "thread_entry.hpp"
 #include "xasl_predicate.hpp"
+#include "query_compiled_pred.hpp"
 // XXX: SHOULD BE THE LAST INCLUDE HEADER
 #include "memory_wrapper.hpp"
 
@@ -2070,7 +2071,7 @@ eval_pred (THREAD_ENTRY * thread_p, const PRED_EXPR * pr, val_descr * vd, OID *
 	    }
 	  /* evaluate regular expression match */
 	  /* Note: Currently only STRING type is supported */
-	  db_string_like (peek_val1, peek_val2, peek_val3, &regexp_res);
+	  db_string_like (peek_val1, peek_val2, peek_val3, &et_like->compiled_like, &regexp_res);
 	  result = (DB_LOGICAL) regexp_res;
 	  break;
 
@@ -2482,7 +2483,7 @@ eval_pred_like6 (THREAD_ENTRY * thread_p, const PRED_EXPR * pr, val_descr * vd,
 
   /* evaluate regular expression match */
   /* Note: Currently only STRING type is supported */
-  db_string_like (peek_val1, peek_val2, peek_val3, &regexp_res);
+  db_string_like (peek_val1, peek_val2, peek_val3, &et_like->compiled_like, &regexp_res);
 
   return (DB_LOGICAL) regexp_res;
 }
@@ -2565,6 +2566,11 @@ eval_fnc (THREAD_ENTRY * thread_p, const PRED_EXPR * pr, DB_TYPE * single_node_t
       return NULL;
     }
 
+  if (pr->compiled != NULL && pr->compiled->is_specialized ())
+    {
+      return (PR_EVAL_FNC) eval_compiled_pred;
+    }
+
   if (pr->type == T_EVAL_TERM)
     {
       switch (pr->pe.m_eval_term.et_type)
@@ -2621,6 +2627,45 @@ eval_fnc (THREAD_ENTRY * thread_p, const PRED_EXPR * pr, DB_TYPE * single_node_t
   return (PR_EVAL_FNC) eval_pred;
 }
 
+/*
+ * eval_compile_pred () - compile the program of a predicate, once
+ *   return:
+ *   thread_p(in):
+ *   pr(in): Predicate Expression Tree of a cached XASL clone
+ *
+ *   Note: the program is kept with the predicate even if no term could be specialized, so it is not compiled again.
+ *         it is freed when the clone is decached (see qexec_clear_pred).
+ */
+void
+eval_compile_pred (THREAD_ENTRY * thread_p, const PRED_EXPR * pr)
+{
+  if (pr == NULL || pr->compiled != NULL)
+    {
+      return;
+    }
+
+  // *INDENT-OFF*
+  pr->compiled = new cubquery::compiled_pred ();
+  // *INDENT-ON*
+  pr->compiled->compile (pr);
+}
+
+/*
+ * eval_compiled_pred () - evaluate a predicate with its compiled program
+ *   return: DB_LOGICAL (V_TRUE, V_FALSE, V_UNKNOWN or V_ERROR)
+ *   thread_p(in):
+ *   pr(in): Predicate Expression Tree compiled by eval_compile_pred
+ *   vd(in): Value descriptor for positional values (optional)
+ *   obj_oid(in): Object Identifier
+ */
+DB_LOGICAL
+eval_compiled_pred (THREAD_ENTRY * thread_p, const PRED_EXPR * pr, val_descr * vd, OID * obj_oid)
+{
+  assert (pr->compiled != NULL);
+
+  return pr->compiled->evaluate (thread_p, vd, obj_oid);
+}
+
 /*
  * update_logical_result () - checks DB_LOGICAL value and qualification
  *   return: new DB_LOGICAL value and qualification (if needed)
@@ -47,6 +47,7 @@
 #include "thread_entry.hpp"
 #include "xasl_cache.h"
 #include "xasl_unpack_info.hpp"
+#include "list_file_compression.hpp"
 // XXX: SHOULD BE THE LAST INCLUDE HEADER
 #include "memory_wrapper.hpp"
 
@@ -74,7 +75,8 @@ enum qmgr_page_type
 {
   QMGR_UNKNOWN_PAGE,
   QMGR_MEMBUF_PAGE,
-  QMGR_TEMP_FILE_PAGE
+  QMGR_TEMP_FILE_PAGE,
+  QMGR_COMPRESSED_PAGE
 };
 typedef enum qmgr_page_type QMGR_PAGE_TYPE;
 
@@ -162,6 +164,7 @@ static OID_BLOCK_LIST *qmgr_allocate_oid_block (THREAD_ENTRY * thread_p);
 static void qmgr_free_oid_block (THREAD_ENTRY * thread_p, OID_BLOCK_LIST * oid_block);
 static int qmgr_init_external_file_page (THREAD_ENTRY * thread_p, PAGE_PTR page, void *args);
 static PAGE_PTR qmgr_get_external_file_page (THREAD_ENTRY * thread_p, VPID * vpid, QMGR_TEMP_FILE * vfid);
+static PAGE_PTR qmgr_get_compressed_file_page (THREAD_ENTRY * thread_p, VPID * vpid, QMGR_TEMP_FILE * vfid);
 static int qmgr_free_query_temp_file_helper (THREAD_ENTRY * thread_p, QMGR_QUERY_ENTRY * query_p);
 static int qmgr_free_query_temp_file (THREAD_ENTRY * thread_p, QMGR_QUERY_ENTRY * qptr, int tran_idx);
 static QMGR_TEMP_FILE *qmgr_allocate_tempfile_with_buffer (int num_buffer_pages);
@@ -202,6 +205,11 @@ qmgr_get_page_type (PAGE_PTR page_p, QMGR_TEMP_FILE * temp_file_p)
       return QMGR_MEMBUF_PAGE;
     }
 
+  if (temp_file_p != NULL && temp_file_p->compressed_pages != NULL && temp_file_p->compressed_pages->owns_page (page_p))
+    {
+      return QMGR_COMPRESSED_PAGE;
+    }
+
   begin_page = (PAGE_PTR) ((PAGE_PTR) temp_file_p->membuf
 			   + DB_ALIGN (sizeof (PAGE_PTR) * temp_file_p->membuf_npages, MAX_ALIGNMENT));
   end_page = begin_page + temp_file_p->membuf_npages * DB_PAGESIZE;
@@ -1280,6 +1288,7 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, QUERY_I
   bool xasl_trace;
   bool is_xasl_pinned_reference;
   bool do_not_cache = false;
+  struct timeval start_time, end_time;
 
   static int qmgr_max_query_entry_per_tran = prm_get_integer_value (PRM_ID_QMGR_MAX_QUERY_PER_TRAN);
 
@@ -1534,6 +1543,8 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, QUERY_I
 
   assert (cached_result == false);
 
+  (void) gettimeofday (&start_time, NULL);
+
   list_id_p =
     qmgr_process_query (thread_p, xclone.xasl, NULL, 0, dbval_count, dbvals_p, *flag_p, query_p, tran_entry_p);
   if (list_id_p == NULL)
@@ -1541,6 +1552,11 @@ xqmgr_execute_query (THREAD_ENTRY * thread_p, const XASL_ID * xasl_id_p, QUERY_I
       goto exit_on_error;
     }
 
+  /* the plan cache keeps how long its plans take, e.g. to compare the plan variants of a statement */
+  (void) gettimeofday (&end_time, NULL);
+  xcache_add_execution (xasl_cache_entry_p, (end_time.tv_sec - start_time.tv_sec) * 1000000LL
+			+ (end_time.tv_usec - start_time.tv_usec));
+
   /* everything is ok, mark that the query is completed */
   qmgr_mark_query_as_completed (query_p);
 
@@ -2466,6 +2482,18 @@ qmgr_get_old_page (THREAD_ENTRY * thread_p, VPID * vpid_p, QMGR_TEMP_FILE * tfil
 	  page_p = NULL;
 	}
     }
+  else if (cubquery::compressed_page_store::is_store_vpid (vpid_p))
+    {
+      /* return compressed page, decompressed */
+      if (tfile_vfid_p == NULL || tfile_vfid_p->compressed_pages == NULL)
+	{
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_QPROC_INVALID_TEMP_FILE, 1,
+		  LOG_FIND_THREAD_TRAN_INDEX (thread_p));
+	  return NULL;
+	}
+
+      page_p = tfile_vfid_p->compressed_pages->fix_page (thread_p, vpid_p);
+    }
   else
     {
       /* return temp file page */
@@ -2516,6 +2544,10 @@ qmgr_free_old_page (THREAD_ENTRY * thread_p, PAGE_PTR page_p, QMGR_TEMP_FILE * t
       /* The list files came from list file cache have no tfile_vfid_p. */
       pgbuf_unfix (thread_p, page_p);
     }
+  else if (page_type == QMGR_COMPRESSED_PAGE)
+    {
+      tfile_vfid_p->compressed_pages->unfix_page (thread_p, page_p);
+    }
 #if defined (SERVER_MODE)
   else
     {
@@ -2550,6 +2582,15 @@ qmgr_set_dirty_page (THREAD_ENTRY * thread_p, PAGE_PTR page_p, int free_page, LO
       log_skip_logging (thread_p, addr_p);
       pgbuf_set_dirty (thread_p, page_p, free_page);
     }
+  else if (page_type == QMGR_COMPRESSED_PAGE)
+    {
+      /* compressed when unfixed */
+      tfile_vfid_p->compressed_pages->set_dirty (page_p);
+      if (free_page == (int) FREE)
+	{
+	  tfile_vfid_p->compressed_pages->unfix_page (thread_p, page_p);
+	}
+    }
 #if defined (SERVER_MODE)
   else if (free_page == (int) FREE)
     {
@@ -2611,10 +2652,24 @@ qmgr_get_new_page (THREAD_ENTRY * thread_p, VPID * vpid_p, QMGR_TEMP_FILE * tfil
 	  VFID_SET_NULL (&tfile_vfid_p->temp_vfid);
 	  return NULL;
 	}
+
+      if (tfile_vfid_p->membuf_type == TEMP_FILE_MEMBUF_NORMAL && prm_get_bool_value (PRM_ID_LIST_FILE_COMPRESSION))
+	{
+	  /* the pages past the membuf are compressed into the pages of the temp file */
+	  assert (tfile_vfid_p->compressed_pages == NULL);
+	  tfile_vfid_p->compressed_pages = new cubquery::compressed_page_store (tfile_vfid_p->temp_vfid);
+	}
     }
 
   /* try to get pages from an external temp file */
-  page_p = qmgr_get_external_file_page (thread_p, vpid_p, tfile_vfid_p);
+  if (tfile_vfid_p->compressed_pages != NULL)
+    {
+      page_p = qmgr_get_compressed_file_page (thread_p, vpid_p, tfile_vfid_p);
+    }
+  else
+    {
+      page_p = qmgr_get_external_file_page (thread_p, vpid_p, tfile_vfid_p);
+    }
   if (page_p == NULL)
     {
       /* more temp file page is unavailable; cause error to stop the query */
@@ -2674,6 +2729,33 @@ qmgr_get_external_file_page (THREAD_ENTRY * thread_p, VPID * vpid_p, QMGR_TEMP_F
   return page_p;
 }
 
+/*
+ * qmgr_get_compressed_file_page () -
+ *   return: PAGE_PTR
+ *   vpid(in)   : Set to the allocated virtual page identifier
+ *   tmp_vfid(in)       : tempfile_vfid struct pointer
+ *
+ * Note: Like qmgr_get_external_file_page, but the new page is a page of the compressed page store of the temp file.
+ * It is compressed into the pages of the temp file when it is freed.
+ */
+static PAGE_PTR
+qmgr_get_compressed_file_page (THREAD_ENTRY * thread_p, VPID * vpid_p, QMGR_TEMP_FILE * tmp_vfid_p)
+{
+  PAGE_PTR page_p = NULL;
+  QFILE_PAGE_HEADER page_header = QFILE_PAGE_HEADER_INITIALIZER;
+
+  VPID_SET_NULL (vpid_p);
+  page_p = tmp_vfid_p->compressed_pages->new_page (thread_p, vpid_p);
+  if (page_p == NULL)
+    {
+      ASSERT_ERROR ();
+      return NULL;
+    }
+
+  qmgr_put_page_header (page_p, &page_header);
+  return page_p;
+}
+
 static QMGR_TEMP_FILE *
 qmgr_allocate_tempfile_with_buffer (int num_buffer_pages)
 {
@@ -2741,6 +2823,7 @@ qmgr_create_new_temp_file (THREAD_ENTRY * thread_p, QUERY_ID query_id, QMGR_TEMP
   tfile_vfid_p->membuf_type = membuf_type;
   tfile_vfid_p->preserved = false;
   tfile_vfid_p->tde_encrypted = false;
+  tfile_vfid_p->compressed_pages = NULL;
   tfile_vfid_p->membuf_last = -1;
 
   page_p = (PAGE_PTR) ((PAGE_PTR) tfile_vfid_p->membuf
@@ -2847,6 +2930,7 @@ qmgr_create_result_file (THREAD_ENTRY * thread_p, QUERY_ID query_id)
   tfile_vfid_p->membuf_type = TEMP_FILE_MEMBUF_NONE;
   tfile_vfid_p->preserved = false;
   tfile_vfid_p->tde_encrypted = false;
+  tfile_vfid_p->compressed_pages = NULL;
 
   /* Find the query entry and chain the created temp file to the entry */
 
@@ -3413,6 +3497,13 @@ qmgr_put_temp_file_into_list (QMGR_TEMP_FILE * temp_file_p)
 
   temp_file_p->membuf_last = -1;
 
+  if (temp_file_p->compressed_pages != NULL)
+    {
+      /* its packed pages are gone with the temp file */
+      delete temp_file_p->compressed_pages;
+      temp_file_p->compressed_pages = NULL;
+    }
+
   if (QMGR_IS_VALID_MEMBUF_TYPE (temp_file_p->membuf_type))
     {
       temp_file_list_p = &qmgr_Query_table.temp_file_list[temp_file_p->membuf_type];
@@ -3613,6 +3704,29 @@ qmgr_get_current_query_id (THREAD_ENTRY * thread_p)
   return query_id;
 }
 
+/*
+ * qmgr_get_query_xasl_cache_entry () - return XASL cache entry of the given query_id
+ *   return: XASL cache entry, NULL if the query was not executed from XASL cache
+ *   thread_p(in):
+ *   query_id(in):
+ *   tran_index(in):
+ *
+ * Note: the entry is fixed until the query ends.
+ */
+XASL_CACHE_ENTRY *
+qmgr_get_query_xasl_cache_entry (THREAD_ENTRY * thread_p, QUERY_ID query_id, int tran_index)
+{
+  QMGR_QUERY_ENTRY *query_ent_p = NULL;
+
+  query_ent_p = qmgr_get_query_entry (thread_p, query_id, tran_index);
+  if (query_ent_p == NULL)
+    {
+      return NULL;
+    }
+
+  return query_ent_p->xasl_ent;
+}
+
 /*
  * qmgr_get_query_sql_user_text () - return sql_user_text of the given query_id
  *   return: query string
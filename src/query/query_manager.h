@@ -39,6 +39,13 @@
 // forward definitions
 struct xasl_cache_ent;
 
+// *INDENT-OFF*
+namespace cubquery
+{
+  class compressed_page_store;
+}
+// *INDENT-ON*
+
 #define qmgr_free_old_page_and_init(thread_p, page_p, tfile_vfidp) \
   do \
     { \
@@ -85,6 +92,7 @@ struct qmgr_temp_file
   QMGR_TEMP_FILE_MEMBUF_TYPE membuf_type;
   bool preserved;		/* if temp file is preserved */
   bool tde_encrypted;		/* whether the file of temp_vfid has to be encrypted when flushing (TDE) */
+  cubquery::compressed_page_store *compressed_pages;	/* pages past the membuf, when list_file_compression is on */
 };
 
 /*
@@ -173,6 +181,7 @@ extern int qmgr_get_temp_file_membuf_pages (QMGR_TEMP_FILE * temp_file_p);
 extern int qmgr_get_sql_id (THREAD_ENTRY * thread_p, char **sql_id_buf, char *query, size_t sql_len);
 extern struct drand48_data *qmgr_get_rand_buf (THREAD_ENTRY * thread_p);
 extern QUERY_ID qmgr_get_current_query_id (THREAD_ENTRY * thread_p);
+extern xasl_cache_ent *qmgr_get_query_xasl_cache_entry (THREAD_ENTRY * thread_p, QUERY_ID query_id, int tran_index);
 extern char *qmgr_get_query_sql_user_text (THREAD_ENTRY * thread_p, QUERY_ID query_id, int tran_index);
 
 #endif /* _QUERY_MANAGER_H_ */
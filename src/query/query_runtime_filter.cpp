@@ -0,0 +1,298 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_runtime_filter - bloom filters on the join keys of a hash join, checked by the block producing its other input
+//
+
+#include "query_runtime_filter.hpp"
+
+#include "dbtype.h"
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  static std::uint64_t
+  rf_mix (std::uint64_t value)
+  {
+    /* finalizer of murmur3 */
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+  }
+
+  //
+  // bloom_filter
+  //
+
+  bloom_filter::bloom_filter (std::size_t expected_keys)
+    : m_words ()
+    , m_block_mask (0)
+  {
+    const std::size_t block_bits = WORDS_PER_BLOCK * 64;
+    std::size_t blocks = 1;
+
+    while (blocks * block_bits < expected_keys * BITS_PER_KEY)
+      {
+	blocks <<= 1;
+      }
+
+    m_words.assign (blocks * WORDS_PER_BLOCK, 0);
+    m_block_mask = blocks - 1;
+  }
+
+  void
+  bloom_filter::add (std::uint64_t hash)
+  {
+    std::uint64_t *block = &m_words[ ((hash >> 32) & m_block_mask) * WORDS_PER_BLOCK];
+    std::uint32_t bit = (std::uint32_t) hash;
+    std::uint32_t step = ((std::uint32_t) (hash >> 17)) | 1;
+
+    for (int i = 0; i < PROBES; i++)
+      {
+	block[ (bit >> 6) & (WORDS_PER_BLOCK - 1)] |= ((std::uint64_t) 1) << (bit & 63);
+	bit += step;
+      }
+  }
+
+  bool
+  bloom_filter::may_contain (std::uint64_t hash) const
+  {
+    const std::uint64_t *block = &m_words[ ((hash >> 32) & m_block_mask) * WORDS_PER_BLOCK];
+    std::uint32_t bit = (std::uint32_t) hash;
+    std::uint32_t step = ((std::uint32_t) (hash >> 17)) | 1;
+
+    for (int i = 0; i < PROBES; i++)
+      {
+	if ((block[ (bit >> 6) & (WORDS_PER_BLOCK - 1)] & (((std::uint64_t) 1) << (bit & 63))) == 0)
+	  {
+	    return false;
+	  }
+	bit += step;
+      }
+
+    return true;
+  }
+
+  std::size_t
+  bloom_filter::get_size () const
+  {
+    return m_words.size () * sizeof (std::uint64_t);
+  }
+
+  //
+  // runtime_filter
+  //
+
+  runtime_filter::runtime_filter (const DB_TYPE *key_types, const int *key_columns, int key_count,
+				  std::size_t expected_keys)
+    : m_key_count (key_count)
+    , m_kinds ()
+    , m_columns (key_columns, key_columns + key_count)
+    , m_bloom (expected_keys)
+    , m_added (0)
+    , m_checked (0)
+    , m_filtered (0)
+    , m_enabled (true)
+  {
+    for (int i = 0; i < key_count; i++)
+      {
+	m_kinds.push_back (get_kind (key_types[i]));
+	assert (m_kinds.back () != KIND_NONE);
+      }
+  }
+
+  runtime_filter::key_kind
+  runtime_filter::get_kind (DB_TYPE type)
+  {
+    switch (type)
+      {
+      case DB_TYPE_SHORT:
+      case DB_TYPE_INTEGER:
+      case DB_TYPE_BIGINT:
+	return KIND_INTEGER;
+      case DB_TYPE_DATE:
+	return KIND_DATE;
+      case DB_TYPE_TIME:
+	return KIND_TIME;
+      case DB_TYPE_TIMESTAMP:
+	return KIND_TIMESTAMP;
+      case DB_TYPE_DATETIME:
+	return KIND_DATETIME;
+      default:
+	return KIND_NONE;
+      }
+  }
+
+  bool
+  runtime_filter::is_supported_type (DB_TYPE type)
+  {
+    return get_kind (type) != KIND_NONE;
+  }
+
+  int
+  runtime_filter::get_key_count () const
+  {
+    return m_key_count;
+  }
+
+  int
+  runtime_filter::get_key_column (int key) const
+  {
+    return m_columns[key];
+  }
+
+  bool
+  runtime_filter::hash_key (DB_VALUE *const *values, std::uint64_t &hash) const
+  {
+    const DB_VALUE *value;
+    const DB_DATETIME *datetime;
+    std::uint64_t native;
+
+    hash = 0;
+    for (int i = 0; i < m_key_count; i++)
+      {
+	value = values[i];
+	if (value == NULL || DB_IS_NULL (value) || get_kind (DB_VALUE_DOMAIN_TYPE (value)) != m_kinds[i])
+	  {
+	    return false;
+	  }
+
+	switch (DB_VALUE_DOMAIN_TYPE (value))
+	  {
+	  case DB_TYPE_SHORT:
+	    native = (std::uint64_t) (std::int64_t) db_get_short (value);
+	    break;
+	  case DB_TYPE_INTEGER:
+	    native = (std::uint64_t) (std::int64_t) db_get_int (value);
+	    break;
+	  case DB_TYPE_BIGINT:
+	    native = (std::uint64_t) db_get_bigint (value);
+	    break;
+	  case DB_TYPE_DATE:
+	    native = *db_get_date (value);
+	    break;
+	  case DB_TYPE_TIME:
+	    native = *db_get_time (value);
+	    break;
+	  case DB_TYPE_TIMESTAMP:
+	    native = *db_get_timestamp (value);
+	    break;
+	  case DB_TYPE_DATETIME:
+	    datetime = db_get_datetime (value);
+	    native = (((std::uint64_t) datetime->date) << 32) | datetime->time;
+	    break;
+	  default:
+	    assert (false);
+	    return false;
+	  }
+
+	hash = rf_mix (hash * 0x9e3779b97f4a7c15ULL + native);
+      }
+
+    return true;
+  }
+
+  bool
+  runtime_filter::add_key (DB_VALUE *const *values)
+  {
+    std::uint64_t hash;
+
+    if (!hash_key (values, hash))
+      {
+	return false;
+      }
+
+    m_bloom.add (hash);
+    m_added++;
+
+    return true;
+  }
+
+  bool
+  runtime_filter::may_match (DB_VALUE *const *values)
+  {
+    std::uint64_t hash;
+    std::uint64_t checked;
+
+    if (!m_enabled.load (std::memory_order_relaxed))
+      {
+	return true;
+      }
+
+    checked = m_checked.fetch_add (1, std::memory_order_relaxed) + 1;
+    if (checked == CHECKS_BEFORE_DECISION
+	&& m_filtered.load (std::memory_order_relaxed) * 100 < checked * MIN_FILTERED_PERCENT)
+      {
+	/* not worth checking the other rows */
+	m_enabled.store (false, std::memory_order_relaxed);
+      }
+
+    for (int i = 0; i < m_key_count; i++)
+      {
+	if (values[i] == NULL || DB_IS_NULL (values[i]))
+	  {
+	    /* the join doesn't match null keys */
+	    m_filtered.fetch_add (1, std::memory_order_relaxed);
+	    return false;
+	  }
+      }
+
+    if (!hash_key (values, hash))
+      {
+	/* cannot tell */
+	return true;
+      }
+
+    if (!m_bloom.may_contain (hash))
+      {
+	m_filtered.fetch_add (1, std::memory_order_relaxed);
+	return false;
+      }
+
+    return true;
+  }
+
+  bool
+  runtime_filter::is_enabled () const
+  {
+    return m_enabled.load (std::memory_order_relaxed);
+  }
+
+  std::uint64_t
+  runtime_filter::get_key_count_added () const
+  {
+    return m_added;
+  }
+
+  std::uint64_t
+  runtime_filter::get_checked_count () const
+  {
+    return m_checked.load (std::memory_order_relaxed);
+  }
+
+  std::uint64_t
+  runtime_filter::get_filtered_count () const
+  {
+    return m_filtered.load (std::memory_order_relaxed);
+  }
+} // namespace cubquery
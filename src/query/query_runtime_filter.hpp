@@ -0,0 +1,159 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_runtime_filter - bloom filters on the join keys of a hash join, checked by the block producing its other input
+//
+//  the inputs of a hash join are list files built by two blocks executed one after the other. the keys of the first
+//  input are added to a bloom filter that the second block checks before it outputs a row: a row whose key is not in
+//  the filter cannot match and is dropped before it is written to the list file, hashed and probed. star joins of a
+//  large fact table with a filtered dimension write only the fact rows that may match.
+//
+//  keys are hashed from their native values, so only families of types that compare equal when their native values
+//  are equal are supported: integers (short, integer, bigint), dates, times, timestamps and datetimes. a row whose key
+//  has another type is always kept.
+//
+//  a filter that drops too few of the first rows it checks is switched off, so that a filter on a key that does not
+//  filter costs nothing but the checks of those rows.
+//
+
+#ifndef _QUERY_RUNTIME_FILTER_HPP_
+#define _QUERY_RUNTIME_FILTER_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "dbtype_def.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace cubquery
+{
+  //
+  // bloom_filter
+  //
+  //  description:
+  //    blocked bloom filter: all bits of a key are in the same cache line, so a check reads one cache line.
+  //
+  class bloom_filter
+  {
+    public:
+      explicit bloom_filter (std::size_t expected_keys);
+
+      void add (std::uint64_t hash);
+      bool may_contain (std::uint64_t hash) const;
+
+      std::size_t get_size () const;	// in bytes
+
+    private:
+      static const int BITS_PER_KEY = 10;
+      static const int PROBES = 7;
+      static const std::size_t WORDS_PER_BLOCK = 8;	// 64 bytes
+
+      std::vector<std::uint64_t> m_words;
+      std::size_t m_block_mask;
+  };
+
+  //
+  // runtime_filter
+  //
+  //  description:
+  //    bloom filter on the join keys of the first input of a hash join, checked on the output rows of the block
+  //    producing the second input. it is filled by one thread, then checked by the thread executing the block and by
+  //    the workers of its exchange.
+  //
+  //  how to use:
+  //    if (runtime_filter::is_supported_type (type of each key of first input))
+  //      {
+  //        runtime_filter *filter = new runtime_filter (key_types, key_columns, key_count, row_count);
+  //        // for each row of first input, with no null key
+  //        if (!filter->add_key (key_values))
+  //          {
+  //            // a value doesn't have the type of its key; the filter cannot be used
+  //          }
+  //        // for each row of second input
+  //        if (!filter->may_match (key_values))
+  //          {
+  //            // drop row
+  //          }
+  //      }
+  //
+  class runtime_filter
+  {
+    public:
+      // key_columns are the positions of the keys in the rows of the second input
+      runtime_filter (const DB_TYPE *key_types, const int *key_columns, int key_count, std::size_t expected_keys);
+      runtime_filter (const runtime_filter &) = delete;
+      runtime_filter (runtime_filter &&) = delete;
+
+      ~runtime_filter () = default;
+
+      runtime_filter &operator= (const runtime_filter &) = delete;
+      runtime_filter &operator= (runtime_filter &&) = delete;
+
+      static bool is_supported_type (DB_TYPE type);
+
+      int get_key_count () const;
+      int get_key_column (int key) const;
+
+      // values of the keys of a row of the first input; none is null. false if a value has another family of types
+      // than its key
+      bool add_key (DB_VALUE *const *values);
+      // false if no row of the first input has the key; null keys never match
+      bool may_match (DB_VALUE *const *values);
+      bool is_enabled () const;
+
+      // stats
+      std::uint64_t get_key_count_added () const;
+      std::uint64_t get_checked_count () const;
+      std::uint64_t get_filtered_count () const;
+
+    private:
+      // families of types whose values compare equal when their native values are equal
+      enum key_kind
+      {
+	KIND_NONE,
+	KIND_INTEGER,
+	KIND_DATE,
+	KIND_TIME,
+	KIND_TIMESTAMP,
+	KIND_DATETIME
+      };
+
+      static key_kind get_kind (DB_TYPE type);
+      // false if a value is null or has another family of types than its key
+      bool hash_key (DB_VALUE *const *values, std::uint64_t &hash) const;
+
+      static const std::uint64_t CHECKS_BEFORE_DECISION = 4096;
+      static const int MIN_FILTERED_PERCENT = 10;
+
+      int m_key_count;
+      std::vector<key_kind> m_kinds;	// of the keys of the first input
+      std::vector<int> m_columns;
+      bloom_filter m_bloom;
+      std::uint64_t m_added;
+      std::atomic<std::uint64_t> m_checked;
+      std::atomic<std::uint64_t> m_filtered;
+      std::atomic<bool> m_enabled;
+  };
+} // namespace cubquery
+
+#endif // _QUERY_RUNTIME_FILTER_HPP_
@@ -0,0 +1,1373 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_vector_filter - evaluate the data filter of a heap scan on batches of objects
+//
+
+#include "query_vector_filter.hpp"
+
+#include "dbtype.h"
+#include "language_support.h"
+#include "object_domain.h"
+#include "object_representation.h"
+#include "object_representation_sr.h"
+#include "query_executor.h"
+#include "regu_var.hpp"
+#include "set_object.h"
+#include "string_like.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <numeric>
+
+#include "memory_wrapper.hpp"
+
+namespace cubquery
+{
+  /* records of a batch are copied; big records end the batch early */
+  const std::size_t VECTOR_FILTER_MAX_BATCH_BYTES = 1024 * 1024;
+
+  const std::int64_t VECTOR_FILTER_MSEC_PER_DAY = 86400000;
+
+  static bool
+  vf_is_integer_type (DB_TYPE type)
+  {
+    return type == DB_TYPE_SHORT || type == DB_TYPE_INTEGER || type == DB_TYPE_BIGINT;
+  }
+
+  static bool
+  vf_is_number_type (DB_TYPE type)
+  {
+    return vf_is_integer_type (type) || type == DB_TYPE_DOUBLE;
+  }
+
+  static bool
+  vf_is_date_time_type (DB_TYPE type)
+  {
+    return type == DB_TYPE_DATE || type == DB_TYPE_TIME || type == DB_TYPE_TIMESTAMP || type == DB_TYPE_DATETIME;
+  }
+
+  /* value of an integer or date/time type as a 64-bit integer that orders the same way */
+  static std::int64_t
+  vf_get_int (const DB_VALUE *value)
+  {
+    const DB_DATETIME *datetime;
+
+    switch (DB_VALUE_TYPE (value))
+      {
+      case DB_TYPE_SHORT:
+	return db_get_short (value);
+      case DB_TYPE_INTEGER:
+	return db_get_int (value);
+      case DB_TYPE_BIGINT:
+	return db_get_bigint (value);
+      case DB_TYPE_DATE:
+	return *db_get_date (value);
+      case DB_TYPE_TIME:
+	return *db_get_time (value);
+      case DB_TYPE_TIMESTAMP:
+	return *db_get_timestamp (value);
+      case DB_TYPE_DATETIME:
+	datetime = db_get_datetime (value);
+	return (std::int64_t) datetime->date * VECTOR_FILTER_MSEC_PER_DAY + datetime->time;
+      default:
+	assert (false);
+	return 0;
+      }
+  }
+
+  /* integer arithmetic with the overflow checks of qdata_add_dbval and friends; false if the interpreter would raise
+   * an error */
+  static bool
+  vf_arith_int (OPERATOR_TYPE opcode, DB_TYPE result_type, std::int64_t left, std::int64_t right,
+		std::int64_t &result)
+  {
+    switch (opcode)
+      {
+      case T_ADD:
+	result = (std::int64_t) ((std::uint64_t) left + (std::uint64_t) right);
+	if (OR_CHECK_ADD_OVERFLOW (left, right, result))
+	  {
+	    return false;
+	  }
+	break;
+      case T_SUB:
+	result = (std::int64_t) ((std::uint64_t) left - (std::uint64_t) right);
+	if (OR_CHECK_SUB_UNDERFLOW (left, right, result))
+	  {
+	    return false;
+	  }
+	break;
+      case T_MUL:
+	if (left == DB_BIGINT_MIN || right == DB_BIGINT_MIN)
+	  {
+	    return false;
+	  }
+	result = (std::int64_t) ((std::uint64_t) left * (std::uint64_t) right);
+	if (OR_CHECK_MULT_OVERFLOW (left, right, result))
+	  {
+	    return false;
+	  }
+	break;
+      case T_DIV:
+	if (right == 0 || OR_CHECK_BIGINT_DIV_OVERFLOW (left, right))
+	  {
+	    return false;
+	  }
+	result = left / right;
+	break;
+      default:
+	assert (false);
+	return false;
+      }
+
+    switch (result_type)
+      {
+      case DB_TYPE_SHORT:
+	return !OR_CHECK_SHORT_OVERFLOW (result);
+      case DB_TYPE_INTEGER:
+	return !OR_CHECK_INT_OVERFLOW (result);
+      default:
+	return true;
+      }
+  }
+
+  static bool
+  vf_arith_double (OPERATOR_TYPE opcode, double left, double right, double &result)
+  {
+    switch (opcode)
+      {
+      case T_ADD:
+	result = left + right;
+	break;
+      case T_SUB:
+	result = left - right;
+	break;
+      case T_MUL:
+	result = left * right;
+	break;
+      case T_DIV:
+	if (right == 0)
+	  {
+	    return false;
+	  }
+	result = left / right;
+	break;
+      default:
+	assert (false);
+	return false;
+      }
+
+    return !OR_CHECK_DOUBLE_OVERFLOW (result);
+  }
+
+  //
+  // kernels
+  //
+
+  template <typename T, typename Cmp, typename View>
+  static void
+  vf_select_cmp (const View &left, const View &right, std::vector<int> &selection)
+  {
+    Cmp cmp;
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < selection.size (); i++)
+      {
+	std::size_t row = selection[i];
+	std::size_t l = row * left.step;
+	std::size_t r = row * right.step;
+
+	/* branch-free; the row is kept by moving past it */
+	selection[count] = (int) row;
+	count += (!left.nulls[l] & !right.nulls[r] & cmp (left.values[l], right.values[r]));
+      }
+    selection.resize (count);
+  }
+
+  template <typename T, typename View>
+  static void
+  vf_select_compare (REL_OP op, const View &left, const View &right, std::vector<int> &selection)
+  {
+    switch (op)
+      {
+      case R_EQ:
+	vf_select_cmp<T, std::equal_to<T>> (left, right, selection);
+	break;
+      case R_NE:
+	vf_select_cmp<T, std::not_equal_to<T>> (left, right, selection);
+	break;
+      case R_LT:
+	vf_select_cmp<T, std::less<T>> (left, right, selection);
+	break;
+      case R_LE:
+	vf_select_cmp<T, std::less_equal<T>> (left, right, selection);
+	break;
+      case R_GT:
+	vf_select_cmp<T, std::greater<T>> (left, right, selection);
+	break;
+      case R_GE:
+	vf_select_cmp<T, std::greater_equal<T>> (left, right, selection);
+	break;
+      default:
+	assert (false);
+	selection.clear ();
+	break;
+      }
+  }
+
+  template <typename T, typename View>
+  static void
+  vf_select_in (const View &values, const std::vector<T> &list, std::vector<int> &selection)
+  {
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < selection.size (); i++)
+      {
+	std::size_t row = selection[i];
+	std::size_t v = row * values.step;
+
+	selection[count] = (int) row;
+	count += (!values.nulls[v] && std::binary_search (list.begin (), list.end (), values.values[v]));
+      }
+    selection.resize (count);
+  }
+
+  //
+  // vector_filter
+  //
+
+  vector_filter::vector_filter (int max_rows)
+    : m_max_rows (max_rows)
+    , m_max_bytes (VECTOR_FILTER_MAX_BATCH_BYTES)
+    , m_attr_info (NULL)
+    , m_vd (NULL)
+    , m_columns ()
+    , m_operands ()
+    , m_terms ()
+    , m_root (-1)
+    , m_complete (false)
+    , m_row_count (0)
+    , m_oids (max_rows)
+    , m_record_offsets (max_rows)
+    , m_recdes (max_rows)
+    , m_records ()
+    , m_strings ()
+    , m_row_error (false)
+    , m_evaluated (false)
+    , m_selection ()
+    , m_next_row (0)
+    , m_next_selected (0)
+    , m_batch_count (0)
+    , m_scan_oid (OID_INITIALIZER)
+    , m_scan_ended (false)
+  {
+    assert (max_rows > 0);
+    m_selection.reserve (max_rows);
+  }
+
+  bool
+  vector_filter::compile (const PRED_EXPR *pred_expr, const HEAP_CACHE_ATTRINFO *attr_info, const val_descr *vd)
+  {
+    m_attr_info = attr_info;
+    m_vd = vd;
+    m_columns.clear ();
+    m_operands.clear ();
+    m_terms.clear ();
+    m_complete = true;
+    m_root = -1;
+
+    if (pred_expr == NULL || attr_info == NULL || attr_info->values == NULL)
+      {
+	m_complete = false;
+	return false;
+      }
+
+    m_root = compile_pred (pred_expr);
+    return m_root >= 0;
+  }
+
+  bool
+  vector_filter::is_complete () const
+  {
+    return m_complete;
+  }
+
+  /* returns the term of pred_expr, or -1 if it has no kernel */
+  int
+  vector_filter::compile_pred (const PRED_EXPR *pred_expr)
+  {
+    std::size_t n_columns = m_columns.size ();
+    std::size_t n_operands = m_operands.size ();
+    std::size_t n_terms = m_terms.size ();
+    int lhs, rhs, term_index = -1;
+
+    if (pred_expr == NULL)
+      {
+	m_complete = false;
+	return -1;
+      }
+
+    switch (pred_expr->type)
+      {
+      case T_PRED:
+	if (pred_expr->pe.m_pred.bool_op != B_AND && pred_expr->pe.m_pred.bool_op != B_OR)
+	  {
+	    break;
+	  }
+	lhs = compile_pred (pred_expr->pe.m_pred.lhs);
+	rhs = compile_pred (pred_expr->pe.m_pred.rhs);
+	if (pred_expr->pe.m_pred.bool_op == B_AND)
+	  {
+	    /* terms without kernels are left to the interpreter */
+	    if (lhs < 0 || rhs < 0)
+	      {
+		return lhs < 0 ? rhs : lhs;
+	      }
+	    term_index = add_term (TERM_AND);
+	  }
+	else
+	  {
+	    if (lhs < 0 || rhs < 0)
+	      {
+		/* any row may satisfy the term without kernel */
+		m_columns.resize (n_columns);
+		m_operands.resize (n_operands);
+		m_terms.resize (n_terms);
+		return -1;
+	      }
+	    term_index = add_term (TERM_OR);
+	  }
+	/* flatten chains of the same operator */
+	for (int child : { lhs, rhs })
+	  {
+	    if (m_terms[child].kind == m_terms[term_index].kind)
+	      {
+		m_terms[term_index].children.insert (m_terms[term_index].children.end (),
+						     m_terms[child].children.begin (), m_terms[child].children.end ());
+	      }
+	    else
+	      {
+		m_terms[term_index].children.push_back (child);
+	      }
+	  }
+	return term_index;
+
+      case T_EVAL_TERM:
+	switch (pred_expr->pe.m_eval_term.et_type)
+	  {
+	  case T_COMP_EVAL_TERM:
+	    term_index = compile_comp_term (pred_expr->pe.m_eval_term.et.et_comp);
+	    break;
+	  case T_ALSM_EVAL_TERM:
+	    term_index = compile_alsm_term (pred_expr->pe.m_eval_term.et.et_alsm);
+	    break;
+	  case T_LIKE_EVAL_TERM:
+	    term_index = compile_like_term (pred_expr->pe.m_eval_term.et.et_like);
+	    break;
+	  default:
+	    break;
+	  }
+	break;
+
+      default:
+	/* NOT terms need to tell false from unknown */
+	break;
+      }
+
+    if (term_index < 0)
+      {
+	m_columns.resize (n_columns);
+	m_operands.resize (n_operands);
+	m_terms.resize (n_terms);
+	m_complete = false;
+      }
+    return term_index;
+  }
+
+  int
+  vector_filter::compile_comp_term (const COMP_EVAL_TERM &et_comp)
+  {
+    int term_index, left, right;
+    DB_TYPE left_type, right_type;
+
+    if (et_comp.rel_op == R_NULL)
+      {
+	left = compile_column (et_comp.lhs);
+	if (left < 0)
+	  {
+	    return -1;
+	  }
+	term_index = add_term (TERM_IS_NULL);
+	m_terms[term_index].left = left;
+	return term_index;
+      }
+
+    switch (et_comp.rel_op)
+      {
+      case R_EQ:
+      case R_NE:
+      case R_LT:
+      case R_LE:
+      case R_GT:
+      case R_GE:
+	break;
+      default:
+	return -1;
+      }
+
+    left = compile_operand (et_comp.lhs);
+    right = left < 0 ? -1 : compile_operand (et_comp.rhs);
+    if (right < 0)
+      {
+	return -1;
+      }
+
+    /* numbers are compared with numbers, date/time values with values of the same type */
+    left_type = m_operands[left].type;
+    right_type = m_operands[right].type;
+    if (left_type != DB_TYPE_NULL && right_type != DB_TYPE_NULL && left_type != right_type
+	&& !(vf_is_number_type (left_type) && vf_is_number_type (right_type)))
+      {
+	return -1;
+      }
+
+    term_index = add_term (TERM_COMPARE);
+    m_terms[term_index].op = et_comp.rel_op;
+    m_terms[term_index].left = left;
+    m_terms[term_index].right = right;
+    return term_index;
+  }
+
+  int
+  vector_filter::compile_alsm_term (const ALSM_EVAL_TERM &et_alsm)
+  {
+    const DB_VALUE *set_value;
+    DB_SET *set;
+    DB_VALUE elem;
+    DB_TYPE type, elem_type;
+    int term_index, left, i, size;
+
+    /* only IN lists, i.e. = SOME */
+    if (et_alsm.eq_flag != F_SOME || et_alsm.rel_op != R_EQ)
+      {
+	return -1;
+      }
+
+    left = compile_operand (et_alsm.elem);
+    if (left < 0 || m_operands[left].type == DB_TYPE_NULL)
+      {
+	return -1;
+      }
+    type = m_operands[left].type;
+
+    set_value = get_constant (et_alsm.elemset);
+    if (set_value == NULL || DB_IS_NULL (set_value) || !TP_IS_SET_TYPE (DB_VALUE_TYPE (set_value)))
+      {
+	return -1;
+      }
+    set = db_get_set (set_value);
+
+    term_index = add_term (TERM_IN);
+    term &t = m_terms[term_index];
+    t.left = left;
+    t.in_doubles = m_operands[left].vkind == VF_DOUBLE;
+
+    size = set_size (set);
+    for (i = 0; i < size; i++)
+      {
+	if (set_get_element_nocopy (set, i, &elem) != NO_ERROR)
+	  {
+	    return -1;
+	  }
+	if (DB_IS_NULL (&elem))
+	  {
+	    /* never equal */
+	    continue;
+	  }
+
+	elem_type = DB_VALUE_TYPE (&elem);
+	if (vf_is_number_type (type) && vf_is_number_type (elem_type))
+	  {
+	    if (elem_type == DB_TYPE_DOUBLE)
+	      {
+		t.in_doubles = true;
+		t.double_list.push_back (db_get_double (&elem));
+	      }
+	    else
+	      {
+		t.int_list.push_back (vf_get_int (&elem));
+		t.double_list.push_back ((double) t.int_list.back ());
+	      }
+	  }
+	else if (elem_type == type)
+	  {
+	    t.int_list.push_back (vf_get_int (&elem));
+	  }
+	else
+	  {
+	    return -1;
+	  }
+      }
+
+    if (t.in_doubles)
+      {
+	t.int_list.clear ();
+	std::sort (t.double_list.begin (), t.double_list.end ());
+      }
+    else
+      {
+	t.double_list.clear ();
+	std::sort (t.int_list.begin (), t.int_list.end ());
+      }
+    return term_index;
+  }
+
+  int
+  vector_filter::compile_like_term (const LIKE_EVAL_TERM &et_like)
+  {
+    const DB_VALUE *pattern, *esc_char;
+    const char *pattern_str, *part;
+    int term_index, column, pattern_size, i;
+    char esc = '\\';
+
+    column = compile_column (et_like.src);
+    if (column < 0 || m_columns[column].kind != VF_STRING)
+      {
+	return -1;
+      }
+
+    if (et_like.esc_char != NULL)
+      {
+	esc_char = get_constant (et_like.esc_char);
+	if (esc_char == NULL)
+	  {
+	    return -1;
+	  }
+	if (!DB_IS_NULL (esc_char))
+	  {
+	    if (!TP_IS_CHAR_TYPE (DB_VALUE_TYPE (esc_char)) || db_get_string_size (esc_char) != 1)
+	      {
+		return -1;
+	      }
+	    esc = db_get_string (esc_char)[0];
+	  }
+      }
+
+    pattern = get_constant (et_like.pattern);
+    if (pattern == NULL || DB_IS_NULL (pattern)
+	|| (DB_VALUE_TYPE (pattern) != DB_TYPE_VARCHAR && DB_VALUE_TYPE (pattern) != DB_TYPE_CHAR)
+	|| db_get_string_codeset (pattern) != m_columns[column].codeset)
+      {
+	return -1;
+      }
+    pattern_str = db_get_string (pattern);
+    pattern_size = db_get_string_size (pattern);
+    if (pattern_size > 0 && pattern_str[pattern_size - 1] == ' ')
+      {
+	/* may be padding of a fixed size pattern */
+	return -1;
+      }
+
+    /* '_' matches a character, not a byte; backslash is the escape character unless no_backslash_escapes is set */
+    for (i = 0; i < pattern_size; i++)
+      {
+	if (pattern_str[i] == '_' || pattern_str[i] == '\\' || pattern_str[i] == esc)
+	  {
+	    return -1;
+	  }
+      }
+
+    term_index = add_term (TERM_LIKE);
+    term &t = m_terms[term_index];
+    t.left = column;
+    t.like_prefix = pattern_size == 0 || pattern_str[0] != '%';
+    t.like_suffix = pattern_size == 0 || pattern_str[pattern_size - 1] != '%';
+
+    part = pattern_str;
+    for (i = 0; i <= pattern_size; i++)
+      {
+	if (i == pattern_size || pattern_str[i] == '%')
+	  {
+	    if (pattern_str + i > part)
+	      {
+		t.like_parts.emplace_back (part, pattern_str + i - part);
+	      }
+	    part = pattern_str + i + 1;
+	  }
+      }
+    return term_index;
+  }
+
+  /* returns the numeric or date/time operand of regu, or -1 if it has no kernel */
+  int
+  vector_filter::compile_operand (const regu_variable_node *regu)
+  {
+    const DB_VALUE *value;
+    const ARITH_TYPE *arith;
+    int operand_index, column, left, right;
+    DB_TYPE left_type, right_type, result_type;
+
+    if (regu == NULL)
+      {
+	return -1;
+      }
+
+    switch (regu->type)
+      {
+      case TYPE_ATTR_ID:
+	column = compile_column (regu);
+	if (column < 0 || (m_columns[column].kind != VF_INT && m_columns[column].kind != VF_DOUBLE))
+	  {
+	    return -1;
+	  }
+	operand_index = (int) m_operands.size ();
+	m_operands.emplace_back ();
+	m_operands[operand_index].kind = OPERAND_COLUMN;
+	m_operands[operand_index].type = m_columns[column].type;
+	m_operands[operand_index].vkind = m_columns[column].kind;
+	m_operands[operand_index].column = column;
+	m_operands[operand_index].is_null = 0;
+	if (m_columns[column].kind == VF_INT)
+	  {
+	    /* compared with doubles */
+	    m_operands[operand_index].doubles.resize (m_max_rows);
+	  }
+	return operand_index;
+
+      case TYPE_DBVAL:
+      case TYPE_POS_VALUE:
+	value = get_constant (regu);
+	if (value == NULL)
+	  {
+	    return -1;
+	  }
+	operand_index = (int) m_operands.size ();
+	m_operands.emplace_back ();
+	{
+	  operand &op = m_operands[operand_index];
+
+	  op.kind = OPERAND_CONSTANT;
+	  op.is_null = DB_IS_NULL (value);
+	  op.int_value = 0;
+	  op.double_value = 0;
+	  if (op.is_null)
+	    {
+	      op.type = DB_TYPE_NULL;
+	      op.vkind = VF_INT;
+	    }
+	  else if (DB_VALUE_TYPE (value) == DB_TYPE_DOUBLE)
+	    {
+	      op.type = DB_TYPE_DOUBLE;
+	      op.vkind = VF_DOUBLE;
+	      op.double_value = db_get_double (value);
+	    }
+	  else if (vf_is_integer_type (DB_VALUE_TYPE (value)) || vf_is_date_time_type (DB_VALUE_TYPE (value)))
+	    {
+	      op.type = DB_VALUE_TYPE (value);
+	      op.vkind = VF_INT;
+	      op.int_value = vf_get_int (value);
+	      op.double_value = (double) op.int_value;
+	    }
+	  else
+	    {
+	      m_operands.pop_back ();
+	      return -1;
+	    }
+	}
+	return operand_index;
+
+      case TYPE_INARITH:
+	arith = regu->value.arithptr;
+	if (arith == NULL || arith->domain == NULL
+	    || (arith->opcode != T_ADD && arith->opcode != T_SUB && arith->opcode != T_MUL && arith->opcode != T_DIV))
+	  {
+	    return -1;
+	  }
+	left = compile_operand (arith->leftptr);
+	right = left < 0 ? -1 : compile_operand (arith->rightptr);
+	if (right < 0)
+	  {
+	    return -1;
+	  }
+
+	/* the result has the type of the widest operand; date/time arithmetic is left to the interpreter */
+	left_type = m_operands[left].type == DB_TYPE_NULL ? m_operands[right].type : m_operands[left].type;
+	right_type = m_operands[right].type == DB_TYPE_NULL ? left_type : m_operands[right].type;
+	if (!vf_is_number_type (left_type) || !vf_is_number_type (right_type))
+	  {
+	    return -1;
+	  }
+	if (left_type == DB_TYPE_DOUBLE || right_type == DB_TYPE_DOUBLE)
+	  {
+	    result_type = DB_TYPE_DOUBLE;
+	  }
+	else if (left_type == DB_TYPE_BIGINT || right_type == DB_TYPE_BIGINT)
+	  {
+	    result_type = DB_TYPE_BIGINT;
+	  }
+	else if (left_type == DB_TYPE_INTEGER || right_type == DB_TYPE_INTEGER)
+	  {
+	    result_type = DB_TYPE_INTEGER;
+	  }
+	else
+	  {
+	    result_type = DB_TYPE_SHORT;
+	  }
+	if (TP_DOMAIN_TYPE (arith->domain) != result_type)
+	  {
+	    /* the result is cast by the interpreter */
+	    return -1;
+	  }
+
+	operand_index = (int) m_operands.size ();
+	m_operands.emplace_back ();
+	{
+	  operand &op = m_operands[operand_index];
+
+	  op.kind = OPERAND_ARITH;
+	  op.type = result_type;
+	  op.vkind = result_type == DB_TYPE_DOUBLE ? VF_DOUBLE : VF_INT;
+	  op.is_null = 0;
+	  op.opcode = arith->opcode;
+	  op.left = left;
+	  op.right = right;
+	  op.ints.resize (m_max_rows);
+	  op.doubles.resize (m_max_rows);
+	  op.nulls.resize (m_max_rows);
+	}
+	return operand_index;
+
+      default:
+	return -1;
+      }
+  }
+
+  /* returns the column of the attribute of regu, or -1 if regu is not an attribute of the predicate */
+  int
+  vector_filter::compile_column (const regu_variable_node *regu)
+  {
+    const HEAP_ATTRVALUE *attr_value;
+    ATTR_ID attrid;
+    int i, column;
+
+    if (regu == NULL || regu->type != TYPE_ATTR_ID)
+      {
+	return -1;
+      }
+    attrid = regu->value.attr_descr.id;
+
+    for (column = 0; column < (int) m_columns.size (); column++)
+      {
+	if (m_columns[column].attrid == attrid)
+	  {
+	    return column;
+	  }
+      }
+
+    for (i = 0; i < m_attr_info->num_values; i++)
+      {
+	if (m_attr_info->values[i].attrid == attrid)
+	  {
+	    break;
+	  }
+      }
+    if (i == m_attr_info->num_values)
+      {
+	return -1;
+      }
+    attr_value = &m_attr_info->values[i];
+    if (attr_value->attr_type != HEAP_INSTANCE_ATTR || attr_value->last_attrepr == NULL)
+      {
+	return -1;
+      }
+
+    column = (int) m_columns.size ();
+    m_columns.emplace_back ();
+    column_values &col = m_columns[column];
+    col.attrid = attrid;
+    col.value_index = i;
+    col.type = attr_value->last_attrepr->type;
+    col.codeset = INTL_CODESET_NONE;
+    if (vf_is_integer_type (col.type) || vf_is_date_time_type (col.type))
+      {
+	col.kind = VF_INT;
+	col.ints.resize (m_max_rows);
+      }
+    else if (col.type == DB_TYPE_DOUBLE)
+      {
+	col.kind = VF_DOUBLE;
+	col.doubles.resize (m_max_rows);
+      }
+    else if (col.type == DB_TYPE_VARCHAR && attr_value->last_attrepr->domain != NULL
+	     && (LANG_IS_COERCIBLE_COLL (attr_value->last_attrepr->domain->collation_id)
+		 || attr_value->last_attrepr->domain->collation_id == LANG_COLL_BINARY))
+      {
+	/* only binary collations compare bytes */
+	col.kind = VF_STRING;
+	col.codeset = attr_value->last_attrepr->domain->codeset;
+	col.str_offsets.resize (m_max_rows);
+	col.str_sizes.resize (m_max_rows);
+      }
+    else
+      {
+	col.kind = VF_ANY;
+      }
+    col.nulls.resize (m_max_rows);
+
+    return column;
+  }
+
+  /* constants may also be correlated with outer scans (TYPE_CONSTANT); only those fixed during the scan are used */
+  const DB_VALUE *
+  vector_filter::get_constant (const regu_variable_node *regu) const
+  {
+    if (regu == NULL)
+      {
+	return NULL;
+      }
+
+    switch (regu->type)
+      {
+      case TYPE_DBVAL:
+	return &regu->value.dbval;
+      case TYPE_POS_VALUE:
+	if (m_vd == NULL || regu->value.val_pos < 0 || regu->value.val_pos >= m_vd->dbval_cnt)
+	  {
+	    return NULL;
+	  }
+	return &m_vd->dbval_ptr[regu->value.val_pos];
+      default:
+	return NULL;
+      }
+  }
+
+  int
+  vector_filter::add_term (term_kind kind)
+  {
+    int term_index = (int) m_terms.size ();
+
+    m_terms.emplace_back ();
+    m_terms[term_index].kind = kind;
+    m_terms[term_index].op = R_NONE;
+    m_terms[term_index].left = -1;
+    m_terms[term_index].right = -1;
+    m_terms[term_index].in_doubles = false;
+    m_terms[term_index].like_prefix = false;
+    m_terms[term_index].like_suffix = false;
+    return term_index;
+  }
+
+  void
+  vector_filter::clear ()
+  {
+    m_row_count = 0;
+    m_records.clear ();
+    m_strings.clear ();
+    m_row_error = false;
+    m_evaluated = false;
+    m_selection.clear ();
+    m_next_row = 0;
+    m_next_selected = 0;
+  }
+
+  bool
+  vector_filter::is_full () const
+  {
+    return m_row_count >= m_max_rows || m_records.size () >= m_max_bytes;
+  }
+
+  int
+  vector_filter::get_row_count () const
+  {
+    return m_row_count;
+  }
+
+  RECDES
+  vector_filter::add_row (const OID &oid, const RECDES &recdes)
+  {
+    RECDES copy = recdes;
+    std::size_t offset = m_records.size ();
+
+    assert (m_row_count < m_max_rows);
+
+    m_records.insert (m_records.end (), recdes.data, recdes.data + recdes.length);
+    m_oids[m_row_count] = oid;
+    m_record_offsets[m_row_count] = offset;
+    m_recdes[m_row_count] = recdes;
+    m_row_count++;
+
+    copy.data = m_records.data () + offset;
+    copy.area_size = recdes.length;
+    return copy;
+  }
+
+  void
+  vector_filter::set_row_values (const HEAP_CACHE_ATTRINFO *attr_info)
+  {
+    int row = m_row_count - 1;
+    const DB_VALUE *value;
+    const char *str;
+    int size;
+
+    assert (row >= 0);
+
+    for (column_values &col : m_columns)
+      {
+	value = &attr_info->values[col.value_index].dbvalue;
+	col.nulls[row] = DB_IS_NULL (value);
+	if (col.nulls[row] || col.kind == VF_ANY)
+	  {
+	    continue;
+	  }
+	if (DB_VALUE_TYPE (value) != col.type)
+	  {
+	    /* e.g. the class was altered; the interpreter is used for this batch */
+	    m_row_error = true;
+	    col.nulls[row] = 1;
+	    continue;
+	  }
+
+	switch (col.kind)
+	  {
+	  case VF_INT:
+	    col.ints[row] = vf_get_int (value);
+	    break;
+	  case VF_DOUBLE:
+	    col.doubles[row] = db_get_double (value);
+	    break;
+	  case VF_STRING:
+	    /* the value may be released by the next read */
+	    str = db_get_string (value);
+	    size = db_get_string_size (value);
+	    col.str_offsets[row] = (std::uint32_t) m_strings.size ();
+	    col.str_sizes[row] = (std::uint32_t) size;
+	    m_strings.insert (m_strings.end (), str, str + size);
+	    break;
+	  default:
+	    assert (false);
+	    break;
+	  }
+      }
+  }
+
+  void
+  vector_filter::evaluate ()
+  {
+    m_selection.resize (m_row_count);
+    std::iota (m_selection.begin (), m_selection.end (), 0);
+    m_evaluated = false;
+
+    if (!m_row_error && m_root >= 0)
+      {
+	m_evaluated = eval_term (m_root, m_selection);
+      }
+    if (!m_evaluated)
+      {
+	m_selection.clear ();
+      }
+
+    m_next_row = 0;
+    m_next_selected = 0;
+    m_batch_count++;
+  }
+
+  bool
+  vector_filter::next_row (bool selected_only, OID &oid, RECDES &recdes, bool &is_qualified, int &skipped)
+  {
+    int row;
+
+    skipped = 0;
+
+    /* the selection is a sorted list of rows */
+    while (m_next_selected < m_selection.size () && m_selection[m_next_selected] < m_next_row)
+      {
+	m_next_selected++;
+      }
+
+    if (selected_only && m_evaluated)
+      {
+	if (m_next_selected >= m_selection.size ())
+	  {
+	    skipped = m_row_count - m_next_row;
+	    m_next_row = m_row_count;
+	    return false;
+	  }
+	row = m_selection[m_next_selected++];
+	skipped = row - m_next_row;
+	is_qualified = m_complete;
+      }
+    else
+      {
+	if (m_next_row >= m_row_count)
+	  {
+	    return false;
+	  }
+	row = m_next_row;
+	is_qualified = (m_complete && m_next_selected < m_selection.size () && m_selection[m_next_selected] == row);
+      }
+    m_next_row = row + 1;
+
+    oid = m_oids[row];
+    recdes = m_recdes[row];
+    recdes.data = m_records.data () + m_record_offsets[row];
+    recdes.area_size = recdes.length;
+    return true;
+  }
+
+  OID &
+  vector_filter::get_scan_oid ()
+  {
+    return m_scan_oid;
+  }
+
+  bool
+  vector_filter::is_scan_ended () const
+  {
+    return m_scan_ended;
+  }
+
+  void
+  vector_filter::set_scan_ended ()
+  {
+    m_scan_ended = true;
+  }
+
+  void
+  vector_filter::reset_scan ()
+  {
+    clear ();
+    OID_SET_NULL (&m_scan_oid);
+    m_scan_ended = false;
+  }
+
+  int
+  vector_filter::get_batch_count () const
+  {
+    return m_batch_count;
+  }
+
+  /* narrows selection to the rows for which the term is true; false if the interpreter must evaluate the batch */
+  bool
+  vector_filter::eval_term (int term_index, std::vector<int> &selection)
+  {
+    const term &t = m_terms[term_index];
+
+    switch (t.kind)
+      {
+      case TERM_AND:
+	for (int child : t.children)
+	  {
+	    if (selection.empty ())
+	      {
+		break;
+	      }
+	    if (!eval_term (child, selection))
+	      {
+		return false;
+	      }
+	  }
+	return true;
+
+      case TERM_OR:
+      {
+	/* each term is evaluated for the rows the previous terms are not true for */
+	std::vector<int> remaining (selection);
+	std::vector<int> child_selection;
+	std::vector<int> rest;
+
+	selection.clear ();
+	for (int child : t.children)
+	  {
+	    if (remaining.empty ())
+	      {
+		break;
+	      }
+	    child_selection = remaining;
+	    if (!eval_term (child, child_selection))
+	      {
+		return false;
+	      }
+	    rest.clear ();
+	    std::set_difference (remaining.begin (), remaining.end (), child_selection.begin (), child_selection.end (),
+				 std::back_inserter (rest));
+	    remaining.swap (rest);
+	    selection.insert (selection.end (), child_selection.begin (), child_selection.end ());
+	  }
+	std::sort (selection.begin (), selection.end ());
+	return true;
+      }
+
+      case TERM_COMPARE:
+	return eval_compare (t, selection);
+
+      case TERM_IN:
+	return eval_in (t, selection);
+
+      case TERM_LIKE:
+	eval_like (t, selection);
+	return true;
+
+      case TERM_IS_NULL:
+	eval_is_null (t, selection);
+	return true;
+
+      default:
+	assert (false);
+	return false;
+      }
+  }
+
+  /* computes the results of arithmetic operands for the selected rows */
+  bool
+  vector_filter::eval_operand (int operand_index, const std::vector<int> &selection)
+  {
+    operand &op = m_operands[operand_index];
+
+    if (op.kind != OPERAND_ARITH)
+      {
+	return true;
+      }
+    if (!eval_operand (op.left, selection) || !eval_operand (op.right, selection))
+      {
+	return false;
+      }
+
+    if (op.vkind == VF_INT)
+      {
+	vector_view<std::int64_t> left = get_int_view (op.left);
+	vector_view<std::int64_t> right = get_int_view (op.right);
+
+	for (int row : selection)
+	  {
+	    std::size_t l = row * left.step;
+	    std::size_t r = row * right.step;
+
+	    op.nulls[row] = left.nulls[l] | right.nulls[r];
+	    if (!op.nulls[row] && !vf_arith_int (op.opcode, op.type, left.values[l], right.values[r], op.ints[row]))
+	      {
+		return false;
+	      }
+	  }
+      }
+    else
+      {
+	vector_view<double> left = get_double_view (op.left, selection);
+	vector_view<double> right = get_double_view (op.right, selection);
+
+	for (int row : selection)
+	  {
+	    std::size_t l = row * left.step;
+	    std::size_t r = row * right.step;
+
+	    op.nulls[row] = left.nulls[l] | right.nulls[r];
+	    if (!op.nulls[row] && !vf_arith_double (op.opcode, left.values[l], right.values[r], op.doubles[row]))
+	      {
+		return false;
+	      }
+	  }
+      }
+    return true;
+  }
+
+  vector_filter::vector_view<std::int64_t>
+  vector_filter::get_int_view (int operand_index)
+  {
+    const operand &op = m_operands[operand_index];
+
+    assert (op.vkind == VF_INT);
+
+    switch (op.kind)
+      {
+      case OPERAND_COLUMN:
+	return { m_columns[op.column].ints.data (), m_columns[op.column].nulls.data (), 1 };
+      case OPERAND_CONSTANT:
+	return { &op.int_value, &op.is_null, 0 };
+      case OPERAND_ARITH:
+      default:
+	return { op.ints.data (), op.nulls.data (), 1 };
+      }
+  }
+
+  vector_filter::vector_view<double>
+  vector_filter::get_double_view (int operand_index, const std::vector<int> &selection)
+  {
+    operand &op = m_operands[operand_index];
+    const std::int64_t *ints;
+
+    switch (op.kind)
+      {
+      case OPERAND_COLUMN:
+	if (op.vkind == VF_DOUBLE)
+	  {
+	    return { m_columns[op.column].doubles.data (), m_columns[op.column].nulls.data (), 1 };
+	  }
+	ints = m_columns[op.column].ints.data ();
+	for (int row : selection)
+	  {
+	    op.doubles[row] = (double) ints[row];
+	  }
+	return { op.doubles.data (), m_columns[op.column].nulls.data (), 1 };
+      case OPERAND_CONSTANT:
+	return { &op.double_value, &op.is_null, 0 };
+      case OPERAND_ARITH:
+      default:
+	if (op.vkind == VF_INT)
+	  {
+	    for (int row : selection)
+	      {
+		op.doubles[row] = (double) op.ints[row];
+	      }
+	  }
+	return { op.doubles.data (), op.nulls.data (), 1 };
+      }
+  }
+
+  bool
+  vector_filter::eval_compare (const term &t, std::vector<int> &selection)
+  {
+    if (!eval_operand (t.left, selection) || !eval_operand (t.right, selection))
+      {
+	return false;
+      }
+
+    if (m_operands[t.left].vkind == VF_INT && m_operands[t.right].vkind == VF_INT)
+      {
+	vf_select_compare<std::int64_t> (t.op, get_int_view (t.left), get_int_view (t.right), selection);
+      }
+    else
+      {
+	vector_view<double> left = get_double_view (t.left, selection);
+	vector_view<double> right = get_double_view (t.right, selection);
+
+	vf_select_compare<double> (t.op, left, right, selection);
+      }
+    return true;
+  }
+
+  bool
+  vector_filter::eval_in (const term &t, std::vector<int> &selection)
+  {
+    if (!eval_operand (t.left, selection))
+      {
+	return false;
+      }
+
+    if (t.in_doubles)
+      {
+	vf_select_in (get_double_view (t.left, selection), t.double_list, selection);
+      }
+    else
+      {
+	vf_select_in (get_int_view (t.left), t.int_list, selection);
+      }
+    return true;
+  }
+
+  void
+  vector_filter::eval_like (const term &t, std::vector<int> &selection)
+  {
+    const column_values &col = m_columns[t.left];
+    const char *strings = m_strings.data ();
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < selection.size (); i++)
+      {
+	int row = selection[i];
+
+	selection[count] = row;
+	count += (!col.nulls[row] && like_match (strings + col.str_offsets[row], col.str_sizes[row], t));
+      }
+    selection.resize (count);
+  }
+
+  void
+  vector_filter::eval_is_null (const term &t, std::vector<int> &selection)
+  {
+    const unsigned char *nulls = m_columns[t.left].nulls.data ();
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < selection.size (); i++)
+      {
+	int row = selection[i];
+
+	selection[count] = row;
+	count += nulls[row];
+      }
+    selection.resize (count);
+  }
+
+  bool
+  vector_filter::like_match (const char *str, std::size_t size, const term &t) const
+  {
+    const char *end = str + size;
+    std::size_t first = 0, last = t.like_parts.size ();
+
+    if (t.like_parts.empty ())
+      {
+	/* '' or only '%' */
+	return !(t.like_prefix && t.like_suffix) || size == 0;
+      }
+
+    if (t.like_prefix)
+      {
+	const std::string &part = t.like_parts.front ();
+
+	if ((std::size_t) (end - str) < part.size () || std::memcmp (str, part.data (), part.size ()) != 0)
+	  {
+	    return false;
+	  }
+	str += part.size ();
+	first++;
+	if (t.like_suffix && last == 1)
+	  {
+	    /* no '%' */
+	    return str == end;
+	  }
+      }
+
+    if (t.like_suffix)
+      {
+	const std::string &part = t.like_parts.back ();
+
+	if ((std::size_t) (end - str) < part.size ()
+	    || std::memcmp (end - part.size (), part.data (), part.size ()) != 0)
+	  {
+	    return false;
+	  }
+	end -= part.size ();
+	last--;
+      }
+
+    for (std::size_t i = first; i < last; i++)
+      {
+	const std::string &part = t.like_parts[i];
+
+	str = cublike::find_substring (str, end - str, part.data (), part.size ());
+	if (str == NULL)
+	  {
+	    return false;
+	  }
+	str += part.size ();
+      }
+    return true;
+  }
+} // namespace cubquery
@@ -0,0 +1,259 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// query_vector_filter - evaluate the data filter of a heap scan on batches of objects
+//
+//  instead of interpreting the predicate tree for each object, a heap scan can read a batch of objects (up to
+//  vector_scan_batch_size) and evaluate the predicate for all of them at once. the values of the attributes used by
+//  the predicate are copied to column vectors of native types (64-bit integers, doubles or strings) with null masks,
+//  and each term of the predicate is evaluated by a kernel that loops over the columns and narrows a selection
+//  vector, i.e. the rows of the batch for which all terms evaluated so far are true.
+//
+//  kernels exist for comparisons, IN lists of constants, IS NULL and LIKE patterns without single character
+//  wildcards. their operands are attributes, constants, host variables and the arithmetic (+, -, *, /) of those. the
+//  terms of a conjunction that have no kernel are left to the tuple interpreter (eval_pred), which is then called
+//  only for the rows selected by the kernels; a disjunction gets a kernel only if each of its terms has one.
+//
+//  the kernels only decide which rows the predicate is true for. scans that must tell false from unknown (e.g. outer
+//  joins) still evaluate the predicate of each row with the interpreter. the interpreter is also used for a whole
+//  batch when a kernel meets an error the interpreter must report (overflow, division by zero).
+//
+
+#ifndef _QUERY_VECTOR_FILTER_HPP_
+#define _QUERY_VECTOR_FILTER_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "dbtype_def.h"
+#include "heap_attrinfo.h"
+#include "storage_common.h"
+#include "xasl_predicate.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// forward definitions
+class regu_variable_node;
+struct val_descr;
+
+namespace cubquery
+{
+  //
+  // vector_filter
+  //
+  //  description:
+  //    the kernels of a scan predicate and the batch of objects they are evaluated on. the objects of the batch are
+  //    copied, so they stay valid until the batch is cleared, after the page they were read from is released.
+  //
+  //  how to use:
+  //    vector_filter *filter = new vector_filter (max_rows);
+  //    if (!filter->compile (pred_expr, attr_info, vd))
+  //      {
+  //        // no kernels, use the interpreter
+  //      }
+  //    filter->clear ();
+  //    while (!filter->is_full () && /* next object */)
+  //      {
+  //        RECDES copy = filter->add_row (oid, recdes);
+  //        // read attributes of copy into attr_info
+  //        filter->set_row_values (attr_info);
+  //      }
+  //    filter->evaluate ();
+  //    while (filter->next_row (true, oid, recdes, is_qualified, skipped))
+  //      {
+  //        // if !is_qualified, evaluate the predicate with the interpreter
+  //      }
+  //
+  class vector_filter
+  {
+    public:
+      vector_filter (int max_rows);
+      vector_filter (const vector_filter &) = delete;
+      vector_filter (vector_filter &&) = delete;
+
+      ~vector_filter () = default;
+
+      vector_filter &operator= (const vector_filter &) = delete;
+      vector_filter &operator= (vector_filter &&) = delete;
+
+      // create the kernels of pred_expr; the attributes of the predicate are described by attr_info. returns false if
+      // no term of the predicate has a kernel
+      bool compile (const PRED_EXPR *pred_expr, const HEAP_CACHE_ATTRINFO *attr_info, const val_descr *vd);
+      // true if the kernels evaluate the whole predicate
+      bool is_complete () const;
+
+      // batch
+      void clear ();
+      bool is_full () const;
+      int get_row_count () const;
+      RECDES add_row (const OID &oid, const RECDES &recdes);
+      // copy the values of the predicate attributes of the last added row; attr_info was read from its record
+      void set_row_values (const HEAP_CACHE_ATTRINFO *attr_info);
+      void evaluate ();
+      // next row of the batch. with selected_only, rows that the kernels rejected are skipped and counted in skipped.
+      // is_qualified is true if the kernels proved the whole predicate true for the row
+      bool next_row (bool selected_only, OID &oid, RECDES &recdes, bool &is_qualified, int &skipped);
+
+      // position of the heap scan that fills the batches
+      OID &get_scan_oid ();
+      bool is_scan_ended () const;
+      void set_scan_ended ();
+      void reset_scan ();
+
+      // stats
+      int get_batch_count () const;
+
+    private:
+      enum value_kind
+      {
+	VF_INT,			// 64-bit integer: integer types and date/time types
+	VF_DOUBLE,
+	VF_STRING,		// only for LIKE
+	VF_ANY			// only for IS NULL
+      };
+
+      // the values of an attribute in the batch
+      struct column_values
+      {
+	ATTR_ID attrid;
+	int value_index;	// index of attribute in attr_info values
+	DB_TYPE type;
+	value_kind kind;
+	int codeset;		// VF_STRING
+	std::vector<std::int64_t> ints;
+	std::vector<double> doubles;
+	std::vector<std::uint32_t> str_offsets;	// in m_strings
+	std::vector<std::uint32_t> str_sizes;
+	std::vector<unsigned char> nulls;
+      };
+
+      enum operand_kind
+      {
+	OPERAND_COLUMN,
+	OPERAND_CONSTANT,
+	OPERAND_ARITH
+      };
+
+      // an expression evaluated for all the selected rows of the batch
+      struct operand
+      {
+	operand_kind kind;
+	DB_TYPE type;		// DB_TYPE_NULL for a null constant
+	value_kind vkind;
+	int column;		// OPERAND_COLUMN
+	std::int64_t int_value;	// OPERAND_CONSTANT
+	double double_value;
+	unsigned char is_null;
+	OPERATOR_TYPE opcode;	// OPERAND_ARITH
+	int left;
+	int right;
+	std::vector<std::int64_t> ints;	// results of OPERAND_ARITH, by row
+	std::vector<double> doubles;
+	std::vector<unsigned char> nulls;
+      };
+
+      enum term_kind
+      {
+	TERM_AND,
+	TERM_OR,
+	TERM_COMPARE,
+	TERM_IS_NULL,
+	TERM_IN,
+	TERM_LIKE
+      };
+
+      struct term
+      {
+	term_kind kind;
+	std::vector<int> children;	// TERM_AND, TERM_OR
+	REL_OP op;		// TERM_COMPARE
+	int left;		// operand; for TERM_IS_NULL and TERM_LIKE, column
+	int right;
+	std::vector<std::int64_t> int_list;	// TERM_IN, sorted
+	std::vector<double> double_list;	// TERM_IN, sorted; used instead of int_list if in_doubles
+	bool in_doubles;
+	std::vector<std::string> like_parts;	// TERM_LIKE, literals between '%'
+	bool like_prefix;	// pattern doesn't start with '%'
+	bool like_suffix;	// pattern doesn't end with '%'
+      };
+
+      // values of an operand for the rows of a batch; constants have a single value
+      template <typename T>
+      struct vector_view
+      {
+	const T *values;
+	const unsigned char *nulls;
+	std::size_t step;	// 0 for constants, 1 for vectors
+      };
+
+      int compile_pred (const PRED_EXPR *pred_expr);
+      int compile_comp_term (const COMP_EVAL_TERM &et_comp);
+      int compile_alsm_term (const ALSM_EVAL_TERM &et_alsm);
+      int compile_like_term (const LIKE_EVAL_TERM &et_like);
+      int compile_operand (const regu_variable_node *regu);
+      int compile_column (const regu_variable_node *regu);
+      const DB_VALUE *get_constant (const regu_variable_node *regu) const;
+      int add_term (term_kind kind);
+
+      bool eval_term (int term_index, std::vector<int> &selection);
+      bool eval_operand (int operand_index, const std::vector<int> &selection);
+      vector_view<std::int64_t> get_int_view (int operand_index);
+      vector_view<double> get_double_view (int operand_index, const std::vector<int> &selection);
+      bool eval_compare (const term &t, std::vector<int> &selection);
+      bool eval_in (const term &t, std::vector<int> &selection);
+      void eval_like (const term &t, std::vector<int> &selection);
+      void eval_is_null (const term &t, std::vector<int> &selection);
+      bool like_match (const char *str, std::size_t size, const term &t) const;
+
+      int m_max_rows;
+      std::size_t m_max_bytes;
+
+      // kernels
+      const HEAP_CACHE_ATTRINFO *m_attr_info;
+      const val_descr *m_vd;
+      std::vector<column_values> m_columns;
+      std::vector<operand> m_operands;
+      std::vector<term> m_terms;
+      int m_root;
+      bool m_complete;
+
+      // batch
+      int m_row_count;
+      std::vector<OID> m_oids;
+      std::vector<std::size_t> m_record_offsets;	// in m_records
+      std::vector<RECDES> m_recdes;
+      std::vector<char> m_records;
+      std::vector<char> m_strings;
+      bool m_row_error;		// a value could not be stored in its column
+      bool m_evaluated;		// selection was computed by kernels
+      std::vector<int> m_selection;
+      int m_next_row;		// next row of the batch
+      std::size_t m_next_selected;	// next position of m_selection
+      int m_batch_count;
+
+      // scan position
+      OID m_scan_oid;
+      bool m_scan_ended;
+  };
+} // namespace cubquery
+
+#endif // _QUERY_VECTOR_FILTER_HPP_
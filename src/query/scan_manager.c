@@ -39,6 +39,7 @@
 #include "perf_monitor.h"
 #include "query_manager.h"
 #include "query_evaluator.h"
+#include "query_executor.h"
 #include "query_opfunc.h"
 #include "query_reevaluation.hpp"
 #include "regu_var.hpp"
@@ -51,6 +52,9 @@
 #include "xasl.h"
 #include "query_hash_scan.h"
 #include "statistics.h"
+#include "parallel_heap_scan.hpp"
+#include "query_vector_filter.hpp"
+#include "query_adaptive_join.hpp"
 // XXX: SHOULD BE THE LAST INCLUDE HEADER
 #include "memory_wrapper.hpp"
 
@@ -174,6 +178,19 @@ static int scan_init_index_key_limit (THREAD_ENTRY * thread_p, INDX_SCAN_ID * is
 				      VAL_DESCR * vd);
 static SCAN_CODE scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static OR_ATTRIBUTE *scan_get_heap_zone_attr (SCAN_ATTRS * pred_attrs, ATTR_ID attrid);
+static const DB_VALUE *scan_get_heap_zone_value (REGU_VARIABLE * regu, VAL_DESCR * vd);
+static void scan_get_heap_zone_bounds (PRED_EXPR * pred_expr, SCAN_ATTRS * pred_attrs, VAL_DESCR * vd,
+				       HEAP_ZONE_BOUND * bounds, int *n_bounds);
+static int scan_start_heap_zone_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, MVCC_SNAPSHOT * mvcc_snapshot);
+static SCAN_CODE scan_next_heap_px_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes,
+					  int is_peeking);
+static SCAN_CODE scan_next_heap_zone_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes,
+					   int is_peeking);
+static void scan_start_heap_vector_filter (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static SCAN_CODE scan_fill_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static SCAN_CODE scan_next_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes,
+				       bool * is_qualified);
 static SCAN_CODE scan_next_heap_page_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_class_attr_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
@@ -181,6 +198,9 @@ static SCAN_CODE scan_next_index_key_info_scan (THREAD_ENTRY * thread_p, SCAN_ID
 static SCAN_CODE scan_next_index_node_info_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_index_lookup_heap (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, INDX_SCAN_ID * isidp,
 					      FILTER_INFO * data_filter, TRAN_ISOLATION isolation);
+static int scan_probe_adaptive_join (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static SCAN_CODE scan_next_index_hash_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
+static void scan_set_adaptive_join_stats (SCAN_ID * scan_id);
 static SCAN_CODE scan_next_list_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_showstmt_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
 static SCAN_CODE scan_next_set_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id);
@@ -304,6 +324,7 @@ scan_init_index_scan (INDX_SCAN_ID * isidp, struct btree_iscan_oid_list *oid_lis
   isidp->need_count_only = false;
   isidp->check_not_vacuumed = false;
   isidp->not_vacuumed_res = DISK_VALID;
+  isidp->adaptive_join = NULL;
 }
 
 /*
@@ -2868,6 +2889,17 @@ scan_open_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
   hsidp->cache_recordinfo = cache_recordinfo;
   hsidp->recordinfo_regu_list = regu_list_recordinfo;
 
+  hsidp->zone_scan = NULL;
+  VPID_SET_NULL (&hsidp->zone_vpid);
+
+  hsidp->px_scan = NULL;
+  hsidp->px_page = 0;
+  hsidp->px_last_page = 0;
+  VPID_SET_NULL (&hsidp->px_vpid);
+  hsidp->px_num_pages = 0;
+
+  hsidp->vector_filter = NULL;
+
   /* for scampling statistics. */
   if (scan_type == S_HEAP_SAMPLING_SCAN && !is_partition_table)
     {
@@ -3107,6 +3139,7 @@ scan_open_index_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id,
   isidp->copy_buf = NULL;
   isidp->copy_buf_len = 0;
   isidp->key_vals = NULL;
+  isidp->adaptive_join = NULL;
 
   isidp->indx_cov.type_list = NULL;
   isidp->indx_cov.list_id = indx_info->cov_list_id;
@@ -4127,6 +4160,13 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	      goto exit_on_error;
 	    }
 	  hsidp->scancache_inited = true;
+
+	  if (scan_id->type == S_HEAP_SCAN && scan_id->scan_op_type == S_SELECT && !scan_id->mvcc_select_lock_needed)
+	    {
+	      /* records are only used to read the scan attributes; big records don't need to be copied entirely */
+	      heap_scancache_set_ovf_attrinfos (&hsidp->scan_cache, hsidp->pred_attrs.attr_cache,
+						hsidp->rest_attrs.attr_cache);
+	    }
 	}
       if (hsidp->caches_inited != true)
 	{
@@ -4157,6 +4197,25 @@ scan_start_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	    }
 	  hsidp->caches_inited = true;
 	}
+
+      if (scan_id->type == S_HEAP_SCAN && !scan_id->grouped && scan_id->scan_op_type == S_SELECT
+	  && hsidp->px_scan == NULL && !scan_id->mvcc_select_lock_needed && mvcc_snapshot != NULL && hsidp->scan_pred.pred_expr != NULL
+	  && prm_get_integer_value (PRM_ID_HEAP_ZONE_MAP_PAGES) > 0 && !mvcc_is_mvcc_disabled_class (&hsidp->cls_oid))
+	{
+	  ret = scan_start_heap_zone_scan (thread_p, scan_id, mvcc_snapshot);
+	  if (ret != NO_ERROR)
+	    {
+	      goto exit_on_error;
+	    }
+	}
+
+      if (scan_id->type == S_HEAP_SCAN && !scan_id->grouped && scan_id->scan_op_type == S_SELECT
+	  && scan_id->direction == S_FORWARD && !scan_id->mvcc_select_lock_needed
+	  && hsidp->scan_pred.pred_expr != NULL && prm_get_integer_value (PRM_ID_VECTOR_SCAN_BATCH_SIZE) > 0
+	  && !mvcc_is_mvcc_disabled_class (&hsidp->cls_oid))
+	{
+	  scan_start_heap_vector_filter (thread_p, scan_id);
+	}
       break;
 
     case S_HEAP_PAGE_SCAN:
@@ -4400,6 +4459,15 @@ scan_reset_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
 	{
 	  s_id->position = (s_id->direction == S_FORWARD) ? S_BEFORE : S_AFTER;
 	  OID_SET_NULL (&s_id->s.hsid.curr_oid);
+	  if (s_id->s.hsid.zone_scan != NULL)
+	    {
+	      heap_zone_scan_reset (s_id->s.hsid.zone_scan, s_id->direction == S_FORWARD);
+	      VPID_SET_NULL (&s_id->s.hsid.zone_vpid);
+	    }
+	  if (s_id->s.hsid.vector_filter != NULL)
+	    {
+	      s_id->s.hsid.vector_filter->reset_scan ();
+	    }
 	}
       break;
 
@@ -4469,6 +4537,12 @@ scan_reset_scan_block (THREAD_ENTRY * thread_p, SCAN_ID * s_id)
 		  status = S_ERROR;
 		}
 	    }
+
+	  /* count the outer row of the adaptive join */
+	  if (s_id->s.isid.adaptive_join != NULL && scan_probe_adaptive_join (thread_p, s_id) != NO_ERROR)
+	    {
+	      status = S_ERROR;
+	    }
 	}
       break;
 
@@ -4708,6 +4782,19 @@ scan_end_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	    }
 	}
 
+      if (hsidp->zone_scan != NULL)
+	{
+	  heap_zone_scan_destroy (thread_p, hsidp->zone_scan);
+	  hsidp->zone_scan = NULL;
+	}
+
+      if (hsidp->vector_filter != NULL)
+	{
+	  scan_id->scan_stats.vector_batches += hsidp->vector_filter->get_batch_count ();
+	  delete hsidp->vector_filter;
+	  hsidp->vector_filter = NULL;
+	}
+
       /* switch scan direction for further iterations */
       if (scan_id->direction == S_FORWARD)
 	{
@@ -4908,6 +4995,14 @@ scan_close_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
 	}
       memset ((void *) (&(isidp->multi_range_opt)), 0, sizeof (MULTI_RANGE_OPT));
       btree_range_scan_free_matched_idx (&isidp->bt_scan);
+
+      /* free the hash table of the adaptive join */
+      if (isidp->adaptive_join != NULL)
+	{
+	  isidp->adaptive_join->clear (thread_p);
+	  delete isidp->adaptive_join;
+	  isidp->adaptive_join = NULL;
+	}
       break;
 
     case S_LIST_SCAN:
@@ -5120,7 +5215,14 @@ scan_next_scan_local (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
       break;
 
     case S_INDX_SCAN:
-      status = scan_next_index_scan (thread_p, scan_id);
+      if (scan_id->s.isid.adaptive_join != NULL && scan_id->s.isid.adaptive_join->is_hashed ())
+	{
+	  status = scan_next_index_hash_scan (thread_p, scan_id);
+	}
+      else
+	{
+	  status = scan_next_index_scan (thread_p, scan_id);
+	}
       break;
 
     case S_INDX_KEY_INFO_SCAN:
@@ -5190,6 +5292,507 @@ typedef enum
   OBJ_REPEAT_GET_WITH_LOCK = 1,
   OBJ_GET_WITH_LOCK_COMPLETE = 2
 } OBJECT_GET_STATUS;
+
+/*
+ * scan_get_heap_zone_attr () - the representation of an attribute read by a heap scan predicate
+ *   return: attribute representation, NULL if not found
+ *   pred_attrs(in): Attributes read by the predicate
+ *   attrid(in): Attribute identifier
+ */
+static OR_ATTRIBUTE *
+scan_get_heap_zone_attr (SCAN_ATTRS * pred_attrs, ATTR_ID attrid)
+{
+  HEAP_CACHE_ATTRINFO *attr_info;
+  int i;
+
+  attr_info = pred_attrs->attr_cache;
+  if (attr_info == NULL || attr_info->values == NULL)
+    {
+      return NULL;
+    }
+  for (i = 0; i < attr_info->num_values; i++)
+    {
+      if (attr_info->values[i].attrid == attrid)
+	{
+	  break;
+	}
+    }
+  if (i == attr_info->num_values || attr_info->values[i].attr_type != HEAP_INSTANCE_ATTR)
+    {
+      return NULL;
+    }
+  return attr_info->values[i].last_attrepr;
+}
+
+/*
+ * scan_get_heap_zone_value () - the value of a constant or host variable operand
+ *   return: value, NULL if the operand is neither
+ *   regu(in): Operand
+ *   vd(in): Value descriptor (for positional values)
+ */
+static const DB_VALUE *
+scan_get_heap_zone_value (REGU_VARIABLE * regu, VAL_DESCR * vd)
+{
+  if (regu == NULL)
+    {
+      return NULL;
+    }
+  switch (regu->type)
+    {
+    case TYPE_DBVAL:
+      return &regu->value.dbval;
+    case TYPE_POS_VALUE:
+      if (vd == NULL || regu->value.val_pos < 0 || regu->value.val_pos >= vd->dbval_cnt)
+	{
+	  return NULL;
+	}
+      return &vd->dbval_ptr[regu->value.val_pos];
+    default:
+      /* constants may be correlated with outer scans and change during the scan */
+      return NULL;
+    }
+}
+
+/*
+ * scan_get_heap_zone_bounds () - collect the terms of a heap scan predicate that can be checked against zone maps
+ *   return: void
+ *   pred_expr(in): Predicate expression
+ *   pred_attrs(in): Attributes read by the predicate
+ *   vd(in): Value descriptor (for positional values)
+ *   bounds(out): Terms found
+ *   n_bounds(in/out): Number of terms found
+ *
+ * Note: Only conjunctions of comparisons between an attribute and a constant or a host variable are considered, and
+ *       LIKE and REGEXP between a string attribute and a constant or host variable pattern. LIKE is considered only
+ *       with binary collations and a pattern in the codeset of the attribute; the trigrams of the zones are bytes.
+ */
+static void
+scan_get_heap_zone_bounds (PRED_EXPR * pred_expr, SCAN_ATTRS * pred_attrs, VAL_DESCR * vd, HEAP_ZONE_BOUND * bounds,
+			   int *n_bounds)
+{
+  COMP_EVAL_TERM *et_comp;
+  LIKE_EVAL_TERM *et_like;
+  RLIKE_EVAL_TERM *et_rlike;
+  REGU_VARIABLE *attr_regu, *value_regu;
+  HEAP_ZONE_BOUND *bound;
+  OR_ATTRIBUTE *attr;
+  const DB_VALUE *case_sensitive;
+  int pattern_coll;
+  bool mirror = false;
+
+  if (pred_expr == NULL || *n_bounds >= HEAP_ZONE_MAP_MAX_ATTRS * 2)
+    {
+      return;
+    }
+
+  if (pred_expr->type == T_PRED)
+    {
+      if (pred_expr->pe.m_pred.bool_op == B_AND)
+	{
+	  scan_get_heap_zone_bounds (pred_expr->pe.m_pred.lhs, pred_attrs, vd, bounds, n_bounds);
+	  scan_get_heap_zone_bounds (pred_expr->pe.m_pred.rhs, pred_attrs, vd, bounds, n_bounds);
+	}
+      return;
+    }
+
+  if (pred_expr->type != T_EVAL_TERM)
+    {
+      return;
+    }
+
+  bound = &bounds[*n_bounds];
+  bound->value = NULL;
+  bound->escape = NULL;
+  bound->is_case_sensitive = false;
+
+  if (pred_expr->pe.m_eval_term.et_type == T_LIKE_EVAL_TERM)
+    {
+      et_like = &pred_expr->pe.m_eval_term.et.et_like;
+      if (et_like->src == NULL || et_like->src->type != TYPE_ATTR_ID)
+	{
+	  return;
+	}
+      bound->attrid = et_like->src->value.attr_descr.id;
+      attr = scan_get_heap_zone_attr (pred_attrs, bound->attrid);
+      bound->value = scan_get_heap_zone_value (et_like->pattern, vd);
+      if (attr == NULL || attr->domain == NULL || bound->value == NULL || !TP_IS_CHAR_TYPE (attr->type)
+	  || !TP_IS_CHAR_TYPE (DB_VALUE_TYPE (bound->value)))
+	{
+	  return;
+	}
+      if (et_like->esc_char != NULL)
+	{
+	  bound->escape = scan_get_heap_zone_value (et_like->esc_char, vd);
+	  if (bound->escape == NULL)
+	    {
+	      return;
+	    }
+	}
+
+      /* the trigrams of the pattern are searched byte by byte in the values */
+      pattern_coll = db_get_string_collation (bound->value);
+      if ((attr->domain->collation_id != LANG_COLL_ISO_BINARY && attr->domain->collation_id != LANG_COLL_UTF8_BINARY)
+	  || (pattern_coll != LANG_COLL_ISO_BINARY && pattern_coll != LANG_COLL_UTF8_BINARY)
+	  || db_get_string_codeset (bound->value) != attr->domain->codeset)
+	{
+	  return;
+	}
+
+      bound->type = attr->type;
+      bound->op = HEAP_ZONE_BOUND_LIKE;
+      (*n_bounds)++;
+      return;
+    }
+
+  if (pred_expr->pe.m_eval_term.et_type == T_RLIKE_EVAL_TERM)
+    {
+      et_rlike = &pred_expr->pe.m_eval_term.et.et_rlike;
+      if (et_rlike->src == NULL || et_rlike->src->type != TYPE_ATTR_ID)
+	{
+	  return;
+	}
+      bound->attrid = et_rlike->src->value.attr_descr.id;
+      attr = scan_get_heap_zone_attr (pred_attrs, bound->attrid);
+      bound->value = scan_get_heap_zone_value (et_rlike->pattern, vd);
+      if (attr == NULL || bound->value == NULL || !TP_IS_CHAR_TYPE (attr->type)
+	  || !TP_IS_CHAR_TYPE (DB_VALUE_TYPE (bound->value)))
+	{
+	  return;
+	}
+
+      /* unknown sensitivity is taken as ignoring case */
+      case_sensitive = scan_get_heap_zone_value (et_rlike->case_sensitive, vd);
+      bound->is_case_sensitive = (case_sensitive != NULL && DB_VALUE_TYPE (case_sensitive) == DB_TYPE_INTEGER
+				  && db_get_int (case_sensitive) != 0);
+
+      bound->type = attr->type;
+      bound->op = HEAP_ZONE_BOUND_REGEXP;
+      (*n_bounds)++;
+      return;
+    }
+
+  if (pred_expr->pe.m_eval_term.et_type != T_COMP_EVAL_TERM)
+    {
+      return;
+    }
+
+  et_comp = &pred_expr->pe.m_eval_term.et.et_comp;
+  if (et_comp->lhs != NULL && et_comp->lhs->type == TYPE_ATTR_ID)
+    {
+      attr_regu = et_comp->lhs;
+      value_regu = et_comp->rhs;
+    }
+  else if (et_comp->rhs != NULL && et_comp->rhs->type == TYPE_ATTR_ID)
+    {
+      /* value op attr */
+      attr_regu = et_comp->rhs;
+      value_regu = et_comp->lhs;
+      mirror = true;
+    }
+  else
+    {
+      return;
+    }
+
+  bound->attrid = attr_regu->value.attr_descr.id;
+
+  /* attribute type */
+  attr = scan_get_heap_zone_attr (pred_attrs, bound->attrid);
+  if (attr == NULL)
+    {
+      return;
+    }
+  bound->type = attr->type;
+
+  if (et_comp->rel_op == R_NULL)
+    {
+      bound->op = HEAP_ZONE_BOUND_IS_NULL;
+      (*n_bounds)++;
+      return;
+    }
+
+  bound->value = scan_get_heap_zone_value (value_regu, vd);
+  if (bound->value == NULL)
+    {
+      return;
+    }
+
+  switch (et_comp->rel_op)
+    {
+    case R_EQ:
+      bound->op = HEAP_ZONE_BOUND_EQ;
+      break;
+    case R_LT:
+      bound->op = mirror ? HEAP_ZONE_BOUND_GT : HEAP_ZONE_BOUND_LT;
+      break;
+    case R_LE:
+      bound->op = mirror ? HEAP_ZONE_BOUND_GE : HEAP_ZONE_BOUND_LE;
+      break;
+    case R_GT:
+      bound->op = mirror ? HEAP_ZONE_BOUND_LT : HEAP_ZONE_BOUND_GT;
+      break;
+    case R_GE:
+      bound->op = mirror ? HEAP_ZONE_BOUND_LE : HEAP_ZONE_BOUND_GE;
+      break;
+    default:
+      return;
+    }
+  (*n_bounds)++;
+}
+
+/*
+ * scan_start_heap_zone_scan () - use zone maps to skip pages of a heap scan
+ *   return: error code
+ *   scan_id(in/out): Scan identifier
+ *   mvcc_snapshot(in): Snapshot of scan
+ *
+ * Note: The zone scan is created only if the data filter has terms that zone maps can check. Otherwise the heap scan
+ *       follows the page chain as usual.
+ */
+static int
+scan_start_heap_zone_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, MVCC_SNAPSHOT * mvcc_snapshot)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  HEAP_ZONE_BOUND bounds[HEAP_ZONE_MAP_MAX_ATTRS * 2];
+  int n_bounds = 0;
+  int error_code;
+
+  assert (hsidp->zone_scan == NULL);
+
+  scan_get_heap_zone_bounds (hsidp->scan_pred.pred_expr, &hsidp->pred_attrs, scan_id->vd, bounds, &n_bounds);
+  if (n_bounds == 0)
+    {
+      return NO_ERROR;
+    }
+
+  error_code = heap_zone_scan_create (thread_p, &hsidp->hfid, &hsidp->cls_oid, mvcc_snapshot, bounds, n_bounds,
+				      &hsidp->zone_scan);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      return error_code;
+    }
+
+  if (hsidp->zone_scan != NULL)
+    {
+      heap_zone_scan_reset (hsidp->zone_scan, scan_id->direction == S_FORWARD);
+      scan_id->scan_stats.zone_map = true;
+    }
+  VPID_SET_NULL (&hsidp->zone_vpid);
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_next_heap_zone_scan () - get next object of a heap scan using zone maps
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *   recdes(out): Record of next object
+ *   is_peeking(in): PEEK or COPY
+ *
+ * Note: Pages are read one by one in the order of the file table. Zones that cannot satisfy the data filter are
+ *       skipped, unless all objects are needed (e.g. outer joins).
+ */
+static SCAN_CODE
+scan_next_heap_zone_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes, int is_peeking)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  SCAN_CODE scan;
+
+  while (true)
+    {
+      if (!VPID_ISNULL (&hsidp->zone_vpid))
+	{
+	  scan = heap_page_next (thread_p, &hsidp->zone_vpid, &hsidp->cls_oid, &hsidp->curr_oid, recdes,
+				 &hsidp->scan_cache, is_peeking);
+	  if (scan != S_END)
+	    {
+	      return scan;
+	    }
+	}
+
+      scan = heap_zone_scan_next_page (thread_p, hsidp->zone_scan, scan_id->qualification == QPROC_QUALIFIED,
+				       &hsidp->zone_vpid, &scan_id->scan_stats.zone_skipped_pages);
+      if (scan != S_SUCCESS)
+	{
+	  VPID_SET_NULL (&hsidp->zone_vpid);
+	  return scan;
+	}
+      OID_SET_NULL (&hsidp->curr_oid);
+    }
+}
+
+/*
+ * scan_next_heap_px_scan () - get next object of a heap scan executed by a parallel worker
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *   recdes(out): Record of next object
+ *   is_peeking(in): PEEK or COPY
+ *
+ * Note: The pages are shared with the other workers of the scan; each page is taken by a single worker.
+ */
+static SCAN_CODE
+scan_next_heap_px_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes, int is_peeking)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  SCAN_CODE scan;
+
+  while (true)
+    {
+      if (!VPID_ISNULL (&hsidp->px_vpid))
+	{
+	  scan = heap_page_next (thread_p, &hsidp->px_vpid, &hsidp->cls_oid, &hsidp->curr_oid, recdes,
+				 &hsidp->scan_cache, is_peeking);
+	  if (scan != S_END)
+	    {
+	      return scan;
+	    }
+	}
+
+      if (!hsidp->px_scan->get_next_page (hsidp->px_page, hsidp->px_last_page, hsidp->px_vpid))
+	{
+	  VPID_SET_NULL (&hsidp->px_vpid);
+	  return S_END;
+	}
+      hsidp->px_num_pages++;
+      OID_SET_NULL (&hsidp->curr_oid);
+    }
+}
+
+/*
+ * scan_start_heap_vector_filter () - evaluate the data filter of a heap scan on batches of objects
+ *   return: void
+ *   scan_id(in/out): Scan identifier
+ *
+ * Note: The vector filter is used only if some terms of the data filter have kernels (see query_vector_filter.hpp).
+ *       Otherwise each object is filtered by the interpreter as usual.
+ */
+static void
+scan_start_heap_vector_filter (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  cubquery::vector_filter *filter;
+
+  assert (hsidp->vector_filter == NULL);
+
+  filter = new cubquery::vector_filter (prm_get_integer_value (PRM_ID_VECTOR_SCAN_BATCH_SIZE));
+  if (!filter->compile (hsidp->scan_pred.pred_expr, hsidp->pred_attrs.attr_cache, scan_id->vd))
+    {
+      delete filter;
+      return;
+    }
+
+  filter->reset_scan ();
+  COPY_OID (&filter->get_scan_oid (), &hsidp->curr_oid);
+  hsidp->vector_filter = filter;
+}
+
+/*
+ * scan_fill_heap_batch () - read the next batch of objects of a heap scan and evaluate its data filter
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *
+ * Note: The objects are read from the same sources as those of the scans without batches. The current OID of the
+ *       scan is the object returned to the caller; the position of the source is kept by the vector filter.
+ */
+static SCAN_CODE
+scan_fill_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  cubquery::vector_filter *filter = hsidp->vector_filter;
+  RECDES recdes = RECDES_INITIALIZER;
+  RECDES row_recdes;
+  SCAN_CODE sp_scan;
+
+  filter->clear ();
+  if (filter->is_scan_ended ())
+    {
+      return S_END;
+    }
+
+  COPY_OID (&hsidp->curr_oid, &filter->get_scan_oid ());
+  while (!filter->is_full ())
+    {
+      recdes.data = NULL;
+      if (hsidp->px_scan != NULL)
+	{
+	  sp_scan = scan_next_heap_px_scan (thread_p, scan_id, &recdes, scan_id->fixed);
+	}
+      else if (hsidp->zone_scan != NULL)
+	{
+	  sp_scan = scan_next_heap_zone_scan (thread_p, scan_id, &recdes, scan_id->fixed);
+	}
+      else
+	{
+	  sp_scan = heap_next (thread_p, &hsidp->hfid, &hsidp->cls_oid, &hsidp->curr_oid, &recdes, &hsidp->scan_cache,
+			       scan_id->fixed);
+	}
+
+      if (sp_scan == S_END)
+	{
+	  filter->set_scan_ended ();
+	  break;
+	}
+      else if (sp_scan != S_SUCCESS)
+	{
+	  return S_ERROR;
+	}
+
+      /* the record is copied before the page is released by the next read */
+      row_recdes = filter->add_row (hsidp->curr_oid, recdes);
+      if (heap_attrinfo_read_dbvalues (thread_p, &hsidp->curr_oid, &row_recdes, hsidp->pred_attrs.attr_cache) !=
+	  NO_ERROR)
+	{
+	  return S_ERROR;
+	}
+      filter->set_row_values (hsidp->pred_attrs.attr_cache);
+    }
+  COPY_OID (&filter->get_scan_oid (), &hsidp->curr_oid);
+
+  if (filter->get_row_count () == 0)
+    {
+      return S_END;
+    }
+
+  filter->evaluate ();
+  return S_SUCCESS;
+}
+
+/*
+ * scan_next_heap_batch () - get next object of a heap scan that filters batches of objects
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *   recdes(out): Record of next object; a copy kept by the batch
+ *   is_qualified(out): true if the vector kernels proved the data filter for the object
+ *
+ * Note: When only qualified objects are needed, the objects rejected by the kernels are skipped. The other objects
+ *       are filtered by the interpreter, unless is_qualified is set.
+ */
+static SCAN_CODE
+scan_next_heap_batch (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, RECDES * recdes, bool * is_qualified)
+{
+  HEAP_SCAN_ID *hsidp = &scan_id->s.hsid;
+  SCAN_CODE sp_scan;
+  int skipped;
+
+  while (true)
+    {
+      if (hsidp->vector_filter->next_row (scan_id->qualification == QPROC_QUALIFIED, hsidp->curr_oid, *recdes,
+					  *is_qualified, skipped))
+	{
+	  scan_id->scan_stats.read_rows += skipped;
+	  return S_SUCCESS;
+	}
+      scan_id->scan_stats.read_rows += skipped;
+
+      sp_scan = scan_fill_heap_batch (thread_p, scan_id);
+      if (sp_scan != S_SUCCESS)
+	{
+	  return sp_scan;
+	}
+    }
+}
+
 /*
  * scan_next_heap_scan () - The scan is moved to the next heap scan item.
  *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
@@ -5212,6 +5815,7 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
   OID retry_oid;
   LOG_LSA ref_lsa;
   bool is_peeking;
+  bool is_batch_qualified = false;
   OBJECT_GET_STATUS object_get_status;
   regu_variable_list_node *p;
 
@@ -5235,6 +5839,11 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
     {
       is_peeking = PEEK;
     }
+  else if (hsidp->vector_filter != NULL)
+    {
+      /* records are copies kept by the batch */
+      is_peeking = COPY;
+    }
 
   if (data_filter.val_list)
     {
@@ -5255,11 +5864,28 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
     restart_scan_oid:
 
       /* get next object */
-      if (scan_id->grouped)
+      if (hsidp->vector_filter != NULL)
+	{
+	  /* data filter evaluated on batches of objects */
+	  sp_scan = scan_next_heap_batch (thread_p, scan_id, &recdes, &is_batch_qualified);
+	}
+      else if (scan_id->grouped)
 	{
 	  /* grouped, fixed scan */
 	  sp_scan = heap_scanrange_next (thread_p, &hsidp->curr_oid, &recdes, &hsidp->scan_range, is_peeking);
 	}
+      else if (hsidp->px_scan != NULL)
+	{
+	  /* pages shared with the other workers of a parallel scan */
+	  recdes.data = NULL;
+	  sp_scan = scan_next_heap_px_scan (thread_p, scan_id, &recdes, is_peeking);
+	}
+      else if (hsidp->zone_scan != NULL)
+	{
+	  /* page by page, skipping zones */
+	  recdes.data = NULL;
+	  sp_scan = scan_next_heap_zone_scan (thread_p, scan_id, &recdes, is_peeking);
+	}
       else
 	{
 	  recdes.data = NULL;
@@ -5319,7 +5945,24 @@ scan_next_heap_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
       /* evaluate the predicates to see if the object qualifies */
       scan_id->scan_stats.read_rows++;
 
-      ev_res = eval_data_filter (thread_p, p_current_oid, &recdes, &hsidp->scan_cache, &data_filter);
+      if (is_batch_qualified)
+	{
+	  /* the vector kernels evaluated the whole data filter; only the values it fetches are needed */
+	  ev_res = V_TRUE;
+	  if (data_filter.val_list != NULL && hsidp->pred_attrs.attr_cache != NULL && hsidp->scan_pred.regu_list != NULL)
+	    {
+	      if (heap_attrinfo_read_dbvalues (thread_p, p_current_oid, &recdes, hsidp->pred_attrs.attr_cache) != NO_ERROR
+		  || fetch_val_list (thread_p, hsidp->scan_pred.regu_list, scan_id->vd, &hsidp->cls_oid, p_current_oid,
+				     NULL, PEEK) != NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	    }
+	}
+      else
+	{
+	  ev_res = eval_data_filter (thread_p, p_current_oid, &recdes, &hsidp->scan_cache, &data_filter);
+	}
       if (ev_res == V_ERROR)
 	{
 	  return S_ERROR;
@@ -6341,6 +6984,227 @@ scan_next_index_lookup_heap (THREAD_ENTRY * thread_p, SCAN_ID * scan_id, INDX_SC
   return S_SUCCESS;
 }
 
+/*
+ * scan_init_adaptive_join () - let the inner index scan of a nested loop join switch to a hash table
+ *   return:
+ *   scan_id(in/out): Scan identifier of an opened index scan
+ *   expected_rows(in): # of outer rows expected by the optimizer
+ *
+ * Note: The scan switches when the outer rows exceed expected_rows by adaptive_join_error_ratio times (see
+ *       query_adaptive_join.hpp). Only the scans looking up a single key of the index and reading the heap for each
+ *       match can switch; the others give the reason in the trace.
+ */
+void
+scan_init_adaptive_join (SCAN_ID * scan_id, int expected_rows)
+{
+  INDX_SCAN_ID *isidp = &scan_id->s.isid;
+  INDX_INFO *indx_info = isidp->indx_info;
+  KEY_INFO *key_info = &indx_info->key_info;
+  float error_ratio = prm_get_float_value (PRM_ID_ADAPTIVE_JOIN_ERROR_RATIO);
+  const char *reason = NULL;
+  int i;
+
+  assert (scan_id->type == S_INDX_SCAN && isidp->adaptive_join == NULL);
+
+  if (error_ratio <= 0 || expected_rows <= 0)
+    {
+      return;
+    }
+
+  if (indx_info->range_type != R_KEY || key_info->key_cnt != 1 || key_info->key_ranges[0].range != EQ_NA
+      || key_info->key_ranges[0].key1 == NULL || key_info->key_limit_l != NULL || key_info->key_limit_u != NULL)
+    {
+      reason = "range is not a single key";
+    }
+  else if (scan_id->grouped || scan_id->mvcc_select_lock_needed || scan_id->scan_op_type != S_SELECT
+	   || isidp->need_count_only || mvcc_is_mvcc_disabled_class (&isidp->cls_oid))
+    {
+      reason = "scan locks or counts rows";
+    }
+  else if (SCAN_IS_INDEX_COVERED (isidp))
+    {
+      reason = "covering index";
+    }
+  else if (SCAN_IS_INDEX_MRO (isidp) || SCAN_IS_INDEX_ISS (isidp) || SCAN_IS_INDEX_ILS (isidp)
+	   || indx_info->orderby_skip || indx_info->groupby_skip)
+    {
+      reason = "order of the index is used";
+    }
+  else if (indx_info->func_idx_col_id != -1)
+    {
+      reason = "function index";
+    }
+  else if (isidp->bt_attrs_prefix_length != NULL)
+    {
+      for (i = 0; i < isidp->bt_num_attrs; i++)
+	{
+	  if (isidp->bt_attrs_prefix_length[i] != -1)
+	    {
+	      reason = "prefix index";
+	      break;
+	    }
+	}
+    }
+
+  isidp->adaptive_join = new cubquery::adaptive_join ((reason == NULL) ? key_info->key_ranges[0].key1 : NULL,
+						      expected_rows, error_ratio);
+  if (reason == NULL && isidp->adaptive_join->get_key_count () > isidp->bt_num_attrs)
+    {
+      assert (false);
+      reason = "range is not a single key";
+    }
+  if (reason != NULL)
+    {
+      isidp->adaptive_join->keep_nested_loop (reason);
+    }
+
+  scan_set_adaptive_join_stats (scan_id);
+}
+
+/*
+ * scan_probe_adaptive_join () - count an outer row probing the inner index scan of an adaptive join
+ *   return: error code
+ *   scan_id(in/out): Scan identifier
+ *
+ * Note: When the outer rows exceed the estimate, the scan tries to switch to a hash table. Once it has switched, the
+ *       key of each outer row is looked up in the hash table.
+ */
+static int
+scan_probe_adaptive_join (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  INDX_SCAN_ID *isidp = &scan_id->s.isid;
+  cubquery::adaptive_join *join = isidp->adaptive_join;
+  int error;
+
+  if (join->add_probe ())
+    {
+      error = join->build (thread_p, isidp->hfid, isidp->cls_oid, isidp->scan_cache.mvcc_snapshot, isidp->bt_attr_ids,
+			   prm_get_bigint_value (PRM_ID_MAX_HASH_LIST_SCAN_SIZE));
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
+    }
+
+  scan_set_adaptive_join_stats (scan_id);
+
+  if (join->is_hashed ())
+    {
+      return join->start_probe (thread_p, scan_id->vd);
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * scan_next_index_hash_scan () - The inner index scan of an adaptive join is moved to the next record of the hash
+ *				  table matching the key of the outer row.
+ *   return: SCAN_CODE (S_SUCCESS, S_END, S_ERROR)
+ *   scan_id(in/out): Scan identifier
+ *
+ * Note: The records of the hash table are filtered like the records found through the index; the key filter is
+ *       evaluated on the record instead of the index key.
+ */
+static SCAN_CODE
+scan_next_index_hash_scan (THREAD_ENTRY * thread_p, SCAN_ID * scan_id)
+{
+  INDX_SCAN_ID *isidp = &scan_id->s.isid;
+  FILTER_INFO key_filter;
+  FILTER_INFO data_filter;
+  RECDES recdes = RECDES_INITIALIZER;
+  OID *oid = NULL;
+  SCAN_CODE sp_scan;
+  DB_LOGICAL ev_res;
+
+  if (scan_id->position == S_AFTER)
+    {
+      return S_END;
+    }
+  scan_id->position = S_ON;
+
+  scan_init_filter_info (&key_filter, &isidp->key_pred, &isidp->key_attrs, scan_id->val_list, scan_id->vd,
+			 &isidp->cls_oid, 0, NULL, NULL, NULL);
+  scan_init_filter_info (&data_filter, &isidp->scan_pred, &isidp->pred_attrs, scan_id->val_list, scan_id->vd,
+			 &isidp->cls_oid, 0, NULL, NULL, NULL);
+
+  while ((sp_scan = isidp->adaptive_join->next_match (thread_p, oid, recdes)) == S_SUCCESS)
+    {
+      if (isidp->key_pred.pred_expr != NULL)
+	{
+	  ev_res = eval_data_filter (thread_p, oid, &recdes, &isidp->scan_cache, &key_filter);
+	  if (ev_res == V_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+	  else if (ev_res != V_TRUE)
+	    {
+	      continue;
+	    }
+	}
+      scan_id->scan_stats.key_qualified_rows++;
+
+      ev_res = eval_data_filter (thread_p, oid, &recdes, &isidp->scan_cache, &data_filter);
+      ev_res = update_logical_result (thread_p, ev_res, (int *) &scan_id->qualification);
+      if (ev_res == V_ERROR)
+	{
+	  return S_ERROR;
+	}
+      else if (ev_res != V_TRUE)
+	{
+	  continue;
+	}
+      scan_id->scan_stats.data_qualified_rows++;
+
+      isidp->curr_oidp = oid;
+
+      if (isidp->rest_regu_list)
+	{
+	  /* read the rest of the values from the record into the attribute cache */
+	  if (heap_attrinfo_read_dbvalues (thread_p, oid, &recdes, isidp->rest_attrs.attr_cache) != NO_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+
+	  /* fetch the rest of the values from the object instance */
+	  if (scan_id->val_list)
+	    {
+	      if (fetch_val_list (thread_p, isidp->rest_regu_list, scan_id->vd, &isidp->cls_oid, oid, NULL, PEEK) !=
+		  NO_ERROR)
+		{
+		  return S_ERROR;
+		}
+	    }
+	}
+
+      return S_SUCCESS;
+    }
+
+  if (sp_scan == S_END)
+    {
+      scan_id->position = S_AFTER;
+    }
+
+  return sp_scan;
+}
+
+/*
+ * scan_set_adaptive_join_stats () - copy the decision of an adaptive join to the stats of its inner scan
+ *   return:
+ *   scan_id(in/out): Scan identifier
+ */
+static void
+scan_set_adaptive_join_stats (SCAN_ID * scan_id)
+{
+  cubquery::adaptive_join *join = scan_id->s.isid.adaptive_join;
+
+  scan_id->scan_stats.adaptive_join = true;
+  scan_id->scan_stats.adaptive_hashed = join->is_hashed ();
+  scan_id->scan_stats.adaptive_reason = join->get_reason ();
+  scan_id->scan_stats.adaptive_outer_rows = join->get_probes ();
+  scan_id->scan_stats.adaptive_switch_rows = join->get_switch_probes ();
+  scan_id->scan_stats.adaptive_expected_rows = join->get_expected_rows ();
+}
+
 /*
  * scan_next_index_key_info_scan () - Scans each key in index and obtains
  *				      information about that key.
@@ -7790,6 +8654,11 @@ scan_print_stats_json (SCAN_ID * scan_id, json_t * scan_stats)
   scan = json_pack ("{s:i, s:I, s:I}", "time", TO_MSEC (scan_id->scan_stats.elapsed_scan), "fetch",
 		    scan_id->scan_stats.num_fetches, "ioread", scan_id->scan_stats.num_ioreads);
 
+  if (scan_id->scan_stats.partition_wise_skipped > 0)
+    {
+      json_object_set_new (scan, "partitionwise_skipped", json_integer (scan_id->scan_stats.partition_wise_skipped));
+    }
+
   switch (scan_id->type)
     {
     case S_HEAP_SCAN:
@@ -7832,6 +8701,36 @@ scan_print_stats_json (SCAN_ID * scan_id, json_t * scan_stats)
 	      free (agl_index);
 	    }
 
+	  if (scan_id->scan_stats.px_degree > 0)
+	    {
+	      json_t *workers, *worker;
+	      int i;
+
+	      json_object_set_new (scan, "parallel", json_integer (scan_id->scan_stats.px_degree));
+
+	      workers = json_array ();
+	      for (i = 0; i < scan_id->scan_stats.px_degree; i++)
+		{
+		  worker = json_pack ("{s:i, s:i, s:I, s:I}", "time",
+				      TO_MSEC (scan_id->scan_stats.px_workers[i].elapsed_scan), "pages",
+				      scan_id->scan_stats.px_workers[i].num_pages, "readrows",
+				      (json_int_t) scan_id->scan_stats.px_workers[i].read_rows, "rows",
+				      (json_int_t) scan_id->scan_stats.px_workers[i].qualified_rows);
+		  json_array_append_new (workers, worker);
+		}
+	      json_object_set_new (scan, "workers", workers);
+	    }
+
+	  if (scan_id->scan_stats.zone_map)
+	    {
+	      json_object_set_new (scan, "zoneskip", json_integer (scan_id->scan_stats.zone_skipped_pages));
+	    }
+
+	  if (scan_id->scan_stats.vector_batches > 0)
+	    {
+	      json_object_set_new (scan, "batches", json_integer (scan_id->scan_stats.vector_batches));
+	    }
+
 	  if (scan_id->scan_stats.noscan)
 	    {
 	      json_object_set_new (scan_stats, "noscan", scan);
@@ -7879,6 +8778,23 @@ scan_print_stats_json (SCAN_ID * scan_id, json_t * scan_stats)
 	{
 	  json_object_set_new (scan_stats, "loose", json_true ());
 	}
+
+      if (scan_id->scan_stats.adaptive_join == true)
+	{
+	  json_t *adaptive;
+
+	  adaptive = json_pack ("{s:s, s:s, s:I, s:I}", "join",
+				scan_id->scan_stats.adaptive_hashed ? "hash" : "nested loop", "reason",
+				scan_id->scan_stats.adaptive_reason, "outerrows",
+				(json_int_t) scan_id->scan_stats.adaptive_outer_rows, "expected",
+				(json_int_t) scan_id->scan_stats.adaptive_expected_rows);
+	  if (scan_id->scan_stats.adaptive_hashed)
+	    {
+	      json_object_set_new (adaptive, "switchrows",
+				   json_integer ((json_int_t) scan_id->scan_stats.adaptive_switch_rows));
+	    }
+	  json_object_set_new (scan_stats, "adaptive", adaptive);
+	}
       break;
 
     case S_SHOWSTMT_SCAN:
@@ -7986,6 +8902,11 @@ scan_print_stats_text (FILE * fp, SCAN_ID * scan_id)
 	   (unsigned long long int) scan_id->scan_stats.num_fetches,
 	   (unsigned long long int) scan_id->scan_stats.num_ioreads);
 
+  if (scan_id->scan_stats.partition_wise_skipped > 0)
+    {
+      fprintf (fp, ", partition-wise skipped: %d", scan_id->scan_stats.partition_wise_skipped);
+    }
+
   switch (scan_id->type)
     {
     case S_HEAP_SCAN:
@@ -8007,6 +8928,28 @@ scan_print_stats_text (FILE * fp, SCAN_ID * scan_id)
 		}
 	    }
 	}
+      if (scan_id->scan_stats.px_degree > 0)
+	{
+	  int i;
+
+	  fprintf (fp, ", parallel: %d", scan_id->scan_stats.px_degree);
+	  for (i = 0; i < scan_id->scan_stats.px_degree; i++)
+	    {
+	      fprintf (fp, " (worker %d time: %d, pages: %d, readrows: %llu, rows: %llu)", i,
+		       TO_MSEC (scan_id->scan_stats.px_workers[i].elapsed_scan),
+		       scan_id->scan_stats.px_workers[i].num_pages,
+		       (unsigned long long int) scan_id->scan_stats.px_workers[i].read_rows,
+		       (unsigned long long int) scan_id->scan_stats.px_workers[i].qualified_rows);
+	    }
+	}
+      if (scan_id->scan_stats.zone_map)
+	{
+	  fprintf (fp, ", zonemap skipped pages: %d", scan_id->scan_stats.zone_skipped_pages);
+	}
+      if (scan_id->scan_stats.vector_batches > 0)
+	{
+	  fprintf (fp, ", vectorized batches: %d", scan_id->scan_stats.vector_batches);
+	}
       fprintf (fp, ")");
       break;
 
@@ -8040,6 +8983,22 @@ scan_print_stats_text (FILE * fp, SCAN_ID * scan_id)
 	{
 	  fprintf (fp, ", loose: true");
 	}
+
+      if (scan_id->scan_stats.adaptive_join == true)
+	{
+	  if (scan_id->scan_stats.adaptive_hashed)
+	    {
+	      fprintf (fp, ", adaptive: hash join after %llu outer rows",
+		       (unsigned long long int) scan_id->scan_stats.adaptive_switch_rows);
+	    }
+	  else
+	    {
+	      fprintf (fp, ", adaptive: nested loop");
+	    }
+	  fprintf (fp, " (%s, outer rows: %llu, expected: %llu)", scan_id->scan_stats.adaptive_reason,
+		   (unsigned long long int) scan_id->scan_stats.adaptive_outer_rows,
+		   (unsigned long long int) scan_id->scan_stats.adaptive_expected_rows);
+	}
       fprintf (fp, ")");
 
       if (scan_id->scan_stats.covered_index == false)
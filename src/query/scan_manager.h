@@ -37,6 +37,7 @@
 
 #include "btree.h"		/* TODO: for BTREE_SCAN */
 #include "heap_file.h"		/* for HEAP_SCANCACHE */
+#include "heap_zone_map.hpp"	/* for HEAP_ZONE_SCAN */
 #include "method_scan.hpp"	/* METHOD_SCAN_ID */
 #include "dblink_scan.h"
 #include "oid.h"		/* for OID */
@@ -65,6 +66,12 @@ namespace cubxasl
   struct pred_expr;
 }
 using PRED_EXPR = cubxasl::pred_expr;
+namespace cubquery
+{
+  class adaptive_join;
+  class parallel_heap_scan;
+  class vector_filter;
+}
 // *INDENT-ON*
 
 /*
@@ -118,6 +125,14 @@ struct heap_scan_id
   DB_VALUE **cache_recordinfo;	/* cache for record information */
   regu_variable_list_node *recordinfo_regu_list;	/* regulator variable list for record info */
   sampling_info sampling;	/* for sampling statistics */
+  HEAP_ZONE_SCAN *zone_scan;	/* page by page scan skipping zones, NULL if zone maps are not used */
+  VPID zone_vpid;		/* current page of zone scan */
+  cubquery::parallel_heap_scan *px_scan;	/* shared page source of a parallel scan worker, NULL if serial */
+  int px_page;			/* next page of the current chunk of px_scan */
+  int px_last_page;		/* end of the current chunk of px_scan */
+  VPID px_vpid;			/* current page of px_scan */
+  int px_num_pages;		/* # of pages taken from px_scan */
+  cubquery::vector_filter *vector_filter;	/* evaluates the data filter on batches of objects, NULL if not used */
 };				/* Regular Heap File Scan Identifier */
 
 typedef struct heap_page_scan_id HEAP_PAGE_SCAN_ID;
@@ -240,6 +255,8 @@ struct indx_scan_id
   bool check_not_vacuumed;	/* if true then during index scan, the entries will be checked if they should've been
 				 * vacuumed. Used in checkdb. */
   DISK_ISVALID not_vacuumed_res;	/* The result of not vacuumed checking operation */
+  cubquery::adaptive_join *adaptive_join;	/* switches the inner scan of a nested loop join to a hash table, NULL
+						 * if not used */
 };
 
 typedef struct index_node_scan_id INDEX_NODE_SCAN_ID;
@@ -311,6 +328,15 @@ struct scan_agl
   SCAN_AGL *next;
 };
 
+typedef struct scan_px_worker_stats SCAN_PX_WORKER_STATS;
+struct scan_px_worker_stats
+{
+  struct timeval elapsed_scan;	/* time spent by the worker */
+  int num_pages;		/* # of heap pages scanned by the worker */
+  UINT64 read_rows;		/* # of rows read by the worker */
+  UINT64 qualified_rows;	/* # of rows qualified by the worker */
+};
+
 typedef struct scan_stats SCAN_STATS;
 struct scan_stats
 {
@@ -337,6 +363,28 @@ struct scan_stats
 
   /* hash list scan */
   struct timeval elapsed_hash_build;
+
+  /* parallel heap scan */
+  int px_degree;		/* # of workers, 0 if the scan was not parallel */
+  SCAN_PX_WORKER_STATS *px_workers;	/* per-worker stats, px_degree elements */
+
+  /* heap scan with zone maps */
+  bool zone_map;		/* zone maps were checked by the scan */
+  int zone_skipped_pages;	/* # of heap pages skipped with zone maps */
+
+  /* heap scan with vectorized data filter */
+  int vector_batches;		/* # of batches of objects filtered by vector kernels */
+
+  /* inner index scan of an adaptive nested loop join */
+  bool adaptive_join;		/* the scan could switch to a hash table */
+  bool adaptive_hashed;		/* the scan switched to a hash table */
+  const char *adaptive_reason;	/* why the scan switched or kept probing the index */
+  UINT64 adaptive_outer_rows;	/* # of outer rows probing the scan */
+  UINT64 adaptive_switch_rows;	/* # of outer rows when the scan switched */
+  UINT64 adaptive_expected_rows;	/* # of outer rows expected by the optimizer */
+
+  /* inner scan of a partition-wise nested loop join */
+  int partition_wise_skipped;	/* # of partitions skipped for not matching the partition of the outer scan */
 };
 
 typedef struct scan_id_struct SCAN_ID;
@@ -491,6 +539,7 @@ extern SCAN_CODE scan_prev_scan (THREAD_ENTRY * thread_p, SCAN_ID * s_id);
 extern void scan_save_scan_pos (SCAN_ID * s_id, SCAN_POS * scan_pos);
 extern SCAN_CODE scan_jump_scan_pos (THREAD_ENTRY * thread_p, SCAN_ID * s_id, SCAN_POS * scan_pos);
 extern int scan_init_iss (INDX_SCAN_ID * isidp);
+extern void scan_init_adaptive_join (SCAN_ID * scan_id, int expected_rows);
 extern void scan_init_index_scan (INDX_SCAN_ID * isidp, struct btree_iscan_oid_list *oid_list,
 				  MVCC_SNAPSHOT * mvcc_snapshot);
 extern int scan_initialize (void);
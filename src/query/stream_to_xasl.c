@@ -1694,6 +1694,10 @@ stx_build_xasl_node (THREAD_ENTRY * thread_p, char *ptr, XASL_NODE * xasl)
   /* initialize query_in_progress flag */
   xasl->query_in_progress = false;
 
+  /* the offset of the block is the same in every unpacked copy of the stream */
+  xasl->px_id = CAST_BUFLEN (ptr - xasl_unpack_info->packed_xasl);
+  xasl->runtime_filter = NULL;
+
   /* XASL node header is packed first */
   ptr = stx_build_xasl_header (thread_p, ptr, &xasl->header);
 
@@ -2174,6 +2178,8 @@ stx_build_xasl_node (THREAD_ENTRY * thread_p, char *ptr, XASL_NODE * xasl)
 
   ptr = or_unpack_int (ptr, &xasl->mvcc_reev_extra_cls_cnt);
 
+  ptr = or_unpack_int (ptr, &xasl->px_degree);
+
   ptr = or_unpack_int (ptr, &offset);
   if (offset == 0)
     {
@@ -4116,7 +4122,7 @@ error:
 static char *
 stx_build_cte_proc (THREAD_ENTRY * thread_p, char *ptr, CTE_PROC_NODE * cte_info)
 {
-  int offset;
+  int offset, tmp;
   XASL_UNPACK_INFO *xasl_unpack_info = get_xasl_unpack_info_ptr (thread_p);
 
   ptr = or_unpack_int (ptr, &offset);
@@ -4148,6 +4154,11 @@ stx_build_cte_proc (THREAD_ENTRY * thread_p, char *ptr, CTE_PROC_NODE * cte_info
 	}
     }
 
+  ptr = or_unpack_int (ptr, &tmp);
+  cte_info->is_distinct = (tmp != 0);
+
+  memset (&cte_info->stats, 0, sizeof (cte_info->stats));
+
   return ptr;
 
 error:
@@ -4221,6 +4232,7 @@ stx_build_pred_expr (THREAD_ENTRY * thread_p, char *ptr, PRED_EXPR * pred_expr)
 
   ptr = or_unpack_int (ptr, &tmp);
   pred_expr->type = (TYPE_PRED_EXPR) tmp;
+  pred_expr->compiled = NULL;
 
   switch (pred_expr->type)
     {
@@ -4297,6 +4309,7 @@ stx_build_pred (THREAD_ENTRY * thread_p, char *ptr, PRED * pred)
       rhs = pred->rhs;
 
       rhs->type = T_PRED;
+      rhs->compiled = NULL;
 
       pred = &rhs->pe.m_pred;
 
@@ -4518,6 +4531,9 @@ stx_build_like_eval_term (THREAD_ENTRY * thread_p, char *ptr, LIKE_EVAL_TERM * l
 	}
     }
 
+  /* initialize pattern analysis pointer */
+  like_eval_term->compiled_like = NULL;
+
   return ptr;
 
 error:
@@ -4745,10 +4761,17 @@ stx_build_access_spec_type (THREAD_ENTRY * thread_p, char *ptr, ACCESS_SPEC_TYPE
   access_spec->parts = NULL;
   access_spec->curent = NULL;
   access_spec->pruned = false;
+  access_spec->join_keys = NULL;
+  access_spec->partition_wise_outer = NULL;
 
   ptr = or_unpack_int (ptr, &val);
   access_spec->flags = (ACCESS_SPEC_FLAG) val;
 
+  ptr = or_unpack_int (ptr, &val);
+  access_spec->pred_hash = (unsigned int) val;
+  ptr = or_unpack_float (ptr, &access_spec->est_selectivity);
+  ptr = or_unpack_int (ptr, &access_spec->adaptive_join_rows);
+
   return ptr;
 
 error:
@@ -6251,6 +6274,16 @@ stx_build_analytic_type (THREAD_ENTRY * thread_p, char *ptr, ANALYTIC_TYPE * ana
   ptr = or_unpack_int (ptr, &tmp_i);
   analytic->is_const_operand = (bool) tmp_i;
 
+  /* has_frame */
+  ptr = or_unpack_int (ptr, &tmp_i);
+  analytic->has_frame = (bool) tmp_i;
+
+  /* frame_start */
+  ptr = or_unpack_int (ptr, &analytic->frame_start);
+
+  /* frame_end */
+  ptr = or_unpack_int (ptr, &analytic->frame_end);
+
   if (analytic->function == PT_PERCENTILE_CONT || analytic->function == PT_PERCENTILE_DISC)
     {
       ptr = or_unpack_int (ptr, &offset);
@@ -0,0 +1,288 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// string_like - LIKE patterns analyzed once and matched by substring search
+//
+
+#include "string_like.hpp"
+
+#include "language_support.h"
+#include "string_opfunc.h"
+
+#include <cstring>
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_LIKE_SSE2
+#include <emmintrin.h>
+#endif
+// XXX: SHOULD BE THE LAST INCLUDE HEADER
+#include "memory_wrapper.hpp"
+
+namespace cublike
+{
+#if defined (STRING_LIKE_SSE2)
+  static int
+  lowest_bit (unsigned int mask)
+  {
+#if defined (__GNUC__)
+    return __builtin_ctz (mask);
+#else
+    int pos = 0;
+
+    while ((mask & 1) == 0)
+      {
+	mask >>= 1;
+	pos++;
+      }
+    return pos;
+#endif
+  }
+#endif /* STRING_LIKE_SSE2 */
+
+  //
+  // find_substring () - first occurrence of sub in str
+  //
+  //  the SSE2 version compares 16 positions of str at once with the first and the last byte of sub and compares the
+  //  rest of sub only at the positions where both match.
+  //
+  const char *
+  find_substring (const char *str, std::size_t size, const char *sub, std::size_t sub_size)
+  {
+    const char *end, *p;
+
+    if (sub_size == 0)
+      {
+	return str;
+      }
+    if (sub_size > size)
+      {
+	return NULL;
+      }
+    if (sub_size == 1)
+      {
+	return (const char *) std::memchr (str, sub[0], size);
+      }
+
+    /* the positions where sub may start are [str, end) */
+    end = str + size - sub_size + 1;
+    p = str;
+
+#if defined (STRING_LIKE_SSE2)
+    const __m128i first = _mm_set1_epi8 (sub[0]);
+    const __m128i last = _mm_set1_epi8 (sub[sub_size - 1]);
+
+    for (; end - p >= 16; p += 16)
+      {
+	const __m128i block_first = _mm_loadu_si128 ((const __m128i *) p);
+	const __m128i block_last = _mm_loadu_si128 ((const __m128i *) (p + sub_size - 1));
+	unsigned int mask;
+
+	mask = _mm_movemask_epi8 (_mm_and_si128 (_mm_cmpeq_epi8 (first, block_first), _mm_cmpeq_epi8 (last, block_last)));
+	while (mask != 0)
+	  {
+	    int pos = lowest_bit (mask);
+
+	    if (std::memcmp (p + pos + 1, sub + 1, sub_size - 2) == 0)
+	      {
+		return p + pos;
+	      }
+	    mask &= mask - 1;
+	  }
+      }
+#endif /* STRING_LIKE_SSE2 */
+
+    while (p < end)
+      {
+	p = (const char *) std::memchr (p, sub[0], end - p);
+	if (p == NULL)
+	  {
+	    return NULL;
+	  }
+	if (std::memcmp (p + 1, sub + 1, sub_size - 1) == 0)
+	  {
+	    return p;
+	  }
+	p++;
+      }
+    return NULL;
+  }
+
+  compiled_like::compiled_like ()
+    : m_pattern ()
+    , m_escape (-1)
+    , m_coll_id (-1)
+    , m_is_simple (false)
+    , m_literals ()
+    , m_is_start_anchored (true)
+    , m_is_end_anchored (true)
+  {
+    //
+  }
+
+  bool
+  compiled_like::is_compiled (const char *pattern, int pattern_size, const char *escape, int coll_id) const
+  {
+    int escape_byte = (escape != NULL) ? (unsigned char) escape[0] : -1;
+
+    return (m_coll_id == coll_id && m_escape == escape_byte && m_pattern.size () == (std::size_t) pattern_size
+	    && std::memcmp (m_pattern.data (), pattern, pattern_size) == 0);
+  }
+
+  //
+  // compile () - split the pattern into its literals, unless it is the pattern compiled last
+  //
+  //  escape is the escape character, NULL if none. the pattern is not simple if it has a byte equal to the first byte
+  //  of the escape character; only that byte is kept in the key.
+  //
+  void
+  compiled_like::compile (const char *pattern, int pattern_size, const char *escape, INTL_CODESET codeset, int coll_id)
+  {
+    const char *literal;
+    char *invalid_pos;
+    int i;
+
+    if (is_compiled (pattern, pattern_size, escape, coll_id))
+      {
+	return;
+      }
+
+    m_pattern.assign (pattern, pattern_size);
+    m_escape = (escape != NULL) ? (unsigned char) escape[0] : -1;
+    m_coll_id = coll_id;
+    m_literals.clear ();
+    m_is_simple = false;
+
+    /* other collations compare characters by their weights */
+    if (coll_id != LANG_COLL_ISO_BINARY && coll_id != LANG_COLL_UTF8_BINARY)
+      {
+	return;
+      }
+    /* the literals are searched byte by byte; an utf8 literal is found only at character boundaries if it is valid */
+    if (codeset == INTL_CODESET_UTF8
+	&& intl_check_utf8 ((const unsigned char *) pattern, pattern_size, &invalid_pos) != INTL_UTF8_VALID)
+      {
+	return;
+      }
+
+    for (i = 0; i < pattern_size; i++)
+      {
+	unsigned char c = (unsigned char) pattern[i];
+
+	if (c == LIKE_WILDCARD_MATCH_ONE || c == ' ' || c == '\0' || (int) c == m_escape)
+	  {
+	    return;
+	  }
+      }
+
+    m_is_start_anchored = pattern_size == 0 || pattern[0] != LIKE_WILDCARD_MATCH_MANY;
+    m_is_end_anchored = pattern_size == 0 || pattern[pattern_size - 1] != LIKE_WILDCARD_MATCH_MANY;
+
+    literal = pattern;
+    for (i = 0; i <= pattern_size; i++)
+      {
+	if (i == pattern_size || pattern[i] == LIKE_WILDCARD_MATCH_MANY)
+	  {
+	    if (pattern + i > literal)
+	      {
+		m_literals.emplace_back (literal, pattern + i - literal);
+	      }
+	    literal = pattern + i + 1;
+	  }
+      }
+    m_is_simple = true;
+  }
+
+  bool
+  compiled_like::is_simple () const
+  {
+    return m_is_simple;
+  }
+
+  //
+  // match () - match a string with a simple pattern
+  //
+  //  the literals have no spaces, so the spaces trailing the string, ignored by LIKE, can be cut before matching.
+  //
+  bool
+  compiled_like::match (const char *str, int size) const
+  {
+    const char *end = str + size;
+    std::size_t first = 0, last = m_literals.size ();
+
+    assert (m_is_simple);
+
+    if (m_is_end_anchored)
+      {
+	while (end > str && end[-1] == ' ')
+	  {
+	    end--;
+	  }
+      }
+
+    if (m_literals.empty ())
+      {
+	/* '' or only '%' */
+	return !(m_is_start_anchored && m_is_end_anchored) || end == str;
+      }
+
+    if (m_is_start_anchored)
+      {
+	const std::string &literal = m_literals.front ();
+
+	if ((std::size_t) (end - str) < literal.size () || std::memcmp (str, literal.data (), literal.size ()) != 0)
+	  {
+	    return false;
+	  }
+	str += literal.size ();
+	first++;
+	if (m_is_end_anchored && last == 1)
+	  {
+	    /* no '%' */
+	    return str == end;
+	  }
+      }
+
+    if (m_is_end_anchored)
+      {
+	const std::string &literal = m_literals.back ();
+
+	if ((std::size_t) (end - str) < literal.size ()
+	    || std::memcmp (end - literal.size (), literal.data (), literal.size ()) != 0)
+	  {
+	    return false;
+	  }
+	end -= literal.size ();
+	last--;
+      }
+
+    /* the first occurrence of each literal leaves the most room to the next ones */
+    for (std::size_t i = first; i < last; i++)
+      {
+	const std::string &literal = m_literals[i];
+
+	str = find_substring (str, end - str, literal.data (), literal.size ());
+	if (str == NULL)
+	  {
+	    return false;
+	  }
+	str += literal.size ();
+      }
+    return true;
+  }
+} // namespace cublike
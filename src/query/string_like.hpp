@@ -0,0 +1,100 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// string_like - LIKE patterns analyzed once and matched by substring search
+//
+//  the general LIKE algorithm walks the pattern character by character for every string, comparing the characters
+//  with the collation and backtracking on '%'. with a binary collation, a pattern made of literals separated by '%' is
+//  matched much faster by searching its literals in the bytes of the string: the first literal at the start of the
+//  string unless the pattern starts with '%', the last one at the end unless it ends with '%' and the others in order
+//  in between. '%token%' becomes a single substring search.
+//
+//  a pattern qualifies when it has no '_', no escape character and no space (the binary collations compare space and
+//  the zero character as equal, and the spaces trailing the string are ignored). other patterns keep the general
+//  algorithm.
+//
+//  the analysis is kept by the LIKE predicate, like the compiled regular expression of RLIKE, and is reused for all the
+//  strings and, in a cached XASL clone, all the executions; it is done again when the pattern, the escape character or
+//  the collation changes.
+//
+
+#ifndef _STRING_LIKE_HPP_
+#define _STRING_LIKE_HPP_
+
+#include "intl_support.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace cublike
+{
+  // first occurrence of sub in str, or NULL; vectorized where SSE2 is available
+  const char *find_substring (const char *str, std::size_t size, const char *sub, std::size_t sub_size);
+
+  //
+  // compiled_like
+  //
+  //  description:
+  //    a LIKE pattern split into the literals between its '%' characters, if it can be matched by substring search.
+  //
+  //  how to use:
+  //    compiled_like *cl = new compiled_like ();
+  //
+  //    // for each string
+  //    cl->compile (pattern, pattern_size, escape, codeset, coll_id);    // analyzes only a new pattern
+  //    if (cl->is_simple ())
+  //      {
+  //        is_match = cl->match (str, str_size);
+  //      }
+  //    else
+  //      {
+  //        // general algorithm
+  //      }
+  //
+  //    delete cl;
+  //
+  class compiled_like
+  {
+    public:
+      compiled_like ();
+
+      void compile (const char *pattern, int pattern_size, const char *escape, INTL_CODESET codeset, int coll_id);
+
+      bool is_simple () const;
+      bool match (const char *str, int size) const;
+
+    private:
+      bool is_compiled (const char *pattern, int pattern_size, const char *escape, int coll_id) const;
+
+      // key of the analysis
+      std::string m_pattern;
+      int m_escape;		// first byte of the escape character; -1 if none
+      int m_coll_id;		// -1 if not compiled
+
+      bool m_is_simple;
+      std::vector<std::string> m_literals;
+      bool m_is_start_anchored;	// the pattern doesn't start with '%'
+      bool m_is_end_anchored;	// the pattern doesn't end with '%'
+  };
+} // namespace cublike
+
+using cub_compiled_like = cublike::compiled_like;
+
+#endif // _STRING_LIKE_HPP_
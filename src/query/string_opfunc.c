@@ -4308,6 +4308,8 @@ qstr_pad (MISC_OPERAND pad_operand, int pad_length, const unsigned char *pad_cha
  *                pattern:  (IN) Pattern string which can contain % and _
  *                               characters.
  *               esc_char:  (IN) Optional escape character.
+ *              comp_like: (IN/OUT) Analysis of the pattern kept by the caller
+ *                               across strings; NULL if none.
  *                 result: (OUT) Integer result.
  *
  * Returns: int
@@ -4334,7 +4336,8 @@ qstr_pad (MISC_OPERAND pad_operand, int pad_length, const unsigned char *pad_cha
 */
 
 int
-db_string_like (const DB_VALUE * src_string, const DB_VALUE * pattern, const DB_VALUE * esc_char, int *result)
+db_string_like (const DB_VALUE * src_string, const DB_VALUE * pattern, const DB_VALUE * esc_char,
+		cub_compiled_like ** comp_like, int *result)
 {
   QSTR_CATEGORY src_category = QSTR_UNKNOWN;
   QSTR_CATEGORY pattern_category = QSTR_UNKNOWN;
@@ -4452,6 +4455,24 @@ db_string_like (const DB_VALUE * src_string, const DB_VALUE * pattern, const DB_
   pattern_char_string_p = db_get_string (pattern);
   pattern_length = db_get_string_size (pattern);
 
+  if (comp_like != NULL)
+    {
+      /* patterns of literals separated by '%' are matched by substring search */
+      if (*comp_like == NULL)
+	{
+	  // *INDENT-OFF*
+	  *comp_like = new cub_compiled_like ();
+	  // *INDENT-ON*
+	}
+      (*comp_like)->compile (pattern_char_string_p, pattern_length, (esc_char ? esc_char_p : NULL),
+			     db_get_string_codeset (src_string), coll_id);
+      if ((*comp_like)->is_simple ())
+	{
+	  *result = (*comp_like)->match (src_char_string_p, src_length) ? V_TRUE : V_FALSE;
+	  return error_status;
+	}
+    }
+
   *result =
     qstr_eval_like (src_char_string_p, src_length, pattern_char_string_p, pattern_length,
 		    (esc_char ? esc_char_p : NULL), db_get_string_codeset (src_string), coll_id);
@@ -38,8 +38,10 @@
 
 #ifdef  __cplusplus
 #include <functional>
+#include "string_like.hpp"
 #include "string_regex.hpp"
 #else
+typedef struct cub_compiled_like cub_compiled_like;
 typedef struct cub_compiled_regex cub_compiled_regex;
 #endif
 
@@ -220,7 +222,7 @@ extern int db_string_trim (const MISC_OPERAND tr_operand, const DB_VALUE * trim_
 extern int db_string_pad (const MISC_OPERAND pad_operand, const DB_VALUE * src_string, const DB_VALUE * pad_length,
 			  const DB_VALUE * pad_charset, DB_VALUE * padded_string);
 extern int db_string_like (const DB_VALUE * src_string, const DB_VALUE * pattern, const DB_VALUE * esc_char,
-			   int *result);
+			   cub_compiled_like ** comp_like, int *result);
 
 //***********************************************************************************************
 // Regular Expression Functions
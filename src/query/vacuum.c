@@ -28,6 +28,7 @@
 #include "btree.h"
 #include "dbtype.h"
 #include "heap_file.h"
+#include "heap_zone_map.hpp"
 #include "lockfree_circular_queue.hpp"
 #include "log_append.hpp"
 #include "log_compress.h"
@@ -1888,6 +1889,9 @@ end:
       vacuum_heap_page_log_and_reset (thread_p, &helper, true, true);
     }
 
+  /* summaries of zone may be narrowed now */
+  heap_zone_map_notify_vacuum (thread_p, &heap_objects[0].vfid, &helper.home_vpid);
+
   return error_code;
 }
 
@@ -3352,7 +3356,38 @@ vacuum_process_log_block (THREAD_ENTRY * thread_p, VACUUM_DATA_ENTRY * data, boo
 	}
 #endif /* !NDEBUG */
 
-      if (LOG_IS_MVCC_HEAP_OPERATION (log_record_data.rcvindex))
+      if (log_record_data.rcvindex == RVHF_MVCC_INSERT_MULTI)
+	{
+	  /* Collect all objects inserted by the log record. Undo data is the array of their slot ids. */
+	  PGSLOTID *slotids = (PGSLOTID *) undo_data;
+	  int n_slotids = undo_data_size / (int) sizeof (PGSLOTID);
+	  int i;
+
+	  assert (undo_data != NULL && n_slotids > 0);
+
+	  heap_object_oid.pageid = log_record_data.pageid;
+	  heap_object_oid.volid = log_record_data.volid;
+	  for (i = 0; i < n_slotids; i++)
+	    {
+	      heap_object_oid.slotid = slotids[i];
+
+	      error_code = vacuum_collect_heap_objects (thread_p, worker, &heap_object_oid, &log_vacuum.vfid);
+	      if (error_code != NO_ERROR)
+		{
+		  assert_release (false);
+		  vacuum_er_log_error (VACUUM_ER_LOG_WORKER | VACUUM_ER_LOG_HEAP, "%s", "vacuum_collect_heap_objects.");
+		  /* Release should not stop. */
+		  er_clear ();
+		  error_code = NO_ERROR;
+		  break;
+		}
+	    }
+	  vacuum_er_log (VACUUM_ER_LOG_HEAP | VACUUM_ER_LOG_WORKER,
+			 "collected %d oids from page %d|%d, in file %d|%d, based on %lld|%d", n_slotids,
+			 heap_object_oid.volid, heap_object_oid.pageid, VFID_AS_ARGS (&log_vacuum.vfid),
+			 LSA_AS_ARGS (&rcv_lsa));
+	}
+      else if (LOG_IS_MVCC_HEAP_OPERATION (log_record_data.rcvindex))
 	{
 	  /* Collect heap object to be vacuumed at the end of the job. */
 	  heap_object_oid.pageid = log_record_data.pageid;
@@ -4004,7 +4039,8 @@ vacuum_process_log_record (THREAD_ENTRY * thread_p, VACUUM_WORKER * worker, LOG_
     }
 
   /* We are here because the file that will be vacuumed is not dropped. */
-  if (!LOG_IS_MVCC_BTREE_OPERATION (log_record_data->rcvindex) && log_record_data->rcvindex != RVES_NOTIFY_VACUUM)
+  if (!LOG_IS_MVCC_BTREE_OPERATION (log_record_data->rcvindex) && log_record_data->rcvindex != RVES_NOTIFY_VACUUM
+      && log_record_data->rcvindex != RVHF_MVCC_INSERT_MULTI)
     {
       /* No need to unpack undo data */
       return NO_ERROR;
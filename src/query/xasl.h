@@ -162,11 +162,13 @@ typedef struct topn_tuples TOPN_TUPLES;
 namespace cubquery
 {
   struct aggregate_hash_context;
+  class runtime_filter;
 }
 using AGGREGATE_HASH_CONTEXT = cubquery::aggregate_hash_context;
 // *INDENT-ON*
 
 typedef struct partition_spec_node PARTITION_SPEC_TYPE;
+typedef struct partition_join_keys PARTITION_JOIN_KEYS;
 #endif /* defined (SERVER_MODE) || defined (SA_MODE) */
 
 /************************************************************************/
@@ -394,6 +396,10 @@ struct hashjoin_stats
     UINT64 fetches;
     UINT64 fetch_time;
     UINT64 ioreads;
+    UINT32 partitions;		/* pairs of partitions joined; 0 if the inputs were not partitioned */
+    UINT32 partition_levels;	/* levels of partitioning of the largest partition */
+    UINT32 partition_workers;	/* workers joining the partitions in parallel */
+    bool is_unique;		/* the join columns are unique: a probed row stops at its first match */
 
 #if defined(TEST_HASH_JOIN_PROFILE_TIME)
     struct
@@ -405,6 +411,21 @@ struct hashjoin_stats
 #endif
   } build;
 
+  /* bloom filter on the keys of the outer input, checked by the block producing the inner input */
+  struct
+  {
+    UINT64 keys;
+    UINT64 checked;
+    UINT64 filtered;
+  } runtime_filter;
+
+  /* partitions of the class scanned by the inner input, pruned with the keys of the outer input */
+  struct
+  {
+    UINT32 partitions;
+    UINT32 scanned;
+  } partition_pruning;
+
   struct
   {
     struct timeval elapsed_time;
@@ -414,6 +435,7 @@ struct hashjoin_stats
     UINT64 ioreads;
     UINT64 readkeys;
     UINT64 rows;
+    UINT64 discarded;		/* outer rows with a match, discarded by an anti join */
     UINT32 max_collisions;
 
 #if defined(TEST_HASH_JOIN_PROFILE_TIME)
@@ -533,11 +555,28 @@ struct merge_proc_node
   bool has_delete;		/* MERGE statement has DELETE */
 };
 
+#if defined (SERVER_MODE) || defined (SA_MODE)
+typedef struct cte_stats CTE_STATS;
+struct cte_stats
+{
+  UINT64 iterations;		/* executions of the recursive part */
+  UINT64 delta_rows;		/* rows added to the result by the recursive part */
+  UINT64 max_delta_rows;	/* rows added by the largest iteration */
+  UINT64 duplicate_rows;	/* rows of the recursive part that were already in the result */
+  bool dedup_sorted;		/* the result outgrew the hash set; duplicates were removed by sorting */
+};
+#endif
+
 typedef struct cte_proc_node CTE_PROC_NODE;
 struct cte_proc_node
 {
   XASL_NODE *non_recursive_part;	/* non recursive part of the CTE */
   XASL_NODE *recursive_part;	/* recursive part of the CTE */
+  bool is_distinct;		/* UNION of the parts instead of UNION ALL; rows already in the result are dropped */
+
+#if defined (SERVER_MODE) || defined (SA_MODE)
+  CTE_STATS stats;
+#endif
 };
 
 /*
@@ -586,6 +625,7 @@ struct cte_proc_node
 #define XASL_INCLUDES_TDE_CLASS	      0x10000	/* is any tde class related */
 #define XASL_SAMPLING_SCAN	      0x20000	/* is sampling scan */
 #define XASL_USES_SQ_CACHE	      0x40000	/* subquery uses result cache */
+#define XASL_HASH_ANTI_JOIN	      0x80000	/* hash left outer join keeps only the outer rows without a match */
 
 #define XASL_IS_FLAGED(x, f)        (((x)->flag & (int) (f)) != 0)
 #define XASL_SET_FLAG(x, f)         (x)->flag |= (int) (f)
@@ -1016,6 +1056,9 @@ struct orderby_stat
   bool orderby_topnsort;
   UINT64 orderby_pages;
   UINT64 orderby_ioreads;
+  UINT64 orderby_runs;		/* runs written by the sort */
+  UINT64 orderby_merge_passes;	/* passes merging the runs */
+  UINT64 orderby_spilled_pages;	/* pages written to the temp files of the sort */
 };
 
 struct groupby_stat
@@ -1023,10 +1066,17 @@ struct groupby_stat
   struct timeval groupby_time;
   UINT64 groupby_pages;
   UINT64 groupby_ioreads;
+  UINT64 groupby_runs;		/* runs written by the sort */
+  UINT64 groupby_merge_passes;	/* passes merging the runs */
+  UINT64 groupby_spilled_pages;	/* pages written to the temp files of the sort */
   int rows;
   AGGREGATE_HASH_STATE groupby_hash;
   bool run_groupby;
   bool groupby_sort;
+  UINT32 hash_partitions;	/* partitions aggregated one by one; 0 if the groups fit in memory */
+  UINT32 hash_partition_levels;	/* levels of partitioning of the largest partition */
+  UINT32 hash_workers;		/* workers computing partial aggregates in parallel */
+  UINT32 partition_wise;	/* partitions of the scanned class whose groups were complete at their end */
 };
 
 struct xasl_stat
@@ -1059,8 +1109,21 @@ struct partition_spec_node
   OID oid;			/* class oid */
   HFID hfid;			/* class hfid */
   BTID btid;			/* index id */
+  int position;			/* of the partition among the partitions of its class */
   PARTITION_SPEC_TYPE *next;	/* next partition */
 };
+
+/* values of the partition key of a class that the rows scanned must match, known before the scan opens (the keys of
+ * the outer input of a hash join); partition_prune_spec scans only the partitions holding them */
+struct partition_join_keys
+{
+  ATTR_ID attr_id;		/* partition key */
+  DB_VALUE *values;		/* keys, or their lowest and highest values if is_range */
+  int count;
+  bool is_range;		/* the keys were too many; the partitions are pruned with their range */
+  int partitions;		/* partitions left by the predicates of the spec */
+  int scanned;			/* partitions left by the keys */
+};
 #endif /* defined (SERVER_MODE) || defined (SA_MODE) */
 
 struct access_spec_node
@@ -1078,6 +1141,10 @@ struct access_spec_node
   ACCESS_SPEC_TYPE *next;	/* next access specification */
   int pruning_type;		/* how pruning should be performed on this access spec performed */
   ACCESS_SPEC_FLAG flags;	/* flags from ACCESS_SPEC_FLAG enum */
+  unsigned int pred_hash;	/* shape of where_pred for the cardinality feedback; 0 if not measured */
+  float est_selectivity;	/* selectivity of where_pred estimated by the optimizer */
+  int adaptive_join_rows;	/* outer rows expected for the inner index scan of a nested loop join; 0 if the scan
+				 * cannot switch to a hash table */
 #if defined (SERVER_MODE) || defined (SA_MODE)
   SCAN_ID s_id;			/* scan identifier */
   PARTITION_SPEC_TYPE *parts;	/* partitions of the current spec */
@@ -1085,6 +1152,9 @@ struct access_spec_node
   bool grouped_scan;		/* grouped or regular scan? it is never true!!! */
   bool fixed_scan;		/* scan pages are kept fixed? */
   bool pruned;			/* true if partition pruning has been performed */
+  PARTITION_JOIN_KEYS *join_keys;	/* join keys pruning the partitions; NULL if none */
+  ACCESS_SPEC_TYPE *partition_wise_outer;	/* outer scan of a nested loop join whose partitions are joined one by
+						 * one with the partitions of this inner scan; NULL if none */
   bool clear_value_at_clone_decache;	/* true, if need to clear s_dbval at clone decache */
 #endif				/* #if defined (SERVER_MODE) || defined (SA_MODE) */
 };
@@ -1149,6 +1219,7 @@ struct xasl_node
   int sub_host_var_count;	/* for subquery's host variable count */
   int *sub_host_var_index;	/* for subquery's host variable index */
   int sub_cache_ref_count;	/* for subquery's result-cache ref. count */
+  int px_degree;		/* degree of the exchange gathering the results of this block; 0 if serial */
 
 #if defined (ENABLE_COMPOSITE_LOCK)
   /* note: upon reactivation, you may face header cross reference issues */
@@ -1202,6 +1273,8 @@ struct xasl_node
   int next_scan_on;		/* next scan is initiated ? */
   int next_scan_block_on;	/* next scan block is initiated ? */
   int max_iterations;		/* Number of maximum iterations (used during run-time for recursive CTE) */
+  int px_id;			/* offset of the block in XASL stream; identifies the block in all clones of the XASL */
+  cubquery::runtime_filter *runtime_filter;	/* join keys the output rows are checked against; see hash join */
 #endif				/* defined (SERVER_MODE) || defined (SA_MODE) */
 };
 
@@ -452,6 +452,8 @@ xcache_entry_init (void *entry)
   xcache_entry->related_objects = NULL;
   xcache_entry->ref_count = 0;
   xcache_entry->clr_count = 0;
+  xcache_entry->exec_count = 0;
+  xcache_entry->exec_time_usec = 0;
 
   xcache_entry->sql_info.sql_hash_text = NULL;
   xcache_entry->sql_info.sql_user_text = NULL;
@@ -891,10 +893,8 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
 				 XASL_CLONE * xclone)
 {
   int error_code = NO_ERROR;
-  HL_HEAPID save_heapid = 0;
   int oid_index;
   int lock_result;
-  bool use_xasl_clone = false;
   xasl_cache_rt_check_result recompile_due_to_threshold = XASL_CACHE_RECOMPILE_NOT_NEEDED;
 
   assert (xid != NULL);
@@ -1001,38 +1001,72 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
 
   assert ((*xcache_entry) != NULL);
 
+  error_code = xcache_get_clone (thread_p, *xcache_entry, xclone);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      xcache_unfix (thread_p, *xcache_entry);
+      *xcache_entry = NULL;
+
+      xcache_log_error ("could not load XASL tree and buffer: \n"
+			XCACHE_LOG_XASL_ID_TEXT ("xasl_id") XCACHE_LOG_TRAN_TEXT,
+			XCACHE_LOG_XASL_ID_ARGS (xid), XCACHE_LOG_TRAN_ARGS (thread_p));
+
+      return error_code;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * xcache_get_clone () - Get XASL clone of a fixed cache entry. A cached clone is used if available, otherwise the XASL
+ *			 stream of entry is loaded.
+ *
+ * return	     : Error code.
+ * thread_p (in)     : Thread entry.
+ * xcache_entry (in) : Fixed XASL cache entry.
+ * xclone (out)	     : XASL clone. It must be retired with xcache_retire_clone.
+ */
+int
+xcache_get_clone (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry, XASL_CLONE * xclone)
+{
+  int error_code = NO_ERROR;
+  HL_HEAPID save_heapid = 0;
+  bool use_xasl_clone = false;
+
+  assert (xcache_entry != NULL);
+  assert (xclone != NULL);
+
   if (xcache_uses_clones ())
     {
       use_xasl_clone = true;
       /* Try to fetch a cached clone. */
-      if ((*xcache_entry)->cache_clones == NULL)
+      if (xcache_entry->cache_clones == NULL)
 	{
 	  assert_release (false);
 	  /* Fall through. */
 	}
       else
 	{
-	  (void) pthread_mutex_lock (&(*xcache_entry)->cache_clones_mutex);
-	  assert ((*xcache_entry)->n_cache_clones <= xcache_Max_clones);
-	  if ((*xcache_entry)->n_cache_clones > 0)
+	  (void) pthread_mutex_lock (&xcache_entry->cache_clones_mutex);
+	  assert (xcache_entry->n_cache_clones <= xcache_Max_clones);
+	  if (xcache_entry->n_cache_clones > 0)
 	    {
 	      /* A clone is available. */
-	      *xclone = (*xcache_entry)->cache_clones[--(*xcache_entry)->n_cache_clones];
-	      (void) pthread_mutex_unlock (&(*xcache_entry)->cache_clones_mutex);
+	      *xclone = xcache_entry->cache_clones[--xcache_entry->n_cache_clones];
+	      (void) pthread_mutex_unlock (&xcache_entry->cache_clones_mutex);
 
 	      assert (xclone->xasl != NULL && xclone->xasl_buf != NULL);
 
 	      xcache_log ("found cached clone: \n"
 			  XCACHE_LOG_ENTRY_TEXT ("entry")
-			  XCACHE_LOG_XASL_ID_TEXT ("lookup xasl_id")
 			  XCACHE_LOG_CLONE
 			  XCACHE_LOG_TRAN_TEXT,
-			  XCACHE_LOG_ENTRY_ARGS (*xcache_entry),
-			  XCACHE_LOG_XASL_ID_ARGS (xid),
+			  XCACHE_LOG_ENTRY_ARGS (xcache_entry),
 			  XCACHE_LOG_CLONE_ARGS (xclone), XCACHE_LOG_TRAN_ARGS (thread_p));
 	      return NO_ERROR;
 	    }
-	  (void) pthread_mutex_unlock (&(*xcache_entry)->cache_clones_mutex);
+	  (void) pthread_mutex_unlock (&xcache_entry->cache_clones_mutex);
 	}
       /* Clone not found. */
       /* When clones are activated, we use global heap to generate the XASL's; this way, other threads can use the
@@ -1040,8 +1074,8 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
       save_heapid = db_change_private_heap (thread_p, 0);
     }
   error_code =
-    stx_map_stream_to_xasl (thread_p, &xclone->xasl, use_xasl_clone, (*xcache_entry)->stream.buffer,
-			    (*xcache_entry)->stream.buffer_size, &xclone->xasl_buf);
+    stx_map_stream_to_xasl (thread_p, &xclone->xasl, use_xasl_clone, xcache_entry->stream.buffer,
+			    xcache_entry->stream.buffer_size, &xclone->xasl_buf);
   if (save_heapid != 0)
     {
       /* Restore heap id. */
@@ -1051,24 +1085,15 @@ xcache_find_xasl_id_for_execute (THREAD_ENTRY * thread_p, const XASL_ID * xid, X
     {
       ASSERT_ERROR ();
       assert (xclone->xasl == NULL && xclone->xasl_buf == NULL);
-      xcache_unfix (thread_p, *xcache_entry);
-      *xcache_entry = NULL;
-
-      xcache_log_error ("could not load XASL tree and buffer: \n"
-			XCACHE_LOG_XASL_ID_TEXT ("xasl_id") XCACHE_LOG_TRAN_TEXT,
-			XCACHE_LOG_XASL_ID_ARGS (xid), XCACHE_LOG_TRAN_ARGS (thread_p));
-
       return error_code;
     }
   assert (xclone->xasl != NULL && xclone->xasl_buf != NULL);
 
   xcache_log ("loaded xasl clone: \n"
 	      XCACHE_LOG_ENTRY_TEXT ("entry")
-	      XCACHE_LOG_XASL_ID_TEXT ("lookup xasl_id")
 	      XCACHE_LOG_CLONE
 	      XCACHE_LOG_TRAN_TEXT,
-	      XCACHE_LOG_ENTRY_ARGS (*xcache_entry),
-	      XCACHE_LOG_XASL_ID_ARGS (xid), XCACHE_LOG_CLONE_ARGS (xclone), XCACHE_LOG_TRAN_ARGS (thread_p));
+	      XCACHE_LOG_ENTRY_ARGS (xcache_entry), XCACHE_LOG_CLONE_ARGS (xclone), XCACHE_LOG_TRAN_ARGS (thread_p));
 
   return NO_ERROR;
 }
@@ -1967,6 +1992,7 @@ xcache_dump (THREAD_ENTRY * thread_p, FILE * fp)
   XASL_CACHE_ENTRY *xcache_entry = NULL;
   int oid_index;
   char *sql_id = NULL;
+  INT64 exec_count;
 
   assert (fp);
 
@@ -2013,6 +2039,13 @@ xcache_dump (THREAD_ENTRY * thread_p, FILE * fp)
       fprintf (fp, "  cache flags = %08x \n", xcache_entry->xasl_id.cache_flag & XCACHE_ENTRY_FLAGS_MASK);
       fprintf (fp, "  reference count = %lld \n", (long long) ATOMIC_INC_64 (&xcache_entry->ref_count, 0));
       fprintf (fp, "  time second last used = %lld \n", (long long) xcache_entry->time_last_used.tv_sec);
+      exec_count = ATOMIC_INC_64 (&xcache_entry->exec_count, 0);
+      fprintf (fp, "  execution count = %lld \n", (long long) exec_count);
+      if (exec_count > 0)
+	{
+	  fprintf (fp, "  average execution time = %lld usec \n",
+		   (long long) (ATOMIC_INC_64 (&xcache_entry->exec_time_usec, 0) / exec_count));
+	}
       if (xcache_uses_clones ())
 	{
 	  fprintf (fp, "  clone count = %d \n", xcache_entry->n_cache_clones);
@@ -2079,6 +2112,20 @@ xcache_clone_decache (THREAD_ENTRY * thread_p, XASL_CLONE * xclone)
   (void) db_change_private_heap (thread_p, save_heapid);
 }
 
+/*
+ * xcache_add_execution () - Account an execution of the plan of XASL cache entry.
+ *
+ * return	       : Void.
+ * xcache_entry (in)   : XASL cache entry.
+ * exec_time_usec (in) : Execution time.
+ */
+void
+xcache_add_execution (XASL_CACHE_ENTRY * xcache_entry, INT64 exec_time_usec)
+{
+  ATOMIC_INC_64 (&xcache_entry->exec_count, 1);
+  ATOMIC_INC_64 (&xcache_entry->exec_time_usec, exec_time_usec);
+}
+
 /*
  * xcache_retire_clone () - Retire XASL clone. If clones caches are enabled, first try to cache it in xcache_entry.
  *
@@ -2438,6 +2485,17 @@ xcache_check_recompilation_threshold (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY
 	  continue;
 	}
 
+      /* Recompile the plan when the scans of the class measured selectivities far from the estimates. */
+      if (stats_get_cardinality_feedback_time_stamp (&xcache_entry->related_objects[relobj].oid)
+	  > (unsigned int) xcache_entry->xasl_id.time_stored.sec)
+	{
+	  if (xcache_entry_set_request_recompile_flag (thread_p, xcache_entry, true))
+	    {
+	      recompile = true;
+	    }
+	  break;
+	}
+
       if (xcache_entry->related_objects[relobj].tcard >= XCACHE_RT_MAX_THRESHOLD)
 	{
 	  continue;
@@ -111,6 +111,8 @@ struct xasl_cache_ent
   struct timeval time_last_used;	/* when this entry used lastly */
   INT64 ref_count;		/* how many times this entry used */
   INT64 clr_count;		/* how many times related qfile caches are clear */
+  INT64 exec_count;		/* how many times the plan was executed (results from the list cache aside) */
+  INT64 exec_time_usec;		/* and how long these executions took */
   int list_ht_no;		/* memory hash table for query result(list file) cache generated by this XASL
 				 * referencing by DB_VALUE parameters bound to the result */
   bool free_data_on_uninit;	/* set to free entry data on uninit. */
@@ -169,7 +171,9 @@ extern void xcache_dump (THREAD_ENTRY * thread_p, FILE * fp);
 
 extern bool xcache_can_entry_cache_list (XASL_CACHE_ENTRY * xcache_entry);
 
+extern int xcache_get_clone (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry, XASL_CLONE * xclone);
 extern void xcache_retire_clone (THREAD_ENTRY * thread_p, XASL_CACHE_ENTRY * xcache_entry, XASL_CLONE * xclone);
+extern void xcache_add_execution (XASL_CACHE_ENTRY * xcache_entry, INT64 exec_time_usec);
 extern int xcache_get_entry_count (void);
 extern bool xcache_uses_clones (void);
 
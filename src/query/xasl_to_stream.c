@@ -3157,6 +3157,8 @@ xts_process_xasl_node (char *ptr, const XASL_NODE * xasl)
 
   ptr = or_pack_int (ptr, xasl->mvcc_reev_extra_cls_cnt);
 
+  ptr = or_pack_int (ptr, xasl->px_degree);
+
   if (xasl->sub_xasl_id == NULL)
     {
       ptr = or_pack_int (ptr, 0);
@@ -3765,6 +3767,8 @@ xts_process_cte_proc (char *ptr, const CTE_PROC_NODE * cte_proc)
     }
   ptr = or_pack_int (ptr, offset);
 
+  ptr = or_pack_int (ptr, cte_proc->is_distinct ? 1 : 0);
+
   return ptr;
 }
 
@@ -4708,6 +4712,10 @@ xts_process_access_spec_type (char *ptr, const ACCESS_SPEC_TYPE * access_spec)
 
   ptr = or_pack_int (ptr, access_spec->flags);
 
+  ptr = or_pack_int (ptr, (int) access_spec->pred_hash);
+  ptr = or_pack_float (ptr, access_spec->est_selectivity);
+  ptr = or_pack_int (ptr, access_spec->adaptive_join_rows);
+
   return ptr;
 }
 
@@ -5730,6 +5738,12 @@ xts_process_analytic_type (char *ptr, const ANALYTIC_TYPE * analytic)
 
   ptr = or_pack_int (ptr, analytic->is_const_operand);
 
+  ptr = or_pack_int (ptr, analytic->has_frame);
+
+  ptr = or_pack_int (ptr, analytic->frame_start);
+
+  ptr = or_pack_int (ptr, analytic->frame_end);
+
   if (analytic->function == PT_PERCENTILE_CONT || analytic->function == PT_PERCENTILE_DISC)
     {
       offset = xts_save_regu_variable (analytic->info.percentile.percentile_reguvar);
@@ -6088,7 +6102,8 @@ xts_sizeof_xasl_node (const XASL_NODE * xasl)
 	   + PTR_SIZE		/* iscycle_regu */
 	   + OR_INT_SIZE	/* scan_op_type */
 	   + OR_INT_SIZE	/* upd_del_class_cnt */
-	   + OR_INT_SIZE);	/* mvcc_reev_extra_cls_cnt */
+	   + OR_INT_SIZE	/* mvcc_reev_extra_cls_cnt */
+	   + OR_INT_SIZE);	/* px_degree */
 
   size += OR_INT_SIZE;		/* number of access specs in spec_list */
   for (access_spec = xasl->spec_list; access_spec; access_spec = access_spec->next)
@@ -6652,7 +6667,8 @@ xts_sizeof_cte_proc (const CTE_PROC_NODE * cte_info)
 
   size += (PTR_SIZE		/* non_recursive_part */
 	   + PTR_SIZE		/* recursive_part */
-	   + PTR_SIZE);		/* list_id */
+	   + PTR_SIZE		/* list_id */
+	   + OR_INT_SIZE);	/* is_distinct */
 
   return size;
 }
@@ -7000,7 +7016,10 @@ xts_sizeof_access_spec_type (const ACCESS_SPEC_TYPE * access_spec)
 	   + OR_INT_SIZE	/* qualified_scan */
 	   + OR_INT_SIZE	/* single_fetch */
 	   + OR_INT_SIZE	/* needs pruning */
-	   + PTR_SIZE);		/* s_dbval */
+	   + PTR_SIZE		/* s_dbval */
+	   + OR_INT_SIZE	/* pred_hash */
+	   + OR_FLOAT_SIZE	/* est_selectivity */
+	   + OR_INT_SIZE);	/* adaptive_join_rows */
 
   return size;
 }
@@ -7586,7 +7605,10 @@ xts_sizeof_analytic_type (const ANALYTIC_TYPE * analytic)
 	   + OR_INT_SIZE	/* flag */
 	   + OR_INT_SIZE	/* from_last */
 	   + OR_INT_SIZE	/* ignore_nulls */
-	   + OR_INT_SIZE);	/* is_const_opr */
+	   + OR_INT_SIZE	/* is_const_opr */
+	   + OR_INT_SIZE	/* has_frame */
+	   + OR_INT_SIZE	/* frame_start */
+	   + OR_INT_SIZE);	/* frame_end */
 
   tmp_size = xts_sizeof_regu_variable (&analytic->operand);
   if (tmp_size == ER_FAILED)
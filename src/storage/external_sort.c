@@ -50,8 +50,14 @@
 #include "server_support.h"
 #include "thread_entry_task.hpp"
 #include "thread_manager.hpp"	// for thread_get_thread_entry_info and thread_sleep
+#include "parallel_query.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <vector>
 // XXX: SHOULD BE THE LAST INCLUDE HEADER
 #include "memory_wrapper.hpp"
 
@@ -83,6 +89,9 @@
 
 #define SORT_SWAP_PTR(a,b) { char **temp; temp = a; a = b; b = temp; }
 
+/* Groups of records smaller than this are sorted by comparisons by the radix sort of key prefixes */
+#define SORT_RADIX_MIN_RECORDS 32
+
 #define SORT_CHECK_DUPLICATE(a, b)  \
     do {                          \
         if (cmp == 0) {           \
@@ -166,6 +175,7 @@ struct sort_param
   /* Comparison function to use in the internal sorting and the merging phases */
   SORT_CMP_FUNC *cmp_fn;
   void *cmp_arg;
+  SORT_KEY_PREFIX_FUNC *key_prefix_fn;	/* normalized key prefix of a record; NULL if records have none */
   SORT_DUP_OPTION option;
 
   /* output function to apply on temporary records */
@@ -243,6 +253,126 @@ struct sort_stack
 typedef void FIND_RUN_FN (char **, long *, SORT_STACK *, long, SORT_CMP_FUNC *, void *);
 typedef void MERGE_RUN_FN (char **, char **, SORT_STACK *, SORT_CMP_FUNC *, void *);
 
+/* Size of the batches of records that the workers of a range-partitioned final merge hand over to the requester */
+#define SORT_PX_BATCH_SIZE (64 * ONE_K)
+
+/* Records sampled from each input run for each key range of a range-partitioned final merge */
+#define SORT_PX_SAMPLES_PER_RANGE 8
+
+/* Records merged between two checks whether the parallel merge is stopped */
+#define SORT_PX_CHECK_INTERVAL 1024
+
+typedef enum
+{
+  SORT_READ_IDLE,		/* not requested, or read and consumed */
+  SORT_READ_QUEUED,		/* waits for the read-ahead worker */
+  SORT_READ_RUNNING,		/* being read by the read-ahead worker */
+  SORT_READ_DONE		/* read by the read-ahead worker */
+} SORT_READ_STATE;
+
+typedef struct sort_read_request SORT_READ_REQUEST;
+struct sort_read_request
+{				/* read of successive pages of a run into an input section */
+  VFID *vfid;
+  int first_page;
+  int num_pages;		/* 0 if nothing is left to read */
+  char *area;
+  SORT_READ_STATE state;	/* access through the mutex of the read-ahead */
+  int error;			/* error of the read-ahead worker */
+};
+
+typedef struct sort_run_input SORT_RUN_INPUT;
+struct sort_run_input
+{				/* run merged by a merge task */
+  VFID *vfid;			/* temp file of the run */
+  int first_page;		/* first page of the run in the file */
+  int num_pages;		/* size of the run */
+};
+
+typedef struct sort_run_reader SORT_RUN_READER;
+struct sort_run_reader
+{				/* records of an input run, read in two halves of an input section */
+  SORT_RUN_INPUT run;
+  int next_page;		/* next page of the run to read, relative to its first page */
+  int half_pages;		/* size of each half of the input section */
+  char *halves[2];
+  SORT_READ_REQUEST requests[2];	/* pages read into each half */
+  int cur_half;			/* half being merged; the other one is read ahead */
+  int cur_buf;			/* page of the current half */
+  int cur_slot;			/* record of the current page */
+  int num_slots;		/* records of the current page */
+  RECDES page_recdes;		/* current record as stored on its page */
+  RECDES recdes;		/* current record; retrieved from the overflow file for REC_BIGONE records */
+  RECDES long_recdes;
+  bool is_end;			/* all records of the run are merged */
+};
+
+typedef struct sort_run_writer SORT_RUN_WRITER;
+struct sort_run_writer
+{				/* output run written through an output section */
+  VFID *vfid;
+  int next_page;		/* page of the file the output section is flushed to */
+  char *area;			/* output section */
+  int area_pages;
+  int cur_buf;			/* page of the output section receiving records */
+  int num_pages;		/* pages flushed to the file */
+  bool tde_encrypted;
+};
+
+typedef struct sort_merge_task SORT_MERGE_TASK;
+struct sort_merge_task
+{				/* merge of input runs into an output run, or into a key range of the final output */
+  SORT_RUN_INPUT inputs[SORT_MAX_HALF_FILES];
+  int num_inputs;
+  int out_file;			/* temp file receiving the output run; -1 for the final merge */
+  int out_pages;		/* size of the output run */
+  char *lower_key;		/* final merge: records up to this key belong to the previous range; NULL for first */
+  char *upper_key;		/* final merge: records after this key belong to the next range; NULL for last */
+};
+
+typedef int SORT_MERGE_OUT_FUNC (THREAD_ENTRY * thread_p, RECDES * page_recdes, RECDES * recdes, void *arg);
+
+// *INDENT-OFF*
+typedef struct sort_prefetcher SORT_PREFETCHER;
+struct sort_prefetcher
+{				/* read-ahead of the pages of the runs merged by a pass, done by a dedicated worker */
+  std::mutex mutex;
+  std::condition_variable cond;	/* a request is queued or read, or no merge is left */
+  std::deque<SORT_READ_REQUEST *> queue;	/* requests in SORT_READ_QUEUED state */
+  int num_users;		/* merges that may still queue requests */
+};
+
+typedef struct sort_px_merge SORT_PX_MERGE;
+struct sort_px_merge
+{				/* merge pass executed by parallel workers */
+  SORT_PARAM *sort_param;
+  SORT_MERGE_TASK *tasks;
+  int num_tasks;
+  bool is_final;		/* tasks are the key ranges of the final merge */
+  bool use_workers;		/* tasks are executed by workers; otherwise by the requester */
+  int num_merges;		/* merges executed at once */
+  int memory_pages;		/* internal memory of each merge */
+  int out_half;
+  SORT_PREFETCHER prefetcher;
+  cubquery::px_exchange *exchange;
+
+  std::mutex mutex;
+  std::condition_variable cond;	/* a batch is produced or consumed, a range ends, or the pass is stopped */
+  bool stop;
+  std::vector<std::deque<std::vector<char>>> ranges;	/* final merge: merged batches of each key range */
+  std::vector<bool> range_ended;
+  size_t max_range_batches;
+};
+
+typedef struct sort_px_range_output SORT_PX_RANGE_OUTPUT;
+struct sort_px_range_output
+{				/* output of a key range of the final merge */
+  SORT_PX_MERGE *px;
+  int range;
+  std::vector<char> batch;
+};
+// *INDENT-ON*
+
 #if !defined(NDEBUG)
 static int sort_validate (char **vector, long size, SORT_CMP_FUNC * compare, void *comp_arg);
 #endif
@@ -257,6 +387,50 @@ static int sort_inphase_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param,
 			      void *arguments, unsigned int *total_numrecs);
 static int sort_exphase_merge_elim_dup (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param);
 static int sort_exphase_merge (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param);
+static int sort_px_exphase_merge (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, bool * is_merged);
+static int sort_px_final_merge (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_PX_MERGE * px,
+				int act_infiles, int num_merge_workers);
+static int sort_px_get_memory_pages (SORT_PARAM * sort_param, int num_inputs, bool has_output, int *num_merges);
+static int sort_px_execute (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px);
+static void sort_px_merge_worker (THREAD_ENTRY * thread_p, int worker_id, SORT_PX_MERGE * px);
+static int sort_px_merge_execute (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px, int merge_id);
+static int sort_px_output_ranges (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px);
+static void sort_px_stop (SORT_PX_MERGE * px);
+static bool sort_px_is_stopped (SORT_PX_MERGE * px);
+// *INDENT-OFF*
+static bool sort_px_range_produce (SORT_PX_MERGE * px, int range, std::vector<char> &batch);
+// *INDENT-ON*
+static void sort_px_range_end (SORT_PX_MERGE * px, int range);
+// *INDENT-OFF*
+static bool sort_px_range_consume (SORT_PX_MERGE * px, int range, std::vector<char> &batch);
+// *INDENT-ON*
+static int sort_px_put_range (THREAD_ENTRY * thread_p, RECDES * page_recdes, RECDES * recdes, void *arg);
+static int sort_px_put_output (THREAD_ENTRY * thread_p, RECDES * page_recdes, RECDES * recdes, void *arg);
+// *INDENT-OFF*
+static int sort_px_find_splitters (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_RUN_INPUT * inputs,
+				   int num_inputs, int num_ranges, std::vector<char *> &splitters);
+// *INDENT-ON*
+static int sort_px_find_start_page (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_RUN_INPUT * input,
+				    char *lower_key, char *page, int *start_page);
+static int sort_px_read_first_record (THREAD_ENTRY * thread_p, SORT_RUN_INPUT * input, int page_no, char *page,
+				      RECDES * long_recdes, RECDES * recdes);
+static int sort_merge_runs (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px, SORT_MERGE_TASK * task, char *memory,
+			    int half_pages, SORT_MERGE_OUT_FUNC * out_fn, void *out_arg);
+static int sort_run_reader_open (THREAD_ENTRY * thread_p, SORT_RUN_READER * reader, SORT_RUN_INPUT * run,
+				 int start_page, char *area, int half_pages, SORT_PREFETCHER * prefetcher);
+static int sort_run_reader_next (THREAD_ENTRY * thread_p, SORT_RUN_READER * reader, SORT_PREFETCHER * prefetcher);
+static void sort_run_reader_request (SORT_RUN_READER * reader, int half, SORT_PREFETCHER * prefetcher);
+static void sort_run_reader_close (SORT_RUN_READER * reader, SORT_PREFETCHER * prefetcher);
+static void sort_run_writer_init (SORT_RUN_WRITER * writer, VFID * vfid, int first_page, char *area, int area_pages,
+				  bool tde_encrypted);
+static int sort_run_writer_put (THREAD_ENTRY * thread_p, RECDES * page_recdes, RECDES * recdes, void *arg);
+static int sort_run_writer_flush (THREAD_ENTRY * thread_p, SORT_RUN_WRITER * writer);
+static void sort_read_ahead (SORT_PREFETCHER * prefetcher, SORT_READ_REQUEST * request, VFID * vfid, int first_page,
+			     int num_pages, char *area);
+static int sort_read_wait (THREAD_ENTRY * thread_p, SORT_PREFETCHER * prefetcher, SORT_READ_REQUEST * request);
+static void sort_read_cancel (SORT_PREFETCHER * prefetcher, SORT_READ_REQUEST * request);
+static void sort_prefetcher_execute (THREAD_ENTRY * thread_p, SORT_PREFETCHER * prefetcher);
+static void sort_prefetcher_release (SORT_PREFETCHER * prefetcher);
 static int sort_get_avg_numpages_of_nonempty_tmpfile (SORT_PARAM * sort_param);
 static void sort_return_used_resources (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param);
 static int sort_add_new_file (THREAD_ENTRY * thread_p, VFID * vfid, int file_pg_cnt_est, bool force_alloc,
@@ -273,6 +447,8 @@ static int sort_find_inbuf_size (int tot_buffers, int in_sections);
 static char *sort_retrieve_longrec (THREAD_ENTRY * thread_p, RECDES * address, RECDES * memory);
 static char **sort_run_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, char **base, long limit,
 			     long sort_numrecs, char **otherbase, long *srun_limit);
+static void sort_radix_sort (SORT_PARAM * sort_param, char **base, char **work, long count, int depth);
+static void sort_insertion_sort (SORT_PARAM * sort_param, char **base, long count);
 static int sort_run_add_new (FILE_CONTENTS * file_contents, int num_pages);
 static void sort_run_remove_first (FILE_CONTENTS * file_contents);
 static void sort_run_flip (char **start, char **stop);
@@ -1190,6 +1366,12 @@ sort_run_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, char **base, lo
       return base;
     }
 
+  if (sort_param->key_prefix_fn != NULL)
+    {
+      /* order the records on their key prefixes first; the runs found below are then few and long */
+      sort_radix_sort (sort_param, base, otherbase, limit, 0);
+    }
+
   /* init */
   compare = sort_param->cmp_fn;
   comp_arg = sort_param->cmp_arg;
@@ -1301,6 +1483,104 @@ sort_run_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, char **base, lo
   return result;
 }
 
+/*
+ * sort_radix_sort () - Most significant byte first radix sort of records on their normalized key prefixes
+ *   return: void
+ *   sort_param(in): sort parameters
+ *   base(in/out): records to sort
+ *   work(in): area of count records
+ *   count(in): number of records
+ *   depth(in): byte of the key prefixes the records are distributed on; the previous bytes are equal
+ *
+ * Note: A group of records whose prefixes are equal up to the length of one of them is left as it is, to be ordered
+ *       by the merge sort of the run. Records with equal keys are left for the merge sort too, which handles the
+ *       duplicates.
+ */
+static void
+sort_radix_sort (SORT_PARAM * sort_param, char **base, char **work, long count, int depth)
+{
+  SORT_KEY_PREFIX_FUNC *prefix_fn = sort_param->key_prefix_fn;
+  void *prefix_arg = sort_param->cmp_arg;
+  const unsigned char *prefix;
+  long ends[256];
+  long start, i;
+  int byte;
+
+  if (count < SORT_RADIX_MIN_RECORDS)
+    {
+      sort_insertion_sort (sort_param, base, count);
+      return;
+    }
+
+  memset (ends, 0, sizeof (ends));
+  for (i = 0; i < count; i++)
+    {
+      prefix = (*prefix_fn) ((SORT_REC *) base[i], prefix_arg);
+      if (SORT_KEY_PREFIX_LENGTH (prefix) <= depth)
+	{
+	  return;
+	}
+      ends[prefix[depth]]++;
+    }
+
+  for (byte = 0; byte < 256; byte++)
+    {
+      if (ends[byte] == count)
+	{
+	  /* all records have the same byte */
+	  sort_radix_sort (sort_param, base, work, count, depth + 1);
+	  return;
+	}
+    }
+
+  /* ends[byte] becomes the start of the records having the byte, then their end as they are distributed */
+  for (byte = 0, start = 0; byte < 256; byte++)
+    {
+      i = ends[byte];
+      ends[byte] = start;
+      start += i;
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      prefix = (*prefix_fn) ((SORT_REC *) base[i], prefix_arg);
+      work[ends[prefix[depth]]++] = base[i];
+    }
+  memcpy (base, work, count * sizeof (char *));
+
+  for (byte = 0, start = 0; byte < 256; start = ends[byte], byte++)
+    {
+      if (ends[byte] - start > 1)
+	{
+	  sort_radix_sort (sort_param, base + start, work + start, ends[byte] - start, depth + 1);
+	}
+    }
+}
+
+/*
+ * sort_insertion_sort () - Sort a small group of records by comparisons
+ *   return: void
+ *   sort_param(in): sort parameters
+ *   base(in/out): records to sort
+ *   count(in): number of records
+ */
+static void
+sort_insertion_sort (SORT_PARAM * sort_param, char **base, long count)
+{
+  char *record;
+  long i, j;
+
+  for (i = 1; i < count; i++)
+    {
+      record = base[i];
+      for (j = i; j > 0 && (*sort_param->cmp_fn) (&base[j - 1], &record, sort_param->cmp_arg) > 0; j--)
+	{
+	  base[j] = base[j - 1];
+	}
+      base[j] = record;
+    }
+}
+
 /*
  * sort_listfile () - Perform sorting
  *   return:
@@ -1333,6 +1613,11 @@ sort_run_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, char **base, lo
  *               second, 1 means the second precedes the first, and 0 means
  *               neither precedes the other.
  *   cmp_arg(in): arguments to the cmp_fn function
+ *   key_prefix_fn(in): user-supplied function returning the normalized key
+ *               prefix (see SORT_KEY_PREFIX_SIZE) of a record, called with
+ *               cmp_arg; in-memory runs are then radix sorted on the
+ *               prefixes before they are merge sorted. NULL if records have
+ *               no prefix.
  *   option(in):
  *   limit(in):  optional arg, can represent the limit clause. If we only want
  *               the top K elements of a processed list, it makes sense to use
@@ -1346,8 +1631,8 @@ sort_run_sort (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, char **base, lo
  */
 int
 sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GET_FUNC * get_fn, void *get_arg,
-	       SORT_PUT_FUNC * put_fn, void *put_arg, SORT_CMP_FUNC * cmp_fn, void *cmp_arg, SORT_DUP_OPTION option,
-	       int limit, bool includes_tde_class)
+	       SORT_PUT_FUNC * put_fn, void *put_arg, SORT_CMP_FUNC * cmp_fn, void *cmp_arg,
+	       SORT_KEY_PREFIX_FUNC * key_prefix_fn, SORT_DUP_OPTION option, int limit, bool includes_tde_class)
 {
   int error = NO_ERROR;
   SORT_PARAM *sort_param = NULL;
@@ -1356,6 +1641,7 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GE
   int i;
   int file_pg_cnt_est;
   unsigned int total_numrecs = 0;
+  bool is_merged = false;
 #if defined(SERVER_MODE)
   int num_cpus;
   int rv;
@@ -1390,6 +1676,7 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GE
 
   sort_param->cmp_fn = cmp_fn;
   sort_param->cmp_arg = cmp_arg;
+  sort_param->key_prefix_fn = key_prefix_fn;
   sort_param->option = option;
 
   sort_param->put_fn = put_fn;
@@ -1538,14 +1825,18 @@ sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GE
 	    }
 	}
 
-      if (sort_param->option == SORT_ELIM_DUP)
-	{
-	  error = sort_exphase_merge_elim_dup (thread_p, sort_param);
-	}
-      else
+      error = sort_px_exphase_merge (thread_p, sort_param, &is_merged);
+      if (error == NO_ERROR && !is_merged)
 	{
-	  /* SORT_DUP */
-	  error = sort_exphase_merge (thread_p, sort_param);
+	  if (sort_param->option == SORT_ELIM_DUP)
+	    {
+	      error = sort_exphase_merge_elim_dup (thread_p, sort_param);
+	    }
+	  else
+	    {
+	      /* SORT_DUP */
+	      error = sort_exphase_merge (thread_p, sort_param);
+	    }
 	}
     }				/* if (sort_param->tot_runs > 1) */
 
@@ -2786,6 +3077,7 @@ sort_run_flush (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, int out_file,
     }
 
   sort_param->tot_runs++;
+  perfmon_inc_stat (thread_p, PSTAT_SORT_NUM_RUNS);
 
   return NO_ERROR;
 }
@@ -2947,6 +3239,8 @@ sort_exphase_merge_elim_dup (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
   /* While there are more than one input files with different runs to merge */
   while ((act_infiles = sort_get_numpages_of_active_infiles (sort_param)) > 1)
     {
+      perfmon_inc_stat (thread_p, PSTAT_SORT_NUM_MERGE_PASSES);
+
       /* Check if output files has enough pages; if not allocate new pages */
       error = sort_checkalloc_numpages_of_outfiles (thread_p, sort_param);
       if (error != NO_ERROR)
@@ -3729,6 +4023,8 @@ sort_exphase_merge (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
   /* While there are more than one input files with different runs to merge */
   while ((act_infiles = sort_get_numpages_of_active_infiles (sort_param)) > 1)
     {
+      perfmon_inc_stat (thread_p, PSTAT_SORT_NUM_MERGE_PASSES);
+
       /* Check if output files has enough pages; if not allocate new pages */
       error = sort_checkalloc_numpages_of_outfiles (thread_p, sort_param);
       if (error != NO_ERROR)
@@ -4368,121 +4664,1516 @@ bailout:
 /* AUXILIARY FUNCTIONS */
 
 /*
- * sort_get_avg_numpages_of_nonempty_tmpfile () - Return average number of pages
- *                                       currently occupied by nonempty
- *                                       temporary file
- *   return:
- *   sort_param(in): Sort paramater
+ * sort_px_exphase_merge () - Merge phase executed by parallel workers
+ *   return: NO_ERROR, or error code
+ *   sort_param(in): sort parameters
+ *   is_merged(out): false if no worker could be reserved; the merge phase must be executed serially
+ *
+ * Note: The output runs of a pass are independent merges. The output files of
+ *       the pass are shared out among the workers, which merge the runs of
+ *       their files one after the other. The final merge is partitioned by key
+ *       range: splitters sampled from the input runs cut the keys into one
+ *       range per worker, and the requester puts the merged ranges in order
+ *       while the workers merge the next ones.
+ *
+ *       One more worker reads ahead the pages of the runs: the input section
+ *       of each run is split in two halves, one being merged while the next
+ *       pages of the run are read into the other one. The temp files are
+ *       created by the requester before the merge phase; workers only read and
+ *       write their pages.
  */
 static int
-sort_get_avg_numpages_of_nonempty_tmpfile (SORT_PARAM * sort_param)
+sort_px_exphase_merge (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, bool * is_merged)
 {
-  int f;
-  int sum, i;
-  int nonempty_temp_file_num = 0;
+  SORT_PX_MERGE px;
+  // *INDENT-OFF*
+  std::vector<SORT_MERGE_TASK> tasks;
+  // *INDENT-ON*
+  SORT_MERGE_TASK *task;
+  SORT_RUN_INPUT *input;
+  FILE_CONTENTS *contents;
+  int start_page[2 * SORT_MAX_HALF_FILES];
+  int degree;
+  int num_merge_workers;
+  int act_infiles;
+  int num_runs;
+  int out_half;
+  int temp;
+  int i, k;
+  int error = NO_ERROR;
 
-  sum = 0;
-  for (i = 0; i < sort_param->tot_tempfiles; i++)
+  *is_merged = false;
+
+  /* each merge needs two pages for each input run and an output page */
+  if (prm_get_integer_value (PRM_ID_PARALLEL_SORT_DEGREE) <= 0
+      || sort_param->tot_buffers < 2 * sort_param->half_files + 1)
     {
-      /* If the list is not empty */
-      f = sort_param->file_contents[i].first_run;
-      if (f > -1)
+      return NO_ERROR;
+    }
+
+  /* one more worker reads ahead */
+  degree = cubquery::px_reserve_workers (prm_get_integer_value (PRM_ID_PARALLEL_SORT_DEGREE) + 1);
+  if (degree <= 0)
+    {
+      return NO_ERROR;
+    }
+  num_merge_workers = degree - 1;
+  *is_merged = true;
+
+  px.sort_param = sort_param;
+  px.exchange = NULL;
+
+  if (sort_param->in_half == 0)
+    {
+      out_half = sort_param->half_files;
+    }
+  else
+    {
+      out_half = 0;
+    }
+
+  /* While there are more than one input files with different runs to merge */
+  while ((act_infiles = sort_get_numpages_of_active_infiles (sort_param)) > 1)
+    {
+      perfmon_inc_stat (thread_p, PSTAT_SORT_NUM_MERGE_PASSES);
+
+      num_runs = 0;
+      for (i = sort_param->in_half; i < sort_param->in_half + act_infiles; i++)
 	{
-	  nonempty_temp_file_num++;
-	  for (; f <= sort_param->file_contents[i].last_run; f++)
+	  num_runs = MAX (num_runs, sort_get_num_file_contents (&sort_param->file_contents[i]));
+	}
+
+      if (num_runs == 1)
+	{
+	  error = sort_px_final_merge (thread_p, sort_param, &px, act_infiles, num_merge_workers);
+	  break;
+	}
+
+      /* Check if output files has enough pages; if not allocate new pages */
+      error = sort_checkalloc_numpages_of_outfiles (thread_p, sort_param);
+      if (error != NO_ERROR)
+	{
+	  break;
+	}
+
+      /* output run k merges the k-th runs of the input files and is written to output file k % half_files */
+      tasks.resize (num_runs);
+      for (i = 0; i < (int) DIM (start_page); i++)
+	{
+	  start_page[i] = 0;
+	}
+      for (k = 0; k < num_runs; k++)
+	{
+	  task = &tasks[k];
+	  task->num_inputs = 0;
+	  for (i = sort_param->in_half; i < sort_param->in_half + act_infiles; i++)
 	    {
-	      sum += sort_param->file_contents[i].num_pages[f];
+	      contents = &sort_param->file_contents[i];
+	      if (sort_get_num_file_contents (contents) <= k)
+		{
+		  continue;
+		}
+
+	      input = &task->inputs[task->num_inputs++];
+	      input->vfid = &sort_param->temp[i];
+	      input->first_page = start_page[i];
+	      input->num_pages = contents->num_pages[contents->first_run + k];
+	      start_page[i] += input->num_pages;
+	    }
+	  task->out_file = out_half + k % sort_param->half_files;
+	  task->out_pages = 0;
+	  task->lower_key = NULL;
+	  task->upper_key = NULL;
+	}
+
+      px.tasks = tasks.data ();
+      px.num_tasks = num_runs;
+      px.is_final = false;
+      px.use_workers = (num_merge_workers > 0);
+      px.num_merges = MIN (MAX (num_merge_workers, 1), MIN (sort_param->half_files, num_runs));
+      px.memory_pages = sort_px_get_memory_pages (sort_param, act_infiles, true, &px.num_merges);
+      px.out_half = out_half;
+
+      error = sort_px_execute (thread_p, &px);
+      if (error != NO_ERROR)
+	{
+	  break;
+	}
+
+      /* all runs of the input files are merged; add the output runs to the output files in order */
+      for (i = sort_param->in_half; i < sort_param->in_half + sort_param->half_files; i++)
+	{
+	  while (sort_param->file_contents[i].first_run != -1)
+	    {
+	      sort_run_remove_first (&sort_param->file_contents[i]);
 	    }
 	}
+      for (k = 0; k < num_runs && error == NO_ERROR; k++)
+	{
+	  error = sort_run_add_new (&sort_param->file_contents[tasks[k].out_file], tasks[k].out_pages);
+	}
+      if (error != NO_ERROR)
+	{
+	  break;
+	}
+
+      /* Exchange input and output file indices */
+      temp = sort_param->in_half;
+      sort_param->in_half = out_half;
+      out_half = temp;
     }
 
-  return (sum / MAX (1, nonempty_temp_file_num));
+  cubquery::px_release_workers (degree);
+
+  return (error == SORT_PUT_STOP) ? NO_ERROR : error;
 }
 
 /*
- * sort_return_used_resources () - Return system resource used for sorting
- *   return: void
- *   sort_param(in): Sort paramater
- *
- * Note: Clear the sort parameter structure by deallocating any allocated
- *       memory areas and destroying any temporary files and volumes.
+ * sort_px_final_merge () - Final merge of the parallel merge phase
+ *   return: NO_ERROR, SORT_PUT_STOP, or error code
+ *   sort_param(in): sort parameters
+ *   px(in): parallel merge
+ *   act_infiles(in): input files; each has a single run
+ *   num_merge_workers(in): workers that may merge key ranges
  */
-static void
-sort_return_used_resources (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
+static int
+sort_px_final_merge (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_PX_MERGE * px, int act_infiles,
+		     int num_merge_workers)
 {
-  int k;
-#if defined(SERVER_MODE)
-  int rv;
-#endif /* SERVER_MODE */
-
-  if (sort_param == NULL)
-    {
-      return;			/* nop */
-    }
+  // *INDENT-OFF*
+  std::vector<SORT_MERGE_TASK> tasks;
+  std::vector<char *> splitters;
+  // *INDENT-ON*
+  SORT_RUN_INPUT inputs[SORT_MAX_HALF_FILES];
+  FILE_CONTENTS *contents;
+  int num_ranges;
+  int i, r;
+  int error = NO_ERROR;
 
-  if (sort_param->internal_memory)
+  for (i = 0; i < act_infiles; i++)
     {
-      free_and_init (sort_param->internal_memory);
+      contents = &sort_param->file_contents[sort_param->in_half + i];
+      inputs[i].vfid = &sort_param->temp[sort_param->in_half + i];
+      inputs[i].first_page = 0;
+      inputs[i].num_pages = contents->num_pages[contents->first_run];
     }
 
-  for (k = 0; k < sort_param->tot_tempfiles; k++)
+  num_ranges = MAX (num_merge_workers, 1);
+  (void) sort_px_get_memory_pages (sort_param, act_infiles, false, &num_ranges);
+  if (num_ranges > 1)
     {
-      if (sort_param->temp[k].volid != NULL_VOLID)
+      error = sort_px_find_splitters (thread_p, sort_param, inputs, act_infiles, num_ranges, splitters);
+      if (error != NO_ERROR)
 	{
-	  (void) file_temp_retire (thread_p, &sort_param->temp[k]);
+	  goto end;
 	}
+      num_ranges = (int) splitters.size () + 1;
     }
 
-  if (sort_param->multipage_file.volid != NULL_VOLID)
+  tasks.resize (num_ranges);
+  for (r = 0; r < num_ranges; r++)
     {
-      (void) file_temp_retire (thread_p, &(sort_param->multipage_file));
+      memcpy (tasks[r].inputs, inputs, act_infiles * sizeof (SORT_RUN_INPUT));
+      tasks[r].num_inputs = act_infiles;
+      tasks[r].out_file = -1;
+      tasks[r].out_pages = 0;
+      tasks[r].lower_key = (r > 0) ? splitters[r - 1] : NULL;
+      tasks[r].upper_key = (r < num_ranges - 1) ? splitters[r] : NULL;
     }
 
-  for (k = 0; k < sort_param->tot_tempfiles; k++)
-    {
-      if (sort_param->file_contents[k].num_pages != NULL)
-	{
-	  db_private_free_and_init (thread_p, sort_param->file_contents[k].num_pages);
-	}
-    }
+  px->tasks = tasks.data ();
+  px->num_tasks = num_ranges;
+  px->is_final = true;
+  px->use_workers = (num_merge_workers > 0);
+  px->num_merges = num_ranges;
+  px->memory_pages = sort_param->tot_buffers / num_ranges;
+  px->out_half = -1;
+  /* a range may be merged ahead of the output by as much memory as its merge uses */
+  px->max_range_batches = MAX (2, (size_t) px->memory_pages * DB_PAGESIZE / SORT_PX_BATCH_SIZE);
 
-  if (sort_param->px_array)
+  error = sort_px_execute (thread_p, px);
+
+end:
+  for (i = 0; i < (int) splitters.size (); i++)
     {
-      free_and_init (sort_param->px_array);
+      free (splitters[i] - SORT_RECORD_LENGTH_SIZE);
     }
-  sort_param->px_height_max = sort_param->px_array_size = 0;
 
-#if defined(SERVER_MODE)
-  rv = pthread_mutex_destroy (&(sort_param->px_mtx));
-  if (rv != 0)
+  return error;
+}
+
+/*
+ * sort_px_get_memory_pages () - Share out the internal memory among the merges executed at once
+ *   return: internal memory of each merge, in pages
+ *   sort_param(in): sort parameters
+ *   num_inputs(in): input runs of each merge
+ *   has_output(in): whether merges write output runs
+ *   num_merges(in/out): merges executed at once; reduced if each merge would not get the memory it needs
+ */
+static int
+sort_px_get_memory_pages (SORT_PARAM * sort_param, int num_inputs, bool has_output, int *num_merges)
+{
+  int needed_pages = 2 * num_inputs + (has_output ? 1 : 0);
+
+  while (*num_merges > 1 && sort_param->tot_buffers / *num_merges < needed_pages)
     {
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_MUTEX_DESTROY, 0);
+      (*num_merges)--;
     }
-#endif
 
-  free_and_init (sort_param);
+  return sort_param->tot_buffers / *num_merges;
 }
 
 /*
- * sort_add_new_file () - Create a new temporary file for sorting purposes
- *   return: NO_ERROR
- *   vfid(in): Set to the created file identifier
- *   file_pg_cnt_est(in): Estimated file page count
- *   force_alloc(in): Allocate file pages now ?
- *   tde_encrypted(in): whether the file has to be encrypted or not for TDE
+ * sort_px_execute () - Execute the merge tasks of a pass
+ *   return: NO_ERROR, SORT_PUT_STOP, or error code
+ *   px(in): parallel merge
+ *
+ * Note: Worker 0 reads ahead. If the tasks are executed by workers, worker
+ *       i + 1 executes merge i, and the requester puts the merged key ranges
+ *       of the final merge. Otherwise the requester executes the tasks.
  */
 static int
-sort_add_new_file (THREAD_ENTRY * thread_p, VFID * vfid, int file_pg_cnt_est, bool force_alloc, bool tde_encrypted)
+sort_px_execute (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px)
 {
-  VPID new_vpid;
-  TDE_ALGORITHM tde_algo = TDE_ALGORITHM_NONE;
-  int ret = NO_ERROR;
-
-  /* todo: sort file is a case I missed that seems to use file_find_nthpages. I don't know if it can be optimized to
-   *       work without numerable files, that remains to be seen. */
+  // *INDENT-OFF*
+  cubquery::px_exchange exchange (*thread_p, px->use_workers ? px->num_merges + 1 : 1);
+  // *INDENT-ON*
+  int error = NO_ERROR;
 
-  ret = file_create_temp_numerable (thread_p, file_pg_cnt_est, vfid);
-  if (ret != NO_ERROR)
+  px->exchange = &exchange;
+  px->prefetcher.num_users = px->use_workers ? px->num_merges : 1;
+  px->stop = false;
+  if (px->is_final && px->use_workers)
+    {
+      px->ranges.clear ();
+      px->ranges.resize (px->num_tasks);
+      px->range_ended.assign (px->num_tasks, false);
+    }
+
+  // *INDENT-OFF*
+  exchange.start ([px] (cubthread::entry &thread_ref, int worker_id)
+    {
+      sort_px_merge_worker (&thread_ref, worker_id, px);
+    });
+  // *INDENT-ON*
+
+  if (!px->use_workers)
+    {
+      error = sort_px_merge_execute (thread_p, px, 0);
+      sort_prefetcher_release (&px->prefetcher);
+    }
+  else if (px->is_final)
+    {
+      error = sort_px_output_ranges (thread_p, px);
+    }
+
+  exchange.finish ();
+  if (error == NO_ERROR)
+    {
+      error = exchange.get_error ();
+    }
+  px->exchange = NULL;
+
+  return error;
+}
+
+/*
+ * sort_px_merge_worker () - Execute the part of a worker in a merge pass
+ *   return: void
+ *   worker_id(in): 0 for the read-ahead worker; otherwise merge worker_id - 1
+ *   px(in): parallel merge
+ */
+static void
+sort_px_merge_worker (THREAD_ENTRY * thread_p, int worker_id, SORT_PX_MERGE * px)
+{
+  bool old_sort_stats_active;
+  int error;
+
+  old_sort_stats_active = thread_set_sort_stats_active (thread_p, true);
+
+  if (worker_id == 0)
+    {
+      sort_prefetcher_execute (thread_p, &px->prefetcher);
+    }
+  else
+    {
+      error = sort_px_merge_execute (thread_p, px, worker_id - 1);
+      sort_prefetcher_release (&px->prefetcher);
+      if (error != NO_ERROR)
+	{
+	  px->exchange->set_error (error);
+	  sort_px_stop (px);
+	}
+    }
+
+  px->exchange->end_production ();
+  (void) thread_set_sort_stats_active (thread_p, old_sort_stats_active);
+}
+
+/*
+ * sort_px_merge_execute () - Execute the merge tasks of a merge
+ *   return: NO_ERROR, SORT_PUT_STOP, or error code
+ *   px(in): parallel merge
+ *   merge_id(in): merge
+ *
+ * Note: A merge of an intermediate pass executes the tasks of the output files
+ *       assigned to it, in order, writing the runs of each file one after the
+ *       other. A merge of the final pass executes the task of its key range.
+ */
+static int
+sort_px_merge_execute (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px, int merge_id)
+{
+  SORT_PARAM *sort_param = px->sort_param;
+  char *memory = sort_param->internal_memory + (size_t) merge_id * px->memory_pages * DB_PAGESIZE;
+  SORT_MERGE_TASK *task;
+  SORT_RUN_WRITER writer;
+  SORT_PX_RANGE_OUTPUT range_output;
+  int next_page[2 * SORT_MAX_HALF_FILES];
+  int half_pages;
+  int in_sectsize;
+  int i;
+  int error = NO_ERROR;
+
+  for (i = 0; i < (int) DIM (next_page); i++)
+    {
+      next_page[i] = 0;
+    }
+
+  for (i = 0; i < px->num_tasks && error == NO_ERROR; i++)
+    {
+      task = &px->tasks[i];
+
+      if (px->is_final)
+	{
+	  if (i != merge_id)
+	    {
+	      continue;
+	    }
+
+	  half_pages = MAX (1, px->memory_pages / (2 * task->num_inputs));
+	  if (!px->use_workers)
+	    {
+	      error = sort_merge_runs (thread_p, px, task, memory, half_pages, sort_px_put_output, sort_param);
+	      continue;
+	    }
+
+	  range_output.px = px;
+	  range_output.range = i;
+	  range_output.batch.reserve (SORT_PX_BATCH_SIZE + DB_PAGESIZE);
+	  error = sort_merge_runs (thread_p, px, task, memory, half_pages, sort_px_put_range, &range_output);
+	  if (error == SORT_PUT_STOP)
+	    {
+	      /* stopped by the requester or by another worker */
+	      error = NO_ERROR;
+	    }
+	  else if (error == NO_ERROR)
+	    {
+	      if (!range_output.batch.empty ())
+		{
+		  (void) sort_px_range_produce (px, i, range_output.batch);
+		}
+	      sort_px_range_end (px, i);
+	    }
+	  continue;
+	}
+
+      if ((task->out_file - px->out_half) % px->num_merges != merge_id)
+	{
+	  continue;
+	}
+
+      if (sort_px_is_stopped (px))
+	{
+	  break;
+	}
+
+      /* Distribute the memory of the merge to the input and output sections */
+      in_sectsize = sort_find_inbuf_size (px->memory_pages, task->num_inputs);
+      half_pages = MAX (1, in_sectsize / 2);
+
+      sort_run_writer_init (&writer, &sort_param->temp[task->out_file], next_page[task->out_file],
+			    memory + (size_t) task->num_inputs * 2 * half_pages * DB_PAGESIZE,
+			    px->memory_pages - task->num_inputs * 2 * half_pages, sort_param->tde_encrypted);
+
+      error = sort_merge_runs (thread_p, px, task, memory, half_pages, sort_run_writer_put, &writer);
+      if (error == NO_ERROR)
+	{
+	  error = sort_run_writer_flush (thread_p, &writer);
+	}
+
+      task->out_pages = writer.num_pages;
+      next_page[task->out_file] += writer.num_pages;
+    }
+
+  return error;
+}
+
+/*
+ * sort_px_output_ranges () - Put the records of the key ranges merged by the workers, in order
+ *   return: NO_ERROR, SORT_PUT_STOP, or error code
+ *   px(in): parallel merge
+ */
+static int
+sort_px_output_ranges (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px)
+{
+  SORT_PARAM *sort_param = px->sort_param;
+  // *INDENT-OFF*
+  std::vector<char> batch;
+  // *INDENT-ON*
+  RECDES recdes;
+  char *record, *end;
+  int range;
+  int error = NO_ERROR;
+
+  recdes.type = REC_HOME;
+
+  for (range = 0; range < px->num_tasks && error == NO_ERROR; range++)
+    {
+      while (error == NO_ERROR && sort_px_range_consume (px, range, batch))
+	{
+	  end = batch.data () + batch.size ();
+	  for (record = batch.data (); record < end && error == NO_ERROR;
+	       record += SORT_RECORD_LENGTH_SIZE + DB_ALIGN (recdes.length, MAX_ALIGNMENT))
+	    {
+	      recdes.data = record + SORT_RECORD_LENGTH_SIZE;
+	      recdes.length = recdes.area_size = SORT_RECORD_LENGTH (recdes.data);
+
+	      error = (*sort_param->put_fn) (thread_p, &recdes, sort_param->put_arg);
+	    }
+	}
+    }
+
+  if (error != NO_ERROR)
+    {
+      sort_px_stop (px);
+    }
+
+  return error;
+}
+
+/*
+ * sort_px_stop () - Stop the merges and the output of a pass
+ *   return: void
+ *   px(in): parallel merge
+ */
+static void
+sort_px_stop (SORT_PX_MERGE * px)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (px->mutex);
+  // *INDENT-ON*
+
+  px->stop = true;
+  px->cond.notify_all ();
+}
+
+/*
+ * sort_px_is_stopped () - Whether the merges of a pass must stop
+ *   return: true if stopped
+ *   px(in): parallel merge
+ */
+static bool
+sort_px_is_stopped (SORT_PX_MERGE * px)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (px->mutex);
+  // *INDENT-ON*
+
+  return px->stop;
+}
+
+/*
+ * sort_px_range_produce () - Hand over a batch of merged records of a key range to the requester
+ *   return: false if the pass is stopped
+ *   px(in): parallel merge
+ *   range(in): key range
+ *   batch(in/out): batch of records; emptied
+ */
+// *INDENT-OFF*
+static bool
+sort_px_range_produce (SORT_PX_MERGE * px, int range, std::vector<char> &batch)
+{
+  std::unique_lock<std::mutex> ulock (px->mutex);
+
+  px->cond.wait (ulock, [px, range] { return px->stop || px->ranges[range].size () < px->max_range_batches; });
+  if (px->stop)
+    {
+      return false;
+    }
+
+  px->ranges[range].push_back (std::move (batch));
+  batch.clear ();
+  px->cond.notify_all ();
+
+  return true;
+}
+// *INDENT-ON*
+
+/*
+ * sort_px_range_end () - Tell the requester that all records of a key range are handed over
+ *   return: void
+ *   px(in): parallel merge
+ *   range(in): key range
+ */
+static void
+sort_px_range_end (SORT_PX_MERGE * px, int range)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (px->mutex);
+  // *INDENT-ON*
+
+  px->range_ended[range] = true;
+  px->cond.notify_all ();
+}
+
+/*
+ * sort_px_range_consume () - Get the next batch of merged records of a key range
+ *   return: false if all records of the range are consumed or the pass is stopped
+ *   px(in): parallel merge
+ *   range(in): key range
+ *   batch(out): batch of records
+ */
+// *INDENT-OFF*
+static bool
+sort_px_range_consume (SORT_PX_MERGE * px, int range, std::vector<char> &batch)
+{
+  std::unique_lock<std::mutex> ulock (px->mutex);
+
+  px->cond.wait (ulock, [px, range] { return px->stop || !px->ranges[range].empty () || px->range_ended[range]; });
+  if (px->stop || px->ranges[range].empty ())
+    {
+      return false;
+    }
+
+  batch = std::move (px->ranges[range].front ());
+  px->ranges[range].pop_front ();
+  px->cond.notify_all ();
+
+  return true;
+}
+// *INDENT-ON*
+
+/*
+ * sort_px_put_range () - Output function of the merge of a key range; add the record to the batch of the range
+ *   return: NO_ERROR, or SORT_PUT_STOP if the pass is stopped
+ *   page_recdes(in): record as stored on its page
+ *   recdes(in): record
+ *   arg(in): output of the key range
+ */
+static int
+sort_px_put_range (THREAD_ENTRY * thread_p, RECDES * page_recdes, RECDES * recdes, void *arg)
+{
+  SORT_PX_RANGE_OUTPUT *output = (SORT_PX_RANGE_OUTPUT *) arg;
+  size_t offset = output->batch.size ();
+  char *record;
+
+  /* records are copied with their length in front of them, like in-memory sort records */
+  output->batch.resize (offset + SORT_RECORD_LENGTH_SIZE + DB_ALIGN (recdes->length, MAX_ALIGNMENT));
+  record = output->batch.data () + offset + SORT_RECORD_LENGTH_SIZE;
+  SORT_RECORD_LENGTH (record) = recdes->length;
+  memcpy (record, recdes->data, recdes->length);
+  ((SORT_REC *) record)->next = NULL;
+
+  if (output->batch.size () >= SORT_PX_BATCH_SIZE && !sort_px_range_produce (output->px, output->range, output->batch))
+    {
+      return SORT_PUT_STOP;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * sort_px_put_output () - Output function of a final merge executed by the requester
+ *   return: NO_ERROR, SORT_PUT_STOP, or error code
+ *   page_recdes(in): record as stored on its page
+ *   recdes(in): record
+ *   arg(in): sort parameters
+ */
+static int
+sort_px_put_output (THREAD_ENTRY * thread_p, RECDES * page_recdes, RECDES * recdes, void *arg)
+{
+  SORT_PARAM *sort_param = (SORT_PARAM *) arg;
+
+  ((SORT_REC *) recdes->data)->next = NULL;
+
+  return (*sort_param->put_fn) (thread_p, recdes, sort_param->put_arg);
+}
+
+/*
+ * sort_px_find_splitters () - Find the keys cutting the final merge in key ranges
+ *   return: NO_ERROR, or error code
+ *   sort_param(in): sort parameters
+ *   inputs(in): input runs
+ *   num_inputs(in): number of input runs
+ *   num_ranges(in): wanted number of key ranges
+ *   splitters(out): keys in ascending order; records up to splitters[i] and after splitters[i - 1] belong to range i.
+ *                   Allocated with their length in front of them.
+ *
+ * Note: The first records of evenly spaced pages of the runs are sampled,
+ *       and the splitters cut the sorted samples in parts of same size.
+ *       Equal splitters are merged, so there may be less ranges than wanted.
+ */
+// *INDENT-OFF*
+static int
+sort_px_find_splitters (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_RUN_INPUT * inputs, int num_inputs,
+			int num_ranges, std::vector<char *> &splitters)
+{
+  std::vector<char *> samples;
+  char *page = sort_param->internal_memory;	/* the workers are not started yet */
+  char *sample;
+  RECDES recdes;
+  RECDES long_recdes;
+  size_t sample_size;
+  size_t pos;
+  int num_samples;
+  int i, s, r;
+  int error = NO_ERROR;
+
+  long_recdes.data = NULL;
+  long_recdes.area_size = 0;
+
+  for (i = 0; i < num_inputs; i++)
+    {
+      num_samples = MIN (inputs[i].num_pages, SORT_PX_SAMPLES_PER_RANGE * num_ranges);
+      for (s = 0; s < num_samples; s++)
+	{
+	  error = sort_px_read_first_record (thread_p, &inputs[i], (int) ((INT64) s * inputs[i].num_pages / num_samples),
+					     page, &long_recdes, &recdes);
+	  if (error != NO_ERROR)
+	    {
+	      goto end;
+	    }
+
+	  sample_size = SORT_RECORD_LENGTH_SIZE + recdes.length;
+	  sample = (char *) malloc (sample_size);
+	  if (sample == NULL)
+	    {
+	      error = ER_OUT_OF_VIRTUAL_MEMORY;
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, error, 1, sample_size);
+	      goto end;
+	    }
+	  sample += SORT_RECORD_LENGTH_SIZE;
+	  SORT_RECORD_LENGTH (sample) = recdes.length;
+	  memcpy (sample, recdes.data, recdes.length);
+	  samples.push_back (sample);
+	}
+    }
+
+  std::sort (samples.begin (), samples.end (), [sort_param] (char *a, char *b)
+    {
+      return (*sort_param->cmp_fn) (&a, &b, sort_param->cmp_arg) < 0;
+    });
+
+  for (r = 1; r < num_ranges; r++)
+    {
+      pos = (size_t) r * samples.size () / num_ranges;
+      sample = samples[pos];
+      if (sample == NULL
+	  || (!splitters.empty () && (*sort_param->cmp_fn) (&splitters.back (), &sample, sort_param->cmp_arg) == 0))
+	{
+	  /* same key as previous splitter */
+	  continue;
+	}
+      splitters.push_back (sample);
+      samples[pos] = NULL;
+    }
+
+end:
+  for (i = 0; i < (int) samples.size (); i++)
+    {
+      if (samples[i] != NULL)
+	{
+	  free (samples[i] - SORT_RECORD_LENGTH_SIZE);
+	}
+    }
+  if (long_recdes.data != NULL)
+    {
+      free_and_init (long_recdes.data);
+    }
+
+  return error;
+}
+// *INDENT-ON*
+
+/*
+ * sort_px_find_start_page () - Find the first page of a run that may have records of a key range
+ *   return: NO_ERROR, or error code
+ *   sort_param(in): sort parameters
+ *   input(in): input run
+ *   lower_key(in): records up to this key belong to the previous ranges
+ *   page(in): page buffer
+ *   start_page(out): last page of the run whose first record is before lower_key, relative to the run
+ */
+static int
+sort_px_find_start_page (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param, SORT_RUN_INPUT * input, char *lower_key,
+			 char *page, int *start_page)
+{
+  RECDES recdes;
+  RECDES long_recdes;
+  int low, high, middle;
+  int error = NO_ERROR;
+
+  long_recdes.data = NULL;
+  long_recdes.area_size = 0;
+
+  *start_page = 0;
+
+  /* records of the previous pages are before the first record of the page */
+  low = 0;
+  high = input->num_pages - 1;
+  while (low <= high)
+    {
+      middle = (low + high) / 2;
+
+      error = sort_px_read_first_record (thread_p, input, middle, page, &long_recdes, &recdes);
+      if (error != NO_ERROR)
+	{
+	  break;
+	}
+
+      if ((*sort_param->cmp_fn) (&recdes.data, &lower_key, sort_param->cmp_arg) < 0)
+	{
+	  *start_page = middle;
+	  low = middle + 1;
+	}
+      else
+	{
+	  high = middle - 1;
+	}
+    }
+
+  if (long_recdes.data != NULL)
+    {
+      free_and_init (long_recdes.data);
+    }
+
+  return error;
+}
+
+/*
+ * sort_px_read_first_record () - Read the first record of a page of a run
+ *   return: NO_ERROR, or error code
+ *   input(in): input run
+ *   page_no(in): page, relative to the run
+ *   page(in): page buffer
+ *   long_recdes(in/out): area for REC_BIGONE records
+ *   recdes(out): record; peeked in page buffer or in long_recdes
+ */
+static int
+sort_px_read_first_record (THREAD_ENTRY * thread_p, SORT_RUN_INPUT * input, int page_no, char *page,
+			   RECDES * long_recdes, RECDES * recdes)
+{
+  int error;
+
+  error = sort_read_area (thread_p, input->vfid, input->first_page + page_no, 1, page);
+  if (error != NO_ERROR)
+    {
+      return error;
+    }
+
+  if (sort_spage_get_record (page, 0, recdes, PEEK) != S_SUCCESS)
+    {
+      error = ER_SORT_TEMP_PAGE_CORRUPTED;
+      er_set (ER_FATAL_ERROR_SEVERITY, ARG_FILE_LINE, error, 0);
+      return error;
+    }
+
+  if (recdes->type == REC_BIGONE)
+    {
+      if (sort_retrieve_longrec (thread_p, recdes, long_recdes) == NULL)
+	{
+	  ASSERT_ERROR_AND_SET (error);
+	  return error;
+	}
+      recdes->data = long_recdes->data;
+      recdes->length = long_recdes->length;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * sort_merge_runs () - Merge the input runs of a merge task
+ *   return: NO_ERROR, SORT_PUT_STOP, or error code
+ *   px(in): parallel merge
+ *   task(in): merge task
+ *   memory(in): internal memory of the merge; the input sections are at its beginning
+ *   half_pages(in): size of each half of the input sections
+ *   out_fn(in): output function of the merged records
+ *   out_arg(in): argument of the output function
+ *
+ * Note: Input runs are sorted and, with SORT_ELIM_DUP, have no duplicates;
+ *       duplicates can only be the current records of different runs.
+ */
+static int
+sort_merge_runs (THREAD_ENTRY * thread_p, SORT_PX_MERGE * px, SORT_MERGE_TASK * task, char *memory, int half_pages,
+		 SORT_MERGE_OUT_FUNC * out_fn, void *out_arg)
+{
+  SORT_PARAM *sort_param = px->sort_param;
+  SORT_CMP_FUNC *compare = sort_param->cmp_fn;
+  void *compare_arg = sort_param->cmp_arg;
+  SORT_RUN_READER readers[SORT_MAX_HALF_FILES];
+  char *section;
+  int num_readers = 0;
+  int start_page;
+  bool is_after_lower_key;
+  int merged_records = 0;
+  int min;
+  int i;
+  int error = NO_ERROR;
+
+  for (i = 0; i < task->num_inputs; i++)
+    {
+      section = memory + (size_t) i * 2 * half_pages * DB_PAGESIZE;
+
+      start_page = 0;
+      if (task->lower_key != NULL)
+	{
+	  /* skip the pages of the previous key ranges */
+	  error = sort_px_find_start_page (thread_p, sort_param, &task->inputs[i], task->lower_key, section,
+					   &start_page);
+	  if (error != NO_ERROR)
+	    {
+	      goto end;
+	    }
+	}
+
+      num_readers++;
+      error = sort_run_reader_open (thread_p, &readers[i], &task->inputs[i], start_page, section, half_pages,
+				    &px->prefetcher);
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
+
+  is_after_lower_key = (task->lower_key == NULL);
+  while (true)
+    {
+      /* Find the smallest current record */
+      min = -1;
+      for (i = 0; i < num_readers; i++)
+	{
+	  if (!readers[i].is_end
+	      && (min == -1 || (*compare) (&readers[i].recdes.data, &readers[min].recdes.data, compare_arg) < 0))
+	    {
+	      min = i;
+	    }
+	}
+      if (min == -1)
+	{
+	  /* all runs are merged */
+	  break;
+	}
+
+      if (sort_param->option == SORT_ELIM_DUP)
+	{
+	  for (i = 0; i < num_readers; i++)
+	    {
+	      if (i != min && !readers[i].is_end
+		  && (*compare) (&readers[i].recdes.data, &readers[min].recdes.data, compare_arg) == 0)
+		{
+		  error = sort_run_reader_next (thread_p, &readers[i], &px->prefetcher);
+		  if (error != NO_ERROR)
+		    {
+		      goto end;
+		    }
+		}
+	    }
+	}
+
+      if (!is_after_lower_key)
+	{
+	  if ((*compare) (&readers[min].recdes.data, &task->lower_key, compare_arg) <= 0)
+	    {
+	      /* belongs to a previous key range */
+	      error = sort_run_reader_next (thread_p, &readers[min], &px->prefetcher);
+	      if (error != NO_ERROR)
+		{
+		  goto end;
+		}
+	      continue;
+	    }
+	  is_after_lower_key = true;
+	}
+
+      if (task->upper_key != NULL && (*compare) (&readers[min].recdes.data, &task->upper_key, compare_arg) > 0)
+	{
+	  /* the rest belongs to the next key ranges */
+	  break;
+	}
+
+      error = (*out_fn) (thread_p, &readers[min].page_recdes, &readers[min].recdes, out_arg);
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+
+      error = sort_run_reader_next (thread_p, &readers[min], &px->prefetcher);
+      if (error != NO_ERROR)
+	{
+	  goto end;
+	}
+
+      if (++merged_records % SORT_PX_CHECK_INTERVAL == 0 && sort_px_is_stopped (px))
+	{
+	  break;
+	}
+    }
+
+end:
+  for (i = 0; i < num_readers; i++)
+    {
+      sort_run_reader_close (&readers[i], &px->prefetcher);
+    }
+
+  return error;
+}
+
+/*
+ * sort_run_reader_open () - Start reading the records of an input run
+ *   return: NO_ERROR, or error code
+ *   reader(out): run reader
+ *   run(in): input run
+ *   start_page(in): first page to read, relative to the run
+ *   area(in): input section; two halves of half_pages pages
+ *   half_pages(in): size of each half of the input section
+ *   prefetcher(in): read-ahead of the pass
+ */
+static int
+sort_run_reader_open (THREAD_ENTRY * thread_p, SORT_RUN_READER * reader, SORT_RUN_INPUT * run, int start_page,
+		      char *area, int half_pages, SORT_PREFETCHER * prefetcher)
+{
+  int i;
+
+  reader->run = *run;
+  reader->next_page = start_page;
+  reader->half_pages = half_pages;
+  reader->halves[0] = area;
+  reader->halves[1] = area + (size_t) half_pages * DB_PAGESIZE;
+  for (i = 0; i < 2; i++)
+    {
+      reader->requests[i].num_pages = 0;
+      reader->requests[i].state = SORT_READ_IDLE;
+    }
+  reader->long_recdes.data = NULL;
+  reader->long_recdes.area_size = 0;
+  reader->is_end = false;
+
+  /* the first half is read now; start as if the second one was just merged, so that it is read ahead */
+  sort_run_reader_request (reader, 0, prefetcher);
+  reader->cur_half = 1;
+  reader->cur_buf = 0;
+  reader->cur_slot = -1;
+  reader->num_slots = 0;
+
+  return sort_run_reader_next (thread_p, reader, prefetcher);
+}
+
+/*
+ * sort_run_reader_next () - Advance to the next record of an input run
+ *   return: NO_ERROR, or error code
+ *   reader(in/out): run reader; is_end is set after the last record
+ *   prefetcher(in): read-ahead of the pass
+ */
+static int
+sort_run_reader_next (THREAD_ENTRY * thread_p, SORT_RUN_READER * reader, SORT_PREFETCHER * prefetcher)
+{
+  char *page;
+  int half;
+  int error;
+
+  reader->cur_slot++;
+  while (reader->cur_slot >= reader->num_slots)
+    {
+      if (reader->cur_buf + 1 < reader->requests[reader->cur_half].num_pages)
+	{
+	  reader->cur_buf++;
+	}
+      else
+	{
+	  /* The current half is merged: read ahead the next pages of the run into it and go on with the other half */
+	  half = reader->cur_half;
+	  sort_run_reader_request (reader, half, prefetcher);
+
+	  reader->cur_half = 1 - half;
+	  error = sort_read_wait (thread_p, prefetcher, &reader->requests[reader->cur_half]);
+	  if (error != NO_ERROR)
+	    {
+	      return error;
+	    }
+	  if (reader->requests[reader->cur_half].num_pages <= 0)
+	    {
+	      reader->is_end = true;
+	      return NO_ERROR;
+	    }
+	  reader->cur_buf = 0;
+	}
+
+      reader->cur_slot = 0;
+      reader->num_slots = sort_spage_get_numrecs (reader->halves[reader->cur_half] + reader->cur_buf * DB_PAGESIZE);
+    }
+
+  page = reader->halves[reader->cur_half] + reader->cur_buf * DB_PAGESIZE;
+  if (sort_spage_get_record (page, reader->cur_slot, &reader->page_recdes, PEEK) != S_SUCCESS)
+    {
+      error = ER_SORT_TEMP_PAGE_CORRUPTED;
+      er_set (ER_FATAL_ERROR_SEVERITY, ARG_FILE_LINE, error, 0);
+      return error;
+    }
+
+  /* If this is a long record retrieve it */
+  if (reader->page_recdes.type == REC_BIGONE)
+    {
+      if (sort_retrieve_longrec (thread_p, &reader->page_recdes, &reader->long_recdes) == NULL)
+	{
+	  ASSERT_ERROR_AND_SET (error);
+	  return error;
+	}
+      reader->recdes.data = reader->long_recdes.data;
+      reader->recdes.length = reader->long_recdes.length;
+    }
+  else
+    {
+      reader->recdes.data = reader->page_recdes.data;
+      reader->recdes.length = reader->page_recdes.length;
+    }
+  reader->recdes.area_size = reader->recdes.length;
+  reader->recdes.type = REC_HOME;
+
+  return NO_ERROR;
+}
+
+/*
+ * sort_run_reader_request () - Request the read of the next pages of an input run into a half of its input section
+ *   return: void
+ *   reader(in/out): run reader
+ *   half(in): half of the input section; its pages are merged
+ *   prefetcher(in): read-ahead of the pass
+ */
+static void
+sort_run_reader_request (SORT_RUN_READER * reader, int half, SORT_PREFETCHER * prefetcher)
+{
+  int num_pages;
+
+  num_pages = MIN (reader->half_pages, reader->run.num_pages - reader->next_page);
+  sort_read_ahead (prefetcher, &reader->requests[half], reader->run.vfid, reader->run.first_page + reader->next_page,
+		   num_pages, reader->halves[half]);
+  reader->next_page += MAX (num_pages, 0);
+}
+
+/*
+ * sort_run_reader_close () - Stop reading an input run
+ *   return: void
+ *   reader(in/out): run reader
+ *   prefetcher(in): read-ahead of the pass
+ *
+ * Note: Once closed, the read-ahead worker does not access the reader nor its
+ *       input section anymore.
+ */
+static void
+sort_run_reader_close (SORT_RUN_READER * reader, SORT_PREFETCHER * prefetcher)
+{
+  sort_read_cancel (prefetcher, &reader->requests[0]);
+  sort_read_cancel (prefetcher, &reader->requests[1]);
+
+  if (reader->long_recdes.data != NULL)
+    {
+      free_and_init (reader->long_recdes.data);
+    }
+}
+
+/*
+ * sort_run_writer_init () - Start writing an output run
+ *   return: void
+ *   writer(out): run writer
+ *   vfid(in): output file
+ *   first_page(in): first page of the run in the file
+ *   area(in): output section
+ *   area_pages(in): size of the output section
+ *   tde_encrypted(in): whether the file is encrypted (TDE)
+ */
+static void
+sort_run_writer_init (SORT_RUN_WRITER * writer, VFID * vfid, int first_page, char *area, int area_pages,
+		      bool tde_encrypted)
+{
+  assert (area_pages > 0);
+
+  writer->vfid = vfid;
+  writer->next_page = first_page;
+  writer->area = area;
+  writer->area_pages = area_pages;
+  writer->cur_buf = 0;
+  writer->num_pages = 0;
+  writer->tde_encrypted = tde_encrypted;
+
+  sort_spage_initialize (area, UNANCHORED_KEEP_SEQUENCE, MAX_ALIGNMENT);
+}
+
+/*
+ * sort_run_writer_put () - Output function of the merge of an output run; add the record to the run
+ *   return: NO_ERROR, or error code
+ *   page_recdes(in): record as stored on its page
+ *   recdes(in): record
+ *   arg(in): run writer
+ */
+static int
+sort_run_writer_put (THREAD_ENTRY * thread_p, RECDES * page_recdes, RECDES * recdes, void *arg)
+{
+  SORT_RUN_WRITER *writer = (SORT_RUN_WRITER *) arg;
+  char *page = writer->area + writer->cur_buf * DB_PAGESIZE;
+  int error;
+
+  if (sort_spage_insert (page, page_recdes) != NULL_SLOTID)
+    {
+      return NO_ERROR;
+    }
+
+  /* The current page is full; flush the output section if all of its pages are full */
+  if (++writer->cur_buf >= writer->area_pages)
+    {
+      error = sort_write_area (thread_p, writer->vfid, writer->next_page, writer->area_pages, writer->area,
+			       writer->tde_encrypted);
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
+
+      writer->next_page += writer->area_pages;
+      writer->num_pages += writer->area_pages;
+      writer->cur_buf = 0;
+    }
+
+  page = writer->area + writer->cur_buf * DB_PAGESIZE;
+  sort_spage_initialize (page, UNANCHORED_KEEP_SEQUENCE, MAX_ALIGNMENT);
+  if (sort_spage_insert (page, page_recdes) == NULL_SLOTID)
+    {
+      /* Slotted page module refuses to insert a short size record to an empty page. This should never happen. */
+      error = ER_GENERIC_ERROR;
+      er_set (ER_FATAL_ERROR_SEVERITY, ARG_FILE_LINE, error, 0);
+      return error;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * sort_run_writer_flush () - Flush the pages of an output run left in its output section
+ *   return: NO_ERROR, or error code
+ *   writer(in/out): run writer
+ */
+static int
+sort_run_writer_flush (THREAD_ENTRY * thread_p, SORT_RUN_WRITER * writer)
+{
+  int num_pages = writer->cur_buf;
+  int error;
+
+  if (sort_spage_get_numrecs (writer->area + writer->cur_buf * DB_PAGESIZE) > 0)
+    {
+      /* the partially full page */
+      num_pages++;
+    }
+
+  if (num_pages > 0)
+    {
+      error = sort_write_area (thread_p, writer->vfid, writer->next_page, num_pages, writer->area,
+			       writer->tde_encrypted);
+      if (error != NO_ERROR)
+	{
+	  return error;
+	}
+
+      writer->next_page += num_pages;
+      writer->num_pages += num_pages;
+    }
+
+  writer->cur_buf = 0;
+  sort_spage_initialize (writer->area, UNANCHORED_KEEP_SEQUENCE, MAX_ALIGNMENT);
+
+  return NO_ERROR;
+}
+
+/*
+ * sort_read_ahead () - Queue the read of pages of a run for the read-ahead worker
+ *   return: void
+ *   prefetcher(in): read-ahead of the pass
+ *   request(out): read request; not in use
+ *   vfid(in): file to read the pages from
+ *   first_page(in): first page to read
+ *   num_pages(in): number of pages to read; nothing is read if not positive
+ *   area(in): memory area receiving the pages
+ */
+static void
+sort_read_ahead (SORT_PREFETCHER * prefetcher, SORT_READ_REQUEST * request, VFID * vfid, int first_page,
+		 int num_pages, char *area)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (prefetcher->mutex);
+  // *INDENT-ON*
+
+  assert (request->state == SORT_READ_IDLE);
+
+  request->vfid = vfid;
+  request->first_page = first_page;
+  request->num_pages = MAX (num_pages, 0);
+  request->area = area;
+  request->error = NO_ERROR;
+
+  if (request->num_pages > 0)
+    {
+      request->state = SORT_READ_QUEUED;
+      prefetcher->queue.push_back (request);
+      prefetcher->cond.notify_all ();
+    }
+}
+
+/*
+ * sort_read_wait () - Wait for the pages of a read request
+ *   return: NO_ERROR, or error code
+ *   prefetcher(in): read-ahead of the pass
+ *   request(in/out): read request; not in use anymore on return
+ *
+ * Note: A request the read-ahead worker has not started yet is read by the
+ *       caller, so that a merge never waits for the reads queued by others.
+ *       The error of a failed read-ahead was set in the context of the worker;
+ *       the caller reads the pages again to get its own.
+ */
+static int
+sort_read_wait (THREAD_ENTRY * thread_p, SORT_PREFETCHER * prefetcher, SORT_READ_REQUEST * request)
+{
+  bool must_read = false;
+
+  if (request->num_pages <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  {
+    // *INDENT-OFF*
+    std::unique_lock<std::mutex> ulock (prefetcher->mutex);
+
+    if (request->state == SORT_READ_QUEUED)
+      {
+	prefetcher->queue.erase (std::find (prefetcher->queue.begin (), prefetcher->queue.end (), request));
+	must_read = true;
+      }
+    else
+      {
+	prefetcher->cond.wait (ulock, [request] { return request->state != SORT_READ_RUNNING; });
+	must_read = (request->state != SORT_READ_DONE || request->error != NO_ERROR);
+      }
+    // *INDENT-ON*
+    request->state = SORT_READ_IDLE;
+  }
+
+  if (must_read)
+    {
+      return sort_read_area (thread_p, request->vfid, request->first_page, request->num_pages, request->area);
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * sort_read_cancel () - Cancel a read request
+ *   return: void
+ *   prefetcher(in): read-ahead of the pass
+ *   request(in/out): read request; not in use anymore on return
+ */
+static void
+sort_read_cancel (SORT_PREFETCHER * prefetcher, SORT_READ_REQUEST * request)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (prefetcher->mutex);
+
+  if (request->state == SORT_READ_QUEUED)
+    {
+      prefetcher->queue.erase (std::find (prefetcher->queue.begin (), prefetcher->queue.end (), request));
+    }
+  else
+    {
+      /* the read-ahead worker writes into the area of the request until it is done */
+      prefetcher->cond.wait (ulock, [request] { return request->state != SORT_READ_RUNNING; });
+    }
+  // *INDENT-ON*
+  request->state = SORT_READ_IDLE;
+}
+
+/*
+ * sort_prefetcher_execute () - Read the queued requests until no merge is left
+ *   return: void
+ *   prefetcher(in): read-ahead of the pass
+ */
+static void
+sort_prefetcher_execute (THREAD_ENTRY * thread_p, SORT_PREFETCHER * prefetcher)
+{
+  SORT_READ_REQUEST *request;
+  int error;
+
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (prefetcher->mutex);
+
+  while (true)
+    {
+      prefetcher->cond.wait (ulock, [prefetcher] { return !prefetcher->queue.empty () || prefetcher->num_users == 0; });
+      if (prefetcher->queue.empty ())
+	{
+	  break;
+	}
+
+      request = prefetcher->queue.front ();
+      prefetcher->queue.pop_front ();
+      request->state = SORT_READ_RUNNING;
+
+      ulock.unlock ();
+      error = sort_read_area (thread_p, request->vfid, request->first_page, request->num_pages, request->area);
+      if (error != NO_ERROR)
+	{
+	  /* the merge reads the pages again */
+	  er_clear ();
+	}
+      ulock.lock ();
+
+      request->error = error;
+      request->state = SORT_READ_DONE;
+      prefetcher->cond.notify_all ();
+    }
+  // *INDENT-ON*
+}
+
+/*
+ * sort_prefetcher_release () - Tell the read-ahead worker that a merge does not queue requests anymore
+ *   return: void
+ *   prefetcher(in): read-ahead of the pass
+ */
+static void
+sort_prefetcher_release (SORT_PREFETCHER * prefetcher)
+{
+  // *INDENT-OFF*
+  std::unique_lock<std::mutex> ulock (prefetcher->mutex);
+  // *INDENT-ON*
+
+  assert (prefetcher->num_users > 0);
+  prefetcher->num_users--;
+  prefetcher->cond.notify_all ();
+}
+
+/*
+ * sort_get_avg_numpages_of_nonempty_tmpfile () - Return average number of pages
+ *                                       currently occupied by nonempty
+ *                                       temporary file
+ *   return:
+ *   sort_param(in): Sort paramater
+ */
+static int
+sort_get_avg_numpages_of_nonempty_tmpfile (SORT_PARAM * sort_param)
+{
+  int f;
+  int sum, i;
+  int nonempty_temp_file_num = 0;
+
+  sum = 0;
+  for (i = 0; i < sort_param->tot_tempfiles; i++)
+    {
+      /* If the list is not empty */
+      f = sort_param->file_contents[i].first_run;
+      if (f > -1)
+	{
+	  nonempty_temp_file_num++;
+	  for (; f <= sort_param->file_contents[i].last_run; f++)
+	    {
+	      sum += sort_param->file_contents[i].num_pages[f];
+	    }
+	}
+    }
+
+  return (sum / MAX (1, nonempty_temp_file_num));
+}
+
+/*
+ * sort_return_used_resources () - Return system resource used for sorting
+ *   return: void
+ *   sort_param(in): Sort paramater
+ *
+ * Note: Clear the sort parameter structure by deallocating any allocated
+ *       memory areas and destroying any temporary files and volumes.
+ */
+static void
+sort_return_used_resources (THREAD_ENTRY * thread_p, SORT_PARAM * sort_param)
+{
+  int k;
+#if defined(SERVER_MODE)
+  int rv;
+#endif /* SERVER_MODE */
+
+  if (sort_param == NULL)
+    {
+      return;			/* nop */
+    }
+
+  if (sort_param->internal_memory)
+    {
+      free_and_init (sort_param->internal_memory);
+    }
+
+  for (k = 0; k < sort_param->tot_tempfiles; k++)
+    {
+      if (sort_param->temp[k].volid != NULL_VOLID)
+	{
+	  (void) file_temp_retire (thread_p, &sort_param->temp[k]);
+	}
+    }
+
+  if (sort_param->multipage_file.volid != NULL_VOLID)
+    {
+      (void) file_temp_retire (thread_p, &(sort_param->multipage_file));
+    }
+
+  for (k = 0; k < sort_param->tot_tempfiles; k++)
+    {
+      if (sort_param->file_contents[k].num_pages != NULL)
+	{
+	  db_private_free_and_init (thread_p, sort_param->file_contents[k].num_pages);
+	}
+    }
+
+  if (sort_param->px_array)
+    {
+      free_and_init (sort_param->px_array);
+    }
+  sort_param->px_height_max = sort_param->px_array_size = 0;
+
+#if defined(SERVER_MODE)
+  rv = pthread_mutex_destroy (&(sort_param->px_mtx));
+  if (rv != 0)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_MUTEX_DESTROY, 0);
+    }
+#endif
+
+  free_and_init (sort_param);
+}
+
+/*
+ * sort_add_new_file () - Create a new temporary file for sorting purposes
+ *   return: NO_ERROR
+ *   vfid(in): Set to the created file identifier
+ *   file_pg_cnt_est(in): Estimated file page count
+ *   force_alloc(in): Allocate file pages now ?
+ *   tde_encrypted(in): whether the file has to be encrypted or not for TDE
+ */
+static int
+sort_add_new_file (THREAD_ENTRY * thread_p, VFID * vfid, int file_pg_cnt_est, bool force_alloc, bool tde_encrypted)
+{
+  VPID new_vpid;
+  TDE_ALGORITHM tde_algo = TDE_ALGORITHM_NONE;
+  int ret = NO_ERROR;
+
+  /* todo: sort file is a case I missed that seems to use file_find_nthpages. I don't know if it can be optimized to
+   *       work without numerable files, that remains to be seen. */
+
+  ret = file_create_temp_numerable (thread_p, file_pg_cnt_est, vfid);
+  if (ret != NO_ERROR)
     {
       ASSERT_ERROR ();
       return ret;
@@ -4566,6 +6257,8 @@ sort_write_area (THREAD_ENTRY * thread_p, VFID * vfid, int first_page, INT32 num
   /* initializations */
   page_no = first_page;
 
+  perfmon_add_stat (thread_p, PSTAT_SORT_NUM_SPILLED_PAGES, num_pages);
+
   /* Flush pages buffered in the given area to the specified file */
 
   page_ptr = (PAGE_PTR) area_start;
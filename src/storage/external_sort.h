@@ -42,6 +42,17 @@
 #define SORT_RECORD_LENGTH_SIZE (sizeof(INT64))	/* for 8byte align */
 #define SORT_RECORD_LENGTH(item_p) (*((int *) ((item_p) - SORT_RECORD_LENGTH_SIZE)))
 
+/*
+ * Normalized key prefix of a sort record: binary string that orders by memcmp as the first keys of the record do,
+ * followed by one byte with the length of the string and whether it holds the whole key. Records whose strings
+ * differ within the shorter length order as the strings do; otherwise their keys must be compared.
+ */
+#define SORT_KEY_PREFIX_SIZE 16	/* keeps the body that follows it aligned */
+#define SORT_KEY_PREFIX_MAX_LENGTH (SORT_KEY_PREFIX_SIZE - 1)
+#define SORT_KEY_PREFIX_COMPLETE 0x80
+#define SORT_KEY_PREFIX_LENGTH(prefix) ((prefix)[SORT_KEY_PREFIX_MAX_LENGTH] & ~SORT_KEY_PREFIX_COMPLETE)
+#define SORT_KEY_PREFIX_IS_COMPLETE(prefix) (((prefix)[SORT_KEY_PREFIX_MAX_LENGTH] & SORT_KEY_PREFIX_COMPLETE) != 0)
+
 typedef enum
 {
   SORT_REC_DOESNT_FIT,
@@ -65,6 +76,8 @@ typedef struct SUBKEY_INFO SUBKEY_INFO;
 typedef struct SORTKEY_INFO SORTKEY_INFO;
 typedef struct SORT_INFO SORT_INFO;
 
+typedef const unsigned char *SORT_KEY_PREFIX_FUNC (const SORT_REC *, void *);
+
 struct SORT_REC
 {
   SORT_REC *next;		/* forward link for duplicate sort_key value */
@@ -117,6 +130,9 @@ struct SUBKEY_INFO
   int is_nulls_first;
 
   bool use_cmp_dom;		/* when true, use cmp_dom to make comparing */
+
+  DB_TYPE prefix_type;		/* type of the key in the normalized key prefix; DB_TYPE_NULL if it has none */
+  const unsigned int *prefix_weights;	/* string key: weights of the bytes in the collation */
 };
 
 struct SORTKEY_INFO
@@ -128,6 +144,7 @@ struct SORTKEY_INFO
   SUBKEY_INFO *key;		/* Points to `default_keys' if `nkeys' <= 8; otherwise it points to malloc'ed space. */
   SUBKEY_INFO default_keys[8];	/* Default storage; this ought to work for most cases. */
   int error;			/* median domain convert errors */
+  bool use_key_prefix;		/* sort records start with a normalized key prefix */
 };
 
 struct SORT_INFO
@@ -144,6 +161,6 @@ struct SORT_INFO
 
 extern int sort_listfile (THREAD_ENTRY * thread_p, INT16 volid, int est_inp_pg_cnt, SORT_GET_FUNC * get_fn,
 			  void *get_arg, SORT_PUT_FUNC * put_fn, void *put_arg, SORT_CMP_FUNC * cmp_fn, void *cmp_arg,
-			  SORT_DUP_OPTION option, int limit, bool includes_tde_class);
+			  SORT_KEY_PREFIX_FUNC * key_prefix_fn, SORT_DUP_OPTION option, int limit, bool includes_tde_class);
 
 #endif /* _EXTERNAL_SORT_H_ */
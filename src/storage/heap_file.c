@@ -45,6 +45,7 @@
 #include "locator_sr.h"
 #include "btree.h"
 #include "btree_unique.hpp"
+#include "heap_zone_map.hpp"
 #include "schema_system_catalog_constants.h"	/* for CT_SERIAL_NAME */
 #include "transform.h"
 #include "serial.h"
@@ -68,6 +69,7 @@
 #include "probes.h"
 #endif /* ENABLE_SYSTEMTAP */
 #include "dbtype.h"
+#include "thread_lockfree_hash_map.hpp"
 #include "thread_manager.hpp"	// for thread_get_thread_entry_info
 #include "db_value_printer.hpp"
 #include "log_append.hpp"
@@ -278,6 +280,15 @@ struct heap_chain
   INT32 flags;			/* Flags for heap page. 2 bits are used for vacuum state. */
 };
 
+/* Redo entry of a record in RVHF_MVCC_INSERT_MULTI log record. */
+typedef struct heap_insert_multi_redo_entry HEAP_INSERT_MULTI_REDO_ENTRY;
+struct heap_insert_multi_redo_entry
+{
+  PGSLOTID slotid;		/* Slot of inserted record */
+  INT16 type;			/* Record type */
+  INT32 length;			/* Record length; record data follows all the entries */
+};
+
 #define HEAP_CHK_ADD_UNFOUND_RELOCOIDS 100
 
 typedef struct heap_chk_relocoid HEAP_CHK_RELOCOID;
@@ -304,24 +315,26 @@ struct heap_chkall_relocoids
 #define DEFAULT_REPR_INCREMENT 16
 
 enum
-{ ZONE_VOID = 1, ZONE_FREE = 2, ZONE_LRU = 3 };
+{ ZONE_VOID = 1, ZONE_FREE = 2, ZONE_CACHED = 3 };
+
+/* fix_state of a class representation entry keeps the fix count and the decached flag. readers fix an entry with an
+ * atomic increment that fails once the entry is decached, so they never need a mutex. a decached entry is reused
+ * only after its last user unfixes it. */
+#define HEAP_CLASSREPR_ENTRY_DECACHED	    ((INT32) 0x80000000)
+#define HEAP_CLASSREPR_ENTRY_FIX_COUNT_MASK  ((INT32) 0x7FFFFFFF)
 
 typedef struct heap_classrepr_entry HEAP_CLASSREPR_ENTRY;
 struct heap_classrepr_entry
 {
-  pthread_mutex_t mutex;
   int idx;			/* Cache index. Used to pass the index when a class representation is in the cache */
-  int fcnt;			/* How many times this structure has been fixed. It cannot be deallocated until this
-				 * value is zero.  */
-  int zone;			/* ZONE_VOID, ZONE_LRU, ZONE_FREE */
-  bool force_decache;
+  volatile INT32 fix_state;	/* How many times this structure has been fixed and HEAP_CLASSREPR_ENTRY_DECACHED flag.
+				 * It cannot be reused until fix count is zero. */
+  int zone;			/* ZONE_VOID, ZONE_FREE, ZONE_CACHED */
+  volatile bool referenced;	/* fixed since the replacement clock passed it last time */
 
-  THREAD_ENTRY *next_wait_thrd;
-  HEAP_CLASSREPR_ENTRY *hash_next;
-  HEAP_CLASSREPR_ENTRY *prev;	/* prev. entry in LRU list */
-  HEAP_CLASSREPR_ENTRY *next;	/* prev. entry in LRU or free list */
+  HEAP_CLASSREPR_ENTRY *next;	/* next entry in free list */
 
-  /* real data */
+  /* real data; does not change while entry is cached, except for missing old representations that are added */
   OID class_oid;		/* Identifier of the class representation */
 
   OR_CLASSREP **repr;		/* A particular representation of the class */
@@ -329,37 +342,18 @@ struct heap_classrepr_entry
   REPR_ID last_reprid;
 };
 
-typedef struct heap_classrepr_lock HEAP_CLASSREPR_LOCK;
-struct heap_classrepr_lock
-{
-  OID class_oid;
-  HEAP_CLASSREPR_LOCK *lock_next;
-  THREAD_ENTRY *next_wait_thrd;
-};
-
-typedef struct heap_classrepr_hash HEAP_CLASSREPR_HASH;
-struct heap_classrepr_hash
+/* entry of lock-free hash class OID -> cache entry */
+typedef struct heap_classrepr_hash_entry HEAP_CLASSREPR_HASH_ENTRY;
+struct heap_classrepr_hash_entry
 {
-  pthread_mutex_t hash_mutex;
-  int idx;
-  HEAP_CLASSREPR_ENTRY *hash_next;
-  HEAP_CLASSREPR_LOCK *lock_next;
-};
+  OID class_oid;		/* key */
 
-typedef struct heap_classrepr_LRU_list HEAP_CLASSREPR_LRU_LIST;
-struct heap_classrepr_LRU_list
-{
-  pthread_mutex_t LRU_mutex;
-  HEAP_CLASSREPR_ENTRY *LRU_top;
-  HEAP_CLASSREPR_ENTRY *LRU_bottom;
-};
+  /* Latch-free stuff. */
+  HEAP_CLASSREPR_HASH_ENTRY *stack;	/* used in freelist */
+  HEAP_CLASSREPR_HASH_ENTRY *next;	/* used in hash table */
+  UINT64 del_id;		/* delete transaction ID (for lock free) */
 
-typedef struct heap_classrepr_free_list HEAP_CLASSREPR_FREE_LIST;
-struct heap_classrepr_free_list
-{
-  pthread_mutex_t free_mutex;
-  HEAP_CLASSREPR_ENTRY *free_top;
-  int free_cnt;
+  int entry_idx;		/* index of cache entry */
 };
 
 typedef struct heap_classrepr_cache HEAP_CLASSREPR_CACHE;
@@ -367,41 +361,31 @@ struct heap_classrepr_cache
 {
   int num_entries;
   HEAP_CLASSREPR_ENTRY *area;
-  int num_hash;
-  HEAP_CLASSREPR_HASH *hash_table;
-  HEAP_CLASSREPR_LOCK *lock_table;
-  HEAP_CLASSREPR_LRU_LIST LRU_list;
-  HEAP_CLASSREPR_FREE_LIST free_list;
+  pthread_mutex_t mutex;	/* serializes cache changes: adding, decaching and replacing entries */
+  HEAP_CLASSREPR_ENTRY *free_top;
+  int free_cnt;
+  int clock_hand;		/* next entry checked for replacement */
   HFID rootclass_hfid;
-#ifdef DEBUG_CLASSREPR_CACHE
-  int num_fix_entries;
-  pthread_mutex_t num_fix_entries_mutex;
-#endif				/* DEBUG_CLASSREPR_CACHE */
 };
 
 static HEAP_CLASSREPR_CACHE heap_Classrepr_cache = {
   -1,
   NULL,
-  -1,
-  NULL,
+  PTHREAD_MUTEX_INITIALIZER,
   NULL,
-  {
-   PTHREAD_MUTEX_INITIALIZER,
-   NULL,
-   NULL},
-  {
-   PTHREAD_MUTEX_INITIALIZER,
-   NULL,
-   -1},
+  -1,
+  0,
   {{NULL_FILEID, NULL_VOLID}, NULL_PAGEID}	/* rootclass_hfid */
-#ifdef DEBUG_CLASSREPR_CACHE
-  , 0, PTHREAD_MUTEX_INITIALIZER
-#endif /* DEBUG_CLASSREPR_CACHE */
 };
 
+// *INDENT-OFF*
+using heap_classrepr_hashmap_type = cubthread::lockfree_hashmap<OID, heap_classrepr_hash_entry>;
+// *INDENT-ON*
+
+static heap_classrepr_hashmap_type heap_Classrepr_hashmap;
+
 #define CLASSREPR_REPR_INCREMENT	10
 #define CLASSREPR_HASH_SIZE  (heap_Classrepr_cache.num_entries * 2)
-#define REPR_HASH(class_oid) (OID_PSEUDO_KEY(class_oid)%CLASSREPR_HASH_SIZE)
 
 #define HEAP_MAYNEED_DECACHE_GUESSED_LASTREPRS(class_oid, hfid) \
   do \
@@ -595,11 +579,6 @@ static PAGE_PTR heap_scan_pb_lock_and_fetch_debug (THREAD_ENTRY * thread_p, cons
 static int heap_classrepr_initialize_cache (void);
 static int heap_classrepr_finalize_cache (void);
 static int heap_classrepr_decache_guessed_last (const OID * class_oid);
-#ifdef SERVER_MODE
-static int heap_classrepr_lock_class (THREAD_ENTRY * thread_p, HEAP_CLASSREPR_HASH * hash_anchor,
-				      const OID * class_oid);
-static int heap_classrepr_unlock_class (HEAP_CLASSREPR_HASH * hash_anchor, const OID * class_oid, int need_hash_mutex);
-#endif
 
 static int heap_classrepr_dump (THREAD_ENTRY * thread_p, FILE * fp, const OID * class_oid, const OR_CLASSREP * repr);
 #ifdef DEBUG_CLASSREPR_CACHE
@@ -607,9 +586,16 @@ static int heap_classrepr_dump_cache (bool simple_dump);
 #endif /* DEBUG_CLASSREPR_CACHE */
 
 static int heap_classrepr_entry_reset (HEAP_CLASSREPR_ENTRY * cache_entry);
-static int heap_classrepr_entry_remove_from_LRU (HEAP_CLASSREPR_ENTRY * cache_entry);
-static HEAP_CLASSREPR_ENTRY *heap_classrepr_entry_alloc (void);
+static HEAP_CLASSREPR_ENTRY *heap_classrepr_entry_alloc (THREAD_ENTRY * thread_p);
 static int heap_classrepr_entry_free (HEAP_CLASSREPR_ENTRY * cache_entry);
+static HEAP_CLASSREPR_ENTRY *heap_classrepr_entry_fix (THREAD_ENTRY * thread_p, const OID * class_oid);
+static int heap_classrepr_entry_unfix (HEAP_CLASSREPR_ENTRY * cache_entry);
+static HEAP_CLASSREPR_ENTRY *heap_classrepr_entry_load (THREAD_ENTRY * thread_p, const OID * class_oid,
+							 RECDES * class_recdes, REPR_ID reprid,
+							 OR_CLASSREP ** repr_nocache);
+static void *heap_classrepr_hash_entry_alloc (void);
+static int heap_classrepr_hash_entry_free (void *entry);
+static int heap_classrepr_hash_entry_init (void *entry);
 
 static OR_CLASSREP *heap_classrepr_get_from_record (THREAD_ENTRY * thread_p, REPR_ID * last_reprid,
 						    const OID * class_oid, RECDES * class_recdes, REPR_ID reprid);
@@ -685,6 +671,7 @@ static int heap_attrinfo_start_refoids (THREAD_ENTRY * thread_p, OID * class_oid
 static int heap_attrinfo_get_disksize (HEAP_CACHE_ATTRINFO * attr_info, bool is_mvcc_class, int *offset_size_ptr);
 
 static int heap_attrvalue_read (RECDES * recdes, HEAP_ATTRVALUE * value, HEAP_CACHE_ATTRINFO * attr_info);
+static int heap_attrinfo_get_needed_length (const RECDES * recdes, const HEAP_CACHE_ATTRINFO * attr_info);
 
 static int heap_midxkey_get_value (RECDES * recdes, OR_ATTRIBUTE * att, DB_VALUE * value,
 				   HEAP_CACHE_ATTRINFO * attr_info);
@@ -770,7 +757,12 @@ static SCAN_CODE heap_get_page_info (THREAD_ENTRY * thread_p, const OID * cls_oi
 				     const PAGE_PTR pgptr, DB_VALUE ** page_info);
 static SCAN_CODE heap_get_bigone_content (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, bool ispeeking,
 					  OID * forward_oid, RECDES * recdes);
+static SCAN_CODE heap_get_bigone_prefix (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, OID * forward_oid,
+					 RECDES * recdes);
 static void heap_mvcc_log_insert (THREAD_ENTRY * thread_p, RECDES * p_recdes, LOG_DATA_ADDR * p_addr);
+static void heap_mvcc_log_insert_multi (THREAD_ENTRY * thread_p, RECDES * recdes_array, PGSLOTID * slotids,
+					int n_records, LOG_DATA_ADDR * p_addr);
+static void heap_rv_update_stats_after_undo_insert (THREAD_ENTRY * thread_p, PAGE_PTR page, int free_space);
 static void heap_mvcc_log_delete (THREAD_ENTRY * thread_p, LOG_DATA_ADDR * p_addr, LOG_RCVINDEX rcvindex);
 static int heap_rv_mvcc_redo_delete_internal (THREAD_ENTRY * thread_p, PAGE_PTR page, PGSLOTID slotid, MVCCID mvccid);
 static void heap_mvcc_log_home_change_on_delete (THREAD_ENTRY * thread_p, RECDES * old_recdes, RECDES * new_recdes,
@@ -810,6 +802,7 @@ static int heap_fix_forward_page (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEX
 static void heap_build_forwarding_recdes (RECDES * recdes_p, INT16 rec_type, OID * forward_oid);
 
 /* heap insert related functions */
+static void heap_insert_set_mvcc_insid (RECDES * recdes_p, MVCCID mvcc_id);
 static int heap_insert_adjust_recdes_header (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context,
 					     bool is_mvcc_class);
 static int heap_update_adjust_recdes_header (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * update_context,
@@ -849,6 +842,28 @@ static int heap_hfid_table_entry_uninit (void *entry);
 static int heap_hfid_table_entry_key_copy (void *src, void *dest);
 static unsigned int heap_hfid_table_entry_key_hash (void *key, int hash_table_size);
 static int heap_hfid_table_entry_key_compare (void *k1, void *k2);
+
+/* heap_Classrepr_hash_descriptor - class OID -> class representation cache entry, used by heap_Classrepr_hashmap */
+static LF_ENTRY_DESCRIPTOR heap_Classrepr_hash_descriptor = {
+  offsetof (HEAP_CLASSREPR_HASH_ENTRY, stack),
+  offsetof (HEAP_CLASSREPR_HASH_ENTRY, next),
+  offsetof (HEAP_CLASSREPR_HASH_ENTRY, del_id),
+  offsetof (HEAP_CLASSREPR_HASH_ENTRY, class_oid),
+  0,
+
+  /* not using mutex */
+  LF_EM_NOT_USING_MUTEX,
+
+  LF_ENTRY_DESCRIPTOR_MAX_ALLOC,
+  heap_classrepr_hash_entry_alloc,
+  heap_classrepr_hash_entry_free,
+  heap_classrepr_hash_entry_init,
+  NULL,
+  heap_hfid_table_entry_key_copy,
+  heap_hfid_table_entry_key_compare,
+  heap_hfid_table_entry_key_hash,
+  NULL				/* duplicates not accepted. */
+};
 static int heap_hfid_cache_get (THREAD_ENTRY * thread_p, const OID * class_oid, HFID * hfid, FILE_TYPE * ftype_out,
 				char **classname_out);
 static int heap_get_class_info_from_record (THREAD_ENTRY * thread_p, const OID * class_oid, HFID * hfid,
@@ -1386,10 +1401,7 @@ static int
 heap_classrepr_initialize_cache (void)
 {
   HEAP_CLASSREPR_ENTRY *cache_entry;
-  HEAP_CLASSREPR_LOCK *lock_entry;
-  HEAP_CLASSREPR_HASH *hash_entry;
   int i, ret = NO_ERROR;
-  size_t size;
 
   if (heap_Classrepr != NULL)
     {
@@ -1400,7 +1412,7 @@ heap_classrepr_initialize_cache (void)
 	}
     }
 
-  /* initialize hash entries table */
+  /* initialize cache entries */
   heap_Classrepr_cache.num_entries = HEAP_CLASSREPR_MAXCACHE;
 
   heap_Classrepr_cache.area =
@@ -1416,18 +1428,12 @@ heap_classrepr_initialize_cache (void)
   cache_entry = heap_Classrepr_cache.area;
   for (i = 0; i < heap_Classrepr_cache.num_entries; i++)
     {
-      pthread_mutex_init (&cache_entry[i].mutex, NULL);
-
       cache_entry[i].idx = i;
-      cache_entry[i].fcnt = 0;
+      cache_entry[i].fix_state = HEAP_CLASSREPR_ENTRY_DECACHED;
       cache_entry[i].zone = ZONE_FREE;
-      cache_entry[i].next_wait_thrd = NULL;
-      cache_entry[i].hash_next = NULL;
-      cache_entry[i].prev = NULL;
+      cache_entry[i].referenced = false;
       cache_entry[i].next = (i < heap_Classrepr_cache.num_entries - 1) ? &cache_entry[i + 1] : NULL;
 
-      cache_entry[i].force_decache = false;
-
       OID_SET_NULL (&cache_entry[i].class_oid);
       cache_entry[i].max_reprid = DEFAULT_REPR_INCREMENT;
       cache_entry[i].repr = (OR_CLASSREP **) malloc (cache_entry[i].max_reprid * sizeof (OR_CLASSREP *));
@@ -1442,53 +1448,15 @@ heap_classrepr_initialize_cache (void)
       cache_entry[i].last_reprid = NULL_REPRID;
     }
 
-  /* initialize hash bucket table */
-  heap_Classrepr_cache.num_hash = CLASSREPR_HASH_SIZE;
-  heap_Classrepr_cache.hash_table =
-    (HEAP_CLASSREPR_HASH *) malloc (heap_Classrepr_cache.num_hash * sizeof (HEAP_CLASSREPR_HASH));
-  if (heap_Classrepr_cache.hash_table == NULL)
-    {
-      ret = ER_OUT_OF_VIRTUAL_MEMORY;
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ret, 1, heap_Classrepr_cache.num_hash * sizeof (HEAP_CLASSREPR_HASH));
-      goto exit_on_error;
-    }
-
-  hash_entry = heap_Classrepr_cache.hash_table;
-  for (i = 0; i < heap_Classrepr_cache.num_hash; i++)
-    {
-      pthread_mutex_init (&hash_entry[i].hash_mutex, NULL);
-      hash_entry[i].idx = i;
-      hash_entry[i].hash_next = NULL;
-      hash_entry[i].lock_next = NULL;
-    }
-
-  /* initialize hash lock table */
-  size = thread_num_total_threads () * sizeof (HEAP_CLASSREPR_LOCK);
-  heap_Classrepr_cache.lock_table = (HEAP_CLASSREPR_LOCK *) malloc (size);
-  if (heap_Classrepr_cache.lock_table == NULL)
-    {
-      ret = ER_OUT_OF_VIRTUAL_MEMORY;
-      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ret, 1, size);
-      goto exit_on_error;
-    }
-  lock_entry = heap_Classrepr_cache.lock_table;
-  for (i = 0; i < (int) thread_num_total_threads (); i++)
-    {
-      OID_SET_NULL (&lock_entry[i].class_oid);
-      lock_entry[i].lock_next = NULL;
-      lock_entry[i].next_wait_thrd = NULL;
-    }
-
-  /* initialize LRU list */
-
-  pthread_mutex_init (&heap_Classrepr_cache.LRU_list.LRU_mutex, NULL);
-  heap_Classrepr_cache.LRU_list.LRU_top = NULL;
-  heap_Classrepr_cache.LRU_list.LRU_bottom = NULL;
+  /* initialize lock-free hash class OID -> cache entry */
+  heap_Classrepr_hashmap.init (classrepr_Ts, THREAD_TS_CLASSREPR, CLASSREPR_HASH_SIZE,
+			       std::max (1, heap_Classrepr_cache.num_entries / 2), 2, heap_Classrepr_hash_descriptor);
 
   /* initialize free list */
-  pthread_mutex_init (&heap_Classrepr_cache.free_list.free_mutex, NULL);
-  heap_Classrepr_cache.free_list.free_top = &heap_Classrepr_cache.area[0];
-  heap_Classrepr_cache.free_list.free_cnt = heap_Classrepr_cache.num_entries;
+  pthread_mutex_init (&heap_Classrepr_cache.mutex, NULL);
+  heap_Classrepr_cache.free_top = &heap_Classrepr_cache.area[0];
+  heap_Classrepr_cache.free_cnt = heap_Classrepr_cache.num_entries;
+  heap_Classrepr_cache.clock_hand = 0;
 
   heap_Classrepr = &heap_Classrepr_cache;
 
@@ -1501,7 +1469,6 @@ exit_on_error:
   return (ret == NO_ERROR) ? ER_FAILED : ret;
 }
 
-/* TODO: STL::list for _cache.area */
 /*
  * heap_classrepr_finalize_cache () - Destroy any cached structures
  *   return: NO_ERROR
@@ -1513,7 +1480,6 @@ static int
 heap_classrepr_finalize_cache (void)
 {
   HEAP_CLASSREPR_ENTRY *cache_entry;
-  HEAP_CLASSREPR_HASH *hash_entry;
   int i, j;
   int ret = NO_ERROR;
 
@@ -1530,12 +1496,13 @@ heap_classrepr_finalize_cache (void)
     }
 #endif /* DEBUG_CLASSREPR_CACHE */
 
-  /* finalize hash entries table */
+  /* finalize hash */
+  heap_Classrepr_hashmap.destroy ();
+
+  /* finalize cache entries */
   cache_entry = heap_Classrepr->area;
   for (i = 0; cache_entry != NULL && i < heap_Classrepr->num_entries; i++)
     {
-      pthread_mutex_destroy (&cache_entry[i].mutex);
-
       if (cache_entry[i].repr == NULL)
 	{
 	  assert (cache_entry[i].repr != NULL);
@@ -1558,34 +1525,52 @@ heap_classrepr_finalize_cache (void)
     }
   heap_Classrepr->num_entries = -1;
 
-  /* finalize hash bucket table */
-  hash_entry = heap_Classrepr->hash_table;
-  for (i = 0; hash_entry != NULL && i < heap_Classrepr->num_hash; i++)
-    {
-      pthread_mutex_destroy (&hash_entry[i].hash_mutex);
-    }
-  heap_Classrepr->num_hash = -1;
-  if (heap_Classrepr->hash_table != NULL)
-    {
-      free_and_init (heap_Classrepr->hash_table);
-    }
+  /* finalize free list */
+  pthread_mutex_destroy (&heap_Classrepr->mutex);
+  heap_Classrepr->free_top = NULL;
+  heap_Classrepr->free_cnt = -1;
 
-  /* finalize hash lock table */
-  if (heap_Classrepr->lock_table != NULL)
-    {
-      free_and_init (heap_Classrepr->lock_table);
-    }
+  heap_Classrepr = NULL;
+
+  return ret;
+}
 
-  /* finalize LRU list */
+/*
+ * heap_classrepr_hash_entry_alloc () - allocate an entry of class OID -> cache entry hash
+ *   return: new entry or NULL
+ */
+static void *
+heap_classrepr_hash_entry_alloc (void)
+{
+  return malloc (sizeof (HEAP_CLASSREPR_HASH_ENTRY));
+}
 
-  pthread_mutex_destroy (&heap_Classrepr->LRU_list.LRU_mutex);
+/*
+ * heap_classrepr_hash_entry_free () - free an entry of class OID -> cache entry hash
+ *   return: NO_ERROR
+ *   entry(in): hash entry
+ */
+static int
+heap_classrepr_hash_entry_free (void *entry)
+{
+  free (entry);
+  return NO_ERROR;
+}
 
-  /* initialize free list */
-  pthread_mutex_destroy (&heap_Classrepr->free_list.free_mutex);
+/*
+ * heap_classrepr_hash_entry_init () - initialize an entry of class OID -> cache entry hash
+ *   return: NO_ERROR
+ *   entry(in): hash entry
+ */
+static int
+heap_classrepr_hash_entry_init (void *entry)
+{
+  HEAP_CLASSREPR_HASH_ENTRY *hash_entry = (HEAP_CLASSREPR_HASH_ENTRY *) entry;
 
-  heap_Classrepr = NULL;
+  OID_SET_NULL (&hash_entry->class_oid);
+  hash_entry->entry_idx = -1;
 
-  return ret;
+  return NO_ERROR;
 }
 
 /*
@@ -1593,7 +1578,7 @@ heap_classrepr_finalize_cache (void)
  *   return: NO_ERROR
  *   cache_entry(in):
  *
- * Note: Reset the given class representation entry.
+ * Note: Reset the given class representation entry. The entry must be decached and unfixed.
  */
 static int
 heap_classrepr_entry_reset (HEAP_CLASSREPR_ENTRY * cache_entry)
@@ -1606,6 +1591,8 @@ heap_classrepr_entry_reset (HEAP_CLASSREPR_ENTRY * cache_entry)
       return NO_ERROR;		/* nop */
     }
 
+  assert (cache_entry->fix_state == HEAP_CLASSREPR_ENTRY_DECACHED);
+
   /* free all classrepr */
   for (i = 0; i <= cache_entry->last_reprid; i++)
     {
@@ -1616,8 +1603,8 @@ heap_classrepr_entry_reset (HEAP_CLASSREPR_ENTRY * cache_entry)
 	}
     }
 
-  cache_entry->force_decache = false;
   OID_SET_NULL (&cache_entry->class_oid);
+  cache_entry->referenced = false;
   if (cache_entry->max_reprid > DEFAULT_REPR_INCREMENT)
     {
       OR_CLASSREP **t;
@@ -1644,38 +1631,89 @@ heap_classrepr_entry_reset (HEAP_CLASSREPR_ENTRY * cache_entry)
 }
 
 /*
- * heap_classrepr_entry_remove_from_LRU () -
- *   return: NO_ERROR
- *   cache_entry(in):
+ * heap_classrepr_entry_fix () - Find and fix the cache entry of a class
+ *   return: fixed cache entry or NULL if class is not cached
+ *   class_oid(in): The class identifier
+ *
+ * Note: No mutex is used. The lock-free transaction of the hash only protects the hash entry until the cache entry
+ *       is fixed; the cache entry may be decached or even replaced by another class in the meantime, which is
+ *       detected by the fix state and by checking the class identifier after fix.
  */
-static int
-heap_classrepr_entry_remove_from_LRU (HEAP_CLASSREPR_ENTRY * cache_entry)
+static HEAP_CLASSREPR_ENTRY *
+heap_classrepr_entry_fix (THREAD_ENTRY * thread_p, const OID * class_oid)
 {
-  if (cache_entry)
+  HEAP_CLASSREPR_HASH_ENTRY *hash_entry;
+  HEAP_CLASSREPR_ENTRY *cache_entry;
+  OID key = *class_oid;
+  INT32 fix_state;
+
+  hash_entry = heap_Classrepr_hashmap.find (thread_p, key);
+  if (hash_entry == NULL)
     {
-      if (cache_entry == heap_Classrepr->LRU_list.LRU_top)
-	{
-	  heap_Classrepr->LRU_list.LRU_top = cache_entry->next;
-	}
-      else
-	{
-	  cache_entry->prev->next = cache_entry->next;
-	}
+      return NULL;
+    }
+  assert (hash_entry->entry_idx >= 0 && hash_entry->entry_idx < heap_Classrepr->num_entries);
+  cache_entry = &heap_Classrepr->area[hash_entry->entry_idx];
+  heap_Classrepr_hashmap.unlock (thread_p, hash_entry);
 
-      if (cache_entry == heap_Classrepr->LRU_list.LRU_bottom)
+  do
+    {
+      fix_state = cache_entry->fix_state;
+      if (fix_state & HEAP_CLASSREPR_ENTRY_DECACHED)
 	{
-	  heap_Classrepr->LRU_list.LRU_bottom = cache_entry->prev;
+	  /* decached or replaced */
+	  return NULL;
 	}
-      else
+    }
+  while (!ATOMIC_CAS_32 (&cache_entry->fix_state, fix_state, fix_state + 1));
+
+  if (!OID_EQ (&cache_entry->class_oid, class_oid))
+    {
+      /* entry was replaced and reused by another class before we fixed it */
+      (void) heap_classrepr_entry_unfix (cache_entry);
+      return NULL;
+    }
+
+  if (!cache_entry->referenced)
+    {
+      cache_entry->referenced = true;
+    }
+
+  return cache_entry;
+}
+
+/*
+ * heap_classrepr_entry_unfix () - Unfix a cache entry
+ *   return: NO_ERROR
+ *   cache_entry(in):
+ *
+ * Note: The last user of a decached entry moves it to free list.
+ */
+static int
+heap_classrepr_entry_unfix (HEAP_CLASSREPR_ENTRY * cache_entry)
+{
+  INT32 fix_state;
+  int rv;
+  int ret = NO_ERROR;
+
+  fix_state = ATOMIC_INC_32 (&cache_entry->fix_state, -1);
+  assert ((fix_state & HEAP_CLASSREPR_ENTRY_FIX_COUNT_MASK) != HEAP_CLASSREPR_ENTRY_FIX_COUNT_MASK);
+
+  if (fix_state == HEAP_CLASSREPR_ENTRY_DECACHED)
+    {
+      /* cache_entry is already removed from hash; move cache_entry to free_list */
+      rv = pthread_mutex_lock (&heap_Classrepr->mutex);
+      ret = heap_classrepr_entry_reset (cache_entry);
+      if (ret == NO_ERROR)
 	{
-	  cache_entry->next->prev = cache_entry->prev;
+	  ret = heap_classrepr_entry_free (cache_entry);
 	}
+      pthread_mutex_unlock (&heap_Classrepr->mutex);
     }
 
-  return NO_ERROR;
+  return ret;
 }
 
-/* TODO: STL::list for ->prev */
 /*
  * heap_classrepr_decache_guessed_last () -
  *   return: NO_ERROR
@@ -1686,12 +1724,18 @@ heap_classrepr_entry_remove_from_LRU (HEAP_CLASSREPR_ENTRY * cache_entry)
  *
  * Note: This function should be called when a class is updated.
  *       1: During normal update
+ *
+ * Note: Transactions that have fixed the representations of the class can keep using them; the entry is reused
+ *       after they are all freed.
  */
 static int
 heap_classrepr_decache_guessed_last (const OID * class_oid)
 {
-  HEAP_CLASSREPR_ENTRY *cache_entry, *prev_entry, *cur_entry;
-  HEAP_CLASSREPR_HASH *hash_anchor;
+  THREAD_ENTRY *thread_p;
+  HEAP_CLASSREPR_HASH_ENTRY *hash_entry;
+  HEAP_CLASSREPR_ENTRY *cache_entry;
+  OID key;
+  INT32 fix_state;
   int rv;
   int ret = NO_ERROR;
 
@@ -1699,104 +1743,34 @@ heap_classrepr_decache_guessed_last (const OID * class_oid)
 
   if (class_oid != NULL)
     {
-      hash_anchor = &heap_Classrepr->hash_table[REPR_HASH (class_oid)];
-
-    search_begin:
-      rv = pthread_mutex_lock (&hash_anchor->hash_mutex);
-
-      for (cache_entry = hash_anchor->hash_next; cache_entry != NULL; cache_entry = cache_entry->hash_next)
-	{
-	  if (OID_EQ (class_oid, &cache_entry->class_oid))
-	    {
-	      rv = pthread_mutex_trylock (&cache_entry->mutex);
-	      if (rv == 0)
-		{
-		  goto delete_begin;
-		}
-
-	      if (rv != EBUSY)
-		{
-		  ret = ER_CSS_PTHREAD_MUTEX_LOCK;
-		  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE, ret, 0);
-		  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-		  return ret;
-		}
-
-	      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	      rv = pthread_mutex_lock (&cache_entry->mutex);
-
-	      /* cache_entry can be used by others. check again */
-	      if (!OID_EQ (class_oid, &cache_entry->class_oid))
-		{
-		  pthread_mutex_unlock (&cache_entry->mutex);
-		  goto search_begin;
-		}
-	      break;
-	    }
-	}
-
-      /* class_oid cache_entry is not found */
-      if (cache_entry == NULL)
-	{
-	  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	  return NO_ERROR;
-	}
-
-      /* hash anchor lock has been released */
-      rv = pthread_mutex_lock (&hash_anchor->hash_mutex);
-
-    delete_begin:
+      thread_p = thread_get_thread_entry_info ();
+      key = *class_oid;
 
-      /* delete classrepr from hash chain */
-      prev_entry = NULL;
-      cur_entry = hash_anchor->hash_next;
-      while (cur_entry != NULL)
-	{
-	  if (cur_entry == cache_entry)
-	    {
-	      break;
-	    }
-	  prev_entry = cur_entry;
-	  cur_entry = cur_entry->hash_next;
-	}
+      rv = pthread_mutex_lock (&heap_Classrepr->mutex);
 
-      /* class_oid cache_entry is not found */
-      if (cur_entry == NULL)
+      hash_entry = heap_Classrepr_hashmap.find (thread_p, key);
+      if (hash_entry == NULL)
 	{
-	  /* This cannot happen */
-	  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	  pthread_mutex_unlock (&cache_entry->mutex);
-
+	  /* class_oid cache_entry is not found */
+	  pthread_mutex_unlock (&heap_Classrepr->mutex);
 	  return NO_ERROR;
 	}
+      cache_entry = &heap_Classrepr->area[hash_entry->entry_idx];
+      heap_Classrepr_hashmap.unlock (thread_p, hash_entry);
 
-      if (prev_entry == NULL)
-	{
-	  hash_anchor->hash_next = cur_entry->hash_next;
-	}
-      else
+      /* stop new fixes */
+      do
 	{
-	  prev_entry->hash_next = cur_entry->hash_next;
+	  fix_state = cache_entry->fix_state;
+	  assert (!(fix_state & HEAP_CLASSREPR_ENTRY_DECACHED));
 	}
-      cur_entry->hash_next = NULL;
+      while (!ATOMIC_CAS_32 (&cache_entry->fix_state, fix_state, fix_state | HEAP_CLASSREPR_ENTRY_DECACHED));
 
-      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-
-      cache_entry->force_decache = true;
-
-      /* Remove from LRU list */
-      if (cache_entry->zone == ZONE_LRU)
-	{
-	  rv = pthread_mutex_lock (&heap_Classrepr->LRU_list.LRU_mutex);
-	  (void) heap_classrepr_entry_remove_from_LRU (cache_entry);
-	  pthread_mutex_unlock (&heap_Classrepr->LRU_list.LRU_mutex);
-	  cache_entry->zone = ZONE_VOID;
-	}
-      cache_entry->prev = NULL;
-      cache_entry->next = NULL;
+      /* delete classrepr from hash */
+      (void) heap_Classrepr_hashmap.erase (thread_p, key);
+      cache_entry->zone = ZONE_VOID;
 
-      int save_fcnt = cache_entry->fcnt;
-      if (cache_entry->fcnt == 0)
+      if (fix_state == 0)
 	{
 	  /* move cache_entry to free_list */
 	  ret = heap_classrepr_entry_reset (cache_entry);
@@ -1806,10 +1780,10 @@ heap_classrepr_decache_guessed_last (const OID * class_oid)
 	    }
 	}
 
-      pthread_mutex_unlock (&cache_entry->mutex);
+      pthread_mutex_unlock (&heap_Classrepr->mutex);
 
       heap_classrepr_log_er ("heap_classrepr_decache_guessed_last %d|%d|%d cache_entry=%p fcnt=%d",
-			     OID_AS_ARGS (class_oid), cache_entry, save_fcnt);
+			     OID_AS_ARGS (class_oid), cache_entry, fix_state);
     }
   return ret;
 }
@@ -1886,7 +1860,6 @@ heap_classrepr_restart_cache (void)
   return NO_ERROR;
 }
 
-/* TODO: STL::list for _cache.area */
 /*
  * heap_classrepr_free () - Free a class representation
  *   return: NO_ERROR
@@ -1907,8 +1880,6 @@ heap_classrepr_restart_cache (void)
 int
 heap_classrepr_free (OR_CLASSREP * classrep, int *idx_incache)
 {
-  HEAP_CLASSREPR_ENTRY *cache_entry;
-  int rv;
   int ret = NO_ERROR;
 
   if (*idx_incache < 0)
@@ -1917,333 +1888,90 @@ heap_classrepr_free (OR_CLASSREP * classrep, int *idx_incache)
       return NO_ERROR;
     }
 
-  cache_entry = &heap_Classrepr->area[*idx_incache];
-
-  rv = pthread_mutex_lock (&cache_entry->mutex);
-  cache_entry->fcnt--;
-  if (cache_entry->fcnt == 0)
-    {
-      /*
-       * Is this entry declared to be decached
-       */
-#ifdef DEBUG_CLASSREPR_CACHE
-      rv = pthread_mutex_lock (&heap_Classrepr->num_fix_entries_mutex);
-      heap_Classrepr->num_fix_entries--;
-      pthread_mutex_unlock (&heap_Classrepr->num_fix_entries_mutex);
-#endif /* DEBUG_CLASSREPR_CACHE */
-      if (cache_entry->force_decache)
-	{
-	  /* cache_entry is already removed from LRU list. */
-
-	  /* move cache_entry to free_list */
-	  ret = heap_classrepr_entry_free (cache_entry);
-	  if (ret == NO_ERROR)
-	    {
-	      ret = heap_classrepr_entry_reset (cache_entry);
-	    }
-	}
-      else
-	{
-	  /* relocate entry to the top of LRU list */
-	  if (cache_entry != heap_Classrepr->LRU_list.LRU_top)
-	    {
-	      rv = pthread_mutex_lock (&heap_Classrepr->LRU_list.LRU_mutex);
-	      if (cache_entry->zone == ZONE_LRU)
-		{
-		  /* remove from LRU list */
-		  (void) heap_classrepr_entry_remove_from_LRU (cache_entry);
-		}
-
-	      /* insert into LRU top */
-	      cache_entry->prev = NULL;
-	      cache_entry->next = heap_Classrepr->LRU_list.LRU_top;
-	      if (heap_Classrepr->LRU_list.LRU_top == NULL)
-		{
-		  heap_Classrepr->LRU_list.LRU_bottom = cache_entry;
-		}
-	      else
-		{
-		  heap_Classrepr->LRU_list.LRU_top->prev = cache_entry;
-		}
-	      heap_Classrepr->LRU_list.LRU_top = cache_entry;
-	      cache_entry->zone = ZONE_LRU;
-
-	      pthread_mutex_unlock (&heap_Classrepr->LRU_list.LRU_mutex);
-	    }
-	}
-    }
-  pthread_mutex_unlock (&cache_entry->mutex);
+  ret = heap_classrepr_entry_unfix (&heap_Classrepr->area[*idx_incache]);
   *idx_incache = -1;
 
   return ret;
 }
 
-#ifdef SERVER_MODE
-
-enum
-{ NEED_TO_RETRY = 0, LOCK_ACQUIRED };
-
 /*
- * heap_classrepr_lock_class () - Prevent other threads accessing class_oid
- *                              class representation.
- *   return: ER_FAILED, NEED_TO_RETRY or LOCK_ACQUIRED
- *   hash_anchor(in):
- *   class_oid(in):
+ * heap_classrepr_entry_alloc () - Get an entry to cache a class
+ *   return: decached and unfixed entry, or NULL if all entries are in use
+ *
+ * Note: Caller must hold the cache mutex. Entries are taken from free list first; otherwise an unfixed entry is
+ *       replaced. The replacement clock gives a second chance to entries that were fixed since it passed them.
  */
-static int
-heap_classrepr_lock_class (THREAD_ENTRY * thread_p, HEAP_CLASSREPR_HASH * hash_anchor, const OID * class_oid)
+static HEAP_CLASSREPR_ENTRY *
+heap_classrepr_entry_alloc (THREAD_ENTRY * thread_p)
 {
-  HEAP_CLASSREPR_LOCK *cur_lock_entry;
-  THREAD_ENTRY *cur_thrd_entry;
+  HEAP_CLASSREPR_ENTRY *cache_entry;
+  OID key;
+  int i;
 
-  if (thread_p == NULL)
+  /* 1. Get entry from free list */
+  if (heap_Classrepr->free_top != NULL)
     {
-      thread_p = thread_get_thread_entry_info ();
-      if (thread_p == NULL)
-	{
-	  return ER_FAILED;
-	}
+      cache_entry = heap_Classrepr->free_top;
+      heap_Classrepr->free_top = cache_entry->next;
+      heap_Classrepr->free_cnt--;
+
+      cache_entry->next = NULL;
+      cache_entry->zone = ZONE_VOID;
+
+      return cache_entry;
     }
-  cur_thrd_entry = thread_p;
 
-  for (cur_lock_entry = hash_anchor->lock_next; cur_lock_entry != NULL; cur_lock_entry = cur_lock_entry->lock_next)
+  /* 2. Replace a cached entry */
+  for (i = 0; i < 2 * heap_Classrepr->num_entries; i++)
     {
-      if (OID_EQ (&cur_lock_entry->class_oid, class_oid))
-	{
-	  cur_thrd_entry->next_wait_thrd = cur_lock_entry->next_wait_thrd;
-	  cur_lock_entry->next_wait_thrd = cur_thrd_entry;
-
-	  thread_lock_entry (cur_thrd_entry);
-	  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	  thread_suspend_wakeup_and_unlock_entry (cur_thrd_entry, THREAD_HEAP_CLSREPR_SUSPENDED);
+      cache_entry = &heap_Classrepr->area[heap_Classrepr->clock_hand];
+      heap_Classrepr->clock_hand = (heap_Classrepr->clock_hand + 1) % heap_Classrepr->num_entries;
 
-	  if (cur_thrd_entry->resume_status == THREAD_HEAP_CLSREPR_RESUMED)
-	    {
-	      return NEED_TO_RETRY;	/* traverse hash chain again */
-	    }
-	  else
-	    {
-	      /* probably due to an interrupt */
-	      assert ((cur_thrd_entry->resume_status == THREAD_RESUME_DUE_TO_INTERRUPT));
-	      return ER_FAILED;
-	    }
+      if (cache_entry->zone != ZONE_CACHED)
+	{
+	  continue;
 	}
-    }
+      if (cache_entry->referenced)
+	{
+	  cache_entry->referenced = false;
+	  continue;
+	}
+      if (!ATOMIC_CAS_32 (&cache_entry->fix_state, 0, HEAP_CLASSREPR_ENTRY_DECACHED))
+	{
+	  /* in use */
+	  continue;
+	}
+
+      /* delete classrepr from hash */
+      key = cache_entry->class_oid;
+      (void) heap_Classrepr_hashmap.erase (thread_p, key);
+      cache_entry->zone = ZONE_VOID;
 
-  cur_lock_entry = &heap_Classrepr->lock_table[cur_thrd_entry->index];
-  cur_lock_entry->class_oid = *class_oid;
-  cur_lock_entry->next_wait_thrd = NULL;
-  cur_lock_entry->lock_next = hash_anchor->lock_next;
-  hash_anchor->lock_next = cur_lock_entry;
+      (void) heap_classrepr_entry_reset (cache_entry);
 
-  pthread_mutex_unlock (&hash_anchor->hash_mutex);
+      return cache_entry;
+    }
 
-  return LOCK_ACQUIRED;		/* lock acquired. */
+  /* not supported */
+  return NULL;
 }
 
 /*
- * heap_classrepr_unlock_class () -
+ * heap_classrepr_entry_free () -
  *   return: NO_ERROR
- *   hash_anchor(in):
- *   class_oid(in):
- *   need_hash_mutex(in):
+ *   cache_entry(in):
+ *
+ * Note: Caller must hold the cache mutex.
  */
 static int
-heap_classrepr_unlock_class (HEAP_CLASSREPR_HASH * hash_anchor, const OID * class_oid, int need_hash_mutex)
+heap_classrepr_entry_free (HEAP_CLASSREPR_ENTRY * cache_entry)
 {
-  HEAP_CLASSREPR_LOCK *prev_lock_entry, *cur_lock_entry;
-  THREAD_ENTRY *cur_thrd_entry;
-  int rv;
+  assert (cache_entry->fix_state == HEAP_CLASSREPR_ENTRY_DECACHED);
 
-  /* if hash mutex lock is not acquired */
-  if (need_hash_mutex)
-    {
-      rv = pthread_mutex_lock (&hash_anchor->hash_mutex);
-    }
-
-  prev_lock_entry = NULL;
-  cur_lock_entry = hash_anchor->lock_next;
-  while (cur_lock_entry != NULL)
-    {
-      if (OID_EQ (&cur_lock_entry->class_oid, class_oid))
-	{
-	  break;
-	}
-      prev_lock_entry = cur_lock_entry;
-      cur_lock_entry = cur_lock_entry->lock_next;
-    }
-
-  /* if lock entry is found, remove it from lock list */
-  if (cur_lock_entry == NULL)
-    {				/* this cannot happen */
-      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-      return ER_FAILED;
-    }
-
-  if (prev_lock_entry == NULL)
-    {
-      hash_anchor->lock_next = cur_lock_entry->lock_next;
-    }
-  else
-    {
-      prev_lock_entry->lock_next = cur_lock_entry->lock_next;
-    }
-  cur_lock_entry->lock_next = NULL;
-  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-  for (cur_thrd_entry = cur_lock_entry->next_wait_thrd; cur_thrd_entry != NULL;
-       cur_thrd_entry = cur_lock_entry->next_wait_thrd)
-    {
-      cur_lock_entry->next_wait_thrd = cur_thrd_entry->next_wait_thrd;
-      cur_thrd_entry->next_wait_thrd = NULL;
-
-      thread_wakeup (cur_thrd_entry, THREAD_HEAP_CLSREPR_RESUMED);
-    }
-
-  return NO_ERROR;
-}
-#endif /* SERVER_MODE */
-
-/* TODO: STL::list for ->prev */
-/*
- * heap_classrepr_entry_alloc () -
- *   return:
- */
-static HEAP_CLASSREPR_ENTRY *
-heap_classrepr_entry_alloc (void)
-{
-  HEAP_CLASSREPR_HASH *hash_anchor;
-  HEAP_CLASSREPR_ENTRY *cache_entry, *prev_entry, *cur_entry;
-  int rv;
-
-  cache_entry = NULL;
-
-/* check_free_list: */
-
-  /* 1. Get entry from free list */
-  if (heap_Classrepr->free_list.free_top == NULL)
-    {
-      goto check_LRU_list;
-    }
-
-  rv = pthread_mutex_lock (&heap_Classrepr->free_list.free_mutex);
-  if (heap_Classrepr->free_list.free_top == NULL)
-    {
-      pthread_mutex_unlock (&heap_Classrepr->free_list.free_mutex);
-      cache_entry = NULL;
-    }
-  else
-    {
-      cache_entry = heap_Classrepr->free_list.free_top;
-      heap_Classrepr->free_list.free_top = cache_entry->next;
-      heap_Classrepr->free_list.free_cnt--;
-      pthread_mutex_unlock (&heap_Classrepr->free_list.free_mutex);
-
-      rv = pthread_mutex_lock (&cache_entry->mutex);
-      cache_entry->next = NULL;
-      cache_entry->zone = ZONE_VOID;
-
-      return cache_entry;
-    }
-
-check_LRU_list:
-  /* 2. Get entry from LRU list */
-  if (heap_Classrepr->LRU_list.LRU_bottom == NULL)
-    {
-      goto expand_list;
-    }
-
-  rv = pthread_mutex_lock (&heap_Classrepr->LRU_list.LRU_mutex);
-  for (cache_entry = heap_Classrepr->LRU_list.LRU_bottom; cache_entry != NULL; cache_entry = cache_entry->prev)
-    {
-      if (cache_entry->fcnt == 0)
-	{
-	  /* remove from LRU list */
-	  (void) heap_classrepr_entry_remove_from_LRU (cache_entry);
-	  cache_entry->zone = ZONE_VOID;
-	  cache_entry->next = cache_entry->prev = NULL;
-	  break;
-	}
-    }
-  pthread_mutex_unlock (&heap_Classrepr->LRU_list.LRU_mutex);
-
-  if (cache_entry == NULL)
-    {
-      goto expand_list;
-    }
-
-  rv = pthread_mutex_lock (&cache_entry->mutex);
-  /* if some has referenced, retry */
-  if (cache_entry->fcnt != 0)
-    {
-      pthread_mutex_unlock (&cache_entry->mutex);
-      goto check_LRU_list;
-    }
-
-  /* delete classrepr from hash chain */
-  hash_anchor = &heap_Classrepr->hash_table[REPR_HASH (&cache_entry->class_oid)];
-  rv = pthread_mutex_lock (&hash_anchor->hash_mutex);
-  prev_entry = NULL;
-  cur_entry = hash_anchor->hash_next;
-  while (cur_entry != NULL)
-    {
-      if (cur_entry == cache_entry)
-	{
-	  break;
-	}
-      prev_entry = cur_entry;
-      cur_entry = cur_entry->hash_next;
-    }
-
-  if (cur_entry == NULL)
-    {
-      /* This cannot happen */
-      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-      pthread_mutex_unlock (&cache_entry->mutex);
-
-      return NULL;
-    }
-  if (prev_entry == NULL)
-    {
-      hash_anchor->hash_next = cur_entry->hash_next;
-    }
-  else
-    {
-      prev_entry->hash_next = cur_entry->hash_next;
-    }
-  cur_entry->hash_next = NULL;
-  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-
-  (void) heap_classrepr_entry_reset (cache_entry);
-
-end:
-
-  return cache_entry;
-
-expand_list:
-
-  /* not supported */
-  cache_entry = NULL;
-  goto end;
-}
-
-/* TODO: STL::list for ->next */
-/*
- * heap_classrepr_entry_free () -
- *   return: NO_ERROR
- *   cache_entry(in):
- */
-static int
-heap_classrepr_entry_free (HEAP_CLASSREPR_ENTRY * cache_entry)
-{
-  int rv;
-  rv = pthread_mutex_lock (&heap_Classrepr->free_list.free_mutex);
-
-  cache_entry->next = heap_Classrepr->free_list.free_top;
-  heap_Classrepr->free_list.free_top = cache_entry;
-  cache_entry->zone = ZONE_FREE;
-  heap_Classrepr->free_list.free_cnt++;
-
-  pthread_mutex_unlock (&heap_Classrepr->free_list.free_mutex);
+  cache_entry->next = heap_Classrepr->free_top;
+  heap_Classrepr->free_top = cache_entry;
+  cache_entry->zone = ZONE_FREE;
+  heap_Classrepr->free_cnt++;
 
   return NO_ERROR;
 }
@@ -2300,314 +2028,230 @@ end:
 }
 
 /*
- * heap_classrepr_get () - Obtain the desired class representation
- *   return: classrepr
+ * heap_classrepr_entry_load () - Read class representations from class record and cache them
+ *   return: fixed cache entry or NULL
  *   class_oid(in): The class identifier
  *   class_recdes(in): The class recdes (when know) or NULL
  *   reprid(in): Representation of the class or NULL_REPRID for last one
- *   idx_incache(in): An index if the desired class representation is part
- *                    of the cache
+ *   repr_nocache(out): the representation read from record when it cannot be cached
  *
- * Note: Obtain the desired class representation for the given class.
+ * Note: The class record is read without holding the cache mutex. If another thread cached the class meanwhile, its
+ *       entry is used instead.
  */
-OR_CLASSREP *
-heap_classrepr_get (THREAD_ENTRY * thread_p, const OID * class_oid, RECDES * class_recdes, REPR_ID reprid,
-		    int *idx_incache)
+static HEAP_CLASSREPR_ENTRY *
+heap_classrepr_entry_load (THREAD_ENTRY * thread_p, const OID * class_oid, RECDES * class_recdes, REPR_ID reprid,
+			   OR_CLASSREP ** repr_nocache)
 {
-  HEAP_CLASSREPR_ENTRY *cache_entry;
-  HEAP_CLASSREPR_HASH *hash_anchor;
-  OR_CLASSREP *repr = NULL;
+  HEAP_CLASSREPR_ENTRY *cache_entry = NULL;
+  HEAP_CLASSREPR_HASH_ENTRY *hash_entry;
   OR_CLASSREP *repr_from_record = NULL;
   OR_CLASSREP *repr_last = NULL;
+  OR_CLASSREP **repr_array;
   REPR_ID last_reprid;
+  OID key;
   int r;
 
-  *idx_incache = -1;
-
-  hash_anchor = &heap_Classrepr->hash_table[REPR_HASH (class_oid)];
-
-  /* search entry with class_oid from hash chain */
-search_begin:
-  r = pthread_mutex_lock (&hash_anchor->hash_mutex);
+  *repr_nocache = NULL;
 
-  for (cache_entry = hash_anchor->hash_next; cache_entry != NULL; cache_entry = cache_entry->hash_next)
+  repr_from_record = heap_classrepr_get_from_record (thread_p, &last_reprid, class_oid, class_recdes, reprid);
+  if (repr_from_record == NULL)
+    {
+      ASSERT_ERROR ();
+      goto exit;
+    }
+  if (reprid == NULL_REPRID)
     {
-      if (OID_EQ (class_oid, &cache_entry->class_oid))
+      reprid = last_reprid;
+    }
+  if (reprid <= NULL_REPRID || reprid > last_reprid)
+    {
+      assert (false);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CT_UNKNOWN_REPRID, 1, reprid);
+      goto exit;
+    }
+  if (reprid != last_reprid)
+    {
+      repr_last = heap_classrepr_get_from_record (thread_p, &last_reprid, class_oid, class_recdes, last_reprid);
+      if (repr_last == NULL)
 	{
-	  r = pthread_mutex_trylock (&cache_entry->mutex);
-	  if (r == 0)
-	    {
-	      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	    }
-	  else
-	    {
-	      if (r != EBUSY)
-		{
-		  /* some error code */
-		  er_set_with_oserror (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CSS_PTHREAD_MUTEX_LOCK, 0);
-		  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-		  goto exit;
-		}
-	      /* if cache_entry lock is busy. release hash mutex lock and lock cache_entry lock unconditionally */
-	      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	      r = pthread_mutex_lock (&cache_entry->mutex);
-	    }
-	  /* check if cache_entry is used by others */
-	  if (!OID_EQ (class_oid, &cache_entry->class_oid))
-	    {
-	      pthread_mutex_unlock (&cache_entry->mutex);
-	      goto search_begin;
-	    }
-
-	  break;
+	  /* can we accept this case? it is loaded when requested. */
 	}
     }
 
-  if (cache_entry == NULL)
+  r = pthread_mutex_lock (&heap_Classrepr->mutex);
+
+  /* check if other thread has cached it meanwhile */
+  cache_entry = heap_classrepr_entry_fix (thread_p, class_oid);
+  if (cache_entry != NULL)
     {
-      if (repr_from_record == NULL)
-	{
-	  /* note: we need to read class record from heap page. however, latching a page and holding mutex is never a
-	   *       good idea, and it can generate ugly deadlocks. but in most cases, we won't have concurrency here,
-	   *       so let's try a conditional latch on page of class. if that doesn't work, release the hash mutex,
-	   *       read representation from heap and restart the process to ensure consistency. */
-	  VPID vpid_of_class;
-	  PAGE_PTR page_of_class = NULL;
-	  VPID_GET_FROM_OID (&vpid_of_class, class_oid);
-	  page_of_class = pgbuf_fix (thread_p, &vpid_of_class, OLD_PAGE, PGBUF_LATCH_READ, PGBUF_CONDITIONAL_LATCH);
-	  if (page_of_class == NULL)
-	    {
-	      /* we cannot hold mutex */
-	      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	    }
-	  else if (spage_get_record_type (page_of_class, class_oid->slotid) != REC_HOME)
-	    {
-	      /* things get too complicated when we need to do ordered fix. */
-	      pgbuf_unfix_and_init (thread_p, page_of_class);
-	      pthread_mutex_unlock (&hash_anchor->hash_mutex);
-	    }
-	  repr_from_record = heap_classrepr_get_from_record (thread_p, &last_reprid, class_oid, class_recdes, reprid);
-	  if (repr_from_record == NULL)
-	    {
-	      ASSERT_ERROR ();
+      pthread_mutex_unlock (&heap_Classrepr->mutex);
+      goto exit;
+    }
 
-	      if (page_of_class != NULL)
-		{
-		  pthread_mutex_unlock (&hash_anchor->hash_mutex);
-		  pgbuf_unfix_and_init (thread_p, page_of_class);
-		}
-	      goto exit;
-	    }
-	  if (reprid == NULL_REPRID)
-	    {
-	      reprid = last_reprid;
-	    }
-	  if (reprid != last_reprid && repr_last == NULL)
-	    {
-	      repr_last = heap_classrepr_get_from_record (thread_p, &last_reprid, class_oid, class_recdes, last_reprid);
-	      if (repr_last == NULL)
-		{
-		  /* can we accept this case? */
-		}
-	    }
-	  if (page_of_class == NULL)
-	    {
-	      /* hash mutex was released, we need to restart search. */
-	      goto search_begin;
-	    }
-	  else
-	    {
-	      pgbuf_unfix_and_init (thread_p, page_of_class);
-	      /* hash mutex was kept */
-	      /* fall through */
-	    }
-	}
-      assert (repr_from_record != NULL);
-      assert (last_reprid != NULL_REPRID);
+  /* Get free entry */
+  cache_entry = heap_classrepr_entry_alloc (thread_p);
+  if (cache_entry == NULL)
+    {
+      /* if all cache entry is busy, return disk repr. */
+      pthread_mutex_unlock (&heap_Classrepr->mutex);
 
-#ifdef SERVER_MODE
-      /* class_oid was not found. Lock class_oid. heap_classrepr_lock_class () release hash_anchor->hash_lock */
-      r = heap_classrepr_lock_class (thread_p, hash_anchor, class_oid);
-      if (r != LOCK_ACQUIRED)
-	{
-	  if (r == NEED_TO_RETRY)
-	    {
-	      goto search_begin;
-	    }
-	  else
-	    {
-	      assert (r == ER_FAILED);
-	      goto exit;
-	    }
-	}
-#endif
+      *repr_nocache = repr_from_record;
+      repr_from_record = NULL;
+      goto exit;
+    }
 
-      /* Get free entry */
-      cache_entry = heap_classrepr_entry_alloc ();
-      if (cache_entry == NULL)
+  /* check if cache_entry->repr[last_reprid] is valid. */
+  if (last_reprid >= cache_entry->max_reprid)
+    {
+      repr_array = (OR_CLASSREP **) malloc ((last_reprid + 1) * sizeof (OR_CLASSREP *));
+      if (repr_array == NULL)
 	{
-	  /* if all cache entry is busy, return disk repr. */
-
-#ifdef SERVER_MODE
-	  /* free lock for class_oid */
-	  (void) heap_classrepr_unlock_class (hash_anchor, class_oid, true);
-#endif
-
-	  if (repr_last != NULL)
-	    {
-	      or_free_classrep (repr_last);
-	    }
+	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+		  (last_reprid + 1) * sizeof (OR_CLASSREP *));
 
-	  /* return disk repr when repr cache is full */
-	  return repr_from_record;
+	  (void) heap_classrepr_entry_free (cache_entry);
+	  pthread_mutex_unlock (&heap_Classrepr->mutex);
+	  cache_entry = NULL;
+	  goto exit;
 	}
+      free_and_init (cache_entry->repr);
+      cache_entry->repr = repr_array;
+      cache_entry->max_reprid = last_reprid + 1;
 
-      /* check if cache_entry->repr[last_reprid] is valid. */
-      if (last_reprid >= cache_entry->max_reprid)
-	{
-	  free_and_init (cache_entry->repr);
-
-	  cache_entry->repr = (OR_CLASSREP **) malloc ((last_reprid + 1) * sizeof (OR_CLASSREP *));
-	  if (cache_entry->repr == NULL)
-	    {
-	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
-		      (last_reprid + 1) * sizeof (OR_CLASSREP *));
+      memset (cache_entry->repr, 0, cache_entry->max_reprid * sizeof (OR_CLASSREP *));
+    }
 
-	      pthread_mutex_unlock (&cache_entry->mutex);
-	      (void) heap_classrepr_entry_free (cache_entry);
-#ifdef SERVER_MODE
-	      (void) heap_classrepr_unlock_class (hash_anchor, class_oid, true);
-#endif
-	      if (repr != NULL)
-		{
-		  or_free_classrep (repr);
-		  repr = NULL;
-		}
-	      goto exit;
-	    }
-	  cache_entry->max_reprid = last_reprid + 1;
+  cache_entry->repr[reprid] = repr_from_record;
+  repr_from_record = NULL;
+  if (reprid != last_reprid)
+    {
+      /* if last repr is not cached */
+      cache_entry->repr[last_reprid] = repr_last;
+      repr_last = NULL;
+    }
+  cache_entry->last_reprid = last_reprid;
+  cache_entry->class_oid = *class_oid;
+  cache_entry->referenced = true;
+  cache_entry->zone = ZONE_CACHED;
 
-	  memset (cache_entry->repr, 0, cache_entry->max_reprid * sizeof (OR_CLASSREP *));
-	}
+  /* entry is ready, publish it fixed by us */
+  MEMORY_BARRIER ();
+  (void) ATOMIC_TAS_32 (&cache_entry->fix_state, 1);
 
-      if (reprid <= NULL_REPRID || reprid > last_reprid || reprid > cache_entry->max_reprid)
+  /* Add to hash */
+  hash_entry = heap_Classrepr_hashmap.freelist_claim (thread_p);
+  if (hash_entry == NULL)
+    {
+      /* nobody else can find it; it is freed on unfix */
+      (void) ATOMIC_TAS_32 (&cache_entry->fix_state, HEAP_CLASSREPR_ENTRY_DECACHED | 1);
+      cache_entry->zone = ZONE_VOID;
+    }
+  else
+    {
+      key = *class_oid;
+      hash_entry->class_oid = key;
+      hash_entry->entry_idx = cache_entry->idx;
+      if (!heap_Classrepr_hashmap.insert_given (thread_p, key, hash_entry))
 	{
+	  /* cannot happen; hash is changed only while holding the mutex */
 	  assert (false);
+	}
+      heap_Classrepr_hashmap.end_tran (thread_p);
+    }
 
-	  pthread_mutex_unlock (&cache_entry->mutex);
-	  (void) heap_classrepr_entry_free (cache_entry);
-#ifdef SERVER_MODE
-	  (void) heap_classrepr_unlock_class (hash_anchor, class_oid, true);
-#endif
+  pthread_mutex_unlock (&heap_Classrepr->mutex);
 
-	  if (repr != NULL)
-	    {
-	      or_free_classrep (repr);
-	      repr = NULL;
-	    }
+  heap_classrepr_log_stack ("heap_classrepr_get %d|%d|%d add repr %p to cache_entry %p", OID_AS_ARGS (class_oid),
+			    cache_entry->repr[reprid], cache_entry);
 
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CT_UNKNOWN_REPRID, 1, reprid);
-	  goto exit;
-	}
+exit:
+  if (repr_from_record != NULL)
+    {
+      or_free_classrep (repr_from_record);
+    }
+  if (repr_last != NULL)
+    {
+      or_free_classrep (repr_last);
+    }
+  return cache_entry;
+}
 
-      cache_entry->repr[reprid] = repr_from_record;
-      repr = cache_entry->repr[reprid];
-      repr_from_record = NULL;
-      cache_entry->last_reprid = last_reprid;
-      if (reprid != last_reprid)
-	{			/* if last repr is not cached */
-	  /* normally, we should not access heap record while keeping mutex in cache entry. however, this entry was not
-	   * yet attached to cache, so no one will get its mutex yet */
-	  cache_entry->repr[last_reprid] = repr_last;
-	  repr_last = NULL;
-	}
+/*
+ * heap_classrepr_get () - Obtain the desired class representation
+ *   return: classrepr
+ *   class_oid(in): The class identifier
+ *   class_recdes(in): The class recdes (when know) or NULL
+ *   reprid(in): Representation of the class or NULL_REPRID for last one
+ *   idx_incache(in): An index if the desired class representation is part
+ *                    of the cache
+ *
+ * Note: Obtain the desired class representation for the given class.
+ *
+ * Note: Cached representations are found and fixed without any mutex. Representations are never changed while they
+ *       are cached; when the class is updated its entry is decached and representations are read again.
+ */
+OR_CLASSREP *
+heap_classrepr_get (THREAD_ENTRY * thread_p, const OID * class_oid, RECDES * class_recdes, REPR_ID reprid,
+		    int *idx_incache)
+{
+  HEAP_CLASSREPR_ENTRY *cache_entry;
+  OR_CLASSREP *repr = NULL;
+  OR_CLASSREP *repr_from_record = NULL;
 
-      cache_entry->fcnt = 1;
-      cache_entry->class_oid = *class_oid;
-#ifdef DEBUG_CLASSREPR_CACHE
-      r = pthread_mutex_lock (&heap_Classrepr->num_fix_entries_mutex);
-      heap_Classrepr->num_fix_entries++;
-      pthread_mutex_unlock (&heap_Classrepr->num_fix_entries_mutex);
+  *idx_incache = -1;
 
-#endif /* DEBUG_CLASSREPR_CACHE */
-      *idx_incache = cache_entry->idx;
+  cache_entry = heap_classrepr_entry_fix (thread_p, class_oid);
+  if (cache_entry == NULL)
+    {
+      cache_entry = heap_classrepr_entry_load (thread_p, class_oid, class_recdes, reprid, &repr);
+      if (cache_entry == NULL)
+	{
+	  /* repr is not cached or NULL on error */
+	  return repr;
+	}
+    }
 
-      /* Add to hash chain, and remove lock for class_oid */
-      r = pthread_mutex_lock (&hash_anchor->hash_mutex);
-      cache_entry->hash_next = hash_anchor->hash_next;
-      hash_anchor->hash_next = cache_entry;
+  /* now, we have cache_entry for class_oid. if it contains repr info for reprid, return it. else load classrepr
+   * info for it */
+  if (reprid == NULL_REPRID)
+    {
+      reprid = cache_entry->last_reprid;
+    }
 
-#ifdef SERVER_MODE
-      (void) heap_classrepr_unlock_class (hash_anchor, class_oid, false);
-#endif
+  if (reprid <= NULL_REPRID || reprid > cache_entry->last_reprid || reprid >= cache_entry->max_reprid)
+    {
+      assert (false);
+
+      (void) heap_classrepr_entry_unfix (cache_entry);
 
-      heap_classrepr_log_stack ("heap_classrepr_get %d|%d|%d add repr %p to cache_entry %p", OID_AS_ARGS (class_oid),
-				repr, cache_entry);
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CT_UNKNOWN_REPRID, 1, reprid);
+      return NULL;
     }
-  else
-    {
-      /* now, we have already cache_entry for class_oid. if it contains repr info for reprid, return it. else load
-       * classrepr info for it */
-      assert (!cache_entry->force_decache);
 
-      if (reprid == NULL_REPRID)
+  /* reprid cannot be greater than cache_entry->last_reprid. */
+  repr = cache_entry->repr[reprid];
+  if (repr == NULL)
+    {
+      /* load repr. info. for reprid of class_oid; other threads may load it concurrently, first one is kept */
+      repr_from_record = heap_classrepr_get_from_record (thread_p, NULL, class_oid, class_recdes, reprid);
+      if (repr_from_record == NULL)
 	{
-	  reprid = cache_entry->last_reprid;
+	  (void) heap_classrepr_entry_unfix (cache_entry);
+	  return NULL;
 	}
 
-      if (reprid <= NULL_REPRID || reprid > cache_entry->last_reprid || reprid > cache_entry->max_reprid)
+      if (ATOMIC_CAS_ADDR (&cache_entry->repr[reprid], (OR_CLASSREP *) NULL, repr_from_record))
 	{
-	  assert (false);
-
-	  pthread_mutex_unlock (&cache_entry->mutex);
-
-	  er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_CT_UNKNOWN_REPRID, 1, reprid);
-	  goto exit;
+	  repr = repr_from_record;
 	}
-
-      /* reprid cannot be greater than cache_entry->last_reprid. */
-      repr = cache_entry->repr[reprid];
-      if (repr == NULL)
+      else
 	{
-	  /* load repr. info. for reprid of class_oid */
-	  if (repr_from_record == NULL)
-	    {
-	      /* we need to read record from its page. we cannot hold cache mutex and latch a page. */
-	      pthread_mutex_unlock (&cache_entry->mutex);
-	      repr_from_record =
-		heap_classrepr_get_from_record (thread_p, &last_reprid, class_oid, class_recdes, reprid);
-	      if (repr_from_record == NULL)
-		{
-		  goto exit;
-		}
-	      /* we need to start over */
-	      goto search_begin;
-	    }
-	  else
-	    {
-	      /* use load representation from record */
-	      cache_entry->repr[reprid] = repr_from_record;
-	      repr = repr_from_record;
-	      repr_from_record = NULL;
-
-	      /* fall through */
-	    }
+	  or_free_classrep (repr_from_record);
+	  repr = cache_entry->repr[reprid];
 	}
-
-      cache_entry->fcnt++;
-      *idx_incache = cache_entry->idx;
     }
-  pthread_mutex_unlock (&cache_entry->mutex);
 
-exit:
-  if (repr_from_record != NULL)
-    {
-      or_free_classrep (repr_from_record);
-    }
-  if (repr_last != NULL)
-    {
-      or_free_classrep (repr_last);
-    }
+  *idx_incache = cache_entry->idx;
   return repr;
 }
 
@@ -2625,7 +2269,6 @@ heap_classrepr_dump_cache (bool simple_dump)
   OR_CLASSREP *classrepr;
   HEAP_CLASSREPR_ENTRY *cache_entry;
   int i, j;
-  int rv;
   int ret = NO_ERROR;
 
   if (heap_Classrepr == NULL)
@@ -2638,13 +2281,12 @@ heap_classrepr_dump_cache (bool simple_dump)
 
   fprintf (stdout, "*** Class Representation cache dump *** \n");
   fprintf (stdout, " Number of entries = %d, Number of used entries = %d\n", heap_Classrepr->num_entries,
-	   heap_Classrepr->num_entries - heap_Classrepr->free_list.free_cnt);
+	   heap_Classrepr->num_entries - heap_Classrepr->free_cnt);
 
   for (cache_entry = heap_Classrepr->area, i = 0; i < heap_Classrepr->num_entries; cache_entry++, i++)
     {
       fprintf (stdout, " \nEntry_id %d\n", cache_entry->idx);
 
-      rv = pthread_mutex_lock (&cache_entry->mutex);
       for (j = 0; j <= cache_entry->last_reprid; j++)
 	{
 	  classrepr = cache_entry->repr[j];
@@ -2653,8 +2295,9 @@ heap_classrepr_dump_cache (bool simple_dump)
 	      fprintf (stdout, ".....\n");
 	      continue;
 	    }
-	  fprintf (stdout, " Fix count = %d, force_decache = %s\n", cache_entry->fcnt,
-		   cache_entry->force_decache ? "true" : "false");
+	  fprintf (stdout, " Fix count = %d, decached = %s\n",
+		   cache_entry->fix_state & HEAP_CLASSREPR_ENTRY_FIX_COUNT_MASK,
+		   (cache_entry->fix_state & HEAP_CLASSREPR_ENTRY_DECACHED) ? "true" : "false");
 
 	  if (simple_dump == true)
 	    {
@@ -2668,8 +2311,6 @@ heap_classrepr_dump_cache (bool simple_dump)
 	      ret = heap_classrepr_dump (&cache_entry->class_oid, classrepr);
 	    }
 	}
-
-      pthread_mutex_unlock (&cache_entry->mutex);
     }
 
   return ret;
@@ -2879,12 +2520,17 @@ exit_on_error:
 int
 heap_classrepr_dump_anyfixed (void)
 {
+  int i;
   int ret = NO_ERROR;
 
-  if (heap_Classrepr->num_fix_entries > 0)
+  for (i = 0; i < heap_Classrepr->num_entries; i++)
     {
-      er_log_debug (ARG_FILE_LINE, "heap_classrepr_dump_anyfixed: Some entries are fixed\n");
-      ret = heap_classrepr_dump_cache (true);
+      if ((heap_Classrepr->area[i].fix_state & HEAP_CLASSREPR_ENTRY_FIX_COUNT_MASK) > 0)
+	{
+	  er_log_debug (ARG_FILE_LINE, "heap_classrepr_dump_anyfixed: Some entries are fixed\n");
+	  ret = heap_classrepr_dump_cache (true);
+	  break;
+	}
     }
 
   return ret;
@@ -5230,6 +4876,8 @@ heap_manager_finalize (void)
 
   heap_finalize_hfid_table ();
 
+  heap_zone_map_final ();
+
   return ret;
 }
 
@@ -5363,6 +5011,7 @@ heap_create_internal (THREAD_ENTRY * thread_p, HFID * hfid, const OID * class_oi
     }
 
   (void) heap_stats_del_bestspace_by_hfid (thread_p, hfid);
+  heap_zone_map_drop (&hfid->vfid);
 
   pgbuf_set_page_ptype (thread_p, addr_hdr.pgptr, PAGE_HEAP);
 
@@ -5888,6 +5537,7 @@ xheap_destroy (THREAD_ENTRY * thread_p, const HFID * hfid, const OID * class_oid
   file_postpone_destroy (thread_p, &hfid->vfid);
 
   (void) heap_stats_del_bestspace_by_hfid (thread_p, hfid);
+  heap_zone_map_drop (&hfid->vfid);
 
   return NO_ERROR;
 }
@@ -5932,6 +5582,7 @@ xheap_destroy_newly_created (THREAD_ENTRY * thread_p, const HFID * hfid, const O
   log_append_postpone (thread_p, RVHF_MARK_DELETED, &addr, sizeof (hfid->vfid), &hfid->vfid);
 
   (void) heap_stats_del_bestspace_by_hfid (thread_p, hfid);
+  heap_zone_map_drop (&hfid->vfid);
 
   return ret;
 }
@@ -6890,6 +6541,8 @@ heap_scancache_start_internal (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_ca
   scan_cache->debug_initpattern = HEAP_DEBUG_SCANCACHE_INITPATTERN;
   scan_cache->mvcc_snapshot = mvcc_snapshot;
   scan_cache->partition_list = NULL;
+  scan_cache->ovf_attr_infos[0] = NULL;
+  scan_cache->ovf_attr_infos[1] = NULL;
 
   return ret;
 
@@ -6908,6 +6561,8 @@ exit_on_error:
   scan_cache->debug_initpattern = 0;
   scan_cache->mvcc_snapshot = NULL;
   scan_cache->partition_list = NULL;
+  scan_cache->ovf_attr_infos[0] = NULL;
+  scan_cache->ovf_attr_infos[1] = NULL;
 
   return (ret == NO_ERROR && (ret = er_errid ()) == NO_ERROR) ? ER_FAILED : ret;
 }
@@ -7189,6 +6844,8 @@ heap_scancache_quick_start_internal (HEAP_SCANCACHE * scan_cache, const HFID * h
   scan_cache->debug_initpattern = HEAP_DEBUG_SCANCACHE_INITPATTERN;
   scan_cache->mvcc_snapshot = NULL;
   scan_cache->partition_list = NULL;
+  scan_cache->ovf_attr_infos[0] = NULL;
+  scan_cache->ovf_attr_infos[1] = NULL;
 
   return NO_ERROR;
 }
@@ -7334,6 +6991,26 @@ heap_scancache_end_modify (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache)
     }
 }
 
+/*
+ * heap_scancache_set_ovf_attrinfos () - Give the attributes read from the records of the scan
+ *   return:
+ *   scan_cache(in/out): Scan cache
+ *   pred_attr_info(in): Attributes of the scan predicate or NULL
+ *   rest_attr_info(in): Rest of the attributes of the scan or NULL
+ *
+ * Note: Once set, big records are read only up to the end of the last given attribute (see heap_get_bigone_prefix).
+ *       The caller must not use the records for anything else than reading these attributes.
+ */
+void
+heap_scancache_set_ovf_attrinfos (HEAP_SCANCACHE * scan_cache, HEAP_CACHE_ATTRINFO * pred_attr_info,
+				  HEAP_CACHE_ATTRINFO * rest_attr_info)
+{
+  assert (scan_cache != NULL && scan_cache->debug_initpattern == HEAP_DEBUG_SCANCACHE_INITPATTERN);
+
+  scan_cache->ovf_attr_infos[0] = pred_attr_info;
+  scan_cache->ovf_attr_infos[1] = rest_attr_info;
+}
+
 #if defined (ENABLE_UNUSED_FUNCTION)
 /*
  * heap_get_if_diff_chn () - Get specified object of the given slotted page when
@@ -10121,6 +9798,100 @@ heap_attrinfo_clear_dbvalues (HEAP_CACHE_ATTRINFO * attr_info)
   return ret;
 }
 
+/*
+ * heap_attrinfo_get_needed_length () - Find the length of the record prefix holding all attributes of attr_info
+ *   return: prefix length or -1 if the whole record is needed
+ *   recdes(in): Instance record descriptor, may be only a prefix of the record
+ *   attr_info(in): The attribute information structure
+ *
+ * Note: The prefix always includes the header, the variable offset table and the fixed attributes. Variable
+ *       attributes are located through the offset table; the end of one is the closest greater offset.
+ */
+static int
+heap_attrinfo_get_needed_length (const RECDES * recdes, const HEAP_CACHE_ATTRINFO * attr_info)
+{
+  OR_CLASSREP *classrepr;
+  OR_ATTRIBUTE *attrepr;
+  HEAP_ATTRVALUE *value;
+  REPR_ID reprid;
+  bool use_read_attrepr;
+  int needed_length;
+  int var_offset, var_end, offset;
+  int i, k;
+
+  if (attr_info == NULL || attr_info->num_values <= 0)
+    {
+      return 0;
+    }
+
+  if (recdes->length < OR_MVCC_MAX_HEADER_SIZE)
+    {
+      return -1;
+    }
+
+  /* the attributes must be described by the representation of the record */
+  reprid = or_rep_id ((RECDES *) recdes);
+  if (attr_info->read_classrepr != NULL && attr_info->read_classrepr->id == reprid)
+    {
+      classrepr = attr_info->read_classrepr;
+      use_read_attrepr = true;
+    }
+  else if (attr_info->last_classrepr != NULL && attr_info->last_classrepr->id == reprid)
+    {
+      classrepr = attr_info->last_classrepr;
+      use_read_attrepr = false;
+    }
+  else
+    {
+      return -1;
+    }
+
+  needed_length = (OR_HEADER_SIZE (recdes->data)
+		   + OR_VAR_TABLE_SIZE_INTERNAL (classrepr->n_variable, OR_GET_OFFSET_SIZE (recdes->data))
+		   + classrepr->fixed_length + OR_BOUND_BIT_BYTES (classrepr->n_attributes - classrepr->n_variable));
+  if (needed_length > recdes->length)
+    {
+      /* offset table is not in the prefix */
+      return -1;
+    }
+
+  for (i = 0; i < attr_info->num_values; i++)
+    {
+      value = &attr_info->values[i];
+      if (IS_DEDUPLICATE_KEY_ATTR_ID (value->attrid) || value->attr_type != HEAP_INSTANCE_ATTR)
+	{
+	  continue;
+	}
+
+      attrepr = use_read_attrepr ? value->read_attrepr : value->last_attrepr;
+      if (attrepr == NULL || attrepr->is_fixed != 0 || OR_VAR_IS_NULL (recdes->data, attrepr->location))
+	{
+	  /* default value, fixed attribute or null; already covered */
+	  continue;
+	}
+
+      /* variable values are not necessarily stored in the order of the offset table */
+      var_offset = OR_VAR_OFFSET (recdes->data, attrepr->location);
+      var_end = -1;
+      for (k = 0; k <= classrepr->n_variable; k++)
+	{
+	  offset = OR_VAR_OFFSET (recdes->data, k);
+	  if (offset > var_offset && (var_end == -1 || offset < var_end))
+	    {
+	      var_end = offset;
+	    }
+	}
+      if (var_end == -1)
+	{
+	  return -1;
+	}
+
+      needed_length = MAX (needed_length, var_end);
+    }
+
+  return needed_length;
+}
+
 /*
  * heap_attrvalue_read () - Read attribute information of given attribute cache
  *                        and instance
@@ -15976,107 +15747,296 @@ heap_mvcc_log_insert (THREAD_ENTRY * thread_p, RECDES * p_recdes, LOG_DATA_ADDR
   redo_crumbs[n_redo_crumbs].length = p_recdes->length - data_copy_offset;
   redo_crumbs[n_redo_crumbs++].data = p_recdes->data + data_copy_offset;
 
-  /* Safe guard */
-  assert (n_redo_crumbs <= HEAP_LOG_MVCC_INSERT_MAX_REDO_CRUMBS);
+  /* Safe guard */
+  assert (n_redo_crumbs <= HEAP_LOG_MVCC_INSERT_MAX_REDO_CRUMBS);
+
+  /* Append redo crumbs; undo crumbs not necessary as the spage_delete physical operation uses the offset field of the
+   * address */
+  if (thread_p->no_logging)
+    {
+      log_append_undo_crumbs (thread_p, RVHF_MVCC_INSERT, p_addr, 0, NULL);
+    }
+  else
+    {
+      log_append_undoredo_crumbs (thread_p, RVHF_MVCC_INSERT, p_addr, 0, n_redo_crumbs, NULL, redo_crumbs);
+    }
+}
+
+/*
+ * heap_rv_mvcc_redo_insert () - Redo the MVCC insertion of an object
+ *   return: int
+ *   rcv(in): Recovery structure
+ *
+ * Note: MVCC redo the insertion of an object at a specific location (OID).
+ */
+int
+heap_rv_mvcc_redo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv)
+{
+  INT16 slotid;
+  RECDES recdes;
+  int chn, sp_success;
+  MVCC_REC_HEADER mvcc_rec_header;
+  INT16 record_type;
+  bool vacuum_status_change = false;
+
+  assert (rcv->pgptr != NULL);
+  assert (MVCCID_IS_NORMAL (rcv->mvcc_id));
+
+  slotid = rcv->offset;
+  if (slotid & HEAP_RV_FLAG_VACUUM_STATUS_CHANGE)
+    {
+      vacuum_status_change = true;
+    }
+  slotid = slotid & (~HEAP_RV_FLAG_VACUUM_STATUS_CHANGE);
+  assert (slotid > 0);
+
+  record_type = *(INT16 *) rcv->data;
+  if (record_type == REC_BIGONE)
+    {
+      /* no data header */
+      HEAP_SET_RECORD (&recdes, rcv->length - sizeof (record_type), rcv->length - sizeof (record_type), REC_BIGONE,
+		       rcv->data + sizeof (record_type));
+    }
+  else
+    {
+      char data_buffer[IO_DEFAULT_PAGE_SIZE + OR_MVCC_MAX_HEADER_SIZE + MAX_ALIGNMENT];
+      int repid_and_flags, offset, mvcc_flag, offset_size;
+
+      offset = sizeof (record_type);
+
+      repid_and_flags = OR_GET_INT (rcv->data + offset);
+      offset += OR_INT_SIZE;
+
+      chn = OR_GET_INT (rcv->data + offset);
+      offset += OR_INT_SIZE;
+
+      mvcc_flag = (char) ((repid_and_flags >> OR_MVCC_FLAG_SHIFT_BITS) & OR_MVCC_FLAG_MASK);
+
+      assert (!(mvcc_flag & OR_MVCC_FLAG_VALID_DELID));
+
+      if ((repid_and_flags & OR_OFFSET_SIZE_FLAG) == OR_OFFSET_SIZE_1BYTE)
+	{
+	  offset_size = OR_BYTE_SIZE;
+	}
+      else if ((repid_and_flags & OR_OFFSET_SIZE_FLAG) == OR_OFFSET_SIZE_2BYTE)
+	{
+	  offset_size = OR_SHORT_SIZE;
+	}
+      else
+	{
+	  offset_size = OR_INT_SIZE;
+	}
+
+      MVCC_SET_REPID (&mvcc_rec_header, repid_and_flags & OR_MVCC_REPID_MASK);
+      MVCC_SET_FLAG (&mvcc_rec_header, mvcc_flag);
+      MVCC_SET_INSID (&mvcc_rec_header, rcv->mvcc_id);
+      MVCC_SET_CHN (&mvcc_rec_header, chn);
+
+      HEAP_SET_RECORD (&recdes, IO_DEFAULT_PAGE_SIZE + OR_MVCC_MAX_HEADER_SIZE, 0, record_type,
+		       PTR_ALIGN (data_buffer, MAX_ALIGNMENT));
+      or_mvcc_add_header (&recdes, &mvcc_rec_header, repid_and_flags & OR_BOUND_BIT_FLAG, offset_size);
+
+      memcpy (recdes.data + recdes.length, rcv->data + offset, rcv->length - offset);
+      recdes.length += (rcv->length - offset);
+    }
+
+  sp_success = spage_insert_for_recovery (thread_p, rcv->pgptr, slotid, &recdes);
+
+  if (sp_success != SP_SUCCESS)
+    {
+      /* Unable to redo insertion */
+      assert_release (false);
+      return ER_FAILED;
+    }
+
+  heap_page_rv_chain_update (thread_p, rcv->pgptr, rcv->mvcc_id, vacuum_status_change);
+  pgbuf_set_dirty (thread_p, rcv->pgptr, DONT_FREE);
+
+  return NO_ERROR;
+}
+
+/*
+ * heap_rv_undo_insert () - Undo the insertion of an object.
+ *   return: int
+ *   rcv(in): Recovery structure
+ *
+ * Note: Delete an object for recovery purposes. The OID of the object
+ * is reused since the object was never committed.
+ */
+int
+heap_rv_undo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv)
+{
+  INT16 slotid;
+  int free_space = 0;
+
+  if (LOG_ISRESTARTED ())
+    {
+      free_space = spage_get_free_space_without_saving (thread_p, rcv->pgptr, NULL);
+    }
+
+  slotid = rcv->offset;
+  /* Clear HEAP_RV_FLAG_VACUUM_STATUS_CHANGE */
+  slotid = slotid & (~HEAP_RV_FLAG_VACUUM_STATUS_CHANGE);
+  (void) spage_delete_for_recovery (thread_p, rcv->pgptr, slotid);
+  pgbuf_set_dirty (thread_p, rcv->pgptr, DONT_FREE);
+
+  if (LOG_ISRESTARTED ())
+    {
+      heap_rv_update_stats_after_undo_insert (thread_p, rcv->pgptr, free_space);
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * heap_rv_update_stats_after_undo_insert () - Update best space statistics of heap file after inserted objects were
+ *					       removed from a page by rollback.
+ *
+ * return	   : Void.
+ * thread_p (in)   : Thread entry.
+ * page (in)	   : Heap page.
+ * free_space (in) : Free space of page before removing the objects.
+ */
+static void
+heap_rv_update_stats_after_undo_insert (THREAD_ENTRY * thread_p, PAGE_PTR page, int free_space)
+{
+  HFID hfid = HFID_INITIALIZER;
+  OID class_oid = OID_INITIALIZER;
+
+  if (heap_get_class_oid_from_page (thread_p, page, &class_oid) != NO_ERROR)
+    {
+      return;
+    }
+
+  if (heap_get_class_info (thread_p, &class_oid, &hfid, NULL, NULL) != NO_ERROR)
+    {
+      return;
+    }
+  assert (!HFID_IS_NULL (&hfid));
+#if defined(CUBRID_DEBUG)
+  assert (heap_hfid_isvalid (&hfid) == DISK_VALID);
+#endif
+
+  heap_stats_update (thread_p, page, &hfid, free_space);
+}
+
+/*
+ * heap_mvcc_log_insert_multi () - Log MVCC insert of several objects in the same heap page.
+ *
+ * return	    : Void.
+ * thread_p (in)    : Thread entry.
+ * recdes_array (in): Newly inserted records.
+ * slotids (in)	    : Slots of inserted records.
+ * n_records (in)   : Number of inserted records.
+ * p_addr (in)	    : Log address data. Offset is set to the slot of first record.
+ *
+ * NOTE: Redo data is the number of records, followed by an HEAP_INSERT_MULTI_REDO_ENTRY for each record, followed by
+ *	 the data of all records. The records are logged with their full MVCC header, the insert MVCCID is the same for
+ *	 all of them.
+ *	 Undo data is the array of slot ids. Besides rollback, it is used by vacuum to collect the inserted objects.
+ */
+static void
+heap_mvcc_log_insert_multi (THREAD_ENTRY * thread_p, RECDES * recdes_array, PGSLOTID * slotids, int n_records,
+			    LOG_DATA_ADDR * p_addr)
+{
+  HEAP_INSERT_MULTI_REDO_ENTRY redo_entries[HEAP_INSERT_BATCH_MAX_RECORDS];
+  LOG_CRUMB redo_crumbs[HEAP_INSERT_BATCH_MAX_RECORDS + 2];
+  LOG_CRUMB undo_crumb;
+  INT32 count = n_records;
+  HEAP_PAGE_VACUUM_STATUS vacuum_status;
+  int n_redo_crumbs = 0;
+  int i;
+
+  assert (recdes_array != NULL && slotids != NULL);
+  assert (n_records > 0 && n_records <= HEAP_INSERT_BATCH_MAX_RECORDS);
+  assert (p_addr != NULL);
+
+  p_addr->offset = slotids[0];
+
+  vacuum_status = heap_page_get_vacuum_status (thread_p, p_addr->pgptr);
+
+  /* Update chain once for all records; vacuum will collect all of them from the same log record. */
+  heap_page_update_chain_after_mvcc_op (thread_p, p_addr->pgptr, logtb_get_current_mvccid (thread_p));
+  if (vacuum_status != heap_page_get_vacuum_status (thread_p, p_addr->pgptr))
+    {
+      /* Mark status change for recovery. */
+      p_addr->offset |= HEAP_RV_FLAG_VACUUM_STATUS_CHANGE;
+    }
+
+  undo_crumb.length = n_records * sizeof (PGSLOTID);
+  undo_crumb.data = slotids;
+
+  if (thread_p->no_logging)
+    {
+      log_append_undo_crumbs (thread_p, RVHF_MVCC_INSERT_MULTI, p_addr, 1, &undo_crumb);
+      return;
+    }
+
+  redo_crumbs[n_redo_crumbs].length = sizeof (count);
+  redo_crumbs[n_redo_crumbs++].data = &count;
 
-  /* Append redo crumbs; undo crumbs not necessary as the spage_delete physical operation uses the offset field of the
-   * address */
-  if (thread_p->no_logging)
+  for (i = 0; i < n_records; i++)
     {
-      log_append_undo_crumbs (thread_p, RVHF_MVCC_INSERT, p_addr, 0, NULL);
+      assert (recdes_array[i].type == REC_HOME);
+
+      redo_entries[i].slotid = slotids[i];
+      redo_entries[i].type = recdes_array[i].type;
+      redo_entries[i].length = recdes_array[i].length;
     }
-  else
+  redo_crumbs[n_redo_crumbs].length = n_records * sizeof (HEAP_INSERT_MULTI_REDO_ENTRY);
+  redo_crumbs[n_redo_crumbs++].data = redo_entries;
+
+  for (i = 0; i < n_records; i++)
     {
-      log_append_undoredo_crumbs (thread_p, RVHF_MVCC_INSERT, p_addr, 0, n_redo_crumbs, NULL, redo_crumbs);
+      redo_crumbs[n_redo_crumbs].length = recdes_array[i].length;
+      redo_crumbs[n_redo_crumbs++].data = recdes_array[i].data;
     }
+
+  log_append_undoredo_crumbs (thread_p, RVHF_MVCC_INSERT_MULTI, p_addr, 1, n_redo_crumbs, &undo_crumb, redo_crumbs);
 }
 
 /*
- * heap_rv_mvcc_redo_insert () - Redo the MVCC insertion of an object
+ * heap_rv_mvcc_redo_insert_multi () - Redo the MVCC insertion of several objects in the same page.
  *   return: int
  *   rcv(in): Recovery structure
  *
- * Note: MVCC redo the insertion of an object at a specific location (OID).
+ * Note: See heap_mvcc_log_insert_multi for log data format.
  */
 int
-heap_rv_mvcc_redo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv)
+heap_rv_mvcc_redo_insert_multi (THREAD_ENTRY * thread_p, LOG_RCV * rcv)
 {
-  INT16 slotid;
+  HEAP_INSERT_MULTI_REDO_ENTRY *redo_entries;
   RECDES recdes;
-  int chn, sp_success;
-  MVCC_REC_HEADER mvcc_rec_header;
-  INT16 record_type;
-  bool vacuum_status_change = false;
+  const char *data_p;
+  INT32 count;
+  int i;
+  bool vacuum_status_change;
 
   assert (rcv->pgptr != NULL);
   assert (MVCCID_IS_NORMAL (rcv->mvcc_id));
 
-  slotid = rcv->offset;
-  if (slotid & HEAP_RV_FLAG_VACUUM_STATUS_CHANGE)
-    {
-      vacuum_status_change = true;
-    }
-  slotid = slotid & (~HEAP_RV_FLAG_VACUUM_STATUS_CHANGE);
-  assert (slotid > 0);
-
-  record_type = *(INT16 *) rcv->data;
-  if (record_type == REC_BIGONE)
-    {
-      /* no data header */
-      HEAP_SET_RECORD (&recdes, rcv->length - sizeof (record_type), rcv->length - sizeof (record_type), REC_BIGONE,
-		       rcv->data + sizeof (record_type));
-    }
-  else
-    {
-      char data_buffer[IO_DEFAULT_PAGE_SIZE + OR_MVCC_MAX_HEADER_SIZE + MAX_ALIGNMENT];
-      int repid_and_flags, offset, mvcc_flag, offset_size;
-
-      offset = sizeof (record_type);
-
-      repid_and_flags = OR_GET_INT (rcv->data + offset);
-      offset += OR_INT_SIZE;
+  vacuum_status_change = (rcv->offset & HEAP_RV_FLAG_VACUUM_STATUS_CHANGE) != 0;
 
-      chn = OR_GET_INT (rcv->data + offset);
-      offset += OR_INT_SIZE;
+  count = *(INT32 *) rcv->data;
+  assert (count > 0 && count <= HEAP_INSERT_BATCH_MAX_RECORDS);
 
-      mvcc_flag = (char) ((repid_and_flags >> OR_MVCC_FLAG_SHIFT_BITS) & OR_MVCC_FLAG_MASK);
+  redo_entries = (HEAP_INSERT_MULTI_REDO_ENTRY *) (rcv->data + sizeof (count));
+  data_p = (const char *) (redo_entries + count);
 
-      assert (!(mvcc_flag & OR_MVCC_FLAG_VALID_DELID));
+  for (i = 0; i < count; i++)
+    {
+      HEAP_SET_RECORD (&recdes, redo_entries[i].length, redo_entries[i].length, redo_entries[i].type,
+		       (char *) data_p);
 
-      if ((repid_and_flags & OR_OFFSET_SIZE_FLAG) == OR_OFFSET_SIZE_1BYTE)
-	{
-	  offset_size = OR_BYTE_SIZE;
-	}
-      else if ((repid_and_flags & OR_OFFSET_SIZE_FLAG) == OR_OFFSET_SIZE_2BYTE)
-	{
-	  offset_size = OR_SHORT_SIZE;
-	}
-      else
+      if (spage_insert_for_recovery (thread_p, rcv->pgptr, redo_entries[i].slotid, &recdes) != SP_SUCCESS)
 	{
-	  offset_size = OR_INT_SIZE;
+	  /* Unable to redo insertion */
+	  assert_release (false);
+	  return ER_FAILED;
 	}
-
-      MVCC_SET_REPID (&mvcc_rec_header, repid_and_flags & OR_MVCC_REPID_MASK);
-      MVCC_SET_FLAG (&mvcc_rec_header, mvcc_flag);
-      MVCC_SET_INSID (&mvcc_rec_header, rcv->mvcc_id);
-      MVCC_SET_CHN (&mvcc_rec_header, chn);
-
-      HEAP_SET_RECORD (&recdes, IO_DEFAULT_PAGE_SIZE + OR_MVCC_MAX_HEADER_SIZE, 0, record_type,
-		       PTR_ALIGN (data_buffer, MAX_ALIGNMENT));
-      or_mvcc_add_header (&recdes, &mvcc_rec_header, repid_and_flags & OR_BOUND_BIT_FLAG, offset_size);
-
-      memcpy (recdes.data + recdes.length, rcv->data + offset, rcv->length - offset);
-      recdes.length += (rcv->length - offset);
-    }
-
-  sp_success = spage_insert_for_recovery (thread_p, rcv->pgptr, slotid, &recdes);
-
-  if (sp_success != SP_SUCCESS)
-    {
-      /* Unable to redo insertion */
-      assert_release (false);
-      return ER_FAILED;
+      data_p += redo_entries[i].length;
     }
+  assert (data_p == rcv->data + rcv->length);
 
   heap_page_rv_chain_update (thread_p, rcv->pgptr, rcv->mvcc_id, vacuum_status_change);
   pgbuf_set_dirty (thread_p, rcv->pgptr, DONT_FREE);
@@ -16085,54 +16045,39 @@ heap_rv_mvcc_redo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv)
 }
 
 /*
- * heap_rv_undo_insert () - Undo the insertion of an object.
+ * heap_rv_undo_insert_multi () - Undo the insertion of several objects in the same page.
  *   return: int
  *   rcv(in): Recovery structure
  *
- * Note: Delete an object for recovery purposes. The OID of the object
- * is reused since the object was never committed.
+ * Note: Undo data is the array of inserted slot ids.
  */
 int
-heap_rv_undo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv)
+heap_rv_undo_insert_multi (THREAD_ENTRY * thread_p, LOG_RCV * rcv)
 {
-  INT16 slotid;
+  const PGSLOTID *slotids = (const PGSLOTID *) rcv->data;
+  int n_slotids = rcv->length / (int) sizeof (PGSLOTID);
   int free_space = 0;
+  int i;
+
+  assert (n_slotids > 0);
 
   if (LOG_ISRESTARTED ())
     {
       free_space = spage_get_free_space_without_saving (thread_p, rcv->pgptr, NULL);
     }
 
-  slotid = rcv->offset;
-  /* Clear HEAP_RV_FLAG_VACUUM_STATUS_CHANGE */
-  slotid = slotid & (~HEAP_RV_FLAG_VACUUM_STATUS_CHANGE);
-  (void) spage_delete_for_recovery (thread_p, rcv->pgptr, slotid);
+  /* remove in reverse order of insertion */
+  for (i = n_slotids - 1; i >= 0; i--)
+    {
+      (void) spage_delete_for_recovery (thread_p, rcv->pgptr, slotids[i]);
+    }
   pgbuf_set_dirty (thread_p, rcv->pgptr, DONT_FREE);
 
   if (LOG_ISRESTARTED ())
     {
-      HFID hfid = HFID_INITIALIZER;
-      OID class_oid = OID_INITIALIZER;
-
-      if (heap_get_class_oid_from_page (thread_p, rcv->pgptr, &class_oid) != NO_ERROR)
-	{
-	  goto end;
-	}
-
-      if (heap_get_class_info (thread_p, &class_oid, &hfid, NULL, NULL) != NO_ERROR)
-	{
-	  goto end;
-	}
-      assert (!HFID_IS_NULL (&hfid));
-#if defined(CUBRID_DEBUG)
-      assert (heap_hfid_isvalid (&hfid) == DISK_VALID);
-#endif
-
-      heap_stats_update (thread_p, rcv->pgptr, &hfid, free_space);
+      heap_rv_update_stats_after_undo_insert (thread_p, rcv->pgptr, free_space);
     }
 
-end:
-
   return NO_ERROR;
 }
 
@@ -18978,75 +18923,215 @@ heap_get_record_info (THREAD_ENTRY * thread_p, const OID oid, RECDES * recdes, R
   return scan;
 }
 
-/*
- * heap_next () - Retrieve or peek next object
- *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
- *   hfid(in):
- *   class_oid(in):
- *   next_oid(in/out): Object identifier of current record.
- *                     Will be set to next available record or NULL_OID when
- *                     there is not one.
- *   recdes(in/out): Pointer to a record descriptor. Will be modified to
- *                   describe the new record.
- *   scan_cache(in/out): Scan cache or NULL
- *   ispeeking(in): PEEK when the object is peeked, scan_cache cannot be NULL
- *                  COPY when the object is copied
- *
- */
-SCAN_CODE
-heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid, RECDES * recdes,
-	   HEAP_SCANCACHE * scan_cache, int ispeeking)
-{
-  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes, scan_cache, ispeeking, false, NULL, NULL);
-}
+/*
+ * heap_next () - Retrieve or peek next object
+ *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
+ *   hfid(in):
+ *   class_oid(in):
+ *   next_oid(in/out): Object identifier of current record.
+ *                     Will be set to next available record or NULL_OID when
+ *                     there is not one.
+ *   recdes(in/out): Pointer to a record descriptor. Will be modified to
+ *                   describe the new record.
+ *   scan_cache(in/out): Scan cache or NULL
+ *   ispeeking(in): PEEK when the object is peeked, scan_cache cannot be NULL
+ *                  COPY when the object is copied
+ *
+ */
+SCAN_CODE
+heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid, RECDES * recdes,
+	   HEAP_SCANCACHE * scan_cache, int ispeeking)
+{
+  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes, scan_cache, ispeeking, false, NULL, NULL);
+}
+
+/*
+ * heap_next_sampling () - Retrieve or peek next object
+ *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
+ *   hfid(in):
+ *   class_oid(in):
+ *   next_oid(in/out): Object identifier of current record.
+ *                     Will be set to next available record or NULL_OID when
+ *                     there is not one.
+ *   recdes(in/out): Pointer to a record descriptor. Will be modified to
+ *                   describe the new record.
+ *   scan_cache(in/out): Scan cache or NULL
+ *   ispeeking(in): PEEK when the object is peeked, scan_cache cannot be NULL
+ *                  COPY when the object is copied
+ *
+ */
+SCAN_CODE
+heap_next_sampling (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid, RECDES * recdes,
+		    HEAP_SCANCACHE * scan_cache, int ispeeking, sampling_info * sampling)
+{
+  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes, scan_cache, ispeeking, false, NULL, sampling);
+}
+
+/*
+ * heap_next_record_info () - Retrieve or peek next object.
+ *
+ * return		     : SCAN_CODE.
+ * thread_p (in)	     : Thread entry.
+ * hfid (in)		     : Heap file identifier.
+ * class_oid (in)	     : Class Object identifier.
+ * next_oid (in/out)	     : Current object identifier. Will store the next
+ *			       scanned object identifier.
+ * recdes (in)		     : Record descriptor.
+ * scan_cache (in)	     : Scan cache.
+ * ispeeking (in)	     : PEEK/COPY.
+ * cache_recordinfo (in/out) : DB_VALUE pointer array that caches record
+ *			       information values.
+ *
+ * NOTE: This function is similar to heap next. The difference is that all
+ *	 slots are scanned in their order in the heap file and along with
+ *	 record data also information about that record is obtained.
+ */
+SCAN_CODE
+heap_next_record_info (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid, RECDES * recdes,
+		       HEAP_SCANCACHE * scan_cache, int ispeeking, DB_VALUE ** cache_recordinfo)
+{
+  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes, scan_cache, ispeeking, false,
+			     cache_recordinfo, NULL);
+}
+
+/*
+ * heap_page_next () - Retrieve or peek next object of a single heap page
+ *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
+ *   vpid(in): Heap page to scan
+ *   class_oid(in): Class object identifier
+ *   next_oid(in/out): Object identifier of current record. When it is NULL_OID or it belongs to another page, the
+ *                     scan starts with the first record of the page. Will be set to NULL_OID when there are no more
+ *                     objects in the page.
+ *   recdes(in/out): Pointer to a record descriptor. Will be modified to describe the new record.
+ *   scan_cache(in/out): Scan cache; the page is kept fixed in its watcher between calls.
+ *   ispeeking(in): PEEK when the object is peeked, COPY when the object is copied
+ *
+ * Note: Unlike heap_next, the page chain is never followed. It is used by scans that split the heap file by pages,
+ *       where pages are obtained from the file table (see file_get_user_page_vpids). A page that was deallocated or
+ *       that no longer belongs to the scanned class is treated as an empty page.
+ */
+SCAN_CODE
+heap_page_next (THREAD_ENTRY * thread_p, const VPID * vpid, OID * class_oid, OID * next_oid, RECDES * recdes,
+		HEAP_SCANCACHE * scan_cache, int ispeeking)
+{
+  OID oid;
+  RECDES forward_recdes;
+  RECDES chain_recdes;
+  INT16 type;
+  SCAN_CODE scan;
+  bool is_null_recdata;
+  int cache_last_fix_page_save;
+
+  assert (vpid != NULL && !VPID_ISNULL (vpid));
+  assert (scan_cache != NULL);
+
+  if (!OID_ISNULL (&scan_cache->node.class_oid))
+    {
+      class_oid = &scan_cache->node.class_oid;
+    }
+
+  if (OID_ISNULL (next_oid) || next_oid->volid != vpid->volid || next_oid->pageid != vpid->pageid)
+    {
+      oid.volid = vpid->volid;
+      oid.pageid = vpid->pageid;
+      oid.slotid = 0;		/* i.e., will get slot 1 */
+    }
+  else
+    {
+      oid = *next_oid;
+    }
+
+  if (scan_cache->page_watcher.pgptr != NULL && !VPID_EQ (pgbuf_get_vpid_ptr (scan_cache->page_watcher.pgptr), vpid))
+    {
+      pgbuf_ordered_unfix (thread_p, &scan_cache->page_watcher);
+    }
+
+  if (scan_cache->page_watcher.pgptr == NULL)
+    {
+      if (pgbuf_ordered_fix (thread_p, vpid, OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_READ,
+			     &scan_cache->page_watcher) != NO_ERROR)
+	{
+	  if (er_errid () == ER_PB_BAD_PAGEID)
+	    {
+	      /* page was deallocated */
+	      er_clear ();
+	      OID_SET_NULL (next_oid);
+	      return S_END;
+	    }
+	  ASSERT_ERROR ();
+	  return S_ERROR;
+	}
+
+      if (pgbuf_get_page_ptype (thread_p, scan_cache->page_watcher.pgptr) != PAGE_HEAP
+	  || spage_get_record (thread_p, scan_cache->page_watcher.pgptr, HEAP_HEADER_AND_CHAIN_SLOTID, &chain_recdes,
+			       PEEK) != S_SUCCESS
+	  || (class_oid != NULL && !OID_ISNULL (class_oid) && !OID_EQ ((OID *) chain_recdes.data, class_oid)))
+	{
+	  /* page was reused by another file or class; the scanned class has no objects here */
+	  pgbuf_ordered_unfix (thread_p, &scan_cache->page_watcher);
+	  OID_SET_NULL (next_oid);
+	  return S_END;
+	}
+    }
+
+  is_null_recdata = (recdes->data == NULL);
+
+  while (true)
+    {
+      /* Find the next object. Skip relocated records (i.e., new_home records). This records must be accessed
+       * through the relocation record (i.e., the object). */
+      scan = spage_next_record (scan_cache->page_watcher.pgptr, &oid.slotid, &forward_recdes, PEEK);
+      if (scan != S_SUCCESS)
+	{
+	  break;
+	}
+      if (oid.slotid == HEAP_HEADER_AND_CHAIN_SLOTID)
+	{
+	  /* skip the header */
+	  continue;
+	}
+      type = spage_get_record_type (scan_cache->page_watcher.pgptr, oid.slotid);
+      if (type == REC_NEWHOME || type == REC_ASSIGN_ADDRESS || type == REC_UNKNOWN)
+	{
+	  /* skip */
+	  continue;
+	}
+
+      cache_last_fix_page_save = scan_cache->cache_last_fix_page;
+      scan_cache->cache_last_fix_page = true;
+      scan =
+	heap_scan_get_visible_version (thread_p, &oid, class_oid, recdes, &forward_recdes, scan_cache, ispeeking,
+				       NULL_CHN);
+      scan_cache->cache_last_fix_page = cache_last_fix_page_save;
+
+      if (scan == S_SNAPSHOT_NOT_SATISFIED || scan == S_DOESNT_EXIST)
+	{
+	  /* the record does not satisfies snapshot or was deleted - continue */
+	  if (is_null_recdata)
+	    {
+	      /* reset recdes->data before getting next record */
+	      recdes->data = NULL;
+	    }
+	  continue;
+	}
+      break;
+    }
+
+  if (scan == S_SUCCESS)
+    {
+      *next_oid = oid;
+    }
+  else if (scan == S_END)
+    {
+      OID_SET_NULL (next_oid);
+    }
 
-/*
- * heap_next_sampling () - Retrieve or peek next object
- *   return: SCAN_CODE (Either of S_SUCCESS, S_DOESNT_FIT, S_END, S_ERROR)
- *   hfid(in):
- *   class_oid(in):
- *   next_oid(in/out): Object identifier of current record.
- *                     Will be set to next available record or NULL_OID when
- *                     there is not one.
- *   recdes(in/out): Pointer to a record descriptor. Will be modified to
- *                   describe the new record.
- *   scan_cache(in/out): Scan cache or NULL
- *   ispeeking(in): PEEK when the object is peeked, scan_cache cannot be NULL
- *                  COPY when the object is copied
- *
- */
-SCAN_CODE
-heap_next_sampling (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid, RECDES * recdes,
-		    HEAP_SCANCACHE * scan_cache, int ispeeking, sampling_info * sampling)
-{
-  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes, scan_cache, ispeeking, false, NULL, sampling);
-}
+  if (scan_cache->page_watcher.pgptr != NULL && (scan != S_SUCCESS || scan_cache->cache_last_fix_page == false))
+    {
+      pgbuf_ordered_unfix (thread_p, &scan_cache->page_watcher);
+    }
 
-/*
- * heap_next_record_info () - Retrieve or peek next object.
- *
- * return		     : SCAN_CODE.
- * thread_p (in)	     : Thread entry.
- * hfid (in)		     : Heap file identifier.
- * class_oid (in)	     : Class Object identifier.
- * next_oid (in/out)	     : Current object identifier. Will store the next
- *			       scanned object identifier.
- * recdes (in)		     : Record descriptor.
- * scan_cache (in)	     : Scan cache.
- * ispeeking (in)	     : PEEK/COPY.
- * cache_recordinfo (in/out) : DB_VALUE pointer array that caches record
- *			       information values.
- *
- * NOTE: This function is similar to heap next. The difference is that all
- *	 slots are scanned in their order in the heap file and along with
- *	 record data also information about that record is obtained.
- */
-SCAN_CODE
-heap_next_record_info (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid, RECDES * recdes,
-		       HEAP_SCANCACHE * scan_cache, int ispeeking, DB_VALUE ** cache_recordinfo)
-{
-  return heap_next_internal (thread_p, hfid, class_oid, next_oid, recdes, scan_cache, ispeeking, false,
-			     cache_recordinfo, NULL);
+  return scan;
 }
 
 /*
@@ -19186,6 +19271,12 @@ heap_get_bigone_content (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, b
   if (scan_cache != NULL
       && (ispeeking == PEEK || recdes->data == NULL || scan_cache->is_recdes_assigned_to_area (*recdes)))
     {
+      if (scan_cache->ovf_attr_infos[0] != NULL || scan_cache->ovf_attr_infos[1] != NULL)
+	{
+	  /* only some attributes are read from the record; don't copy what follows them */
+	  return heap_get_bigone_prefix (thread_p, scan_cache, forward_oid, recdes);
+	}
+
       scan_cache->assign_recdes_to_area (*recdes);
 
       while ((scan = heap_ovf_get (thread_p, forward_oid, recdes, NULL_CHN, NULL)) == S_DOESNT_FIT)
@@ -19209,6 +19300,73 @@ heap_get_bigone_content (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, b
   return scan;
 }
 
+/*
+ * heap_get_bigone_prefix () - get the prefix of a big record holding the attributes read by the scan
+ *
+ * return	    : scan code.
+ * thread_p (in)    :
+ * scan_cache (in)  : Scan cache with the attributes of the scan (see heap_scancache_set_ovf_attrinfos)
+ * forward_oid(in)  : content oid.
+ * recdes(out)      : record descriptor that will contain the prefix of the record
+ *
+ * Note: The data on the first overflow page is read first. It holds the header and the offset table of the record
+ *       and usually all fixed and small variable attributes, in which case nothing else is read. Otherwise, the
+ *       record is read up to the end of its last needed attribute. The large values that follow are never copied.
+ */
+static SCAN_CODE
+heap_get_bigone_prefix (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache, OID * forward_oid, RECDES * recdes)
+{
+  VPID ovf_vpid;
+  int remaining_length;
+  int needed_length, length;
+  int i;
+  SCAN_CODE scan;
+
+  ovf_vpid.volid = forward_oid->volid;
+  ovf_vpid.pageid = forward_oid->pageid;
+
+  scan_cache->assign_recdes_to_area (*recdes, OVERFLOW_FIRST_PART_DATA_SIZE);
+  scan = overflow_get_nbytes (thread_p, &ovf_vpid, recdes, 0, OVERFLOW_FIRST_PART_DATA_SIZE, &remaining_length, NULL);
+  if (scan != S_SUCCESS)
+    {
+      recdes->data = NULL;
+      return scan;
+    }
+
+  if (remaining_length == 0)
+    {
+      /* nothing else */
+      return S_SUCCESS;
+    }
+
+  needed_length = 0;
+  for (i = 0; i < HEAP_SCANCACHE_MAX_OVF_ATTRINFOS && needed_length >= 0; i++)
+    {
+      length = heap_attrinfo_get_needed_length (recdes, scan_cache->ovf_attr_infos[i]);
+      needed_length = (length < 0) ? -1 : MAX (needed_length, length);
+    }
+
+  if (needed_length >= 0 && needed_length <= recdes->length)
+    {
+      /* all attributes are on the first page */
+      return S_SUCCESS;
+    }
+
+  if (needed_length < 0)
+    {
+      needed_length = recdes->length + remaining_length;
+    }
+
+  scan_cache->assign_recdes_to_area (*recdes, needed_length);
+  scan = overflow_get_nbytes (thread_p, &ovf_vpid, recdes, 0, needed_length, &remaining_length, NULL);
+  if (scan != S_SUCCESS)
+    {
+      recdes->data = NULL;
+    }
+
+  return scan;
+}
+
 /*
  * heap_get_class_oid_from_page () - Gets heap page owner class OID.
  *
@@ -20095,6 +20253,47 @@ heap_build_forwarding_recdes (RECDES * recdes_p, INT16 rec_type, OID * forward_o
   recdes_p->area_size = sizeof (OID);
 }
 
+/*
+ * heap_insert_set_mvcc_insid () - set insert MVCCID in the header of a record to be inserted
+ *
+ * return	 : Void.
+ * recdes_p (in) : Record descriptor. The header must not have DELID or PREV_VERSION.
+ * mvcc_id (in)	 : Insert MVCCID.
+ *
+ * NOTE: If the header has no INSID yet, the record data is moved to make room for it, so the record area must have
+ *	 OR_MVCCID_SIZE spare bytes.
+ */
+static void
+heap_insert_set_mvcc_insid (RECDES * recdes_p, MVCCID mvcc_id)
+{
+  int repid_and_flag_bits, mvcc_flags;
+  char *start_p, *new_ins_mvccid_pos_p, *existing_data_p;
+
+  start_p = recdes_p->data;
+  repid_and_flag_bits = OR_GET_MVCC_REPID_AND_FLAG (start_p);
+  mvcc_flags = (repid_and_flag_bits >> OR_MVCC_FLAG_SHIFT_BITS) & OR_MVCC_FLAG_MASK;
+  assert (!(mvcc_flags & (OR_MVCC_FLAG_VALID_DELID | OR_MVCC_FLAG_VALID_PREV_VERSION)));
+
+  /* Skip bytes up to insid_offset */
+  new_ins_mvccid_pos_p = start_p + OR_MVCC_INSERT_ID_OFFSET;
+
+  if (!(mvcc_flags & OR_MVCC_FLAG_VALID_INSID))
+    {
+      /* Sets MVCC INSID flag, overwrite first four bytes. */
+      repid_and_flag_bits |= (OR_MVCC_FLAG_VALID_INSID << OR_MVCC_FLAG_SHIFT_BITS);
+      OR_PUT_INT (start_p, repid_and_flag_bits);
+
+      /* Move the record data before inserting INSID */
+      assert (recdes_p->area_size >= recdes_p->length + OR_MVCCID_SIZE);
+      existing_data_p = new_ins_mvccid_pos_p;
+      memmove (new_ins_mvccid_pos_p + OR_MVCCID_SIZE, existing_data_p, recdes_p->length - OR_MVCC_INSERT_ID_OFFSET);
+      recdes_p->length += OR_MVCCID_SIZE;
+    }
+
+  /* Sets the MVCC INSID */
+  OR_PUT_BIGINT (new_ins_mvccid_pos_p, &mvcc_id);
+}
+
 /*
  * heap_insert_adjust_recdes_header () - adjust record header for insert
  *                                       operation
@@ -20112,7 +20311,6 @@ heap_insert_adjust_recdes_header (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEX
   MVCC_REC_HEADER mvcc_rec_header;
   int record_size;
   int repid_and_flag_bits = 0, mvcc_flags = 0;
-  char *new_ins_mvccid_pos_p, *start_p, *existing_data_p;
   MVCCID mvcc_id;
   bool use_optimization = false;
 
@@ -20141,26 +20339,7 @@ heap_insert_adjust_recdes_header (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEX
       assert (!(mvcc_flags & OR_MVCC_FLAG_VALID_DELID));
       mvcc_id = logtb_get_current_mvccid (thread_p);
 
-      start_p = insert_context->recdes_p->data;
-      /* Skip bytes up to insid_offset */
-      new_ins_mvccid_pos_p = start_p + OR_MVCC_INSERT_ID_OFFSET;
-
-      if (!(mvcc_flags & OR_MVCC_FLAG_VALID_INSID))
-	{
-	  /* Sets MVCC INSID flag, overwrite first four bytes. */
-	  repid_and_flag_bits |= (OR_MVCC_FLAG_VALID_INSID << OR_MVCC_FLAG_SHIFT_BITS);
-	  OR_PUT_INT (start_p, repid_and_flag_bits);
-
-	  /* Move the record data before inserting INSID */
-	  assert (insert_context->recdes_p->area_size >= insert_context->recdes_p->length + OR_MVCCID_SIZE);
-	  existing_data_p = new_ins_mvccid_pos_p;
-	  memmove (new_ins_mvccid_pos_p + OR_MVCCID_SIZE, existing_data_p,
-		   insert_context->recdes_p->length - OR_MVCC_INSERT_ID_OFFSET);
-	  insert_context->recdes_p->length += OR_MVCCID_SIZE;
-	}
-
-      /* Sets the MVCC INSID */
-      OR_PUT_BIGINT (new_ins_mvccid_pos_p, &mvcc_id);
+      heap_insert_set_mvcc_insid (insert_context->recdes_p, mvcc_id);
 
       return NO_ERROR;
     }
@@ -23188,6 +23367,8 @@ heap_insert_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context,
   /* unfix other pages */
   heap_unfix_watchers (thread_p, context);
 
+  heap_zone_map_notify_insert (thread_p, &context->hfid.vfid, &context->res_oid);
+
   /*
    * Class creation case
    */
@@ -23232,6 +23413,201 @@ error:
   return rc;
 }
 
+/*
+ * heap_insert_batch_is_allowed () - can the instances of class be inserted with heap_insert_logical_batch?
+ *
+ * return	  : true if batched insert can be used
+ * thread_p (in)  : Thread entry
+ * class_oid (in) : Class object identifier
+ *
+ * NOTE: Batched insert logs the records of a page in one RVHF_MVCC_INSERT_MULTI log record. It is used only for MVCC
+ *	 operations and only when the log is not read by other consumers of RVHF_MVCC_INSERT records (replication and
+ *	 supplemental logging for CDC and flashback).
+ */
+bool
+heap_insert_batch_is_allowed (THREAD_ENTRY * thread_p, const OID * class_oid)
+{
+#if defined (SERVER_MODE)
+  if (OID_ISNULL (class_oid) || OID_IS_ROOTOID (class_oid) || mvcc_is_mvcc_disabled_class (class_oid))
+    {
+      return false;
+    }
+
+  if (!LOG_CHECK_LOG_APPLIER (thread_p) && log_does_allow_replication ())
+    {
+      return false;
+    }
+
+  if (check_supplemental_log (thread_p, (OID *) class_oid))
+    {
+      return false;
+    }
+
+  return true;
+#else /* SERVER_MODE */
+  /* no MVCC operations */
+  return false;
+#endif /* SERVER_MODE */
+}
+
+/*
+ * heap_insert_logical_batch () - Insert several objects onto the same heap page
+ *
+ * return	     : Error code
+ * thread_p (in)     : Thread entry
+ * hfid (in)	     : Heap file identifier
+ * class_oid (in)    : Class object identifier
+ * recdes_array (in) : Records to insert. The header of records is adjusted for insert.
+ * n_recdes (in)     : Number of records
+ * scan_cache (in)   : Scan cache used for insert
+ * oid_array (out)   : OID of inserted objects
+ * n_inserted (out)  : Number of inserted records. They are always the first records of the array.
+ *
+ * NOTE: A page is found for the first record and the following records are added to the same page as long as they
+ *	 fit without overpassing the unfill space of the page. The page is kept fixed for the whole batch and one
+ *	 RVHF_MVCC_INSERT_MULTI log record is appended for all inserted records. The caller should repeat the call for
+ *	 the records that were not inserted.
+ *
+ *	 All records must be REC_HOME records that fit in a page with the MVCC insert id added to their header, and
+ *	 their area must have room for the insert id. Batched insert must be allowed for the class (see
+ *	 heap_insert_batch_is_allowed).
+ */
+int
+heap_insert_logical_batch (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, RECDES * recdes_array, int n_recdes,
+			   HEAP_SCANCACHE * scan_cache, OID * oid_array, int *n_inserted)
+{
+  HEAP_OPERATION_CONTEXT context;
+  PGSLOTID slotids[HEAP_INSERT_BATCH_MAX_RECORDS];
+  LOG_DATA_ADDR log_addr;
+  MVCCID mvcc_id;
+  int n_records, n_done = 0;
+  int needed_space = 0, unfill_space;
+  int i;
+  int error_code = NO_ERROR;
+
+  assert (hfid != NULL && !HFID_IS_NULL (hfid));
+  assert (class_oid != NULL);
+  assert (recdes_array != NULL && n_recdes > 0);
+  assert (oid_array != NULL && n_inserted != NULL);
+  assert (heap_insert_batch_is_allowed (thread_p, class_oid));
+
+  *n_inserted = 0;
+
+  /* check scancache */
+  if (heap_scancache_check_with_hfid (thread_p, hfid, class_oid, &scan_cache) != NO_ERROR)
+    {
+      return ER_FAILED;
+    }
+
+  n_records = MIN (n_recdes, HEAP_INSERT_BATCH_MAX_RECORDS);
+
+  /* set the insert id of all records at once */
+  mvcc_id = logtb_get_current_mvccid (thread_p);
+  for (i = 0; i < n_records; i++)
+    {
+      assert (recdes_array[i].type == REC_HOME);
+      assert (!heap_is_big_length (recdes_array[i].length + OR_MVCCID_SIZE));
+
+      heap_insert_set_mvcc_insid (&recdes_array[i], mvcc_id);
+      if (needed_space < DB_PAGESIZE / 4)
+	{
+	  needed_space += recdes_array[i].length;
+	}
+    }
+  /* ask for enough space to make the batch worth it, but not so much that half empty pages are skipped */
+  needed_space = MAX (recdes_array[0].length, MIN (needed_space, DB_PAGESIZE / 4));
+  unfill_space = (int) ((float) DB_PAGESIZE * prm_get_float_value (PRM_ID_HF_UNFILL_FACTOR));
+
+  /* make sure we have IX_LOCK on class; see heap_insert_logical */
+  if (lock_object (thread_p, class_oid, oid_Root_class_oid, IX_LOCK, LK_UNCOND_LOCK) != LK_GRANTED)
+    {
+      return ER_FAILED;
+    }
+
+  heap_create_insert_context (&context, hfid, class_oid, &recdes_array[0], scan_cache);
+
+  /* find and fix page for the batch */
+  if (heap_stats_find_best_page (thread_p, hfid, needed_space, true, needed_space, scan_cache,
+				 &context.home_page_watcher) == NULL)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+
+  for (i = 0; i < n_records; i++)
+    {
+      context.recdes_p = &recdes_array[i];
+
+      if (i > 0
+	  && spage_max_space_for_new_record (thread_p, context.home_page_watcher.pgptr) - recdes_array[i].length
+	  < unfill_space)
+	{
+	  /* page is full */
+	  break;
+	}
+
+      /* get slot (includes locking) */
+      error_code = heap_get_insert_location_with_lock (thread_p, &context, &context.home_page_watcher);
+      if (error_code != NO_ERROR)
+	{
+	  if (error_code == ER_SP_NOSPACE_IN_PAGE && i > 0)
+	    {
+	      error_code = NO_ERROR;
+	    }
+	  else if (error_code == ER_SP_NOSPACE_IN_PAGE)
+	    {
+	      /* page was found for this record */
+	      assert_release (false);
+	      error_code = ER_FAILED;
+	    }
+	  break;
+	}
+
+      error_code = heap_insert_physical (thread_p, &context);
+      if (error_code != NO_ERROR)
+	{
+	  break;
+	}
+
+      slotids[n_done] = context.res_oid.slotid;
+      COPY_OID (&oid_array[n_done], &context.res_oid);
+      n_done++;
+    }
+
+  if (n_done > 0)
+    {
+      /* log all records inserted in page, even if the batch failed; rollback must remove them */
+      log_addr.vfid = &hfid->vfid;
+      log_addr.pgptr = context.home_page_watcher.pgptr;
+      log_addr.offset = NULL_SLOTID;
+      heap_mvcc_log_insert_multi (thread_p, recdes_array, slotids, n_done, &log_addr);
+
+      pgbuf_set_dirty (thread_p, context.home_page_watcher.pgptr, DONT_FREE);
+    }
+
+  /*
+   * Page unfix or caching
+   */
+  if (scan_cache != NULL && scan_cache->cache_last_fix_page == true && context.home_page_watcher.pgptr != NULL)
+    {
+      /* cache */
+      pgbuf_replace_watcher (thread_p, &context.home_page_watcher, &scan_cache->page_watcher);
+    }
+
+  /* unfix pages */
+  heap_unfix_watchers (thread_p, &context);
+
+  if (n_done > 0)
+    {
+      heap_zone_map_notify_insert (thread_p, &hfid->vfid, &oid_array[0]);
+    }
+
+  perfmon_add_stat (thread_p, PSTAT_HEAP_HOME_INSERTS, n_done);
+
+  *n_inserted = n_done;
+  return error_code;
+}
+
 /*
  * heap_delete_logical () - Delete an object from heap file
  *   thread_p(in): thread entry
@@ -23586,6 +23962,9 @@ heap_update_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context)
       context->do_supplemental_log = false;
     }
 
+  /* the zone of home page can't be rebuilt until this update is seen by all snapshots */
+  heap_zone_map_notify_update (thread_p, &context->hfid.vfid, &context->oid);
+
   /*
    * Update record
    */
@@ -138,6 +138,11 @@ struct heap_scancache_node_list
   HEAP_SCANCACHE_NODE_LIST *next;
 };
 
+/* maximum number of records inserted by one call of heap_insert_logical_batch (and logged by one log record) */
+#define HEAP_INSERT_BATCH_MAX_RECORDS 256
+
+#define HEAP_SCANCACHE_MAX_OVF_ATTRINFOS 2
+
 // *INDENT-OFF*
 typedef struct heap_scancache HEAP_SCANCACHE;
 struct heap_scancache
@@ -157,6 +162,10 @@ struct heap_scancache
     MVCC_SNAPSHOT *mvcc_snapshot;	/* mvcc snapshot */
     HEAP_SCANCACHE_NODE_LIST *partition_list;	/* list holding the heap file information for partition nodes involved
 						 * in the scan */
+    HEAP_CACHE_ATTRINFO *ovf_attr_infos[HEAP_SCANCACHE_MAX_OVF_ATTRINFOS];	/* attributes read from the scanned
+										 * records. if set, overflow records
+										 * are read only up to the last byte
+										 * of these attributes. */
 
 
     void start_area ();
@@ -415,6 +424,8 @@ extern int heap_scancache_quick_start_modify (HEAP_SCANCACHE * scan_cache);
 extern int heap_scancache_end (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
 extern int heap_scancache_end_when_scan_will_resume (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
 extern void heap_scancache_end_modify (THREAD_ENTRY * thread_p, HEAP_SCANCACHE * scan_cache);
+extern void heap_scancache_set_ovf_attrinfos (HEAP_SCANCACHE * scan_cache, HEAP_CACHE_ATTRINFO * pred_attr_info,
+					      HEAP_CACHE_ATTRINFO * rest_attr_info);
 extern SCAN_CODE heap_get_class_oid (THREAD_ENTRY * thread_p, const OID * oid, OID * class_oid);
 extern SCAN_CODE heap_next (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid,
 			    RECDES * recdes, HEAP_SCANCACHE * scan_cache, int ispeeking);
@@ -424,6 +435,8 @@ extern SCAN_CODE heap_next_sampling (THREAD_ENTRY * thread_p, const HFID * hfid,
 extern SCAN_CODE heap_next_record_info (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid,
 					RECDES * recdes, HEAP_SCANCACHE * scan_cache, int ispeeking,
 					DB_VALUE ** cache_recordinfo);
+extern SCAN_CODE heap_page_next (THREAD_ENTRY * thread_p, const VPID * vpid, OID * class_oid, OID * next_oid,
+				 RECDES * recdes, HEAP_SCANCACHE * scan_cache, int ispeeking);
 extern SCAN_CODE heap_prev (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * prev_oid,
 			    RECDES * recdes, HEAP_SCANCACHE * scan_cache, int ispeeking);
 extern SCAN_CODE heap_prev_record_info (THREAD_ENTRY * thread_p, const HFID * hfid, OID * class_oid, OID * next_oid,
@@ -580,6 +593,8 @@ extern void heap_rv_dump_chain (FILE * fp, int ignore_length, void *data);
 extern int heap_rv_undo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
 extern int heap_rv_redo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
 extern int heap_rv_mvcc_redo_insert (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
+extern int heap_rv_undo_insert_multi (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
+extern int heap_rv_mvcc_redo_insert_multi (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
 extern int heap_rv_undo_delete (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
 extern int heap_rv_redo_delete (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
 extern int heap_rv_mvcc_undo_delete (THREAD_ENTRY * thread_p, LOG_RCV * rcv);
@@ -657,6 +672,9 @@ extern void heap_create_delete_context (HEAP_OPERATION_CONTEXT * context, HFID *
 extern void heap_create_update_context (HEAP_OPERATION_CONTEXT * context, HFID * hfid_p, OID * oid_p, OID * class_oid_p,
 					RECDES * recdes_p, HEAP_SCANCACHE * scancache_p, UPDATE_INPLACE_STYLE in_place);
 extern int heap_insert_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context, PGBUF_WATCHER * home_hint_p);
+extern bool heap_insert_batch_is_allowed (THREAD_ENTRY * thread_p, const OID * class_oid);
+extern int heap_insert_logical_batch (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, RECDES * recdes_array,
+				      int n_recdes, HEAP_SCANCACHE * scan_cache, OID * oid_array, int *n_inserted);
 extern int heap_delete_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context);
 extern int heap_update_logical (THREAD_ENTRY * thread_p, HEAP_OPERATION_CONTEXT * context);
 
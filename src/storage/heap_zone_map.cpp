@@ -0,0 +1,1626 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// heap_zone_map - min/max summaries of ranges of heap pages, used by heap scans to skip pages
+//
+
+#include "heap_zone_map.hpp"
+
+#include "dbtype.h"
+#include "error_manager.h"
+#include "file_manager.h"
+#include "heap_file.h"
+#include "log_impl.h"
+#include "memory_alloc.h"
+#include "mvcc.h"
+#include "object_domain.h"
+#include "page_buffer.h"
+#include "slotted_page.h"
+#include "system_parameter.h"
+#include "thread_entry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "memory_wrapper.hpp"
+
+typedef enum
+{
+  HEAP_ZONE_UNKNOWN,		/* zone was never built or it was modified since */
+  HEAP_ZONE_VALID,		/* summaries of zone can be used */
+  HEAP_ZONE_UNSKIPPABLE		/* zone has objects that are not summarized (relocated or big records) */
+} HEAP_ZONE_STATE;
+
+/* signatures of trigrams have about 8 bits per distinct trigram of the zone, from 64 to 2^20 bits */
+#define HEAP_ZONE_TRIGRAM_BITS_PER_TRIGRAM 8
+#define HEAP_ZONE_TRIGRAM_MIN_BITS 64
+#define HEAP_ZONE_TRIGRAM_MAX_BITS (1 << 20)
+
+/* trigrams of the values read while a zone is built are deduplicated when they reach this count */
+#define HEAP_ZONE_TRIGRAM_DEDUP_COUNT 65536
+
+/* summary of an attribute in a zone */
+struct heap_zone_attr
+{
+  DB_VALUE min_value;
+  DB_VALUE max_value;
+  int null_count;
+  int value_count;		/* not null values */
+  // *INDENT-OFF*
+  std::vector<std::uint64_t> trigram_bits;	/* signature of the trigrams of a string attribute */
+  // *INDENT-ON*
+  int trigram_bits_set;		/* bits set in trigram_bits */
+};
+
+struct heap_zone
+{
+  HEAP_ZONE_STATE state;
+  std::uint64_t modify_seq;	/* sequence of the zone map when the zone was last modified */
+  MVCCID update_mvccid;		/* latest transaction that updated objects of the zone */
+  MVCCID built_mvccid;		/* latest transaction that updated objects of the zone before it was built */
+  heap_zone_attr attrs[HEAP_ZONE_MAP_MAX_ATTRS];
+
+  heap_zone ()
+    : state (HEAP_ZONE_UNKNOWN)
+    , modify_seq (0)
+    , update_mvccid (MVCCID_NULL)
+    , built_mvccid (MVCCID_NULL)
+    , attrs ()
+  {
+  }
+};
+
+struct heap_zone_map
+{
+  VFID vfid;
+  OID class_oid;
+  int zone_pages;		/* pages in a zone */
+  MVCCID create_mvccid;		/* next MVCCID when the zone map was created; older updates are not tracked */
+
+  std::mutex mutex;
+  std::uint64_t modify_seq;	/* incremented for each modification of a zone */
+  int attrs_version;		/* incremented when an attribute is added */
+  int n_attrs;
+  ATTR_ID attr_ids[HEAP_ZONE_MAP_MAX_ATTRS];
+  DB_TYPE attr_types[HEAP_ZONE_MAP_MAX_ATTRS];
+  // *INDENT-OFF*
+  std::unordered_map<std::uint64_t, heap_zone> zones;
+  // *INDENT-ON*
+
+  heap_zone_map (const VFID &vfid_arg, const OID &class_oid_arg, int zone_pages_arg)
+    : vfid (vfid_arg)
+    , class_oid (class_oid_arg)
+    , zone_pages (zone_pages_arg)
+    , create_mvccid (MVCCID_NULL)
+    , mutex ()
+    , modify_seq (0)
+    , attrs_version (0)
+    , n_attrs (0)
+    , attr_ids ()
+    , attr_types ()
+    , zones ()
+  {
+  }
+
+  std::uint64_t
+  get_zone_key (const VPID &vpid) const
+  {
+    return (((std::uint64_t) (std::uint16_t) vpid.volid) << 32) | (std::uint32_t) (vpid.pageid / zone_pages);
+  }
+
+  int
+  find_attr (ATTR_ID attrid) const
+  {
+    for (int i = 0; i < n_attrs; i++)
+      {
+	if (attr_ids[i] == attrid)
+	  {
+	    return i;
+	  }
+      }
+    return -1;
+  }
+};
+
+struct heap_zone_scan_bound
+{
+  int attr_index;		/* index of attribute in zone map */
+  HEAP_ZONE_BOUND_OP op;
+  const DB_VALUE *value;
+  // *INDENT-OFF*
+  std::vector<std::uint32_t> trigrams;	/* trigrams that values matching a LIKE or REGEXP bound contain */
+  // *INDENT-ON*
+};
+
+struct heap_zone_scan
+{
+  // *INDENT-OFF*
+  std::shared_ptr<heap_zone_map> map;
+  // *INDENT-ON*
+  HFID hfid;
+  OID class_oid;
+  MVCC_SNAPSHOT *snapshot;
+  std::uint64_t start_seq;	/* zone map sequence when pages were collected */
+  int attrs_version;
+
+  VPID *vpids;			/* user pages of heap file, ordered by volume and page */
+  int page_count;
+  bool forward;
+  int next_page;		/* next page to return */
+  int group_end;		/* end of pages of current zone, exclusive in scan direction */
+
+  int n_bounds;
+  heap_zone_scan_bound bounds[HEAP_ZONE_MAP_MAX_ATTRS * 2];
+
+  HEAP_CACHE_ATTRINFO attr_info;	/* to read attributes when zones are built */
+  bool attr_info_inited;
+};
+
+/* zone maps of heap files, by VFID. the registry is checked by every heap insert and update; the counter lets them
+ * skip the lookup while no zone maps exist */
+// *INDENT-OFF*
+static std::mutex heap_Zone_maps_mutex;
+static std::unordered_map<std::uint64_t, std::shared_ptr<heap_zone_map>> heap_Zone_maps;
+// *INDENT-ON*
+static std::atomic<int> heap_Zone_maps_count (0);
+
+static std::uint64_t heap_zone_map_vfid_key (const VFID * vfid);
+// *INDENT-OFF*
+static std::shared_ptr<heap_zone_map> heap_zone_map_find (const VFID * vfid);
+static std::shared_ptr<heap_zone_map> heap_zone_map_find_or_create (const VFID * vfid, const OID * class_oid,
+								     int zone_pages);
+// *INDENT-ON*
+static void heap_zone_map_notify (THREAD_ENTRY * thread_p, const VFID * vfid, const VPID * vpid, bool is_update);
+static bool heap_zone_map_is_summarized_type (DB_TYPE type);
+static bool heap_zone_map_is_trigram_type (DB_TYPE type);
+static bool heap_zone_map_can_summarize (DB_TYPE attr_type, DB_TYPE value_type);
+static bool heap_zone_bound_is_usable (const HEAP_ZONE_BOUND * bound);
+static double heap_zone_map_value_to_double (const DB_VALUE * value);
+static void heap_zone_add_value (heap_zone_attr * zone_attr, DB_VALUE * value);
+// *INDENT-OFF*
+static std::uint32_t heap_zone_trigram (const unsigned char *bytes);
+static void heap_zone_signature_bits (std::uint32_t trigram, std::size_t n_bits, std::size_t * bit1,
+				      std::size_t * bit2);
+static bool heap_zone_signature_has (const heap_zone_attr * zone_attr, std::uint32_t trigram);
+static void heap_zone_add_string (heap_zone_attr * zone_attr, DB_VALUE * value, std::vector<std::uint32_t> &trigrams);
+static void heap_zone_make_signature (heap_zone_attr * zone_attr, std::vector<std::uint32_t> &trigrams);
+static void heap_zone_literal_trigrams (const std::string &literal, bool is_regexp, bool is_case_sensitive,
+					std::vector<std::uint32_t> &trigrams);
+static void heap_zone_like_trigrams (const DB_VALUE * pattern, const DB_VALUE * escape,
+				     std::vector<std::uint32_t> &trigrams);
+static void heap_zone_regexp_trigrams (const DB_VALUE * pattern, bool is_case_sensitive,
+				       std::vector<std::uint32_t> &trigrams);
+// *INDENT-ON*
+static bool heap_zone_can_skip (const heap_zone_scan * zone_scan, const heap_zone * zone);
+static int heap_zone_build (THREAD_ENTRY * thread_p, heap_zone_scan * zone_scan, int first_page, int last_page,
+			    heap_zone * zone);
+static int heap_zone_scan_check_zone (THREAD_ENTRY * thread_p, heap_zone_scan * zone_scan, int first_page,
+				      int last_page, bool * can_skip);
+
+static std::uint64_t
+heap_zone_map_vfid_key (const VFID * vfid)
+{
+  return (((std::uint64_t) (std::uint16_t) vfid->volid) << 32) | (std::uint32_t) vfid->fileid;
+}
+
+// *INDENT-OFF*
+static std::shared_ptr<heap_zone_map>
+heap_zone_map_find (const VFID * vfid)
+{
+  std::unique_lock<std::mutex> ulock (heap_Zone_maps_mutex);
+
+  auto it = heap_Zone_maps.find (heap_zone_map_vfid_key (vfid));
+  if (it == heap_Zone_maps.end ())
+    {
+      return nullptr;
+    }
+  return it->second;
+}
+
+static std::shared_ptr<heap_zone_map>
+heap_zone_map_find_or_create (const VFID * vfid, const OID * class_oid, int zone_pages)
+{
+  std::shared_ptr<heap_zone_map> map;
+
+  {
+    std::unique_lock<std::mutex> ulock (heap_Zone_maps_mutex);
+
+    auto it = heap_Zone_maps.find (heap_zone_map_vfid_key (vfid));
+    if (it != heap_Zone_maps.end ())
+      {
+	return it->second;
+      }
+
+    map = std::make_shared<heap_zone_map> (*vfid, *class_oid, zone_pages);
+    heap_Zone_maps[heap_zone_map_vfid_key (vfid)] = map;
+    heap_Zone_maps_count++;
+  }
+
+  /* updates are tracked from now on. the transactions that could have updated objects before have smaller MVCCIDs
+   * than the next one. */
+  std::unique_lock<std::mutex> map_lock (map->mutex);
+  map->create_mvccid = LOG_READ_NEXT_MVCCID;
+
+  return map;
+}
+// *INDENT-ON*
+
+/*
+ * heap_zone_map_notify () - invalidate the zone of a modified heap page
+ *
+ * thread_p (in)  : thread entry
+ * vfid (in)	  : heap file
+ * vpid (in)	  : modified page
+ * is_update (in) : true if an existing object was updated
+ */
+static void
+heap_zone_map_notify (THREAD_ENTRY * thread_p, const VFID * vfid, const VPID * vpid, bool is_update)
+{
+  if (heap_Zone_maps_count == 0)
+    {
+      return;
+    }
+
+  // *INDENT-OFF*
+  std::shared_ptr<heap_zone_map> map = heap_zone_map_find (vfid);
+  // *INDENT-ON*
+  if (map == NULL)
+    {
+      return;
+    }
+
+  MVCCID mvccid = is_update ? logtb_get_current_mvccid (thread_p) : MVCCID_NULL;
+
+  std::unique_lock<std::mutex> ulock (map->mutex);
+  heap_zone &zone = map->zones[map->get_zone_key (*vpid)];
+
+  zone.state = HEAP_ZONE_UNKNOWN;
+  zone.modify_seq = ++map->modify_seq;
+  if (is_update && zone.update_mvccid < mvccid)
+    {
+      zone.update_mvccid = mvccid;
+    }
+}
+
+/*
+ * heap_zone_map_notify_insert () - an object was inserted; must be called after the object is in the page
+ *
+ * thread_p (in) : thread entry
+ * vfid (in)	 : heap file
+ * oid (in)	 : inserted object
+ */
+void
+heap_zone_map_notify_insert (THREAD_ENTRY * thread_p, const VFID * vfid, const OID * oid)
+{
+  VPID vpid;
+
+  VPID_GET_FROM_OID (&vpid, oid);
+  heap_zone_map_notify (thread_p, vfid, &vpid, false);
+}
+
+/*
+ * heap_zone_map_notify_update () - an object is about to be updated; must be called before its home page is changed
+ *
+ * thread_p (in) : thread entry
+ * vfid (in)	 : heap file
+ * oid (in)	 : updated object
+ *
+ * NOTE: the zone will not be built again until the updating transaction is completed, and only snapshots that see
+ *	 the update will use it.
+ */
+void
+heap_zone_map_notify_update (THREAD_ENTRY * thread_p, const VFID * vfid, const OID * oid)
+{
+  VPID vpid;
+
+  VPID_GET_FROM_OID (&vpid, oid);
+  heap_zone_map_notify (thread_p, vfid, &vpid, true);
+}
+
+/*
+ * heap_zone_map_notify_vacuum () - objects of a page were vacuumed; the zone is invalidated to be rebuilt without
+ *				    the removed versions
+ *
+ * thread_p (in) : thread entry
+ * vfid (in)	 : heap file
+ * vpid (in)	 : vacuumed page
+ */
+void
+heap_zone_map_notify_vacuum (THREAD_ENTRY * thread_p, const VFID * vfid, const VPID * vpid)
+{
+  heap_zone_map_notify (thread_p, vfid, vpid, false);
+}
+
+/*
+ * heap_zone_map_drop () - remove the zone map of a destroyed heap file
+ *
+ * vfid (in) : heap file
+ */
+void
+heap_zone_map_drop (const VFID * vfid)
+{
+  if (heap_Zone_maps_count == 0)
+    {
+      return;
+    }
+
+  std::unique_lock<std::mutex> ulock (heap_Zone_maps_mutex);
+  if (heap_Zone_maps.erase (heap_zone_map_vfid_key (vfid)) > 0)
+    {
+      heap_Zone_maps_count--;
+    }
+}
+
+/*
+ * heap_zone_map_final () - remove all zone maps
+ */
+void
+heap_zone_map_final (void)
+{
+  std::unique_lock<std::mutex> ulock (heap_Zone_maps_mutex);
+
+  heap_Zone_maps.clear ();
+  heap_Zone_maps_count = 0;
+}
+
+/*
+ * heap_zone_map_get_width () - average fraction of the value range of an attribute that is covered by a zone
+ *
+ * return     : value between 0 and 1; 1 if the attribute has no zone map
+ * vfid (in)  : heap file
+ * attrid (in): attribute identifier
+ *
+ * NOTE: a scan with a predicate of selectivity s on a well clustered attribute reads about s + width of the heap.
+ *	 zones that cannot be skipped count as covering the whole range.
+ *	 the width of a string attribute summarized by trigrams is the average fraction of zones whose signature has
+ *	 the bits of a trigram they don't contain, i.e. the zones read in vain by a LIKE or REGEXP search.
+ */
+double
+heap_zone_map_get_width (const VFID * vfid, ATTR_ID attrid)
+{
+  double min_value = 0, max_value = 0, zone_width = 0;
+  double width_sum = 0;
+  int n_valid = 0, n_unusable = 0;
+  int attr_index;
+
+  if (heap_Zone_maps_count == 0)
+    {
+      return 1.0;
+    }
+
+  // *INDENT-OFF*
+  std::shared_ptr<heap_zone_map> map = heap_zone_map_find (vfid);
+  // *INDENT-ON*
+  if (map == NULL)
+    {
+      return 1.0;
+    }
+
+  std::unique_lock<std::mutex> ulock (map->mutex);
+
+  attr_index = map->find_attr (attrid);
+  if (attr_index < 0)
+    {
+      return 1.0;
+    }
+
+  if (heap_zone_map_is_trigram_type (map->attr_types[attr_index]))
+    {
+      // *INDENT-OFF*
+      for (const auto &it : map->zones)
+	{
+	  const heap_zone_attr &zone_attr = it.second.attrs[attr_index];
+	  double fill;
+
+	  if (it.second.state != HEAP_ZONE_VALID)
+	    {
+	      width_sum += 1.0;
+	      n_unusable++;
+	      continue;
+	    }
+	  if (zone_attr.value_count > 0)
+	    {
+	      /* both bits of the trigram are set */
+	      fill = (double) zone_attr.trigram_bits_set / (zone_attr.trigram_bits.size () * 64);
+	      width_sum += fill * fill;
+	    }
+	  n_valid++;
+	}
+      // *INDENT-ON*
+
+      if (n_valid == 0)
+	{
+	  return 1.0;
+	}
+      return MIN (1.0, width_sum / (n_valid + n_unusable));
+    }
+
+  // *INDENT-OFF*
+  for (const auto &it : map->zones)
+    {
+      const heap_zone &zone = it.second;
+      const heap_zone_attr &zone_attr = zone.attrs[attr_index];
+
+      if (zone.state != HEAP_ZONE_VALID)
+	{
+	  n_unusable++;
+	  continue;
+	}
+      if (zone_attr.value_count == 0)
+	{
+	  /* only nulls; skipped by every comparison */
+	  n_valid++;
+	  continue;
+	}
+
+      double zone_min = heap_zone_map_value_to_double (&zone_attr.min_value);
+      double zone_max = heap_zone_map_value_to_double (&zone_attr.max_value);
+
+      if (n_valid == 0 || zone_min < min_value)
+	{
+	  min_value = zone_min;
+	}
+      if (n_valid == 0 || zone_max > max_value)
+	{
+	  max_value = zone_max;
+	}
+      width_sum += zone_max - zone_min;
+      n_valid++;
+    }
+  // *INDENT-ON*
+
+  if (n_valid < 2 || max_value <= min_value)
+    {
+      return 1.0;
+    }
+
+  zone_width = width_sum / n_valid / (max_value - min_value);
+  zone_width = (zone_width * n_valid + n_unusable) / (n_valid + n_unusable);
+
+  return MIN (1.0, MAX (0.0, zone_width));
+}
+
+static bool
+heap_zone_map_is_summarized_type (DB_TYPE type)
+{
+  switch (type)
+    {
+    case DB_TYPE_SHORT:
+    case DB_TYPE_INTEGER:
+    case DB_TYPE_BIGINT:
+    case DB_TYPE_FLOAT:
+    case DB_TYPE_DOUBLE:
+    case DB_TYPE_MONETARY:
+    case DB_TYPE_DATE:
+    case DB_TYPE_TIME:
+    case DB_TYPE_TIMESTAMP:
+    case DB_TYPE_TIMESTAMPLTZ:
+    case DB_TYPE_TIMESTAMPTZ:
+    case DB_TYPE_DATETIME:
+    case DB_TYPE_DATETIMELTZ:
+    case DB_TYPE_DATETIMETZ:
+      /* values are kept entirely in DB_VALUE and can be copied bitwise */
+      return true;
+    default:
+      return false;
+    }
+}
+
+/* string attributes are summarized by the trigrams of their values */
+static bool
+heap_zone_map_is_trigram_type (DB_TYPE type)
+{
+  return type == DB_TYPE_CHAR || type == DB_TYPE_VARCHAR;
+}
+
+/* can the values of an attribute be summarized; values of string attributes are summarized by trigrams */
+static bool
+heap_zone_map_can_summarize (DB_TYPE attr_type, DB_TYPE value_type)
+{
+  if (heap_zone_map_is_trigram_type (attr_type))
+    {
+      return heap_zone_map_is_trigram_type (value_type);
+    }
+  return heap_zone_map_is_summarized_type (value_type);
+}
+
+/* can zone maps check the bound */
+static bool
+heap_zone_bound_is_usable (const HEAP_ZONE_BOUND * bound)
+{
+  if (bound->op == HEAP_ZONE_BOUND_LIKE || bound->op == HEAP_ZONE_BOUND_REGEXP)
+    {
+      return (heap_zone_map_is_trigram_type (bound->type) && bound->value != NULL && !DB_IS_NULL (bound->value)
+	      && TP_IS_CHAR_TYPE (DB_VALUE_TYPE (bound->value)));
+    }
+  return heap_zone_map_is_summarized_type (bound->type);
+}
+
+static double
+heap_zone_map_value_to_double (const DB_VALUE * value)
+{
+  const DB_DATETIME *datetime;
+
+  switch (DB_VALUE_TYPE (value))
+    {
+    case DB_TYPE_SHORT:
+      return db_get_short (value);
+    case DB_TYPE_INTEGER:
+      return db_get_int (value);
+    case DB_TYPE_BIGINT:
+      return (double) db_get_bigint (value);
+    case DB_TYPE_FLOAT:
+      return db_get_float (value);
+    case DB_TYPE_DOUBLE:
+      return db_get_double (value);
+    case DB_TYPE_MONETARY:
+      return db_get_monetary (value)->amount;
+    case DB_TYPE_DATE:
+      return *db_get_date (value);
+    case DB_TYPE_TIME:
+      return *db_get_time (value);
+    case DB_TYPE_TIMESTAMP:
+    case DB_TYPE_TIMESTAMPLTZ:
+      return *db_get_timestamp (value);
+    case DB_TYPE_TIMESTAMPTZ:
+      return db_get_timestamptz (value)->timestamp;
+    case DB_TYPE_DATETIME:
+    case DB_TYPE_DATETIMELTZ:
+      datetime = db_get_datetime (value);
+      return (double) datetime->date * 86400000.0 + datetime->time;
+    case DB_TYPE_DATETIMETZ:
+      datetime = &db_get_datetimetz (value)->datetime;
+      return (double) datetime->date * 86400000.0 + datetime->time;
+    default:
+      assert (false);
+      return 0;
+    }
+}
+
+static void
+heap_zone_add_value (heap_zone_attr * zone_attr, DB_VALUE * value)
+{
+  if (DB_IS_NULL (value))
+    {
+      zone_attr->null_count++;
+      return;
+    }
+
+  if (zone_attr->value_count == 0)
+    {
+      zone_attr->min_value = *value;
+      zone_attr->max_value = *value;
+    }
+  else if (tp_value_compare (value, &zone_attr->min_value, 1, 1) == DB_LT)
+    {
+      zone_attr->min_value = *value;
+    }
+  else if (tp_value_compare (value, &zone_attr->max_value, 1, 1) == DB_GT)
+    {
+      zone_attr->max_value = *value;
+    }
+  zone_attr->value_count++;
+}
+
+/*
+ * heap_zone_trigram () - trigram of three bytes; ascii letters are folded to lower case
+ */
+static std::uint32_t
+heap_zone_trigram (const unsigned char *bytes)
+{
+  std::uint32_t trigram = 0;
+  int i;
+
+  for (i = 0; i < 3; i++)
+    {
+      unsigned char c = bytes[i];
+
+      if (c >= 'A' && c <= 'Z')
+	{
+	  c = c - 'A' + 'a';
+	}
+      trigram = (trigram << 8) | c;
+    }
+  return trigram;
+}
+
+/*
+ * heap_zone_signature_bits () - the two bits of a trigram in a signature of n_bits bits (a power of 2)
+ */
+static void
+heap_zone_signature_bits (std::uint32_t trigram, std::size_t n_bits, std::size_t * bit1, std::size_t * bit2)
+{
+  std::uint64_t hash = trigram * 0x9E3779B97F4A7C15ULL;
+
+  *bit1 = (std::size_t) (hash >> 32) & (n_bits - 1);
+  *bit2 = (std::size_t) (hash & 0xFFFFFFFF) & (n_bits - 1);
+}
+
+/*
+ * heap_zone_signature_has () - may the values of the attribute in the zone contain the trigram?
+ */
+static bool
+heap_zone_signature_has (const heap_zone_attr * zone_attr, std::uint32_t trigram)
+{
+  std::size_t bit1, bit2;
+
+  if (zone_attr->trigram_bits.empty ())
+    {
+      /* no value has three bytes */
+      return false;
+    }
+
+  heap_zone_signature_bits (trigram, zone_attr->trigram_bits.size () * 64, &bit1, &bit2);
+  return ((zone_attr->trigram_bits[bit1 / 64] >> (bit1 % 64)) & 1) != 0
+    && ((zone_attr->trigram_bits[bit2 / 64] >> (bit2 % 64)) & 1) != 0;
+}
+
+/*
+ * heap_zone_add_string () - add a value of a string attribute to the summary of a zone being built
+ *
+ * zone_attr (in/out) : summary of the attribute
+ * value (in)	      : value
+ * trigrams (in/out)  : trigrams of the values added so far
+ */
+// *INDENT-OFF*
+static void
+heap_zone_add_string (heap_zone_attr * zone_attr, DB_VALUE * value, std::vector<std::uint32_t> &trigrams)
+// *INDENT-ON*
+{
+  const unsigned char *str;
+  int size, i;
+
+  if (DB_IS_NULL (value))
+    {
+      zone_attr->null_count++;
+      return;
+    }
+  zone_attr->value_count++;
+
+  str = (const unsigned char *) db_get_string (value);
+  size = db_get_string_size (value);
+  for (i = 0; i + 3 <= size; i++)
+    {
+      trigrams.push_back (heap_zone_trigram (str + i));
+    }
+
+  if (trigrams.size () >= HEAP_ZONE_TRIGRAM_DEDUP_COUNT)
+    {
+      std::sort (trigrams.begin (), trigrams.end ());
+      trigrams.erase (std::unique (trigrams.begin (), trigrams.end ()), trigrams.end ());
+    }
+}
+
+/*
+ * heap_zone_make_signature () - make the signature of the trigrams of the values of a zone
+ *
+ * zone_attr (in/out) : summary of the attribute
+ * trigrams (in/out)  : trigrams of the values of the zone; deduplicated
+ */
+// *INDENT-OFF*
+static void
+heap_zone_make_signature (heap_zone_attr * zone_attr, std::vector<std::uint32_t> &trigrams)
+// *INDENT-ON*
+{
+  std::size_t n_bits, bit1, bit2;
+
+  zone_attr->trigram_bits.clear ();
+  zone_attr->trigram_bits_set = 0;
+  if (trigrams.empty ())
+    {
+      return;
+    }
+
+  std::sort (trigrams.begin (), trigrams.end ());
+  trigrams.erase (std::unique (trigrams.begin (), trigrams.end ()), trigrams.end ());
+
+  for (n_bits = HEAP_ZONE_TRIGRAM_MIN_BITS;
+       n_bits < trigrams.size () * HEAP_ZONE_TRIGRAM_BITS_PER_TRIGRAM && n_bits < HEAP_ZONE_TRIGRAM_MAX_BITS;
+       n_bits *= 2)
+    {
+      ;
+    }
+  zone_attr->trigram_bits.assign (n_bits / 64, 0);
+
+  // *INDENT-OFF*
+  for (std::uint32_t trigram : trigrams)
+    {
+      heap_zone_signature_bits (trigram, n_bits, &bit1, &bit2);
+      for (std::size_t bit : { bit1, bit2 })
+	{
+	  std::uint64_t mask = ((std::uint64_t) 1) << (bit % 64);
+
+	  if ((zone_attr->trigram_bits[bit / 64] & mask) == 0)
+	    {
+	      zone_attr->trigram_bits[bit / 64] |= mask;
+	      zone_attr->trigram_bits_set++;
+	    }
+	}
+    }
+  // *INDENT-ON*
+}
+
+/*
+ * heap_zone_literal_trigrams () - add the trigrams of a literal that the matches of a pattern contain
+ *
+ * literal (in)		  : bytes of the literal
+ * is_regexp (in)	  : the pattern is a regular expression
+ * is_case_sensitive (in) : the regular expression is case sensitive
+ * trigrams (in/out)	  : trigrams
+ *
+ * NOTE: LIKE with binary collations compares space and the zero character as equal, so trigrams with either are not
+ *	 used. regular expressions match the strings converted to utf8, so only ascii trigrams are used; when they
+ *	 ignore case, 'i', 'k' and 's' may also match characters out of ascii (kelvin sign, long s, dotted capital i)
+ *	 and trigrams with them are not used either.
+ */
+// *INDENT-OFF*
+static void
+heap_zone_literal_trigrams (const std::string &literal, bool is_regexp, bool is_case_sensitive,
+			    std::vector<std::uint32_t> &trigrams)
+// *INDENT-ON*
+{
+  const unsigned char *bytes = (const unsigned char *) literal.data ();
+  std::size_t i, j;
+
+  for (i = 0; i + 3 <= literal.size (); i++)
+    {
+      for (j = i; j < i + 3; j++)
+	{
+	  unsigned char c = bytes[j];
+
+	  if (c == ' ' || c == '\0')
+	    {
+	      break;
+	    }
+	  if (is_regexp && c >= 0x80)
+	    {
+	      break;
+	    }
+	  if (is_regexp && !is_case_sensitive && std::strchr ("iIkKsS", c) != NULL)
+	    {
+	      break;
+	    }
+	}
+      if (j == i + 3)
+	{
+	  trigrams.push_back (heap_zone_trigram (bytes + i));
+	}
+    }
+}
+
+/*
+ * heap_zone_like_trigrams () - trigrams that the strings matching a LIKE pattern contain
+ *
+ * pattern (in)	     : pattern
+ * escape (in)	     : escape character; NULL if none, a null value for the default '\'
+ * trigrams (in/out) : trigrams
+ *
+ * NOTE: the literals are the runs of bytes between the wildcards. an escape character ends a literal and the byte
+ *	 following it is not used.
+ */
+// *INDENT-OFF*
+static void
+heap_zone_like_trigrams (const DB_VALUE * pattern, const DB_VALUE * escape, std::vector<std::uint32_t> &trigrams)
+// *INDENT-ON*
+{
+  const char *str = db_get_string (pattern);
+  int size = db_get_string_size (pattern);
+  int escape_byte = -1;
+  std::string literal;
+  int i;
+
+  if (escape != NULL)
+    {
+      if (DB_IS_NULL (escape))
+	{
+	  escape_byte = '\\';
+	}
+      else if (TP_IS_CHAR_TYPE (DB_VALUE_TYPE (escape)) && db_get_string_size (escape) > 0)
+	{
+	  escape_byte = (unsigned char) db_get_string (escape)[0];
+	}
+      else
+	{
+	  return;
+	}
+    }
+
+  for (i = 0; i <= size; i++)
+    {
+      if (i < size && str[i] != '%' && str[i] != '_' && (unsigned char) str[i] != escape_byte)
+	{
+	  literal.push_back (str[i]);
+	  continue;
+	}
+
+      heap_zone_literal_trigrams (literal, false, true, trigrams);
+      literal.clear ();
+      if (i < size && (unsigned char) str[i] == escape_byte)
+	{
+	  i++;
+	}
+    }
+}
+
+/*
+ * heap_zone_regexp_trigrams () - trigrams that the strings matching a regular expression contain
+ *
+ * pattern (in)		  : regular expression
+ * is_case_sensitive (in) : the regular expression is case sensitive
+ * trigrams (in/out)	  : trigrams
+ *
+ * NOTE: the literals are the runs of characters outside groups and bracket expressions, without the character before
+ *	 a '*', '?' or '{' quantifier. escapes of letters and digits (classes, code points) end a literal with the
+ *	 letters and digits that follow them. an alternation out of the groups has no required literal, and a group
+ *	 starting with '?' may set flags, so the expression is taken as ignoring case.
+ */
+// *INDENT-OFF*
+static void
+heap_zone_regexp_trigrams (const DB_VALUE * pattern, bool is_case_sensitive, std::vector<std::uint32_t> &trigrams)
+// *INDENT-ON*
+{
+  const char *str = db_get_string (pattern);
+  int size = db_get_string_size (pattern);
+  // *INDENT-OFF*
+  std::vector<std::string> literals;
+  // *INDENT-ON*
+  std::string literal;
+  int depth = 0;
+  int i;
+
+  for (i = 0; i < size; i++)
+    {
+      unsigned char c = (unsigned char) str[i];
+
+      switch (c)
+	{
+	case '|':
+	  if (depth == 0)
+	    {
+	      return;
+	    }
+	  break;
+
+	case '(':
+	  if (i + 1 < size && str[i + 1] == '?')
+	    {
+	      /* may be flags, like (?i) */
+	      is_case_sensitive = false;
+	    }
+	  depth++;
+	  break;
+
+	case ')':
+	  depth = MAX (0, depth - 1);
+	  break;
+
+	case '[':
+	  /* skip the bracket expression; ']' first is a member */
+	  i++;
+	  if (i < size && str[i] == '^')
+	    {
+	      i++;
+	    }
+	  if (i < size && str[i] == ']')
+	    {
+	      i++;
+	    }
+	  for (; i < size && str[i] != ']'; i++)
+	    {
+	      if (str[i] == '[' && i + 1 < size && (str[i + 1] == ':' || str[i + 1] == '.' || str[i + 1] == '='))
+		{
+		  /* [:class:], [.coll.] or [=equiv=] */
+		  const char *end = (const char *) std::memchr (str + i + 2, str[i + 1], size - i - 2);
+
+		  if (end == NULL || end + 1 >= str + size || end[1] != ']')
+		    {
+		      return;
+		    }
+		  i = (int) (end + 1 - str);
+		}
+	      else if (str[i] == '\\')
+		{
+		  i++;
+		}
+	    }
+	  if (i >= size)
+	    {
+	      /* not terminated */
+	      return;
+	    }
+	  break;
+
+	case '+':
+	  if (i + 1 == size || (str[i + 1] != '*' && str[i + 1] != '?' && str[i + 1] != '{'))
+	    {
+	      /* the character before is there at least once */
+	      break;
+	    }
+	  /* fall through: '+*' and the like make the character before optional */
+	case '*':
+	case '?':
+	case '{':
+	  /* the character before is optional */
+	  if (depth == 0 && !literal.empty ())
+	    {
+	      std::size_t last = literal.size () - 1;
+
+	      while (last > 0 && (literal[last] & 0xC0) == 0x80)
+		{
+		  /* continuation byte of utf8 */
+		  last--;
+		}
+	      literal.resize (last);
+	    }
+	  if (c == '{')
+	    {
+	      const char *end = (const char *) std::memchr (str + i, '}', size - i);
+
+	      i = (end != NULL) ? (int) (end - str) : size;
+	    }
+	  break;
+
+	case '\\':
+	  if (i + 1 < size && !std::isalnum ((unsigned char) str[i + 1]))
+	    {
+	      /* escaped punctuation is itself */
+	      i++;
+	      if (depth == 0)
+		{
+		  literal.push_back (str[i]);
+		  continue;
+		}
+	      break;
+	    }
+	  for (i++; i + 1 < size && std::isalnum ((unsigned char) str[i + 1]); i++)
+	    {
+	      ;
+	    }
+	  break;
+
+	case '.':
+	case '^':
+	case '$':
+	case ']':
+	case '}':
+	  break;
+
+	default:
+	  if (depth == 0)
+	    {
+	      literal.push_back (str[i]);
+	      continue;
+	    }
+	  break;
+	}
+
+      /* c ends the literal */
+      literals.push_back (literal);
+      literal.clear ();
+    }
+  literals.push_back (literal);
+
+  // *INDENT-OFF*
+  for (const std::string &l : literals)
+    {
+      heap_zone_literal_trigrams (l, true, is_case_sensitive, trigrams);
+    }
+  // *INDENT-ON*
+}
+
+/*
+ * heap_zone_can_skip () - can the zone be skipped? true if no object of zone can satisfy all the bounds
+ */
+static bool
+heap_zone_can_skip (const heap_zone_scan * zone_scan, const heap_zone * zone)
+{
+  DB_VALUE_COMPARE_RESULT min_cmp, max_cmp;
+  int i;
+
+  for (i = 0; i < zone_scan->n_bounds; i++)
+    {
+      const heap_zone_scan_bound *bound = &zone_scan->bounds[i];
+      const heap_zone_attr *zone_attr = &zone->attrs[bound->attr_index];
+
+      if (bound->op == HEAP_ZONE_BOUND_IS_NULL)
+	{
+	  if (zone_attr->null_count == 0)
+	    {
+	      return true;
+	    }
+	  continue;
+	}
+
+      if (bound->op == HEAP_ZONE_BOUND_LIKE || bound->op == HEAP_ZONE_BOUND_REGEXP)
+	{
+	  if (zone_attr->value_count == 0)
+	    {
+	      /* nulls never match */
+	      return true;
+	    }
+	  // *INDENT-OFF*
+	  for (std::uint32_t trigram : bound->trigrams)
+	    {
+	      if (!heap_zone_signature_has (zone_attr, trigram))
+		{
+		  return true;
+		}
+	    }
+	  // *INDENT-ON*
+	  continue;
+	}
+
+      if (DB_IS_NULL (bound->value))
+	{
+	  continue;
+	}
+      if (zone_attr->value_count == 0)
+	{
+	  /* comparisons with nulls are never true */
+	  return true;
+	}
+
+      min_cmp = tp_value_compare (&zone_attr->min_value, bound->value, 1, 0);
+      max_cmp = tp_value_compare (&zone_attr->max_value, bound->value, 1, 0);
+      if (min_cmp == DB_UNK || max_cmp == DB_UNK)
+	{
+	  continue;
+	}
+
+      switch (bound->op)
+	{
+	case HEAP_ZONE_BOUND_EQ:
+	  if (min_cmp == DB_GT || max_cmp == DB_LT)
+	    {
+	      return true;
+	    }
+	  break;
+	case HEAP_ZONE_BOUND_LT:
+	  if (min_cmp != DB_LT)
+	    {
+	      return true;
+	    }
+	  break;
+	case HEAP_ZONE_BOUND_LE:
+	  if (min_cmp == DB_GT)
+	    {
+	      return true;
+	    }
+	  break;
+	case HEAP_ZONE_BOUND_GT:
+	  if (max_cmp != DB_GT)
+	    {
+	      return true;
+	    }
+	  break;
+	case HEAP_ZONE_BOUND_GE:
+	  if (max_cmp == DB_LT)
+	    {
+	      return true;
+	    }
+	  break;
+	default:
+	  assert (false);
+	  break;
+	}
+    }
+
+  return false;
+}
+
+/*
+ * heap_zone_build () - compute the summaries of a zone from all records of its pages
+ *
+ * return	    : error code
+ * thread_p (in)    : thread entry
+ * zone_scan (in)   : zone scan
+ * first_page (in)  : first page of zone in the pages of scan
+ * last_page (in)   : last page of zone in the pages of scan (inclusive)
+ * zone (out)	    : zone summaries
+ *
+ * NOTE: all records are read, whatever their visibility, since the zone is shared by all transactions. deleted
+ *	 objects are summarized too until they are vacuumed.
+ */
+static int
+heap_zone_build (THREAD_ENTRY * thread_p, heap_zone_scan * zone_scan, int first_page, int last_page, heap_zone * zone)
+{
+  PGBUF_WATCHER pg_watcher;
+  RECDES recdes, chain_recdes;
+  OID oid;
+  INT16 type;
+  int page, i;
+  int error_code = NO_ERROR;
+  heap_zone_map *map = zone_scan->map.get ();
+  // *INDENT-OFF*
+  std::vector<std::uint32_t> trigrams[HEAP_ZONE_MAP_MAX_ATTRS];
+  // *INDENT-ON*
+
+  zone->state = HEAP_ZONE_VALID;
+  for (i = 0; i < map->n_attrs; i++)
+    {
+      db_make_null (&zone->attrs[i].min_value);
+      db_make_null (&zone->attrs[i].max_value);
+      zone->attrs[i].null_count = 0;
+      zone->attrs[i].value_count = 0;
+      zone->attrs[i].trigram_bits.clear ();
+      zone->attrs[i].trigram_bits_set = 0;
+    }
+
+  if (!zone_scan->attr_info_inited)
+    {
+      error_code = heap_attrinfo_start (thread_p, &zone_scan->class_oid, map->n_attrs, map->attr_ids,
+					&zone_scan->attr_info);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  return error_code;
+	}
+      zone_scan->attr_info_inited = true;
+    }
+
+  PGBUF_INIT_WATCHER (&pg_watcher, PGBUF_ORDERED_HEAP_NORMAL, &zone_scan->hfid);
+
+  for (page = first_page; page <= last_page && zone->state == HEAP_ZONE_VALID; page++)
+    {
+      const VPID *vpid = &zone_scan->vpids[page];
+
+      if (pgbuf_ordered_fix (thread_p, vpid, OLD_PAGE_MAYBE_DEALLOCATED, PGBUF_LATCH_READ, &pg_watcher) != NO_ERROR)
+	{
+	  if (er_errid () == ER_PB_BAD_PAGEID)
+	    {
+	      /* page was deallocated */
+	      er_clear ();
+	      continue;
+	    }
+	  ASSERT_ERROR_AND_SET (error_code);
+	  return error_code;
+	}
+
+      if (pgbuf_get_page_ptype (thread_p, pg_watcher.pgptr) != PAGE_HEAP
+	  || spage_get_record (thread_p, pg_watcher.pgptr, HEAP_HEADER_AND_CHAIN_SLOTID, &chain_recdes,
+			       PEEK) != S_SUCCESS || !OID_EQ ((OID *) chain_recdes.data, &zone_scan->class_oid))
+	{
+	  /* page was reused by another file or class */
+	  pgbuf_ordered_unfix (thread_p, &pg_watcher);
+	  continue;
+	}
+
+      oid.volid = vpid->volid;
+      oid.pageid = vpid->pageid;
+      oid.slotid = HEAP_HEADER_AND_CHAIN_SLOTID;
+
+      while (spage_next_record (pg_watcher.pgptr, &oid.slotid, &recdes, PEEK) == S_SUCCESS)
+	{
+	  if (oid.slotid == HEAP_HEADER_AND_CHAIN_SLOTID)
+	    {
+	      continue;
+	    }
+
+	  type = spage_get_record_type (pg_watcher.pgptr, oid.slotid);
+	  if (type == REC_RELOCATION || type == REC_BIGONE)
+	    {
+	      /* attributes are stored in other pages; not worth reading them */
+	      zone->state = HEAP_ZONE_UNSKIPPABLE;
+	      break;
+	    }
+	  if (type != REC_HOME)
+	    {
+	      /* REC_NEWHOME records are summarized with their relocation records */
+	      continue;
+	    }
+
+	  error_code = heap_attrinfo_read_dbvalues (thread_p, &oid, &recdes, &zone_scan->attr_info);
+	  if (error_code != NO_ERROR)
+	    {
+	      ASSERT_ERROR ();
+	      pgbuf_ordered_unfix (thread_p, &pg_watcher);
+	      return error_code;
+	    }
+
+	  for (i = 0; i < map->n_attrs; i++)
+	    {
+	      DB_VALUE *value = heap_attrinfo_access (map->attr_ids[i], &zone_scan->attr_info);
+
+	      if (value == NULL
+		  || (!DB_IS_NULL (value) && !heap_zone_map_can_summarize (map->attr_types[i], DB_VALUE_TYPE (value))))
+		{
+		  zone->state = HEAP_ZONE_UNSKIPPABLE;
+		  break;
+		}
+	      if (heap_zone_map_is_trigram_type (map->attr_types[i]))
+		{
+		  heap_zone_add_string (&zone->attrs[i], value, trigrams[i]);
+		}
+	      else
+		{
+		  heap_zone_add_value (&zone->attrs[i], value);
+		}
+	    }
+	  if (zone->state != HEAP_ZONE_VALID)
+	    {
+	      break;
+	    }
+	}
+
+      pgbuf_ordered_unfix (thread_p, &pg_watcher);
+    }
+
+  if (zone->state == HEAP_ZONE_VALID)
+    {
+      for (i = 0; i < map->n_attrs; i++)
+	{
+	  if (heap_zone_map_is_trigram_type (map->attr_types[i]))
+	    {
+	      heap_zone_make_signature (&zone->attrs[i], trigrams[i]);
+	    }
+	}
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * heap_zone_scan_check_zone () - check if the zone of a group of pages can be skipped; the zone is built if needed
+ *
+ * return	    : error code
+ * thread_p (in)    : thread entry
+ * zone_scan (in)   : zone scan
+ * first_page (in)  : first page of zone in the pages of scan
+ * last_page (in)   : last page of zone in the pages of scan (inclusive)
+ * can_skip (out)   : true if the pages can be skipped
+ */
+static int
+heap_zone_scan_check_zone (THREAD_ENTRY * thread_p, heap_zone_scan * zone_scan, int first_page, int last_page,
+			   bool * can_skip)
+{
+  heap_zone_map *map = zone_scan->map.get ();
+  std::uint64_t key = map->get_zone_key (zone_scan->vpids[first_page]);
+  std::uint64_t modify_seq;
+  MVCCID built_mvccid;
+  heap_zone new_zone;
+  int error_code;
+
+  *can_skip = false;
+
+  {
+    std::unique_lock<std::mutex> ulock (map->mutex);
+
+    if (map->attrs_version != zone_scan->attrs_version)
+      {
+	/* attributes were added after the scan started; bounds may point to other attributes */
+	return NO_ERROR;
+      }
+
+    // *INDENT-OFF*
+    auto it = map->zones.find (key);
+    // *INDENT-ON*
+    if (it != map->zones.end ())
+      {
+	const heap_zone &zone = it->second;
+
+	if (zone.state == HEAP_ZONE_VALID)
+	  {
+	    /* the snapshot must see all updates summarized by the zone */
+	    if (MVCC_ID_PRECEDES (zone.built_mvccid, zone_scan->snapshot->lowest_active_mvccid))
+	      {
+		*can_skip = heap_zone_can_skip (zone_scan, &zone);
+	      }
+	    return NO_ERROR;
+	  }
+	if (zone.state == HEAP_ZONE_UNSKIPPABLE || zone.modify_seq > zone_scan->start_seq)
+	  {
+	    /* objects may have been added to pages that this scan does not know */
+	    return NO_ERROR;
+	  }
+	modify_seq = zone.modify_seq;
+	built_mvccid = MAX (zone.update_mvccid, map->create_mvccid);
+      }
+    else
+      {
+	modify_seq = 0;
+	built_mvccid = map->create_mvccid;
+      }
+
+    if (built_mvccid == MVCCID_NULL || !MVCC_ID_PRECEDES (built_mvccid, zone_scan->snapshot->lowest_active_mvccid))
+      {
+	/* last versions of objects may not be the ones seen by all snapshots; wait for updaters to complete */
+	return NO_ERROR;
+      }
+  }
+
+  error_code = heap_zone_build (thread_p, zone_scan, first_page, last_page, &new_zone);
+  if (error_code != NO_ERROR)
+    {
+      return error_code;
+    }
+
+  std::unique_lock<std::mutex> ulock (map->mutex);
+
+  if (map->attrs_version != zone_scan->attrs_version)
+    {
+      return NO_ERROR;
+    }
+
+  heap_zone &zone = map->zones[key];
+  if (zone.modify_seq != modify_seq || zone.state != HEAP_ZONE_UNKNOWN)
+    {
+      /* zone was modified or built by someone else meanwhile */
+      return NO_ERROR;
+    }
+
+  new_zone.modify_seq = zone.modify_seq;
+  new_zone.update_mvccid = zone.update_mvccid;
+  new_zone.built_mvccid = built_mvccid;
+  zone = new_zone;
+
+  if (zone.state == HEAP_ZONE_VALID)
+    {
+      *can_skip = heap_zone_can_skip (zone_scan, &zone);
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * heap_zone_scan_create () - start a page by page scan of the heap that skips zones not satisfying the bounds
+ *
+ * return	       : error code
+ * thread_p (in)       : thread entry
+ * hfid (in)	       : heap file
+ * class_oid (in)      : class of heap
+ * snapshot (in)       : snapshot of scan; must be taken before the scan is created
+ * bounds (in)	       : terms of scan predicate
+ * n_bounds (in)       : number of bounds
+ * zone_scan_out (out) : zone scan or NULL if zone maps are not used
+ *
+ * NOTE: the attributes of bounds are registered in the zone map of the heap.
+ */
+int
+heap_zone_scan_create (THREAD_ENTRY * thread_p, const HFID * hfid, const OID * class_oid, MVCC_SNAPSHOT * snapshot,
+		       const HEAP_ZONE_BOUND * bounds, int n_bounds, HEAP_ZONE_SCAN ** zone_scan_out)
+{
+  heap_zone_scan *zone_scan = NULL;
+  int zone_pages = prm_get_integer_value (PRM_ID_HEAP_ZONE_MAP_PAGES);
+  int i, attr_index;
+  int error_code = NO_ERROR;
+
+  assert (snapshot != NULL);
+
+  *zone_scan_out = NULL;
+
+  if (zone_pages <= 0 || n_bounds <= 0)
+    {
+      return NO_ERROR;
+    }
+
+  for (i = 0; i < n_bounds; i++)
+    {
+      if (heap_zone_bound_is_usable (&bounds[i]))
+	{
+	  break;
+	}
+    }
+  if (i == n_bounds)
+    {
+      return NO_ERROR;
+    }
+
+  zone_scan = new heap_zone_scan ();
+  zone_scan->map = heap_zone_map_find_or_create (&hfid->vfid, class_oid, zone_pages);
+  zone_scan->hfid = *hfid;
+  zone_scan->class_oid = *class_oid;
+  zone_scan->snapshot = snapshot;
+  zone_scan->vpids = NULL;
+  zone_scan->page_count = 0;
+  zone_scan->n_bounds = 0;
+  zone_scan->attr_info_inited = false;
+
+  {
+    heap_zone_map *map = zone_scan->map.get ();
+    std::unique_lock<std::mutex> ulock (map->mutex);
+
+    for (i = 0; i < n_bounds && zone_scan->n_bounds < HEAP_ZONE_MAP_MAX_ATTRS * 2; i++)
+      {
+	heap_zone_scan_bound *scan_bound = &zone_scan->bounds[zone_scan->n_bounds];
+
+	if (!heap_zone_bound_is_usable (&bounds[i]))
+	  {
+	    continue;
+	  }
+
+	scan_bound->trigrams.clear ();
+	if (bounds[i].op == HEAP_ZONE_BOUND_LIKE)
+	  {
+	    heap_zone_like_trigrams (bounds[i].value, bounds[i].escape, scan_bound->trigrams);
+	  }
+	else if (bounds[i].op == HEAP_ZONE_BOUND_REGEXP)
+	  {
+	    heap_zone_regexp_trigrams (bounds[i].value, bounds[i].is_case_sensitive, scan_bound->trigrams);
+	  }
+	if ((bounds[i].op == HEAP_ZONE_BOUND_LIKE || bounds[i].op == HEAP_ZONE_BOUND_REGEXP)
+	    && scan_bound->trigrams.empty ())
+	  {
+	    /* the pattern has no literal of three characters */
+	    continue;
+	  }
+
+	attr_index = map->find_attr (bounds[i].attrid);
+	if (attr_index < 0 && map->n_attrs < HEAP_ZONE_MAP_MAX_ATTRS)
+	  {
+	    /* new attribute; all zones must be built again */
+	    attr_index = map->n_attrs++;
+	    map->attr_ids[attr_index] = bounds[i].attrid;
+	    map->attr_types[attr_index] = bounds[i].type;
+	    map->attrs_version++;
+	    // *INDENT-OFF*
+	    for (auto &it : map->zones)
+	      {
+		if (it.second.state == HEAP_ZONE_VALID)
+		  {
+		    it.second.state = HEAP_ZONE_UNKNOWN;
+		  }
+	      }
+	    // *INDENT-ON*
+	  }
+	if (attr_index < 0 || map->attr_types[attr_index] != bounds[i].type)
+	  {
+	    continue;
+	  }
+
+	scan_bound->attr_index = attr_index;
+	scan_bound->op = bounds[i].op;
+	scan_bound->value = bounds[i].value;
+	zone_scan->n_bounds++;
+      }
+
+    /* pages allocated after the sequence is read can only hold objects inserted after it */
+    zone_scan->start_seq = map->modify_seq;
+    zone_scan->attrs_version = map->attrs_version;
+  }
+
+  if (zone_scan->n_bounds == 0)
+    {
+      heap_zone_scan_destroy (thread_p, zone_scan);
+      return NO_ERROR;
+    }
+
+  error_code = file_get_user_page_vpids (thread_p, &zone_scan->hfid.vfid, &zone_scan->vpids, &zone_scan->page_count);
+  if (error_code != NO_ERROR)
+    {
+      ASSERT_ERROR ();
+      heap_zone_scan_destroy (thread_p, zone_scan);
+      return error_code;
+    }
+
+  // *INDENT-OFF*
+  std::sort (zone_scan->vpids, zone_scan->vpids + zone_scan->page_count, [] (const VPID &a, const VPID &b)
+    {
+      return a.volid < b.volid || (a.volid == b.volid && a.pageid < b.pageid);
+    });
+  // *INDENT-ON*
+
+  heap_zone_scan_reset (zone_scan, true);
+
+  *zone_scan_out = zone_scan;
+  return NO_ERROR;
+}
+
+/*
+ * heap_zone_scan_destroy () - end zone scan
+ */
+void
+heap_zone_scan_destroy (THREAD_ENTRY * thread_p, HEAP_ZONE_SCAN * zone_scan)
+{
+  if (zone_scan->attr_info_inited)
+    {
+      heap_attrinfo_end (thread_p, &zone_scan->attr_info);
+    }
+  if (zone_scan->vpids != NULL)
+    {
+      db_private_free (thread_p, zone_scan->vpids);
+    }
+  delete zone_scan;
+}
+
+/*
+ * heap_zone_scan_reset () - restart zone scan from first page in the given direction
+ */
+void
+heap_zone_scan_reset (HEAP_ZONE_SCAN * zone_scan, bool forward)
+{
+  zone_scan->forward = forward;
+  zone_scan->next_page = forward ? 0 : zone_scan->page_count - 1;
+  zone_scan->group_end = zone_scan->next_page;
+}
+
+/*
+ * heap_zone_scan_next_page () - get next page to scan
+ *
+ * return	      : S_SUCCESS, S_END or S_ERROR
+ * thread_p (in)      : thread entry
+ * zone_scan (in)     : zone scan
+ * can_skip (in)      : false if all pages must be returned
+ * vpid (out)	      : next page
+ * skipped_pages (in/out) : incremented with the number of skipped pages
+ *
+ * NOTE: the caller must not keep heap pages fixed; pages of next zone may be read to build it.
+ */
+SCAN_CODE
+heap_zone_scan_next_page (THREAD_ENTRY * thread_p, HEAP_ZONE_SCAN * zone_scan, bool can_skip, VPID * vpid,
+			  int *skipped_pages)
+{
+  int step = zone_scan->forward ? 1 : -1;
+  int group_start, first_page, last_page;
+  bool skip;
+  std::uint64_t key;
+
+  while (zone_scan->next_page >= 0 && zone_scan->next_page < zone_scan->page_count)
+    {
+      if (zone_scan->next_page != zone_scan->group_end)
+	{
+	  /* inside the zone being scanned */
+	  *vpid = zone_scan->vpids[zone_scan->next_page];
+	  zone_scan->next_page += step;
+	  return S_SUCCESS;
+	}
+
+      /* first page of a new zone; find all its pages */
+      group_start = zone_scan->next_page;
+      key = zone_scan->map->get_zone_key (zone_scan->vpids[group_start]);
+      for (zone_scan->group_end = group_start + step;
+	   zone_scan->group_end >= 0 && zone_scan->group_end < zone_scan->page_count
+	   && zone_scan->map->get_zone_key (zone_scan->vpids[zone_scan->group_end]) == key;
+	   zone_scan->group_end += step)
+	{
+	  ;
+	}
+
+      skip = false;
+      if (can_skip)
+	{
+	  first_page = MIN (group_start, zone_scan->group_end - step);
+	  last_page = MAX (group_start, zone_scan->group_end - step);
+	  if (heap_zone_scan_check_zone (thread_p, zone_scan, first_page, last_page, &skip) != NO_ERROR)
+	    {
+	      return S_ERROR;
+	    }
+	}
+
+      if (skip)
+	{
+	  *skipped_pages += (zone_scan->group_end - group_start) * step;
+	  zone_scan->next_page = zone_scan->group_end;
+	  continue;
+	}
+
+      *vpid = zone_scan->vpids[zone_scan->next_page];
+      zone_scan->next_page += step;
+      return S_SUCCESS;
+    }
+
+  return S_END;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+//
+// heap_zone_map - min/max summaries of ranges of heap pages, used by heap scans to skip pages
+//
+//  a zone is a range of heap_zone_map_pages consecutive pages of a volume. for each zone, the zone map of a heap file
+//  keeps the minimum and maximum value and the number of nulls of a few attributes. the attributes are selected by
+//  the scans: the attributes compared with constants in scan predicates are registered in the zone map of the heap,
+//  up to HEAP_ZONE_MAP_MAX_ATTRS.
+//
+//  zone maps live in memory only. a zone is built by the first scan that reads it and is invalidated by every insert
+//  and update of its pages and by vacuum; the next scan rebuilds it. scans skip the zones that cannot hold objects
+//  satisfying the predicate. attributes of fixed size types (numbers and date/time types) are summarized by their
+//  minimum and maximum.
+//
+//  string attributes searched by LIKE and REGEXP are summarized by the trigrams of their values: the zone keeps a
+//  signature with two bits set for each distinct trigram (three consecutive bytes, ascii letters in lower case), sized
+//  to about eight bits per trigram. it works as an inverted index from trigrams to zones: the literals that a match of
+//  the pattern must contain ('abc' and 'de' in '%abc%de_%') give the trigrams that every candidate zone must have, and
+//  the zones missing one of them are skipped. the objects of the other zones are checked by the scan predicate.
+//
+//  the summary of a zone is computed from the last versions of its objects. scans with snapshots that may see older
+//  versions don't use the zone: the zone remembers the latest transaction that updated its objects and it is used
+//  only by snapshots where that transaction is completed.
+//
+
+#ifndef _HEAP_ZONE_MAP_HPP_
+#define _HEAP_ZONE_MAP_HPP_
+
+#if !defined (SERVER_MODE) && !defined (SA_MODE)
+#error Wrong module
+#endif // not server and not SA mode
+
+#include "dbtype_def.h"
+#include "storage_common.h"
+#include "thread_compat.hpp"
+
+// forward definitions
+struct mvcc_snapshot;
+struct heap_zone_scan;
+
+#define HEAP_ZONE_MAP_MAX_ATTRS 4
+
+typedef enum
+{
+  HEAP_ZONE_BOUND_EQ,		/* attr = value */
+  HEAP_ZONE_BOUND_LT,		/* attr < value */
+  HEAP_ZONE_BOUND_LE,		/* attr <= value */
+  HEAP_ZONE_BOUND_GT,		/* attr > value */
+  HEAP_ZONE_BOUND_GE,		/* attr >= value */
+  HEAP_ZONE_BOUND_IS_NULL,	/* attr IS NULL */
+  HEAP_ZONE_BOUND_LIKE,		/* attr LIKE value, with a binary collation */
+  HEAP_ZONE_BOUND_REGEXP	/* attr REGEXP value */
+} HEAP_ZONE_BOUND_OP;
+
+/* a term of the scan predicate that objects must satisfy */
+typedef struct heap_zone_bound HEAP_ZONE_BOUND;
+struct heap_zone_bound
+{
+  ATTR_ID attrid;		/* attribute identifier */
+  DB_TYPE type;			/* attribute type */
+  HEAP_ZONE_BOUND_OP op;	/* comparison operator */
+  const DB_VALUE *value;	/* value compared with attribute; not used for HEAP_ZONE_BOUND_IS_NULL */
+  const DB_VALUE *escape;	/* escape character of HEAP_ZONE_BOUND_LIKE, NULL if none */
+  bool is_case_sensitive;	/* HEAP_ZONE_BOUND_REGEXP only */
+};
+
+typedef struct heap_zone_scan HEAP_ZONE_SCAN;
+
+/* zone map maintenance */
+extern void heap_zone_map_notify_insert (THREAD_ENTRY * thread_p, const VFID * vfid, const OID * oid);
+extern void heap_zone_map_notify_update (THREAD_ENTRY * thread_p, const VFID * vfid, const OID * oid);
+extern void heap_zone_map_notify_vacuum (THREAD_ENTRY * thread_p, const VFID * vfid, const VPID * vpid);
+extern void heap_zone_map_drop (const VFID * vfid);
+extern double heap_zone_map_get_width (const VFID * vfid, ATTR_ID attrid);
+extern void heap_zone_map_final (void);
+
+/* page by page scan skipping zones */
+extern int heap_zone_scan_create (THREAD_ENTRY * thread_p, const HFID * hfid, const OID * class_oid,
+				  mvcc_snapshot * snapshot, const HEAP_ZONE_BOUND * bounds, int n_bounds,
+				  HEAP_ZONE_SCAN ** zone_scan_out);
+extern void heap_zone_scan_destroy (THREAD_ENTRY * thread_p, HEAP_ZONE_SCAN * zone_scan);
+extern void heap_zone_scan_reset (HEAP_ZONE_SCAN * zone_scan, bool forward);
+extern SCAN_CODE heap_zone_scan_next_page (THREAD_ENTRY * thread_p, HEAP_ZONE_SCAN * zone_scan, bool can_skip,
+					   VPID * vpid, int *skipped_pages);
+
+#endif // _HEAP_ZONE_MAP_HPP_
@@ -109,7 +109,7 @@ overflow_insert (THREAD_ENTRY * thread_p, const VFID * ovf_vfid, VPID * ovf_vpid
   /*
    * Guess the number of pages. The total number of pages is found by dividing length by page size - the smallest
    * header. Then, we make sure that this estimate is correct. */
-  length = recdes->length - (DB_PAGESIZE - (int) offsetof (OVERFLOW_FIRST_PART, data));
+  length = recdes->length - OVERFLOW_FIRST_PART_DATA_SIZE;
   if (length > 0)
     {
       i = DB_PAGESIZE - offsetof (OVERFLOW_REST_PART, data);
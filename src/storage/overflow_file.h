@@ -42,6 +42,9 @@ struct overflow_first_part
   char data[1];			/* Really more than one */
 };
 
+/* bytes of overflow data stored on the first page */
+#define OVERFLOW_FIRST_PART_DATA_SIZE (DB_PAGESIZE - (int) offsetof (OVERFLOW_FIRST_PART, data))
+
 typedef struct overflow_rest_part OVERFLOW_REST_PART;
 struct overflow_rest_part
 {
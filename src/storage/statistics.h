@@ -47,6 +47,9 @@
 
 #define STATS_MAX_PRECISION	4000	/* max precision of char for getting statistics */
 
+#define STATS_MAX_FREQUENT_VALUES 8	/* most frequent values kept for the first column of an index */
+#define STATS_MAX_CARDINALITY_FEEDBACK 16	/* predicates of a class with a selectivity measured by the scans */
+
 /* free_and_init routine */
 #define stats_free_statistics_and_init(stats) \
   do \
@@ -77,6 +80,22 @@ struct btree_stats
 #endif
 };
 
+/* A frequent value of an attribute and the fraction of the objects having it */
+typedef struct attr_freq_value ATTR_FREQ_VALUE;
+struct attr_freq_value
+{
+  DB_VALUE value;
+  double fraction;
+};
+
+/* Selectivity of the predicates of a heap scan, measured by the executions of the plans scanning the class */
+typedef struct stats_card_feedback STATS_CARD_FEEDBACK;
+struct stats_card_feedback
+{
+  unsigned int pred_hash;	/* shape of the predicates, see qo_node_predicate_hash () */
+  double selectivity;		/* fraction of the scanned objects qualified by the predicates */
+};
+
 /* Statistical Information about the attribute */
 typedef struct attr_stats ATTR_STATS;
 struct attr_stats
@@ -86,6 +105,9 @@ struct attr_stats
   int n_btstats;		/* number of B+tree statistics information */
   BTREE_STATS *bt_stats;	/* pointer to array of BTREE_STATS[n_btstats] */
   INT64 ndv;			/* Number of Distinct Values of column */
+  double zone_map_width;	/* average fraction of the value range covered by a zone; 1 without zone map */
+  int n_freq_values;		/* number of frequent values */
+  ATTR_FREQ_VALUE *freq_values;	/* values much more frequent than 1 / ndv, most frequent first */
 };
 
 /* Statistical Information about the class */
@@ -97,6 +119,8 @@ struct class_stats
   int heap_num_pages;		/* number of pages the class occupy */
   int n_attrs;			/* number of attributes; size of the attr_stats[] */
   ATTR_STATS *attr_stats;	/* pointer to the array of attribute statistics */
+  int n_feedback;		/* number of predicates with a measured selectivity */
+  STATS_CARD_FEEDBACK *feedback;	/* selectivity of the predicates far from the estimates */
 };
 
 /* Statistical Information about the attribute NDV */
@@ -105,6 +129,8 @@ struct attr_ndv
 {
   int id;			/* column id */
   INT64 ndv;			/* Number of Distinct Values of column */
+  int n_freq_values;		/* number of frequent values */
+  ATTR_FREQ_VALUE *freq_values;	/* values much more frequent than 1 / ndv, most frequent first */
 };
 
 typedef struct class_attr_ndv CLASS_ATTR_NDV;
@@ -123,6 +149,7 @@ extern void stats_ndv_dump (const char *classname, FILE * fp);
 extern char *stats_make_select_list_for_ndv (const MOP class_mop, ATTR_NDV ** attr_ndv);
 extern int stats_get_ndv_by_query (const MOP class_mop, CLASS_ATTR_NDV * class_attr_ndv, FILE * file_p,
 				   int with_fullscan);
+extern void stats_free_class_attr_ndv (CLASS_ATTR_NDV * class_attr_ndv);
 #endif /* !SERVER_MODE */
 STATIC_INLINE int stats_adjust_sampling_weight (INT64 sampling_ndv, int sampling_weight)
   __attribute__ ((ALWAYS_INLINE));
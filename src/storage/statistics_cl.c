@@ -33,12 +33,17 @@
 #include "work_space.h"
 #include "schema_manager.h"
 #include "network_interface_cl.h"
+#include "system_parameter.h"
 #include "tz_support.h"
 #include "db_date.h"
 #include "db.h"
 #include "dbtype_function.h"
 
 static CLASS_STATS *stats_client_unpack_statistics (char *buffer);
+static int stats_get_frequent_values_by_query (const MOP class_mop, CLASS_ATTR_NDV * class_attr_ndv, FILE * file_p,
+					       int with_fullscan);
+static int stats_get_frequent_values_of_attribute (const char *class_name_p, const char *attr_name_p,
+						   ATTR_NDV * attr_ndv, FILE * file_p, int with_fullscan);
 
 /*
  * stats_get_statistics () - Get class statistics
@@ -100,6 +105,9 @@ stats_client_unpack_statistics (char *buf_p)
       return NULL;
     }
 
+  class_stats_p->n_feedback = 0;
+  class_stats_p->feedback = NULL;
+
   class_stats_p->time_stamp = (unsigned int) OR_GET_INT (buf_p);
   buf_p += OR_INT_SIZE;
 
@@ -139,6 +147,7 @@ stats_client_unpack_statistics (char *buf_p)
       db_ws_free (class_stats_p);
       return NULL;
     }
+  memset (class_stats_p->attr_stats, 0, class_stats_p->n_attrs * sizeof (ATTR_STATS));
 
   for (i = 0, attr_stats_p = class_stats_p->attr_stats; i < class_stats_p->n_attrs; i++, attr_stats_p++)
     {
@@ -154,6 +163,30 @@ stats_client_unpack_statistics (char *buf_p)
       OR_GET_INT64 (buf_p, &attr_stats_p->ndv);
       buf_p += OR_INT64_SIZE;
 
+      OR_GET_DOUBLE (buf_p, &attr_stats_p->zone_map_width);
+      buf_p += OR_DOUBLE_SIZE;
+
+      attr_stats_p->n_freq_values = OR_GET_INT (buf_p);
+      buf_p += OR_INT_SIZE;
+
+      if (attr_stats_p->n_freq_values > 0)
+	{
+	  attr_stats_p->freq_values =
+	    (ATTR_FREQ_VALUE *) db_ws_alloc (attr_stats_p->n_freq_values * sizeof (ATTR_FREQ_VALUE));
+	  if (attr_stats_p->freq_values == NULL)
+	    {
+	      attr_stats_p->n_freq_values = 0;
+	      stats_free_statistics (class_stats_p);
+	      return NULL;
+	    }
+
+	  for (j = 0; j < attr_stats_p->n_freq_values; j++)
+	    {
+	      buf_p = or_unpack_value (buf_p, &attr_stats_p->freq_values[j].value);
+	      buf_p = or_unpack_double (buf_p, &attr_stats_p->freq_values[j].fraction);
+	    }
+	}
+
       if (attr_stats_p->n_btstats <= 0)
 	{
 	  attr_stats_p->bt_stats = NULL;
@@ -224,6 +257,29 @@ stats_client_unpack_statistics (char *buf_p)
 	}
     }
 
+  class_stats_p->n_feedback = OR_GET_INT (buf_p);
+  buf_p += OR_INT_SIZE;
+  if (class_stats_p->n_feedback > 0)
+    {
+      class_stats_p->feedback =
+	(STATS_CARD_FEEDBACK *) db_ws_alloc (class_stats_p->n_feedback * sizeof (STATS_CARD_FEEDBACK));
+      if (class_stats_p->feedback == NULL)
+	{
+	  class_stats_p->n_feedback = 0;
+	  stats_free_statistics (class_stats_p);
+	  return NULL;
+	}
+
+      for (i = 0; i < class_stats_p->n_feedback; i++)
+	{
+	  class_stats_p->feedback[i].pred_hash = (unsigned int) OR_GET_INT (buf_p);
+	  buf_p += OR_INT_SIZE;
+
+	  OR_GET_DOUBLE (buf_p, &class_stats_p->feedback[i].selectivity);
+	  buf_p += OR_DOUBLE_SIZE;
+	}
+    }
+
   /* validate key stats info */
   assert (class_stats_p->heap_num_objects >= 0);
   for (i = 0, attr_stats_p = class_stats_p->attr_stats; i < class_stats_p->n_attrs; i++, attr_stats_p++)
@@ -274,11 +330,28 @@ stats_free_statistics (CLASS_STATS * class_statsp)
 		  db_ws_free (attr_statsp->bt_stats);
 		  attr_statsp->bt_stats = NULL;
 		}
+
+	      if (attr_statsp->freq_values)
+		{
+		  for (j = 0; j < attr_statsp->n_freq_values; j++)
+		    {
+		      pr_clear_value (&attr_statsp->freq_values[j].value);
+		    }
+
+		  db_ws_free (attr_statsp->freq_values);
+		  attr_statsp->freq_values = NULL;
+		}
 	    }
 	  db_ws_free (class_statsp->attr_stats);
 	  class_statsp->attr_stats = NULL;
 	}
 
+      if (class_statsp->feedback)
+	{
+	  db_ws_free (class_statsp->feedback);
+	  class_statsp->feedback = NULL;
+	}
+
       db_ws_free (class_statsp);
     }
 }
@@ -328,6 +401,16 @@ stats_dump (const char *class_name_p, FILE * file_p)
   fprintf (file_p, " Total pages in class heap: %d\n", class_stats_p->heap_num_pages);
   fprintf (file_p, " Total objects: %d\n", class_stats_p->heap_num_objects);
   fprintf (file_p, " Number of attributes: %d\n", class_stats_p->n_attrs);
+  if (class_stats_p->n_feedback > 0)
+    {
+      fprintf (file_p, " Measured selectivity of predicates:");
+      for (i = 0; i < class_stats_p->n_feedback; i++)
+	{
+	  fprintf (file_p, " %08x (%.4f%%)", class_stats_p->feedback[i].pred_hash,
+		   class_stats_p->feedback[i].selectivity * 100);
+	}
+      fprintf (file_p, "\n");
+    }
 
   for (i = 0; i < class_stats_p->n_attrs; i++)
     {
@@ -338,6 +421,18 @@ stats_dump (const char *class_name_p, FILE * file_p)
       fprintf (file_p, "%s)\n", pr_type_name (attr_stats_p->type));
       fprintf (file_p, "    Number of Distinct Values: %ld\n", attr_stats_p->ndv);
 
+      if (attr_stats_p->n_freq_values > 0)
+	{
+	  fprintf (file_p, "    Frequent values:");
+	  for (j = 0; j < attr_stats_p->n_freq_values; j++)
+	    {
+	      fprintf (file_p, " ");
+	      db_value_fprint (file_p, &attr_stats_p->freq_values[j].value);
+	      fprintf (file_p, " (%.2f%%)", attr_stats_p->freq_values[j].fraction * 100);
+	    }
+	  fprintf (file_p, "\n");
+	}
+
       if (attr_stats_p->n_btstats > 0)
 	{
 	  fprintf (file_p, "    B+tree statistics:\n");
@@ -408,10 +503,7 @@ stats_ndv_dump (const char *class_name_p, FILE * file_p)
   fprintf (file_p, "\n");
 
 end:
-  if (class_attr_ndv.attr_ndv != NULL)
-    {
-      free_and_init (class_attr_ndv.attr_ndv);
-    }
+  stats_free_class_attr_ndv (&class_attr_ndv);
   return;
 }
 
@@ -445,8 +537,7 @@ stats_get_ndv_by_query (const MOP class_mop, CLASS_ATTR_NDV * class_attr_ndv, FI
        * class; just set to 0 and return. */
       class_attr_ndv->attr_cnt = 0;
       class_attr_ndv->attr_ndv = (ATTR_NDV *) malloc (sizeof (ATTR_NDV));
-      class_attr_ndv->attr_ndv[0].ndv = 0;
-      class_attr_ndv->attr_ndv[0].id = 0;
+      memset (class_attr_ndv->attr_ndv, 0, sizeof (ATTR_NDV));
       goto end;
     }
 
@@ -466,6 +557,7 @@ stats_get_ndv_by_query (const MOP class_mop, CLASS_ATTR_NDV * class_attr_ndv, FI
     {
       return ER_FAILED;
     }
+  memset (class_attr_ndv->attr_ndv, 0, sizeof (ATTR_NDV) * (class_attr_ndv->attr_cnt + 1));
 
   select_list = stats_make_select_list_for_ndv (class_mop, &class_attr_ndv->attr_ndv);
   if (select_list == NULL)
@@ -531,6 +623,12 @@ stats_get_ndv_by_query (const MOP class_mop, CLASS_ATTR_NDV * class_attr_ndv, FI
     }
   class_attr_ndv->attr_ndv[i].ndv = DB_GET_BIGINT (&value);
 
+  /* frequent values make plans depend on the values of host variables (see max_plan_cache_variants) */
+  if (prm_get_integer_value (PRM_ID_XASL_CACHE_MAX_PLAN_VARIANTS) > 0)
+    {
+      error = stats_get_frequent_values_by_query (class_mop, class_attr_ndv, file_p, with_fullscan);
+    }
+
 end:
   if (select_list)
     {
@@ -549,6 +647,215 @@ end:
   return error;
 }
 
+/*
+ * stats_get_frequent_values_by_query () - get the most frequent values of the first columns of the indexes
+ *   return: error code
+ *   class_mop(in): class
+ *   class_attr_ndv(in/out): NDV of the columns; the frequent values are added to the columns
+ *   file_p(in): the queries are printed if not NULL
+ *   with_fullscan(in):
+ *
+ * Note: Only the first columns of non-unique indexes are gathered. When such a column is compared with a host
+ *       variable, the best plan may depend on the value (see do_get_plan_variant).
+ */
+static int
+stats_get_frequent_values_by_query (const MOP class_mop, CLASS_ATTR_NDV * class_attr_ndv, FILE * file_p,
+				    int with_fullscan)
+{
+  DB_CONSTRAINT *cons;
+  DB_CONSTRAINT_TYPE cons_type;
+  DB_ATTRIBUTE **cons_attrs;
+  DB_DOMAIN *dom;
+  ATTR_NDV *attr_ndv;
+  const char *class_name_p;
+  int i, error = NO_ERROR;
+
+  class_name_p = db_get_class_name (class_mop);
+  if (class_name_p == NULL)
+    {
+      return NO_ERROR;
+    }
+
+  for (cons = db_get_constraints (class_mop); cons != NULL; cons = db_constraint_next (cons))
+    {
+      cons_type = db_constraint_type (cons);
+      if ((cons_type != DB_CONSTRAINT_INDEX && cons_type != DB_CONSTRAINT_REVERSE_INDEX
+	   && cons_type != DB_CONSTRAINT_FOREIGN_KEY) || cons->func_index_info != NULL)
+	{
+	  /* unique keys have no frequent values */
+	  continue;
+	}
+
+      cons_attrs = db_constraint_attributes (cons);
+      if (cons_attrs == NULL || cons_attrs[0] == NULL)
+	{
+	  continue;
+	}
+
+      attr_ndv = NULL;
+      for (i = 0; i < class_attr_ndv->attr_cnt; i++)
+	{
+	  if (class_attr_ndv->attr_ndv[i].id == db_attribute_id (cons_attrs[0]))
+	    {
+	      attr_ndv = &class_attr_ndv->attr_ndv[i];
+	      break;
+	    }
+	}
+      if (attr_ndv == NULL || attr_ndv->ndv <= 1 || attr_ndv->freq_values != NULL)
+	{
+	  /* not gathered, a single value, or already gathered for another index */
+	  continue;
+	}
+
+      dom = db_attribute_domain (cons_attrs[0]);
+      if (TP_IS_SET_TYPE (TP_DOMAIN_TYPE (dom)) || TP_DOMAIN_TYPE (dom) == DB_TYPE_OBJECT)
+	{
+	  continue;
+	}
+
+      error = stats_get_frequent_values_of_attribute (class_name_p, db_attribute_name (cons_attrs[0]), attr_ndv,
+						      file_p, with_fullscan);
+      if (error != NO_ERROR)
+	{
+	  break;
+	}
+    }
+
+  return error;
+}
+
+/*
+ * stats_get_frequent_values_of_attribute () - get the most frequent values of a column
+ *   return: error code
+ *   class_name_p(in):
+ *   attr_name_p(in):
+ *   attr_ndv(in/out): NDV of the column; gets the frequent values
+ *   file_p(in): the query is printed if not NULL
+ *   with_fullscan(in):
+ *
+ * Note: The fraction of a value is its count over the rows of the sample. A value is frequent if it is held by more
+ *       than four times the rows of an average value.
+ */
+static int
+stats_get_frequent_values_of_attribute (const char *class_name_p, const char *attr_name_p, ATTR_NDV * attr_ndv,
+					FILE * file_p, int with_fullscan)
+{
+  const char *query;
+  char *query_buf = NULL;
+  int buf_size;
+  DB_QUERY_RESULT *query_result = NULL;
+  DB_QUERY_ERROR query_error;
+  DB_VALUE value, count, total;
+  double fraction;
+  int error = NO_ERROR;
+
+  query = "SELECT [v], CAST ([c] AS DOUBLE), CAST ([s] AS DOUBLE) "
+    "FROM (SELECT [v], [c], SUM ([c]) OVER () [s] "
+    "FROM (SELECT %s[%s] [v], COUNT (*) [c] FROM [%s] GROUP BY [%s]) [g]) [h] "
+    "WHERE [v] IS NOT NULL ORDER BY 2 DESC LIMIT %d";
+
+  buf_size = strlen (query) + 2 * strlen (attr_name_p) + strlen (class_name_p) + 40;
+  query_buf = (char *) malloc (buf_size);
+  if (query_buf == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) buf_size);
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+  snprintf (query_buf, buf_size, query, (with_fullscan == STATS_WITH_FULLSCAN) ? "" : "/*+ SAMPLING_SCAN */ ",
+	    attr_name_p, class_name_p, attr_name_p, STATS_MAX_FREQUENT_VALUES);
+
+  if (file_p != NULL)
+    {
+      fprintf (file_p, "Query : %s\n", query_buf);
+    }
+
+  error = db_compile_and_execute_local (query_buf, &query_result, &query_error);
+  if (error < NO_ERROR)
+    {
+      goto end;
+    }
+  error = NO_ERROR;
+
+  if (db_query_first_tuple (query_result) != DB_CURSOR_SUCCESS)
+    {
+      /* no values */
+      goto end;
+    }
+
+  attr_ndv->freq_values = (ATTR_FREQ_VALUE *) malloc (STATS_MAX_FREQUENT_VALUES * sizeof (ATTR_FREQ_VALUE));
+  if (attr_ndv->freq_values == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1,
+	      STATS_MAX_FREQUENT_VALUES * sizeof (ATTR_FREQ_VALUE));
+      error = ER_OUT_OF_VIRTUAL_MEMORY;
+      goto end;
+    }
+
+  do
+    {
+      if (db_query_get_tuple_value (query_result, 0, &value) != NO_ERROR
+	  || db_query_get_tuple_value (query_result, 1, &count) != NO_ERROR
+	  || db_query_get_tuple_value (query_result, 2, &total) != NO_ERROR)
+	{
+	  ASSERT_ERROR_AND_SET (error);
+	  goto end;
+	}
+
+      fraction = (db_get_double (&total) > 0) ? db_get_double (&count) / db_get_double (&total) : 0;
+      if (fraction * attr_ndv->ndv <= 4.0)
+	{
+	  /* the values are sorted by their count, the others are not frequent either */
+	  pr_clear_value (&value);
+	  break;
+	}
+
+      attr_ndv->freq_values[attr_ndv->n_freq_values].value = value;
+      attr_ndv->freq_values[attr_ndv->n_freq_values].fraction = MIN (fraction, 1.0);
+      attr_ndv->n_freq_values++;
+    }
+  while (attr_ndv->n_freq_values < STATS_MAX_FREQUENT_VALUES
+	 && db_query_next_tuple (query_result) == DB_CURSOR_SUCCESS);
+
+end:
+  if (query_result != NULL)
+    {
+      db_query_end (query_result);
+    }
+  free_and_init (query_buf);
+
+  return error;
+}
+
+/*
+ * stats_free_class_attr_ndv () - free the NDV and the frequent values of the columns of a class
+ *   return:
+ *   class_attr_ndv(in/out):
+ */
+void
+stats_free_class_attr_ndv (CLASS_ATTR_NDV * class_attr_ndv)
+{
+  int i, j;
+
+  if (class_attr_ndv->attr_ndv == NULL)
+    {
+      return;
+    }
+
+  for (i = 0; i < class_attr_ndv->attr_cnt; i++)
+    {
+      if (class_attr_ndv->attr_ndv[i].freq_values != NULL)
+	{
+	  for (j = 0; j < class_attr_ndv->attr_ndv[i].n_freq_values; j++)
+	    {
+	      pr_clear_value (&class_attr_ndv->attr_ndv[i].freq_values[j].value);
+	    }
+	  free_and_init (class_attr_ndv->attr_ndv[i].freq_values);
+	}
+    }
+
+  free_and_init (class_attr_ndv->attr_ndv);
+}
+
 /*
  * stats_make_select_list_for_ndv () - make select-list for ndv
  *   return:
@@ -32,6 +32,7 @@
 
 #include "btree.h"
 #include "heap_file.h"
+#include "heap_zone_map.hpp"
 #include "boot_sr.h"
 #include "partition_sr.h"
 #include "object_primitive.h"
@@ -64,6 +65,34 @@ struct partition_stats_acumulator
 				 * # of {a, b} ... pkeys[pkeys_size-1] -> # of {a, b, ..., x} */
 };
 
+/* The most frequent values of the columns, as computed by the client for UPDATE STATISTICS. They are not stored in
+   the catalog; they are kept in memory, with the time stamp of the statistics they belong to, until the server
+   stops. Each column keeps its values packed: the count, then each value with its fraction of the rows. */
+// *INDENT-OFF*
+struct stats_freq_values
+{
+  unsigned int time_stamp;
+  std::unordered_map<int, std::vector<char>> attrs;	/* by attribute id */
+};
+
+static std::mutex stats_Freq_values_mutex;
+static std::unordered_map<std::uint64_t, stats_freq_values> stats_Freq_values;
+// *INDENT-ON*
+
+/* The selectivity of the predicates of heap scans, when the executions found it far from the estimate of the
+   optimizer. They are kept in memory by class until the server stops, and sent with the statistics of the class
+   so that the plans compiled again use them. The time stamp of the last change makes the statistics newer. */
+// *INDENT-OFF*
+struct stats_card_feedback_list
+{
+  unsigned int time_stamp;
+  std::vector<STATS_CARD_FEEDBACK> preds;	/* the most recently changed last */
+};
+
+static std::mutex stats_Card_feedback_mutex;
+static std::unordered_map<std::uint64_t, stats_card_feedback_list> stats_Card_feedback;
+// *INDENT-ON*
+
 #if defined(ENABLE_UNUSED_FUNCTION)
 static int stats_compare_data (DB_DATA * data1, DB_DATA * data2, DB_TYPE type);
 static int stats_compare_date (DB_DATE * date1, DB_DATE * date2);
@@ -74,6 +103,12 @@ static int stats_compare_money (DB_MONETARY * mn1, DB_MONETARY * mn2);
 #endif
 static int stats_update_partitioned_statistics (THREAD_ENTRY * thread_p, OID * class_oid, OID * partitions, int count,
 						bool with_fullscan, CLASS_ATTR_NDV * class_attr_ndv);
+// *INDENT-OFF*
+static std::uint64_t stats_freq_values_key (const OID * class_id_p);
+// *INDENT-ON*
+static void stats_save_frequent_values (const OID * class_id_p, unsigned int time_stamp,
+					const CLASS_ATTR_NDV * class_attr_ndv);
+static char *stats_pack_frequent_values (char *buf_p, const char *packed_p);
 
 /*
  * xstats_update_statistics () -  Updates the statistics for the objects
@@ -308,6 +343,8 @@ xstats_update_statistics (THREAD_ENTRY * thread_p, OID * class_id_p, bool with_f
       goto error;
     }
 
+  stats_save_frequent_values (class_id_p, cls_info_p->ci_time_stamp, class_attr_ndv);
+
 end:
 
   (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error_code);
@@ -370,11 +407,17 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
   DISK_ATTR *disk_attr_p;
   BTREE_STATS *btree_stats_p;
   OID dir_oid;
-  int i, j, k, size, n_attrs, tot_n_btstats, tot_key_info_size;
+  int i, j, k, size, n_attrs, tot_n_btstats, tot_key_info_size, freq_values_size;
+  unsigned int stats_time_stamp;
   char *buf_p, *start_p;
   int key_size;
   int lk_grant_code;
   CATALOG_ACCESS_INFO catalog_access_info = CATALOG_ACCESS_INFO_INITIALIZER;
+  // *INDENT-OFF*
+  std::unordered_map<int, std::vector<char>> freq_values;
+  std::unordered_map<int, std::vector<char>>::const_iterator freq_it;
+  std::vector<STATS_CARD_FEEDBACK> feedback;
+  // *INDENT-ON*
 
   /* init */
   cls_info_p = NULL;
@@ -424,12 +467,40 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
       goto exit_on_error;
     }
 
-  if (time_stamp > 0 && time_stamp >= cls_info_p->ci_time_stamp)
+  /* the measured selectivities of the predicates are as much a part of the statistics */
+  stats_time_stamp = cls_info_p->ci_time_stamp;
+  {
+    // *INDENT-OFF*
+    std::lock_guard<std::mutex> lock (stats_Card_feedback_mutex);
+    auto entry = stats_Card_feedback.find (stats_freq_values_key (class_id_p));
+    // *INDENT-ON*
+
+    if (entry != stats_Card_feedback.end ())
+      {
+	feedback = entry->second.preds;
+	stats_time_stamp = MAX (stats_time_stamp, entry->second.time_stamp);
+      }
+  }
+
+  if (time_stamp > 0 && time_stamp >= stats_time_stamp)
     {
       *length_p = 0;
       goto exit_on_error;
     }
 
+  /* the frequent values go with the statistics they were computed with */
+  {
+    // *INDENT-OFF*
+    std::lock_guard<std::mutex> lock (stats_Freq_values_mutex);
+    auto entry = stats_Freq_values.find (stats_freq_values_key (class_id_p));
+    // *INDENT-ON*
+
+    if (entry != stats_Freq_values.end () && entry->second.time_stamp >= cls_info_p->ci_time_stamp)
+      {
+	freq_values = entry->second.attrs;
+      }
+  }
+
   if (catalog_get_last_representation_id (thread_p, class_id_p, &repr_id) != NO_ERROR)
     {
       goto exit_on_error;
@@ -447,7 +518,7 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 
   n_attrs = disk_repr_p->n_fixed + disk_repr_p->n_variable;
 
-  tot_n_btstats = tot_key_info_size = 0;
+  tot_n_btstats = tot_key_info_size = freq_values_size = 0;
   for (i = 0; i < n_attrs; i++)
     {
       if (i < disk_repr_p->n_fixed)
@@ -466,6 +537,13 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 	  assert (btree_stats_p->pkeys_size <= BTREE_STATS_PKEYS_NUM);
 	  tot_key_info_size += (btree_stats_p->pkeys_size * OR_INT_SIZE);	/* pkeys[] */
 	}
+
+      freq_it = freq_values.find (disk_attr_p->id);
+      if (freq_it != freq_values.end ())
+	{
+	  /* the values are repacked; leave room for a different alignment of each value and fraction */
+	  freq_values_size += (int) freq_it->second.size () + STATS_MAX_FREQUENT_VALUES * 2 * MAX_ALIGNMENT;
+	}
     }
 
   size = (OR_INT_SIZE		/* time_stamp of CLS_INFO */
@@ -476,6 +554,8 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 	     + OR_INT_SIZE	/* type of DISK_ATTR */
 	     + OR_INT_SIZE	/* n_btstats of DISK_ATTR */
 	     + OR_INT64_SIZE	/* Number of Distinct Values */
+	     + OR_DOUBLE_SIZE	/* width of zones */
+	     + OR_INT_SIZE	/* number of frequent values */
 	  ) * n_attrs);		/* number of attributes */
 
   size += ((OR_BTID_ALIGNED_SIZE	/* btid of BTREE_STATS */
@@ -489,6 +569,10 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 
   size += tot_key_info_size;	/* key_type, pkeys[] of BTREE_STATS */
 
+  size += freq_values_size;	/* frequent values and their fractions */
+
+  size += OR_INT_SIZE + (OR_INT_SIZE + OR_DOUBLE_SIZE) * (int) feedback.size ();	/* measured selectivities */
+
   start_p = buf_p = (char *) malloc (size);
   if (buf_p == NULL)
     {
@@ -496,7 +580,7 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
     }
   memset (start_p, 0, size);
 
-  OR_PUT_INT (buf_p, cls_info_p->ci_time_stamp);
+  OR_PUT_INT (buf_p, stats_time_stamp);
   buf_p += OR_INT_SIZE;
 
   assert (cls_info_p->ci_tot_objects >= 0);
@@ -536,6 +620,20 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
       OR_PUT_INT64 (buf_p, &disk_attr_p->ndv);
       buf_p += OR_INT64_SIZE;
 
+      OR_PUT_DOUBLE (buf_p, heap_zone_map_get_width (&cls_info_p->ci_hfid.vfid, disk_attr_p->id));
+      buf_p += OR_DOUBLE_SIZE;
+
+      freq_it = freq_values.find (disk_attr_p->id);
+      if (freq_it != freq_values.end ())
+	{
+	  buf_p = stats_pack_frequent_values (buf_p, freq_it->second.data ());
+	}
+      else
+	{
+	  OR_PUT_INT (buf_p, 0);
+	  buf_p += OR_INT_SIZE;
+	}
+
       for (j = 0, btree_stats_p = disk_attr_p->bt_stats; j < disk_attr_p->n_btstats; j++, btree_stats_p++)
 	{
 	  OR_PUT_BTID (buf_p, &btree_stats_p->btid);
@@ -597,6 +695,18 @@ xstats_get_statistics_from_server (THREAD_ENTRY * thread_p, OID * class_id_p, un
 	}			/* for (j = 0, ...) */
     }
 
+  OR_PUT_INT (buf_p, (int) feedback.size ());
+  buf_p += OR_INT_SIZE;
+
+  for (i = 0; i < (int) feedback.size (); i++)
+    {
+      OR_PUT_INT (buf_p, (int) feedback[i].pred_hash);
+      buf_p += OR_INT_SIZE;
+
+      OR_PUT_DOUBLE (buf_p, feedback[i].selectivity);
+      buf_p += OR_DOUBLE_SIZE;
+    }
+
   catalog_free_representation_and_init (disk_repr_p);
   catalog_free_class_info_and_init (cls_info_p);
 
@@ -812,6 +922,176 @@ stats_compare_data (DB_DATA * data1_p, DB_DATA * data2_p, DB_TYPE type)
 }
 #endif
 
+/*
+ * stats_freq_values_key () - key of the frequent values of a class
+ *   return: key
+ *   class_id_p(in): class
+ */
+static std::uint64_t
+stats_freq_values_key (const OID * class_id_p)
+{
+  return (((std::uint64_t) (unsigned short) class_id_p->volid << 48)
+	  | ((std::uint64_t) (unsigned int) class_id_p->pageid << 16) | (unsigned short) class_id_p->slotid);
+}
+
+/*
+ * stats_save_frequent_values () - keep the frequent values of the columns of a class
+ *   return:
+ *   class_id_p(in): class
+ *   time_stamp(in): time stamp of the statistics of the class
+ *   class_attr_ndv(in): NDV and frequent values of the columns
+ *
+ * Note: the frequent values of a former UPDATE STATISTICS are replaced, even when the columns have none now.
+ */
+static void
+stats_save_frequent_values (const OID * class_id_p, unsigned int time_stamp, const CLASS_ATTR_NDV * class_attr_ndv)
+{
+  stats_freq_values entry;
+  int i, j, size;
+  char *ptr;
+
+  entry.time_stamp = time_stamp;
+
+  for (i = 0; i < class_attr_ndv->attr_cnt; i++)
+    {
+      ATTR_NDV *attr_ndv = &class_attr_ndv->attr_ndv[i];
+
+      if (attr_ndv->n_freq_values <= 0 || attr_ndv->freq_values == NULL)
+	{
+	  continue;
+	}
+
+      size = OR_INT_SIZE;
+      for (j = 0; j < attr_ndv->n_freq_values; j++)
+	{
+	  size += or_packed_value_size (&attr_ndv->freq_values[j].value, 1, 1, 0) + OR_DOUBLE_SIZE + 2 * MAX_ALIGNMENT;
+	}
+
+      // *INDENT-OFF*
+      std::vector<char> &packed = entry.attrs[attr_ndv->id];
+      // *INDENT-ON*
+
+      packed.resize (size);
+      ptr = or_pack_int (packed.data (), attr_ndv->n_freq_values);
+      for (j = 0; j < attr_ndv->n_freq_values; j++)
+	{
+	  ptr = or_pack_value (ptr, &attr_ndv->freq_values[j].value);
+	  ptr = or_pack_double (ptr, attr_ndv->freq_values[j].fraction);
+	}
+      packed.resize (ptr - packed.data ());
+    }
+
+  // *INDENT-OFF*
+  std::lock_guard<std::mutex> lock (stats_Freq_values_mutex);
+  // *INDENT-ON*
+
+  if (entry.attrs.empty ())
+    {
+      stats_Freq_values.erase (stats_freq_values_key (class_id_p));
+    }
+  else
+    {
+      stats_Freq_values[stats_freq_values_key (class_id_p)] = std::move (entry);
+    }
+}
+
+/*
+ * stats_pack_frequent_values () - put the frequent values of a column to the statistics sent to the client
+ *   return: advanced buffer pointer
+ *   buf_p(in): buffer
+ *   packed_p(in): frequent values, as saved by stats_save_frequent_values ()
+ */
+static char *
+stats_pack_frequent_values (char *buf_p, const char *packed_p)
+{
+  DB_VALUE value;
+  double fraction;
+  int i, n_values;
+  char *ptr = (char *) packed_p;
+
+  ptr = or_unpack_int (ptr, &n_values);
+  buf_p = or_pack_int (buf_p, n_values);
+
+  for (i = 0; i < n_values; i++)
+    {
+      ptr = or_unpack_value (ptr, &value);
+      ptr = or_unpack_double (ptr, &fraction);
+
+      buf_p = or_pack_value (buf_p, &value);
+      buf_p = or_pack_double (buf_p, fraction);
+
+      pr_clear_value (&value);
+    }
+
+  return buf_p;
+}
+
+/*
+ * stats_add_cardinality_feedback () - keep the selectivity of the predicates of a heap scan
+ *   return:
+ *   class_id_p(in): class
+ *   pred_hash(in): shape of the predicates
+ *   selectivity(in): fraction of the scanned objects qualified by the predicates
+ *
+ * Note: a selectivity close to the one already kept for the predicates is ignored, so that the plans are not
+ *       compiled again for small changes. When the class has too many predicates, the least recently changed
+ *       is forgotten.
+ */
+void
+stats_add_cardinality_feedback (const OID * class_id_p, unsigned int pred_hash, double selectivity)
+{
+  // *INDENT-OFF*
+  std::lock_guard<std::mutex> lock (stats_Card_feedback_mutex);
+  stats_card_feedback_list &entry = stats_Card_feedback[stats_freq_values_key (class_id_p)];
+  std::vector<STATS_CARD_FEEDBACK>::iterator it;
+  // *INDENT-ON*
+  STATS_CARD_FEEDBACK pred;
+
+  for (it = entry.preds.begin (); it != entry.preds.end (); ++it)
+    {
+      if (it->pred_hash == pred_hash)
+	{
+	  break;
+	}
+    }
+
+  if (it != entry.preds.end ())
+    {
+      if (selectivity <= it->selectivity * 2 && selectivity * 2 >= it->selectivity)
+	{
+	  return;
+	}
+      entry.preds.erase (it);
+    }
+  else if (entry.preds.size () >= STATS_MAX_CARDINALITY_FEEDBACK)
+    {
+      entry.preds.erase (entry.preds.begin ());
+    }
+
+  pred.pred_hash = pred_hash;
+  pred.selectivity = selectivity;
+  entry.preds.push_back (pred);
+
+  /* the statistics sent before must look older, even within the same second */
+  entry.time_stamp = MAX (stats_get_time_stamp (), entry.time_stamp + 1);
+}
+
+/*
+ * stats_get_cardinality_feedback_time_stamp () - time of the last change of the selectivities measured on a class
+ *   return: time stamp; 0 if no selectivity was measured
+ *   class_id_p(in): class
+ */
+unsigned int
+stats_get_cardinality_feedback_time_stamp (const OID * class_id_p)
+{
+  // *INDENT-OFF*
+  std::lock_guard<std::mutex> lock (stats_Card_feedback_mutex);
+  auto entry = stats_Card_feedback.find (stats_freq_values_key (class_id_p));
+  // *INDENT-ON*
+
+  return (entry != stats_Card_feedback.end ()) ? entry->second.time_stamp : 0;
+}
+
 /*
  * stats_get_time_stamp () - returns the current system time
  *   return: current system time
@@ -1378,6 +1658,10 @@ stats_update_partitioned_statistics (THREAD_ENTRY * thread_p, OID * class_id_p,
   cls_info_p->ci_time_stamp = stats_get_time_stamp ();
 
   error = catalog_add_class_info (thread_p, class_id_p, cls_info_p, &catalog_access_info);
+  if (error == NO_ERROR)
+    {
+      stats_save_frequent_values (class_id_p, cls_info_p->ci_time_stamp, class_attr_ndv);
+    }
 
 cleanup:
   (void) catalog_end_access_with_dir_oid (thread_p, &catalog_access_info, error);
@@ -36,6 +36,8 @@
 #include "object_representation_sr.h"
 
 extern unsigned int stats_get_time_stamp (void);
+extern void stats_add_cardinality_feedback (const OID * class_id_p, unsigned int pred_hash, double selectivity);
+extern unsigned int stats_get_cardinality_feedback_time_stamp (const OID * class_id_p);
 extern const BTREE_STATS *stats_find_inherited_index_stats (OR_CLASSREP * cls_rep, OR_CLASSREP * subcls_rep,
 							    DISK_ATTR * subcls_attr, BTID * cls_btid);
 #if defined(CUBRID_DEBUG)
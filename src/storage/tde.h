@@ -109,6 +109,7 @@ typedef struct tde_mk_file_item
    || (rcvindex) == RVHF_DELETE \
    || (rcvindex) == RVHF_UPDATE \
    || (rcvindex) == RVHF_MVCC_INSERT \
+   || (rcvindex) == RVHF_MVCC_INSERT_MULTI \
    || (rcvindex) == RVHF_MVCC_DELETE_MODIFY_HOME \
    || (rcvindex) == RVHF_UPDATE_NOTIFY_VACUUM \
    || (rcvindex) == RVHF_INSERT_NEWHOME \
@@ -188,6 +188,7 @@ namespace cubthread
     tran_entries[THREAD_TS_HFID_TABLE] = NULL;
     tran_entries[THREAD_TS_XCACHE] = NULL;
     tran_entries[THREAD_TS_FPCACHE] = NULL;
+    tran_entries[THREAD_TS_CLASSREPR] = NULL;
 
     _unload_cnt_parallel_process = NO_UNLOAD_PARALLEL_PROCESSIING;
     _unload_parallel_process_idx = NO_UNLOAD_PARALLEL_PROCESSIING;
@@ -221,6 +222,7 @@ namespace cubthread
     tran_entries[THREAD_TS_XCACHE] = lf_tran_request_entry (&xcache_Ts);
     tran_entries[THREAD_TS_FPCACHE] = lf_tran_request_entry (&fpcache_Ts);
     tran_entries[THREAD_TS_DWB_SLOTS] = lf_tran_request_entry (&dwb_slots_Ts);
+    tran_entries[THREAD_TS_CLASSREPR] = lf_tran_request_entry (&classrepr_Ts);
   }
 
   void
@@ -88,6 +88,7 @@ enum
   THREAD_TS_XCACHE,
   THREAD_TS_FPCACHE,
   THREAD_TS_DWB_SLOTS,
+  THREAD_TS_CLASSREPR,
   THREAD_TS_LAST
 };
 #define THREAD_TS_COUNT  THREAD_TS_LAST
@@ -422,6 +422,7 @@ namespace cubthread
     std::size_t max_active_workers = NUM_NON_SYSTEM_TRANS;  // one per each connection
     std::size_t max_conn_workers = NUM_NON_SYSTEM_TRANS;    // one per each connection
     std::size_t max_vacuum_workers = prm_get_integer_value (PRM_ID_VACUUM_WORKER_COUNT);
+    std::size_t max_parallel_workers = prm_get_integer_value (PRM_ID_MAX_PARALLEL_WORKERS);
     std::size_t max_daemons = 128;  // magic number to cover predictable requirements; not cool
 
     // note: thread entry initialization is slow, that is why we keep a static pool initialized from the beginning to
@@ -429,7 +430,7 @@ namespace cubthread
     //       generated at "runtime" (after thread starts its task). however, with current thread entry design, that is
     //       rather unlikely.
 
-    m_max_threads = max_active_workers + max_conn_workers + max_vacuum_workers + max_daemons;
+    m_max_threads = max_active_workers + max_conn_workers + max_vacuum_workers + max_parallel_workers + max_daemons;
   }
 
   void
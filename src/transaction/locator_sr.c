@@ -76,6 +76,9 @@ static const int LOCATOR_GUESS_NUM_NESTED_REFERENCES = 100;
 
 #define CLASSNAME_CACHE_SIZE            1024
 
+/* initial size of the area where a batch of inserted instances is built */
+#define LOCATOR_INSERT_BATCH_AREA_SIZE  (4 * DB_PAGESIZE)
+
 /* flag for INSERT/UPDATE/DELETE statement */
 typedef enum
 {
@@ -159,6 +162,9 @@ static int locator_update_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * cla
 				 REPL_INFO_TYPE repl_info_type, int pruning_type, PRUNING_CONTEXT * pcontext,
 				 MVCC_REEV_DATA * mvcc_reev_data, UPDATE_INPLACE_STYLE force_in_place,
 				 bool need_locking);
+static int locator_insert_instance_indexes (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, OID * oid,
+					    RECDES * recdes, int has_index, int op_type, HEAP_SCANCACHE * scan_cache,
+					    FUNC_PRED_UNPACK_INFO * func_preds, bool has_BU_lock, bool dont_check_fk);
 static int locator_move_record (THREAD_ENTRY * thread_p, HFID * old_hfid, OID * old_class_oid, OID * obj_oid,
 				OID * new_class_oid, HFID * new_class_hfid, RECDES * recdes,
 				HEAP_SCANCACHE * scan_cache, int op_type, int has_index, int *force_count,
@@ -4948,17 +4954,12 @@ locator_insert_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, OID
 #if 0				/* TODO - dead code; do not delete me */
   OID rep_dir = { NULL_PAGEID, NULL_SLOTID, NULL_VOLID };
 #endif
-  bool isold_object;		/* Make sure that this is an old object */
-  RECDES new_recdes;
-  bool is_cached = false;
-  LC_COPYAREA *cache_attr_copyarea = NULL;
   int error_code = NO_ERROR;
   OID real_class_oid;
   HFID real_hfid;
   HEAP_SCANCACHE *local_scan_cache = NULL;
   FUNC_PRED_UNPACK_INFO *local_func_preds = NULL;
   HEAP_OPERATION_CONTEXT context;
-  bool skip_checking_fk;
 
   assert (class_oid != NULL);
   assert (!OID_ISNULL (class_oid));
@@ -5182,57 +5183,14 @@ locator_insert_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, OID
       /*
        * AN INSTANCE: Apply the necessary index insertions
        */
-      skip_checking_fk = locator_Dont_check_foreign_key || dont_check_fk;
-
-      if (has_index
-	  && locator_add_or_remove_index (thread_p, recdes, oid, &real_class_oid, true, op_type, local_scan_cache, true,
-					  true, &real_hfid, local_func_preds, has_BU_lock,
-					  skip_checking_fk) != NO_ERROR)
+      error_code =
+	locator_insert_instance_indexes (thread_p, &real_hfid, &real_class_oid, oid, recdes, has_index, op_type,
+					 local_scan_cache, local_func_preds, has_BU_lock, dont_check_fk);
+      if (error_code != NO_ERROR)
 	{
-	  assert (er_errid () != NO_ERROR);
-	  error_code = er_errid ();
-	  if (error_code == NO_ERROR)
-	    {
-	      error_code = ER_FAILED;
-	    }
 	  goto error1;
 	}
 
-      /* check the foreign key constraints */
-      if (has_index && !skip_checking_fk)
-	{
-	  error_code =
-	    locator_check_foreign_key (thread_p, &real_hfid, &real_class_oid, oid, recdes, &new_recdes, &is_cached,
-				       &cache_attr_copyarea);
-	  if (error_code != NO_ERROR)
-	    {
-	      goto error1;
-	    }
-
-	  if (is_cached)
-	    {
-	      HEAP_OPERATION_CONTEXT update_context;
-
-	      recdes = &new_recdes;
-	      /* Cache object has been updated, we need update the value again */
-	      heap_create_update_context (&update_context, &real_hfid, oid, &real_class_oid, recdes, local_scan_cache,
-					  UPDATE_INPLACE_CURRENT_MVCCID);
-	      if (heap_update_logical (thread_p, &update_context) != NO_ERROR)
-		{
-		  assert (er_errid () != NO_ERROR);
-		  error_code = er_errid ();
-		  if (error_code == NO_ERROR)
-		    {
-		      error_code = ER_FAILED;
-		    }
-		  goto error1;
-		}
-
-	      assert (update_context.is_logical_old);
-	      isold_object = update_context.is_logical_old;
-	    }
-	}
-
 #if defined(ENABLE_UNUSED_FUNCTION)
       /* increase the counter of the catalog */
       locator_increase_catalog_count (thread_p, &real_class_oid);
@@ -5265,6 +5223,87 @@ error1:
   HFID_COPY (hfid, &real_hfid);
 
 error2:
+  return error_code;
+}
+
+/*
+ * locator_insert_instance_indexes () - add the index entries of a new instance and check its foreign keys
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   hfid(in): heap of the instance
+ *   class_oid(in): class of the instance (the partition, for partitioned classes)
+ *   oid(in): the new instance
+ *   recdes(in): the instance in disk format, as inserted in heap
+ *   has_index(in): false if we know for sure that there is not any index on the instances of the class
+ *   op_type(in):
+ *   scan_cache(in): scan cache used to insert the instance
+ *   func_preds(in): cached function index expressions
+ *   has_BU_lock(in): true if class is bulk loaded
+ *   dont_check_fk(in): true to skip foreign key checks
+ *
+ * Note: if a cached attribute is set by the foreign key check, the instance is updated in heap.
+ */
+static int
+locator_insert_instance_indexes (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid, OID * oid, RECDES * recdes,
+				 int has_index, int op_type, HEAP_SCANCACHE * scan_cache,
+				 FUNC_PRED_UNPACK_INFO * func_preds, bool has_BU_lock, bool dont_check_fk)
+{
+  RECDES new_recdes;
+  bool is_cached = false;
+  LC_COPYAREA *cache_attr_copyarea = NULL;
+  bool skip_checking_fk;
+  int error_code = NO_ERROR;
+
+  skip_checking_fk = locator_Dont_check_foreign_key || dont_check_fk;
+
+  if (has_index
+      && locator_add_or_remove_index (thread_p, recdes, oid, class_oid, true, op_type, scan_cache, true, true, hfid,
+				      func_preds, has_BU_lock, skip_checking_fk) != NO_ERROR)
+    {
+      assert (er_errid () != NO_ERROR);
+      error_code = er_errid ();
+      if (error_code == NO_ERROR)
+	{
+	  error_code = ER_FAILED;
+	}
+      goto end;
+    }
+
+  /* check the foreign key constraints */
+  if (has_index && !skip_checking_fk)
+    {
+      error_code =
+	locator_check_foreign_key (thread_p, hfid, class_oid, oid, recdes, &new_recdes, &is_cached,
+				   &cache_attr_copyarea);
+      if (error_code != NO_ERROR)
+	{
+	  goto end;
+	}
+
+      if (is_cached)
+	{
+	  HEAP_OPERATION_CONTEXT update_context;
+
+	  /* Cache object has been updated, we need update the value again */
+	  heap_create_update_context (&update_context, hfid, oid, class_oid, &new_recdes, scan_cache,
+				      UPDATE_INPLACE_CURRENT_MVCCID);
+	  if (heap_update_logical (thread_p, &update_context) != NO_ERROR)
+	    {
+	      assert (er_errid () != NO_ERROR);
+	      error_code = er_errid ();
+	      if (error_code == NO_ERROR)
+		{
+		  error_code = ER_FAILED;
+		}
+	      goto end;
+	    }
+
+	  assert (update_context.is_logical_old);
+	}
+    }
+
+end:
   if (cache_attr_copyarea != NULL)
     {
       locator_free_copy_area (cache_attr_copyarea);
@@ -7643,6 +7682,242 @@ locator_attribute_info_force (THREAD_ENTRY * thread_p, const HFID * hfid, OID *
   return error_code;
 }
 
+/*
+ * locator_insert_batch_init () - initialize a batch of instances to insert
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   batch(out): batch to initialize
+ *   hfid(in): heap of class
+ *   class_oid(in): class of instances; must not be partitioned
+ *   op_type(in):
+ *   scan_cache(in): scan cache started for insert in class
+ *   func_preds(in): cached function index expressions
+ *
+ * Note: Batched insert must be allowed for the class (see heap_insert_batch_is_allowed).
+ */
+int
+locator_insert_batch_init (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch, const HFID * hfid,
+			   const OID * class_oid, int op_type, HEAP_SCANCACHE * scan_cache,
+			   FUNC_PRED_UNPACK_INFO * func_preds)
+{
+  HFID_COPY (&batch->hfid, hfid);
+  COPY_OID (&batch->class_oid, class_oid);
+  batch->scan_cache = scan_cache;
+  batch->func_preds = func_preds;
+  batch->op_type = op_type;
+  batch->n_records = 0;
+  batch->area_used = 0;
+
+  batch->area_size = LOCATOR_INSERT_BATCH_AREA_SIZE;
+  batch->area = (char *) db_private_alloc (thread_p, batch->area_size);
+  if (batch->area == NULL)
+    {
+      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) batch->area_size);
+      batch->area_size = 0;
+      return ER_OUT_OF_VIRTUAL_MEMORY;
+    }
+
+  return NO_ERROR;
+}
+
+/*
+ * locator_insert_batch_add () - add an instance represented by an attribute information structure to batch
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   batch(in/out): batch of instances
+ *   attr_info(in): attribute information of the new instance
+ *   force_count(out): 1 if instance was added (or inserted)
+ *
+ * Note: The instance is inserted into heap and indexes when the batch is flushed. Instances that do not fit in a heap
+ *	 page are inserted right away, after flushing the batch.
+ */
+int
+locator_insert_batch_add (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch, HEAP_CACHE_ATTRINFO * attr_info,
+			  int *force_count)
+{
+  // *INDENT-OFF*
+  record_descriptor build_record (cubmem::CSTYLE_BLOCK_ALLOCATOR);
+  // *INDENT-ON*
+  RECDES *recdes_p;
+  OID oid;
+  char *allocated_data = NULL;
+  size_t allocated_size = 0;
+  int record_length, free_area_size;
+  int error_code = NO_ERROR;
+
+  assert (OID_EQ (&batch->class_oid, &attr_info->class_oid));
+
+  *force_count = 0;
+
+  if (batch->n_records == HEAP_INSERT_BATCH_MAX_RECORDS)
+    {
+      error_code = locator_insert_batch_flush (thread_p, batch);
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+    }
+
+  /* build the disk image in the free area, keeping room for the MVCC header */
+  free_area_size = batch->area_size - batch->area_used - OR_MVCC_MAX_HEADER_SIZE;
+  if (free_area_size > 0)
+    {
+      build_record.set_external_buffer (batch->area + batch->area_used, (size_t) free_area_size);
+    }
+
+  if (heap_attrinfo_transform_to_disk (thread_p, attr_info, NULL, &build_record) != S_SUCCESS)
+    {
+      ASSERT_ERROR_AND_SET (error_code);
+      return error_code;
+    }
+
+  record_length = (int) build_record.get_size ();
+  build_record.release_buffer (allocated_data, allocated_size);
+  if (allocated_data != NULL)
+    {
+      /* not enough free area; insert collected instances and move the new one at the start of the area */
+      error_code = locator_insert_batch_flush (thread_p, batch);
+      if (error_code != NO_ERROR)
+	{
+	  free (allocated_data);	// c-style allocator was used
+	  return error_code;
+	}
+
+      if (batch->area_size < record_length + OR_MVCC_MAX_HEADER_SIZE)
+	{
+	  int new_area_size = DB_ALIGN (record_length + OR_MVCC_MAX_HEADER_SIZE, DB_PAGESIZE);
+	  char *new_area = (char *) db_private_realloc (thread_p, batch->area, new_area_size);
+
+	  if (new_area == NULL)
+	    {
+	      free (allocated_data);
+	      er_set (ER_ERROR_SEVERITY, ARG_FILE_LINE, ER_OUT_OF_VIRTUAL_MEMORY, 1, (size_t) new_area_size);
+	      return ER_OUT_OF_VIRTUAL_MEMORY;
+	    }
+	  batch->area = new_area;
+	  batch->area_size = new_area_size;
+	}
+
+      std::memcpy (batch->area, allocated_data, record_length);
+      free (allocated_data);
+    }
+
+  recdes_p = &batch->recdes[batch->n_records];
+  recdes_p->data = batch->area + batch->area_used;
+  recdes_p->length = record_length;
+  recdes_p->area_size = batch->area_size - batch->area_used;
+  recdes_p->type = REC_HOME;
+
+  if (heap_is_big_length (record_length + OR_MVCCID_SIZE))
+    {
+      /* multipage instance; insert it now, after the instances added before it, so that index entries, unique and
+       * foreign key checks still see the instances in the order of the statement. the flush leaves the area and
+       * recdes_p as they are. */
+      error_code = locator_insert_batch_flush (thread_p, batch);
+      if (error_code != NO_ERROR)
+	{
+	  return error_code;
+	}
+      return locator_insert_force (thread_p, &batch->hfid, &batch->class_oid, &oid, recdes_p, true, batch->op_type,
+				   batch->scan_cache, force_count, DB_NOT_PARTITIONED_CLASS, NULL, batch->func_preds,
+				   UPDATE_INPLACE_NONE, NULL, false, false);
+    }
+
+  /* keep room for the insert MVCCID */
+  recdes_p->area_size = record_length + OR_MVCCID_SIZE;
+  batch->area_used += DB_ALIGN (recdes_p->area_size, MAX_ALIGNMENT);
+  batch->n_records++;
+
+  *force_count = 1;
+  return NO_ERROR;
+}
+
+/*
+ * locator_insert_batch_flush () - insert the instances collected in batch
+ *
+ * return: NO_ERROR if all OK, ER_ status otherwise
+ *
+ *   batch(in/out): batch of instances
+ *
+ * Note: Instances are inserted into heap a page at a time, with a single log record for each page. Index entries are
+ *	 added and foreign keys are checked afterwards, for each instance in the order it was added to batch.
+ */
+int
+locator_insert_batch_flush (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch)
+{
+  int n_done = 0, n_inserted, i;
+  int error_code = NO_ERROR;
+
+  if (batch->n_records == 0)
+    {
+      return NO_ERROR;
+    }
+
+  while (n_done < batch->n_records)
+    {
+      error_code =
+	heap_insert_logical_batch (thread_p, &batch->hfid, &batch->class_oid, &batch->recdes[n_done],
+				   batch->n_records - n_done, batch->scan_cache, &batch->oids[n_done], &n_inserted);
+      if (error_code != NO_ERROR)
+	{
+	  ASSERT_ERROR ();
+	  goto end;
+	}
+      assert (n_inserted > 0);
+      n_done += n_inserted;
+    }
+
+  for (i = 0; i < batch->n_records; i++)
+    {
+      error_code =
+	locator_insert_instance_indexes (thread_p, &batch->hfid, &batch->class_oid, &batch->oids[i], &batch->recdes[i],
+					 true, batch->op_type, batch->scan_cache, batch->func_preds, false, false);
+      if (error_code != NO_ERROR)
+	{
+	  goto end;
+	}
+    }
+
+  /* remove query result cache entries which are relevant with this class */
+  if (!QFILE_IS_LIST_CACHE_DISABLED)
+    {
+      if (qexec_clear_list_cache_by_class (thread_p, &batch->class_oid) != NO_ERROR)
+	{
+	  er_log_debug (ARG_FILE_LINE,
+			"locator_insert_batch_flush: qexec_clear_list_cache_by_class failed for class { %d %d %d }\n",
+			OID_AS_ARGS (&batch->class_oid));
+	}
+      qmgr_add_modified_class (thread_p, &batch->class_oid);
+    }
+
+end:
+  batch->n_records = 0;
+  batch->area_used = 0;
+
+  return error_code;
+}
+
+/*
+ * locator_insert_batch_clear () - free the resources of a batch; instances not flushed are dropped
+ *
+ * return: void
+ *
+ *   batch(in/out): batch of instances
+ */
+void
+locator_insert_batch_clear (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch)
+{
+  if (batch->area != NULL)
+    {
+      db_private_free_and_init (thread_p, batch->area);
+    }
+  batch->area_size = 0;
+  batch->area_used = 0;
+  batch->n_records = 0;
+}
+
 /*
  * locator_was_index_already_applied () - Check B-Tree was already added
  *                                        or removed entries
@@ -59,6 +59,25 @@ enum
   LOB_FLAG_INCLUDE_LOB
 };
 
+/* instances of an INSERT statement collected and inserted into heap a page at a time (see heap_insert_logical_batch) */
+typedef struct locator_insert_batch LOCATOR_INSERT_BATCH;
+struct locator_insert_batch
+{
+  HFID hfid;
+  OID class_oid;
+  HEAP_SCANCACHE *scan_cache;	/* scan cache of the insert */
+  FUNC_PRED_UNPACK_INFO *func_preds;	/* cached function index expressions */
+  int op_type;
+
+  char *area;			/* disk images of collected instances */
+  int area_size;
+  int area_used;
+
+  RECDES recdes[HEAP_INSERT_BATCH_MAX_RECORDS];
+  OID oids[HEAP_INSERT_BATCH_MAX_RECORDS];
+  int n_records;
+};
+
 extern bool locator_Dont_check_foreign_key;
 
 extern int locator_initialize (THREAD_ENTRY * thread_p);
@@ -133,6 +152,14 @@ extern int locator_insert_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * cla
 				 UPDATE_INPLACE_STYLE force_in_place, PGBUF_WATCHER * home_hint_p, bool has_BU_lock,
 				 bool dont_check_fk, bool use_bulk_logging = false);
 
+extern int locator_insert_batch_init (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch, const HFID * hfid,
+				      const OID * class_oid, int op_type, HEAP_SCANCACHE * scan_cache,
+				      FUNC_PRED_UNPACK_INFO * func_preds);
+extern int locator_insert_batch_add (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch,
+				     HEAP_CACHE_ATTRINFO * attr_info, int *force_count);
+extern int locator_insert_batch_flush (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch);
+extern void locator_insert_batch_clear (THREAD_ENTRY * thread_p, LOCATOR_INSERT_BATCH * batch);
+
  // *INDENT-OFF*
 extern int locator_multi_insert_force (THREAD_ENTRY * thread_p, HFID * hfid, OID * class_oid,
 				       const std::vector<record_descriptor> &recdes, int has_index, int op_type,
@@ -239,6 +239,7 @@ typedef enum mvcc_satisfies_vacuum_result MVCC_SATISFIES_VACUUM_RESULT;
 #define LOG_IS_MVCC_HEAP_OPERATION(rcvindex) \
   (((rcvindex) == RVHF_MVCC_DELETE_REC_HOME) \
    || ((rcvindex) == RVHF_MVCC_INSERT) \
+   || ((rcvindex) == RVHF_MVCC_INSERT_MULTI) \
    || ((rcvindex) == RVHF_UPDATE_NOTIFY_VACUUM) \
    || ((rcvindex) == RVHF_MVCC_DELETE_MODIFY_HOME) \
    || ((rcvindex) == RVHF_MVCC_NO_MODIFY_HOME) \
@@ -835,6 +835,13 @@ struct rvfun RV_fun[] = {
    file_rv_set_tde_algorithm,
    NULL,
    NULL},
+
+  {RVHF_MVCC_INSERT_MULTI,
+   "RVHF_MVCC_INSERT_MULTI",
+   heap_rv_undo_insert_multi,
+   heap_rv_mvcc_redo_insert_multi,
+   log_rv_dump_hexa,
+   log_rv_dump_hexa},
 };
 
 /*
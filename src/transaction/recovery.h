@@ -183,8 +183,9 @@ typedef enum
 
   RVPGBUF_SET_TDE_ALGORITHM = 127,
   RVFL_FHEAD_SET_TDE_ALGORITHM = 128,
+  RVHF_MVCC_INSERT_MULTI = 129,
 
-  RV_LAST_LOGID = RVFL_FHEAD_SET_TDE_ALGORITHM,
+  RV_LAST_LOGID = RVHF_MVCC_INSERT_MULTI,
 
   RV_NOT_DEFINED = 999
 } LOG_RCVINDEX;
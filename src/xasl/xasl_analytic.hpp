@@ -34,6 +34,9 @@ struct sort_list;
 typedef struct sort_list SORT_LIST;   // todo - rename sort_list member.
 struct tp_domain;
 
+// offset of an UNBOUNDED bound of a ROWS window frame; UNBOUNDED PRECEDING is its negation
+#define ANALYTIC_FRAME_UNBOUNDED DB_INT32_MAX
+
 namespace cubxasl
 {
   struct analytic_ntile_function_info
@@ -84,6 +87,9 @@ namespace cubxasl
     bool from_last;		/* begin at the last or first row */
     bool ignore_nulls;		/* ignore or respect NULL values */
     bool is_const_operand;	/* is the operand a constant or a host var for MEDIAN function */
+    bool has_frame;		/* computed over a ROWS window frame */
+    int frame_start;		/* first row of the frame, relative to the current row */
+    int frame_end;		/* last row of the frame, relative to the current row */
 
     /* runtime values */
     analytic_function_info info;	/* custom function runtime values */
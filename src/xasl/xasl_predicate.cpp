@@ -57,6 +57,10 @@ namespace cubxasl
 	    free_regu_not_null (pe.m_eval_term.et.et_like.src);
 	    free_regu_not_null (pe.m_eval_term.et.et_like.pattern);
 	    free_regu_not_null (pe.m_eval_term.et.et_like.esc_char);
+		// *INDENT-OFF*
+		delete pe.m_eval_term.et.et_like.compiled_like;
+		pe.m_eval_term.et.et_like.compiled_like = NULL;
+		// *INDENT-ON*
 	    break;
 	  case T_RLIKE_EVAL_TERM:
 	    free_regu_not_null (pe.m_eval_term.et.et_rlike.src);
@@ -24,10 +24,15 @@
 #define _XASL_PREDICATE_HPP_
 
 #include "dbtype_def.h"             // DB_TYPE
+#include "string_like.hpp"
 #include "string_regex.hpp"
 
 // forward definitions
 class regu_variable_node;
+namespace cubquery
+{
+  class compiled_pred;
+}
 
 typedef enum
 {
@@ -125,6 +130,7 @@ namespace cubxasl
     regu_variable_node *src;
     regu_variable_node *pattern;
     regu_variable_node *esc_char;
+    mutable cub_compiled_like *compiled_like;
   };
 
   struct rlike_eval_term
@@ -156,6 +162,7 @@ namespace cubxasl
       pred_expr *m_not_term;
     } pe;
     TYPE_PRED_EXPR type;
+    mutable cubquery::compiled_pred *compiled;	// program of a cached XASL clone's scan predicate; server only
 
     void clear_xasl ();
   };
@@ -0,0 +1,413 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+#include "test_compiled_pred.hpp"
+
+#include "test_perf_compare.hpp"
+#include "test_debug.hpp"
+
+#include "area_alloc.h"
+#include "db_date.h"
+#include "dbtype.h"
+#include "object_domain.h"
+#include "object_primitive.h"
+#include "query_compiled_pred.hpp"
+#include "query_evaluator.h"
+#include "query_executor.h"
+#include "regu_var.hpp"
+#include "set_object.h"
+#include "thread_entry.hpp"
+#include "thread_manager.hpp"
+#include "xasl_predicate.hpp"
+
+#include <deque>
+#include <initializer_list>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace test_compiled_pred
+{
+
+  /************************************************************************/
+  /* Predicate builder                                                    */
+  /************************************************************************/
+
+  /* TPC-H lineitem columns, in the order of the values of a row */
+  enum lineitem_column
+  {
+    L_QUANTITY,			/* integer */
+    L_EXTENDEDPRICE,		/* double */
+    L_DISCOUNT,			/* double */
+    L_SHIPDATE,			/* date */
+    L_COLUMN_COUNT
+  };
+
+  /* build predicate trees the way stx_build_pred_expr unpacks them; columns are positional values of the row the
+   * value descriptor points to */
+  class pred_builder
+  {
+    public:
+      pred_builder () = default;
+
+      ~pred_builder ()
+      {
+	for (PRED_EXPR &pr : m_preds)
+	  {
+	    delete pr.compiled;
+	  }
+	for (REGU_VARIABLE &regu : m_regus)
+	  {
+	    if (regu.type == TYPE_DBVAL)
+	      {
+		pr_clear_value (&regu.value.dbval);
+	      }
+	  }
+	for (DB_VALUE &value : m_values)
+	  {
+	    pr_clear_value (&value);
+	  }
+      }
+
+      REGU_VARIABLE *column (lineitem_column col, TP_DOMAIN *domain)
+      {
+	REGU_VARIABLE *regu = new_regu (TYPE_POS_VALUE, domain);
+
+	regu->value.val_pos = col;
+	return regu;
+      }
+
+      REGU_VARIABLE *int_const (int value)
+      {
+	REGU_VARIABLE *regu = new_regu (TYPE_DBVAL, &tp_Integer_domain);
+
+	db_make_int (&regu->value.dbval, value);
+	return regu;
+      }
+
+      REGU_VARIABLE *double_const (double value)
+      {
+	REGU_VARIABLE *regu = new_regu (TYPE_DBVAL, &tp_Double_domain);
+
+	db_make_double (&regu->value.dbval, value);
+	return regu;
+      }
+
+      REGU_VARIABLE *date_const (int year, int month, int day)
+      {
+	REGU_VARIABLE *regu = new_regu (TYPE_DBVAL, &tp_Date_domain);
+
+	db_make_date (&regu->value.dbval, month, day, year);
+	return regu;
+      }
+
+      REGU_VARIABLE *arith (OPERATOR_TYPE opcode, REGU_VARIABLE *left, REGU_VARIABLE *right, TP_DOMAIN *domain)
+      {
+	REGU_VARIABLE *regu = new_regu (TYPE_INARITH, domain);
+	ARITH_TYPE &arith = m_ariths.emplace_back ();
+
+	m_values.emplace_back ();
+	db_make_null (&m_values.back ());
+
+	arith.domain = domain;
+	arith.original_domain = NULL;
+	arith.value = &m_values.back ();
+	arith.leftptr = left;
+	arith.rightptr = right;
+	arith.thirdptr = NULL;
+	arith.opcode = opcode;
+	arith.misc_operand = LEADING;
+	arith.pred = NULL;
+	arith.rand_seed = NULL;
+
+	regu->value.arithptr = &arith;
+	return regu;
+      }
+
+      PRED_EXPR *comp (REGU_VARIABLE *lhs, REL_OP rel_op, REGU_VARIABLE *rhs)
+      {
+	PRED_EXPR *pr = new_pred (T_EVAL_TERM);
+	COMP_EVAL_TERM &et_comp = pr->pe.m_eval_term.et.et_comp;
+
+	pr->pe.m_eval_term.et_type = T_COMP_EVAL_TERM;
+	et_comp.lhs = lhs;
+	et_comp.rhs = rhs;
+	et_comp.rel_op = rel_op;
+	et_comp.type = TP_DOMAIN_TYPE (lhs->domain);
+	return pr;
+      }
+
+      PRED_EXPR *in_list (REGU_VARIABLE *elem, std::initializer_list<int> values)
+      {
+	REGU_VARIABLE *elemset = new_regu (TYPE_DBVAL, &tp_Multiset_domain);
+	PRED_EXPR *pr = new_pred (T_EVAL_TERM);
+	ALSM_EVAL_TERM &et_alsm = pr->pe.m_eval_term.et.et_alsm;
+	DB_COLLECTION *set = set_create_multi ();
+	DB_VALUE elem_value;
+
+	test_common::custom_assert (set != NULL);
+	for (int value : values)
+	  {
+	    db_make_int (&elem_value, value);
+	    test_common::custom_assert (set_add_element (set, &elem_value) == NO_ERROR);
+	  }
+	db_make_multiset (&elemset->value.dbval, set);
+
+	pr->pe.m_eval_term.et_type = T_ALSM_EVAL_TERM;
+	et_alsm.elem = elem;
+	et_alsm.elemset = elemset;
+	et_alsm.eq_flag = F_SOME;
+	et_alsm.rel_op = R_EQ;
+	et_alsm.item_type = TP_DOMAIN_TYPE (elem->domain);
+	return pr;
+      }
+
+      /* right-linear chain of terms, like the parser generates for conjunctions and disjunctions */
+      PRED_EXPR *chain (BOOL_OP bool_op, std::initializer_list<PRED_EXPR *> terms)
+      {
+	std::vector<PRED_EXPR *> term_vector (terms);
+	PRED_EXPR *pr = term_vector.back ();
+
+	for (std::size_t i = term_vector.size () - 1; i > 0; i--)
+	  {
+	    PRED_EXPR *parent = new_pred (T_PRED);
+
+	    parent->pe.m_pred.lhs = term_vector[i - 1];
+	    parent->pe.m_pred.rhs = pr;
+	    parent->pe.m_pred.bool_op = bool_op;
+	    pr = parent;
+	  }
+	return pr;
+      }
+
+      PRED_EXPR *between (REGU_VARIABLE *value, REGU_VARIABLE *lower, REGU_VARIABLE *upper)
+      {
+	return chain (B_AND, { comp (value, R_GE, lower), comp (value, R_LE, upper) });
+      }
+
+    private:
+      REGU_VARIABLE *new_regu (REGU_DATATYPE type, TP_DOMAIN *domain)
+      {
+	REGU_VARIABLE &regu = m_regus.emplace_back ();
+
+	regu.type = type;
+	regu.flags = 0;
+	regu.domain = domain;
+	regu.original_domain = NULL;
+	regu.vfetch_to = NULL;
+	regu.xasl = NULL;
+	return &regu;
+      }
+
+      PRED_EXPR *new_pred (TYPE_PRED_EXPR type)
+      {
+	PRED_EXPR &pr = m_preds.emplace_back ();
+
+	pr.type = type;
+	pr.compiled = NULL;
+	return &pr;
+      }
+
+      /* deques keep the addresses of their elements */
+      std::deque<REGU_VARIABLE> m_regus;
+      std::deque<ARITH_TYPE> m_ariths;
+      std::deque<DB_VALUE> m_values;
+      std::deque<PRED_EXPR> m_preds;
+  };
+
+  /************************************************************************/
+  /* Benchmark                                                            */
+  /************************************************************************/
+
+  static const std::size_t ROW_COUNT = 200000;
+  static const int REPEAT_COUNT = 5;
+
+  /* random lineitem rows; one in a hundred discounts is null */
+  static void
+  generate_rows (std::vector<DB_VALUE> &rows)
+  {
+    std::mt19937 generator (20261019);
+    std::uniform_int_distribution<int> quantity (1, 50);
+    std::uniform_real_distribution<double> price (900.0, 105000.0);
+    std::uniform_int_distribution<int> discount (0, 10);
+    std::uniform_int_distribution<int> day (0, 2500);
+    std::uniform_int_distribution<int> null_discount (0, 99);
+    DB_DATE start_date;
+    int month, mday, year;
+
+    start_date = julian_encode (1, 1, 1992);
+
+    rows.resize (ROW_COUNT * L_COLUMN_COUNT);
+    for (std::size_t row = 0; row < ROW_COUNT; row++)
+      {
+	DB_VALUE *values = &rows[row * L_COLUMN_COUNT];
+
+	db_make_int (&values[L_QUANTITY], quantity (generator));
+	db_make_double (&values[L_EXTENDEDPRICE], price (generator));
+	if (null_discount (generator) == 0)
+	  {
+	    db_make_null (&values[L_DISCOUNT]);
+	  }
+	else
+	  {
+	    db_make_double (&values[L_DISCOUNT], discount (generator) / 100.0);
+	  }
+	julian_decode (start_date + day (generator), &month, &mday, &year, NULL);
+	db_make_date (&values[L_SHIPDATE], month, mday, year);
+      }
+  }
+
+  enum evaluator
+  {
+    EVAL_COMPILED,
+    EVAL_INTERPRETER
+  };
+
+  /* evaluate pr for all rows with the compiled program and with the interpreter and time both. the results must be
+   * the same. */
+  static int
+  run_predicate (test_common::perf_compare &results, size_t step, THREAD_ENTRY *thread_p, PRED_EXPR *pr,
+		 std::vector<DB_VALUE> &rows)
+  {
+    VAL_DESCR vd;
+    std::vector<DB_LOGICAL> expected (ROW_COUNT);
+    std::size_t row, qualified = 0;
+    DB_LOGICAL ev_res;
+    int repeat;
+
+    eval_compile_pred (thread_p, pr);
+    test_common::custom_assert (pr->compiled != NULL && pr->compiled->is_specialized ());
+
+    vd.dbval_cnt = L_COLUMN_COUNT;
+    vd.xasl_state = NULL;
+
+    test_common::us_timer timer;
+
+    for (repeat = 0; repeat < REPEAT_COUNT; repeat++)
+      {
+	for (row = 0; row < ROW_COUNT; row++)
+	  {
+	    vd.dbval_ptr = &rows[row * L_COLUMN_COUNT];
+	    expected[row] = eval_pred (thread_p, pr, &vd, NULL);
+	  }
+      }
+    results.register_time (timer, EVAL_INTERPRETER, step);
+
+    for (repeat = 0; repeat < REPEAT_COUNT; repeat++)
+      {
+	for (row = 0; row < ROW_COUNT; row++)
+	  {
+	    vd.dbval_ptr = &rows[row * L_COLUMN_COUNT];
+	    ev_res = eval_compiled_pred (thread_p, pr, &vd, NULL);
+	    if (ev_res != expected[row])
+	      {
+		std::cout << "    row " << row << ": compiled " << ev_res << ", interpreter " << expected[row]
+			  << std::endl;
+		return 1;
+	      }
+	    qualified += (ev_res == V_TRUE) ? 1 : 0;
+	  }
+      }
+    results.register_time (timer, EVAL_COMPILED, step);
+
+    std::cout << "    " << pr->compiled->get_specialized_count () << " specialized terms, "
+	      << qualified / REPEAT_COUNT << " qualified rows" << std::endl;
+    return 0;
+  }
+
+  int
+  test_compiled_pred (void)
+  {
+    THREAD_ENTRY *thread_p = NULL;
+    std::vector<DB_VALUE> rows;
+    pred_builder builder;
+    int err = 0;
+
+    cubthread::initialize (thread_p);
+    area_init ();
+    test_common::custom_assert (set_area_init () == NO_ERROR);
+
+    generate_rows (rows);
+
+    REGU_VARIABLE *quantity = builder.column (L_QUANTITY, &tp_Integer_domain);
+    REGU_VARIABLE *price = builder.column (L_EXTENDEDPRICE, &tp_Double_domain);
+    REGU_VARIABLE *discount = builder.column (L_DISCOUNT, &tp_Double_domain);
+    REGU_VARIABLE *shipdate = builder.column (L_SHIPDATE, &tp_Date_domain);
+
+    /* Q1: l_shipdate <= date '1998-09-02' */
+    PRED_EXPR *q1 = builder.comp (shipdate, R_LE, builder.date_const (1998, 9, 2));
+
+    /* Q6: l_shipdate >= date '1994-01-01' and l_shipdate < date '1995-01-01'
+     *     and l_discount between 0.05 and 0.07 and l_quantity < 24 */
+    PRED_EXPR *q6 =
+	    builder.chain (B_AND, { builder.comp (shipdate, R_GE, builder.date_const (1994, 1, 1)),
+				    builder.comp (shipdate, R_LT, builder.date_const (1995, 1, 1)),
+				    builder.between (discount, builder.double_const (0.05), builder.double_const (0.07)),
+				    builder.comp (quantity, R_LT, builder.int_const (24))
+				  });
+
+    /* Q19-like: (l_quantity in (1, 5, 7, 11) and l_discount < 0.03)
+     *           or (l_quantity between 10 and 20 and l_shipdate >= date '1996-01-01')
+     *           or (l_quantity in (30, 31, 32) and l_discount > 0.08) */
+    PRED_EXPR *q19 =
+	    builder.chain (B_OR, { builder.chain (B_AND, { builder.in_list (quantity, { 1, 5, 7, 11 }),
+						   builder.comp (discount, R_LT, builder.double_const (0.03))
+						 }),
+				   builder.chain (B_AND, { builder.between (quantity, builder.int_const (10),
+						   builder.int_const (20)),
+						   builder.comp (shipdate, R_GE, builder.date_const (1996, 1, 1))
+						 }),
+				   builder.chain (B_AND, { builder.in_list (quantity, { 30, 31, 32 }),
+						   builder.comp (discount, R_GT, builder.double_const (0.08))
+						 })
+				 });
+
+    /* revenue: l_extendedprice * (1 - l_discount) > 50000 */
+    PRED_EXPR *revenue =
+	    builder.comp (builder.arith (T_MUL, price,
+					 builder.arith (T_SUB, builder.int_const (1), discount, &tp_Double_domain),
+					 &tp_Double_domain),
+			  R_GT, builder.double_const (50000.0));
+
+    test_common::string_collection evaluator_names ("compiled", "interpreter");
+    test_common::string_collection step_names ("Q1 shipdate", "Q6 ranges", "Q19 disjunction", "revenue arithmetic");
+    test_common::perf_compare results (evaluator_names, step_names);
+    std::size_t step = 0;
+
+    for (PRED_EXPR *pr : { q1, q6, q19, revenue })
+      {
+	std::cout << "  " << step_names.get_name (step) << std::endl;
+	err = run_predicate (results, step++, thread_p, pr, rows);
+	if (err != 0)
+	  {
+	    break;
+	  }
+      }
+    std::cout << std::endl;
+
+    results.print_results_and_warnings (std::cout);
+
+    for (DB_VALUE &value : rows)
+      {
+	pr_clear_value (&value);
+      }
+
+    return err;
+  }
+
+}  // namespace test_compiled_pred
@@ -0,0 +1,329 @@
+/*
+ * Copyright 2008 Search Solution Corporation
+ * Copyright 2016 CUBRID Corporation
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ */
+
+/*
+ * test_query_exec.cpp - statements executed by a server, checked through their results
+ *
+ * the test connects to the database named by CUBRID_TEST_DB (testdb by default), which must be served by a running
+ * cub_server: the paths tested here are not taken by the standalone mode. it is built only with
+ * -DUNIT_TEST_QUERY_EXEC=ON.
+ *
+ * cases:
+ *  - INSERT ... SELECT of small rows and a multipage row with a self-referencing foreign key
+ *  - a prepared hash join executed with outer keys pruning no partition of its inner class, then some
+ */
+
+#include "test_query_exec.hpp"
+
+#include "dbi.h"
+#include "dbtype.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace test_query_exec
+{
+
+  static int
+  print_error (const char *what, int err)
+  {
+    std::cout << "  " << what << " failed: " << db_error_string (3) << std::endl;
+    return err != 0 ? err : -1;
+  }
+
+  /* execute sql; returns the number of affected rows, or a negative error */
+  static int
+  execute (const std::string &sql)
+  {
+    DB_QUERY_RESULT *result = NULL;
+    DB_QUERY_ERROR query_error;
+    int count;
+
+    count = db_execute (sql.c_str (), &result, &query_error);
+    if (result != NULL)
+      {
+	db_query_end (result);
+      }
+    if (count < 0)
+      {
+	print_error (sql.c_str (), count);
+      }
+    return count;
+  }
+
+  /* the first column of the first row of a query result, read as an integer */
+  static int
+  first_int (DB_QUERY_RESULT *result, int &value)
+  {
+    DB_VALUE db_value;
+    int err;
+
+    err = db_query_first_tuple (result);
+    if (err != DB_CURSOR_SUCCESS)
+      {
+	return err < 0 ? err : -1;
+      }
+    err = db_query_get_tuple_value (result, 0, &db_value);
+    if (err != NO_ERROR)
+      {
+	return err;
+      }
+    value = DB_IS_NULL (&db_value) ? 0 : db_get_int (&db_value);
+    db_value_clear (&db_value);
+    return NO_ERROR;
+  }
+
+  static int
+  query_int (const std::string &sql, int &value)
+  {
+    DB_QUERY_RESULT *result = NULL;
+    DB_QUERY_ERROR query_error;
+    int err;
+
+    err = db_execute (sql.c_str (), &result, &query_error);
+    if (err >= 0)
+      {
+	err = first_int (result, value);
+      }
+    if (result != NULL)
+      {
+	db_query_end (result);
+      }
+    if (err < 0)
+      {
+	return print_error (sql.c_str (), err);
+      }
+    return NO_ERROR;
+  }
+
+  static int
+  check_int (const std::string &sql, int expected)
+  {
+    int value = 0;
+    int err;
+
+    err = query_int (sql, value);
+    if (err != NO_ERROR)
+      {
+	return err;
+      }
+    if (value != expected)
+      {
+	std::cout << "  " << sql << ": expected " << expected << ", got " << value << std::endl;
+	return -1;
+      }
+    return NO_ERROR;
+  }
+
+  /* execute a compiled statement with an integer host variable; its first column is read as an integer */
+  static int
+  execute_prepared_int (DB_SESSION *session, int stmt_id, int host_value, int &value)
+  {
+    DB_QUERY_RESULT *result = NULL;
+    DB_VALUE host_var;
+    int err;
+
+    db_make_int (&host_var, host_value);
+    err = db_push_values (session, 1, &host_var);
+    if (err >= 0)
+      {
+	err = db_execute_and_keep_statement (session, stmt_id, &result);
+      }
+    if (err >= 0)
+      {
+	err = first_int (result, value);
+      }
+    if (result != NULL)
+      {
+	db_query_end (result);
+      }
+    if (err < 0)
+      {
+	return print_error ("prepared statement", err);
+      }
+    return NO_ERROR;
+  }
+
+  /************************************************************************/
+  /* INSERT ... SELECT in heap batches                                     */
+  /************************************************************************/
+
+  /* an INSERT ... SELECT inserts its small rows by batches and its multipage rows right away; a row referencing an
+   * earlier row of the same statement must find it whichever way each of them is inserted */
+  static int
+  test_insert_batch_big_record (void)
+  {
+    const int n_rows = 30, big_row = 21, big_length = 40000;
+    std::string sql;
+    int err = NO_ERROR;
+
+    std::cout << "  INSERT ... SELECT of small rows and a multipage row with a self-referencing foreign key"
+	      << std::endl;
+
+    execute ("DROP TABLE IF EXISTS qe_batch, qe_batch_src");
+    if (execute ("CREATE TABLE qe_batch_src (id INT, parent_id INT, len INT)") < 0
+	|| execute ("CREATE TABLE qe_batch (id INT PRIMARY KEY, parent_id INT, payload VARCHAR,"
+		    " CONSTRAINT fk_qe_batch_parent FOREIGN KEY (parent_id) REFERENCES qe_batch (id))") < 0)
+      {
+	err = -1;
+	goto end;
+      }
+
+    /* each row references the one before it, the multipage row included */
+    sql = "INSERT INTO qe_batch_src VALUES (1, NULL, 10)";
+    for (int id = 2; id <= n_rows; id++)
+      {
+	sql += ", (" + std::to_string (id) + ", " + std::to_string (id - 1) + ", "
+	       + std::to_string (id == big_row ? big_length : 10) + ")";
+      }
+    if (execute (sql) != n_rows)
+      {
+	err = -1;
+	goto end;
+      }
+
+    if (execute ("INSERT INTO qe_batch SELECT id, parent_id, REPEAT ('x', len) FROM qe_batch_src ORDER BY id")
+	!= n_rows)
+      {
+	err = -1;
+	goto end;
+      }
+
+    err = check_int ("SELECT COUNT (*) FROM qe_batch", n_rows);
+    if (err == NO_ERROR)
+      {
+	err = check_int ("SELECT id FROM qe_batch WHERE CHAR_LENGTH (payload) = " + std::to_string (big_length),
+			 big_row);
+      }
+    if (err == NO_ERROR)
+      {
+	err = check_int ("SELECT COUNT (*) FROM qe_batch c, qe_batch p WHERE c.parent_id = p.id", n_rows - 1);
+      }
+
+  end:
+    db_abort_transaction ();
+    execute ("DROP TABLE IF EXISTS qe_batch, qe_batch_src");
+    db_commit_transaction ();
+    return err;
+  }
+
+  /************************************************************************/
+  /* Partitions pruned by the keys of a hash join                          */
+  /************************************************************************/
+
+  /* the outer keys of a hash join prune the partitions of its inner class; when they match no partition, the next
+   * execution of the cached plan must prune the partitions again with its own keys */
+  static int
+  test_join_key_pruning_reexecution (void)
+  {
+    const char *query = "SELECT /*+ ORDERED USE_HASH */ COUNT (*) FROM qe_outer o, qe_part p"
+			" WHERE o.k = p.id AND o.grp = ?";
+    DB_SESSION *session = NULL;
+    int stmt_id, count = -1;
+    int err = NO_ERROR;
+
+    std::cout << "  hash join pruning no partition, then some, in two executions of a prepared statement" << std::endl;
+
+    execute ("DROP TABLE IF EXISTS qe_outer, qe_part");
+    if (execute ("CREATE TABLE qe_part (id INT, v INT) PARTITION BY RANGE (id)"
+		 " (PARTITION p0 VALUES LESS THAN (100), PARTITION p1 VALUES LESS THAN (200))") < 0
+	|| execute ("INSERT INTO qe_part SELECT ROWNUM - 1, ROWNUM FROM db_class a, db_class b LIMIT 200") != 200
+	|| execute ("CREATE TABLE qe_outer (k INT, grp INT)") < 0
+	/* group 1 is out of every partition, group 2 is in both */
+	|| execute ("INSERT INTO qe_outer VALUES (500, 1), (501, 1), (10, 2), (150, 2)") != 4)
+      {
+	err = -1;
+	goto end;
+      }
+
+    session = db_open_buffer (query);
+    if (session == NULL)
+      {
+	err = print_error (query, db_error_code ());
+	goto end;
+      }
+    stmt_id = db_compile_statement (session);
+    if (stmt_id < 0)
+      {
+	err = print_error (query, stmt_id);
+	goto end;
+      }
+
+    for (int grp : { 1, 2, 1, 2 })
+      {
+	const int expected = (grp == 1) ? 0 : 2;
+
+	err = execute_prepared_int (session, stmt_id, grp, count);
+	if (err != NO_ERROR)
+	  {
+	    goto end;
+	  }
+	if (count != expected)
+	  {
+	    std::cout << "  group " << grp << ": expected " << expected << " rows, got " << count << std::endl;
+	    err = -1;
+	    goto end;
+	  }
+      }
+
+  end:
+    if (session != NULL)
+      {
+	db_close_session (session);
+      }
+    db_abort_transaction ();
+    execute ("DROP TABLE IF EXISTS qe_outer, qe_part");
+    db_commit_transaction ();
+    return err;
+  }
+
+  int
+  test_query_exec (void)
+  {
+    const char *db_name = std::getenv ("CUBRID_TEST_DB");
+    int err;
+
+    if (db_name == NULL)
+      {
+	db_name = "testdb";
+      }
+
+    std::cout << "query execution on " << db_name << std::endl;
+
+    if (db_login ("dba", NULL) != NO_ERROR)
+      {
+	return print_error ("login", db_error_code ());
+      }
+    err = db_restart ("test_query_exec", TRUE, db_name);
+    if (err != NO_ERROR)
+      {
+	return print_error ("restart", err);
+      }
+
+    err = test_insert_batch_big_record ();
+    if (err == NO_ERROR)
+      {
+	err = test_join_key_pruning_reexecution ();
+      }
+
+    db_shutdown ();
+    return err;
+  }
+
+}  // namespace test_query_exec